@@ -67,6 +67,14 @@ if (ENABLE_GPU)
     add_compile_definitions(ENABLE_GPU_COLLECTIVE)
 endif()
 
+if (ENABLE_CPU)
+    add_compile_definitions(ENABLE_CPU)
+endif()
+
+if (ENABLE_CPU AND NOT WIN32)
+    add_compile_definitions(ENABLE_CPU_COLLECTIVE)
+endif()
+
 if (ENABLE_GE)
     add_compile_definitions(ENABLE_GE)
     add_compile_definitions(CUSTOM_OP)
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <thread>
 #include <utility>
 #include "./securec.h"
 #include "common/utils.h"
@@ -87,6 +88,227 @@ T DivCeil(T n1, T n2) {
   return (n2 != 0) ? (n1 - 1) / n2 + 1 : 0;
 }
 
+namespace {
+constexpr size_t kMaxTransThreadNum = 8;
+constexpr size_t kMinTransBytesPerThread = 512 * 1024;
+// elements per side of the tiles used by the transposes, keeps both the source and the destination in cache
+constexpr size_t kTransBlock = 32;
+
+// Run task(begin, end) over [0, task_num), on several threads when there are enough bytes to move.
+void ParallelFor(size_t task_num, size_t total_bytes, const std::function<void(size_t, size_t)> &task) {
+  size_t thread_num = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), kMaxTransThreadNum);
+  thread_num = std::min(thread_num, std::max<size_t>(total_bytes / kMinTransBytesPerThread, 1));
+  thread_num = std::min(thread_num, task_num);
+  if (thread_num <= 1) {
+    task(0, task_num);
+    return;
+  }
+  size_t task_per_thread = DivCeil(task_num, thread_num);
+  std::vector<std::thread> threads;
+  for (size_t begin = task_per_thread; begin < task_num; begin += task_per_thread) {
+    threads.emplace_back(task, begin, std::min(begin + task_per_thread, task_num));
+  }
+  task(0, task_per_thread);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+// The format kernels only move elements, so they are instantiated once per element width.
+template <typename Func>
+bool DispatchByTypeSize(size_t size, Func &&func) {
+  switch (size) {
+    case 1:
+      func(uint8_t());
+      return true;
+    case 2:
+      func(uint16_t());
+      return true;
+    case 4:
+      func(uint32_t());
+      return true;
+    case 8:
+      func(uint64_t());
+      return true;
+    default:
+      MS_LOG(ERROR) << "Trans data not support size " << size;
+      return false;
+  }
+}
+
+// dst[b][j][i] = src[b][i][j], src is batch x rows x cols
+template <typename T>
+void BatchTranspose(const T *src, T *dst, size_t batch, size_t rows, size_t cols) {
+  size_t row_blocks = DivCeil(rows, kTransBlock);
+  size_t matrix_size = rows * cols;
+  ParallelFor(batch * row_blocks, batch * matrix_size * sizeof(T), [&](size_t begin, size_t end) {
+    for (size_t task = begin; task < end; task++) {
+      const T *src_matrix = src + task / row_blocks * matrix_size;
+      T *dst_matrix = dst + task / row_blocks * matrix_size;
+      size_t row_begin = task % row_blocks * kTransBlock;
+      size_t row_end = std::min(row_begin + kTransBlock, rows);
+      for (size_t col_begin = 0; col_begin < cols; col_begin += kTransBlock) {
+        size_t col_end = std::min(col_begin + kTransBlock, cols);
+        for (size_t row = row_begin; row < row_end; row++) {
+          for (size_t col = col_begin; col < col_end; col++) {
+            dst_matrix[col * rows + row] = src_matrix[row * cols + col];
+          }
+        }
+      }
+    }
+  });
+}
+
+// hwcn[hw][c][n] = nchw[n][c][hw], an n x c block is transposed for every hw position
+template <typename T>
+void NchwHwcnKernel(const T *src, T *dst, size_t n, size_t c, size_t hw, bool to_hwcn) {
+  size_t hw_blocks = DivCeil(hw, kTransBlock);
+  ParallelFor(hw_blocks, n * c * hw * sizeof(T), [&](size_t begin, size_t end) {
+    for (size_t task = begin; task < end; task++) {
+      size_t hw_begin = task * kTransBlock;
+      size_t hw_end = std::min(hw_begin + kTransBlock, hw);
+      for (size_t ni = 0; ni < n; ni++) {
+        for (size_t ci = 0; ci < c; ci++) {
+          size_t nchw_idx = (ni * c + ci) * hw;
+          size_t hwcn_idx = ci * n + ni;
+          if (to_hwcn) {
+            for (size_t i = hw_begin; i < hw_end; i++) {
+              dst[i * c * n + hwcn_idx] = src[nchw_idx + i];
+            }
+          } else {
+            for (size_t i = hw_begin; i < hw_end; i++) {
+              dst[nchw_idx + i] = src[i * c * n + hwcn_idx];
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename T>
+void NchwToNc1hwc0Kernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t c0) {
+  size_t c1 = DivCeil(c, c0);
+  size_t hwc0 = hw * c0;
+  ParallelFor(n * c1, n * c1 * hwc0 * sizeof(T), [&](size_t begin, size_t end) {
+    for (size_t task = begin; task < end; task++) {
+      size_t c_begin = task % c1 * c0;
+      size_t valid_c0 = std::min(c0, c - c_begin);
+      const T *src_planes = src + (task / c1 * c + c_begin) * hw;
+      T *dst_block = dst + task * hwc0;
+      for (size_t hw_begin = 0; hw_begin < hw; hw_begin += kTransBlock) {
+        size_t hw_end = std::min(hw_begin + kTransBlock, hw);
+        for (size_t c0_idx = 0; c0_idx < valid_c0; c0_idx++) {
+          const T *src_plane = src_planes + c0_idx * hw;
+          for (size_t i = hw_begin; i < hw_end; i++) {
+            dst_block[i * c0 + c0_idx] = src_plane[i];
+          }
+        }
+        for (size_t c0_idx = valid_c0; c0_idx < c0; c0_idx++) {
+          for (size_t i = hw_begin; i < hw_end; i++) {
+            dst_block[i * c0 + c0_idx] = 0;
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename T>
+void Nc1hwc0ToNchwKernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t c1, size_t c0) {
+  size_t hwc0 = hw * c0;
+  ParallelFor(n * c1, n * c * hw * sizeof(T), [&](size_t begin, size_t end) {
+    for (size_t task = begin; task < end; task++) {
+      size_t n_idx = task / c1;
+      size_t c_begin = task % c1 * c0;
+      if (c_begin >= c) {
+        continue;
+      }
+      size_t valid_c0 = std::min(c0, c - c_begin);
+      const T *src_block = src + task * hwc0;
+      T *dst_planes = dst + (n_idx * c + c_begin) * hw;
+      for (size_t hw_begin = 0; hw_begin < hw; hw_begin += kTransBlock) {
+        size_t hw_end = std::min(hw_begin + kTransBlock, hw);
+        for (size_t c0_idx = 0; c0_idx < valid_c0; c0_idx++) {
+          T *dst_plane = dst_planes + c0_idx * hw;
+          for (size_t i = hw_begin; i < hw_end; i++) {
+            dst_plane[i] = src_block[i * c0 + c0_idx];
+          }
+        }
+      }
+    }
+  });
+}
+
+// frac_z: (c1 * h * w) x n1 fractals of n0(16) x c0, padded with zeros
+template <typename T>
+void NchwToFracZKernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t c0) {
+  size_t c1 = DivCeil(c, c0);
+  size_t vf_cnt = c1 * hw;
+  size_t n_pad = DivCeil(n, kCubeSize) * kCubeSize;
+  size_t chw = c * hw;
+  ParallelFor(vf_cnt, vf_cnt * n_pad * c0 * sizeof(T), [&](size_t begin, size_t end) {
+    for (size_t vfi = begin; vfi < end; vfi++) {
+      size_t c_begin = vfi / hw * c0;
+      size_t valid_c0 = std::min(c0, c - c_begin);
+      const T *src_col = src + c_begin * hw + vfi % hw;
+      T *dst_row = dst + vfi * n_pad * c0;
+      for (size_t n_idx = 0; n_idx < n_pad; n_idx++, dst_row += c0) {
+        size_t row = 0;
+        if (n_idx < n) {
+          const T *src_n = src_col + n_idx * chw;
+          for (; row < valid_c0; row++) {
+            dst_row[row] = src_n[row * hw];
+          }
+        }
+        for (; row < c0; row++) {
+          dst_row[row] = 0;
+        }
+      }
+    }
+  });
+}
+
+template <typename T>
+void FracZToNchwKernel(const T *src, T *dst, size_t n, size_t c, size_t hw, size_t ncc0, size_t c0) {
+  size_t hwncc0 = hw * ncc0;
+  ParallelFor(n * c, n * c * hw * sizeof(T), [&](size_t begin, size_t end) {
+    for (size_t task = begin; task < end; task++) {
+      size_t n_idx = task / c;
+      size_t c_idx = task % c;
+      const T *src_col = src + c_idx / c0 * hwncc0 + n_idx * c0 + c_idx % c0;
+      T *dst_plane = dst + task * hw;
+      for (size_t i = 0; i < hw; i++) {
+        dst_plane[i] = src_col[i * ncc0];
+      }
+    }
+  });
+}
+
+// frac_nz moves whole runs of w0 elements, each host row is split into w1 runs
+template <typename T>
+void FracNzKernel(const T *src, T *dst, size_t times, size_t h, size_t w, size_t w0, size_t h1h0w0,
+                  size_t w1h1h0w0, bool to_nz) {
+  size_t num_w1 = DivCeil(w, w0);
+  ParallelFor(times * h, times * h * w * sizeof(T), [&](size_t begin, size_t end) {
+    for (size_t row = begin; row < end; row++) {
+      size_t host_head = row * w;
+      size_t nz_head = row / h * w1h1h0w0 + row % h * w0;
+      for (size_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
+        size_t len = std::min(w0, w - w1_idx * w0);
+        size_t host_idx = host_head + w1_idx * w0;
+        size_t nz_idx = nz_head + w1_idx * h1h0w0;
+        if (to_nz) {
+          (void)std::copy(src + host_idx, src + host_idx + len, dst + nz_idx);
+        } else {
+          (void)std::copy(src + nz_idx, src + nz_idx + len, dst + host_idx);
+        }
+      }
+    }
+  });
+}
+}  // namespace
+
 enum DataTypeTransMode {
   FROM_FLOAT_TO_FLOAT16,
   FROM_FLOAT_TO_INT32,
@@ -154,10 +376,13 @@ void CheckMemSize(const TypeIdArgs &args) {
 template <typename SrcT, typename DstT>
 void TransDataSrc2Dst(const TypeIdArgs &args, void *dst, const size_t data_size) {
   CheckMemSize(args);
-  for (size_t idx = 0; idx != data_size; idx++) {
-    SrcT src_data = static_cast<const SrcT *>(args.data)[idx];
-    static_cast<DstT *>(dst)[idx] = static_cast<DstT>(src_data);
-  }
+  auto src_data = static_cast<const SrcT *>(args.data);
+  auto dst_data = static_cast<DstT *>(dst);
+  ParallelFor(data_size, data_size * sizeof(DstT), [src_data, dst_data](size_t begin, size_t end) {
+    for (size_t idx = begin; idx < end; idx++) {
+      dst_data[idx] = static_cast<DstT>(src_data[idx]);
+    }
+  });
 }
 
 template <typename SrcT>
@@ -165,9 +390,11 @@ void TransDataSrc2Fp16(const TypeIdArgs &args, void *dst, const size_t data_size
   CheckMemSize(args);
   auto src_data = static_cast<const SrcT *>(args.data);
   auto half_data = static_cast<Eigen::half *>(dst);
-  for (size_t i = 0; i < data_size; i++) {
-    half_data[i] = Eigen::half(src_data[i]);
-  }
+  ParallelFor(data_size, data_size * sizeof(Eigen::half), [src_data, half_data](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      half_data[i] = Eigen::half(src_data[i]);
+    }
+  });
 }
 
 bool CastKernel(const TypeIdArgs &args, void *dst, const size_t data_size, const DataTypeTransMode mode) {
@@ -542,25 +769,19 @@ bool NchwTo4D(const FormatArgs &args, void *result) {
   }
   size_t n = args.host_shape[0];
   size_t c = args.host_shape[1];
-  size_t h = args.host_shape[2];
-  size_t w = args.host_shape[3];
-  for (size_t ni = 0; ni < n; ni++) {
-    for (size_t ci = 0; ci < c; ci++) {
-      for (size_t hi = 0; hi < h; hi++) {
-        for (size_t wi = 0; wi < w; wi++) {
-          auto src_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          auto dst_idx = 0;
-          if (args.device_format == kOpFormat_NHWC) {
-            dst_idx = ni * h * w * c + hi * w * c + wi * c + ci;
-          } else if (args.device_format == kOpFormat_HWCN) {
-            dst_idx = hi * w * c * n + wi * c * n + ci * n + ni;
-          }
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
+  size_t hw = args.host_shape[2] * args.host_shape[3];
+  // nhwc transposes c x hw of every batch, hwcn transposes n x c of every hw position
+  bool to_nhwc = args.device_format == kOpFormat_NHWC;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    auto src = static_cast<const T *>(args.data);
+    auto dst = static_cast<T *>(result);
+    if (to_nhwc) {
+      BatchTranspose(src, dst, n, c, hw);
+    } else {
+      NchwHwcnKernel(src, dst, n, c, hw, true);
     }
-  }
-  return true;
+  });
 }
 
 bool ToNchw(const FormatArgs &args, void *result) {
@@ -574,25 +795,18 @@ bool ToNchw(const FormatArgs &args, void *result) {
   }
   size_t n = args.host_shape[0];
   size_t c = args.host_shape[1];
-  size_t h = args.host_shape[2];
-  size_t w = args.host_shape[3];
-  for (size_t ni = 0; ni < n; ni++) {
-    for (size_t ci = 0; ci < c; ci++) {
-      for (size_t hi = 0; hi < h; hi++) {
-        for (size_t wi = 0; wi < w; wi++) {
-          auto dst_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          auto src_idx = 0;
-          if (args.device_format == kOpFormat_NHWC) {
-            src_idx = ni * h * w * c + hi * w * c + wi * c + ci;
-          } else if (args.device_format == kOpFormat_HWCN) {
-            src_idx = hi * w * c * n + wi * c * n + ci * n + ni;
-          }
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
+  size_t hw = args.host_shape[2] * args.host_shape[3];
+  bool from_nhwc = args.device_format == kOpFormat_NHWC;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    auto src = static_cast<const T *>(args.data);
+    auto dst = static_cast<T *>(result);
+    if (from_nhwc) {
+      BatchTranspose(src, dst, n, hw, c);
+    } else {
+      NchwHwcnKernel(src, dst, n, c, hw, false);
     }
-  }
-  return true;
+  });
 }
 
 bool NchwToFracZ(const FormatArgs &args, void *result) {
@@ -619,9 +833,6 @@ bool NchwToFracZ(const FormatArgs &args, void *result) {
   }
   size_t c1 = DivCeil(c, c0);
   size_t hw = h * w;
-  size_t chw = c * hw;
-  size_t hwc0 = hw * c0;
-  size_t nchw = n * chw;
 
   size_t hf_cnt = DivCeil(n, kCubeSize);
   size_t vf_cnt = c1 * hw;
@@ -634,26 +845,10 @@ bool NchwToFracZ(const FormatArgs &args, void *result) {
     return false;
   }
 
-  for (size_t vfi = 0; vfi < vf_cnt; vfi++) {
-    auto vf_base_i = vfi * hf_cnt;  // vertical fractal matrix base index
-    for (size_t hfi = 0; hfi < hf_cnt; hfi++) {
-      auto gfi = vf_base_i + hfi;  // global fractal matrix index
-      auto src_n_offset = hfi * chw * kCubeSize;
-      auto src_f_offset = src_n_offset + vfi % hw + vfi / hw * hwc0;
-      for (size_t row = 0; row < c0; row++) {
-        auto src_ci = vfi / hw * c0 + row;
-        auto src_row_offset = src_f_offset + row * hw;
-        for (size_t col = 0; col < kCubeSize; col++) {
-          auto src_ni = hfi * kCubeSize + col;
-          auto src_idx = src_row_offset + chw * col;
-          auto dst_idx = gfi * fractal_ele_cnt + col * c0 + row;
-          auto pad_zero = (src_ni >= n || src_idx >= nchw || src_ci >= c) ? true : false;
-          SetData(size, pad_zero, src_idx, dst_idx, args, result);
-        }
-      }
-    }
-  }
-  return true;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    NchwToFracZKernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, c0);
+  });
 }
 
 bool FracZToNchw(const FormatArgs &args, void *result) {
@@ -685,29 +880,11 @@ bool FracZToNchw(const FormatArgs &args, void *result) {
 
   size_t nc = ni * n0;
   size_t ncc0 = nc * c0;
-  size_t wncc0 = w * ncc0;
-  size_t hwncc0 = h * wncc0;
   size_t hw = h * w;
-  size_t chw = c * hw;
-
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * chw;
-    for (size_t c_idx = 0; c_idx < c; c_idx++) {
-      size_t c_head_addr = n_head_addr + c_idx * hw;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c_head_addr + h_idx * w;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t dst_idx = h_head_addr + w_idx;
-          size_t c1_idx = c_idx / c0;
-          size_t c0_idx = c_idx % c0;
-          size_t nc_idx = n_idx;
-          size_t src_idx = c1_idx * hwncc0 + h_idx * wncc0 + w_idx * ncc0 + nc_idx * c0 + c0_idx;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
-  }
-  return true;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    FracZToNchwKernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, ncc0, c0);
+  });
 }
 
 bool NchwToFracZc04(const FormatArgs &args, void *result) {
@@ -824,8 +1001,6 @@ bool NchwToFracNz(const FormatArgs &args, void *result) {
   auto times = hw_shape.at(0);
   auto h = hw_shape.at(1);
   auto w = hw_shape.at(2);
-  auto hw = h * w;
-
   auto shape_size = args.device_shape.size();
   auto w1 = args.device_shape[shape_size - 4];
   auto h1 = args.device_shape[shape_size - 3];
@@ -833,31 +1008,11 @@ bool NchwToFracNz(const FormatArgs &args, void *result) {
   auto w0 = args.device_shape[shape_size - 1];
   auto h1h0w0 = h1 * h0 * w0;
   auto w1h1h0w0 = w1 * h1h0w0;
-  auto num_w1 = w / w0;
-
-  for (size_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (size_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto src_h_head = src_times_head + h1h0_idx * w;
-      for (size_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        for (size_t i = 0; i < w0; ++i) {
-          size_t src_idx = src_h_head + w1_idx * w0 + i;
-          size_t dst_idx = h1h0_head + w1_idx * h1h0w0 + i;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-      auto w1_head = num_w1 * w0;
-      for (size_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto src_w_idx = w1_head + w0_idx;
-        size_t dst_idx = h1h0_head + num_w1 * h1h0w0 + w0_idx;
-        size_t src_idx = src_h_head + src_w_idx;
-        SetData(size, false, src_idx, dst_idx, args, result);
-      }
-    }
-  }
-  return true;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    FracNzKernel(static_cast<const T *>(args.data), static_cast<T *>(result), times, h, w, w0, h1h0w0, w1h1h0w0,
+                 true);
+  });
 }
 
 bool FracNzToNchw(const FormatArgs &args, void *result) {
@@ -886,8 +1041,6 @@ bool FracNzToNchw(const FormatArgs &args, void *result) {
   auto times = hw_shape.at(0);
   auto h = hw_shape.at(1);
   auto w = hw_shape.at(2);
-  auto hw = h * w;
-
   auto shape_size = args.device_shape.size();
   auto w1 = args.device_shape[shape_size - 4];
   auto h1 = args.device_shape[shape_size - 3];
@@ -895,31 +1048,11 @@ bool FracNzToNchw(const FormatArgs &args, void *result) {
   auto w0 = args.device_shape[shape_size - 1];
   auto h1h0w0 = h1 * h0 * w0;
   auto w1h1h0w0 = w1 * h1h0w0;
-  auto num_w1 = w / w0;
-
-  for (size_t times_idx = 0; times_idx < times; times_idx++) {
-    auto times_head = times_idx * w1h1h0w0;
-    auto src_times_head = times_idx * hw;
-    for (size_t h1h0_idx = 0; h1h0_idx < h; h1h0_idx++) {
-      auto h1h0_head = times_head + h1h0_idx * w0;
-      auto src_h_head = src_times_head + h1h0_idx * w;
-      for (size_t w1_idx = 0; w1_idx < num_w1; w1_idx++) {
-        for (size_t i = 0; i < w0; ++i) {
-          size_t src_idx = h1h0_head + w1_idx * h1h0w0 + i;
-          size_t dst_idx = src_h_head + w1_idx * w0 + i;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-      auto w1_head = num_w1 * w0;
-      for (size_t w0_idx = 0; w1_head + w0_idx < w; w0_idx++) {
-        auto src_w_idx = w1_head + w0_idx;
-        size_t src_idx = h1h0_head + num_w1 * h1h0w0 + w0_idx;
-        size_t dst_idx = src_h_head + src_w_idx;
-        SetData(size, false, src_idx, dst_idx, args, result);
-      }
-    }
-  }
-  return true;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    FracNzKernel(static_cast<const T *>(args.data), static_cast<T *>(result), times, h, w, w0, h1h0w0, w1h1h0w0,
+                 false);
+  });
 }
 
 bool NchwToNc1hwc0(const FormatArgs &args, void *result) {
@@ -949,32 +1082,11 @@ bool NchwToNc1hwc0(const FormatArgs &args, void *result) {
     MS_LOG(ERROR) << "Illegal dtype.";
     return false;
   }
-  size_t c1 = DivCeil(c, c0);
   size_t hw = h * w;
-  size_t chw = c * hw;
-  size_t c1hwc0 = c1 * hw * c0;
-  size_t wc0 = w * c0;
-
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * c1hwc0;
-    for (size_t c1_idx = 0; c1_idx < c1; c1_idx++) {
-      size_t c1_head_addr = n_head_addr + c1_idx * hw * c0;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c1_head_addr + h_idx * wc0;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t w_head_addr = h_head_addr + w_idx * c0;
-          for (size_t c0_idx = 0; c0_idx < c0; c0_idx++) {
-            size_t dst_idx = c0_idx + w_head_addr;
-            size_t c_idx = c0_idx + c1_idx * c0;
-            size_t src_idx = n_idx * chw + c_idx * hw + h_idx * w + w_idx;
-            auto pad_zero = (c_idx < c) ? false : true;
-            SetData(size, pad_zero, src_idx, dst_idx, args, result);
-          }
-        }
-      }
-    }
-  }
-  return true;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    NchwToNc1hwc0Kernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, c0);
+  });
 }
 
 bool Nc1hwc0ToNchw(const FormatArgs &args, void *result) {
@@ -1003,28 +1115,10 @@ bool Nc1hwc0ToNchw(const FormatArgs &args, void *result) {
   auto c0 = args.device_shape[4];
 
   size_t hw = h * w;
-  size_t chw = c * hw;
-  size_t wc0 = w * c0;
-  size_t hwc0 = h * wc0;
-  size_t c1hwc0 = c1 * hwc0;
-
-  for (size_t n_idx = 0; n_idx < n; n_idx++) {
-    size_t n_head_addr = n_idx * chw;
-    for (size_t c_idx = 0; c_idx < c; c_idx++) {
-      size_t c_head_addr = n_head_addr + c_idx * hw;
-      for (size_t h_idx = 0; h_idx < h; h_idx++) {
-        size_t h_head_addr = c_head_addr + h_idx * w;
-        for (size_t w_idx = 0; w_idx < w; w_idx++) {
-          size_t dst_idx = h_head_addr + w_idx;
-          size_t c1_idx = c_idx / c0;
-          size_t c0_idx = c_idx % c0;
-          size_t src_idx = n_idx * c1hwc0 + c1_idx * hwc0 + h_idx * wc0 + w_idx * c0 + c0_idx;
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
-  }
-  return true;
+  return DispatchByTypeSize(size, [&](auto type) {
+    using T = decltype(type);
+    Nc1hwc0ToNchwKernel(static_cast<const T *>(args.data), static_cast<T *>(result), n, c, hw, c1, c0);
+  });
 }
 
 bool NchwToC1hwncoc0(const FormatArgs &args, void *result) {
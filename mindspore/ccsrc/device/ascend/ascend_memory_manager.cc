@@ -59,8 +59,8 @@ void AscendMemoryManager::FreeDeviceMemory() {
   }
 }
 
-void *AscendMemoryManager::MallocMemFromMemPool(size_t size) {
-  return AscendMemoryPool::GetInstance().AllocTensorMem(size);
+void *AscendMemoryManager::MallocMemFromMemPool(size_t size, uint32_t stream_id) {
+  return AscendMemoryPool::GetInstance().AllocTensorMem(size, stream_id);
 }
 }  // namespace ascend
 }  // namespace device
@@ -27,7 +27,7 @@ class AscendMemoryManager : public MemoryManager {
 
   void MallocDeviceMemory() override;
   void FreeDeviceMemory() override;
-  void *MallocMemFromMemPool(size_t size) override;
+  void *MallocMemFromMemPool(size_t size, uint32_t stream_id = 0) override;
 
  private:
   uint8_t *device_mem_pool_base_{nullptr};
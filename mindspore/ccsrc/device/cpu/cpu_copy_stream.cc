@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "device/cpu/cpu_copy_stream.h"
+#include <utility>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+CPUCopyStream::~CPUCopyStream() {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    exit_ = true;
+  }
+  cond_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+std::future<bool> CPUCopyStream::Submit(const std::function<bool()> &copy) {
+  std::packaged_task<bool()> task(copy);
+  auto future = task.get_future();
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    copies_.push(std::move(task));
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&CPUCopyStream::WorkerLoop, this);
+    }
+  }
+  cond_.notify_one();
+  return future;
+}
+
+void CPUCopyStream::WorkerLoop() {
+  while (true) {
+    std::packaged_task<bool()> task;
+    {
+      std::unique_lock<std::mutex> lock(lock_);
+      cond_.wait(lock, [this] { return exit_ || !copies_.empty(); });
+      // the copies submitted are finished before the exit, their futures are waited on
+      if (copies_.empty()) {
+        return;
+      }
+      task = std::move(copies_.front());
+      copies_.pop();
+    }
+    task();
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_COPY_STREAM_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_CPU_COPY_STREAM_H_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "common/utils.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// A thread that runs the copies between the device and the host one at a time, in the order they are submitted, while
+// the caller goes on with the kernels. The thread is started by the first copy.
+class CPUCopyStream {
+ public:
+  CPUCopyStream() = default;
+  ~CPUCopyStream();
+  DISABLE_COPY_AND_ASSIGN(CPUCopyStream)
+
+  // the future is the result of the copy, an exception thrown by it is rethrown by the get of the future
+  std::future<bool> Submit(const std::function<bool()> &copy);
+
+ private:
+  void WorkerLoop();
+
+  std::thread worker_;
+  std::mutex lock_;
+  std::condition_variable cond_;
+  std::queue<std::packaged_task<bool()>> copies_;
+  bool exit_{false};
+};
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_CPU_COPY_STREAM_H_
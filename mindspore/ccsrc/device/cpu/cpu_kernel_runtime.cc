@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "device/cpu/cpu_kernel_runtime.h"
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <memory>
@@ -22,17 +24,26 @@
 #include <functional>
 #include <unordered_map>
 #include "kernel/kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
 #include "device/cpu/cpu_device_address.h"
 #include "utils/context/ms_context.h"
 #include "utils/config_manager.h"
 #include "common/utils.h"
 #include "session/anf_runtime_algorithm.h"
 #include "operator/ops.h"
+#include "utils/utils.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
 const size_t INIT_NODE_REF = 1;
+
+bool CPUKernelRuntime::Init() {
+  // start the compute threads and bind them to their cores before any graph runs
+  (void)kernel::CPUThreadPool::GetInstance();
+  return true;
+}
+
 void CPUKernelRuntime::AssignKernelAddress(session::KernelGraph *kernel_graph) {
   AssignValueNodeAddress(kernel_graph);
   AssignInputNodeAddress(kernel_graph);
@@ -227,6 +238,10 @@ void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<ker
   kernel::AddressPtr input = std::make_shared<kernel::Address>();
   MS_EXCEPTION_IF_NULL(input);
   if (address->ptr_ == nullptr) {
+    // the memory of the tensors copied to the host is released as their copies finish
+    while (!resource_manager_.MemFits(address->size_) && !pending_copies_.empty()) {
+      FinishCopy();
+    }
     address->ptr_ = resource_manager_.MemMalloc(address->size_);
   }
   MS_EXCEPTION_IF_NULL(address->ptr_);
@@ -235,16 +250,51 @@ void CPUKernelRuntime::AddRuntimeAddress(DeviceAddress *address, std::vector<ker
   input_list->push_back(input);
 }
 
+void CPUKernelRuntime::FinishCopy() {
+  auto copy = std::move(pending_copies_.front());
+  pending_copies_.pop_front();
+  auto ret = copy.done.get();
+  resource_manager_.DecreaseAddressRefCount(copy.kernel);
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed.";
+  }
+}
+
+void CPUKernelRuntime::PollCopies() {
+  while (!pending_copies_.empty() &&
+         pending_copies_.front().done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+    FinishCopy();
+  }
+}
+
+void CPUKernelRuntime::WaitCopy(const AnfNodePtr &kernel) {
+  auto iter = std::find_if(pending_copies_.begin(), pending_copies_.end(),
+                           [&kernel](const PendingCopy &copy) { return copy.kernel == kernel; });
+  if (iter == pending_copies_.end()) {
+    return;
+  }
+  auto count = iter - pending_copies_.begin() + 1;
+  for (auto i = 0; i < count; ++i) {
+    FinishCopy();
+  }
+}
+
 bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
   MS_EXCEPTION_IF_NULL(kernel_graph);
   resource_manager_.ResetAddressRefCount(kernel_graph);
   auto kernels = kernel_graph->execution_order();
   for (const auto &kernel : kernels) {
+    auto kernel_name = AnfAlgo::GetCNodeName(kernel);
+    bool is_copy = kernel_name == kSwapOutOpName || kernel_name == kSwapInOpName;
     std::vector<kernel::AddressPtr> kernel_inputs;
     std::vector<kernel::AddressPtr> kernel_workspaces;
     std::vector<kernel::AddressPtr> kernel_outputs;
     size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
     for (size_t i = 0; i < input_num; ++i) {
+      // the copies run in order on the copy stream, the other kernels wait for the copies of their inputs
+      if (!is_copy) {
+        WaitCopy(AnfAlgo::GetPrevNodeOutput(kernel, i).first);
+      }
       auto device_address = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, i).get();
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_inputs);
@@ -262,11 +312,26 @@ bool CPUKernelRuntime::Run(session::KernelGraph *kernel_graph) {
       MS_EXCEPTION_IF_NULL(device_address);
       AddRuntimeAddress(device_address, &kernel_workspaces);
     }
-    auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
-    resource_manager_.DecreaseAddressRefCount(kernel);
-    if (!ret) {
-      MS_LOG(EXCEPTION) << "Launch kernel failed.";
+    if (is_copy) {
+      auto copy = [kernel_mod, kernel_inputs, kernel_workspaces, kernel_outputs]() {
+        return kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+      };
+      pending_copies_.push_back({kernel, copy_stream_.Submit(copy)});
+    } else {
+      auto ret = kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, 0);
+      resource_manager_.DecreaseAddressRefCount(kernel);
+      if (!ret) {
+        MS_LOG(EXCEPTION) << "Launch kernel failed.";
+      }
     }
+    PollCopies();
+  }
+  while (!pending_copies_.empty()) {
+    FinishCopy();
+  }
+  if (resource_manager_.memory_limit() > 0) {
+    MS_LOG(INFO) << "The peak memory is " << resource_manager_.peak_size() << " bytes of the limit "
+                 << resource_manager_.memory_limit();
   }
   return true;
 }
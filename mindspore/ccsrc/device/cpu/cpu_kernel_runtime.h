@@ -16,12 +16,15 @@
 #ifndef MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_RUNTIME_H_
 #define MINDSPORE_CCSRC_DEVICE_CPU_CPU_KERNEL_RUNTIME_H_
 
+#include <deque>
+#include <future>
 #include <memory>
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include "device/kernel_runtime.h"
 #include "session/kernel_graph.h"
+#include "device/cpu/cpu_copy_stream.h"
 #include "device/cpu/cpu_resource_manager.h"
 #include "utils/any.h"
 namespace mindspore {
@@ -32,11 +35,12 @@ class CPUKernelRuntime : public KernelRuntime {
   CPUKernelRuntime() = default;
   ~CPUKernelRuntime() override = default;
 
-  bool Init() override { return true; }
+  bool Init() override;
   bool Run(session::KernelGraph *graph) override;
   void AssignKernelAddress(session::KernelGraph *kernel_graph);
   void BindInputOutput(const session::KernelGraph *kernel_graph, const std::vector<tensor::TensorPtr> &inputs,
                        VectorRef *outputs);
+  void set_memory_limit(size_t memory_limit) { resource_manager_.set_memory_limit(memory_limit); }
 
  protected:
   bool SyncStream() override { return true; };
@@ -50,7 +54,21 @@ class CPUKernelRuntime : public KernelRuntime {
   void AssignInputNodeAddress(const session::KernelGraph *kernel_graph);
   void AssignKernelOutputAddress(const session::KernelGraph *kernel_graph);
   void AddRuntimeAddress(DeviceAddress *address, std::vector<kernel::AddressPtr> *input_list);
+  // wait for the oldest copy and release its inputs
+  void FinishCopy();
+  // finish the copies done so far
+  void PollCopies();
+  // finish the copies up to the one of kernel if it is pending
+  void WaitCopy(const AnfNodePtr &kernel);
+
+  // a swap kernel running on the copy stream, the ref counts of its inputs are decreased when it is done
+  struct PendingCopy {
+    CNodePtr kernel;
+    std::future<bool> done;
+  };
   CPUResourceManager resource_manager_;
+  CPUCopyStream copy_stream_;
+  std::deque<PendingCopy> pending_copies_;
 };
 }  // namespace cpu
 }  // namespace device
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "device/cpu/cpu_resource_manager.h"
+#include <algorithm>
 #include "session/anf_runtime_algorithm.h"
 
 namespace mindspore {
@@ -32,9 +33,15 @@ void CPUResourceManager::MemFree() {
     free(iter.first);
   }
   dynamic_mem_.clear();
+  used_size_ = 0;
 }
 
 void CPUResourceManager::MemPlan(const session::KernelGraph *graph) {
+  if (memory_limit_ > 0) {
+    // the plan keeps every tensor for the whole graph
+    dynamic_malloc_ = true;
+    return;
+  }
   mem_plan_.MemPlan(graph);
   size_t graph_mem_size = mem_plan_.GetGraphMemSize(graph);
   if (graph_mem_size > mem_size_) {
@@ -58,10 +65,16 @@ void CPUResourceManager::MemMalloc(const session::KernelGraph *graph) {
 }
 
 void *CPUResourceManager::MemMalloc(size_t mem_size) {
+  if (!MemFits(mem_size)) {
+    MS_LOG(EXCEPTION) << "Malloc memory failed: size " << mem_size << " with " << used_size_
+                      << " used is over the memory limit " << memory_limit_;
+  }
   void *ptr = malloc(mem_size);
   if (ptr != nullptr) {
     memset_s(ptr, mem_size, 0, mem_size);
     dynamic_mem_[ptr] = mem_size;
+    used_size_ += mem_size;
+    peak_size_ = std::max(peak_size_, used_size_);
     return ptr;
   } else {
     MS_LOG(EXCEPTION) << "Malloc memory failed: size " << mem_size;
@@ -71,6 +84,7 @@ void *CPUResourceManager::MemMalloc(size_t mem_size) {
 void CPUResourceManager::MemFree(void *ptr) {
   auto iter = dynamic_mem_.find(ptr);
   if (iter != dynamic_mem_.end()) {
+    used_size_ -= iter->second;
     (void)dynamic_mem_.erase(iter);
     free(ptr);
   }
@@ -35,6 +35,12 @@ class CPUResourceManager {
   void DecreaseAddressRefCount(const AnfNodePtr &kernel);
   void *MemMalloc(size_t mem_size);
   void MemFree(void *ptr);
+  // simulate a device memory of memory_limit bytes, the tensors are allocated as the kernels run and an allocation
+  // over the limit fails, 0 for no limit
+  void set_memory_limit(size_t memory_limit) { memory_limit_ = memory_limit; }
+  size_t memory_limit() const { return memory_limit_; }
+  bool MemFits(size_t mem_size) const { return memory_limit_ == 0 || used_size_ + mem_size <= memory_limit_; }
+  size_t peak_size() const { return peak_size_; }
 
  private:
   void MemFree();
@@ -44,6 +50,9 @@ class CPUResourceManager {
   uint8_t *mem_ptr_{nullptr};
   bool dynamic_malloc_{false};
   std::unordered_map<void *, size_t> dynamic_mem_;
+  size_t memory_limit_{0};
+  size_t used_size_{0};
+  size_t peak_size_{0};
 };
 }  // namespace cpu
 }  // namespace device
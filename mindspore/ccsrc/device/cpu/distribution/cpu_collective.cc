@@ -0,0 +1,917 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/distribution/cpu_collective.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <utility>
+#include "Eigen/Core"
+#include "securec/include/securec.h"
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kHostBytes = 256;
+constexpr size_t kAddrBytes = 64;
+constexpr size_t kCopyBlockBytes = 1 << 30;
+
+// The entry of a process in the rendezvous
+struct PeerInfo {
+  int32_t rank;
+  int32_t port;
+  char host[kHostBytes];
+  char addr[kAddrBytes];
+};
+
+// The header of a point to point message
+struct MessageHeader {
+  int32_t tag;
+  int32_t reserved;
+  uint64_t bytes;
+};
+
+size_t TypeBytes(TypeId type) {
+  switch (type) {
+    case kNumberTypeFloat16:
+      return 2;
+    case kNumberTypeFloat32:
+    case kNumberTypeInt32:
+      return 4;
+    case kNumberTypeFloat64:
+    case kNumberTypeInt64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+void ReduceTyped(T *dst, const T *src, size_t count, CollectiveReduceOp op) {
+  switch (op) {
+    case kCollectiveSum:
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] += src[i];
+      }
+      break;
+    case kCollectiveMax:
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] = std::max(dst[i], src[i]);
+      }
+      break;
+    case kCollectiveMin:
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] = std::min(dst[i], src[i]);
+      }
+      break;
+    case kCollectiveProd:
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] *= src[i];
+      }
+      break;
+  }
+}
+
+void ReduceBuffer(char *dst, const char *src, size_t bytes, TypeId type, CollectiveReduceOp op) {
+  switch (type) {
+    case kNumberTypeFloat16:
+      ReduceTyped(reinterpret_cast<Eigen::half *>(dst), reinterpret_cast<const Eigen::half *>(src),
+                  bytes / sizeof(Eigen::half), op);
+      break;
+    case kNumberTypeFloat32:
+      ReduceTyped(reinterpret_cast<float *>(dst), reinterpret_cast<const float *>(src), bytes / sizeof(float), op);
+      break;
+    case kNumberTypeFloat64:
+      ReduceTyped(reinterpret_cast<double *>(dst), reinterpret_cast<const double *>(src), bytes / sizeof(double), op);
+      break;
+    case kNumberTypeInt32:
+      ReduceTyped(reinterpret_cast<int32_t *>(dst), reinterpret_cast<const int32_t *>(src), bytes / sizeof(int32_t),
+                  op);
+      break;
+    case kNumberTypeInt64:
+      ReduceTyped(reinterpret_cast<int64_t *>(dst), reinterpret_cast<const int64_t *>(src), bytes / sizeof(int64_t),
+                  op);
+      break;
+    default:
+      break;
+  }
+}
+
+// memcpy_s copies at most 2GB at a time
+bool CopyBuffer(void *dst, const void *src, size_t bytes) {
+  if (dst == src) {
+    return true;
+  }
+  auto dst_bytes = static_cast<char *>(dst);
+  auto src_bytes = static_cast<const char *>(src);
+  for (size_t offset = 0; offset < bytes; offset += kCopyBlockBytes) {
+    size_t size = std::min(kCopyBlockBytes, bytes - offset);
+    if (memcpy_s(dst_bytes + offset, size, src_bytes + offset, size) != EOK) {
+      MS_LOG(ERROR) << "Copy " << size << " bytes failed";
+      return false;
+    }
+  }
+  return true;
+}
+
+int SegmentIndex(int index, int size) { return ((index % size) + size) % size; }
+
+bool IsPowerOfTwo(size_t size) { return size > 0 && (size & (size - 1)) == 0; }
+
+bool GetEnvInt(const char *name, int *value) {
+  const char *env = getenv(name);
+  if (env == nullptr) {
+    return false;
+  }
+  char *end = nullptr;
+  long result = strtol(env, &end, 10);
+  if (end == env || *end != '\0') {
+    return false;
+  }
+  *value = static_cast<int>(result);
+  return true;
+}
+}  // namespace
+
+bool GetCollectiveReduceOp(const std::string &op_name, CollectiveReduceOp *op) {
+  MS_EXCEPTION_IF_NULL(op);
+  if (op_name == "sum") {
+    *op = kCollectiveSum;
+  } else if (op_name == "max") {
+    *op = kCollectiveMax;
+  } else if (op_name == "min") {
+    *op = kCollectiveMin;
+  } else if (op_name == "prod") {
+    *op = kCollectiveProd;
+  } else {
+    MS_LOG(ERROR) << "The reduce op " << op_name << " is not supported by the cpu collective";
+    return false;
+  }
+  return true;
+}
+
+CPUCollective &CPUCollective::instance() {
+  static CPUCollective instance;
+  return instance;
+}
+
+CPUCollective::~CPUCollective() { Finalize(); }
+
+bool CPUCollective::Init(int rank, int size, const std::string &master_addr, int master_port) {
+  if (initialized_) {
+    MS_LOG(ERROR) << "The cpu collective has been initialized";
+    return false;
+  }
+  if (size <= 0 || rank < 0 || rank >= size) {
+    MS_LOG(ERROR) << "Invalid rank " << rank << " of the rank size " << size;
+    return false;
+  }
+  if (master_port <= 0 || master_port > 65535) {
+    MS_LOG(ERROR) << "Invalid master port " << master_port;
+    return false;
+  }
+  rank_ = rank;
+  size_ = size;
+  links_.assign(IntToSize(size), nullptr);
+  if (size > 1) {
+    int listen_port = 0;
+    int listen_fd = ListenOn(0, size, &listen_port);
+    if (listen_fd < 0) {
+      return false;
+    }
+    bool ret = Rendezvous(master_addr, master_port, listen_port) && ConnectPeers(listen_fd) &&
+               (!shm_enable_ || UpgradeToShm());
+    CloseFd(listen_fd);
+    if (!ret) {
+      MS_LOG(ERROR) << "Connect the rank " << rank << " to the other ranks failed";
+      links_.clear();
+      return false;
+    }
+  }
+
+  std::vector<int> world_ranks;
+  for (int i = 0; i < size; ++i) {
+    world_ranks.push_back(i);
+  }
+  groups_.clear();
+  groups_[CPU_WORLD_GROUP] = {world_ranks, rank};
+  stop_ = false;
+  pending_sends_ = 0;
+  send_failed_ = false;
+  send_thread_ = std::thread(&CPUCollective::SendLoop, this);
+  initialized_ = true;
+
+  size_t shm_links = 0;
+  for (auto &link : links_) {
+    if (link != nullptr && link->type() == "shm") {
+      shm_links++;
+    }
+  }
+  MS_LOG(INFO) << "The cpu collective of the rank " << rank << " of " << size << " is initialized, " << shm_links
+               << " peers on the same host talk through shared memory";
+  return true;
+}
+
+void CPUCollective::Finalize() {
+  if (!initialized_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    stop_ = true;
+  }
+  send_cond_.notify_all();
+  if (send_thread_.joinable()) {
+    send_thread_.join();
+  }
+  links_.clear();
+  groups_.clear();
+  unmatched_messages_.clear();
+  initialized_ = false;
+  MS_LOG(INFO) << "The cpu collective of the rank " << rank_ << " is finalized";
+}
+
+std::string CPUCollective::link_type(int peer) const {
+  if (peer < 0 || peer >= SizeToInt(links_.size()) || links_[IntToSize(peer)] == nullptr) {
+    return "";
+  }
+  return links_[IntToSize(peer)]->type();
+}
+
+bool CPUCollective::Rendezvous(const std::string &master_addr, int master_port, int listen_port) {
+  PeerInfo self;
+  (void)memset_s(&self, sizeof(self), 0, sizeof(self));
+  self.rank = rank_;
+  self.port = listen_port;
+  if (gethostname(self.host, kHostBytes - 1) != 0) {
+    MS_LOG(ERROR) << "Get the host name failed";
+    return false;
+  }
+  std::vector<PeerInfo> table(IntToSize(size_));
+  int64_t job_id = 0;
+  if (rank_ == 0) {
+    int master_fd = ListenOn(master_port, size_, nullptr);
+    if (master_fd < 0) {
+      return false;
+    }
+    table[0] = self;
+    (void)strncpy_s(table[0].addr, kAddrBytes, master_addr.c_str(), kAddrBytes - 1);
+    std::vector<int> fds;
+    bool ret = true;
+    for (int i = 1; i < size_ && ret; ++i) {
+      std::string peer_addr;
+      int fd = AcceptFrom(master_fd, &peer_addr);
+      PeerInfo info;
+      ret = (fd >= 0) && RecvAll(fd, &info, sizeof(info));
+      if (ret && (info.rank <= 0 || info.rank >= size_ || table[IntToSize(info.rank)].rank != 0)) {
+        MS_LOG(ERROR) << "The rank " << info.rank << " joins twice or is out of the rank size " << size_;
+        ret = false;
+      }
+      if (ret) {
+        info.host[kHostBytes - 1] = '\0';
+        (void)strncpy_s(info.addr, kAddrBytes, peer_addr.c_str(), kAddrBytes - 1);
+        table[IntToSize(info.rank)] = info;
+      }
+      if (fd >= 0) {
+        fds.push_back(fd);
+      }
+    }
+    job_id = static_cast<int64_t>(getpid());
+    for (auto fd : fds) {
+      ret = ret && SendAll(fd, &job_id, sizeof(job_id)) && SendAll(fd, table.data(), table.size() * sizeof(PeerInfo));
+      CloseFd(fd);
+    }
+    CloseFd(master_fd);
+    if (!ret) {
+      return false;
+    }
+  } else {
+    int fd = ConnectTo(master_addr, master_port, kLinkTimeoutSeconds);
+    bool ret = (fd >= 0) && SendAll(fd, &self, sizeof(self)) && RecvAll(fd, &job_id, sizeof(job_id)) &&
+               RecvAll(fd, table.data(), table.size() * sizeof(PeerInfo));
+    CloseFd(fd);
+    if (!ret) {
+      MS_LOG(ERROR) << "The rendezvous at the master " << master_addr << ":" << master_port << " failed";
+      return false;
+    }
+  }
+
+  hosts_.clear();
+  addrs_.clear();
+  ports_.clear();
+  for (auto &info : table) {
+    hosts_.emplace_back(info.host);
+    addrs_.emplace_back(info.addr);
+    ports_.push_back(info.port);
+  }
+  job_ = std::to_string(master_port) + "_" + std::to_string(job_id);
+  return true;
+}
+
+// Every rank connects to the lower ranks and accepts the higher ones, the connections wait in the backlog of the
+// listen socket until they are accepted
+bool CPUCollective::ConnectPeers(int listen_fd) {
+  for (int peer = 0; peer < rank_; ++peer) {
+    int fd = ConnectTo(addrs_[IntToSize(peer)], ports_[IntToSize(peer)], kLinkTimeoutSeconds);
+    if (fd < 0) {
+      return false;
+    }
+    links_[IntToSize(peer)] = std::make_shared<TcpLink>(fd);
+    int32_t self = rank_;
+    if (!links_[IntToSize(peer)]->Send(&self, sizeof(self))) {
+      return false;
+    }
+  }
+  for (int i = rank_ + 1; i < size_; ++i) {
+    int fd = AcceptFrom(listen_fd, nullptr);
+    if (fd < 0) {
+      return false;
+    }
+    auto link = std::make_shared<TcpLink>(fd);
+    int32_t peer = -1;
+    if (!link->Recv(&peer, sizeof(peer))) {
+      return false;
+    }
+    if (peer <= rank_ || peer >= size_ || links_[IntToSize(peer)] != nullptr) {
+      MS_LOG(ERROR) << "The rank " << rank_ << " gets an unexpected connection from the rank " << peer;
+      return false;
+    }
+    links_[IntToSize(peer)] = link;
+  }
+  return true;
+}
+
+// The pairs of the ranks on the same host switch to shared memory one by one in the order of (lower rank, higher
+// rank), the lower rank creates the segment and the higher one opens it. A pair stays on TCP if that fails.
+bool CPUCollective::UpgradeToShm() {
+  for (int peer = 0; peer < size_; ++peer) {
+    if (peer == rank_ || hosts_[IntToSize(peer)] != hosts_[IntToSize(rank_)]) {
+      continue;
+    }
+    bool creator = rank_ < peer;
+    std::string name = "/ms_cpu_collective_" + job_ + "_" + std::to_string(std::min(rank_, peer)) + "_" +
+                       std::to_string(std::max(rank_, peer));
+    auto tcp = links_[IntToSize(peer)];
+    std::shared_ptr<ShmLink> shm = nullptr;
+    char created = 0;
+    char opened = 0;
+    if (creator) {
+      shm = ShmLink::Create(name, true);
+      created = (shm != nullptr) ? 1 : 0;
+      if (!tcp->Send(&created, sizeof(created))) {
+        return false;
+      }
+      if (created != 0) {
+        if (!tcp->Recv(&opened, sizeof(opened))) {
+          return false;
+        }
+        ShmLink::Unlink(name);
+      }
+    } else {
+      if (!tcp->Recv(&created, sizeof(created))) {
+        return false;
+      }
+      if (created != 0) {
+        shm = ShmLink::Create(name, false);
+        opened = (shm != nullptr) ? 1 : 0;
+        if (!tcp->Send(&opened, sizeof(opened))) {
+          return false;
+        }
+      }
+    }
+    if (created != 0 && opened != 0) {
+      links_[IntToSize(peer)] = shm;
+    } else {
+      MS_LOG(WARNING) << "The rank " << rank_ << " talks to the rank " << peer << " on the same host through TCP";
+    }
+  }
+  return true;
+}
+
+bool CPUCollective::CreateGroup(const std::string &group, const std::vector<unsigned int> &ranks) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  if (!initialized_) {
+    MS_LOG(ERROR) << "The cpu collective is not initialized";
+    return false;
+  }
+  if (group.empty() || group == CPU_WORLD_GROUP || groups_.find(group) != groups_.end()) {
+    MS_LOG(ERROR) << "The group name " << group << " is empty, the world group or already used";
+    return false;
+  }
+  std::set<unsigned int> rank_set(ranks.begin(), ranks.end());
+  if (ranks.empty() || rank_set.size() != ranks.size() || *rank_set.rbegin() >= IntToUint(size_)) {
+    MS_LOG(ERROR) << "The ranks of the group " << group << " are empty, duplicated or out of the rank size " << size_;
+    return false;
+  }
+  auto iter = std::find(ranks.begin(), ranks.end(), IntToUint(rank_));
+  if (iter == ranks.end()) {
+    MS_LOG(ERROR) << "The rank " << rank_ << " is not in the group " << group;
+    return false;
+  }
+  CollectiveGroup new_group;
+  (void)std::transform(ranks.begin(), ranks.end(), std::back_inserter(new_group.ranks),
+                       [](unsigned int rank) { return UintToInt(rank); });
+  new_group.rank = static_cast<int>(iter - ranks.begin());
+  groups_[group] = new_group;
+  MS_LOG(INFO) << "Create the group " << group << " of " << ranks.size() << " ranks";
+  return true;
+}
+
+bool CPUCollective::DestroyGroup(const std::string &group) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  if (group == CPU_WORLD_GROUP || groups_.erase(group) == 0) {
+    MS_LOG(ERROR) << "The group " << group << " is the world group or does not exist";
+    return false;
+  }
+  return true;
+}
+
+bool CPUCollective::GetRankId(const std::string &group, unsigned int *rank_id) const {
+  MS_EXCEPTION_IF_NULL(rank_id);
+  auto found = FindGroup(group);
+  if (found == nullptr) {
+    return false;
+  }
+  *rank_id = IntToUint(found->rank);
+  return true;
+}
+
+bool CPUCollective::GetRankSize(const std::string &group, unsigned int *rank_size) const {
+  MS_EXCEPTION_IF_NULL(rank_size);
+  auto found = FindGroup(group);
+  if (found == nullptr) {
+    return false;
+  }
+  *rank_size = SizeToUint(found->ranks.size());
+  return true;
+}
+
+const CollectiveGroup *CPUCollective::FindGroup(const std::string &group) const {
+  if (!initialized_) {
+    MS_LOG(ERROR) << "The cpu collective is not initialized";
+    return nullptr;
+  }
+  auto iter = groups_.find(group);
+  if (iter == groups_.end()) {
+    MS_LOG(ERROR) << "The group " << group << " does not exist";
+    return nullptr;
+  }
+  return &iter->second;
+}
+
+Link *CPUCollective::GroupLink(const CollectiveGroup &group, int group_rank) const {
+  return links_[IntToSize(group.ranks[IntToSize(group_rank)])].get();
+}
+
+Link *CPUCollective::PeerLink(int peer) const {
+  if (peer < 0 || peer >= size_ || peer == rank_ || links_[IntToSize(peer)] == nullptr) {
+    MS_LOG(ERROR) << "The rank " << rank_ << " has no link to the rank " << peer;
+    return nullptr;
+  }
+  return links_[IntToSize(peer)].get();
+}
+
+bool CPUCollective::UseHalving(size_t bytes, const CollectiveGroup &group) const {
+  return IsPowerOfTwo(group.ranks.size()) && bytes <= halving_max_bytes_;
+}
+
+size_t CPUCollective::ChunkBytes(TypeId type) const {
+  size_t type_bytes = TypeBytes(type);
+  return std::max(chunk_bytes_ / type_bytes * type_bytes, type_bytes);
+}
+
+bool CPUCollective::AllReduce(const void *input, void *output, size_t count, TypeId type, CollectiveReduceOp op,
+                              const std::string &group) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  auto found = FindGroup(group);
+  if (found == nullptr || TypeBytes(type) == 0) {
+    MS_LOG(ERROR) << "AllReduce of the type " << type << " in the group " << group << " is not supported";
+    return false;
+  }
+  size_t type_bytes = TypeBytes(type);
+  auto buffer = static_cast<char *>(output);
+  if (!CopyBuffer(buffer, input, count * type_bytes)) {
+    return false;
+  }
+  size_t ranks = found->ranks.size();
+  if (ranks == 1 || count == 0) {
+    return true;
+  }
+  // the elements are split evenly among the ranks
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i <= ranks; ++i) {
+    offsets.push_back(count * i / ranks * type_bytes);
+  }
+  if (UseHalving(count * type_bytes, *found)) {
+    return HalvingReduceScatter(buffer, offsets, type, op, *found) && DoublingAllGather(buffer, offsets, type, *found);
+  }
+  return RingReduceScatter(buffer, offsets, type, op, *found) && RingAllGather(buffer, offsets, type, *found);
+}
+
+bool CPUCollective::AllGather(const void *input, void *output, size_t count, TypeId type, const std::string &group) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  auto found = FindGroup(group);
+  if (found == nullptr || TypeBytes(type) == 0) {
+    MS_LOG(ERROR) << "AllGather of the type " << type << " in the group " << group << " is not supported";
+    return false;
+  }
+  size_t bytes = count * TypeBytes(type);
+  size_t ranks = found->ranks.size();
+  auto buffer = static_cast<char *>(output);
+  if (!CopyBuffer(buffer + IntToSize(found->rank) * bytes, input, bytes)) {
+    return false;
+  }
+  if (ranks == 1 || count == 0) {
+    return true;
+  }
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i <= ranks; ++i) {
+    offsets.push_back(i * bytes);
+  }
+  if (UseHalving(ranks * bytes, *found)) {
+    return DoublingAllGather(buffer, offsets, type, *found);
+  }
+  return RingAllGather(buffer, offsets, type, *found);
+}
+
+bool CPUCollective::ReduceScatter(const void *input, void *output, size_t count, TypeId type, CollectiveReduceOp op,
+                                  const std::string &group) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  auto found = FindGroup(group);
+  if (found == nullptr || TypeBytes(type) == 0) {
+    MS_LOG(ERROR) << "ReduceScatter of the type " << type << " in the group " << group << " is not supported";
+    return false;
+  }
+  size_t bytes = count * TypeBytes(type);
+  size_t ranks = found->ranks.size();
+  if (ranks == 1 || count == 0) {
+    return CopyBuffer(output, input, bytes);
+  }
+  // the input is kept, the segments are reduced in the work buffer
+  work_buffer_.resize(ranks * bytes);
+  if (!CopyBuffer(work_buffer_.data(), input, ranks * bytes)) {
+    return false;
+  }
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i <= ranks; ++i) {
+    offsets.push_back(i * bytes);
+  }
+  bool ret = UseHalving(ranks * bytes, *found) ? HalvingReduceScatter(work_buffer_.data(), offsets, type, op, *found)
+                                                : RingReduceScatter(work_buffer_.data(), offsets, type, op, *found);
+  return ret && CopyBuffer(output, work_buffer_.data() + offsets[IntToSize(found->rank)], bytes);
+}
+
+bool CPUCollective::Broadcast(const void *input, void *output, size_t count, TypeId type, int root,
+                              const std::string &group) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  auto found = FindGroup(group);
+  if (found == nullptr || TypeBytes(type) == 0) {
+    MS_LOG(ERROR) << "Broadcast of the type " << type << " in the group " << group << " is not supported";
+    return false;
+  }
+  if (root < 0 || root >= SizeToInt(found->ranks.size())) {
+    MS_LOG(ERROR) << "The root " << root << " is out of the group " << group;
+    return false;
+  }
+  size_t bytes = count * TypeBytes(type);
+  auto buffer = static_cast<char *>(output);
+  if (found->rank == root && !CopyBuffer(buffer, input, bytes)) {
+    return false;
+  }
+  if (found->ranks.size() == 1 || count == 0) {
+    return true;
+  }
+  return ChainBroadcast(buffer, bytes, type, root, *found);
+}
+
+bool CPUCollective::Send(const void *input, size_t count, TypeId type, int dest_rank, int tag) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  if (!initialized_ || TypeBytes(type) == 0) {
+    MS_LOG(ERROR) << "Send of the type " << type << " is not supported or the cpu collective is not initialized";
+    return false;
+  }
+  Link *link = PeerLink(dest_rank);
+  if (link == nullptr) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> send_lock(send_mutex_);
+    if (send_failed_) {
+      MS_LOG(ERROR) << "A previous send of the rank " << rank_ << " failed";
+      return false;
+    }
+  }
+  size_t bytes = count * TypeBytes(type);
+  MessageHeader header = {tag, 0, static_cast<uint64_t>(bytes)};
+  auto message = std::make_shared<std::vector<char>>(sizeof(header) + bytes);
+  if (!CopyBuffer(message->data(), &header, sizeof(header)) ||
+      !CopyBuffer(message->data() + sizeof(header), input, bytes)) {
+    return false;
+  }
+  EnqueueSend(link, message->data(), message->size(), message);
+  return true;
+}
+
+bool CPUCollective::Recv(void *output, size_t count, TypeId type, int src_rank, int tag) {
+  std::lock_guard<std::mutex> lock(collective_mutex_);
+  if (!initialized_ || TypeBytes(type) == 0) {
+    MS_LOG(ERROR) << "Recv of the type " << type << " is not supported or the cpu collective is not initialized";
+    return false;
+  }
+  Link *link = PeerLink(src_rank);
+  if (link == nullptr) {
+    return false;
+  }
+  size_t bytes = count * TypeBytes(type);
+  auto key = std::make_pair(src_rank, tag);
+  auto iter = unmatched_messages_.find(key);
+  if (iter != unmatched_messages_.end()) {
+    auto message = std::move(iter->second.front());
+    iter->second.pop_front();
+    if (iter->second.empty()) {
+      (void)unmatched_messages_.erase(iter);
+    }
+    if (message.size() != bytes) {
+      MS_LOG(ERROR) << "The rank " << rank_ << " expects " << bytes << " bytes of the tag " << tag << " from the rank "
+                    << src_rank << ", but gets " << message.size() << " bytes";
+      return false;
+    }
+    return CopyBuffer(output, message.data(), bytes);
+  }
+  while (true) {
+    MessageHeader header;
+    if (!link->Recv(&header, sizeof(header))) {
+      return false;
+    }
+    if (header.tag == tag && header.bytes == static_cast<uint64_t>(bytes)) {
+      return link->Recv(output, bytes);
+    }
+    // the message is read off the link even if its size is wrong, so the link stays usable
+    std::vector<char> message(static_cast<size_t>(header.bytes));
+    if (!link->Recv(message.data(), message.size())) {
+      return false;
+    }
+    if (header.tag == tag) {
+      MS_LOG(ERROR) << "The rank " << rank_ << " expects " << bytes << " bytes of the tag " << tag << " from the rank "
+                    << src_rank << ", but gets " << header.bytes << " bytes";
+      return false;
+    }
+    unmatched_messages_[std::make_pair(src_rank, header.tag)].push_back(std::move(message));
+  }
+}
+
+// At the step s the rank r sends the segment r - s - 1 to the next rank and reduces the segment r - s - 2 from the
+// previous one, which it sends at the step s + 1. The chunks are forwarded as soon as they are reduced, so the steps
+// overlap.
+bool CPUCollective::RingReduceScatter(char *buffer, const std::vector<size_t> &offsets, TypeId type,
+                                      CollectiveReduceOp op, const CollectiveGroup &group) {
+  int ranks = SizeToInt(group.ranks.size());
+  int rank = group.rank;
+  Link *next = GroupLink(group, SegmentIndex(rank + 1, ranks));
+  Link *prev = GroupLink(group, SegmentIndex(rank - 1, ranks));
+  size_t first = IntToSize(SegmentIndex(rank - 1, ranks));
+  EnqueueSendChunks(next, buffer + offsets[first], offsets[first + 1] - offsets[first], type);
+  bool ret = true;
+  for (int step = 0; step < ranks - 1 && ret; ++step) {
+    size_t segment = IntToSize(SegmentIndex(rank - step - 2, ranks));
+    bool forward = (step < ranks - 2);
+    ret = RecvChunks(prev, buffer + offsets[segment], offsets[segment + 1] - offsets[segment], type, true, op,
+                     [this, next, forward](const char *data, size_t bytes) {
+                       if (forward) {
+                         EnqueueSend(next, data, bytes);
+                       }
+                     });
+  }
+  return WaitSends() && ret;
+}
+
+// At the step s the rank r sends the segment r - s to the next rank and receives the segment r - s - 1
+bool CPUCollective::RingAllGather(char *buffer, const std::vector<size_t> &offsets, TypeId type,
+                                  const CollectiveGroup &group) {
+  int ranks = SizeToInt(group.ranks.size());
+  int rank = group.rank;
+  Link *next = GroupLink(group, SegmentIndex(rank + 1, ranks));
+  Link *prev = GroupLink(group, SegmentIndex(rank - 1, ranks));
+  size_t first = IntToSize(rank);
+  EnqueueSendChunks(next, buffer + offsets[first], offsets[first + 1] - offsets[first], type);
+  bool ret = true;
+  for (int step = 0; step < ranks - 1 && ret; ++step) {
+    size_t segment = IntToSize(SegmentIndex(rank - step - 1, ranks));
+    bool forward = (step < ranks - 2);
+    ret = RecvChunks(prev, buffer + offsets[segment], offsets[segment + 1] - offsets[segment], type, false,
+                     kCollectiveSum, [this, next, forward](const char *data, size_t bytes) {
+                       if (forward) {
+                         EnqueueSend(next, data, bytes);
+                       }
+                     });
+  }
+  return WaitSends() && ret;
+}
+
+// The rank exchanges half of its segments with the rank differing in one bit, from the highest bit down, and keeps
+// the half of its own bit. After log(n) steps it holds its own segment reduced.
+bool CPUCollective::HalvingReduceScatter(char *buffer, const std::vector<size_t> &offsets, TypeId type,
+                                         CollectiveReduceOp op, const CollectiveGroup &group) {
+  int ranks = SizeToInt(group.ranks.size());
+  int rank = group.rank;
+  size_t low = 0;
+  size_t high = IntToSize(ranks);
+  bool ret = true;
+  for (int mask = ranks / 2; mask >= 1 && ret; mask >>= 1) {
+    Link *peer = GroupLink(group, rank ^ mask);
+    size_t middle = low + (high - low) / 2;
+    bool upper = (rank & mask) != 0;
+    size_t send_low = upper ? low : middle;
+    size_t send_high = upper ? middle : high;
+    low = upper ? middle : low;
+    high = upper ? high : middle;
+    EnqueueSendChunks(peer, buffer + offsets[send_low], offsets[send_high] - offsets[send_low], type);
+    ret = RecvChunks(peer, buffer + offsets[low], offsets[high] - offsets[low], type, true, op,
+                     [](const char *, size_t) {});
+  }
+  return WaitSends() && ret;
+}
+
+// The rank exchanges the segments it holds with the rank differing in one bit, from the lowest bit up
+bool CPUCollective::DoublingAllGather(char *buffer, const std::vector<size_t> &offsets, TypeId type,
+                                      const CollectiveGroup &group) {
+  int ranks = SizeToInt(group.ranks.size());
+  int rank = group.rank;
+  bool ret = true;
+  for (int mask = 1; mask < ranks && ret; mask <<= 1) {
+    int peer_rank = rank ^ mask;
+    size_t low = IntToSize(rank & ~(mask - 1));
+    size_t peer_low = IntToSize(peer_rank & ~(mask - 1));
+    size_t blocks = IntToSize(mask);
+    Link *peer = GroupLink(group, peer_rank);
+    EnqueueSendChunks(peer, buffer + offsets[low], offsets[low + blocks] - offsets[low], type);
+    ret = RecvChunks(peer, buffer + offsets[peer_low], offsets[peer_low + blocks] - offsets[peer_low], type, false,
+                     kCollectiveSum, [](const char *, size_t) {});
+  }
+  return WaitSends() && ret;
+}
+
+// The ranks form a chain from the root, every rank forwards a chunk to the next one once it is received
+bool CPUCollective::ChainBroadcast(char *buffer, size_t bytes, TypeId type, int root, const CollectiveGroup &group) {
+  int ranks = SizeToInt(group.ranks.size());
+  int rank = group.rank;
+  int position = SegmentIndex(rank - root, ranks);
+  Link *next = (position < ranks - 1) ? GroupLink(group, SegmentIndex(rank + 1, ranks)) : nullptr;
+  bool ret = true;
+  if (position == 0) {
+    EnqueueSendChunks(next, buffer, bytes, type);
+  } else {
+    Link *prev = GroupLink(group, SegmentIndex(rank - 1, ranks));
+    ret = RecvChunks(prev, buffer, bytes, type, false, kCollectiveSum, [this, next](const char *data, size_t size) {
+      if (next != nullptr) {
+        EnqueueSend(next, data, size);
+      }
+    });
+  }
+  return WaitSends() && ret;
+}
+
+template <typename Forward>
+bool CPUCollective::RecvChunks(Link *link, char *buffer, size_t bytes, TypeId type, bool reduce,
+                               CollectiveReduceOp op, Forward forward) {
+  MS_EXCEPTION_IF_NULL(link);
+  size_t chunk = ChunkBytes(type);
+  if (reduce && recv_buffer_.size() < chunk) {
+    recv_buffer_.resize(chunk);
+  }
+  for (size_t offset = 0; offset < bytes; offset += chunk) {
+    size_t size = std::min(chunk, bytes - offset);
+    if (reduce) {
+      if (!link->Recv(recv_buffer_.data(), size)) {
+        return false;
+      }
+      ReduceBuffer(buffer + offset, recv_buffer_.data(), size, type, op);
+    } else if (!link->Recv(buffer + offset, size)) {
+      return false;
+    }
+    forward(buffer + offset, size);
+  }
+  return true;
+}
+
+void CPUCollective::EnqueueSend(Link *link, const char *data, size_t bytes,
+                                const std::shared_ptr<std::vector<char>> &owner) {
+  MS_EXCEPTION_IF_NULL(link);
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    send_tasks_.push_back({link, data, bytes, owner});
+    pending_sends_++;
+  }
+  send_cond_.notify_one();
+}
+
+void CPUCollective::EnqueueSendChunks(Link *link, const char *data, size_t bytes, TypeId type) {
+  size_t chunk = ChunkBytes(type);
+  for (size_t offset = 0; offset < bytes; offset += chunk) {
+    EnqueueSend(link, data + offset, std::min(chunk, bytes - offset));
+  }
+}
+
+bool CPUCollective::WaitSends() {
+  std::unique_lock<std::mutex> lock(send_mutex_);
+  send_done_cond_.wait(lock, [this] { return pending_sends_ == 0; });
+  bool ret = !send_failed_;
+  send_failed_ = false;
+  return ret;
+}
+
+// The tasks after a failed send are dropped, the collective fails once they are all done
+void CPUCollective::SendLoop() {
+  while (true) {
+    SendTask task;
+    bool failed = false;
+    {
+      std::unique_lock<std::mutex> lock(send_mutex_);
+      send_cond_.wait(lock, [this] { return stop_ || !send_tasks_.empty(); });
+      if (send_tasks_.empty()) {
+        return;
+      }
+      task = send_tasks_.front();
+      send_tasks_.pop_front();
+      failed = send_failed_;
+    }
+    bool ret = !failed && task.link->Send(task.data, task.bytes);
+    {
+      std::lock_guard<std::mutex> lock(send_mutex_);
+      send_failed_ = send_failed_ || !ret;
+      pending_sends_--;
+      if (pending_sends_ == 0) {
+        send_done_cond_.notify_all();
+      }
+    }
+  }
+}
+
+void InitCPUCollective() {
+  int rank = 0;
+  int size = 0;
+  int master_port = 0;
+  if (!GetEnvInt("RANK_ID", &rank) || !GetEnvInt("RANK_SIZE", &size) || !GetEnvInt("MASTER_PORT", &master_port)) {
+    MS_LOG(EXCEPTION) << "The environment variables RANK_ID, RANK_SIZE and MASTER_PORT should be integers";
+  }
+  const char *master_addr = getenv("MASTER_ADDR");
+  const char *shm = getenv("MS_CPU_COLLECTIVE_SHM");
+  CPUCollective::instance().set_shm_enable(shm == nullptr || std::string(shm) != "0");
+  if (!CPUCollective::instance().Init(rank, size, (master_addr == nullptr) ? "127.0.0.1" : master_addr,
+                                      master_port)) {
+    MS_LOG(EXCEPTION) << "Init the cpu collective of the rank " << rank << " failed";
+  }
+}
+
+void FinalizeCPUCollective() { CPUCollective::instance().Finalize(); }
+
+unsigned int GetCPUCollectiveRankId(const std::string &group) {
+  unsigned int rank_id = 0;
+  if (!CPUCollective::instance().GetRankId(group, &rank_id)) {
+    MS_LOG(EXCEPTION) << "Get the rank id of the group " << group << " failed";
+  }
+  return rank_id;
+}
+
+unsigned int GetCPUCollectiveRankSize(const std::string &group) {
+  unsigned int rank_size = 0;
+  if (!CPUCollective::instance().GetRankSize(group, &rank_size)) {
+    MS_LOG(EXCEPTION) << "Get the rank size of the group " << group << " failed";
+  }
+  return rank_size;
+}
+
+void CreateCPUCollectiveGroup(const std::string &group, const std::vector<unsigned int> &ranks) {
+  if (!CPUCollective::instance().CreateGroup(group, ranks)) {
+    MS_LOG(EXCEPTION) << "Create the group " << group << " failed";
+  }
+}
+
+void DestroyCPUCollectiveGroup(const std::string &group) {
+  if (!CPUCollective::instance().DestroyGroup(group)) {
+    MS_LOG(EXCEPTION) << "Destroy the group " << group << " failed";
+  }
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
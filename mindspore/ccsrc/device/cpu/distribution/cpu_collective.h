@@ -0,0 +1,193 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_DISTRIBUTION_CPU_COLLECTIVE_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_DISTRIBUTION_CPU_COLLECTIVE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "device/cpu/distribution/cpu_transport.h"
+#include "ir/dtype/type.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+constexpr char CPU_WORLD_GROUP[] = "cpu_world_group";
+// The messages are sent in chunks, a rank forwards a chunk as soon as it is received and reduced
+constexpr size_t kDefaultChunkBytes = 128 * 1024;
+// The recursive halving and doubling is used below this size when the group size is a power of 2, the ring above it
+constexpr size_t kDefaultHalvingMaxBytes = 1024 * 1024;
+
+enum CollectiveReduceOp { kCollectiveSum, kCollectiveMax, kCollectiveMin, kCollectiveProd };
+
+// Parse the op of the communication primitives, "sum", "max", "min" or "prod"
+bool GetCollectiveReduceOp(const std::string &op_name, CollectiveReduceOp *op);
+
+struct CollectiveGroup {
+  // the world ranks of the group
+  std::vector<int> ranks;
+  // the rank in the group
+  int rank;
+};
+
+// The collective communication of the processes on the CPU. The processes meet at the master address, where the
+// rank 0 listens, and then connect to each other. The processes on the same host talk through shared memory and the
+// others through TCP.
+class CPUCollective {
+ public:
+  CPUCollective(CPUCollective const &) = delete;
+  CPUCollective &operator=(const CPUCollective &) = delete;
+  static CPUCollective &instance();
+
+  bool Init(int rank, int size, const std::string &master_addr, int master_port);
+  void Finalize();
+  bool initialized() const { return initialized_; }
+  int rank() const { return rank_; }
+  int size() const { return size_; }
+  // The link type of the peer, "tcp" or "shm"
+  std::string link_type(int peer) const;
+
+  // Set before Init, the processes on the same host use TCP as well if disabled
+  void set_shm_enable(bool shm_enable) { shm_enable_ = shm_enable; }
+  void set_chunk_bytes(size_t chunk_bytes) { chunk_bytes_ = chunk_bytes; }
+  void set_halving_max_bytes(size_t halving_max_bytes) { halving_max_bytes_ = halving_max_bytes; }
+
+  // The groups must be created by all of their members in the same order
+  bool CreateGroup(const std::string &group, const std::vector<unsigned int> &ranks);
+  bool DestroyGroup(const std::string &group);
+  bool GetRankId(const std::string &group, unsigned int *rank_id) const;
+  bool GetRankSize(const std::string &group, unsigned int *rank_size) const;
+
+  // The count is the number of the elements of the input. The input and the output may be the same buffer.
+  bool AllReduce(const void *input, void *output, size_t count, TypeId type, CollectiveReduceOp op,
+                 const std::string &group);
+  // The output is the inputs of the ranks of the group in their order
+  bool AllGather(const void *input, void *output, size_t count, TypeId type, const std::string &group);
+  // The count is the number of the elements of the output, the input has count elements for every rank
+  bool ReduceScatter(const void *input, void *output, size_t count, TypeId type, CollectiveReduceOp op,
+                     const std::string &group);
+  // The root is the rank in the group
+  bool Broadcast(const void *input, void *output, size_t count, TypeId type, int root, const std::string &group);
+
+  // The point to point messages between the pipeline stages, the peers are the world ranks. The input is copied and
+  // the send returns once it is queued, so two ranks may send to each other at the same time; a failed send fails the
+  // next send or collective. A receive gets the message of its tag from the peer, the messages of the other tags that
+  // come first are kept for their receives. The ranks must not run a collective between a send and its receive.
+  bool Send(const void *input, size_t count, TypeId type, int dest_rank, int tag);
+  bool Recv(void *output, size_t count, TypeId type, int src_rank, int tag);
+
+ private:
+  CPUCollective()
+      : initialized_(false),
+        rank_(-1),
+        size_(0),
+        shm_enable_(true),
+        chunk_bytes_(kDefaultChunkBytes),
+        halving_max_bytes_(kDefaultHalvingMaxBytes),
+        stop_(false),
+        pending_sends_(0),
+        send_failed_(false) {}
+  ~CPUCollective();
+
+  // Exchange the hosts and the listen ports of the ranks through the rank 0
+  bool Rendezvous(const std::string &master_addr, int master_port, int listen_port);
+  bool ConnectPeers(int listen_fd);
+  bool UpgradeToShm();
+  const CollectiveGroup *FindGroup(const std::string &group) const;
+  Link *GroupLink(const CollectiveGroup &group, int group_rank) const;
+  Link *PeerLink(int peer) const;
+
+  // The algorithms run in place on the buffer holding the segments of all the ranks, the offsets are the bytes where
+  // the segments begin followed by the total bytes. After a reduce scatter each rank holds the reduced segment of its
+  // own rank, an allgather starts from that.
+  bool RingReduceScatter(char *buffer, const std::vector<size_t> &offsets, TypeId type, CollectiveReduceOp op,
+                         const CollectiveGroup &group);
+  bool RingAllGather(char *buffer, const std::vector<size_t> &offsets, TypeId type, const CollectiveGroup &group);
+  bool HalvingReduceScatter(char *buffer, const std::vector<size_t> &offsets, TypeId type, CollectiveReduceOp op,
+                            const CollectiveGroup &group);
+  bool DoublingAllGather(char *buffer, const std::vector<size_t> &offsets, TypeId type, const CollectiveGroup &group);
+  bool ChainBroadcast(char *buffer, size_t bytes, TypeId type, int root, const CollectiveGroup &group);
+  bool UseHalving(size_t bytes, const CollectiveGroup &group) const;
+  size_t ChunkBytes(TypeId type) const;
+  // Receive the bytes chunk by chunk, reduce every chunk into the buffer and call forward on it
+  template <typename Forward>
+  bool RecvChunks(Link *link, char *buffer, size_t bytes, TypeId type, bool reduce, CollectiveReduceOp op,
+                  Forward forward);
+
+  // The sends run on the send thread, so that a rank sends and receives at the same time
+  // The owner keeps the data of an asynchronous send until it is sent
+  void EnqueueSend(Link *link, const char *data, size_t bytes,
+                   const std::shared_ptr<std::vector<char>> &owner = nullptr);
+  void EnqueueSendChunks(Link *link, const char *data, size_t bytes, TypeId type);
+  bool WaitSends();
+  void SendLoop();
+
+  struct SendTask {
+    Link *link;
+    const char *data;
+    size_t bytes;
+    std::shared_ptr<std::vector<char>> owner;
+  };
+
+  bool initialized_;
+  int rank_;
+  int size_;
+  bool shm_enable_;
+  size_t chunk_bytes_;
+  size_t halving_max_bytes_;
+  std::vector<std::string> hosts_;
+  std::vector<std::string> addrs_;
+  std::vector<int> ports_;
+  // unique to the job, it names the shared memory segments
+  std::string job_;
+  std::vector<LinkPtr> links_;
+  std::map<std::string, CollectiveGroup> groups_;
+  // the point to point messages received before their receives, by the source rank and the tag
+  std::map<std::pair<int, int>, std::deque<std::vector<char>>> unmatched_messages_;
+  std::vector<char> recv_buffer_;
+  std::vector<char> work_buffer_;
+  std::mutex collective_mutex_;
+
+  std::thread send_thread_;
+  std::mutex send_mutex_;
+  std::condition_variable send_cond_;
+  std::condition_variable send_done_cond_;
+  std::deque<SendTask> send_tasks_;
+  bool stop_;
+  size_t pending_sends_;
+  bool send_failed_;
+};
+
+// The entries of the python api, they raise on failure. The rendezvous is given by the environment variables
+// RANK_ID, RANK_SIZE, MASTER_ADDR and MASTER_PORT.
+void InitCPUCollective();
+void FinalizeCPUCollective();
+unsigned int GetCPUCollectiveRankId(const std::string &group);
+unsigned int GetCPUCollectiveRankSize(const std::string &group);
+void CreateCPUCollectiveGroup(const std::string &group, const std::vector<unsigned int> &ranks);
+void DestroyCPUCollectiveGroup(const std::string &group);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_DISTRIBUTION_CPU_COLLECTIVE_H_
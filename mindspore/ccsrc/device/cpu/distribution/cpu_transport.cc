@@ -0,0 +1,322 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "device/cpu/distribution/cpu_transport.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+namespace {
+constexpr size_t kSpinCount = 1 << 12;
+constexpr int64_t kSleepAfterUs = 1000;
+constexpr int kSleepUs = 20;
+constexpr int kConnectRetryMs = 100;
+
+// Spin first since the peer is usually a few microseconds behind, then yield and finally sleep on long waits
+class Backoff {
+ public:
+  Backoff() : spins_(0), start_(std::chrono::steady_clock::now()) {}
+  ~Backoff() = default;
+  // Return false once the wait times out
+  bool Wait() {
+    ++spins_;
+    if (spins_ < kSpinCount) {
+      return true;
+    }
+    if ((spins_ & 0xff) == 0) {
+      auto waited = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_);
+      if (waited.count() > static_cast<int64_t>(kLinkTimeoutSeconds) * 1000000) {
+        return false;
+      }
+      if (waited.count() > kSleepAfterUs) {
+        (void)usleep(kSleepUs);
+        return true;
+      }
+    }
+    std::this_thread::yield();
+    return true;
+  }
+  void Reset() {
+    spins_ = 0;
+    start_ = std::chrono::steady_clock::now();
+  }
+
+ private:
+  size_t spins_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+void SetNoDelay(int fd) {
+  int on = 1;
+  (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+}  // namespace
+
+bool SendAll(int fd, const void *data, size_t size) {
+  auto buf = static_cast<const char *>(data);
+  while (size > 0) {
+    ssize_t ret = send(fd, buf, size, MSG_NOSIGNAL);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      MS_LOG(ERROR) << "Send to the socket " << fd << " failed: " << strerror(errno);
+      return false;
+    }
+    buf += ret;
+    size -= static_cast<size_t>(ret);
+  }
+  return true;
+}
+
+bool RecvAll(int fd, void *data, size_t size) {
+  auto buf = static_cast<char *>(data);
+  while (size > 0) {
+    ssize_t ret = recv(fd, buf, size, 0);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret == 0) {
+      MS_LOG(ERROR) << "The peer of the socket " << fd << " is closed";
+      return false;
+    }
+    if (ret < 0) {
+      MS_LOG(ERROR) << "Receive from the socket " << fd << " failed: " << strerror(errno);
+      return false;
+    }
+    buf += ret;
+    size -= static_cast<size_t>(ret);
+  }
+  return true;
+}
+
+int ListenOn(int port, int backlog, int *bound_port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Create the socket failed: " << strerror(errno);
+    return -1;
+  }
+  int on = 1;
+  (void)setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  struct sockaddr_in addr;
+  (void)memset_s(&addr, sizeof(addr), 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || listen(fd, backlog) != 0) {
+    MS_LOG(ERROR) << "Listen on the port " << port << " failed: " << strerror(errno);
+    CloseFd(fd);
+    return -1;
+  }
+  socklen_t len = sizeof(addr);
+  if (bound_port != nullptr) {
+    if (getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len) != 0) {
+      MS_LOG(ERROR) << "Get the port of the socket failed: " << strerror(errno);
+      CloseFd(fd);
+      return -1;
+    }
+    *bound_port = ntohs(addr.sin_port);
+  }
+  return fd;
+}
+
+int ConnectTo(const std::string &addr, int port, int timeout_seconds) {
+  struct addrinfo hints;
+  (void)memset_s(&hints, sizeof(hints), 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *result = nullptr;
+  if (getaddrinfo(addr.c_str(), std::to_string(port).c_str(), &hints, &result) != 0 || result == nullptr) {
+    MS_LOG(ERROR) << "Resolve the address " << addr << " failed";
+    return -1;
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout_seconds);
+  int fd = -1;
+  while (true) {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) == 0) {
+      break;
+    }
+    CloseFd(fd);
+    fd = -1;
+    if (std::chrono::steady_clock::now() > deadline) {
+      MS_LOG(ERROR) << "Connect to " << addr << ":" << port << " failed: " << strerror(errno);
+      break;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kConnectRetryMs));
+  }
+  freeaddrinfo(result);
+  if (fd >= 0) {
+    SetNoDelay(fd);
+  }
+  return fd;
+}
+
+int AcceptFrom(int listen_fd, std::string *peer_addr) {
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  int fd = -1;
+  do {
+    fd = accept(listen_fd, reinterpret_cast<struct sockaddr *>(&addr), &len);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Accept on the socket " << listen_fd << " failed: " << strerror(errno);
+    return -1;
+  }
+  SetNoDelay(fd);
+  if (peer_addr != nullptr) {
+    char buf[INET_ADDRSTRLEN] = {0};
+    if (inet_ntop(AF_INET, &addr.sin_addr, buf, sizeof(buf)) == nullptr) {
+      MS_LOG(ERROR) << "Get the address of the peer failed: " << strerror(errno);
+      CloseFd(fd);
+      return -1;
+    }
+    *peer_addr = buf;
+  }
+  return fd;
+}
+
+void CloseFd(int fd) {
+  if (fd >= 0) {
+    (void)close(fd);
+  }
+}
+
+TcpLink::~TcpLink() { CloseFd(fd_); }
+
+bool TcpLink::Send(const void *data, size_t size) { return SendAll(fd_, data, size); }
+
+bool TcpLink::Recv(void *data, size_t size) { return RecvAll(fd_, data, size); }
+
+std::shared_ptr<ShmLink> ShmLink::Create(const std::string &name, bool creator) {
+  const size_t segment_bytes = 2 * sizeof(ShmRing);
+  int fd = creator ? shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600) : shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open the shared memory " << name << " failed: " << strerror(errno);
+    return nullptr;
+  }
+  if (creator && ftruncate(fd, static_cast<off_t>(segment_bytes)) != 0) {
+    MS_LOG(ERROR) << "Resize the shared memory " << name << " failed: " << strerror(errno);
+    CloseFd(fd);
+    (void)shm_unlink(name.c_str());
+    return nullptr;
+  }
+  void *addr = mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  CloseFd(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map the shared memory " << name << " failed: " << strerror(errno);
+    if (creator) {
+      (void)shm_unlink(name.c_str());
+    }
+    return nullptr;
+  }
+  auto rings = static_cast<ShmRing *>(addr);
+  if (creator) {
+    for (size_t i = 0; i < 2; ++i) {
+      (void)new (&rings[i].head) std::atomic<uint64_t>(0);
+      (void)new (&rings[i].tail) std::atomic<uint64_t>(0);
+    }
+  }
+  ShmRing *send_ring = creator ? &rings[0] : &rings[1];
+  ShmRing *recv_ring = creator ? &rings[1] : &rings[0];
+  return std::shared_ptr<ShmLink>(new ShmLink(addr, send_ring, recv_ring));
+}
+
+void ShmLink::Unlink(const std::string &name) { (void)shm_unlink(name.c_str()); }
+
+ShmLink::~ShmLink() { (void)munmap(addr_, 2 * sizeof(ShmRing)); }
+
+bool ShmLink::Send(const void *data, size_t size) {
+  auto src = static_cast<const char *>(data);
+  uint64_t head = send_ring_->head.load(std::memory_order_relaxed);
+  Backoff backoff;
+  size_t done = 0;
+  while (done < size) {
+    uint64_t tail = send_ring_->tail.load(std::memory_order_acquire);
+    size_t space = kShmRingBytes - static_cast<size_t>(head - tail);
+    if (space == 0) {
+      if (!backoff.Wait()) {
+        MS_LOG(ERROR) << "Send to the shared memory link timed out";
+        return false;
+      }
+      continue;
+    }
+    size_t bytes = std::min(space, size - done);
+    size_t pos = static_cast<size_t>(head % kShmRingBytes);
+    size_t first = std::min(bytes, kShmRingBytes - pos);
+    if (memcpy_s(send_ring_->data + pos, first, src + done, first) != EOK ||
+        (bytes > first && memcpy_s(send_ring_->data, bytes - first, src + done + first, bytes - first) != EOK)) {
+      MS_LOG(ERROR) << "Copy to the shared memory link failed";
+      return false;
+    }
+    head += bytes;
+    send_ring_->head.store(head, std::memory_order_release);
+    done += bytes;
+    backoff.Reset();
+  }
+  return true;
+}
+
+bool ShmLink::Recv(void *data, size_t size) {
+  auto dst = static_cast<char *>(data);
+  uint64_t tail = recv_ring_->tail.load(std::memory_order_relaxed);
+  Backoff backoff;
+  size_t done = 0;
+  while (done < size) {
+    uint64_t head = recv_ring_->head.load(std::memory_order_acquire);
+    size_t ready = static_cast<size_t>(head - tail);
+    if (ready == 0) {
+      if (!backoff.Wait()) {
+        MS_LOG(ERROR) << "Receive from the shared memory link timed out";
+        return false;
+      }
+      continue;
+    }
+    size_t bytes = std::min(ready, size - done);
+    size_t pos = static_cast<size_t>(tail % kShmRingBytes);
+    size_t first = std::min(bytes, kShmRingBytes - pos);
+    if (memcpy_s(dst + done, first, recv_ring_->data + pos, first) != EOK ||
+        (bytes > first && memcpy_s(dst + done + first, bytes - first, recv_ring_->data, bytes - first) != EOK)) {
+      MS_LOG(ERROR) << "Copy from the shared memory link failed";
+      return false;
+    }
+    tail += bytes;
+    recv_ring_->tail.store(tail, std::memory_order_release);
+    done += bytes;
+    backoff.Reset();
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
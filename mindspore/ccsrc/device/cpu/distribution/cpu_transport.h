@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_DEVICE_CPU_DISTRIBUTION_CPU_TRANSPORT_H_
+#define MINDSPORE_CCSRC_DEVICE_CPU_DISTRIBUTION_CPU_TRANSPORT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+// The bytes of the ring of each direction of a shared memory link
+constexpr size_t kShmRingBytes = 1 << 20;
+// A link waits for its peer at most this long before it fails
+constexpr int kLinkTimeoutSeconds = 300;
+
+// A reliable ordered byte stream to a peer process, every byte sent by one side is received by the other side in
+// the same order. Send and Recv may run on two threads at the same time.
+class Link {
+ public:
+  Link() = default;
+  virtual ~Link() = default;
+  virtual bool Send(const void *data, size_t size) = 0;
+  virtual bool Recv(void *data, size_t size) = 0;
+  virtual std::string type() const = 0;
+};
+using LinkPtr = std::shared_ptr<Link>;
+
+class TcpLink : public Link {
+ public:
+  explicit TcpLink(int fd) : fd_(fd) {}
+  ~TcpLink() override;
+  bool Send(const void *data, size_t size) override;
+  bool Recv(void *data, size_t size) override;
+  std::string type() const override { return "tcp"; }
+
+ private:
+  int fd_;
+};
+
+// A single producer single consumer ring, head and tail count the bytes written and read since the creation
+struct ShmRing {
+  alignas(64) std::atomic<uint64_t> head;
+  alignas(64) std::atomic<uint64_t> tail;
+  alignas(64) char data[kShmRingBytes];
+};
+
+// Two rings in a shared memory segment of the processes on the same host, the creator sends through the first one
+// and the other side through the second one. The bytes are copied without system calls, the waiting side spins and
+// then yields.
+class ShmLink : public Link {
+ public:
+  // The creator creates and initializes the segment, the other side opens it after the creator is done. The name
+  // can be unlinked once both sides have mapped the segment.
+  static std::shared_ptr<ShmLink> Create(const std::string &name, bool creator);
+  static void Unlink(const std::string &name);
+  ~ShmLink() override;
+  bool Send(const void *data, size_t size) override;
+  bool Recv(void *data, size_t size) override;
+  std::string type() const override { return "shm"; }
+
+ private:
+  ShmLink(void *addr, ShmRing *send_ring, ShmRing *recv_ring)
+      : addr_(addr), send_ring_(send_ring), recv_ring_(recv_ring) {}
+  void *addr_;
+  ShmRing *send_ring_;
+  ShmRing *recv_ring_;
+};
+
+// The socket helpers of the rendezvous, they return -1 or false on failure
+bool SendAll(int fd, const void *data, size_t size);
+bool RecvAll(int fd, void *data, size_t size);
+// Listen on all the addresses, the port 0 picks a free port which is returned by bound_port
+int ListenOn(int port, int backlog, int *bound_port);
+// Retry until the peer listens or the timeout passes
+int ConnectTo(const std::string &addr, int port, int timeout_seconds);
+// Accept a connection, peer_addr gets the address of the peer if not null
+int AcceptFrom(int listen_fd, std::string *peer_addr);
+void CloseFd(int fd);
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_DEVICE_CPU_DISTRIBUTION_CPU_TRANSPORT_H_
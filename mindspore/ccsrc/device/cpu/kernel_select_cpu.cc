@@ -83,8 +83,8 @@ void GetOutputFormatsAndDtypes(const CNodePtr &kernel_node, const KernelAttr &ke
 bool IsInputFormatDtypeMatched(const KernelAttr &kernel_attr, const std::vector<std::string> &input_formats,
                                const std::vector<TypeId> &input_types,
                                const std::vector<size_t> &input_not_cnode_indexes) {
-  if (kernel_attr.GetInputSize() != input_types.size()) {
-    MS_LOG(ERROR) << "Output num is not equal!";
+  if (!kernel_attr.GetAllSame() && kernel_attr.GetInputSize() != input_types.size()) {
+    MS_LOG(DEBUG) << "Input num is not equal!";
     return false;
   }
   auto input_num = input_types.size();
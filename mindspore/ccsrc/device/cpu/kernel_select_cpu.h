@@ -46,8 +46,15 @@ class KernelAttr {
     return *this;
   }
 
-  const DataType &GetInputAttr(const size_t index) const { return input_type_[index]; }
+  // all the inputs take the first input attr, for the ops with a dynamic input number like Concat
+  KernelAttr &AddAllSameAttr(const bool &all_same) {
+    all_same_ = all_same;
+    return *this;
+  }
+
+  const DataType &GetInputAttr(const size_t index) const { return all_same_ ? input_type_[0] : input_type_[index]; }
   const DataType &GetOutputAttr(const size_t index) const { return output_type_[index]; }
+  const bool &GetAllSame() const { return all_same_; }
 
   size_t GetInputSize() const { return input_type_.size(); }
   size_t GetOutputSize() const { return output_type_.size(); }
@@ -55,6 +62,7 @@ class KernelAttr {
  private:
   std::vector<DataType> input_type_;
   std::vector<DataType> output_type_;
+  bool all_same_{false};
 };
 }  // namespace cpu
 }  // namespace device
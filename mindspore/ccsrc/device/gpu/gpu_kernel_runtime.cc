@@ -231,12 +231,13 @@ void GPUKernelRuntime::AllocKernelDynamicRes(const mindspore::kernel::KernelMod
     input->size = device_address->size_;
     kernel_inputs->emplace_back(input);
   }
+  auto stream_id = AnfAlgo::GetStreamId(kernel);
   auto output_sizes = kernel_mod.GetOutputSizeList();
   for (size_t i = 0; i < output_sizes.size(); ++i) {
     auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i);
     MS_EXCEPTION_IF_NULL(device_address);
     if (device_address->ptr_ == nullptr) {
-      auto ret = mem_manager_->MallocMemFromMemPool(device_address, output_sizes[i]);
+      auto ret = mem_manager_->MallocMemFromMemPool(device_address, output_sizes[i], stream_id);
       if (!ret) {
         MS_LOG(EXCEPTION) << "Malloc device memory failed.";
       }
@@ -253,7 +254,7 @@ void GPUKernelRuntime::AllocKernelDynamicRes(const mindspore::kernel::KernelMod
       kernel_workspaces->emplace_back(nullptr);
       continue;
     }
-    auto device_ptr = mem_manager_->MallocMemFromMemPool(workspace_sizes[i]);
+    auto device_ptr = mem_manager_->MallocMemFromMemPool(workspace_sizes[i], stream_id);
     if (!device_ptr) {
       MS_LOG(EXCEPTION) << "Malloc device memory failed.";
     }
@@ -21,8 +21,8 @@
 namespace mindspore {
 namespace device {
 namespace gpu {
-void *GPUMemoryManager::MallocMemFromMemPool(size_t size) {
-  return GPUMemoryAllocator::GetInstance().AllocTensorMem(size);
+void *GPUMemoryManager::MallocMemFromMemPool(size_t size, uint32_t stream_id) {
+  return GPUMemoryAllocator::GetInstance().AllocTensorMem(size, stream_id);
 }
 
 void GPUMemoryManager::FreeMemFromMemPool(void *device_ptr) {
@@ -214,7 +214,7 @@ void KernelRuntime::RunOpAssignOutputMemory(const AnfNodePtr &kernel) {
     auto output_type = AnfAlgo::GetOutputDeviceDataType(kernel, i);
     auto device_address = CreateDeviceAddress(nullptr, output_sizes[i], output_format, output_type);
     MS_EXCEPTION_IF_NULL(device_address);
-    auto ret = mem_manager_->MallocMemFromMemPool(device_address, output_sizes[i]);
+    auto ret = mem_manager_->MallocMemFromMemPool(device_address, output_sizes[i], AnfAlgo::GetStreamId(kernel));
     if (!ret) {
       MS_LOG(EXCEPTION) << "Malloc device memory failed.";
     }
@@ -232,7 +232,7 @@ void KernelRuntime::RunOpAssignWorkSpaceMemory(const AnfNodePtr &kernel) {
     for (size_t i = 0; i < workspace_lists.size(); ++i) {
       auto device_address = CreateDeviceAddress(nullptr, workspace_lists[i], "", kTypeUnknown);
       MS_EXCEPTION_IF_NULL(device_address);
-      auto ret = mem_manager_->MallocMemFromMemPool(device_address, workspace_lists[i]);
+      auto ret = mem_manager_->MallocMemFromMemPool(device_address, workspace_lists[i], AnfAlgo::GetStreamId(kernel));
       if (!ret) {
         MS_LOG(EXCEPTION) << "Malloc device memory failed.";
       }
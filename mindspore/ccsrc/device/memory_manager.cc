@@ -141,8 +141,8 @@ uint8_t *MemoryManager::MallocDynamicMem(size_t size, bool communication_mem) {
   }
 }
 
-bool MemoryManager::MallocMemFromMemPool(const DeviceAddressPtr address, size_t size) {
-  auto device_ptr = MallocMemFromMemPool(size);
+bool MemoryManager::MallocMemFromMemPool(const DeviceAddressPtr address, size_t size, uint32_t stream_id) {
+  auto device_ptr = MallocMemFromMemPool(size, stream_id);
   if (!device_ptr) {
     return false;
   }
@@ -151,7 +151,7 @@ bool MemoryManager::MallocMemFromMemPool(const DeviceAddressPtr address, size_t
   return true;
 }
 
-void *MemoryManager::MallocMemFromMemPool(size_t size) {
+void *MemoryManager::MallocMemFromMemPool(size_t size, uint32_t) {
   if (size == 0) {
     MS_LOG(ERROR) << "MallocMemFromMemPool size is 0.";
   }
@@ -46,8 +46,9 @@ class MemoryManager {
   uint8_t *MallocWorkSpaceMem(const AnfNodePtr &node, size_t index, int flag, size_t size);
   virtual uint8_t *MallocMem(int flag, size_t size);
 
-  virtual bool MallocMemFromMemPool(const DeviceAddressPtr address, size_t size);
-  virtual void *MallocMemFromMemPool(size_t size);
+  // The stream_id is the stream of the kernel using the memory, the pool caches the small memory freed per stream.
+  virtual bool MallocMemFromMemPool(const DeviceAddressPtr address, size_t size, uint32_t stream_id = 0);
+  virtual void *MallocMemFromMemPool(size_t size, uint32_t stream_id = 0);
   virtual void FreeMemFromMemPool(const DeviceAddressPtr address);
   virtual void FreeMemFromMemPool(void *device_ptr);
   virtual bool MallocContinuousMemFromMemPool(const DeviceAddressPtrList addr_list, size_t total_size,
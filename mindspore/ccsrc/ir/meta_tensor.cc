@@ -16,6 +16,7 @@
 
 #include "ir/meta_tensor.h"
 
+#include <chrono>
 #include <functional>
 #include <numeric>
 #include <vector>
@@ -26,6 +27,7 @@
 #include "pybind_api/api_register.h"
 #include "pybind_api/export_flags.h"
 #include "pipeline/static_analysis/abstract_value.h"
+#include "utils/data_version.h"
 
 namespace mindspore {
 
@@ -183,14 +185,16 @@ Tensor::Tensor(const py::float_ &input, const TypePtr &data_type) { init(py::arr
 
 Tensor::Tensor(const py::int_ &input, const TypePtr &data_type) { init(py::array(input), data_type); }
 
-Tensor::Tensor(const Tensor &tensor, const TypePtr &data_type)
-    : MetaTensor(tensor), device_address_(tensor.device_address_) {
+Tensor::Tensor(const Tensor &tensor, const TypePtr &data_type) : MetaTensor(tensor) {
+  tensor.WaitPendingTask();
+  device_address_ = tensor.device_address_;
   init(tensor.data_, data_type);
   dirty_ = tensor.is_dirty();
 }
 
 Tensor &Tensor::operator=(const Tensor &tensor) {
   if (this != &tensor) {
+    tensor.WaitPendingTask();
     MetaTensor::operator=(tensor);
     dirty_ = tensor.is_dirty();
     device_address_ = tensor.device_address();
@@ -233,7 +237,11 @@ void *Tensor::data_c(bool writable) {
     DataBuf2Contiguous(data_, &data_c);
     data_ = data_c;
   }
-  return data_.request(writable).ptr;
+  void *ptr = data_.request(writable).ptr;
+  if (writable) {
+    DataVersion::GetInstance().Bump(ptr);
+  }
+  return ptr;
 }
 
 TypeId Tensor::GetDataType(const py::buffer_info &buf) const {
@@ -305,6 +313,8 @@ void Tensor::init(const py::array &input, const TypeId &data_type) {
     data_ = input;
   }
   dirty_ = true;
+  // the data set from python or loaded from a checkpoint replaces what the kernels converted at the address
+  DataVersion::GetInstance().Bump(data_.data());
 }
 
 void Tensor::init(TypeId data_type, const std::vector<int> &shape, py::array *const data) {
@@ -351,6 +361,8 @@ void Tensor::init(TypeId data_type, const std::vector<int> &shape, py::array *co
       MS_LOG(EXCEPTION) << "Cannot construct Tensor because of unsupported data type: " << data_type << ".";
       break;
   }
+  // the new buffer may take the address of a freed one
+  DataVersion::GetInstance().Bump(data->data());
 }
 
 TypePtr Tensor::SetDtype(const TypePtr type_ptr) {
@@ -360,10 +372,13 @@ TypePtr Tensor::SetDtype(const TypePtr type_ptr) {
 }
 
 TypeId Tensor::set_data_type(const TypeId data_type) {
+  // the data may still be written by a pending op
+  WaitPendingTask();
   if (data_.size() > 0 && data_type_ != data_type) {
     bool success = convert_data(data_, data_type_, &data_, data_type);
     if (success) {
       data_type_ = data_type;
+      DataVersion::GetInstance().Bump(data_.data());
     } else {
       MS_LOG(EXCEPTION) << "Convert data from " << data_type_ << " to " << data_type << " failed!";
     }
@@ -435,6 +450,7 @@ std::string Tensor::GetShapeAndDataTypeInfo() const {
 }
 
 std::string Tensor::ToString() const {
+  WaitPendingTask();
   const int small_tensor_size = 30;
   std::ostringstream buf;
   buf << "Tensor \nshape:[" << shape() << "]" << this->Dtype()->ToString();
@@ -446,6 +462,7 @@ std::string Tensor::ToString() const {
 }
 
 std::string Tensor::ToStringRepr() const {
+  WaitPendingTask();
   std::ostringstream buf;
   auto type_ptr = this->Dtype();
   MS_EXCEPTION_IF_NULL(type_ptr);
@@ -454,7 +471,22 @@ std::string Tensor::ToStringRepr() const {
   return buf.str();
 }
 
+void Tensor::WaitPendingTask() const {
+  if (!pending_task_.valid()) {
+    return;
+  }
+  if (pending_task_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    // the async executor needs the GIL to finish the op
+    py::gil_scoped_release release;
+    pending_task_.wait();
+  }
+  // keep the future of a failed op so that every later read reports the error
+  pending_task_.get();
+  pending_task_ = std::shared_future<void>();
+}
+
 py::array Tensor::data_sync() {
+  WaitPendingTask();
   if (device_address_ != nullptr) {
     if (!device_address_->SyncDeviceToHost(this->shape(), static_cast<size_t>(this->data().nbytes()), this->data_type(),
                                            this->data_c(true))) {
@@ -21,6 +21,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <future>
 #include "device/device_address.h"
 
 #include "pybind11/numpy.h"
@@ -413,11 +414,16 @@ class Tensor : public MetaTensor {
   void set_dirty(const bool dirty) { dirty_ = dirty; }
   DeviceAddressPtr device_address() const { return device_address_; }
   void set_device_address(const DeviceAddressPtr &device_address) { device_address_ = device_address; }
+  // the tensor is an output of a pynative op which may still be running in the async executor
+  void set_pending_task(const std::shared_future<void> &pending_task) { pending_task_ = pending_task; }
+  // wait for the op producing the tensor, raise the error of the op if it failed
+  void WaitPendingTask() const;
   py::array data_sync();
 
  private:
   bool dirty_{true};
   DeviceAddressPtr device_address_{nullptr};
+  mutable std::shared_future<void> pending_task_;
 };
 
 using TensorPtr = std::shared_ptr<Tensor>;
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/adam_cpu_kernel.h"
+#include <cmath>
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "kernel/cpu/simd/vector_math.h"
+#include "device/cpu/cpu_device_address.h"
+#include "utils/data_version.h"
+
+namespace mindspore {
+namespace kernel {
+void AdamCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  use_nesterov_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "use_nesterov");
+}
+
+bool AdamCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 10 || outputs.size() < 3) {
+    MS_LOG(EXCEPTION) << "error input output size!";
+  }
+  if (inputs[0]->size != inputs[1]->size || inputs[0]->size != inputs[2]->size || inputs[0]->size != inputs[9]->size) {
+    MS_LOG(EXCEPTION) << "error input data size!";
+  }
+  auto var = reinterpret_cast<float *>(inputs[0]->addr);
+  auto m = reinterpret_cast<float *>(inputs[1]->addr);
+  auto v = reinterpret_cast<float *>(inputs[2]->addr);
+  float beta1_power = reinterpret_cast<float *>(inputs[3]->addr)[0];
+  float beta2_power = reinterpret_cast<float *>(inputs[4]->addr)[0];
+  float lr = reinterpret_cast<float *>(inputs[5]->addr)[0];
+  auto grad = reinterpret_cast<float *>(inputs[9]->addr);
+  if (beta1_power == 1.f) {
+    MS_LOG(EXCEPTION) << "beta1_power can not be 1";
+  }
+  AdamParam param;
+  param.lr = lr * std::sqrt(1.f - beta2_power) / (1.f - beta1_power);
+  param.beta1 = reinterpret_cast<float *>(inputs[6]->addr)[0];
+  param.beta2 = reinterpret_cast<float *>(inputs[7]->addr)[0];
+  param.epsilon = reinterpret_cast<float *>(inputs[8]->addr)[0];
+  param.use_nesterov = use_nesterov_;
+  size_t elem_num = inputs[0]->size / sizeof(float);
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, kParallelGrainSize, [&](size_t begin, size_t end) {
+    VecAdam(param, grad + begin, var + begin, m + begin, v + begin, end - begin);
+  });
+  // the weights converted and cached by the mkl kernels are stale now, the same for the separate outputs
+  DataVersion::GetInstance().Bump(var);
+  // var, m and v are updated in place, the outputs only need a copy if they are separate buffers
+  for (size_t i = 0; i < 3; ++i) {
+    if (outputs[i]->addr == inputs[i]->addr) {
+      continue;
+    }
+    auto ret = memcpy_s(outputs[i]->addr, outputs[i]->size, inputs[i]->addr, inputs[i]->size);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+    }
+    DataVersion::GetInstance().Bump(outputs[i]->addr);
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
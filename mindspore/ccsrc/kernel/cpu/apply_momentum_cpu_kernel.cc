@@ -14,7 +14,8 @@
  * limitations under the License.
  */
 #include "kernel/cpu/apply_momentum_cpu_kernel.h"
-#include "kernel/cpu/mkldnn/mkl_kernel_engine.h"
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "utils/data_version.h"
 #include "device/cpu/cpu_device_address.h"
 #include "common/utils.h"
 
@@ -37,10 +38,14 @@ bool ApplyMomentumCPUKernel::Launch(const std::vector<kernel::AddressPtr> &input
   auto gradient = reinterpret_cast<float *>(inputs[3]->addr);
   float moment = reinterpret_cast<float *>(inputs[4]->addr)[0];
   size_t elem_num = inputs[0]->size / sizeof(float);
-  for (size_t i = 0; i < elem_num; ++i) {
-    accumulate[i] = accumulate[i] * moment + gradient[i];
-    weight[i] -= accumulate[i] * learning_rate;
-  }
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, kParallelGrainSize, [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      accumulate[i] = accumulate[i] * moment + gradient[i];
+      weight[i] -= accumulate[i] * learning_rate;
+    }
+  });
+  // the weights converted and cached by the mkl kernels are stale now
+  DataVersion::GetInstance().Bump(inputs[0]->addr);
   return true;
 }
 }  // namespace kernel
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "kernel/cpu/argmax_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
 #include "device/cpu/cpu_device_address.h"
 
 namespace mindspore {
@@ -47,20 +48,23 @@ bool ArgmaxCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   }
   auto input = reinterpret_cast<float *>(inputs[0]->addr);
   auto output = reinterpret_cast<int *>(outputs[0]->addr);
-  size_t row_start = 0;
-  for (size_t i = 0; i < batch_size_; ++i) {
-    size_t max_index = 0;
-    float max_value = input[row_start];
-    for (size_t j = 1; j < class_num_; ++j) {
-      size_t index = row_start + j;
-      if (input[index] > max_value) {
-        max_value = input[index];
-        max_index = j;
+  size_t class_num = class_num_;
+  size_t grain = ParallelGrain(class_num);
+  CPUThreadPool::GetInstance().ParallelFor(batch_size_, grain, [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      size_t row_start = i * class_num;
+      size_t max_index = 0;
+      float max_value = input[row_start];
+      for (size_t j = 1; j < class_num; ++j) {
+        size_t index = row_start + j;
+        if (input[index] > max_value) {
+          max_value = input[index];
+          max_index = j;
+        }
       }
+      output[i] = SizeToInt(max_index);
     }
-    output[i] = SizeToInt(max_index);
-    row_start += class_num_;
-  }
+  });
   return true;
 }
 }  // namespace kernel
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/batch_norm_cpu_kernel.h"
+#include <cmath>
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "kernel/cpu/simd/vector_math.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void BatchNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  if (input_shape.size() < 2) {
+    MS_LOG(EXCEPTION) << "batch norm needs an input of at least 2 dims, but got " << input_shape.size();
+  }
+  is_training_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "is_training");
+  epsilon_ = AnfAlgo::GetNodeAttr<float>(kernel_node, "epsilon");
+  batch_size_ = input_shape[0];
+  channel_ = input_shape[1];
+  spatial_size_ = 1;
+  for (size_t i = 2; i < input_shape.size(); ++i) {
+    spatial_size_ *= input_shape[i];
+  }
+}
+
+bool BatchNormCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 5 || outputs.size() < 5) {
+    MS_LOG(EXCEPTION) << "input or output size error!";
+  }
+  size_t channel_bytes = channel_ * sizeof(float);
+  if (inputs[0]->size != batch_size_ * channel_ * spatial_size_ * sizeof(float) || inputs[1]->size != channel_bytes ||
+      inputs[3]->size != channel_bytes || outputs[1]->size != channel_bytes) {
+    MS_LOG(EXCEPTION) << "input or output data size error!";
+  }
+  auto x = reinterpret_cast<float *>(inputs[0]->addr);
+  auto scale = reinterpret_cast<float *>(inputs[1]->addr);
+  auto offset = reinterpret_cast<float *>(inputs[2]->addr);
+  auto y = reinterpret_cast<float *>(outputs[0]->addr);
+  auto mean = reinterpret_cast<float *>(outputs[1]->addr);
+  auto variance = reinterpret_cast<float *>(outputs[2]->addr);
+  size_t batch_size = batch_size_;
+  size_t channel = channel_;
+  size_t spatial_size = spatial_size_;
+  float epsilon = epsilon_;
+  if (batch_size * spatial_size == 0) {
+    return true;
+  }
+  size_t plane_grain = ParallelGrain(spatial_size);
+  if (is_training_) {
+    // the biased statistics of each channel over the batch and spatial dims
+    float count = static_cast<float>(batch_size * spatial_size);
+    size_t channel_size = batch_size * spatial_size;
+    size_t channel_grain = ParallelGrain(channel_size);
+    CPUThreadPool::GetInstance().ParallelFor(channel, channel_grain, [=](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        float sum = 0.f;
+        for (size_t n = 0; n < batch_size; ++n) {
+          sum += VecSum(x + (n * channel + c) * spatial_size, spatial_size);
+        }
+        float channel_mean = sum / count;
+        float square_sum = 0.f;
+        for (size_t n = 0; n < batch_size; ++n) {
+          square_sum += VecSquareDiffSum(x + (n * channel + c) * spatial_size, channel_mean, spatial_size);
+        }
+        mean[c] = channel_mean;
+        variance[c] = square_sum / count;
+      }
+    });
+  } else {
+    for (size_t i = 1; i < 3; ++i) {
+      auto ret = memcpy_s(outputs[i]->addr, outputs[i]->size, inputs[i + 2]->addr, channel_bytes);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+      }
+    }
+  }
+  // y = x * (scale * rstd) + (offset - mean * scale * rstd), plane by plane
+  CPUThreadPool::GetInstance().ParallelFor(batch_size * channel, plane_grain, [=](size_t begin, size_t end) {
+    for (size_t plane = begin; plane < end; ++plane) {
+      size_t c = plane % channel;
+      float plane_scale = scale[c] / std::sqrt(variance[c] + epsilon);
+      float plane_shift = offset[c] - mean[c] * plane_scale;
+      VecScaleShift(x + plane * spatial_size, plane_scale, plane_shift, y + plane * spatial_size, spatial_size);
+    }
+  });
+  for (size_t i = 3; i < 5; ++i) {
+    auto ret = memcpy_s(outputs[i]->addr, outputs[i]->size, outputs[i - 2]->addr, channel_bytes);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+    }
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
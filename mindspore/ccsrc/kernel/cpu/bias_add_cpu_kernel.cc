@@ -15,6 +15,7 @@
  */
 
 #include "kernel/cpu/bias_add_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -38,6 +39,7 @@ void BiasAddCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (input_shape_[1] != bias_shape_[0]) {
     MS_LOG(EXCEPTION) << "bias shape not match";
   }
+  fused_relu_ = HasFusedRelu(kernel_node);
 }
 
 bool BiasAddCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> & /*workspace*/,
@@ -49,32 +51,33 @@ bool BiasAddCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const std::
   auto src_addr = reinterpret_cast<float *>(inputs[0]->addr);
   auto bias_addr = reinterpret_cast<float *>(inputs[1]->addr);
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
+  // the relu folded by the cpu ir fusion is applied in the same pass
+  bool fused_relu = fused_relu_;
+  auto activate = [fused_relu](float value) { return fused_relu && value < 0.f ? 0.f : value; };
 
+  // the planes of nchw, or the rows of nc, are split across the threads
+  size_t channel = input_shape_[1];
+  size_t plane_size = data_shape_ == 4 ? input_shape_[2] * input_shape_[3] : 1;
   if (data_shape_ == 4) {
-    size_t h_size = input_shape_[3];
-    size_t c_size = input_shape_[2] * h_size;
-    size_t n_size = input_shape_[1] * c_size;
-    size_t hw_size = input_shape_[2] * input_shape_[3];
-    size_t n_offset = 0;
-    for (size_t n = 0; n < input_shape_[0]; ++n) {
-      size_t c_offset = 0;
-      for (size_t c = 0; c < input_shape_[1]; ++c) {
-        for (size_t hw = 0; hw < hw_size; ++hw) {
-          size_t offset = n_offset + c_offset + hw;
-          output_addr[offset] = src_addr[offset] + bias_addr[c];
+    CPUThreadPool::GetInstance().ParallelFor(
+      input_shape_[0] * channel, ParallelGrain(plane_size), [&](size_t begin, size_t end) {
+        for (size_t plane = begin; plane < end; ++plane) {
+          float bias = bias_addr[plane % channel];
+          size_t plane_offset = plane * plane_size;
+          for (size_t hw = 0; hw < plane_size; ++hw) {
+            output_addr[plane_offset + hw] = activate(src_addr[plane_offset + hw] + bias);
+          }
         }
-        c_offset += c_size;
-      }
-      n_offset += n_size;
-    }
+      });
   } else {
-    size_t n_offset = 0;
-    for (size_t n = 0; n < input_shape_[0]; ++n) {
-      for (size_t c = 0; c < input_shape_[1]; ++c) {
-        output_addr[n_offset + c] = src_addr[n_offset + c] + bias_addr[c];
+    CPUThreadPool::GetInstance().ParallelFor(input_shape_[0], ParallelGrain(channel), [&](size_t begin, size_t end) {
+      for (size_t n = begin; n < end; ++n) {
+        size_t n_offset = n * channel;
+        for (size_t c = 0; c < channel; ++c) {
+          output_addr[n_offset + c] = activate(src_addr[n_offset + c] + bias_addr[c]);
+        }
       }
-      n_offset += input_shape_[1];
-    }
+    });
   }
   return true;
 }
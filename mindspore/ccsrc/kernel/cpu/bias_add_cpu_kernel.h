@@ -34,6 +34,7 @@ class BiasAddCPUKernel : public CPUKernel {
 
  private:
   uint8_t data_shape_{0};
+  bool fused_relu_{false};
   std::vector<size_t> input_shape_;
   std::vector<size_t> bias_shape_;
 };
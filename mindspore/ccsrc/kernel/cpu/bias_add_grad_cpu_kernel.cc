@@ -15,6 +15,7 @@
  */
 
 #include "kernel/cpu/bias_add_grad_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
 
 namespace mindspore {
 namespace kernel {
@@ -34,33 +35,34 @@ bool BiasAddGradCPUKernel::Launch(const std::vector<AddressPtr> &inputs, const s
   auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
   auto input_addr = reinterpret_cast<float *>(inputs[0]->addr);
 
+  // each channel is summed by one thread
+  size_t batch = input_shape_[0];
+  size_t channel = input_shape_[1];
   if (input_shape_.size() == 4) {
-    size_t h_size = input_shape_[3];
-    size_t c_size = h_size * input_shape_[2];
-    size_t n_size = c_size * input_shape_[1];
     size_t hw_size = input_shape_[2] * input_shape_[3];
-    size_t c_offset = 0;
-    for (size_t c = 0; c < input_shape_[1]; ++c) {
-      output_addr[c] = 0;
-      size_t n_offset = 0;
-      for (size_t n = 0; n < input_shape_[0]; ++n) {
-        for (size_t hw = 0; hw < hw_size; ++hw) {
-          size_t offset = c_offset + n_offset + hw;
-          output_addr[c] += input_addr[offset];
+    size_t n_size = channel * hw_size;
+    CPUThreadPool::GetInstance().ParallelFor(channel, ParallelGrain(batch * hw_size), [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        float sum = 0;
+        for (size_t n = 0; n < batch; ++n) {
+          size_t offset = n * n_size + c * hw_size;
+          for (size_t hw = 0; hw < hw_size; ++hw) {
+            sum += input_addr[offset + hw];
+          }
         }
-        n_offset += n_size;
+        output_addr[c] = sum;
       }
-      c_offset += c_size;
-    }
+    });
   } else if (input_shape_.size() == 2) {
-    for (size_t c = 0; c < input_shape_[1]; ++c) {
-      output_addr[c] = 0;
-      size_t n_offset = 0;
-      for (size_t n = 0; n < input_shape_[0]; ++n) {
-        output_addr[c] += input_addr[c + n_offset];
-        n_offset += input_shape_[1];
+    CPUThreadPool::GetInstance().ParallelFor(channel, ParallelGrain(batch), [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        float sum = 0;
+        for (size_t n = 0; n < batch; ++n) {
+          sum += input_addr[c + n * channel];
+        }
+        output_addr[c] = sum;
       }
-    }
+    });
   }
   return true;
 }
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/cast_cpu_kernel.h"
+#include "device/convert_tensor_utils.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void CastCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  source_type_ = AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
+  target_type_ = AnfAlgo::GetOutputInferDataType(kernel_node, 0);
+}
+
+bool CastCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (source_type_ == kNumberTypeFloat32 && target_type_ == kNumberTypeFloat16) {
+    device::FloatToHalf(outputs[0]->addr, inputs[0]->addr, inputs[0]->size / sizeof(float));
+  } else if (source_type_ == kNumberTypeFloat16 && target_type_ == kNumberTypeFloat32) {
+    device::HalfToFloat(outputs[0]->addr, inputs[0]->addr, outputs[0]->size / sizeof(float));
+  } else if (source_type_ == target_type_) {
+    if (inputs[0]->addr != outputs[0]->addr &&
+        memcpy_s(outputs[0]->addr, outputs[0]->size, inputs[0]->addr, inputs[0]->size) != EOK) {
+      MS_LOG(EXCEPTION) << "memcpy_s error!";
+    }
+  } else {
+    MS_LOG(EXCEPTION) << "Cast from " << TypeIdLabel(source_type_) << " to " << TypeIdLabel(target_type_)
+                      << " is not supported on the cpu.";
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
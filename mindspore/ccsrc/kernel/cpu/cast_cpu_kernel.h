@@ -0,0 +1,53 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_CAST_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_CAST_CPU_KERNEL_H_
+#include <vector>
+#include <memory>
+#include "kernel/cpu/cpu_kernel.h"
+#include "kernel/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// The casts between float32 and float16, such as the ones of the gradients compressed to float16
+class CastCPUKernel : public CPUKernel {
+ public:
+  CastCPUKernel() = default;
+  ~CastCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  TypeId source_type_{kNumberTypeFloat32};
+  TypeId target_type_{kNumberTypeFloat32};
+};
+
+MS_REG_CPU_KERNEL_EX(Cast, Float32ToFloat16,
+                     KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat16),
+                     CastCPUKernel);
+MS_REG_CPU_KERNEL_EX(Cast, Float16ToFloat32,
+                     KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat32),
+                     CastCPUKernel);
+MS_REG_CPU_KERNEL_EX(Cast, Float32ToFloat32,
+                     KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                     CastCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_CAST_CPU_KERNEL_H_
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/collective_cpu_kernel.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void CollectiveCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  auto iter = kCollectiveTypeMap.find(kernel_name);
+  if (iter == kCollectiveTypeMap.end()) {
+    MS_LOG(EXCEPTION) << "Kernel " << kernel_name << " is not supported.";
+  }
+  kernel_type_ = iter->second;
+  group_ = AnfAlgo::GetNodeAttr<std::string>(kernel_node, "group");
+  auto reduce_op = AnfAlgo::GetCNodePrimitive(kernel_node)->GetAttr("op");
+  if (reduce_op && !device::cpu::GetCollectiveReduceOp(GetValue<std::string>(reduce_op), &reduce_op_)) {
+    MS_LOG(EXCEPTION) << "The reduce op of " << kernel_name << " is not supported.";
+  }
+  type_ = (kernel_type_ == kCpuReceive) ? AnfAlgo::GetOutputInferDataType(kernel_node, 0)
+                                        : AnfAlgo::GetPrevNodeOutputInferDataType(kernel_node, 0);
+  type_bytes_ = (type_ == kNumberTypeFloat16) ? sizeof(uint16_t) : sizeof(float);
+  if (kernel_type_ == kCpuBroadcast) {
+    root_rank_ = AnfAlgo::GetNodeAttr<int>(kernel_node, "root_rank");
+  } else if (kernel_type_ == kCpuSend || kernel_type_ == kCpuReceive) {
+    sr_tag_ = AnfAlgo::GetNodeAttr<int>(kernel_node, "sr_tag");
+    peer_rank_ = AnfAlgo::GetNodeAttr<int>(kernel_node, (kernel_type_ == kCpuSend) ? "dest_rank" : "src_rank");
+  }
+  if (!device::cpu::CPUCollective::instance().initialized()) {
+    MS_LOG(EXCEPTION) << kernel_name << " on the cpu needs init(\"cpu\") first.";
+  }
+}
+
+bool CollectiveCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                 const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                 const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || inputs.size() != outputs.size()) {
+    MS_LOG(EXCEPTION) << "input or output size error!";
+  }
+  auto &collective = device::cpu::CPUCollective::instance();
+  bool ret = true;
+  switch (kernel_type_) {
+    case kCpuAllReduce:
+      ret = collective.AllReduce(inputs[0]->addr, outputs[0]->addr, inputs[0]->size / type_bytes_, type_, reduce_op_,
+                                 group_);
+      break;
+    case kCpuAllGather:
+      ret = collective.AllGather(inputs[0]->addr, outputs[0]->addr, inputs[0]->size / type_bytes_, type_, group_);
+      break;
+    case kCpuReduceScatter:
+      ret = collective.ReduceScatter(inputs[0]->addr, outputs[0]->addr, outputs[0]->size / type_bytes_, type_,
+                                     reduce_op_, group_);
+      break;
+    case kCpuBroadcast:
+      for (size_t i = 0; i < inputs.size() && ret; ++i) {
+        ret = collective.Broadcast(inputs[i]->addr, outputs[i]->addr, inputs[i]->size / type_bytes_, type_,
+                                   root_rank_, group_);
+      }
+      break;
+    case kCpuSend:
+      ret = collective.Send(inputs[0]->addr, inputs[0]->size / type_bytes_, type_, peer_rank_, sr_tag_);
+      if (ret && outputs[0]->size >= sizeof(float)) {
+        *static_cast<float *>(outputs[0]->addr) = 0.0f;
+      }
+      break;
+    case kCpuReceive:
+      ret = collective.Recv(outputs[0]->addr, outputs[0]->size / type_bytes_, type_, peer_rank_, sr_tag_);
+      break;
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "The collective communication in the group " << group_ << " failed.";
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_COLLECTIVE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_COLLECTIVE_CPU_KERNEL_H_
+#include <map>
+#include <string>
+#include <vector>
+#include "kernel/cpu/cpu_kernel.h"
+#include "kernel/cpu/cpu_kernel_factory.h"
+#include "device/cpu/distribution/cpu_collective.h"
+
+namespace mindspore {
+namespace kernel {
+enum CollectiveKernelType { kCpuAllReduce = 0, kCpuAllGather, kCpuReduceScatter, kCpuBroadcast, kCpuSend, kCpuReceive };
+const std::map<std::string, CollectiveKernelType> kCollectiveTypeMap = {
+  {"AllReduce", kCpuAllReduce},
+  {"AllGather", kCpuAllGather},
+  {"ReduceScatter", kCpuReduceScatter},
+  {"Broadcast", kCpuBroadcast},
+  {"_Send", kCpuSend},
+  {"_Receive", kCpuReceive},
+};
+
+// The communication primitives on the processes initialized by init("cpu")
+class CollectiveCPUKernel : public CPUKernel {
+ public:
+  CollectiveCPUKernel() = default;
+  ~CollectiveCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  CollectiveKernelType kernel_type_{kCpuAllReduce};
+  device::cpu::CollectiveReduceOp reduce_op_{device::cpu::kCollectiveSum};
+  std::string group_;
+  int root_rank_{0};
+  // the world rank the _Send sends to or the _Receive receives from
+  int peer_rank_{0};
+  int sr_tag_{0};
+  TypeId type_{kNumberTypeFloat32};
+  size_t type_bytes_{sizeof(float)};
+};
+
+MS_REG_CPU_KERNEL(AllReduce, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  CollectiveCPUKernel);
+// the float16 gradients of the data parallel compressed by casting
+MS_REG_CPU_KERNEL_EX(AllReduce, Float16,
+                     KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                     CollectiveCPUKernel);
+MS_REG_CPU_KERNEL(AllGather, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  CollectiveCPUKernel);
+MS_REG_CPU_KERNEL(ReduceScatter, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  CollectiveCPUKernel);
+MS_REG_CPU_KERNEL(Broadcast,
+                  KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  CollectiveCPUKernel);
+// the _Send outputs a token, the input of the _Receive only carries the gradient of the send back
+MS_REG_CPU_KERNEL(_Send, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  CollectiveCPUKernel);
+MS_REG_CPU_KERNEL(_Receive, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  CollectiveCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_COLLECTIVE_CPU_KERNEL_H_
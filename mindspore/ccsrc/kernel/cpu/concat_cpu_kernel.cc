@@ -0,0 +1,84 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/concat_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void ConcatCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  int axis = AnfAlgo::GetNodeAttr<int>(kernel_node, AXIS);
+  if (axis < 0) {
+    axis += SizeToInt(output_shape.size());
+  }
+  if (axis < 0 || IntToSize(axis) >= output_shape.size()) {
+    MS_LOG(EXCEPTION) << "invalid axis: " << axis;
+  }
+  outer_size_ = 1;
+  for (size_t i = 0; i < IntToSize(axis); ++i) {
+    outer_size_ *= output_shape[i];
+  }
+  input_row_sizes_.clear();
+  output_row_size_ = 0;
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  for (size_t i = 0; i < input_num; ++i) {
+    auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i);
+    size_t row_size = 1;
+    for (size_t j = IntToSize(axis); j < input_shape.size(); ++j) {
+      row_size *= input_shape[j];
+    }
+    input_row_sizes_.push_back(row_size);
+    output_row_size_ += row_size;
+  }
+}
+
+bool ConcatCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                             const std::vector<kernel::AddressPtr> & /*workspace*/,
+                             const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != input_row_sizes_.size() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output size error!";
+  }
+  if (outputs[0]->size != outer_size_ * output_row_size_ * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "output data size error!";
+  }
+  if (output_row_size_ == 0) {
+    return true;
+  }
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  size_t grain = ParallelGrain(output_row_size_);
+  CPUThreadPool::GetInstance().ParallelFor(outer_size_, grain, [&](size_t begin, size_t end) {
+    for (size_t outer = begin; outer < end; ++outer) {
+      float *dst = output + outer * output_row_size_;
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        size_t row_bytes = input_row_sizes_[i] * sizeof(float);
+        if (row_bytes == 0) {
+          continue;
+        }
+        auto src = reinterpret_cast<float *>(inputs[i]->addr) + outer * input_row_sizes_[i];
+        auto ret = memcpy_s(dst, row_bytes, src, row_bytes);
+        if (ret != 0) {
+          MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+        }
+        dst += input_row_sizes_[i];
+      }
+    }
+  });
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
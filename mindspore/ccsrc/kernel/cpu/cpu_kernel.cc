@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "kernel/cpu/cpu_kernel.h"
+#include <string>
+#include "operator/ops.h"
+#include "utils/utils.h"
 
 namespace mindspore {
 namespace kernel {
@@ -36,6 +39,18 @@ void CPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   }
 }
 
+bool CPUKernel::HasFusedRelu(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  if (!AnfAlgo::HasNodeAttr(kAttrFusedActivation, kernel_node)) {
+    return false;
+  }
+  auto activation = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrFusedActivation);
+  if (activation != prim::kPrimRelu->name()) {
+    MS_LOG(EXCEPTION) << "cpu kernel does not support fused activation " << activation;
+  }
+  return true;
+}
+
 void CPUKernel::Init(const CNodePtr &kernel_node) {
   InitInputOutputSize(kernel_node);
   InitKernel(kernel_node);
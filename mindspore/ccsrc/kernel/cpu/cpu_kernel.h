@@ -65,6 +65,8 @@ class CPUKernel : public kernel::KernelMod {
 
  protected:
   virtual void InitInputOutputSize(const CNodePtr &kernel_node);
+  // return true if the cpu ir fusion has folded a relu into the kernel
+  static bool HasFusedRelu(const CNodePtr &kernel_node);
   std::vector<size_t> input_size_list_;
   std::vector<size_t> output_size_list_;
   std::vector<size_t> workspace_size_list_;
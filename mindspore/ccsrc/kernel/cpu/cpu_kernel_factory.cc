@@ -49,6 +49,31 @@ std::shared_ptr<CPUKernel> CPUKernelFactory::Create(const std::string &kernel_na
   return nullptr;
 }
 
+namespace {
+// an op may register several attrs, e.g. conv2d with and without the fused bias input
+bool IsKernelAttrMatched(const KernelAttr &kernel_attr, const KernelBuildInfo *kernel_info) {
+  if ((!kernel_attr.GetAllSame() && kernel_attr.GetInputSize() != kernel_info->GetInputNum()) ||
+      kernel_attr.GetOutputSize() != kernel_info->GetOutputNum()) {
+    return false;
+  }
+  for (size_t i = 0; i < kernel_info->GetInputNum(); ++i) {
+    if (kernel_info->GetInputDeviceType(i) != kernel_attr.GetInputAttr(i).first) {
+      MS_LOG(DEBUG) << "kernel info type:" << kernel_info->GetInputDeviceType(i) << ", "
+                    << "register type:" << kernel_attr.GetInputAttr(i).first << ", input index: " << i << ".";
+      return false;
+    }
+  }
+  for (size_t i = 0; i < kernel_info->GetOutputNum(); ++i) {
+    if (kernel_info->GetOutputDeviceType(i) != kernel_attr.GetOutputAttr(i).first) {
+      MS_LOG(DEBUG) << "kernel info type:" << kernel_info->GetOutputDeviceType(i) << ", "
+                    << "register type:" << kernel_attr.GetOutputAttr(i).first << ", output index: " << i << ".";
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 std::pair<bool, size_t> CPUKernelFactory::CPUKernelAttrCheck(const std::string &kernel_name,
                                                              const KernelBuildInfo *kernel_info) {
   auto iter = name_to_attr_creator_.find(kernel_name);
@@ -56,27 +81,13 @@ std::pair<bool, size_t> CPUKernelFactory::CPUKernelAttrCheck(const std::string &
     MS_LOG(INFO) << "Not registered CPU kernel: op[" << kernel_name << "]!";
     return std::make_pair(false, 0);
   }
-  auto creators = iter->second;
+  auto &creators = iter->second;
   for (size_t index = 0; index < creators.size(); ++index) {
-    auto attr_creator = creators[index];
-    for (size_t i = 0; i < kernel_info->GetInputNum(); ++i) {
-      if (kernel_info->GetInputDeviceType(i) != attr_creator.first.GetInputAttr(i).first) {
-        MS_LOG(WARNING) << "cpu kernel attr check failed. input index: " << i << ".";
-        MS_LOG(WARNING) << "kernel info type:" << kernel_info->GetInputDeviceType(i) << ", "
-                        << "register type:" << attr_creator.first.GetInputAttr(i).first;
-        return std::make_pair(false, 0);
-      }
-    }
-    for (size_t i = 0; i < kernel_info->GetOutputNum(); ++i) {
-      if (kernel_info->GetOutputDeviceType(i) != attr_creator.first.GetOutputAttr(i).first) {
-        MS_LOG(WARNING) << "cpu kernel attr check failed. output index: " << i << ".";
-        MS_LOG(WARNING) << "kernel info type:" << kernel_info->GetOutputDeviceType(i) << ", "
-                        << "register type:" << attr_creator.first.GetOutputAttr(i).first;
-        return std::make_pair(false, 0);
-      }
+    if (IsKernelAttrMatched(creators[index].first, kernel_info)) {
+      return std::make_pair(true, index);
     }
-    return std::make_pair(true, index);
   }
+  MS_LOG(WARNING) << "cpu kernel attr check failed, no registered attr of op[" << kernel_name << "] matches.";
   return std::make_pair(false, 0);
 }
 
@@ -60,6 +60,12 @@ class CPUKernelRegistrar {
   static const CPUKernelRegistrar g_cpu_kernel_##OPNAME##_reg(#OPNAME, ATTR,               \
                                                               []() { return std::make_shared<OPCLASS>(); });
 
+// register another attr of the same op, e.g. the one with the bias input folded by the cpu ir fusion
+#define MS_REG_CPU_KERNEL_EX(OPNAME, SUFFIX, ATTR, OPCLASS)                                \
+  static_assert(std::is_base_of<CPUKernel, OPCLASS>::value, " must be base of CPUKernel"); \
+  static const CPUKernelRegistrar g_cpu_kernel_##OPNAME##_##SUFFIX##_reg(                  \
+    #OPNAME, ATTR, []() { return std::make_shared<OPCLASS>(); });
+
 #define MS_REG_CPU_KERNEL_T(OPNAME, ATTR, OPCLASS, T)                                         \
   static_assert(std::is_base_of<CPUKernel, OPCLASS<T>>::value, " must be base of CPUKernel"); \
   static const CPUKernelRegistrar g_cpu_kernel_##OPNAME##_##T##_reg(#OPNAME, ATTR,            \
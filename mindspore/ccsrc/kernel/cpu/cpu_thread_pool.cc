@@ -0,0 +1,268 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/cpu_thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+struct ParallelContext {
+  std::atomic<size_t> remaining{0};
+  std::mutex lock;
+  std::condition_variable done;
+  std::exception_ptr error{nullptr};
+};
+
+// set on the pool threads and on a caller while it runs its ranges
+thread_local bool t_in_parallel = false;
+
+class InParallelGuard {
+ public:
+  InParallelGuard() : prev_(t_in_parallel) { t_in_parallel = true; }
+  ~InParallelGuard() { t_in_parallel = prev_; }
+
+ private:
+  bool prev_;
+};
+
+// the core ids that can be bound are below this, CPU_SET has no effect on the others
+int GetCoreIdLimit() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto online_num = sysconf(_SC_NPROCESSORS_ONLN);
+  if (online_num > 0) {
+    return static_cast<int>(std::min(online_num, static_cast<long>(CPU_SETSIZE)));
+  }
+  return CPU_SETSIZE;
+#else
+  return static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+#endif
+}
+
+// a core list like "0-7,16-23", as the one in the env or in the sysfs of a numa node
+std::vector<int> ParseCoreList(const std::string &text) {
+  std::vector<int> cores;
+  std::stringstream stream(text);
+  std::string item;
+  int core_id_limit = GetCoreIdLimit();
+  while (std::getline(stream, item, ',')) {
+    if (item.empty()) {
+      continue;
+    }
+    int first = 0;
+    int last = 0;
+    try {
+      auto dash = item.find('-');
+      first = std::stoi(item.substr(0, dash));
+      last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+    } catch (const std::exception &) {
+      MS_LOG(EXCEPTION) << "invalid core list " << text;
+    }
+    if (first < 0 || first > last || last >= core_id_limit) {
+      MS_LOG(EXCEPTION) << "invalid cores " << item << " in core list " << text << ", the core ids must be in [0, "
+                        << core_id_limit << ")";
+    }
+    for (int core = first; core <= last; ++core) {
+      cores.push_back(core);
+    }
+  }
+  return cores;
+}
+
+std::vector<int> GetBindCores() {
+  auto cores_env = common::GetEnv("MS_CPU_BIND_CORES");
+  if (!cores_env.empty()) {
+    return ParseCoreList(cores_env);
+  }
+  auto node_env = common::GetEnv("MS_CPU_NUMA_NODE");
+  if (node_env.empty()) {
+    return {};
+  }
+  std::string path = "/sys/devices/system/node/node" + node_env + "/cpulist";
+  std::ifstream file(path);
+  std::string cpulist;
+  if (!file.is_open() || !std::getline(file, cpulist)) {
+    MS_LOG(WARNING) << "Can not read the cores of numa node " << node_env << " from " << path;
+    return {};
+  }
+  return ParseCoreList(cpulist);
+}
+
+// the number of cores the process is allowed to run on, which respects taskset and the cpuset of a container
+size_t GetAvailableCoreNum() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    return std::max(static_cast<size_t>(CPU_COUNT(&cpu_set)), size_t(1));
+  }
+#endif
+  return std::max(std::thread::hardware_concurrency(), 1U);
+}
+
+void BindCurrentThread(const std::vector<int> &cores) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (auto core : cores) {
+    CPU_SET(core, &cpu_set);
+  }
+  auto ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (ret != 0) {
+    MS_LOG(WARNING) << "Bind thread to cores failed, errno " << ret;
+  }
+#else
+  MS_LOG(WARNING) << "Binding the cpu threads to cores is not supported on this platform";
+#endif
+}
+}  // namespace
+
+CPUThreadPool::CPUThreadPool() {
+  bind_cores_ = GetBindCores();
+  size_t thread_num = bind_cores_.empty() ? GetAvailableCoreNum() : bind_cores_.size();
+  auto thread_num_env = common::GetEnv("MS_CPU_THREAD_NUM");
+  if (!thread_num_env.empty()) {
+    try {
+      thread_num = static_cast<size_t>(std::max(std::stoi(thread_num_env), 1));
+    } catch (const std::exception &) {
+      MS_LOG(EXCEPTION) << "invalid MS_CPU_THREAD_NUM " << thread_num_env;
+    }
+  }
+  if (!bind_cores_.empty()) {
+    // the caller is confined to the cores of the process but not pinned to one, it may not be a compute thread only
+    BindCurrentThread(bind_cores_);
+  }
+  for (size_t i = 1; i < thread_num; ++i) {
+    workers_.emplace_back(&CPUThreadPool::WorkerLoop, this, i);
+  }
+  MS_LOG(INFO) << "Cpu thread pool thread num " << thread_num << ", bind core num " << bind_cores_.size();
+}
+
+bool CPUThreadPool::InParallel() { return t_in_parallel; }
+
+CPUThreadPool::~CPUThreadPool() {
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    exit_ = true;
+  }
+  cond_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void CPUThreadPool::WorkerLoop(size_t index) {
+  t_in_parallel = true;
+  if (!bind_cores_.empty()) {
+    BindCurrentThread({bind_cores_[index % bind_cores_.size()]});
+  }
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> locker(lock_);
+      cond_.wait(locker, [this] { return exit_ || !tasks_.empty(); });
+      if (exit_ && tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop();
+    }
+    task();
+  }
+}
+
+bool CPUThreadPool::RunPendingTask() {
+  std::function<void()> task;
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    if (tasks_.empty()) {
+      return false;
+    }
+    task = std::move(tasks_.front());
+    tasks_.pop();
+  }
+  task();
+  return true;
+}
+
+void CPUThreadPool::ParallelFor(size_t count, size_t grain, const RangeTask &task) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max(grain, size_t(1));
+  size_t range_num = std::min(thread_num(), (count + grain - 1) / grain);
+  if (range_num <= 1 || t_in_parallel) {
+    task(0, count);
+    return;
+  }
+  size_t range_size = (count + range_num - 1) / range_num;
+  range_num = (count + range_size - 1) / range_size;
+  auto context = std::make_shared<ParallelContext>();
+  context->remaining = range_num;
+  auto run_range = [context, &task](size_t begin, size_t end) {
+    try {
+      task(begin, end);
+    } catch (...) {
+      std::lock_guard<std::mutex> locker(context->lock);
+      if (context->error == nullptr) {
+        context->error = std::current_exception();
+      }
+    }
+    if (context->remaining.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> locker(context->lock);
+      context->done.notify_all();
+    }
+  };
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    for (size_t i = 1; i < range_num; ++i) {
+      size_t begin = i * range_size;
+      size_t end = std::min(begin + range_size, count);
+      tasks_.emplace([run_range, begin, end]() { run_range(begin, end); });
+    }
+  }
+  cond_.notify_all();
+  InParallelGuard guard;
+  run_range(0, range_size);
+  // help with the queued ranges instead of blocking, the ranges of another caller included
+  while (context->remaining.load() != 0) {
+    if (RunPendingTask()) {
+      continue;
+    }
+    std::unique_lock<std::mutex> locker(context->lock);
+    (void)context->done.wait_for(locker, std::chrono::milliseconds(1),
+                                 [&context] { return context->remaining.load() == 0; });
+  }
+  if (context->error != nullptr) {
+    std::rethrow_exception(context->error);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
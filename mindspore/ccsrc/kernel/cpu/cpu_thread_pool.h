@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_CPU_THREAD_POOL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_CPU_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+#include "common/utils.h"
+
+namespace mindspore {
+namespace kernel {
+// the number of elements below which a range is not worth another thread
+constexpr size_t kParallelGrainSize = 16384;
+
+// the grain of a parallel for over items of item_size elements each
+inline size_t ParallelGrain(size_t item_size) {
+  return item_size >= kParallelGrainSize ? 1 : kParallelGrainSize / (item_size == 0 ? 1 : item_size);
+}
+
+// the pool shared by the cpu kernels for the intra-op parallelism, it is the only source of compute threads of the
+// process (mkl-dnn is built with the sequential runtime and runs on the calling thread). it is set up from the env:
+//   MS_CPU_THREAD_NUM  the number of compute threads, the caller included, default the cores the process may run on
+//   MS_CPU_BIND_CORES  the cores to pin the threads to, e.g. "0-7,16-23"
+//   MS_CPU_NUMA_NODE   pin the threads to the cores of a numa node, ignored if MS_CPU_BIND_CORES is set
+// so that several processes can share a host without oversubscribing it.
+class CPUThreadPool {
+ public:
+  using RangeTask = std::function<void(size_t begin, size_t end)>;
+
+  static CPUThreadPool &GetInstance() {
+    static CPUThreadPool instance;
+    return instance;
+  }
+  DISABLE_COPY_AND_ASSIGN(CPUThreadPool)
+
+  // split [0, count) into ranges of at least grain elements and run them on the pool, the caller runs one of the
+  // ranges and returns when all of them are done. an exception thrown by a range is rethrown to the caller.
+  // a call from inside a range runs inline, the pool is already busy.
+  void ParallelFor(size_t count, size_t grain, const RangeTask &task);
+  size_t thread_num() const { return workers_.size() + 1; }
+  const std::vector<int> &bind_cores() const { return bind_cores_; }
+  static bool InParallel();
+
+ private:
+  CPUThreadPool();
+  ~CPUThreadPool();
+  void WorkerLoop(size_t index);
+  bool RunPendingTask();
+
+  std::vector<std::thread> workers_;
+  std::vector<int> bind_cores_;
+  std::mutex lock_;
+  std::condition_variable cond_;
+  std::queue<std::function<void()>> tasks_;
+  bool exit_{false};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_CPU_THREAD_POOL_H_
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "kernel/cpu/equal_count_cpu_kernel.h"
+#include <atomic>
+#include "kernel/cpu/cpu_thread_pool.h"
 #include "device/cpu/cpu_device_address.h"
 
 namespace mindspore {
@@ -29,17 +31,21 @@ bool EqualCountCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs[0]->size != inputs[1]->size) {
     MS_LOG(EXCEPTION) << "input or output size!";
   }
-  int count = 0;
+  std::atomic<int> count{0};
   auto left = reinterpret_cast<int *>(inputs[0]->addr);
   auto right = reinterpret_cast<int *>(inputs[1]->addr);
   size_t elem_num = inputs[0]->size / sizeof(int);
-  for (size_t i = 0; i < elem_num; i++) {
-    if (left[i] == right[i]) {
-      count++;
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, kParallelGrainSize, [&](size_t begin, size_t end) {
+    int range_count = 0;
+    for (size_t i = begin; i < end; i++) {
+      if (left[i] == right[i]) {
+        range_count++;
+      }
     }
-  }
+    (void)count.fetch_add(range_count);
+  });
   auto output = reinterpret_cast<int *>(outputs[0]->addr);
-  output[0] = count;
+  output[0] = count.load();
   return true;
 }
 }  // namespace kernel
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/fused_elemwise_cpu_kernel.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <numeric>
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "kernel/cpu/simd/vector_math.h"
+#include "device/cpu/cpu_device_address.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// the elements computed through all the steps at a time, the block of each operand stays in the l1 cache
+constexpr size_t kBlockSize = 2048;
+
+ElemwiseOp GetElemwiseOp(const std::string &name) {
+  static const std::map<std::string, ElemwiseOp> kElemwiseOps = {{"ReLU", ElemwiseOp::kRelu},
+                                                                 {"Gelu", ElemwiseOp::kGelu},
+                                                                 {"Mul", ElemwiseOp::kMul},
+                                                                 {"ReluGrad", ElemwiseOp::kReluGrad}};
+  auto iter = kElemwiseOps.find(name);
+  if (iter == kElemwiseOps.end()) {
+    MS_LOG(EXCEPTION) << "fused elemwise kernel not support op " << name;
+  }
+  return iter->second;
+}
+
+size_t GetOperandNum(ElemwiseOp op) { return op == ElemwiseOp::kMul || op == ElemwiseOp::kReluGrad ? 2 : 1; }
+}  // namespace
+
+std::vector<ElemwiseStep> FusedElemwiseCPUKernel::ParseSteps(const std::vector<std::string> &ops,
+                                                             const std::vector<int> &operands, size_t input_num) {
+  if (ops.empty()) {
+    MS_LOG(EXCEPTION) << "fused elemwise kernel has no op";
+  }
+  std::vector<ElemwiseStep> steps;
+  size_t pos = 0;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    ElemwiseStep step{GetElemwiseOp(ops[i]), {}};
+    size_t operand_num = GetOperandNum(step.op);
+    if (pos + operand_num > operands.size()) {
+      MS_LOG(EXCEPTION) << "fused elemwise kernel lacks the operands of op " << ops[i];
+    }
+    for (size_t j = 0; j < operand_num; ++j, ++pos) {
+      int operand = operands[pos];
+      bool valid = operand == kChainOperand ? i > 0 : operand >= 0 && IntToSize(operand) < input_num;
+      if (!valid) {
+        MS_LOG(EXCEPTION) << "fused elemwise kernel op " << ops[i] << " has invalid operand " << operand;
+      }
+      step.operands.push_back(operand);
+    }
+    steps.push_back(step);
+  }
+  if (pos != operands.size()) {
+    MS_LOG(EXCEPTION) << "fused elemwise kernel has " << operands.size() << " operands, its ops use " << pos;
+  }
+  return steps;
+}
+
+void FusedElemwiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  auto ops = AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, kAttrFusedOps);
+  auto operands = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, kAttrFusedOperands);
+  steps_ = ParseSteps(ops, operands, input_num);
+  std::vector<size_t> dst_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  elem_num_ = std::accumulate(dst_shape.begin(), dst_shape.end(), size_t(1), std::multiplies<size_t>());
+  scalar_inputs_.clear();
+  for (size_t i = 0; i < input_num; ++i) {
+    std::vector<size_t> src_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i);
+    size_t src_num = std::accumulate(src_shape.begin(), src_shape.end(), size_t(1), std::multiplies<size_t>());
+    if (src_num != elem_num_ && src_num != 1) {
+      MS_LOG(EXCEPTION) << "fused elemwise kernel input " << i << " has " << src_num << " elements, the output has "
+                        << elem_num_;
+    }
+    scalar_inputs_.push_back(src_num != elem_num_);
+  }
+  for (auto &step : steps_) {
+    bool has_scalar = std::any_of(step.operands.begin(), step.operands.end(), [this](int operand) {
+      return operand != kChainOperand && scalar_inputs_[IntToSize(operand)];
+    });
+    if (has_scalar && step.op != ElemwiseOp::kMul) {
+      MS_LOG(EXCEPTION) << "fused elemwise kernel only support the scalar operands of mul";
+    }
+  }
+}
+
+void FusedElemwiseCPUKernel::ComputeBlock(const std::vector<AddressPtr> &inputs, float *output, size_t begin,
+                                          size_t end) const {
+  size_t n = end - begin;
+  float *y = output + begin;
+  // the block of the operand, nullptr and its value for a scalar
+  auto operand_data = [&inputs, y, begin, this](int operand, float *scalar) -> const float * {
+    if (operand == kChainOperand) {
+      return y;
+    }
+    auto data = reinterpret_cast<const float *>(inputs[IntToSize(operand)]->addr);
+    if (scalar_inputs_[IntToSize(operand)]) {
+      *scalar = data[0];
+      return nullptr;
+    }
+    return data + begin;
+  };
+  for (auto &step : steps_) {
+    float scalar0 = 0.f;
+    float scalar1 = 0.f;
+    const float *a = operand_data(step.operands[0], &scalar0);
+    switch (step.op) {
+      case ElemwiseOp::kRelu:
+        for (size_t i = 0; i < n; ++i) {
+          y[i] = a[i] > 0.f ? a[i] : 0.f;
+        }
+        break;
+      case ElemwiseOp::kGelu:
+        VecGelu(a, y, n);
+        break;
+      case ElemwiseOp::kMul: {
+        const float *b = operand_data(step.operands[1], &scalar1);
+        if (a == nullptr && b == nullptr) {
+          std::fill(y, y + n, scalar0 * scalar1);
+        } else if (a == nullptr) {
+          VecScaleShift(b, scalar0, 0.f, y, n);
+        } else if (b == nullptr) {
+          VecScaleShift(a, scalar1, 0.f, y, n);
+        } else {
+          for (size_t i = 0; i < n; ++i) {
+            y[i] = a[i] * b[i];
+          }
+        }
+        break;
+      }
+      case ElemwiseOp::kReluGrad: {
+        // the gradient dy and the input x of the relu
+        const float *x = operand_data(step.operands[1], &scalar1);
+        for (size_t i = 0; i < n; ++i) {
+          y[i] = x[i] > 0.f ? a[i] : 0.f;
+        }
+        break;
+      }
+    }
+  }
+}
+
+bool FusedElemwiseCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                    const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                    const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != scalar_inputs_.size() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "fused elemwise kernel error input output size!";
+  }
+  if (outputs[0]->size < elem_num_ * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "fused elemwise kernel error output data size!";
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i]->size < (scalar_inputs_[i] ? 1 : elem_num_) * sizeof(float)) {
+      MS_LOG(EXCEPTION) << "fused elemwise kernel error input " << i << " data size!";
+    }
+  }
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  CPUThreadPool::GetInstance().ParallelFor(elem_num_, kParallelGrainSize, [&inputs, output, this](size_t begin,
+                                                                                                   size_t end) {
+    for (size_t block = begin; block < end; block += kBlockSize) {
+      ComputeBlock(inputs, output, block, std::min(block + kBlockSize, end));
+    }
+  });
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
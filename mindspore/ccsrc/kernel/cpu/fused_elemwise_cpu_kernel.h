@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
+#include <string>
+#include <vector>
+#include <memory>
+#include "kernel/cpu/cpu_kernel.h"
+#include "kernel/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// the operand of a step which is the result of the previous step
+constexpr int kChainOperand = -1;
+
+enum class ElemwiseOp { kRelu = 0, kGelu, kMul, kReluGrad };
+
+struct ElemwiseStep {
+  ElemwiseOp op;
+  // the input index of each operand of the op, or kChainOperand
+  std::vector<int> operands;
+};
+
+// A chain of elementwise ops folded by the cpu ir fusion. The steps run one block of the output after the other,
+// so each element is read from and written to the memory once instead of once per op. The fused_ops attr holds the
+// names of the ops and the fused_operands attr their operands, see ElemwiseStep. An input of one element is a scalar
+// broadcast to the operands of a mul, the other inputs have the size of the output.
+class FusedElemwiseCPUKernel : public CPUKernel {
+ public:
+  FusedElemwiseCPUKernel() = default;
+  ~FusedElemwiseCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  // the steps of the fused ops and their flattened operands, an exception if they do not form a chain
+  static std::vector<ElemwiseStep> ParseSteps(const std::vector<std::string> &ops, const std::vector<int> &operands,
+                                              size_t input_num);
+
+ private:
+  void ComputeBlock(const std::vector<AddressPtr> &inputs, float *output, size_t begin, size_t end) const;
+
+  std::vector<ElemwiseStep> steps_;
+  std::vector<bool> scalar_inputs_;
+  size_t elem_num_{0};
+};
+
+MS_REG_CPU_KERNEL(FusedElemwise,
+                  KernelAttr().AddAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  FusedElemwiseCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_FUSED_ELEMWISE_CPU_KERNEL_H_
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/gather_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void GatherV2CPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  auto indices_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 1);
+  int axis = AnfAlgo::GetNodeAttr<int>(kernel_node, AXIS);
+  if (axis < 0) {
+    axis += SizeToInt(input_shape.size());
+  }
+  if (axis < 0 || IntToSize(axis) >= input_shape.size()) {
+    MS_LOG(EXCEPTION) << "invalid axis: " << axis;
+  }
+  outer_size_ = 1;
+  inner_size_ = 1;
+  indices_num_ = 1;
+  for (size_t i = 0; i < IntToSize(axis); ++i) {
+    outer_size_ *= input_shape[i];
+  }
+  axis_dim_ = input_shape[IntToSize(axis)];
+  for (size_t i = IntToSize(axis) + 1; i < input_shape.size(); ++i) {
+    inner_size_ *= input_shape[i];
+  }
+  for (auto dim : indices_shape) {
+    indices_num_ *= dim;
+  }
+}
+
+bool GatherV2CPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                               const std::vector<kernel::AddressPtr> & /*workspace*/,
+                               const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 2 || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (outputs[0]->size != outer_size_ * indices_num_ * inner_size_ * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "output data size error!";
+  }
+  if (inner_size_ == 0) {
+    return true;
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto indices = reinterpret_cast<int *>(inputs[1]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  size_t axis_dim = axis_dim_;
+  size_t inner_size = inner_size_;
+  size_t indices_num = indices_num_;
+  size_t grain = ParallelGrain(inner_size);
+  // each task copies the inner blocks selected by a range of (outer, index) pairs
+  CPUThreadPool::GetInstance().ParallelFor(outer_size_ * indices_num, grain, [=](size_t begin, size_t end) {
+    for (size_t pos = begin; pos < end; ++pos) {
+      size_t outer = pos / indices_num;
+      int index = indices[pos % indices_num];
+      float *dst = output + pos * inner_size;
+      size_t block_bytes = inner_size * sizeof(float);
+      // an index out of range gives zeros, the same as the gpu kernel
+      if (index < 0 || IntToSize(index) >= axis_dim) {
+        auto ret = memset_s(dst, block_bytes, 0, block_bytes);
+        if (ret != 0) {
+          MS_LOG(EXCEPTION) << "memset_s error, errorno" << ret;
+        }
+        continue;
+      }
+      const float *src = input + (outer * axis_dim + IntToSize(index)) * inner_size;
+      auto ret = memcpy_s(dst, block_bytes, src, block_bytes);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+      }
+    }
+  });
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,43 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/gelu_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "kernel/cpu/simd/vector_math.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void GeluCPUKernel::InitKernel(const CNodePtr & /*kernel_node*/) {}
+
+bool GeluCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (inputs[0]->size != outputs[0]->size) {
+    MS_LOG(EXCEPTION) << "input and output size not match!";
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  size_t elem_num = inputs[0]->size / sizeof(float);
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, kParallelGrainSize, [input, output](size_t begin, size_t end) {
+    VecGelu(input + begin, output + begin, end - begin);
+  });
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
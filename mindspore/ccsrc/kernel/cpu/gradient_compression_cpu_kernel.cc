@@ -0,0 +1,300 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/gradient_compression_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "device/cpu/cpu_device_address.h"
+#include "securec/include/securec.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// a column of P whose norm drops below this part of its norm by the orthogonalization is dependent on the others
+constexpr float kOrthogonalizeTolerance = 1e-4;
+
+size_t ShapeSize(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+// The index of a top-k value is sent in the bits of a float32, the values are only moved by the AllGather
+float IndexToFloat(uint32_t index) {
+  float value = 0;
+  (void)memcpy_s(&value, sizeof(value), &index, sizeof(index));
+  return value;
+}
+
+uint32_t FloatToIndex(float value) {
+  uint32_t index = 0;
+  (void)memcpy_s(&index, sizeof(index), &value, sizeof(value));
+  return index;
+}
+}  // namespace
+
+GradientCompressionStore &GradientCompressionStore::GetInstance() {
+  static GradientCompressionStore instance;
+  return instance;
+}
+
+GradientCompressionState *GradientCompressionStore::GetState(const std::string &key, size_t count) {
+  std::lock_guard<std::mutex> lock(lock_);
+  auto &state = states_[key];
+  if (state.residual.size() != count) {
+    state.residual.assign(count, 0.0f);
+    state.p.clear();
+    state.q.clear();
+  }
+  return &state;
+}
+
+void TopKCompressCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  key_ = AnfAlgo::GetNodeAttr<std::string>(kernel_node, "key");
+  count_ = ShapeSize(AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0));
+  // the k of the inferred shape, rather than the ratio, so that it is the one every device gathers
+  k_ = ShapeSize(AnfAlgo::GetOutputInferShape(kernel_node, 0)) / 2;
+  if (k_ == 0 || k_ > count_ || count_ > UINT32_MAX) {
+    MS_LOG(EXCEPTION) << "The top " << k_ << " of the gradient of " << count_ << " elements is invalid";
+  }
+}
+
+bool TopKCompressCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                   const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                   const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  auto gradient = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  auto state = GradientCompressionStore::GetInstance().GetState(key_, count_);
+  auto &residual = state->residual;
+  // error feedback, the elements left by the last steps are added to this one
+  for (size_t i = 0; i < count_; ++i) {
+    residual[i] += gradient[i];
+  }
+  std::vector<uint32_t> indices(count_);
+  std::iota(indices.begin(), indices.end(), 0);
+  std::nth_element(indices.begin(), indices.begin() + (k_ - 1), indices.end(), [&residual](uint32_t a, uint32_t b) {
+    return std::fabs(residual[a]) > std::fabs(residual[b]);
+  });
+  for (size_t i = 0; i < k_; ++i) {
+    output[i] = residual[indices[i]];
+    output[k_ + i] = IndexToFloat(indices[i]);
+    residual[indices[i]] = 0.0f;
+  }
+  return true;
+}
+
+void TopKDecompressCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  dev_num_ = IntToSize(AnfAlgo::GetNodeAttr<int>(kernel_node, "dev_num"));
+  auto gathered = ShapeSize(AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0));
+  count_ = ShapeSize(AnfAlgo::GetOutputInferShape(kernel_node, 0));
+  if (dev_num_ == 0 || gathered % (2 * dev_num_) != 0) {
+    MS_LOG(EXCEPTION) << "The " << gathered << " elements gathered from " << dev_num_ << " devices are invalid";
+  }
+  k_ = gathered / (2 * dev_num_);
+}
+
+bool TopKDecompressCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                     const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                     const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  auto gathered = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  if (memset_s(output, outputs[0]->size, 0, outputs[0]->size) != EOK) {
+    MS_LOG(EXCEPTION) << "memset output failed!";
+  }
+  for (size_t dev = 0; dev < dev_num_; ++dev) {
+    const float *values = gathered + dev * 2 * k_;
+    const float *indices = values + k_;
+    for (size_t i = 0; i < k_; ++i) {
+      uint32_t index = FloatToIndex(indices[i]);
+      if (index >= count_) {
+        MS_LOG(EXCEPTION) << "The index " << index << " of the top-k of the device " << dev << " is out of range "
+                          << count_;
+      }
+      output[index] += values[i];
+    }
+  }
+  return true;
+}
+
+void PowerSGDCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  auto iter = kPowerSGDStepMap.find(kernel_name);
+  if (iter == kPowerSGDStepMap.end()) {
+    MS_LOG(EXCEPTION) << "Kernel " << kernel_name << " is not supported.";
+  }
+  step_ = iter->second;
+  key_ = AnfAlgo::GetNodeAttr<std::string>(kernel_node, "key");
+  rank_ = IntToSize(AnfAlgo::GetNodeAttr<int>(kernel_node, "rank"));
+  if (step_ == kPowerSGDDecompress) {
+    dev_num_ = IntToSize(AnfAlgo::GetNodeAttr<int>(kernel_node, "dev_num"));
+  }
+  // the gradient is the only input of the first step and the last input of the others
+  auto shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, AnfAlgo::GetInputTensorNum(kernel_node) - 1);
+  if (shape.size() < 2) {
+    MS_LOG(EXCEPTION) << "PowerSGD needs a gradient of 2 dimensions at least, but got " << shape.size();
+  }
+  rows_ = shape[0];
+  cols_ = ShapeSize(shape) / rows_;
+  if (rank_ == 0 || dev_num_ == 0) {
+    MS_LOG(EXCEPTION) << "The rank " << rank_ << " or the device number " << dev_num_ << " of PowerSGD is invalid";
+  }
+}
+
+bool PowerSGDCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                               const std::vector<kernel::AddressPtr> & /*workspace*/,
+                               const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  auto state = GradientCompressionStore::GetInstance().GetState(key_, rows_ * cols_);
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  switch (step_) {
+    case kPowerSGDCompressP:
+      CompressP(state, input, output);
+      break;
+    case kPowerSGDCompressQ:
+      CompressQ(state, input, output);
+      break;
+    case kPowerSGDDecompress:
+      Decompress(state, input, output);
+      break;
+  }
+  return true;
+}
+
+void PowerSGDCPUKernel::CompressP(GradientCompressionState *state, const float *gradient, float *p) const {
+  auto &m = state->residual;
+  auto &q = state->q;
+  if (q.size() != cols_ * rank_) {
+    // the same seed on all the devices, so that they start from the same Q
+    std::mt19937 generator(0);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    q.resize(cols_ * rank_);
+    for (auto &value : q) {
+      value = distribution(generator);
+    }
+  }
+  for (size_t i = 0; i < rows_ * cols_; ++i) {
+    m[i] += gradient[i];
+  }
+  size_t cols = cols_;
+  size_t rank = rank_;
+  const float *m_data = m.data();
+  const float *q_data = q.data();
+  CPUThreadPool::GetInstance().ParallelFor(rows_, ParallelGrain(cols * rank), [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const float *m_row = m_data + i * cols;
+      for (size_t r = 0; r < rank; ++r) {
+        float sum = 0.0f;
+        for (size_t j = 0; j < cols; ++j) {
+          sum += m_row[j] * q_data[j * rank + r];
+        }
+        p[i * rank + r] = sum;
+      }
+    }
+  });
+}
+
+void PowerSGDCPUKernel::CompressQ(GradientCompressionState *state, const float *p, float *q) const {
+  // Gram-Schmidt on the columns of the reduced P, every device gets the same orthogonal P. The projections are
+  // removed twice to keep the columns orthogonal in float32, and a column left with nothing but the rounding errors
+  // is dropped, which happens when the rank of the gradient is below the rank of the approximation.
+  auto &p_hat = state->p;
+  p_hat.assign(p, p + rows_ * rank_);
+  auto column_norm = [this, &p_hat](size_t r) {
+    float norm = 0.0f;
+    for (size_t i = 0; i < rows_; ++i) {
+      norm += p_hat[i * rank_ + r] * p_hat[i * rank_ + r];
+    }
+    return std::sqrt(norm);
+  };
+  for (size_t r = 0; r < rank_; ++r) {
+    float origin_norm = column_norm(r);
+    for (size_t pass = 0; pass < 2; ++pass) {
+      for (size_t prev = 0; prev < r; ++prev) {
+        float dot = 0.0f;
+        for (size_t i = 0; i < rows_; ++i) {
+          dot += p_hat[i * rank_ + r] * p_hat[i * rank_ + prev];
+        }
+        for (size_t i = 0; i < rows_; ++i) {
+          p_hat[i * rank_ + r] -= dot * p_hat[i * rank_ + prev];
+        }
+      }
+    }
+    float norm = column_norm(r);
+    float scale = (norm > kOrthogonalizeTolerance * origin_norm && norm > 0.0f) ? 1.0f / norm : 0.0f;
+    for (size_t i = 0; i < rows_; ++i) {
+      p_hat[i * rank_ + r] *= scale;
+    }
+  }
+  size_t rows = rows_;
+  size_t cols = cols_;
+  size_t rank = rank_;
+  const float *m_data = state->residual.data();
+  const float *p_data = p_hat.data();
+  CPUThreadPool::GetInstance().ParallelFor(cols_, ParallelGrain(rows * rank), [=](size_t begin, size_t end) {
+    for (size_t j = begin; j < end; ++j) {
+      for (size_t r = 0; r < rank; ++r) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < rows; ++i) {
+          sum += m_data[i * cols + j] * p_data[i * rank + r];
+        }
+        q[j * rank + r] = sum;
+      }
+    }
+  });
+}
+
+void PowerSGDCPUKernel::Decompress(GradientCompressionState *state, const float *q, float *gradient) const {
+  size_t cols = cols_;
+  size_t rank = rank_;
+  float scale = 1.0f / static_cast<float>(dev_num_);
+  float *m_data = state->residual.data();
+  const float *p_data = state->p.data();
+  if (state->p.size() != rows_ * rank_) {
+    MS_LOG(EXCEPTION) << "The PowerSGD decompression of " << key_ << " runs before its compression";
+  }
+  // the sum of the approximations of all the devices, the residual is what the average one leaves of the local M
+  CPUThreadPool::GetInstance().ParallelFor(rows_, ParallelGrain(cols * rank), [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        float sum = 0.0f;
+        for (size_t r = 0; r < rank; ++r) {
+          sum += p_data[i * rank + r] * q[j * rank + r];
+        }
+        gradient[i * cols + j] = sum;
+        m_data[i * cols + j] -= sum * scale;
+      }
+    }
+  });
+  // the average Q starts the power iteration of the next step
+  state->q.assign(q, q + cols_ * rank_);
+  for (auto &value : state->q) {
+    value *= scale;
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
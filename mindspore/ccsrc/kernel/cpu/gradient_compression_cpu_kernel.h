@@ -0,0 +1,141 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_GRADIENT_COMPRESSION_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_GRADIENT_COMPRESSION_CPU_KERNEL_H_
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "kernel/cpu/cpu_kernel.h"
+#include "kernel/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// The state a compressed gradient carries from one step to the next
+struct GradientCompressionState {
+  // the part of the gradient not communicated yet, added to the gradient of the next step. PowerSGD keeps the
+  // gradient matrix M in it between its compression and decompression.
+  std::vector<float> residual;
+  // the orthogonalized P of PowerSGD
+  std::vector<float> p;
+  // the Q of PowerSGD, reused by the next step
+  std::vector<float> q;
+};
+
+// The states of the gradients, shared by the kernels of a gradient through the key of its mirror operator
+class GradientCompressionStore {
+ public:
+  GradientCompressionStore(const GradientCompressionStore &) = delete;
+  GradientCompressionStore &operator=(const GradientCompressionStore &) = delete;
+  static GradientCompressionStore &GetInstance();
+  // The state is created with a zero residual of count elements on the first call
+  GradientCompressionState *GetState(const std::string &key, size_t count);
+
+ private:
+  GradientCompressionStore() = default;
+  ~GradientCompressionStore() = default;
+  std::mutex lock_;
+  std::map<std::string, GradientCompressionState> states_;
+};
+
+// Keep the k elements of the largest magnitude of the gradient plus the residual, the output is the k values followed
+// by their indices stored in the bits of float32
+class TopKCompressCPUKernel : public CPUKernel {
+ public:
+  TopKCompressCPUKernel() = default;
+  ~TopKCompressCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  std::string key_;
+  size_t count_{0};
+  size_t k_{0};
+};
+
+// Sum the values of the TopKCompress of all the devices into the dense gradient
+class TopKDecompressCPUKernel : public CPUKernel {
+ public:
+  TopKDecompressCPUKernel() = default;
+  ~TopKDecompressCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  size_t count_{0};
+  size_t k_{0};
+  size_t dev_num_{0};
+};
+
+// The three steps of PowerSGD on the gradient viewed as a matrix M of rows by cols: P = M * Q, Q = M^T * orth(P) and
+// the approximation orth(P) * Q^T
+enum PowerSGDStep { kPowerSGDCompressP = 0, kPowerSGDCompressQ, kPowerSGDDecompress };
+const std::map<std::string, PowerSGDStep> kPowerSGDStepMap = {
+  {"_PowerSGDCompressP", kPowerSGDCompressP},
+  {"_PowerSGDCompressQ", kPowerSGDCompressQ},
+  {"_PowerSGDDecompress", kPowerSGDDecompress},
+};
+
+class PowerSGDCPUKernel : public CPUKernel {
+ public:
+  PowerSGDCPUKernel() = default;
+  ~PowerSGDCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  void CompressP(GradientCompressionState *state, const float *gradient, float *p) const;
+  void CompressQ(GradientCompressionState *state, const float *p, float *q) const;
+  void Decompress(GradientCompressionState *state, const float *q, float *gradient) const;
+
+  PowerSGDStep step_{kPowerSGDCompressP};
+  std::string key_;
+  size_t rows_{0};
+  size_t cols_{0};
+  size_t rank_{0};
+  size_t dev_num_{1};
+};
+
+MS_REG_CPU_KERNEL(_TopKCompress, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  TopKCompressCPUKernel);
+MS_REG_CPU_KERNEL(
+  _TopKDecompress,
+  KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+  TopKDecompressCPUKernel);
+MS_REG_CPU_KERNEL(_PowerSGDCompressP,
+                  KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  PowerSGDCPUKernel);
+MS_REG_CPU_KERNEL(
+  _PowerSGDCompressQ,
+  KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+  PowerSGDCPUKernel);
+MS_REG_CPU_KERNEL(
+  _PowerSGDDecompress,
+  KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+  PowerSGDCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_GRADIENT_COMPRESSION_CPU_KERNEL_H_
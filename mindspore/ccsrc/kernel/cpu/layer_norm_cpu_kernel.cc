@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/layer_norm_cpu_kernel.h"
+#include <cmath>
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "kernel/cpu/simd/vector_math.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// the same epsilon as the gpu kernel
+constexpr float kLayerNormEpsilon = 10e-12;
+
+size_t NormalizeAxis(int axis, size_t rank) {
+  int normalized = axis < 0 ? axis + SizeToInt(rank) : axis;
+  if (normalized < 0 || IntToSize(normalized) >= rank) {
+    MS_LOG(EXCEPTION) << "invalid axis: " << axis << ", rank: " << rank;
+  }
+  return IntToSize(normalized);
+}
+}  // namespace
+
+void LayerNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  size_t norm_axis = NormalizeAxis(AnfAlgo::GetNodeAttr<int>(kernel_node, "begin_norm_axis"), input_shape.size());
+  size_t params_axis = NormalizeAxis(AnfAlgo::GetNodeAttr<int>(kernel_node, "begin_params_axis"), input_shape.size());
+  if (params_axis < norm_axis) {
+    MS_LOG(EXCEPTION) << "begin_params_axis " << params_axis << " is less than begin_norm_axis " << norm_axis;
+  }
+  row_ = 1;
+  col_ = 1;
+  param_dim_ = 1;
+  for (size_t i = 0; i < norm_axis; ++i) {
+    row_ *= input_shape[i];
+  }
+  for (size_t i = norm_axis; i < input_shape.size(); ++i) {
+    col_ *= input_shape[i];
+  }
+  for (size_t i = params_axis; i < input_shape.size(); ++i) {
+    param_dim_ *= input_shape[i];
+  }
+}
+
+bool LayerNormCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() < 3 || outputs.size() < 3) {
+    MS_LOG(EXCEPTION) << "input or output size error!";
+  }
+  if (inputs[0]->size != row_ * col_ * sizeof(float) || inputs[1]->size != param_dim_ * sizeof(float) ||
+      outputs[1]->size != row_ * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "input or output data size error!";
+  }
+  if (col_ == 0 || param_dim_ == 0) {
+    return true;
+  }
+  auto x = reinterpret_cast<float *>(inputs[0]->addr);
+  auto gamma = reinterpret_cast<float *>(inputs[1]->addr);
+  auto beta = reinterpret_cast<float *>(inputs[2]->addr);
+  auto y = reinterpret_cast<float *>(outputs[0]->addr);
+  auto mean = reinterpret_cast<float *>(outputs[1]->addr);
+  auto variance = reinterpret_cast<float *>(outputs[2]->addr);
+  size_t col = col_;
+  size_t param_dim = param_dim_;
+  size_t grain = ParallelGrain(col);
+  CPUThreadPool::GetInstance().ParallelFor(row_, grain, [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const float *x_row = x + i * col;
+      float *y_row = y + i * col;
+      float row_mean = VecSum(x_row, col) / col;
+      float row_var = VecSquareDiffSum(x_row, row_mean, col) / col;
+      float rstd = 1.f / std::sqrt(row_var + kLayerNormEpsilon);
+      // gamma and beta repeat every param_dim elements of a row
+      for (size_t j = 0; j < col; j += param_dim) {
+        VecNormalize(x_row + j, gamma, beta, row_mean, rstd, y_row + j, param_dim);
+      }
+      mean[i] = row_mean;
+      variance[i] = row_var;
+    }
+  });
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -29,10 +29,6 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (src_shape.size() != 4 || weight_shape.size() != 4) {
     MS_LOG(EXCEPTION) << "conv2d only support nchw input!";
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
-
   int kernel_size = SizeToInt(weight_shape[3]);
   auto stride_ori = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDE);
   auto dilation_ori = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, DILATION);
@@ -63,16 +59,32 @@ void Conv2dCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
+  // the bias add and relu folded by the cpu ir fusion run inside the convolution primitive
+  has_bias_ = AnfAlgo::GetInputTensorNum(kernel_node) > 2;
+  dnnl::memory::desc bias_desc = GetDefaultMemDesc({weight_shape[0]});
+  // let the primitive choose the blocked layouts, the inputs and the output are reordered if needed
+  dnnl::memory::desc src_desc = GetAnyMemDesc(src_shape);
+  dnnl::memory::desc weights_desc = GetAnyMemDesc(weight_shape);
+  dnnl::memory::desc dst_desc = GetAnyMemDesc(dst_shape);
   dnnl::convolution_forward::desc desc =
-    dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
-                                    weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
+    has_bias_ ? dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                                src_desc, weights_desc, bias_desc, dst_desc, strides, dilates,
+                                                padding_l, padding_r)
+              : dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                                src_desc, weights_desc, dst_desc, strides, dilates, padding_l,
+                                                padding_r);
 
-  auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
+  auto prim_desc =
+    dnnl::convolution_forward::primitive_desc(desc, GetPrimitiveAttr(kernel_node), MKLKernelEngine::Get().engine());
+  CreatePrimitive<dnnl::convolution_forward>(kernel_node, GetDescKey(desc), prim_desc);
 
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
+  AddInputArgument(DNNL_ARG_SRC, 0, GetInputLayout(kernel_node, 0, src_shape), prim_desc.src_desc());
+  AddInputArgument(DNNL_ARG_WEIGHTS, 1, GetDefaultMemDesc(weight_shape), prim_desc.weights_desc(),
+                   IsParameterInput(kernel_node, 1));
+  if (has_bias_) {
+    AddInputArgument(DNNL_ARG_BIAS, 2, bias_desc, prim_desc.bias_desc());
+  }
+  AddOutputArgument(kernel_node, DNNL_ARG_DST, 0, prim_desc.dst_desc());
 }
 
 bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -81,10 +93,10 @@ bool Conv2dCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
-  SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
-  SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
-  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
-  ExecutePrimitive();
+  if (has_bias_ && inputs.size() < 3) {
+    MS_LOG(EXCEPTION) << "conv2d with bias needs 3 inputs!";
+  }
+  ExecuteWithLayouts(inputs, outputs);
   return true;
 }
 }  // namespace kernel
@@ -31,12 +31,22 @@ class Conv2dCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool has_bias_{false};
 };
 
 MS_REG_CPU_KERNEL(
   Conv2D,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   Conv2dCPUKernel);
+MS_REG_CPU_KERNEL_EX(Conv2D, Bias,
+                     KernelAttr()
+                       .AddInputAttr(kNumberTypeFloat32)
+                       .AddInputAttr(kNumberTypeFloat32)
+                       .AddInputAttr(kNumberTypeFloat32)
+                       .AddOutputAttr(kNumberTypeFloat32),
+                     Conv2dCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
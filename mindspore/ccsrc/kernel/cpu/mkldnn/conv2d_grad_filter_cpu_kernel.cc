@@ -29,9 +29,9 @@ void Conv2dGradFilterCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (src_shape.size() != 4 || weight_shape.size() != 4) {
     MS_LOG(EXCEPTION) << ("conv2d grad filter only support nchw input!");
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc weights_desc = GetDefaultMemDesc(weight_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc src_desc = GetAnyMemDesc(src_shape);
+  dnnl::memory::desc weights_desc = GetAnyMemDesc(weight_shape);
+  dnnl::memory::desc dst_desc = GetAnyMemDesc(dst_shape);
 
   int kernel_size = SizeToInt(weight_shape[3]);
   auto stride_ori = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDE);
@@ -69,12 +69,13 @@ void Conv2dGradFilterCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     dnnl::algorithm::convolution_auto, src_desc, weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
 
   auto backward_prim_desc = dnnl::convolution_backward_weights::primitive_desc(
-    backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::convolution_backward_weights>(backward_prim_desc);
+    backward_desc, GetPrimitiveAttr(kernel_node), MKLKernelEngine::Get().engine(), forward_prim_desc);
+  CreatePrimitive<dnnl::convolution_backward_weights>(kernel_node, GetDescKey(backward_desc) + GetDescKey(forward_desc),
+                                                      backward_prim_desc);
 
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DIFF_DST, dst_desc);
-  AddArgument(DNNL_ARG_DIFF_WEIGHTS, weights_desc);
+  AddInputArgument(DNNL_ARG_DIFF_DST, 0, GetDefaultMemDesc(dst_shape), backward_prim_desc.diff_dst_desc());
+  AddInputArgument(DNNL_ARG_SRC, 1, GetDefaultMemDesc(src_shape), backward_prim_desc.src_desc());
+  AddOutputArgument(kernel_node, DNNL_ARG_DIFF_WEIGHTS, 0, backward_prim_desc.diff_weights_desc());
 }
 
 bool Conv2dGradFilterCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -83,10 +84,7 @@ bool Conv2dGradFilterCPUKernel::Launch(const std::vector<kernel::AddressPtr> &in
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
-  SetArgumentHandle(DNNL_ARG_SRC, inputs[1]->addr);
-  SetArgumentHandle(DNNL_ARG_DIFF_DST, inputs[0]->addr);
-  SetArgumentHandle(DNNL_ARG_DIFF_WEIGHTS, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecuteWithLayouts(inputs, outputs);
   return true;
 }
 }  // namespace kernel
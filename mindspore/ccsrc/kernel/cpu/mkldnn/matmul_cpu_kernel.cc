@@ -45,14 +45,81 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     trans_b_ = TRANSPOSE_YES;
   }
   dim_n_ = static_cast<dnnl_dim_t>(dst_shape[1]);
+
+  has_bias_ = AnfAlgo::GetInputTensorNum(kernel_node) > 2;
+  fused_relu_ = HasFusedRelu(kernel_node);
+  if ((has_bias_ || fused_relu_) && !trans_a) {
+    InitInnerProduct(kernel_node);
+  }
+}
+
+void MatMulCPUKernel::InitInnerProduct(const CNodePtr &kernel_node) {
+  use_inner_product_ = true;
+  dnnl::memory::desc src_desc({dim_m_, dim_k_}, dnnl::memory::data_type::f32, dnnl::memory::format_tag::ab);
+  // the weights of inner product are {n, k}, a b which is not transposed is read as its transpose
+  auto weights_tag = trans_b_ == TRANSPOSE_YES ? dnnl::memory::format_tag::oi : dnnl::memory::format_tag::io;
+  dnnl::memory::desc weights_desc({dim_n_, dim_k_}, dnnl::memory::data_type::f32, weights_tag);
+  dnnl::memory::desc bias_desc({dim_n_}, dnnl::memory::data_type::f32, dnnl::memory::format_tag::a);
+  dnnl::memory::desc dst_desc({dim_m_, dim_n_}, dnnl::memory::data_type::f32, dnnl::memory::format_tag::ab);
+  dnnl::inner_product_forward::desc desc =
+    has_bias_ ? dnnl::inner_product_forward::desc(dnnl::prop_kind::forward_inference, src_desc, weights_desc,
+                                                  bias_desc, dst_desc)
+              : dnnl::inner_product_forward::desc(dnnl::prop_kind::forward_inference, src_desc, weights_desc, dst_desc);
+  auto prim_desc =
+    dnnl::inner_product_forward::primitive_desc(desc, GetPrimitiveAttr(kernel_node), MKLKernelEngine::Get().engine());
+  CreatePrimitive<dnnl::inner_product_forward>(kernel_node, GetDescKey(desc), prim_desc);
+  AddArgument(DNNL_ARG_SRC, src_desc);
+  AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
+  if (has_bias_) {
+    AddArgument(DNNL_ARG_BIAS, bias_desc);
+  }
+  AddArgument(DNNL_ARG_DST, dst_desc);
+}
+
+void MatMulCPUKernel::LaunchGemmWithBias(const float *input_a, const float *input_b, const float *bias,
+                                         float *output) {
+  dnnl_dim_t lda = trans_a_ == TRANSPOSE_NO ? dim_k_ : dim_m_;
+  dnnl_dim_t ldb = trans_b_ == TRANSPOSE_NO ? dim_n_ : dim_k_;
+  float beta = 0.f;
+  if (bias != nullptr) {
+    // start from the bias and accumulate the product on it
+    for (dnnl_dim_t i = 0; i < dim_m_; ++i) {
+      std::copy(bias, bias + dim_n_, output + i * dim_n_);
+    }
+    beta = 1.f;
+  }
+  (void)dnnl_sgemm(trans_a_, trans_b_, dim_m_, dim_n_, dim_k_, 1.f, input_a, lda, input_b, ldb, beta, output, dim_n_);
+  if (fused_relu_) {
+    size_t size = static_cast<size_t>(dim_m_ * dim_n_);
+    for (size_t i = 0; i < size; ++i) {
+      output[i] = output[i] > 0.f ? output[i] : 0.f;
+    }
+  }
 }
 
 bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                              const std::vector<kernel::AddressPtr> & /*workspace*/,
                              const std::vector<kernel::AddressPtr> &outputs) {
-  if (inputs.size() < 2 || outputs.empty()) {
+  size_t input_num = has_bias_ ? 3 : 2;
+  if (inputs.size() < input_num || outputs.empty()) {
     MS_LOG(EXCEPTION) << "matmul error input output size!";
   }
+  if (use_inner_product_) {
+    SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
+    SetArgumentHandle(DNNL_ARG_WEIGHTS, inputs[1]->addr);
+    if (has_bias_) {
+      SetArgumentHandle(DNNL_ARG_BIAS, inputs[2]->addr);
+    }
+    SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
+    ExecutePrimitive();
+    return true;
+  }
+  if (has_bias_ || fused_relu_) {
+    auto bias = has_bias_ ? reinterpret_cast<float *>(inputs[2]->addr) : nullptr;
+    LaunchGemmWithBias(reinterpret_cast<float *>(inputs[0]->addr), reinterpret_cast<float *>(inputs[1]->addr), bias,
+                       reinterpret_cast<float *>(outputs[0]->addr));
+    return true;
+  }
   dnnl_dim_t lda = dim_m_;
   if (trans_a_ == TRANSPOSE_NO) {
     lda = dim_k_;
@@ -33,6 +33,13 @@ class MatMulCPUKernel : public MKLCPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
+  void InitInnerProduct(const CNodePtr &kernel_node);
+  void LaunchGemmWithBias(const float *input_a, const float *input_b, const float *bias, float *output);
+
+  bool has_bias_{false};
+  bool fused_relu_{false};
+  // the matmul with a fused bias or relu runs as an mkl-dnn inner product when a is not transposed
+  bool use_inner_product_{false};
   char trans_a_{TRANSPOSE_NO};
   char trans_b_{TRANSPOSE_NO};
   dnnl_dim_t dim_m_{0};
@@ -44,6 +51,13 @@ MS_REG_CPU_KERNEL(
   MatMul,
   KernelAttr().AddInputAttr(kNumberTypeFloat32).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
   MatMulCPUKernel);
+MS_REG_CPU_KERNEL_EX(MatMul, Bias,
+                     KernelAttr()
+                       .AddInputAttr(kNumberTypeFloat32)
+                       .AddInputAttr(kNumberTypeFloat32)
+                       .AddInputAttr(kNumberTypeFloat32)
+                       .AddOutputAttr(kNumberTypeFloat32),
+                     MatMulCPUKernel);
 }  // namespace kernel
 }  // namespace mindspore
 
@@ -19,6 +19,8 @@
 #include <algorithm>
 #include "common/utils.h"
 #include "kernel/cpu/mkldnn/mkl_kernel_engine.h"
+#include "utils/utils.h"
+#include "utils/data_version.h"
 
 namespace mindspore {
 namespace kernel {
@@ -86,6 +88,17 @@ dnnl::memory::desc MKLCPUKernel::GetDefaultMemDesc(const std::vector<size_t> &sh
   return mem_desc;
 }
 
+dnnl::primitive_attr MKLCPUKernel::GetPrimitiveAttr(const CNodePtr &kernel_node) const {
+  dnnl::primitive_attr attr;
+  attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+  if (HasFusedRelu(kernel_node)) {
+    dnnl::post_ops ops;
+    ops.append_eltwise(1.0f, dnnl::algorithm::eltwise_relu, 0.0f, 0.0f);
+    attr.set_post_ops(ops);
+  }
+  return attr;
+}
+
 void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc, bool alloc) {
   arguments_[arg_key] = MKLKernelEngine::Get().CreateMemory(mem_desc, alloc);
 }
@@ -98,5 +111,119 @@ void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
 }
 
 void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+
+dnnl::memory::desc MKLCPUKernel::GetAnyMemDesc(const std::vector<size_t> &shape) const {
+  dnnl::memory::dims dims;
+  dims.insert(dims.end(), shape.begin(), shape.end());
+  return dnnl::memory::desc(dims, dnnl::memory::data_type::f32, dnnl::memory::format_tag::any);
+}
+
+dnnl::memory::desc MKLCPUKernel::GetInputLayout(const CNodePtr &kernel_node, size_t index,
+                                                const std::vector<size_t> &shape) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto prev_node = AnfAlgo::GetPrevNodeOutput(kernel_node, index);
+  MS_EXCEPTION_IF_NULL(prev_node.first);
+  if (!prev_node.first->isa<CNode>() || !AnfAlgo::HasNodeAttr(kAttrBlockedLayout, prev_node.first->cast<CNodePtr>()) ||
+      !AnfAlgo::GetNodeAttr<bool>(prev_node.first, kAttrBlockedLayout)) {
+    return GetDefaultMemDesc(shape);
+  }
+  // the previous kernel has been built before as the kernels are built in execution order
+  auto prev_kernel = dynamic_cast<MKLCPUKernel *>(AnfAlgo::GetKernelMod(prev_node.first));
+  if (prev_kernel == nullptr) {
+    MS_LOG(EXCEPTION) << "The blocked output of " << prev_node.first->DebugString()
+                      << " is not written by an mkl kernel";
+  }
+  return prev_kernel->GetOutputLayout(prev_node.second);
+}
+
+bool MKLCPUKernel::IsParameterInput(const CNodePtr &kernel_node, size_t index) {
+  auto prev_node = AnfAlgo::GetPrevNodeOutput(kernel_node, index);
+  MS_EXCEPTION_IF_NULL(prev_node.first);
+  return prev_node.first->isa<Parameter>();
+}
+
+const dnnl::memory::desc &MKLCPUKernel::GetOutputLayout(size_t index) const {
+  auto iter = output_layouts_.find(index);
+  if (iter == output_layouts_.end()) {
+    MS_LOG(EXCEPTION) << "The layout of output " << index << " is not bound";
+  }
+  return iter->second;
+}
+
+void MKLCPUKernel::AddInputArgument(int arg_key, size_t index, const dnnl::memory::desc &input_desc,
+                                    const dnnl::memory::desc &prim_desc, bool cached) {
+  LayoutBinding binding;
+  binding.index = index;
+  binding.user_memory = MKLKernelEngine::Get().CreateMemory(input_desc);
+  if (input_desc == prim_desc) {
+    binding.prim_memory = binding.user_memory;
+  } else {
+    binding.prim_memory = MKLKernelEngine::Get().CreateMemory(prim_desc, true);
+    binding.reorder = std::make_shared<dnnl::reorder>(binding.user_memory, binding.prim_memory);
+    binding.cached = cached;
+  }
+  arguments_[arg_key] = binding.prim_memory;
+  input_bindings_.push_back(binding);
+}
+
+void MKLCPUKernel::AddOutputArgument(const CNodePtr &kernel_node, int arg_key, size_t index,
+                                     const dnnl::memory::desc &prim_desc) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  bool keep_blocked = AnfAlgo::HasNodeAttr(kAttrBlockedLayout, kernel_node) &&
+                      AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrBlockedLayout);
+  dnnl::memory::desc output_desc =
+    keep_blocked ? prim_desc : GetDefaultMemDesc(AnfAlgo::GetOutputDeviceShape(kernel_node, index));
+  LayoutBinding binding;
+  binding.index = index;
+  binding.user_memory = MKLKernelEngine::Get().CreateMemory(output_desc);
+  if (output_desc == prim_desc) {
+    binding.prim_memory = binding.user_memory;
+  } else {
+    binding.prim_memory = MKLKernelEngine::Get().CreateMemory(prim_desc, true);
+    binding.reorder = std::make_shared<dnnl::reorder>(binding.prim_memory, binding.user_memory);
+  }
+  // a blocked layout may pad the channels, the output address is allocated with the size of the layout
+  if (index < output_size_list_.size()) {
+    output_size_list_[index] = output_desc.get_size();
+  }
+  output_layouts_[index] = output_desc;
+  arguments_[arg_key] = binding.prim_memory;
+  output_bindings_.push_back(binding);
+}
+
+void MKLCPUKernel::ExecuteWithLayouts(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
+  auto &engine = MKLKernelEngine::Get();
+  for (auto &binding : input_bindings_) {
+    if (binding.index >= inputs.size()) {
+      MS_LOG(EXCEPTION) << "input index " << binding.index << " is out of range " << inputs.size();
+    }
+    void *addr = inputs[binding.index]->addr;
+    binding.user_memory.set_data_handle(addr);
+    if (binding.reorder == nullptr) {
+      continue;
+    }
+    if (binding.cached) {
+      uint64_t version = DataVersion::GetInstance().Get(addr);
+      if (addr == binding.cached_addr && version == binding.cached_version) {
+        continue;
+      }
+      binding.cached_addr = addr;
+      binding.cached_version = version;
+    }
+    engine.Reorder(binding.reorder, binding.user_memory, binding.prim_memory);
+  }
+  for (auto &binding : output_bindings_) {
+    if (binding.index >= outputs.size()) {
+      MS_LOG(EXCEPTION) << "output index " << binding.index << " is out of range " << outputs.size();
+    }
+    binding.user_memory.set_data_handle(outputs[binding.index]->addr);
+  }
+  ExecutePrimitive();
+  for (auto &binding : output_bindings_) {
+    if (binding.reorder != nullptr) {
+      engine.Reorder(binding.reorder, binding.prim_memory, binding.user_memory);
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -16,13 +16,16 @@
 #ifndef MINDSPORE_CCSRC_KERNEL_CPU_MKL_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_KERNEL_CPU_MKL_CPU_KERNEL_H_
 
+#include <cstdint>
 #include <string>
+#include <typeinfo>
 #include <unordered_map>
 #include <memory>
 #include <vector>
 #include "dnnl.hpp"
 #include "kernel/cpu/cpu_kernel.h"
 #include "kernel/cpu/cpu_kernel_factory.h"
+#include "kernel/cpu/mkldnn/mkl_primitive_cache.h"
 
 namespace mindspore {
 namespace kernel {
@@ -31,6 +34,9 @@ class MKLCPUKernel : public CPUKernel {
   MKLCPUKernel() = default;
   ~MKLCPUKernel() override = default;
 
+  // the layout in which the output is written for the next kernels, blocked if the layout propagation kept it
+  const dnnl::memory::desc &GetOutputLayout(size_t index) const;
+
  protected:
   void GetPadding(const CNodePtr &kernel_node, const std::string &pad_mode, const std::vector<size_t> &src_shape,
                   int kernel_size, int stride, std::vector<int> *padding_l, std::vector<int> *padding_r);
@@ -38,9 +44,60 @@ class MKLCPUKernel : public CPUKernel {
   void SetArgumentHandle(int arg_key, void *ptr);
   dnnl::memory::format_tag GetDefaultFormatTag(const dnnl::memory::dims &dims) const;
   dnnl::memory::desc GetDefaultMemDesc(const std::vector<size_t> &shape);
+  // the scratchpad is owned by the kernel, so a cached primitive can be executed by several kernels at the
+  // same time. the activation fused into the kernel is appended as post-op.
+  dnnl::primitive_attr GetPrimitiveAttr(const CNodePtr &kernel_node) const;
+  // the key of the op desc in the primitive cache
+  template <typename OpDesc>
+  static std::string GetDescKey(const OpDesc &desc) {
+    return std::string(reinterpret_cast<const char *>(&desc.data), sizeof(desc.data));
+  }
+  // take the primitive from the cache or create it, the prim_desc must be created with GetPrimitiveAttr
+  template <typename Prim>
+  void CreatePrimitive(const CNodePtr &kernel_node, const std::string &desc_key,
+                       const typename Prim::primitive_desc &prim_desc) {
+    std::string key = std::string(typeid(Prim).name()) + desc_key;
+    if (HasFusedRelu(kernel_node)) {
+      key += "_relu";
+    }
+    primitive_ = MKLPrimitiveCache::GetInstance().GetOrCreate(
+      key, [&prim_desc]() { return std::make_shared<Prim>(prim_desc); });
+    AddArgument(DNNL_ARG_SCRATCHPAD, prim_desc.scratchpad_desc(), true);
+  }
   void ExecutePrimitive();
+
+  // the desc with format_tag::any, the primitive picks its optimal (usually blocked) layout for it
+  dnnl::memory::desc GetAnyMemDesc(const std::vector<size_t> &shape) const;
+  // the layout in which the previous kernel writes the input
+  dnnl::memory::desc GetInputLayout(const CNodePtr &kernel_node, size_t index, const std::vector<size_t> &shape);
+  // bind the input to the argument of the primitive, the input is reordered when the layouts differ. the reorder of
+  // a cached input is redone only when its address or the DataVersion of the address changes, for the weights.
+  void AddInputArgument(int arg_key, size_t index, const dnnl::memory::desc &input_desc,
+                        const dnnl::memory::desc &prim_desc, bool cached = false);
+  static bool IsParameterInput(const CNodePtr &kernel_node, size_t index);
+  // bind the output, it is reordered to the plain layout unless the layout propagation kept the primitive one
+  void AddOutputArgument(const CNodePtr &kernel_node, int arg_key, size_t index, const dnnl::memory::desc &prim_desc);
+  // set the addresses of the bound arguments and execute the primitive with the reorders around it
+  void ExecuteWithLayouts(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
+
   std::unordered_map<int, dnnl::memory> arguments_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
+
+ private:
+  struct LayoutBinding {
+    size_t index{0};
+    // the memory in the layout outside the kernel, its handle is the address of the input or output
+    dnnl::memory user_memory;
+    // the memory in the layout of the primitive, owned by the kernel if a reorder is needed
+    dnnl::memory prim_memory;
+    std::shared_ptr<dnnl::reorder> reorder{nullptr};
+    bool cached{false};
+    void *cached_addr{nullptr};
+    uint64_t cached_version{0};
+  };
+  std::vector<LayoutBinding> input_bindings_;
+  std::vector<LayoutBinding> output_bindings_;
+  std::unordered_map<size_t, dnnl::memory::desc> output_layouts_;
 };
 }  // namespace kernel
 }  // namespace mindspore
@@ -22,8 +22,22 @@ namespace kernel {
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
-  primitive->execute(stream_, arguments);
-  (void)stream_.wait();
+  auto &stream = this->stream();
+  primitive->execute(stream, arguments);
+  (void)stream.wait();
+}
+
+void MKLKernelEngine::Reorder(const std::shared_ptr<dnnl::reorder> &reorder, const dnnl::memory &src,
+                              const dnnl::memory &dst) {
+  MS_EXCEPTION_IF_NULL(reorder);
+  auto &stream = this->stream();
+  reorder->execute(stream, {{DNNL_ARG_FROM, src}, {DNNL_ARG_TO, dst}});
+  (void)stream.wait();
+}
+
+dnnl::stream &MKLKernelEngine::stream() {
+  thread_local dnnl::stream stream(engine_);
+  return stream;
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
@@ -39,11 +39,15 @@ class MKLKernelEngine {
   void Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                const std::unordered_map<int, dnnl::memory> &arguments);
 
+  void Reorder(const std::shared_ptr<dnnl::reorder> &reorder, const dnnl::memory &src, const dnnl::memory &dst);
+
+  // every thread executes on its own stream, the kernels run concurrently without sharing the queue
+  dnnl::stream &stream();
+
  private:
-  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0), stream_(engine_) {}
+  MKLKernelEngine() : engine_(dnnl::engine::kind::cpu, 0) {}
   ~MKLKernelEngine() = default;
   dnnl::engine engine_;
-  dnnl::stream stream_;
 };
 }  // namespace kernel
 }  // namespace mindspore
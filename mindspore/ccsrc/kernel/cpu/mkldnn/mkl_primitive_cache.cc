@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/mkldnn/mkl_primitive_cache.h"
+#include <string>
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+MKLPrimitiveCache::MKLPrimitiveCache() {
+  auto capacity_env = common::GetEnv("MS_MKL_PRIMITIVE_CACHE_CAPACITY");
+  if (!capacity_env.empty()) {
+    int capacity = std::stoi(capacity_env);
+    if (capacity < 0) {
+      MS_LOG(EXCEPTION) << "Error mkl primitive cache capacity " << capacity << ".";
+    }
+    capacity_ = IntToSize(capacity);
+  }
+  MS_LOG(INFO) << "Mkl primitive cache capacity = " << capacity_ << ".";
+}
+
+std::shared_ptr<dnnl::primitive> MKLPrimitiveCache::GetOrCreate(const std::string &key,
+                                                                const PrimitiveCreator &creator) {
+  {
+    std::lock_guard<std::mutex> locker(lock_);
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, iter->second);
+      (void)hit_count_.fetch_add(1);
+      return iter->second->second;
+    }
+  }
+  (void)miss_count_.fetch_add(1);
+  // the code generation is done outside the lock, the kernels of different ops are built concurrently
+  auto primitive = creator();
+  MS_EXCEPTION_IF_NULL(primitive);
+  std::lock_guard<std::mutex> locker(lock_);
+  if (capacity_ == 0) {
+    return primitive;
+  }
+  auto iter = index_.find(key);
+  if (iter != index_.end()) {
+    // created by another thread at the same time, keep the cached one
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    return iter->second->second;
+  }
+  entries_.emplace_front(key, primitive);
+  index_[key] = entries_.begin();
+  Evict();
+  return primitive;
+}
+
+void MKLPrimitiveCache::Clear() {
+  std::lock_guard<std::mutex> locker(lock_);
+  entries_.clear();
+  index_.clear();
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+
+void MKLPrimitiveCache::set_capacity(size_t capacity) {
+  std::lock_guard<std::mutex> locker(lock_);
+  capacity_ = capacity;
+  Evict();
+}
+
+size_t MKLPrimitiveCache::capacity() const {
+  std::lock_guard<std::mutex> locker(lock_);
+  return capacity_;
+}
+
+size_t MKLPrimitiveCache::size() const {
+  std::lock_guard<std::mutex> locker(lock_);
+  return entries_.size();
+}
+
+void MKLPrimitiveCache::Evict() {
+  while (entries_.size() > capacity_) {
+    (void)index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
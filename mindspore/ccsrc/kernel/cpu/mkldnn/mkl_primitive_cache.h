@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_MKLDNN_MKL_PRIMITIVE_CACHE_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_MKLDNN_MKL_PRIMITIVE_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "dnnl.hpp"
+#include "common/utils.h"
+
+namespace mindspore {
+namespace kernel {
+// lru cache of the created primitives keyed by the op desc, the kernels of the same shapes in different graphs
+// and the repeated pynative calls share one primitive instead of generating the code again.
+class MKLPrimitiveCache {
+ public:
+  using PrimitiveCreator = std::function<std::shared_ptr<dnnl::primitive>()>;
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  static MKLPrimitiveCache &GetInstance() {
+    static MKLPrimitiveCache instance;
+    return instance;
+  }
+  DISABLE_COPY_AND_ASSIGN(MKLPrimitiveCache)
+
+  std::shared_ptr<dnnl::primitive> GetOrCreate(const std::string &key, const PrimitiveCreator &creator);
+  void Clear();
+  // the least recently used primitives are dropped when the capacity shrinks, 0 disables the cache
+  void set_capacity(size_t capacity);
+  size_t capacity() const;
+  size_t size() const;
+  uint64_t hit_count() const { return hit_count_.load(); }
+  uint64_t miss_count() const { return miss_count_.load(); }
+
+ private:
+  MKLPrimitiveCache();
+  ~MKLPrimitiveCache() = default;
+  void Evict();
+
+  using Entry = std::pair<std::string, std::shared_ptr<dnnl::primitive>>;
+  mutable std::mutex lock_;
+  size_t capacity_{kDefaultCapacity};
+  // the most recently used entry is at the front
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_MKLDNN_MKL_PRIMITIVE_CACHE_H_
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "kernel/cpu/mkldnn/mul_cpu_kernel.h"
+#include <functional>
+#include <numeric>
 #include "kernel/cpu/mkldnn/mkl_kernel_engine.h"
 #include "device/cpu/cpu_device_address.h"
 #include "common/utils.h"
@@ -29,6 +31,16 @@ void MulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     MS_LOG(EXCEPTION) << "mul only support same dim input or tensor * scalar " << src0_shape.size() << " vs "
                       << src1_shape.size();
   }
+  fused_relu_ = HasFusedRelu(kernel_node);
+  if (fused_relu_) {
+    output_size_ = std::accumulate(dst_shape.begin(), dst_shape.end(), size_t(1), std::multiplies<size_t>());
+    scalar_input1_ =
+      std::accumulate(src1_shape.begin(), src1_shape.end(), size_t(1), std::multiplies<size_t>()) == 1;
+    if (!scalar_input1_ && src0_shape != src1_shape) {
+      MS_LOG(EXCEPTION) << "mul with fused relu only support same shape input or tensor * scalar";
+    }
+    return;
+  }
   if (src1_shape.size() < src0_shape.size()) {
     for (size_t i = src1_shape.size(); i < src0_shape.size(); ++i) {
       src1_shape.emplace_back(1);
@@ -38,8 +50,8 @@ void MulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   dnnl::memory::desc src1_mem_desc = GetDefaultMemDesc(src1_shape);
   dnnl::memory::desc dst_mem_desc = GetDefaultMemDesc(dst_shape);
   dnnl::binary::desc desc = dnnl::binary::desc(dnnl::algorithm::binary_mul, src0_mem_desc, src1_mem_desc, dst_mem_desc);
-  auto prim_desc = dnnl::binary::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::binary>(prim_desc);
+  auto prim_desc = dnnl::binary::primitive_desc(desc, GetPrimitiveAttr(kernel_node), MKLKernelEngine::Get().engine());
+  CreatePrimitive<dnnl::binary>(kernel_node, GetDescKey(desc), prim_desc);
   AddArgument(DNNL_ARG_SRC_0, src0_mem_desc);
   AddArgument(DNNL_ARG_SRC_1, src1_mem_desc);
   AddArgument(DNNL_ARG_DST, dst_mem_desc);
@@ -51,6 +63,24 @@ bool MulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs.size() < 2 || outputs.empty()) {
     MS_LOG(EXCEPTION) << "mul error input output size!";
   }
+  if (fused_relu_) {
+    auto input0 = reinterpret_cast<float *>(inputs[0]->addr);
+    auto input1 = reinterpret_cast<float *>(inputs[1]->addr);
+    auto output = reinterpret_cast<float *>(outputs[0]->addr);
+    if (scalar_input1_) {
+      float scalar = input1[0];
+      for (size_t i = 0; i < output_size_; ++i) {
+        float value = input0[i] * scalar;
+        output[i] = value > 0.f ? value : 0.f;
+      }
+    } else {
+      for (size_t i = 0; i < output_size_; ++i) {
+        float value = input0[i] * input1[i];
+        output[i] = value > 0.f ? value : 0.f;
+      }
+    }
+    return true;
+  }
   SetArgumentHandle(DNNL_ARG_SRC_0, inputs[0]->addr);
   SetArgumentHandle(DNNL_ARG_SRC_1, inputs[1]->addr);
   SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
@@ -31,6 +31,12 @@ class MulCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  // mul followed by the relu folded by the cpu ir fusion, computed in one pass over the output
+  bool fused_relu_{false};
+  bool scalar_input1_{false};
+  size_t output_size_{0};
 };
 
 MS_REG_CPU_KERNEL(
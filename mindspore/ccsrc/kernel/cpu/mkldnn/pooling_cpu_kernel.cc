@@ -26,8 +26,8 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   std::vector<size_t> src_shape = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   std::vector<size_t> dst_shape = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
-  dnnl::memory::desc dst_desc = GetDefaultMemDesc(dst_shape);
+  dnnl::memory::desc src_desc = GetInputLayout(kernel_node, 0, src_shape);
+  dnnl::memory::desc dst_desc = GetAnyMemDesc(dst_shape);
   std::vector<int> kernel_sizes = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, KSIZE);
   std::vector<int> strides = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, STRIDES);
   if (kernel_sizes.size() != 4 || strides.size() != 4) {
@@ -47,11 +47,12 @@ void PoolingCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   dnnl::pooling_forward::desc desc =
     dnnl::pooling_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::pooling_max, src_desc, dst_desc,
                                 strides_dims, kernels_dims, padding_l, padding_r);
-  auto prim_desc = dnnl::pooling_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::pooling_forward>(prim_desc);
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, dst_desc);
-  AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc());
+  auto prim_desc =
+    dnnl::pooling_forward::primitive_desc(desc, GetPrimitiveAttr(kernel_node), MKLKernelEngine::Get().engine());
+  CreatePrimitive<dnnl::pooling_forward>(kernel_node, GetDescKey(desc), prim_desc);
+  AddInputArgument(DNNL_ARG_SRC, 0, src_desc, prim_desc.src_desc());
+  AddOutputArgument(kernel_node, DNNL_ARG_DST, 0, prim_desc.dst_desc());
+  AddArgument(DNNL_ARG_WORKSPACE, prim_desc.workspace_desc(), true);
 }
 
 bool PoolingCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -60,9 +61,7 @@ bool PoolingCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs.empty() || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
-  SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
-  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecuteWithLayouts(inputs, outputs);
   return true;
 }
 }  // namespace kernel
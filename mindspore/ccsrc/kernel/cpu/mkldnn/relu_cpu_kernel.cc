@@ -26,15 +26,17 @@ void ReluCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   if (src_shape.size() != 4 && src_shape.size() != 2) {
     MS_LOG(EXCEPTION) << "relu kernel dims invalid " << src_shape.size();
   }
-  dnnl::memory::desc src_desc = GetDefaultMemDesc(src_shape);
+  // relu works in the layout of its input, a blocked input stays blocked
+  dnnl::memory::desc src_desc = GetInputLayout(kernel_node, 0, src_shape);
 
   dnnl::eltwise_forward::desc desc =
     dnnl::eltwise_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::eltwise_relu, src_desc, 0.0);
-  auto prim_desc = dnnl::eltwise_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
-  primitive_ = std::make_shared<dnnl::eltwise_forward>(prim_desc);
+  auto prim_desc =
+    dnnl::eltwise_forward::primitive_desc(desc, GetPrimitiveAttr(kernel_node), MKLKernelEngine::Get().engine());
+  CreatePrimitive<dnnl::eltwise_forward>(kernel_node, GetDescKey(desc), prim_desc);
 
-  AddArgument(DNNL_ARG_SRC, src_desc);
-  AddArgument(DNNL_ARG_DST, src_desc);
+  AddInputArgument(DNNL_ARG_SRC, 0, src_desc, prim_desc.src_desc());
+  AddOutputArgument(kernel_node, DNNL_ARG_DST, 0, prim_desc.dst_desc());
 }
 
 bool ReluCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -43,9 +45,7 @@ bool ReluCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   if (inputs.empty() || outputs.empty()) {
     MS_LOG(EXCEPTION) << "error input output size!";
   }
-  SetArgumentHandle(DNNL_ARG_SRC, inputs[0]->addr);
-  SetArgumentHandle(DNNL_ARG_DST, outputs[0]->addr);
-  ExecutePrimitive();
+  ExecuteWithLayouts(inputs, outputs);
   return true;
 }
 }  // namespace kernel
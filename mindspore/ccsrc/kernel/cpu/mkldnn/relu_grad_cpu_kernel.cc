@@ -34,9 +34,10 @@ void ReluGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
 
   dnnl::eltwise_backward::desc backward_desc =
     dnnl::eltwise_backward::desc(dnnl::algorithm::eltwise_relu, src_desc, src_desc, 0.0, 0.0);
-  auto backward_prim_desc =
-    dnnl::eltwise_backward::primitive_desc(backward_desc, MKLKernelEngine::Get().engine(), forward_prim_desc);
-  primitive_ = std::make_shared<dnnl::eltwise_backward>(backward_prim_desc);
+  auto backward_prim_desc = dnnl::eltwise_backward::primitive_desc(
+    backward_desc, GetPrimitiveAttr(kernel_node), MKLKernelEngine::Get().engine(), forward_prim_desc);
+  CreatePrimitive<dnnl::eltwise_backward>(kernel_node, GetDescKey(backward_desc) + GetDescKey(forward_desc),
+                                          backward_prim_desc);
 
   AddArgument(DNNL_ARG_SRC, src_desc);
   AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "kernel/cpu/one_hot_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
 #include "device/cpu/cpu_device_address.h"
 
 namespace mindspore {
@@ -52,19 +53,24 @@ bool OneHotCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
   auto output = reinterpret_cast<float *>(outputs[0]->addr);
   size_t elem_num = inputs[0]->size / sizeof(int);
 
-  for (size_t i = 0; i < elem_num; i++) {
-    size_t stride_num = i / stride_;
-    size_t output_index = stride_num * depth_ * stride_ + i % stride_;
-    size_t index = IntToSize(indices[i]);
-    for (size_t j = 0; j < depth_; j++) {
-      if (index == j) {
-        output[output_index] = on_value;
-      } else {
-        output[output_index] = off_value;
+  size_t depth = depth_;
+  size_t stride = stride_;
+  size_t grain = ParallelGrain(depth);
+  CPUThreadPool::GetInstance().ParallelFor(elem_num, grain, [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      size_t stride_num = i / stride;
+      size_t output_index = stride_num * depth * stride + i % stride;
+      size_t index = IntToSize(indices[i]);
+      for (size_t j = 0; j < depth; j++) {
+        if (index == j) {
+          output[output_index] = on_value;
+        } else {
+          output[output_index] = off_value;
+        }
+        output_index += stride;
       }
-      output_index += stride_;
     }
-  }
+  });
 
   return true;
 }
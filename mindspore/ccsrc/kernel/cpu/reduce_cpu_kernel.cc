@@ -0,0 +1,209 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/reduce_cpu_kernel.h"
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <utility>
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "kernel/cpu/simd/vector_math.h"
+#include "device/cpu/cpu_device_address.h"
+#include "operator/ops.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+// the inner dims are split into blocks of this many elements so that a reduction with a small outer size still runs
+// on several threads
+constexpr size_t kReduceInnerBlock = 1024;
+
+std::vector<size_t> GetReduceAxes(const CNodePtr &kernel_node, size_t rank) {
+  auto axis_attr = AnfAlgo::GetCNodePrimitive(kernel_node)->GetAttr(AXIS);
+  MS_EXCEPTION_IF_NULL(axis_attr);
+  std::vector<int> axes;
+  if (axis_attr->isa<ValueTuple>() || axis_attr->isa<ValueList>()) {
+    axes = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, AXIS);
+  } else if (axis_attr->isa<Int32Imm>()) {
+    axes.push_back(AnfAlgo::GetNodeAttr<int>(kernel_node, AXIS));
+  } else {
+    MS_LOG(EXCEPTION) << "attribute axis type is invalid.";
+  }
+  std::vector<size_t> result;
+  // an empty axis reduces all dims
+  if (axes.empty()) {
+    for (size_t i = 0; i < rank; ++i) {
+      result.push_back(i);
+    }
+    return result;
+  }
+  for (auto axis : axes) {
+    if (axis < 0) {
+      axis += SizeToInt(rank);
+    }
+    if (axis < 0 || IntToSize(axis) >= rank) {
+      MS_LOG(EXCEPTION) << "invalid axis: " << axis << ", rank: " << rank;
+    }
+    result.push_back(IntToSize(axis));
+  }
+  return result;
+}
+}  // namespace
+
+void ReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
+  if (kernel_name == prim::kPrimReduceSum->name()) {
+    reduce_type_ = kReduceSum;
+  } else if (kernel_name == prim::kPrimReduceMean->name()) {
+    reduce_type_ = kReduceMean;
+  } else if (kernel_name == prim::kPrimReduceMax->name()) {
+    reduce_type_ = kReduceMax;
+  } else {
+    MS_LOG(EXCEPTION) << "unsupported reduce op " << kernel_name;
+  }
+  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  auto axes = GetReduceAxes(kernel_node, input_shape.size());
+  std::vector<bool> reduced(input_shape.size(), false);
+  for (auto axis : axes) {
+    reduced[axis] = true;
+  }
+  // merge the neighbouring dims of the same kind, the dims of size 1 go with either
+  std::vector<std::pair<size_t, bool>> groups;
+  reduce_num_ = 1;
+  for (size_t i = 0; i < input_shape.size(); ++i) {
+    if (reduced[i]) {
+      reduce_num_ *= input_shape[i];
+    }
+    if (input_shape[i] == 1) {
+      continue;
+    }
+    if (!groups.empty() && groups.back().second == reduced[i]) {
+      groups.back().first *= input_shape[i];
+    } else {
+      groups.emplace_back(input_shape[i], reduced[i]);
+    }
+  }
+  // reduce the innermost group first, so that a reduced last dim is a row reduction
+  steps_.clear();
+  workspace_size_list_.clear();
+  while (true) {
+    auto iter = std::find_if(groups.rbegin(), groups.rend(), [](const std::pair<size_t, bool> &group) {
+      return group.second;
+    });
+    if (iter == groups.rend()) {
+      break;
+    }
+    size_t index = static_cast<size_t>(std::distance(iter, groups.rend()) - 1);
+    ReduceStep step{1, groups[index].first, 1};
+    for (size_t i = 0; i < index; ++i) {
+      step.outer *= groups[i].first;
+    }
+    for (size_t i = index + 1; i < groups.size(); ++i) {
+      step.inner *= groups[i].first;
+    }
+    if (!steps_.empty()) {
+      // the result of the previous step
+      workspace_size_list_.push_back(step.outer * step.mid * step.inner * sizeof(float));
+    }
+    steps_.push_back(step);
+    (void)groups.erase(groups.begin() + SizeToInt(index));
+    if (index > 0 && index < groups.size()) {
+      groups[index - 1].first *= groups[index].first;
+      (void)groups.erase(groups.begin() + SizeToInt(index));
+    }
+  }
+}
+
+void ReduceCPUKernel::RunStep(const ReduceStep &step, const float *src, float *dst) const {
+  bool is_max = reduce_type_ == kReduceMax;
+  if (step.inner == 1) {
+    size_t grain = ParallelGrain(step.mid);
+    CPUThreadPool::GetInstance().ParallelFor(step.outer, grain, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        const float *row = src + i * step.mid;
+        dst[i] = is_max ? VecMax(row, step.mid) : VecSum(row, step.mid);
+      }
+    });
+    return;
+  }
+  size_t block_num = (step.inner + kReduceInnerBlock - 1) / kReduceInnerBlock;
+  size_t block_work = std::min(step.inner, kReduceInnerBlock) * step.mid;
+  size_t grain = ParallelGrain(block_work);
+  // accumulate the mid rows of each [inner] block into the output block
+  CPUThreadPool::GetInstance().ParallelFor(step.outer * block_num, grain, [&](size_t begin, size_t end) {
+    for (size_t task = begin; task < end; ++task) {
+      size_t outer = task / block_num;
+      size_t offset = (task % block_num) * kReduceInnerBlock;
+      size_t len = std::min(kReduceInnerBlock, step.inner - offset);
+      const float *src_block = src + outer * step.mid * step.inner + offset;
+      float *dst_block = dst + outer * step.inner + offset;
+      auto ret = memcpy_s(dst_block, len * sizeof(float), src_block, len * sizeof(float));
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+      }
+      for (size_t m = 1; m < step.mid; ++m) {
+        const float *src_row = src_block + m * step.inner;
+        if (is_max) {
+          VecMaximum(dst_block, src_row, dst_block, len);
+        } else {
+          VecAdd(dst_block, src_row, dst_block, len);
+        }
+      }
+    }
+  });
+}
+
+bool ReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                             const std::vector<kernel::AddressPtr> &workspace,
+                             const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty() || workspace.size() < workspace_size_list_.size()) {
+    MS_LOG(EXCEPTION) << "input, workspace or output size error!";
+  }
+  size_t input_size = inputs[0]->size / sizeof(float);
+  size_t output_size = outputs[0]->size / sizeof(float);
+  if (output_size * reduce_num_ != input_size) {
+    MS_LOG(EXCEPTION) << "input or output data size error!";
+  }
+  if (input_size == 0) {
+    return true;
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  if (steps_.empty()) {
+    if (input != output) {
+      auto ret = memcpy_s(output, outputs[0]->size, input, inputs[0]->size);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+      }
+    }
+    return true;
+  }
+  const float *src = input;
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    float *dst = i + 1 == steps_.size() ? output : reinterpret_cast<float *>(workspace[i]->addr);
+    RunStep(steps_[i], src, dst);
+    src = dst;
+  }
+  if (reduce_type_ == kReduceMean) {
+    float scale = 1.f / reduce_num_;
+    CPUThreadPool::GetInstance().ParallelFor(output_size, kParallelGrainSize, [=](size_t begin, size_t end) {
+      VecScaleShift(output + begin, scale, 0.f, output + begin, end - begin);
+    });
+  }
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/simd/cpu_isa.h"
+#include <algorithm>
+#include "common/utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+CPUISA DetectHostISA() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return CPUISA::kAVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return CPUISA::kAVX2;
+  }
+#endif
+  return CPUISA::kGeneric;
+}
+
+CPUISA InitCPUISA() {
+  CPUISA isa = DetectHostISA();
+  auto isa_env = common::GetEnv("MS_CPU_ISA");
+  if (!isa_env.empty()) {
+    CPUISA limit = CPUISA::kAVX512;
+    if (isa_env == "generic") {
+      limit = CPUISA::kGeneric;
+    } else if (isa_env == "avx2") {
+      limit = CPUISA::kAVX2;
+    } else if (isa_env != "avx512") {
+      MS_LOG(WARNING) << "Invalid MS_CPU_ISA " << isa_env << ", it should be generic, avx2 or avx512.";
+    }
+    isa = std::min(isa, limit);
+  }
+  MS_LOG(INFO) << "Cpu kernels use isa " << GetCPUISAName(isa);
+  return isa;
+}
+}  // namespace
+
+CPUISA GetCPUISA() {
+  static const CPUISA isa = InitCPUISA();
+  return isa;
+}
+
+std::string GetCPUISAName(CPUISA isa) {
+  switch (isa) {
+    case CPUISA::kAVX2:
+      return "avx2";
+    case CPUISA::kAVX512:
+      return "avx512";
+    default:
+      return "generic";
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
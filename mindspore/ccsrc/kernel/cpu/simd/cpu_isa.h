@@ -0,0 +1,31 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_SIMD_CPU_ISA_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_SIMD_CPU_ISA_H_
+
+#include <string>
+
+namespace mindspore {
+namespace kernel {
+enum class CPUISA { kGeneric = 0, kAVX2 = 1, kAVX512 = 2 };
+
+// the best isa of the host, the env MS_CPU_ISA=generic|avx2|avx512 caps it, e.g. to compare with the generic code
+CPUISA GetCPUISA();
+std::string GetCPUISAName(CPUISA isa);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_SIMD_CPU_ISA_H_
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/simd/vector_math.h"
+#include <cmath>
+#include <limits>
+#include "kernel/cpu/simd/vector_math_impl.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+float GenericSum(const float *x, size_t n) {
+  float sum = 0.f;
+  for (size_t i = 0; i < n; ++i) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+float GenericMax(const float *x, size_t n) {
+  float result = -std::numeric_limits<float>::infinity();
+  for (size_t i = 0; i < n; ++i) {
+    result = x[i] > result ? x[i] : result;
+  }
+  return result;
+}
+
+float GenericSquareDiffSum(const float *x, float mean, size_t n) {
+  float sum = 0.f;
+  for (size_t i = 0; i < n; ++i) {
+    float diff = x[i] - mean;
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+void GenericAdd(const float *a, const float *b, float *out, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = a[i] + b[i];
+  }
+}
+
+void GenericMaximum(const float *a, const float *b, float *out, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = a[i] > b[i] ? a[i] : b[i];
+  }
+}
+
+void GenericScaleShift(const float *x, float scale, float shift, float *y, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    y[i] = x[i] * scale + shift;
+  }
+}
+
+void GenericNormalize(const float *x, const float *gamma, const float *beta, float mean, float rstd, float *y,
+                      size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    y[i] = (x[i] - mean) * rstd * gamma[i] + beta[i];
+  }
+}
+
+void GenericGelu(const float *x, float *y, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    float value = x[i];
+    y[i] = 0.5f * value * (1.f + std::tanh(0.7978845608f * (value + 0.044715f * value * value * value)));
+  }
+}
+
+void GenericAdam(const AdamParam &param, const float *grad, float *var, float *m, float *v, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    float g = grad[i];
+    m[i] = param.beta1 * m[i] + (1.f - param.beta1) * g;
+    v[i] = param.beta2 * v[i] + (1.f - param.beta2) * g * g;
+    float update = param.use_nesterov ? m[i] * param.beta1 + (1.f - param.beta1) * g : m[i];
+    var[i] -= param.lr * update / (std::sqrt(v[i]) + param.epsilon);
+  }
+}
+
+struct VectorMathDispatch {
+  CPUISA isa{CPUISA::kGeneric};
+  const VectorMathTable *table{nullptr};
+};
+
+VectorMathDispatch InitDispatch() {
+  VectorMathDispatch dispatch;
+  CPUISA isa = GetCPUISA();
+  if (isa == CPUISA::kAVX512 && GetAVX512VectorMathTable() != nullptr) {
+    dispatch = {CPUISA::kAVX512, GetAVX512VectorMathTable()};
+  } else if (isa >= CPUISA::kAVX2 && GetAVX2VectorMathTable() != nullptr) {
+    dispatch = {CPUISA::kAVX2, GetAVX2VectorMathTable()};
+  } else {
+    dispatch = {CPUISA::kGeneric, GetGenericVectorMathTable()};
+  }
+  MS_LOG(INFO) << "Cpu vector math uses isa " << GetCPUISAName(dispatch.isa);
+  return dispatch;
+}
+
+const VectorMathDispatch &GetDispatch() {
+  static const VectorMathDispatch dispatch = InitDispatch();
+  return dispatch;
+}
+}  // namespace
+
+const VectorMathTable *GetGenericVectorMathTable() {
+  static const VectorMathTable table{GenericSum,       GenericMax,     GenericSquareDiffSum,
+                                     GenericAdd,       GenericMaximum, GenericScaleShift,
+                                     GenericNormalize, GenericGelu,    GenericAdam};
+  return &table;
+}
+
+float VecSum(const float *x, size_t n) { return GetDispatch().table->sum(x, n); }
+
+float VecMax(const float *x, size_t n) { return GetDispatch().table->max(x, n); }
+
+float VecSquareDiffSum(const float *x, float mean, size_t n) {
+  return GetDispatch().table->square_diff_sum(x, mean, n);
+}
+
+void VecAdd(const float *a, const float *b, float *out, size_t n) { GetDispatch().table->add(a, b, out, n); }
+
+void VecMaximum(const float *a, const float *b, float *out, size_t n) { GetDispatch().table->maximum(a, b, out, n); }
+
+void VecScaleShift(const float *x, float scale, float shift, float *y, size_t n) {
+  GetDispatch().table->scale_shift(x, scale, shift, y, n);
+}
+
+void VecNormalize(const float *x, const float *gamma, const float *beta, float mean, float rstd, float *y, size_t n) {
+  GetDispatch().table->normalize(x, gamma, beta, mean, rstd, y, n);
+}
+
+void VecGelu(const float *x, float *y, size_t n) { GetDispatch().table->gelu(x, y, n); }
+
+void VecAdam(const AdamParam &param, const float *grad, float *var, float *m, float *v, size_t n) {
+  GetDispatch().table->adam(param, grad, var, m, v, n);
+}
+
+CPUISA GetVectorMathISA() { return GetDispatch().isa; }
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,55 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_SIMD_VECTOR_MATH_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_SIMD_VECTOR_MATH_H_
+
+#include <cstddef>
+#include "kernel/cpu/simd/cpu_isa.h"
+
+namespace mindspore {
+namespace kernel {
+// the float routines of the cpu kernels, dispatched to the avx512, avx2 or generic code by GetCPUISA
+struct AdamParam {
+  // lr * sqrt(1 - beta2_power) / (1 - beta1_power)
+  float lr{0.f};
+  float beta1{0.f};
+  float beta2{0.f};
+  float epsilon{0.f};
+  bool use_nesterov{false};
+};
+
+float VecSum(const float *x, size_t n);
+float VecMax(const float *x, size_t n);
+// sum((x - mean)^2)
+float VecSquareDiffSum(const float *x, float mean, size_t n);
+// out = a + b
+void VecAdd(const float *a, const float *b, float *out, size_t n);
+// out = max(a, b)
+void VecMaximum(const float *a, const float *b, float *out, size_t n);
+// y = x * scale + shift
+void VecScaleShift(const float *x, float scale, float shift, float *y, size_t n);
+// y = (x - mean) * rstd * gamma + beta
+void VecNormalize(const float *x, const float *gamma, const float *beta, float mean, float rstd, float *y, size_t n);
+// gelu with the tanh approximation, 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+void VecGelu(const float *x, float *y, size_t n);
+// update var, m and v in place
+void VecAdam(const AdamParam &param, const float *grad, float *var, float *m, float *v, size_t n);
+// the isa the routines are dispatched to
+CPUISA GetVectorMathISA();
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_SIMD_VECTOR_MATH_H_
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/simd/vector_math_impl.h"
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+// compiled with -mavx2 -mfma, only called when the host supports them
+namespace mindspore {
+namespace kernel {
+#if defined(__AVX2__) && defined(__FMA__)
+namespace {
+struct AVX2Vector {
+  using Reg = __m256;
+  static constexpr size_t kWidth = 8;
+  static Reg Zero() { return _mm256_setzero_ps(); }
+  static Reg Set1(float value) { return _mm256_set1_ps(value); }
+  static Reg Load(const float *addr) { return _mm256_loadu_ps(addr); }
+  static void Store(float *addr, Reg value) { _mm256_storeu_ps(addr, value); }
+  static Reg Add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+  static Reg Max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+  static Reg Min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+  static Reg Fma(Reg a, Reg b, Reg c) { return _mm256_fmadd_ps(a, b, c); }
+  static Reg Sqrt(Reg a) { return _mm256_sqrt_ps(a); }
+  static Reg Floor(Reg a) { return _mm256_floor_ps(a); }
+  static Reg Pow2n(Reg n) {
+    __m256i exponent = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(exponent, 23));
+  }
+  static float ReduceAdd(Reg a) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+  }
+  static float ReduceMax(Reg a) {
+    __m128 result = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+    result = _mm_max_ps(result, _mm_movehl_ps(result, result));
+    result = _mm_max_ss(result, _mm_movehdup_ps(result));
+    return _mm_cvtss_f32(result);
+  }
+};
+}  // namespace
+
+const VectorMathTable *GetAVX2VectorMathTable() {
+  static const VectorMathTable table = VectorKernels<AVX2Vector>::Table();
+  return &table;
+}
+#else
+const VectorMathTable *GetAVX2VectorMathTable() { return nullptr; }
+#endif
+}  // namespace kernel
+}  // namespace mindspore
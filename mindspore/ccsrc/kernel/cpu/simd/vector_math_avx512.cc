@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/simd/vector_math_impl.h"
+#if defined(__AVX512F__)
+// the _mm512_undefined_* in the intrinsic headers of some gcc versions raise false uninitialized warnings
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#endif
+
+// compiled with -mavx512f, only called when the host supports it
+namespace mindspore {
+namespace kernel {
+#if defined(__AVX512F__)
+namespace {
+struct AVX512Vector {
+  using Reg = __m512;
+  static constexpr size_t kWidth = 16;
+  static Reg Zero() { return _mm512_setzero_ps(); }
+  static Reg Set1(float value) { return _mm512_set1_ps(value); }
+  static Reg Load(const float *addr) { return _mm512_loadu_ps(addr); }
+  static void Store(float *addr, Reg value) { _mm512_storeu_ps(addr, value); }
+  static Reg Add(Reg a, Reg b) { return _mm512_add_ps(a, b); }
+  static Reg Sub(Reg a, Reg b) { return _mm512_sub_ps(a, b); }
+  static Reg Mul(Reg a, Reg b) { return _mm512_mul_ps(a, b); }
+  static Reg Div(Reg a, Reg b) { return _mm512_div_ps(a, b); }
+  static Reg Max(Reg a, Reg b) { return _mm512_max_ps(a, b); }
+  static Reg Min(Reg a, Reg b) { return _mm512_min_ps(a, b); }
+  static Reg Fma(Reg a, Reg b, Reg c) { return _mm512_fmadd_ps(a, b, c); }
+  static Reg Sqrt(Reg a) { return _mm512_sqrt_ps(a); }
+  static Reg Floor(Reg a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+  static Reg Pow2n(Reg n) {
+    __m512i exponent = _mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(exponent, 23));
+  }
+  static float ReduceAdd(Reg a) { return _mm512_reduce_add_ps(a); }
+  static float ReduceMax(Reg a) { return _mm512_reduce_max_ps(a); }
+};
+}  // namespace
+
+const VectorMathTable *GetAVX512VectorMathTable() {
+  static const VectorMathTable table = VectorKernels<AVX512Vector>::Table();
+  return &table;
+}
+#else
+const VectorMathTable *GetAVX512VectorMathTable() { return nullptr; }
+#endif
+}  // namespace kernel
+}  // namespace mindspore
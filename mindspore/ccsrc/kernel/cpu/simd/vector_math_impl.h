@@ -0,0 +1,199 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_SIMD_VECTOR_MATH_IMPL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_SIMD_VECTOR_MATH_IMPL_H_
+
+#include <cstddef>
+#include "kernel/cpu/simd/vector_math.h"
+
+namespace mindspore {
+namespace kernel {
+struct VectorMathTable {
+  float (*sum)(const float *x, size_t n);
+  float (*max)(const float *x, size_t n);
+  float (*square_diff_sum)(const float *x, float mean, size_t n);
+  void (*add)(const float *a, const float *b, float *out, size_t n);
+  void (*maximum)(const float *a, const float *b, float *out, size_t n);
+  void (*scale_shift)(const float *x, float scale, float shift, float *y, size_t n);
+  void (*normalize)(const float *x, const float *gamma, const float *beta, float mean, float rstd, float *y,
+                    size_t n);
+  void (*gelu)(const float *x, float *y, size_t n);
+  void (*adam)(const AdamParam &param, const float *grad, float *var, float *m, float *v, size_t n);
+};
+
+const VectorMathTable *GetGenericVectorMathTable();
+// nullptr if the isa is not built in
+const VectorMathTable *GetAVX2VectorMathTable();
+const VectorMathTable *GetAVX512VectorMathTable();
+
+// the routines written once over the register type V of an isa, V provides kWidth, Reg, Zero, Set1, Load, Store,
+// Add, Sub, Mul, Div, Max, Min, Fma(a, b, c) = a * b + c, Sqrt, Floor, Pow2n (2^n of an integral n), ReduceAdd and
+// ReduceMax. the tails shorter than a register are left to the generic routines.
+// the isa source files are compiled with the isa flags, so V must be declared in an anonymous namespace there and
+// nothing but the intrinsics may be called here, an inline function emitted with the isa instructions could
+// otherwise be picked by the linker for the generic code.
+template <typename V>
+class VectorKernels {
+ public:
+  using Reg = typename V::Reg;
+
+  static float Sum(const float *x, size_t n) {
+    Reg acc0 = V::Zero();
+    Reg acc1 = V::Zero();
+    size_t i = 0;
+    for (; i + 2 * V::kWidth <= n; i += 2 * V::kWidth) {
+      acc0 = V::Add(acc0, V::Load(x + i));
+      acc1 = V::Add(acc1, V::Load(x + i + V::kWidth));
+    }
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      acc0 = V::Add(acc0, V::Load(x + i));
+    }
+    return V::ReduceAdd(V::Add(acc0, acc1)) + GetGenericVectorMathTable()->sum(x + i, n - i);
+  }
+
+  static float Max(const float *x, size_t n) {
+    if (n < V::kWidth) {
+      return GetGenericVectorMathTable()->max(x, n);
+    }
+    Reg acc = V::Load(x);
+    size_t i = V::kWidth;
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      acc = V::Max(acc, V::Load(x + i));
+    }
+    float result = V::ReduceMax(acc);
+    if (i < n) {
+      float tail = GetGenericVectorMathTable()->max(x + i, n - i);
+      result = result > tail ? result : tail;
+    }
+    return result;
+  }
+
+  static float SquareDiffSum(const float *x, float mean, size_t n) {
+    Reg mean_reg = V::Set1(mean);
+    Reg acc0 = V::Zero();
+    Reg acc1 = V::Zero();
+    size_t i = 0;
+    for (; i + 2 * V::kWidth <= n; i += 2 * V::kWidth) {
+      Reg diff0 = V::Sub(V::Load(x + i), mean_reg);
+      Reg diff1 = V::Sub(V::Load(x + i + V::kWidth), mean_reg);
+      acc0 = V::Fma(diff0, diff0, acc0);
+      acc1 = V::Fma(diff1, diff1, acc1);
+    }
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      Reg diff = V::Sub(V::Load(x + i), mean_reg);
+      acc0 = V::Fma(diff, diff, acc0);
+    }
+    return V::ReduceAdd(V::Add(acc0, acc1)) + GetGenericVectorMathTable()->square_diff_sum(x + i, mean, n - i);
+  }
+
+  static void Add(const float *a, const float *b, float *out, size_t n) {
+    size_t i = 0;
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      V::Store(out + i, V::Add(V::Load(a + i), V::Load(b + i)));
+    }
+    GetGenericVectorMathTable()->add(a + i, b + i, out + i, n - i);
+  }
+
+  static void Maximum(const float *a, const float *b, float *out, size_t n) {
+    size_t i = 0;
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      V::Store(out + i, V::Max(V::Load(a + i), V::Load(b + i)));
+    }
+    GetGenericVectorMathTable()->maximum(a + i, b + i, out + i, n - i);
+  }
+
+  static void ScaleShift(const float *x, float scale, float shift, float *y, size_t n) {
+    Reg scale_reg = V::Set1(scale);
+    Reg shift_reg = V::Set1(shift);
+    size_t i = 0;
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      V::Store(y + i, V::Fma(V::Load(x + i), scale_reg, shift_reg));
+    }
+    GetGenericVectorMathTable()->scale_shift(x + i, scale, shift, y + i, n - i);
+  }
+
+  static void Normalize(const float *x, const float *gamma, const float *beta, float mean, float rstd, float *y,
+                        size_t n) {
+    Reg mean_reg = V::Set1(mean);
+    Reg rstd_reg = V::Set1(rstd);
+    size_t i = 0;
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      Reg norm = V::Mul(V::Sub(V::Load(x + i), mean_reg), rstd_reg);
+      V::Store(y + i, V::Fma(norm, V::Load(gamma + i), V::Load(beta + i)));
+    }
+    GetGenericVectorMathTable()->normalize(x + i, gamma + i, beta + i, mean, rstd, y + i, n - i);
+  }
+
+  // 0.5 * (1 + tanh(u)) is sigmoid(2u), so gelu(x) = x / (1 + exp(-2u))
+  static void Gelu(const float *x, float *y, size_t n) {
+    Reg coef = V::Set1(-1.5957691216f);
+    Reg cube_coef = V::Set1(-1.5957691216f * 0.044715f);
+    Reg one = V::Set1(1.f);
+    size_t i = 0;
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      Reg value = V::Load(x + i);
+      Reg neg_2u = V::Mul(value, V::Fma(V::Mul(value, value), cube_coef, coef));
+      V::Store(y + i, V::Div(value, V::Add(one, Exp(neg_2u))));
+    }
+    GetGenericVectorMathTable()->gelu(x + i, y + i, n - i);
+  }
+
+  static void Adam(const AdamParam &param, const float *grad, float *var, float *m, float *v, size_t n) {
+    Reg lr = V::Set1(param.lr);
+    Reg beta1 = V::Set1(param.beta1);
+    Reg beta2 = V::Set1(param.beta2);
+    Reg one_sub_beta1 = V::Set1(1.f - param.beta1);
+    Reg one_sub_beta2 = V::Set1(1.f - param.beta2);
+    Reg epsilon = V::Set1(param.epsilon);
+    size_t i = 0;
+    for (; i + V::kWidth <= n; i += V::kWidth) {
+      Reg g = V::Load(grad + i);
+      Reg new_m = V::Fma(beta1, V::Load(m + i), V::Mul(one_sub_beta1, g));
+      Reg new_v = V::Fma(beta2, V::Load(v + i), V::Mul(one_sub_beta2, V::Mul(g, g)));
+      Reg update = param.use_nesterov ? V::Fma(new_m, beta1, V::Mul(one_sub_beta1, g)) : new_m;
+      update = V::Div(V::Mul(lr, update), V::Add(V::Sqrt(new_v), epsilon));
+      V::Store(m + i, new_m);
+      V::Store(v + i, new_v);
+      V::Store(var + i, V::Sub(V::Load(var + i), update));
+    }
+    GetGenericVectorMathTable()->adam(param, grad + i, var + i, m + i, v + i, n - i);
+  }
+
+  static VectorMathTable Table() {
+    return VectorMathTable{Sum, Max, SquareDiffSum, Add, Maximum, ScaleShift, Normalize, Gelu, Adam};
+  }
+
+ private:
+  // the cephes expf, x is clamped to keep 2^n a normal float
+  static Reg Exp(Reg x) {
+    x = V::Min(V::Max(x, V::Set1(-88.3762626647949f)), V::Set1(88.3762626647949f));
+    Reg n = V::Floor(V::Fma(x, V::Set1(1.44269504088896341f), V::Set1(0.5f)));
+    Reg r = V::Sub(x, V::Mul(n, V::Set1(0.693359375f)));
+    r = V::Sub(r, V::Mul(n, V::Set1(-2.12194440e-4f)));
+    Reg poly = V::Set1(1.9875691500e-4f);
+    poly = V::Fma(poly, r, V::Set1(1.3981999507e-3f));
+    poly = V::Fma(poly, r, V::Set1(8.3334519073e-3f));
+    poly = V::Fma(poly, r, V::Set1(4.1665795894e-2f));
+    poly = V::Fma(poly, r, V::Set1(1.6666665459e-1f));
+    poly = V::Fma(poly, r, V::Set1(5.0000001201e-1f));
+    poly = V::Fma(poly, V::Mul(r, r), V::Add(r, V::Set1(1.f)));
+    return V::Mul(poly, V::Pow2n(n));
+  }
+};
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_SIMD_VECTOR_MATH_IMPL_H_
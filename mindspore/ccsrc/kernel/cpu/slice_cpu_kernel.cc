@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/slice_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void SliceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  output_shape_ = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  auto begin = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, "begin");
+  if (input_shape.empty() || begin.size() != input_shape.size() || output_shape_.size() != input_shape.size()) {
+    MS_LOG(EXCEPTION) << "invalid slice of input rank " << input_shape.size() << ", begin rank " << begin.size();
+  }
+  begin_.clear();
+  input_strides_.assign(input_shape.size(), 1);
+  for (size_t i = input_shape.size() - 1; i > 0; --i) {
+    input_strides_[i - 1] = input_strides_[i] * input_shape[i];
+  }
+  // the output shape already resolves a size of -1, only begin is needed
+  for (size_t i = 0; i < input_shape.size(); ++i) {
+    int dim_begin = begin[i] < 0 ? begin[i] + SizeToInt(input_shape[i]) : begin[i];
+    if (dim_begin < 0 || IntToSize(dim_begin) + output_shape_[i] > input_shape[i]) {
+      MS_LOG(EXCEPTION) << "slice out of bounds in axis " << i << ", begin " << begin[i] << ", size "
+                        << output_shape_[i] << ", dim " << input_shape[i];
+    }
+    begin_.push_back(IntToSize(dim_begin));
+  }
+}
+
+bool SliceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                            const std::vector<kernel::AddressPtr> & /*workspace*/,
+                            const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  size_t rank = output_shape_.size();
+  size_t row_size = output_shape_[rank - 1];
+  size_t row_num = 1;
+  for (size_t i = 0; i + 1 < rank; ++i) {
+    row_num *= output_shape_[i];
+  }
+  if (outputs[0]->size != row_num * row_size * sizeof(float)) {
+    MS_LOG(EXCEPTION) << "output data size error!";
+  }
+  if (row_size == 0) {
+    return true;
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  size_t grain = ParallelGrain(row_size);
+  // the innermost dim is contiguous in both tensors, so the slice is a copy of output rows
+  CPUThreadPool::GetInstance().ParallelFor(row_num, grain, [&](size_t begin, size_t end) {
+    for (size_t row = begin; row < end; ++row) {
+      size_t offset = begin_[rank - 1];
+      size_t remain = row;
+      for (size_t i = rank - 1; i > 0; --i) {
+        offset += (begin_[i - 1] + remain % output_shape_[i - 1]) * input_strides_[i - 1];
+        remain /= output_shape_[i - 1];
+      }
+      size_t row_bytes = row_size * sizeof(float);
+      auto ret = memcpy_s(output + row * row_size, row_bytes, input + offset, row_bytes);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+      }
+    }
+  });
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,76 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/swap_cpu_kernel.h"
+#include "device/cpu/cpu_device_address.h"
+#include "securec/include/securec.h"
+#include "utils/utils.h"
+#include "utils/data_version.h"
+
+namespace mindspore {
+namespace kernel {
+SwapHostStore &SwapHostStore::GetInstance() {
+  static SwapHostStore instance;
+  return instance;
+}
+
+std::vector<uint8_t> *SwapHostStore::GetBuffer(int swap_id, size_t size) {
+  std::lock_guard<std::mutex> lock(lock_);
+  auto &buffer = buffers_[swap_id];
+  if (buffer.size() != size) {
+    buffer.resize(size);
+  }
+  return &buffer;
+}
+
+void SwapCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  swap_out_ = AnfAlgo::GetCNodeName(kernel_node) == kSwapOutOpName;
+  swap_id_ = AnfAlgo::GetNodeAttr<int>(kernel_node, kAttrSwapId);
+}
+
+bool SwapCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                           const std::vector<kernel::AddressPtr> & /*workspace*/,
+                           const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (swap_out_) {
+    auto buffer = SwapHostStore::GetInstance().GetBuffer(swap_id_, inputs[0]->size);
+    if (!buffer->empty()) {
+      auto ret = memcpy_s(buffer->data(), buffer->size(), inputs[0]->addr, inputs[0]->size);
+      if (ret != 0) {
+        MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+      }
+    }
+    auto ret = memset_s(outputs[0]->addr, outputs[0]->size, 0, outputs[0]->size);
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memset_s error, errorno" << ret;
+    }
+    DataVersion::GetInstance().Bump(outputs[0]->addr);
+    return true;
+  }
+  auto buffer = SwapHostStore::GetInstance().GetBuffer(swap_id_, outputs[0]->size);
+  if (!buffer->empty()) {
+    auto ret = memcpy_s(outputs[0]->addr, outputs[0]->size, buffer->data(), buffer->size());
+    if (ret != 0) {
+      MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+    }
+  }
+  DataVersion::GetInstance().Bump(outputs[0]->addr);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
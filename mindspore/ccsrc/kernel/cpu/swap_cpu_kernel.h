@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_KERNEL_CPU_SWAP_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_KERNEL_CPU_SWAP_CPU_KERNEL_H_
+#include <map>
+#include <mutex>
+#include <vector>
+#include "kernel/cpu/cpu_kernel.h"
+#include "kernel/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// The host buffers of the swapped tensors keyed by the swap ids, kept from one step to the next
+class SwapHostStore {
+ public:
+  SwapHostStore(const SwapHostStore &) = delete;
+  SwapHostStore &operator=(const SwapHostStore &) = delete;
+  static SwapHostStore &GetInstance();
+  // The buffer is resized to size bytes on the first call
+  std::vector<uint8_t> *GetBuffer(int swap_id, size_t size);
+
+ private:
+  SwapHostStore() = default;
+  ~SwapHostStore() = default;
+  std::mutex lock_;
+  std::map<int, std::vector<uint8_t>> buffers_;
+};
+
+// _SwapOut copies its input to the host buffer and writes a token, _SwapIn copies the buffer back to its output. The
+// runtime launches them on its copy stream.
+class SwapCPUKernel : public CPUKernel {
+ public:
+  SwapCPUKernel() = default;
+  ~SwapCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool swap_out_{true};
+  int swap_id_{0};
+};
+
+MS_REG_CPU_KERNEL(_SwapOut, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  SwapCPUKernel);
+MS_REG_CPU_KERNEL(_SwapIn, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  SwapCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_KERNEL_CPU_SWAP_CPU_KERNEL_H_
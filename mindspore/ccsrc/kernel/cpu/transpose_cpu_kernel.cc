@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "kernel/cpu/transpose_cpu_kernel.h"
+#include "kernel/cpu/cpu_thread_pool.h"
+#include "device/cpu/cpu_device_address.h"
+
+namespace mindspore {
+namespace kernel {
+void TransposeCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  auto perm = AnfAlgo::GetNodeAttr<std::vector<int>>(kernel_node, "perm");
+  if (input_shape.empty() || perm.size() != input_shape.size()) {
+    MS_LOG(EXCEPTION) << "invalid perm size " << perm.size() << " for input rank " << input_shape.size();
+  }
+  std::vector<size_t> input_strides(input_shape.size(), 1);
+  for (size_t i = input_shape.size() - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+  output_shape_.clear();
+  strides_.clear();
+  for (auto axis : perm) {
+    if (axis < 0) {
+      axis += SizeToInt(input_shape.size());
+    }
+    if (axis < 0 || IntToSize(axis) >= input_shape.size()) {
+      MS_LOG(EXCEPTION) << "invalid perm axis: " << axis;
+    }
+    output_shape_.push_back(input_shape[IntToSize(axis)]);
+    strides_.push_back(input_strides[IntToSize(axis)]);
+  }
+}
+
+bool TransposeCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                const std::vector<kernel::AddressPtr> & /*workspace*/,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "input or output empty!";
+  }
+  if (inputs[0]->size != outputs[0]->size) {
+    MS_LOG(EXCEPTION) << "input and output size not match!";
+  }
+  size_t rank = output_shape_.size();
+  size_t row_size = output_shape_[rank - 1];
+  size_t row_stride = strides_[rank - 1];
+  size_t row_num = outputs[0]->size / sizeof(float) / (row_size == 0 ? 1 : row_size);
+  if (row_size == 0 || row_num == 0) {
+    return true;
+  }
+  auto input = reinterpret_cast<float *>(inputs[0]->addr);
+  auto output = reinterpret_cast<float *>(outputs[0]->addr);
+  size_t grain = ParallelGrain(row_size);
+  // walk the output by rows, the row is a plain copy if the last axis stays in place
+  CPUThreadPool::GetInstance().ParallelFor(row_num, grain, [&](size_t begin, size_t end) {
+    for (size_t row = begin; row < end; ++row) {
+      size_t offset = 0;
+      size_t remain = row;
+      for (size_t i = rank - 1; i > 0; --i) {
+        offset += (remain % output_shape_[i - 1]) * strides_[i - 1];
+        remain /= output_shape_[i - 1];
+      }
+      float *dst = output + row * row_size;
+      const float *src = input + offset;
+      if (row_stride == 1) {
+        size_t row_bytes = row_size * sizeof(float);
+        auto ret = memcpy_s(dst, row_bytes, src, row_bytes);
+        if (ret != 0) {
+          MS_LOG(EXCEPTION) << "memcpy_s error, errorno" << ret;
+        }
+        continue;
+      }
+      for (size_t j = 0; j < row_size; ++j) {
+        dst[j] = src[j * row_stride];
+      }
+    }
+  });
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
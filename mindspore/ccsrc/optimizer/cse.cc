@@ -21,6 +21,7 @@
 #include <set>
 #include <unordered_map>
 #include "./common.h"
+#include "optimizer/recompute.h"
 
 namespace mindspore {
 /* namespace to support opt */
@@ -181,6 +182,10 @@ bool CSE::DoReplace(const FuncGraphManagerPtr manager, const std::vector<std::si
           if (main->func_graph() != node->func_graph()) {
             continue;
           }
+          // the copies of the recomputation compute the same values as the originals on purpose
+          if (IsRecomputeCopy(main) || IsRecomputeCopy(node)) {
+            continue;
+          }
           if (CheckReplace(node, main)) {
             changes = true;
             (void)manager->Replace(node, main);
@@ -0,0 +1,447 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "optimizer/recompute.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "ir/dtype/type.h"
+#include "operator/ops.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#include "pybind_api/export_flags.h"
+#include "utils/context/ms_context.h"
+#include "utils/graph_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+/* namespace to support opt */
+namespace opt {
+namespace {
+constexpr size_t kNoCopy = std::numeric_limits<size_t>::max();
+
+std::vector<std::vector<size_t>> NodeReaders(const std::vector<RecomputeNode> &nodes) {
+  std::vector<std::vector<size_t>> readers(nodes.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    for (auto input : nodes[i].inputs) {
+      if (input >= i) {
+        MS_LOG(EXCEPTION) << "The input " << input << " of the node " << i << " is not before it";
+      }
+      readers[input].push_back(i);
+    }
+  }
+  return readers;
+}
+
+// The position of the first and the last reader of the copy of each recomputed node, kNoCopy if it is not copied
+void CopyRange(const std::vector<RecomputeNode> &nodes, const std::vector<std::vector<size_t>> &readers,
+               const std::vector<bool> &recomputed, std::vector<size_t> *copy_begin, std::vector<size_t> *copy_end) {
+  size_t node_num = nodes.size();
+  copy_begin->assign(node_num, kNoCopy);
+  copy_end->assign(node_num, 0);
+  for (size_t i = node_num; i > 0; --i) {
+    size_t index = i - 1;
+    if (!recomputed[index]) {
+      continue;
+    }
+    for (auto reader : readers[index]) {
+      size_t position = kNoCopy;
+      if (!nodes[reader].forward) {
+        position = reader;
+      } else if (recomputed[reader]) {
+        position = (*copy_begin)[reader];
+      }
+      if (position == kNoCopy) {
+        continue;
+      }
+      (*copy_begin)[index] = std::min((*copy_begin)[index], position);
+      (*copy_end)[index] = std::max((*copy_end)[index], position);
+    }
+  }
+}
+
+double PeakMemory(const std::vector<RecomputeNode> &nodes, const std::vector<std::vector<size_t>> &readers,
+                  const std::vector<bool> &recomputed) {
+  size_t node_num = nodes.size();
+  std::vector<size_t> copy_begin;
+  std::vector<size_t> copy_end;
+  CopyRange(nodes, readers, recomputed, &copy_begin, &copy_end);
+
+  // the bytes allocated and freed at each position
+  std::vector<double> delta(node_num + 1, 0.0);
+  for (size_t i = 0; i < node_num; ++i) {
+    size_t last = i;
+    for (auto reader : readers[i]) {
+      if (!nodes[reader].forward) {
+        // a recomputed node leaves its backward readers to its copy
+        if (!recomputed[i]) {
+          last = std::max(last, reader);
+        }
+        continue;
+      }
+      last = std::max(last, reader);
+      // the copy of a recomputed reader reads the copy of the node if it is recomputed as well, otherwise the node
+      if (recomputed[reader] && copy_begin[reader] != kNoCopy && !recomputed[i]) {
+        last = std::max(last, copy_begin[reader]);
+      }
+    }
+    delta[i] += nodes[i].bytes;
+    delta[last + 1] -= nodes[i].bytes;
+    if (recomputed[i] && copy_begin[i] != kNoCopy) {
+      delta[copy_begin[i]] += nodes[i].bytes;
+      delta[copy_end[i] + 1] -= nodes[i].bytes;
+    }
+  }
+
+  double memory = 0.0;
+  double peak = 0.0;
+  for (size_t i = 0; i < node_num; ++i) {
+    memory += delta[i];
+    peak = std::max(peak, memory);
+  }
+  return peak;
+}
+
+// The bytes of the tensors of an output
+double AbstractBytes(const AbstractBasePtr &abstract) {
+  if (abstract == nullptr) {
+    return 0.0;
+  }
+  if (abstract->isa<abstract::AbstractTuple>()) {
+    double bytes = 0.0;
+    for (auto &element : abstract->cast<abstract::AbstractTuplePtr>()->elements()) {
+      bytes += AbstractBytes(element);
+    }
+    return bytes;
+  }
+  auto tensor = abstract->cast<abstract::AbstractTensorPtr>();
+  if (tensor == nullptr || tensor->shape() == nullptr) {
+    return 0.0;
+  }
+  double bytes = static_cast<double>(GetTypeByte(tensor->element()->BuildType()));
+  for (auto dim : tensor->shape()->shape()) {
+    bytes *= std::max(dim, 1);
+  }
+  return bytes;
+}
+
+std::vector<int> AbstractShape(const AnfNodePtr &node) {
+  auto tensor = node->abstract() == nullptr ? nullptr : node->abstract()->cast<abstract::AbstractTensorPtr>();
+  if (tensor == nullptr || tensor->shape() == nullptr) {
+    return {};
+  }
+  return tensor->shape()->shape();
+}
+
+double ShapeElements(const std::vector<int> &shape) {
+  double elements = 1.0;
+  for (auto dim : shape) {
+    elements *= std::max(dim, 1);
+  }
+  return elements;
+}
+
+bool PrimitiveFlag(const PrimitivePtr &prim, const std::string &name) {
+  auto value = prim->GetAttr(name);
+  return value != nullptr && value->isa<BoolImm>() && GetValue<bool>(value);
+}
+
+// The floating point operations of a node: a multiply and an add per reduced element for the matrix multiplications
+// and the convolutions, an operation per element for the others
+double NodeFlops(const CNodePtr &cnode) {
+  auto prim = GetCNodePrimitive(cnode);
+  MS_EXCEPTION_IF_NULL(prim);
+  double output_elements = ShapeElements(AbstractShape(cnode));
+  const size_t kWeightIndex = 2;
+  bool is_matmul = prim->name() == prim::kPrimMatMul->name() || prim->name() == prim::kPrimBatchMatMul->name();
+  if (is_matmul && cnode->size() > kWeightIndex) {
+    auto shape = AbstractShape(cnode->input(1));
+    if (shape.size() >= 2) {
+      size_t reduced = PrimitiveFlag(prim, "transpose_a") ? shape.size() - 2 : shape.size() - 1;
+      return 2.0 * output_elements * std::max(shape[reduced], 1);
+    }
+  }
+  if (prim->name() == prim::kPrimConv2D->name() && cnode->size() > kWeightIndex) {
+    auto shape = AbstractShape(cnode->input(kWeightIndex));
+    if (!shape.empty() && shape[0] > 0) {
+      return 2.0 * output_elements * ShapeElements(shape) / shape[0];
+    }
+  }
+  double elements = output_elements;
+  for (size_t i = 1; i < cnode->size(); ++i) {
+    elements = std::max(elements, ShapeElements(AbstractShape(cnode->input(i))));
+  }
+  return elements;
+}
+
+bool InGradients(const AnfNodePtr &node) {
+  static const std::string gradients_scope = "Gradients/";
+  auto scope = node->scope();
+  return scope != nullptr && scope->name().compare(0, gradients_scope.size(), gradients_scope) == 0;
+}
+
+// The node whose output a tuple_getitem or a depend passes on
+AnfNodePtr RealOutput(const AnfNodePtr &node) {
+  auto current = node;
+  while (IsPrimitiveCNode(current, prim::kPrimTupleGetItem) || IsPrimitiveCNode(current, prim::kPrimDepend)) {
+    current = current->cast<CNodePtr>()->input(1);
+  }
+  return current;
+}
+
+// A node can be recomputed when it computes a tensor without effects, randomness or communication, and is not a copy
+bool CanRecompute(const FuncGraphPtr &root, const CNodePtr &cnode) {
+  auto prim = GetCNodePrimitive(cnode);
+  if (prim == nullptr || PrimitiveFlag(prim, kAttrRecomputeCopy)) {
+    return false;
+  }
+  if (IsPrimitiveCNode(cnode, prim::kPrimTupleGetItem) || IsPrimitiveCNode(cnode, prim::kPrimDepend) ||
+      IsPrimitiveCNode(cnode, prim::kPrimControlDepend)) {
+    return false;
+  }
+  if (cnode->abstract() == nullptr || !cnode->abstract()->isa<abstract::AbstractTensor>()) {
+    return false;
+  }
+  if (root->HasEffect(cnode) || PrimitiveFlag(prim, GRAPH_FLAG_RANDOM_EFFECT) || prim->GetAttr("group") != nullptr) {
+    return false;
+  }
+  auto &inputs = cnode->inputs();
+  return std::any_of(inputs.begin() + 1, inputs.end(),
+                     [](const AnfNodePtr &input) { return !input->isa<ValueNode>(); });
+}
+
+// The primitive of a copy is a clone of the one of the node, flagged so that the copy differs from the node
+PrimitivePtr CopyPrimitive(const PrimitivePtr &prim) {
+  MS_EXCEPTION_IF_NULL(prim);
+  PrimitivePtr copy = prim->isa<PrimitivePy>() ? std::make_shared<PrimitivePy>(*prim->cast<PrimitivePyPtr>())
+                                                : std::make_shared<Primitive>(*prim);
+  copy->set_attr(kAttrRecomputeCopy, MakeValue(true));
+  return copy;
+}
+
+// The gradient a backward node receives, the copies it reads are made after it
+AnfNodePtr BackwardInput(const CNodePtr &cnode, const std::unordered_map<AnfNodePtr, size_t> &index,
+                         const std::vector<RecomputeNode> &nodes) {
+  for (size_t i = 1; i < cnode->size(); ++i) {
+    auto iter = index.find(RealOutput(cnode->input(i)));
+    if (iter != index.end() && !nodes[iter->second].forward) {
+      return cnode->input(i);
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+double RecomputePeakMemory(const std::vector<RecomputeNode> &nodes, const std::vector<bool> &recomputed) {
+  if (recomputed.size() != nodes.size()) {
+    MS_LOG(EXCEPTION) << "The recomputed flags " << recomputed.size() << " do not match the nodes " << nodes.size();
+  }
+  return PeakMemory(nodes, NodeReaders(nodes), recomputed);
+}
+
+bool ChooseRecompute(const std::vector<RecomputeNode> &nodes, double memory_budget, RecomputePlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  size_t node_num = nodes.size();
+  auto readers = NodeReaders(nodes);
+  std::vector<bool> recomputed(node_num, false);
+  for (size_t i = 0; i < node_num; ++i) {
+    recomputed[i] = nodes[i].candidate && nodes[i].forward && nodes[i].marked;
+  }
+  plan->origin_peak_memory = PeakMemory(nodes, readers, std::vector<bool>(node_num, false));
+  plan->peak_memory = PeakMemory(nodes, readers, recomputed);
+
+  if (memory_budget > 0) {
+    std::vector<size_t> order;
+    for (size_t i = 0; i < node_num; ++i) {
+      if (!nodes[i].candidate || !nodes[i].forward || recomputed[i]) {
+        continue;
+      }
+      auto is_backward = [&nodes](size_t reader) { return !nodes[reader].forward; };
+      if (std::any_of(readers[i].begin(), readers[i].end(), is_backward)) {
+        order.push_back(i);
+      }
+    }
+    // the bytes kept per floating point operation, the larger first
+    std::stable_sort(order.begin(), order.end(), [&nodes](size_t a, size_t b) {
+      return nodes[a].bytes * std::max(nodes[b].flops, 1.0) > nodes[b].bytes * std::max(nodes[a].flops, 1.0);
+    });
+    for (auto index : order) {
+      if (plan->peak_memory <= memory_budget) {
+        break;
+      }
+      recomputed[index] = true;
+      double peak_memory = PeakMemory(nodes, readers, recomputed);
+      if (peak_memory < plan->peak_memory) {
+        plan->peak_memory = peak_memory;
+      } else {
+        recomputed[index] = false;
+      }
+    }
+  }
+
+  // the nodes without a copy change nothing
+  std::vector<size_t> copy_begin;
+  std::vector<size_t> copy_end;
+  CopyRange(nodes, readers, recomputed, &copy_begin, &copy_end);
+  plan->recomputed.clear();
+  plan->recompute_flops = 0.0;
+  plan->total_flops = 0.0;
+  for (size_t i = 0; i < node_num; ++i) {
+    plan->total_flops += nodes[i].flops;
+    if (recomputed[i] && copy_begin[i] != kNoCopy) {
+      plan->recomputed.push_back(i);
+      plan->recompute_flops += nodes[i].flops;
+    }
+  }
+  return memory_budget <= 0 || plan->peak_memory <= memory_budget;
+}
+
+bool IsRecomputeCopy(const AnfNodePtr &node) {
+  auto prim = GetCNodePrimitive(node);
+  return prim != nullptr && PrimitiveFlag(prim, kAttrRecomputeCopy);
+}
+
+bool Recompute(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager) {
+  MS_EXCEPTION_IF_NULL(root);
+  MS_EXCEPTION_IF_NULL(manager);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  double memory_budget = context->recompute_memory_max_size();
+
+  std::vector<CNodePtr> cnodes;
+  std::unordered_map<AnfNodePtr, size_t> index;
+  std::vector<RecomputeNode> nodes;
+  bool has_marked = false;
+  for (auto &node : TopoSort(root->get_return())) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode == nullptr || cnode->func_graph() != root) {
+      continue;
+    }
+    RecomputeNode recompute_node{0.0, 0.0, !InGradients(cnode), false, false, {}};
+    for (size_t i = 1; i < cnode->size(); ++i) {
+      auto iter = index.find(cnode->input(i));
+      if (iter != index.end() && !nodes[iter->second].forward) {
+        recompute_node.forward = false;
+      }
+      auto real_iter = index.find(RealOutput(cnode->input(i)));
+      if (real_iter != index.end()) {
+        recompute_node.inputs.push_back(real_iter->second);
+      }
+    }
+    bool is_alias = IsPrimitiveCNode(cnode, prim::kPrimTupleGetItem) || IsPrimitiveCNode(cnode, prim::kPrimDepend);
+    recompute_node.bytes = is_alias ? 0.0 : AbstractBytes(cnode->abstract());
+    auto prim = GetCNodePrimitive(cnode);
+    if (prim != nullptr && !is_alias) {
+      recompute_node.flops = NodeFlops(cnode);
+      recompute_node.marked = PrimitiveFlag(prim, kAttrRecompute);
+      recompute_node.candidate = recompute_node.forward && CanRecompute(root, cnode);
+      if (recompute_node.forward && recompute_node.marked && !recompute_node.candidate) {
+        MS_LOG(WARNING) << "The node " << cnode->DebugString() << " is marked to recompute but can not be recomputed";
+      }
+      has_marked = has_marked || (recompute_node.candidate && recompute_node.marked);
+    }
+    index[cnode] = nodes.size();
+    nodes.push_back(recompute_node);
+    cnodes.push_back(cnode);
+  }
+  if (!has_marked && memory_budget <= 0) {
+    return false;
+  }
+
+  RecomputePlan plan;
+  if (!ChooseRecompute(nodes, memory_budget, &plan)) {
+    MS_LOG(WARNING) << "The activations take " << plan.peak_memory << " bytes at the peak even with the recomputation, "
+                    << "over the budget " << memory_budget;
+  }
+  if (plan.recomputed.empty()) {
+    return false;
+  }
+
+  // the readers of the recomputed nodes, taken before the copies are added
+  std::vector<bool> recomputed(nodes.size(), false);
+  for (auto i : plan.recomputed) {
+    recomputed[i] = true;
+  }
+  auto &node_users = manager->node_users();
+  std::unordered_map<size_t, std::vector<std::pair<AnfNodePtr, int>>> backward_users;
+  for (auto i : plan.recomputed) {
+    for (auto &user : node_users[cnodes[i]]) {
+      auto iter = index.find(user.first);
+      if (iter != index.end() && !nodes[iter->second].forward) {
+        backward_users[i].push_back(user);
+      }
+    }
+  }
+
+  // each copy is made after the gradient its first reader receives, that of a backward reader or of the first reader
+  // of a recomputed reader
+  std::unordered_map<size_t, std::pair<size_t, AnfNodePtr>> triggers;
+  for (auto iter = plan.recomputed.rbegin(); iter != plan.recomputed.rend(); ++iter) {
+    std::pair<size_t, AnfNodePtr> trigger{kNoCopy, nullptr};
+    for (auto &user : backward_users[*iter]) {
+      size_t position = index[user.first];
+      if (position < trigger.first) {
+        trigger = {position, BackwardInput(user.first->cast<CNodePtr>(), index, nodes)};
+      }
+    }
+    for (auto &user : node_users[cnodes[*iter]]) {
+      auto user_iter = index.find(user.first);
+      if (user_iter == index.end() || !recomputed[user_iter->second]) {
+        continue;
+      }
+      auto &reader_trigger = triggers[user_iter->second];
+      if (reader_trigger.first < trigger.first) {
+        trigger = reader_trigger;
+      }
+    }
+    triggers[*iter] = trigger;
+  }
+
+  std::unordered_map<AnfNodePtr, AnfNodePtr> copies;
+  for (auto i : plan.recomputed) {
+    auto &cnode = cnodes[i];
+    std::vector<AnfNodePtr> inputs{NewValueNode(CopyPrimitive(GetCNodePrimitive(cnode)))};
+    for (size_t k = 1; k < cnode->size(); ++k) {
+      auto iter = copies.find(cnode->input(k));
+      inputs.push_back(iter == copies.end() ? cnode->input(k) : iter->second);
+    }
+    auto trigger = triggers[i].second;
+    if (trigger != nullptr) {
+      auto first = std::find_if(inputs.begin() + 1, inputs.end(),
+                                [](const AnfNodePtr &input) { return !input->isa<ValueNode>(); });
+      auto depend = root->NewCNodeWithScope({NewValueNode(prim::kPrimDepend), *first, trigger}, cnode->scope());
+      depend->set_abstract((*first)->abstract());
+      *first = depend;
+    }
+    auto copy_node = root->NewCNodeWithScope(inputs, cnode->scope());
+    copy_node->set_abstract(cnode->abstract());
+    copies[cnode] = copy_node;
+    for (auto &user : backward_users[i]) {
+      manager->SetEdge(user.first, user.second, copy_node);
+    }
+  }
+
+  MS_LOG(INFO) << "Recompute " << plan.recomputed.size() << " nodes for the backward: the peak memory of the "
+               << "activations goes from " << plan.origin_peak_memory << " to " << plan.peak_memory << " bytes for "
+               << plan.recompute_flops << " more floating point operations, over the " << plan.total_flops
+               << " of the graph";
+  return true;
+}
+}  // namespace opt
+}  // namespace mindspore
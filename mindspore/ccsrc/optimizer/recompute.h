@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_OPTIMIZER_RECOMPUTE_H_
+#define MINDSPORE_CCSRC_OPTIMIZER_RECOMPUTE_H_
+
+#include <cstddef>
+#include <vector>
+#include "ir/anf.h"
+#include "ir/manager.h"
+
+namespace mindspore {
+/* namespace to support opt */
+namespace opt {
+// The primitive attribute set by Primitive.recompute() to mark the nodes to recompute
+constexpr char kAttrRecompute[] = "recompute";
+// The primitive attribute of the copies made for the backward, CSE must not merge them back into the originals
+constexpr char kAttrRecomputeCopy[] = "recompute_copy";
+
+// A node of the graph in topological order, as seen by the recompute planner
+struct RecomputeNode {
+  // the bytes of the output
+  double bytes;
+  // the floating point operations of the node, paid again when it is recomputed
+  double flops;
+  // whether the node computes the forward, only the forward outputs read by the backward stay alive across it
+  bool forward;
+  // whether the node can be recomputed
+  bool candidate;
+  // whether the user marked the node to be recomputed
+  bool marked;
+  // the indexes of the nodes whose outputs the node reads, all smaller than its own
+  std::vector<size_t> inputs;
+};
+
+struct RecomputePlan {
+  // the indexes of the nodes recomputed for the backward, sorted
+  std::vector<size_t> recomputed;
+  // the peak bytes of the outputs alive without and with the recomputation
+  double origin_peak_memory;
+  double peak_memory;
+  // the floating point operations recomputed, and those of the whole graph
+  double recompute_flops;
+  double total_flops;
+};
+
+// The peak bytes of the outputs alive when the nodes flagged in recomputed are recomputed. An output is alive from its
+// node to its last reader, as the memory reuse counts it. A recomputed node keeps its output for the forward readers
+// only, and is copied right before its first backward reader. The copy reads the copies of its recomputed inputs and
+// the original outputs of the others, which stay alive until then.
+double RecomputePeakMemory(const std::vector<RecomputeNode> &nodes, const std::vector<bool> &recomputed);
+
+// Recompute the marked candidates. With a positive memory_budget, the candidates read by the backward are added in the
+// order of the bytes they keep per floating point operation, the larger first, as long as they lower the peak, until
+// the peak fits the budget. Return false if it does not fit even then.
+bool ChooseRecompute(const std::vector<RecomputeNode> &nodes, double memory_budget, RecomputePlan *plan);
+
+// Trade the compute of the backward for the memory of the activations: the forward nodes chosen by ChooseRecompute
+// are duplicated for their backward readers, with the memory budget of the context. The graph must be flattened by
+// the inlining of the grads. Return whether the graph is changed.
+bool Recompute(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager);
+
+// Whether the node is a copy made by Recompute
+bool IsRecomputeCopy(const AnfNodePtr &node);
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_OPTIMIZER_RECOMPUTE_H_
@@ -15,15 +15,24 @@
  */
 
 #include "parallel/allreduce_fusion/allreduce_fusion.h"
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <string>
 #include <unordered_set>
 #include "ir/func_graph.h"
+#include "parallel/allreduce_fusion/gradient_bucket.h"
+#include "parallel/allreduce_fusion/gradient_compression.h"
+#include "parallel/context.h"
 #include "parallel/costmodel_context.h"
 #include "parallel/graph_util/node_info.h"
+#include "parallel/ops_info/ops_utils.h"
 #include "parallel/status.h"
 #include "parallel/step_parallel.h"
+#include "parallel/tensor_layout/tensor_layout.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#include "utils/convert_utils.h"
+#include "utils/graph_utils.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -379,6 +388,239 @@ Status AllreduceFusion::SetFusionByBackwardCompAndAllreduceTime() {
   return SUCCESS;
 }
 
+// The shape of the gradient slice of the parameter on this device
+Shape GradientShape(const AnfNodePtr &para) {
+  auto para_ptr = para->cast<ParameterPtr>();
+  MS_EXCEPTION_IF_NULL(para_ptr);
+  if (para_ptr->tensor_layout() != nullptr) {
+    return para_ptr->tensor_layout()->slice_shape().array();
+  }
+  auto shapes = GetNodeShape(para);
+  return shapes.empty() ? Shape() : shapes[0];
+}
+
+// The bytes of an element of the gradient of the parameter, 0 if it is not a tensor
+size_t GradientElementBytes(const AnfNodePtr &para) {
+  MS_EXCEPTION_IF_NULL(para);
+  auto tensor_abstract = para->abstract() == nullptr ? nullptr : para->abstract()->cast<abstract::AbstractTensorPtr>();
+  if (tensor_abstract == nullptr) {
+    return 0;
+  }
+  return GetTypeByte(tensor_abstract->element()->BuildType());
+}
+
+// The bytes of the gradient slice of the parameter on this device
+double GradientBytes(const AnfNodePtr &para) {
+  double bytes = static_cast<double>(GradientElementBytes(para));
+  if (bytes == 0) {
+    return 0.0;
+  }
+  for (auto dim : GradientShape(para)) {
+    bytes *= dim;
+  }
+  return bytes;
+}
+
+// The AllReduce time of the measured profile on the group size if there is one, otherwise of the inherent time and
+// the bandwidth. The group size 0 is all the devices, which the gradients of the data parallel are reduced among.
+Status GetAllreduceTimeFunc(AllreduceTimeFunc *allreduce_time, size_t group_size) {
+  MS_EXCEPTION_IF_NULL(allreduce_time);
+  auto context = CostModelContext::GetInstance();
+  auto cost_profile = context->costmodel_profile();
+  if (cost_profile != nullptr) {
+    if (group_size == 0) {
+      group_size = IntToSize(std::max(ParallelContext::GetInstance()->device_num(), 0));
+    }
+    *allreduce_time = [cost_profile, group_size](double bytes) {
+      return cost_profile->CommunicationTime(ALLREDUCE_COMMUNICATION_CURVE, bytes, group_size);
+    };
+    return SUCCESS;
+  }
+  double inherent_time = context->costmodel_allreduce_fusion_allreduce_inherent_time();
+  double bandwidth = context->costmodel_allreduce_fusion_allreduce_bandwidth();
+  if (inherent_time < 0 || bandwidth <= 0) {
+    MS_LOG(ERROR) << "'costmodel_allreduce_fusion_allreduce_inherent_time' is " << inherent_time
+                  << ", 'costmodel_allreduce_fusion_allreduce_bandwidth' is " << bandwidth;
+    return FAILED;
+  }
+  *allreduce_time = [inherent_time, bandwidth](double bytes) { return inherent_time + bytes / bandwidth; };
+  return SUCCESS;
+}
+
+Status AllreduceFusion::SetGradientCompression() {
+  auto context = CostModelContext::GetInstance();
+  GradientCompressionConfig config;
+  if (!GetGradientCompression(context->costmodel_gradient_compression(), &config.method)) {
+    MS_LOG(ERROR) << "The gradient compression " << context->costmodel_gradient_compression() << " is unknown";
+    return FAILED;
+  }
+  if (config.method == kCompressionNone) {
+    return SUCCESS;
+  }
+  config.topk_ratio = context->costmodel_gradient_compression_topk_ratio();
+  config.powersgd_rank = context->costmodel_gradient_compression_powersgd_rank();
+  config.element_time = context->costmodel_gradient_compression_element_time();
+
+  size_t gradients = 0;
+  for (auto &parameter : root_graph_->parameters()) {
+    if (!ParameterRequireGrad(parameter)) {
+      continue;
+    }
+    auto shape = GradientShape(parameter);
+    auto element_bytes = GradientElementBytes(parameter);
+    for (auto &mirror_cnode : FindMirror(parameter)) {
+      MS_EXCEPTION_IF_NULL(mirror_cnode);
+      auto node_prim = GetValueNode<PrimitivePtr>(mirror_cnode->input(0));
+      MS_EXCEPTION_IF_NULL(node_prim);
+      auto dev_num_ptr = node_prim->GetAttr(DEV_NUM);
+      int32_t dev_num = (dev_num_ptr != nullptr && dev_num_ptr->isa<Int32Imm>()) ? GetValue<int>(dev_num_ptr) : 0;
+      // the gradient is reduced among the devices of the mirror
+      AllreduceTimeFunc allreduce_time;
+      if (GetAllreduceTimeFunc(&allreduce_time, IntToSize(std::max(dev_num, 0))) != SUCCESS) {
+        MS_LOG(ERROR) << "GetAllreduceTimeFunc failed";
+        return FAILED;
+      }
+      auto method = ChooseGradientCompression(config, shape, element_bytes, dev_num, allreduce_time);
+      if (method == kCompressionNone) {
+        continue;
+      }
+      MS_LOG(DEBUG) << "Compress the gradient of " << ParameterName(parameter) << " by "
+                    << GradientCompressionName(method);
+      (void)node_prim->AddAttr(PARAMETER, MakeValue(ParameterName(parameter)));
+      // a shared parameter has a mirror for every use, each of which compresses its own gradient
+      (void)node_prim->AddAttr(COMPRESSION_KEY, MakeValue(ParameterName(parameter) + "_" + mirror_cnode->UniqueId()));
+      (void)node_prim->AddAttr(COMPRESSION, MakeValue(GradientCompressionName(method)));
+      (void)node_prim->AddAttr(COMPRESSION_TOPK_RATIO, MakeValue(config.topk_ratio));
+      (void)node_prim->AddAttr(COMPRESSION_POWERSGD_RANK, MakeValue(config.powersgd_rank));
+      para_compression_[parameter] = method;
+      ++gradients;
+    }
+  }
+  MS_LOG(INFO) << "Gradient compression " << GradientCompressionName(config.method) << " is applied to " << gradients
+               << " gradients, the others are cheaper to reduce uncompressed";
+  return SUCCESS;
+}
+
+Status AllreduceFusion::SetFusionByBackwardProfile(const FuncGraphPtr &forward_graph) {
+  MS_EXCEPTION_IF_NULL(forward_graph);
+  auto context = CostModelContext::GetInstance();
+  auto profile_file = context->costmodel_allreduce_fusion_backward_profile_file();
+  if (profile_file.empty()) {
+    MS_LOG(ERROR) << "'costmodel_allreduce_fusion_backward_profile_file' is not set for the fusion algorithm 3";
+    return FAILED;
+  }
+  std::unordered_map<std::string, double> profile;
+  if (LoadBackwardTimeProfile(profile_file, &profile) != SUCCESS) {
+    MS_LOG(ERROR) << "LoadBackwardTimeProfile failed";
+    return FAILED;
+  }
+  AllreduceTimeFunc allreduce_time;
+  if (GetAllreduceTimeFunc(&allreduce_time) != SUCCESS) {
+    MS_LOG(ERROR) << "GetAllreduceTimeFunc failed";
+    return FAILED;
+  }
+
+  // the operators in the order of the backward, which is the reverse of the forward
+  std::vector<CNodePtr> ops;
+  for (auto &node : TopoSort(forward_graph->get_return())) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode != nullptr && IsValueNode<Primitive>(cnode->input(0)) && IsParallelCareNode(cnode) &&
+        cnode->operator_info() != nullptr) {
+      ops.push_back(cnode);
+    }
+  }
+  std::reverse(ops.begin(), ops.end());
+  std::unordered_map<CNodePtr, size_t> op_index;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    op_index[ops[i]] = i;
+  }
+  // the gradient of a parameter is ready after the backward of its last user in the backward
+  std::vector<std::vector<AnfNodePtr>> op_paras(ops.size());
+  for (auto &parameter : root_graph_->parameters()) {
+    if (!ParameterRequireGrad(parameter)) {
+      continue;
+    }
+    size_t last = 0;
+    bool used = false;
+    for (auto &cnode : FindCNodesWithPara(parameter)) {
+      auto iter = op_index.find(cnode);
+      if (iter != op_index.end()) {
+        last = used ? std::max(last, iter->second) : iter->second;
+        used = true;
+      }
+    }
+    if (used) {
+      op_paras[last].push_back(parameter);
+    }
+  }
+
+  // the operators not in the profile take the time per cost of the ones in it
+  std::vector<double> times(ops.size(), -1.0);
+  std::vector<double> costs(ops.size(), 0.0);
+  double profiled_time = 0.0;
+  double profiled_cost = 0.0;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    costs[i] = ops[i]->operator_info()->GetForwardMemoryCostFromCNode();
+    auto iter = profile.find(ops[i]->fullname_with_scope());
+    if (iter == profile.end()) {
+      iter = profile.find(ops[i]->operator_info()->name());
+    }
+    if (iter != profile.end()) {
+      times[i] = iter->second;
+      profiled_time += iter->second;
+      profiled_cost += costs[i];
+    }
+  }
+  double time_per_cost = context->costmodel_allreduce_fusion_computation_time_parameter();
+  if (profiled_cost > 0) {
+    time_per_cost = profiled_time / profiled_cost;
+  } else {
+    MS_LOG(WARNING) << "None of the " << ops.size() << " operators is in the backward profile " << profile_file
+                    << ", their time is estimated by 'costmodel_allreduce_fusion_computation_time_parameter'";
+  }
+  std::vector<BackwardOp> backward_ops;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    double time = (times[i] >= 0) ? times[i] : costs[i] * time_per_cost;
+    double bytes = 0.0;
+    for (auto &para : op_paras[i]) {
+      // the compressed gradients add less or nothing to their buckets
+      auto iter = para_compression_.find(para);
+      auto method = (iter == para_compression_.end()) ? kCompressionNone : iter->second;
+      bytes += FusedGradientBytes(method, GradientBytes(para));
+    }
+    backward_ops.push_back({ops[i]->fullname_with_scope(), time, bytes});
+  }
+
+  BucketPlan plan;
+  double bucket_bytes = context->costmodel_allreduce_fusion_bucket_bytes();
+  if (PlanGradientBuckets(backward_ops, bucket_bytes, allreduce_time, &plan) != SUCCESS) {
+    MS_LOG(ERROR) << "PlanGradientBuckets failed";
+    return FAILED;
+  }
+  // the fusion 1 is the last bucket of the backward, as the other algorithms do
+  int32_t fusion = SizeToInt(plan.buckets.size());
+  for (auto &bucket : plan.buckets) {
+    std::vector<AnfNodePtr> paras;
+    for (size_t i = bucket.first_op; i <= bucket.last_op; ++i) {
+      (void)paras.insert(paras.end(), op_paras[i].begin(), op_paras[i].end());
+    }
+    if (FindMirrorAndSetFusion(paras, fusion) != SUCCESS) {
+      MS_LOG(ERROR) << "FindMirrorAndSetFusion failed";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "AllReduce fusion " << fusion << ": " << paras.size() << " gradients of " << bucket.bytes
+                 << " bytes from " << backward_ops[bucket.first_op].name << " to "
+                 << backward_ops[bucket.last_op].name << ", ready at " << bucket.ready_time << ", reduced from "
+                 << bucket.start_time << " to " << bucket.end_time;
+    fusion--;
+  }
+  MS_LOG(INFO) << "AllReduce fusion report: " << plan.buckets.size() << " buckets of target " << bucket_bytes
+               << " bytes, backward time " << plan.backward_time << ", allreduce time " << plan.allreduce_time
+               << ", exposed allreduce time " << plan.exposed_time << ", predicted overlap ratio "
+               << plan.overlap_ratio;
+  return SUCCESS;
+}
+
 Status AllreduceFusion::SetFusionByAlgorithm(int32_t algorithm) {
   if (algorithm == 1) {
     return SetFusionByBackwardCompTime();
@@ -391,14 +633,18 @@ Status AllreduceFusion::ProcessAllreduceFusion(const CNodePtr &ret) {
     MS_LOG(ERROR) << "ret is nullptr.";
     return FAILED;
   }
+  ret_ = ret;
+  root_graph_ = ret_->func_graph();
+  MS_EXCEPTION_IF_NULL(root_graph_);
+  if (SetGradientCompression() != SUCCESS) {
+    MS_LOG(ERROR) << "SetGradientCompression failed.";
+    return FAILED;
+  }
   auto algorithm = CostModelContext::GetInstance()->costmodel_allreduce_fusion_algorithm();
-  if (algorithm < 1 || algorithm > 2) {
+  if (algorithm < 1 || algorithm > 3) {
     MS_LOG(INFO) << "'costmodel_allreduce_fusion_algorithm' is " << algorithm << ". Bypass ProcessAllreduceFusion";
     return SUCCESS;
   }
-  ret_ = ret;
-  root_graph_ = ret_->func_graph();
-  MS_EXCEPTION_IF_NULL(root_graph_);
   auto graph_set = ForwardGraph(root_graph_);
   if (graph_set.size() > 1) {
     MS_LOG(WARNING) << "AllReduce fusion don't support multiple subgraphs now.";
@@ -408,6 +654,9 @@ Status AllreduceFusion::ProcessAllreduceFusion(const CNodePtr &ret) {
   MS_EXCEPTION_IF_NULL(forward_graph);
   forward_ret_ = forward_graph->get_return();
   MS_EXCEPTION_IF_NULL(forward_ret_);
+  if (algorithm == 3) {
+    return SetFusionByBackwardProfile(forward_graph);
+  }
 
   if (allreduce_graph_.set_head_cnode(forward_ret_) != SUCCESS) {
     MS_LOG(ERROR) << "AllreduceGraph set_head_cnode failed.";
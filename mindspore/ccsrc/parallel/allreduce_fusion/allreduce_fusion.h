@@ -21,6 +21,7 @@
 #include <vector>
 #include "ir/anf.h"
 #include "parallel/allreduce_fusion/allreduce_graph.h"
+#include "parallel/allreduce_fusion/gradient_compression.h"
 #include "parallel/status.h"
 
 namespace mindspore {
@@ -34,6 +35,7 @@ constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_TAIL_TIME = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_INHERENT_TIME = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_BANDWIDTH = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_COMPUTATION_TIME_PARAMETER = 0.1;
+constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_BUCKET_BYTES = 25.0 * 1024 * 1024;
 
 constexpr char FUSION[] = "fusion";
 constexpr char PARAMETER[] = "parameter";
@@ -63,6 +65,10 @@ class AllreduceFusion {
   Status SetFusionByBackwardCompTime();
   Status SetFusionByBackwardCompAndAllreduceTime();
   Status GetSetFusionByBackwardCompAndAllreduceTimeParams();
+  // Size the buckets by the measured backward time of the operators
+  Status SetFusionByBackwardProfile(const FuncGraphPtr &forward_graph);
+  // Annotate the mirror operators of the gradients the cost model finds faster to reduce compressed
+  Status SetGradientCompression();
 
   AllreduceGraph allreduce_graph_;
   CNodePtr ret_;
@@ -72,7 +78,13 @@ class AllreduceFusion {
   double allreduce_inherent_time_;
   double allreduce_bandwidth_;
   double computation_time_parameter_;
+  std::unordered_map<AnfNodePtr, GradientCompression> para_compression_;
 };
+
+// The bytes of the gradient slice of the parameter on this device
+double GradientBytes(const AnfNodePtr &para);
+// The AllReduce time of the measured profile if there is one, otherwise of the inherent time and the bandwidth
+Status GetAllreduceTimeFunc(AllreduceTimeFunc *allreduce_time, size_t group_size = 0);
 }  // namespace parallel
 }  // namespace mindspore
 
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/allreduce_fusion/gradient_bucket.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+Status PlanGradientBuckets(const std::vector<BackwardOp> &ops, double bucket_bytes,
+                           const AllreduceTimeFunc &allreduce_time, BucketPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  if (!allreduce_time) {
+    MS_LOG(ERROR) << "The AllReduce time function is empty";
+    return FAILED;
+  }
+  plan->buckets.clear();
+  plan->allreduce_time = 0.0;
+  double now = 0.0;
+  double link_free = 0.0;
+  GradientBucket bucket = {0, 0, 0.0, 0.0, 0.0, 0.0};
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (ops[i].backward_time < 0.0 || ops[i].gradient_bytes < 0.0) {
+      MS_LOG(ERROR) << "The operator " << ops[i].name << " has a negative backward time " << ops[i].backward_time
+                    << " or gradient bytes " << ops[i].gradient_bytes;
+      return FAILED;
+    }
+    now += ops[i].backward_time;
+    if (ops[i].gradient_bytes == 0.0) {
+      continue;
+    }
+    if (bucket.bytes == 0.0) {
+      bucket.first_op = i;
+    }
+    bucket.last_op = i;
+    bucket.bytes += ops[i].gradient_bytes;
+
+    // the next operator with gradients, whose gradients the bucket would wait for
+    size_t next = i + 1;
+    double next_ready = now;
+    for (; next < ops.size(); ++next) {
+      next_ready += ops[next].backward_time;
+      if (ops[next].gradient_bytes > 0.0) {
+        break;
+      }
+    }
+    double start = std::max(now, link_free);
+    double time = allreduce_time(bucket.bytes);
+    bool last = (next == ops.size());
+    bool full = (bucket_bytes > 0.0 && bucket.bytes >= bucket_bytes);
+    bool link_idle = (start + time <= next_ready);
+    if (!last && !full && !link_idle) {
+      continue;
+    }
+    bucket.ready_time = now;
+    bucket.start_time = start;
+    bucket.end_time = start + time;
+    link_free = bucket.end_time;
+    plan->allreduce_time += time;
+    plan->buckets.push_back(bucket);
+    bucket = {0, 0, 0.0, 0.0, 0.0, 0.0};
+  }
+
+  plan->backward_time = now;
+  plan->exposed_time = std::max(link_free - now, 0.0);
+  plan->overlap_ratio = (plan->allreduce_time > 0.0) ? 1.0 - plan->exposed_time / plan->allreduce_time : 1.0;
+  return SUCCESS;
+}
+
+Status LoadBackwardTimeProfile(const std::string &file, std::unordered_map<std::string, double> *profile) {
+  MS_EXCEPTION_IF_NULL(profile);
+  std::ifstream json_file(file);
+  if (!json_file.is_open()) {
+    MS_LOG(ERROR) << "Open backward time profile " << file << " failed.";
+    return FAILED;
+  }
+  profile->clear();
+  try {
+    nlohmann::json profile_json;
+    json_file >> profile_json;
+    for (auto &item : profile_json.items()) {
+      double time = item.value().get<double>();
+      if (!(time >= 0.0) || std::isinf(time)) {
+        MS_LOG(ERROR) << "Invalid backward time " << time << " of " << item.key() << " in profile " << file;
+        return FAILED;
+      }
+      (*profile)[item.key()] = time;
+    }
+  } catch (const nlohmann::json::exception &e) {
+    MS_LOG(ERROR) << "Parse backward time profile " << file << " failed: " << e.what();
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Loaded the backward time of " << profile->size() << " operators from " << file;
+  return SUCCESS;
+}
+}  // namespace parallel
+}  // namespace mindspore
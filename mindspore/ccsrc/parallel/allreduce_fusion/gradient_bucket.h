@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PARALLEL_ALLREDUCE_FUSION_GRADIENT_BUCKET_H_
+#define MINDSPORE_CCSRC_PARALLEL_ALLREDUCE_FUSION_GRADIENT_BUCKET_H_
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "parallel/status.h"
+
+namespace mindspore {
+namespace parallel {
+// An operator in the order of the backward, the gradients of its parameters are ready when its backward ends
+struct BackwardOp {
+  std::string name;
+  double backward_time;
+  double gradient_bytes;
+};
+
+// The gradients of the operators from first_op to last_op reduced by one AllReduce
+struct GradientBucket {
+  size_t first_op;
+  size_t last_op;
+  double bytes;
+  double ready_time;
+  double start_time;
+  double end_time;
+};
+
+struct BucketPlan {
+  std::vector<GradientBucket> buckets;
+  double backward_time;
+  double allreduce_time;
+  // the time of the allreduces after the end of the backward
+  double exposed_time;
+  // the part of the allreduce time hidden behind the backward
+  double overlap_ratio;
+};
+
+// The time of the AllReduce of the bytes
+using AllreduceTimeFunc = std::function<double(double)>;
+
+// Split the gradients into buckets in the order of the backward. A bucket is closed when it reaches bucket_bytes, or
+// earlier when its AllReduce would end before the next gradient is ready, since waiting for that gradient only
+// delays the bucket then. The AllReduces run one at a time, each starting when its bucket is ready and the previous
+// one ends.
+Status PlanGradientBuckets(const std::vector<BackwardOp> &ops, double bucket_bytes,
+                           const AllreduceTimeFunc &allreduce_time, BucketPlan *plan);
+
+// The file is a json object mapping the names of the operators, the full names with scope or the names of their
+// OperatorInfo, to their measured backward time, in the unit of the AllReduce time.
+Status LoadBackwardTimeProfile(const std::string &file, std::unordered_map<std::string, double> *profile);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PARALLEL_ALLREDUCE_FUSION_GRADIENT_BUCKET_H_
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/allreduce_fusion/gradient_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+constexpr size_t kFloat32Bytes = 4;
+constexpr double kFp16ScalePasses = 4.0;
+
+const std::map<std::string, GradientCompression> kGradientCompressionMap = {
+  {"none", kCompressionNone},
+  {"fp16", kCompressionFp16},
+  {"topk", kCompressionTopK},
+  {"powersgd", kCompressionPowerSGD},
+};
+}  // namespace
+
+bool GetGradientCompression(const std::string &name, GradientCompression *method) {
+  MS_EXCEPTION_IF_NULL(method);
+  auto iter = kGradientCompressionMap.find(name);
+  if (iter == kGradientCompressionMap.end()) {
+    return false;
+  }
+  *method = iter->second;
+  return true;
+}
+
+std::string GradientCompressionName(GradientCompression method) {
+  for (auto &item : kGradientCompressionMap) {
+    if (item.second == method) {
+      return item.first;
+    }
+  }
+  return "none";
+}
+
+size_t TopKCount(size_t count, double ratio) {
+  auto k = static_cast<size_t>(std::ceil(ratio * static_cast<double>(count)));
+  return std::min(std::max(k, size_t(1)), count);
+}
+
+void PowerSGDMatrix(const std::vector<int32_t> &shape, size_t *rows, size_t *cols) {
+  MS_EXCEPTION_IF_NULL(rows);
+  MS_EXCEPTION_IF_NULL(cols);
+  *rows = shape.empty() ? 1 : static_cast<size_t>(shape[0]);
+  *cols = 1;
+  for (size_t i = 1; i < shape.size(); ++i) {
+    *cols *= static_cast<size_t>(shape[i]);
+  }
+}
+
+double CompressedAllreduceTime(const GradientCompressionConfig &config, GradientCompression method,
+                               const std::vector<int32_t> &shape, size_t element_bytes, int32_t dev_num,
+                               const AllreduceTimeFunc &allreduce_time) {
+  if (!allreduce_time || element_bytes != kFloat32Bytes || dev_num < 1) {
+    return -1.0;
+  }
+  size_t count = 1;
+  for (auto dim : shape) {
+    count *= static_cast<size_t>(dim);
+  }
+  auto elements = static_cast<double>(count);
+  switch (method) {
+    case kCompressionNone:
+      return allreduce_time(elements * kFloat32Bytes);
+    case kCompressionFp16:
+      // the AllReduce of the largest magnitude, then the passes finding it, scaling and casting to float16, and
+      // casting back and unscaling
+      return allreduce_time(elements * kFloat32Bytes / 2) + allreduce_time(kFloat32Bytes) +
+             kFp16ScalePasses * elements * config.element_time;
+    case kCompressionTopK: {
+      if (config.topk_ratio <= 0 || config.topk_ratio >= 1) {
+        return -1.0;
+      }
+      // every device sends k values and k indices, an AllGather moves about half the bytes of an AllReduce of its
+      // output
+      auto k = static_cast<double>(TopKCount(count, config.topk_ratio));
+      double gathered_bytes = dev_num * 2 * k * kFloat32Bytes;
+      return allreduce_time(gathered_bytes / 2) + (elements + dev_num * k) * config.element_time;
+    }
+    case kCompressionPowerSGD: {
+      size_t rows = 0;
+      size_t cols = 0;
+      PowerSGDMatrix(shape, &rows, &cols);
+      auto rank = static_cast<size_t>(std::max(config.powersgd_rank, 0));
+      // the vectors and the gradients whose factors are not smaller than themselves stay uncompressed
+      if (shape.size() < 2 || rank == 0 || rank >= std::min(rows, cols) || rank * (rows + cols) >= count) {
+        return -1.0;
+      }
+      auto r = static_cast<double>(rank);
+      // the products M * Q, M^T * P and P * Q^T and the orthogonalization of P
+      double compute = (3 * elements * r + static_cast<double>(rows) * r * r) * config.element_time;
+      return allreduce_time(static_cast<double>(rows) * r * kFloat32Bytes) +
+             allreduce_time(static_cast<double>(cols) * r * kFloat32Bytes) + compute;
+    }
+    default:
+      return -1.0;
+  }
+}
+
+GradientCompression ChooseGradientCompression(const GradientCompressionConfig &config,
+                                              const std::vector<int32_t> &shape, size_t element_bytes,
+                                              int32_t dev_num, const AllreduceTimeFunc &allreduce_time) {
+  if (config.method == kCompressionNone || dev_num < 2) {
+    return kCompressionNone;
+  }
+  double compressed_time =
+    CompressedAllreduceTime(config, config.method, shape, element_bytes, dev_num, allreduce_time);
+  if (compressed_time < 0) {
+    return kCompressionNone;
+  }
+  double plain_time = CompressedAllreduceTime(config, kCompressionNone, shape, element_bytes, dev_num, allreduce_time);
+  return (compressed_time < plain_time) ? config.method : kCompressionNone;
+}
+
+double FusedGradientBytes(GradientCompression method, double bytes) {
+  switch (method) {
+    case kCompressionFp16:
+      return bytes / 2;
+    case kCompressionTopK:
+    case kCompressionPowerSGD:
+      return 0.0;
+    default:
+      return bytes;
+  }
+}
+}  // namespace parallel
+}  // namespace mindspore
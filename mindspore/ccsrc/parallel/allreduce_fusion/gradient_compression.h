@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PARALLEL_ALLREDUCE_FUSION_GRADIENT_COMPRESSION_H_
+#define MINDSPORE_CCSRC_PARALLEL_ALLREDUCE_FUSION_GRADIENT_COMPRESSION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "parallel/allreduce_fusion/gradient_bucket.h"
+
+namespace mindspore {
+namespace parallel {
+constexpr char DEFAULT_COST_MODEL_GRADIENT_COMPRESSION[] = "none";
+constexpr double DEFAULT_COST_MODEL_GRADIENT_COMPRESSION_TOPK_RATIO = 0.01;
+constexpr int32_t DEFAULT_COST_MODEL_GRADIENT_COMPRESSION_POWERSGD_RANK = 4;
+constexpr double DEFAULT_COST_MODEL_GRADIENT_COMPRESSION_ELEMENT_TIME = 0.0;
+
+// The attributes of the mirror operators whose gradients are compressed, the bprop of the mirror operator reads them
+constexpr char COMPRESSION[] = "compression";
+constexpr char COMPRESSION_TOPK_RATIO[] = "compression_topk_ratio";
+constexpr char COMPRESSION_POWERSGD_RANK[] = "compression_powersgd_rank";
+// the key of the state of the compression, such as the residual, which is kept per mirror operator
+constexpr char COMPRESSION_KEY[] = "compression_key";
+
+enum GradientCompression { kCompressionNone, kCompressionFp16, kCompressionTopK, kCompressionPowerSGD };
+
+// Parse the names "none", "fp16", "topk" and "powersgd"
+bool GetGradientCompression(const std::string &name, GradientCompression *method);
+std::string GradientCompressionName(GradientCompression method);
+
+struct GradientCompressionConfig {
+  GradientCompression method;
+  // the part of the elements kept by the top-k
+  double topk_ratio;
+  // the rank of the low-rank approximation of PowerSGD
+  int32_t powersgd_rank;
+  // the time to compress or decompress one element, in the unit of the AllReduce time
+  double element_time;
+};
+
+// The number of the elements kept by the top-k, at least one
+size_t TopKCount(size_t count, double ratio);
+
+// PowerSGD views the gradient as a matrix of the first dimension by the product of the others
+void PowerSGDMatrix(const std::vector<int32_t> &shape, size_t *rows, size_t *cols);
+
+// The time of the communication of a gradient compressed by the method, including the compression and the
+// decompression, or a negative value when the method does not apply to the gradient. The top-k values and indices
+// are gathered from all the devices while PowerSGD reduces its two factors. Only the float32 gradients are
+// compressed.
+double CompressedAllreduceTime(const GradientCompressionConfig &config, GradientCompression method,
+                               const std::vector<int32_t> &shape, size_t element_bytes, int32_t dev_num,
+                               const AllreduceTimeFunc &allreduce_time);
+
+// The configured method if it reduces the gradient faster than the plain AllReduce, otherwise none
+GradientCompression ChooseGradientCompression(const GradientCompressionConfig &config,
+                                              const std::vector<int32_t> &shape, size_t element_bytes,
+                                              int32_t dev_num, const AllreduceTimeFunc &allreduce_time);
+
+// The bytes the gradient adds to its fused AllReduce. The top-k and PowerSGD gradients are communicated by their own
+// operators, outside the fused ones.
+double FusedGradientBytes(GradientCompression method, double bytes);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PARALLEL_ALLREDUCE_FUSION_GRADIENT_COMPRESSION_H_
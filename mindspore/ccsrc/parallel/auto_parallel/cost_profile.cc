@@ -0,0 +1,794 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/auto_parallel/cost_profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+#ifdef ENABLE_CPU
+#include "device/cpu/kernel_select_cpu.h"
+#include "device/kernel_info.h"
+#include "ir/func_graph.h"
+#include "ir/primitive.h"
+#include "kernel/cpu/cpu_kernel_factory.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#endif
+#ifdef ENABLE_CPU_COLLECTIVE
+#include "device/cpu/distribution/cpu_collective.h"
+#endif
+
+namespace mindspore {
+namespace parallel {
+namespace {
+constexpr double kMinMeasureTimeUs = 2000.0;
+constexpr size_t kMinMeasureRepeat = 3;
+constexpr size_t kMinCalibrationBytes = 4 << 10;
+constexpr size_t kMaxCalibrationBytes = 16 << 20;
+// the naive gemm of the host is slow, it is extrapolated above this
+constexpr size_t kMaxGemmCalibrationBytes = 4 << 20;
+constexpr size_t kCalibrationBytesStep = 4;
+constexpr size_t kMaxCalibrationRanks = 8;
+// the collectives among the processes are repeated the same times on every rank, about this many bytes in all
+constexpr size_t kCollectiveRepeatBytes = 64 << 20;
+constexpr size_t kMaxCollectiveRepeat = 200;
+constexpr size_t kRowSize = 1024;
+constexpr size_t kGatherRowSize = 16;
+
+// The host kernel each OperatorCost is measured with
+enum class KernelKind { kGemm, kUnary, kBinary, kRowNorm, kReduce, kGather, kCopy };
+enum class CollectiveKind { kAllReduce, kAllGather };
+
+const std::vector<std::pair<std::string, KernelKind>> &CostModelKernels() {
+  static const std::vector<std::pair<std::string, KernelKind>> kernels = {
+    {DEFAULT_COMPUTATION_CURVE, KernelKind::kUnary},
+    {REDISTRIBUTION_COMPUTATION_CURVE, KernelKind::kCopy},
+    {"MatMulCost", KernelKind::kGemm},
+    {"ActivationCost", KernelKind::kUnary},
+    {"SoftmaxCost", KernelKind::kRowNorm},
+    {"TmpIdentityCost", KernelKind::kCopy},
+    {"BatchParallelCost", KernelKind::kCopy},
+    {"VirtualDatasetCost", KernelKind::kCopy},
+    {"GeneratorBaseCost", KernelKind::kCopy},
+    {"PReLUCost", KernelKind::kBinary},
+    {"OneHotCost", KernelKind::kCopy},
+    {"SoftmaxCrossEntropyWithLogitsCost", KernelKind::kRowNorm},
+    {"ReshapeCost", KernelKind::kCopy},
+    {"ArithmeticCost", KernelKind::kBinary},
+    {"ReduceMethodCost", KernelKind::kReduce},
+    {"ReduceMeanCost", KernelKind::kReduce},
+    {"GetNextCost", KernelKind::kCopy},
+    {"DropOutCost", KernelKind::kBinary},
+    {"LayerNormCost", KernelKind::kRowNorm},
+    {"GatherV2Cost", KernelKind::kGather},
+    {"GatherV2PCost", KernelKind::kGather},
+  };
+  return kernels;
+}
+
+// Keep the results of the kernels alive, so they are not optimized out
+volatile float g_kernel_sink = 0.0f;
+
+// The average time in us of run, after a warm up run
+double MeasureUs(const std::function<void()> &run) {
+  run();
+  size_t repeat = 0;
+  double total = 0.0;
+  while (repeat < kMinMeasureRepeat || total < kMinMeasureTimeUs) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    total += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    repeat++;
+  }
+  return total / repeat;
+}
+
+// The loop on the host standing for the kernel, for the builds without the CPU kernels
+double MeasureHostKernel(KernelKind kind, size_t bytes) {
+  size_t count = std::max<size_t>(bytes / sizeof(float), kRowSize);
+  switch (kind) {
+    case KernelKind::kGemm: {
+      // two square matrices of float
+      auto n = std::max<size_t>(static_cast<size_t>(std::sqrt(bytes / (2.0 * sizeof(float)))), 1);
+      std::vector<float> a(n * n, 1.0f), b(n * n, 0.5f), c(n * n);
+      return MeasureUs([&]() {
+        std::fill(c.begin(), c.end(), 0.0f);
+        for (size_t i = 0; i < n; ++i) {
+          for (size_t k = 0; k < n; ++k) {
+            float scale = a[i * n + k];
+            for (size_t j = 0; j < n; ++j) {
+              c[i * n + j] += scale * b[k * n + j];
+            }
+          }
+        }
+        g_kernel_sink = c[n * n - 1];
+      });
+    }
+    case KernelKind::kUnary: {
+      std::vector<float> x(count, -1.0f), y(count);
+      return MeasureUs([&]() {
+        for (size_t i = 0; i < count; ++i) {
+          y[i] = x[i] > 0.0f ? x[i] : 0.01f * x[i];
+        }
+        g_kernel_sink = y[count - 1];
+      });
+    }
+    case KernelKind::kBinary: {
+      count /= 2;
+      std::vector<float> x0(count, 1.0f), x1(count, 2.0f), y(count);
+      return MeasureUs([&]() {
+        for (size_t i = 0; i < count; ++i) {
+          y[i] = x0[i] * x1[i] + x0[i];
+        }
+        g_kernel_sink = y[count - 1];
+      });
+    }
+    case KernelKind::kRowNorm: {
+      // softmax of every row
+      std::vector<float> x(count, 1.0f), y(count);
+      return MeasureUs([&]() {
+        for (size_t row = 0; row + kRowSize <= count; row += kRowSize) {
+          float max_value = *std::max_element(x.begin() + row, x.begin() + row + kRowSize);
+          float sum = 0.0f;
+          for (size_t i = row; i < row + kRowSize; ++i) {
+            y[i] = std::exp(x[i] - max_value);
+            sum += y[i];
+          }
+          for (size_t i = row; i < row + kRowSize; ++i) {
+            y[i] /= sum;
+          }
+        }
+        g_kernel_sink = y[count - 1];
+      });
+    }
+    case KernelKind::kReduce: {
+      std::vector<float> x(count, 1.0f), y(count / kRowSize);
+      return MeasureUs([&]() {
+        for (size_t row = 0; row < y.size(); ++row) {
+          float sum = 0.0f;
+          for (size_t i = row * kRowSize; i < (row + 1) * kRowSize; ++i) {
+            sum += x[i];
+          }
+          y[row] = sum;
+        }
+        g_kernel_sink = y.back();
+      });
+    }
+    case KernelKind::kGather: {
+      // an eighth of the bytes are the indices, the rest is the table
+      size_t index_num = std::max<size_t>(count / 8, 1);
+      size_t row_num = std::max<size_t>((count - index_num) / kGatherRowSize, 1);
+      std::vector<float> table(row_num * kGatherRowSize, 1.0f), y(index_num * kGatherRowSize);
+      std::vector<uint32_t> indices(index_num);
+      uint32_t seed = 1;
+      for (auto &index : indices) {
+        seed = seed * 1103515245 + 12345;
+        index = seed % row_num;
+      }
+      return MeasureUs([&]() {
+        for (size_t i = 0; i < index_num; ++i) {
+          std::copy_n(table.begin() + indices[i] * kGatherRowSize, kGatherRowSize, y.begin() + i * kGatherRowSize);
+        }
+        g_kernel_sink = y.back();
+      });
+    }
+    case KernelKind::kCopy:
+    default: {
+      std::vector<float> x(count, 1.0f), y(count);
+      return MeasureUs([&]() {
+        std::copy(x.begin(), x.end(), y.begin());
+        g_kernel_sink = y[count - 1];
+      });
+    }
+  }
+}
+
+#ifdef ENABLE_CPU
+struct KernelSpec {
+  std::string name;
+  std::vector<std::pair<TypePtr, std::vector<int>>> inputs;
+  std::vector<int> output;
+  std::vector<std::pair<std::string, ValuePtr>> attrs;
+};
+
+// The registered CPU kernel standing for the kind, whose inputs take 'bytes' bytes in all
+KernelSpec GetKernelSpec(KernelKind kind, size_t bytes) {
+  int count = SizeToInt(std::max<size_t>(bytes / sizeof(float), kRowSize));
+  int row_size = SizeToInt(kRowSize);
+  int rows = count / row_size;
+  switch (kind) {
+    case KernelKind::kGemm: {
+      int n = std::max(static_cast<int>(std::sqrt(bytes / (2.0 * sizeof(float)))), 1);
+      return {"MatMul",
+              {{kFloat32, {n, n}}, {kFloat32, {n, n}}},
+              {n, n},
+              {{kernel::TRANSPOSE_A, MakeValue(false)}, {kernel::TRANSPOSE_B, MakeValue(false)}}};
+    }
+    case KernelKind::kUnary:
+      return {"ReLU", {{kFloat32, {rows, row_size}}}, {rows, row_size}, {}};
+    case KernelKind::kBinary: {
+      int half_rows = std::max(rows / 2, 1);
+      return {"Mul", {{kFloat32, {half_rows, row_size}}, {kFloat32, {half_rows, row_size}}}, {half_rows, row_size}, {}};
+    }
+    case KernelKind::kRowNorm:
+      return {"Softmax",
+              {{kFloat32, {rows, row_size}}},
+              {rows, row_size},
+              {{kernel::AXIS, MakeValue(std::vector<int>{-1})}}};
+    case KernelKind::kReduce:
+      return {"ReduceSum",
+              {{kFloat32, {rows, row_size}}},
+              {rows},
+              {{kernel::AXIS, MakeValue(std::vector<int>{1})}, {"keep_dims", MakeValue(false)}}};
+    case KernelKind::kGather: {
+      // an eighth of the bytes are the indices, the rest is the table
+      int index_num = std::max(count / 8, 1);
+      int gather_row_size = SizeToInt(kGatherRowSize);
+      int row_num = std::max((count - index_num) / gather_row_size, 1);
+      return {"GatherV2",
+              {{kFloat32, {row_num, gather_row_size}}, {kInt32, {index_num}}},
+              {index_num, gather_row_size},
+              {{kernel::AXIS, MakeValue(0)}}};
+    }
+    case KernelKind::kCopy:
+    default:
+      return {"Reshape", {{kFloat32, {rows, row_size}}}, {rows * row_size}, {}};
+  }
+}
+
+// The time of the registered CPU kernel on a node built for it, a negative time if the kernel is not registered
+double MeasureCPUKernel(const KernelSpec &spec) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto prim = std::make_shared<Primitive>(spec.name);
+  for (auto &attr : spec.attrs) {
+    (void)prim->AddAttr(attr.first, attr.second);
+  }
+  std::vector<AnfNodePtr> node_inputs = {NewValueNode(prim)};
+  for (auto &input : spec.inputs) {
+    auto param = graph->add_parameter();
+    param->set_abstract(std::make_shared<abstract::AbstractTensor>(input.first, input.second));
+    param->set_kernel_info(std::make_shared<device::KernelInfo>());
+    node_inputs.push_back(param);
+  }
+  auto kernel_node = graph->NewCNode(node_inputs);
+  kernel_node->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, spec.output));
+  kernel_node->set_kernel_info(std::make_shared<device::KernelInfo>());
+  device::cpu::SetKernelInfo(kernel_node);
+  auto cpu_kernel = kernel::CPUKernelFactory::GetInstance().Create(spec.name, kernel_node);
+  if (cpu_kernel == nullptr) {
+    return -1.0;
+  }
+  cpu_kernel->Init(kernel_node);
+
+  std::vector<std::vector<float>> buffers;
+  auto make_addresses = [&buffers](const std::vector<size_t> &sizes, std::vector<AddressPtr> *addresses) {
+    for (auto size : sizes) {
+      buffers.emplace_back((size + sizeof(float) - 1) / sizeof(float), 0.5f);
+      auto address = std::make_shared<kernel::Address>();
+      address->addr = buffers.back().data();
+      address->size = size;
+      addresses->push_back(address);
+    }
+  };
+  std::vector<AddressPtr> inputs, workspaces, outputs;
+  make_addresses(cpu_kernel->GetInputSizeList(), &inputs);
+  make_addresses(cpu_kernel->GetWorkspaceSizeList(), &workspaces);
+  make_addresses(cpu_kernel->GetOutputSizeList(), &outputs);
+  // the int32 inputs are the indices into the first dim of the first input
+  for (size_t i = 0; i < spec.inputs.size() && i < inputs.size(); ++i) {
+    if (spec.inputs[i].first->type_id() != kNumberTypeInt32) {
+      continue;
+    }
+    auto indices = static_cast<int32_t *>(inputs[i]->addr);
+    uint32_t seed = 1;
+    uint32_t bound = IntToUint(spec.inputs[0].second[0]);
+    for (size_t j = 0; j < inputs[i]->size / sizeof(int32_t); ++j) {
+      seed = seed * 1103515245 + 12345;
+      indices[j] = UintToInt(seed % bound);
+    }
+  }
+  return MeasureUs([&]() {
+    if (!cpu_kernel->Launch(inputs, workspaces, outputs)) {
+      MS_LOG(EXCEPTION) << "Launch the cpu kernel " << spec.name << " failed.";
+    }
+  });
+}
+#endif
+
+// The kernel takes inputs of 'bytes' bytes in all, which is the computation cost of the OperatorCost. The registered
+// CPU kernel is measured if there is one, the loop on the host if not.
+double MeasureKernel(KernelKind kind, size_t bytes) {
+#ifdef ENABLE_CPU
+  auto spec = GetKernelSpec(kind, bytes);
+  try {
+    double time = MeasureCPUKernel(spec);
+    if (time >= 0.0) {
+      return time;
+    }
+    MS_LOG(WARNING) << "The cpu kernel " << spec.name << " is not registered, the host loop is measured instead.";
+  } catch (const std::exception &e) {
+    MS_LOG(WARNING) << "Measure the cpu kernel " << spec.name << " failed, the host loop is measured instead: "
+                    << e.what();
+  }
+#endif
+  return MeasureHostKernel(kind, bytes);
+}
+
+// The barrier of the ranks emulated by the host threads
+class RankBarrier {
+ public:
+  explicit RankBarrier(size_t count) : count_(count) {}
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t generation = generation_;
+    if (++arrived_ == count_) {
+      arrived_ = 0;
+      generation_++;
+      cond_.notify_all();
+      return;
+    }
+    cond_.wait(lock, [this, generation]() { return generation != generation_; });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  size_t count_;
+  size_t arrived_ = 0;
+  size_t generation_ = 0;
+};
+
+// The ring collective among rank_num host threads, 'bytes' is the size of the result on each rank
+double MeasureThreadCollective(CollectiveKind kind, size_t bytes, size_t rank_num) {
+  size_t count = std::max(bytes / sizeof(float), rank_num);
+  std::vector<std::vector<float>> buffers(rank_num, std::vector<float>(count, 1.0f));
+  auto chunk_begin = [count, rank_num](size_t chunk) { return chunk % rank_num * count / rank_num; };
+  auto chunk_end = [count, rank_num](size_t chunk) { return (chunk % rank_num + 1) * count / rank_num; };
+  RankBarrier barrier(rank_num);
+  std::atomic<bool> done(false);
+  double total = 0.0;
+  size_t repeat = 0;
+
+  auto rank_loop = [&](size_t rank) {
+    auto &buffer = buffers[rank];
+    const auto &prev_buffer = buffers[(rank + rank_num - 1) % rank_num];
+    // the first run warms up
+    for (size_t run = 0;; ++run) {
+      barrier.Wait();
+      if (done) {
+        break;
+      }
+      auto start = std::chrono::steady_clock::now();
+      if (kind == CollectiveKind::kAllReduce) {
+        // reduce scatter, the rank receives a chunk from the previous rank at each step
+        for (size_t step = 0; step + 1 < rank_num; ++step) {
+          size_t chunk = rank + 2 * rank_num - step - 1;
+          for (size_t i = chunk_begin(chunk); i < chunk_end(chunk); ++i) {
+            buffer[i] += prev_buffer[i];
+          }
+          barrier.Wait();
+        }
+      }
+      // all gather of the chunks complete on each rank
+      size_t first_chunk = kind == CollectiveKind::kAllReduce ? rank + rank_num : rank + rank_num - 1;
+      for (size_t step = 0; step + 1 < rank_num; ++step) {
+        size_t chunk = first_chunk - step;
+        std::copy(prev_buffer.begin() + chunk_begin(chunk), prev_buffer.begin() + chunk_end(chunk),
+                  buffer.begin() + chunk_begin(chunk));
+        barrier.Wait();
+      }
+      if (rank == 0) {
+        if (run > 0) {
+          total += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+          repeat++;
+        }
+        done = repeat >= kMinMeasureRepeat && total >= kMinMeasureTimeUs;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t rank = 1; rank < rank_num; ++rank) {
+    threads.emplace_back(rank_loop, rank);
+  }
+  rank_loop(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  g_kernel_sink = buffers[0][count - 1];
+  return total / repeat;
+}
+
+#ifdef ENABLE_CPU_COLLECTIVE
+// The collective of the group among the processes, 'bytes' is the size of the result on each rank. The ranks run
+// the same number of collectives, which depends on the size only.
+double MeasureProcessCollective(CollectiveKind kind, size_t bytes, const std::string &group, size_t rank_num) {
+  auto &collective = device::cpu::CPUCollective::instance();
+  size_t count = std::max(bytes / sizeof(float), rank_num) / rank_num * rank_num;
+  std::vector<float> input(kind == CollectiveKind::kAllReduce ? count : count / rank_num, 1.0f);
+  std::vector<float> output(count);
+  auto run = [&]() {
+    bool success = kind == CollectiveKind::kAllReduce
+                     ? collective.AllReduce(input.data(), output.data(), count, kNumberTypeFloat32,
+                                            device::cpu::kCollectiveSum, group)
+                     : collective.AllGather(input.data(), output.data(), input.size(), kNumberTypeFloat32, group);
+    if (!success) {
+      MS_LOG(EXCEPTION) << "The collective of the group " << group << " failed when calibrating the cost models.";
+    }
+  };
+  // the first run warms up, and the ranks start together after it
+  run();
+  size_t repeat = std::min(std::max(kCollectiveRepeatBytes / bytes, kMinMeasureRepeat), kMaxCollectiveRepeat);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repeat; ++i) {
+    run();
+  }
+  g_kernel_sink = output[count - 1];
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / repeat;
+}
+
+// Every rank keeps the largest time of every point among the ranks, the curves have the same points on every rank
+void SyncCurvesAmongRanks(std::vector<ThroughputCurve *> curves) {
+  std::vector<double> times;
+  for (auto curve : curves) {
+    for (auto &point : curve->points()) {
+      times.push_back(point.second);
+    }
+  }
+  if (!device::cpu::CPUCollective::instance().AllReduce(times.data(), times.data(), times.size(), kNumberTypeFloat64,
+                                                         device::cpu::kCollectiveMax, device::cpu::CPU_WORLD_GROUP)) {
+    MS_LOG(EXCEPTION) << "Sync the cost profile among the ranks failed.";
+  }
+  size_t index = 0;
+  for (auto curve : curves) {
+    auto points = curve->points();
+    for (auto &point : points) {
+      point.second = times[index++];
+    }
+    *curve = ThroughputCurve(points);
+  }
+}
+#endif
+
+// The powers of 2 below the rank number and the rank number
+std::vector<size_t> CalibrationGroupSizes(size_t rank_num) {
+  std::vector<size_t> sizes;
+  for (size_t size = 2; size < rank_num; size *= 2) {
+    sizes.push_back(size);
+  }
+  sizes.push_back(rank_num);
+  return sizes;
+}
+
+// The time of a ring collective of the group measured on measured_size ranks, scaled to group_size ranks
+double ScaleToGroupSize(const ThroughputCurve &curve, double bytes, size_t measured_size, size_t group_size) {
+  double time = curve.Time(bytes);
+  if (group_size == measured_size || curve.empty()) {
+    return time;
+  }
+  double latency = std::min(curve.points().front().second, time);
+  double steps_ratio = (group_size - 1.0) / (measured_size - 1.0);
+  double share_ratio = steps_ratio * measured_size / group_size;
+  return latency * steps_ratio + (time - latency) * share_ratio;
+}
+
+std::vector<size_t> CalibrationSizes(size_t max_bytes) {
+  std::vector<size_t> sizes;
+  for (size_t bytes = kMinCalibrationBytes; bytes <= max_bytes; bytes *= kCalibrationBytesStep) {
+    sizes.push_back(bytes);
+  }
+  return sizes;
+}
+}  // namespace
+
+ThroughputCurve::ThroughputCurve(std::vector<std::pair<double, double>> points) : points_(std::move(points)) {
+  std::sort(points_.begin(), points_.end());
+  // the time never decreases with the size, which the measuring noise may break
+  for (size_t i = 1; i < points_.size(); ++i) {
+    points_[i].second = std::max(points_[i].second, points_[i - 1].second);
+  }
+}
+
+double ThroughputCurve::Time(double bytes) const {
+  if (bytes <= 0.0 || points_.empty()) {
+    return 0.0;
+  }
+  if (bytes <= points_.front().first) {
+    return points_.front().second;
+  }
+  auto iter = std::lower_bound(points_.begin(), points_.end(), std::make_pair(bytes, 0.0));
+  if (iter != points_.end()) {
+    auto prev = iter - 1;
+    return prev->second + (iter->second - prev->second) * (bytes - prev->first) / (iter->first - prev->first);
+  }
+  auto &last = points_.back();
+  // the time per byte of the last segment, or of the last size when the segment is flat
+  double slope = 0.0;
+  if (points_.size() > 1) {
+    auto &prev = points_[points_.size() - 2];
+    slope = (last.second - prev.second) / (last.first - prev.first);
+  }
+  if (slope <= 0.0) {
+    slope = last.second / last.first;
+  }
+  return last.second + slope * (bytes - last.first);
+}
+
+Status CostProfile::CheckCurves() const {
+  auto default_curve = computation_curves_.find(DEFAULT_COMPUTATION_CURVE);
+  if (default_curve == computation_curves_.end() || default_curve->second.empty()) {
+    MS_LOG(ERROR) << "The cost profile has no computation curve: " << DEFAULT_COMPUTATION_CURVE;
+    return FAILED;
+  }
+  for (auto &name : {ALLREDUCE_COMMUNICATION_CURVE, ALLGATHER_COMMUNICATION_CURVE}) {
+    auto curves = communication_curves_.find(name);
+    if (curves == communication_curves_.end() || curves->second.empty()) {
+      MS_LOG(ERROR) << "The cost profile has no communication curve: " << name;
+      return FAILED;
+    }
+    for (auto &curve : curves->second) {
+      if (curve.first < 2 || curve.second.empty()) {
+        MS_LOG(ERROR) << "The communication curve " << name << " of the group size " << curve.first
+                      << " is invalid, the group size must be at least 2 and the curve must have points.";
+        return FAILED;
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+Status CostProfile::Load(const std::string &file) {
+  std::ifstream json_file(file);
+  if (!json_file.is_open()) {
+    MS_LOG(ERROR) << "Open cost profile " << file << " failed.";
+    return FAILED;
+  }
+  computation_curves_.clear();
+  communication_curves_.clear();
+  try {
+    nlohmann::json profile;
+    json_file >> profile;
+    rank_num_ = profile.value("rank_num", 0);
+    auto parse_curve = [&file](const std::string &name, const nlohmann::json &points_json, ThroughputCurve *curve) {
+      std::vector<std::pair<double, double>> points;
+      for (auto &point : points_json) {
+        double bytes = point.at(0).get<double>();
+        double time = point.at(1).get<double>();
+        if (!(bytes > 0.0) || !(time >= 0.0) || std::isinf(bytes) || std::isinf(time)) {
+          MS_LOG(ERROR) << "Invalid point (" << bytes << ", " << time << ") of the curve " << name
+                        << " in cost profile " << file;
+          return false;
+        }
+        points.emplace_back(bytes, time);
+      }
+      *curve = ThroughputCurve(points);
+      return true;
+    };
+    if (profile.find("computation") != profile.end()) {
+      for (auto &item : profile.at("computation").items()) {
+        if (!parse_curve(item.key(), item.value(), &computation_curves_[item.key()])) {
+          return FAILED;
+        }
+      }
+    }
+    if (profile.find("communication") != profile.end()) {
+      for (auto &item : profile.at("communication").items()) {
+        for (auto &group_item : item.value().items()) {
+          size_t group_size = std::stoul(group_item.key());
+          if (!parse_curve(item.key(), group_item.value(), &communication_curves_[item.key()][group_size])) {
+            return FAILED;
+          }
+        }
+      }
+    }
+  } catch (const std::logic_error &e) {
+    // the group sizes not being numbers
+    MS_LOG(ERROR) << "Parse cost profile " << file << " failed: " << e.what();
+    return FAILED;
+  } catch (const nlohmann::json::exception &e) {
+    MS_LOG(ERROR) << "Parse cost profile " << file << " failed: " << e.what();
+    return FAILED;
+  }
+  if (CheckCurves() != SUCCESS) {
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Loaded cost profile " << file << " of " << computation_curves_.size() << " computation curves and "
+               << communication_curves_.size() << " communication curves measured on " << rank_num_ << " ranks.";
+  return SUCCESS;
+}
+
+Status CostProfile::Save(const std::string &file) const {
+  nlohmann::json profile;
+  profile["rank_num"] = rank_num_;
+  auto curve_json = [](const ThroughputCurve &curve) {
+    nlohmann::json points = nlohmann::json::array();
+    for (auto &point : curve.points()) {
+      points.push_back({point.first, point.second});
+    }
+    return points;
+  };
+  profile["computation"] = nlohmann::json::object();
+  for (auto &curve : computation_curves_) {
+    profile["computation"][curve.first] = curve_json(curve.second);
+  }
+  profile["communication"] = nlohmann::json::object();
+  for (auto &curves : communication_curves_) {
+    nlohmann::json groups_json = nlohmann::json::object();
+    for (auto &curve : curves.second) {
+      groups_json[std::to_string(curve.first)] = curve_json(curve.second);
+    }
+    profile["communication"][curves.first] = groups_json;
+  }
+  std::ofstream json_file(file);
+  if (!json_file.is_open()) {
+    MS_LOG(ERROR) << "Open cost profile " << file << " failed.";
+    return FAILED;
+  }
+  json_file << profile.dump(2) << std::endl;
+  if (!json_file.good()) {
+    MS_LOG(ERROR) << "Write cost profile " << file << " failed.";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+std::shared_ptr<CostProfile> CostProfile::Calibrate() {
+  auto profile = std::make_shared<CostProfile>();
+  MS_LOG(INFO) << "Calibrating the cost models on the host begins.";
+  std::map<KernelKind, ThroughputCurve> kernel_curves;
+  for (auto &cost_kernel : CostModelKernels()) {
+    auto kind = cost_kernel.second;
+    if (kernel_curves.find(kind) == kernel_curves.end()) {
+      std::vector<std::pair<double, double>> points;
+      auto max_bytes = kind == KernelKind::kGemm ? kMaxGemmCalibrationBytes : kMaxCalibrationBytes;
+      for (auto bytes : CalibrationSizes(max_bytes)) {
+        points.emplace_back(static_cast<double>(bytes), MeasureKernel(kind, bytes));
+      }
+      kernel_curves[kind] = ThroughputCurve(points);
+    }
+    profile->computation_curves_[cost_kernel.first] = kernel_curves[kind];
+  }
+
+  // the collectives among the processes if they are initialized, among the host threads if not
+  std::function<double(CollectiveKind, size_t, size_t)> measure_collective = MeasureThreadCollective;
+  profile->rank_num_ = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 2), kMaxCalibrationRanks);
+#ifdef ENABLE_CPU_COLLECTIVE
+  auto &collective = device::cpu::CPUCollective::instance();
+  bool among_processes = collective.initialized() && collective.size() > 1;
+  if (among_processes) {
+    profile->rank_num_ = IntToSize(collective.size());
+    size_t rank = IntToSize(collective.rank());
+    // the group of the first group_size ranks, the other ranks leave their points to be synced from them
+    measure_collective = [&collective, rank](CollectiveKind kind, size_t bytes, size_t group_size) {
+      if (rank >= group_size) {
+        return 0.0;
+      }
+      if (group_size == IntToSize(collective.size())) {
+        return MeasureProcessCollective(kind, bytes, device::cpu::CPU_WORLD_GROUP, group_size);
+      }
+      return MeasureProcessCollective(kind, bytes, "cost_profile_group_" + std::to_string(group_size), group_size);
+    };
+  }
+#endif
+  for (auto group_size : CalibrationGroupSizes(profile->rank_num_)) {
+#ifdef ENABLE_CPU_COLLECTIVE
+    std::string group = "cost_profile_group_" + std::to_string(group_size);
+    bool sub_group = among_processes && group_size < profile->rank_num_ && IntToSize(collective.rank()) < group_size;
+    if (sub_group) {
+      std::vector<unsigned int> ranks(group_size);
+      std::iota(ranks.begin(), ranks.end(), 0);
+      if (!collective.CreateGroup(group, ranks)) {
+        MS_LOG(EXCEPTION) << "Create the group " << group << " for calibrating the cost models failed.";
+      }
+    }
+#endif
+    for (auto &kind : {std::make_pair(ALLREDUCE_COMMUNICATION_CURVE, CollectiveKind::kAllReduce),
+                       std::make_pair(ALLGATHER_COMMUNICATION_CURVE, CollectiveKind::kAllGather)}) {
+      std::vector<std::pair<double, double>> points;
+      for (auto bytes : CalibrationSizes(kMaxCalibrationBytes)) {
+        points.emplace_back(static_cast<double>(bytes), measure_collective(kind.second, bytes, group_size));
+      }
+      profile->communication_curves_[kind.first][group_size] = ThroughputCurve(points);
+    }
+#ifdef ENABLE_CPU_COLLECTIVE
+    if (sub_group) {
+      (void)collective.DestroyGroup(group);
+    }
+#endif
+  }
+#ifdef ENABLE_CPU_COLLECTIVE
+  if (collective.initialized() && collective.size() > 1) {
+    std::vector<ThroughputCurve *> curves;
+    for (auto &curve : profile->computation_curves_) {
+      curves.push_back(&curve.second);
+    }
+    for (auto &group_curves : profile->communication_curves_) {
+      for (auto &curve : group_curves.second) {
+        curves.push_back(&curve.second);
+      }
+    }
+    SyncCurvesAmongRanks(curves);
+  }
+#endif
+  for (auto &curve : profile->computation_curves_) {
+    MS_LOG(INFO) << "Computation curve " << curve.first << ": " << curve.second.Time(kMaxCalibrationBytes) << " us for "
+                 << kMaxCalibrationBytes << " bytes.";
+  }
+  for (auto &group_curves : profile->communication_curves_) {
+    for (auto &curve : group_curves.second) {
+      MS_LOG(INFO) << "Communication curve " << group_curves.first << " of " << curve.first
+                   << " ranks: " << curve.second.Time(kMaxCalibrationBytes) << " us for " << kMaxCalibrationBytes
+                   << " bytes.";
+    }
+  }
+  MS_LOG(INFO) << "Calibrating the cost models on the host ends.";
+  return profile;
+}
+
+double CostProfile::ComputationTime(const std::string &name, double bytes) const {
+  auto curve = computation_curves_.find(name);
+  if (curve == computation_curves_.end()) {
+    curve = computation_curves_.find(DEFAULT_COMPUTATION_CURVE);
+    if (curve == computation_curves_.end()) {
+      MS_LOG(EXCEPTION) << "The cost profile has no computation curve: " << DEFAULT_COMPUTATION_CURVE;
+    }
+  }
+  return curve->second.Time(bytes);
+}
+
+void CostProfile::set_communication_curve(const std::string &name, size_t group_size, const ThroughputCurve &curve) {
+  if (group_size < 2) {
+    MS_LOG(EXCEPTION) << "The group size of the communication curve " << name << " is " << group_size
+                      << ", it must be at least 2.";
+  }
+  communication_curves_[name][group_size] = curve;
+}
+
+double CostProfile::CommunicationTime(const std::string &name, double bytes, size_t group_size) const {
+  auto curves = communication_curves_.find(name);
+  if (curves == communication_curves_.end() || curves->second.empty()) {
+    MS_LOG(EXCEPTION) << "The cost profile has no communication curve: " << name;
+  }
+  if (group_size == 0) {
+    group_size = rank_num_ > 0 ? rank_num_ : curves->second.rbegin()->first;
+  }
+  if (group_size < 2) {
+    return 0.0;
+  }
+  // the curve of the nearest group size in ratio
+  auto nearest = curves->second.lower_bound(group_size);
+  if (nearest == curves->second.end()) {
+    nearest = std::prev(nearest);
+  } else if (nearest->first != group_size && nearest != curves->second.begin()) {
+    auto below = std::prev(nearest);
+    if (static_cast<double>(group_size) / below->first < static_cast<double>(nearest->first) / group_size) {
+      nearest = below;
+    }
+  }
+  return ScaleToGroupSize(nearest->second, bytes, nearest->first, group_size);
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PARALLEL_AUTO_PARALLEL_COST_PROFILE_H_
+#define MINDSPORE_CCSRC_PARALLEL_AUTO_PARALLEL_COST_PROFILE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "parallel/status.h"
+
+namespace mindspore {
+namespace parallel {
+// The computation curve used for the cost models without a curve of their own
+#define DEFAULT_COMPUTATION_CURVE "Default"
+// The computation curve of the split and concat of a tensor redistribution
+#define REDISTRIBUTION_COMPUTATION_CURVE "TensorRedistribution"
+// The communication curve of the operators, whose communication is the AllReduce of partial results and gradients
+#define ALLREDUCE_COMMUNICATION_CURVE "AllReduce"
+// The communication curve of the tensor redistributions, which gather the slices of a tensor
+#define ALLGATHER_COMMUNICATION_CURVE "AllGather"
+
+// The time in us measured at some sizes in bytes, the bytes being what the cost model returns as the cost.
+class ThroughputCurve {
+ public:
+  ThroughputCurve() = default;
+  explicit ThroughputCurve(std::vector<std::pair<double, double>> points);
+  ~ThroughputCurve() = default;
+  // Linear between the measured sizes. Below the smallest size the time of it is taken as the latency, and above the
+  // largest size the throughput of the last segment is kept. A size of no bytes takes no time.
+  double Time(double bytes) const;
+  const std::vector<std::pair<double, double>> &points() const { return points_; }
+  bool empty() const { return points_.empty(); }
+
+ private:
+  // (bytes, us) sorted by bytes
+  std::vector<std::pair<double, double>> points_;
+};
+
+// The profile used by the cost models in place of the analytic constants. The computation cost of an operator is
+// turned into time by the curve of its OperatorCost, and the communication cost by the curve of the collective, so
+// the strategy search minimizes the step time in us. The curves of a collective are measured on several group sizes,
+// the time on another group size is scaled from the nearest one as a ring collective: the latency grows with the
+// p - 1 steps and the time of the bytes with the share (p - 1) / p sent by every rank.
+class CostProfile {
+ public:
+  CostProfile() = default;
+  ~CostProfile() = default;
+
+  // The file is a json object, whose "computation" maps the curve names to lists of [bytes, us] pairs, and whose
+  // "communication" maps the curve names to objects of such lists keyed by the group size. The default computation
+  // curve and the two communication curves must be in it.
+  Status Load(const std::string &file);
+  Status Save(const std::string &file) const;
+  // Run the registered CPU kernels of every OperatorCost, and the collectives among the processes if the CPU
+  // collective is initialized, or among the host threads if not. All the processes must calibrate together, they
+  // keep the slowest time of every point so that they search the strategies on the same profile.
+  static std::shared_ptr<CostProfile> Calibrate();
+
+  void set_computation_curve(const std::string &name, const ThroughputCurve &curve) {
+    computation_curves_[name] = curve;
+  }
+  // The group size is at least 2
+  void set_communication_curve(const std::string &name, size_t group_size, const ThroughputCurve &curve);
+  // The number of ranks of the job the profile is measured on, the group size of the collectives unknown to the cost
+  // models
+  size_t rank_num() const { return rank_num_; }
+  void set_rank_num(size_t rank_num) { rank_num_ = rank_num; }
+  // Use the default curve for the names not in the profile
+  double ComputationTime(const std::string &name, double bytes) const;
+  // A group size of 0 is the rank number of the profile, a group of a single rank takes no time
+  double CommunicationTime(const std::string &name, double bytes, size_t group_size = 0) const;
+
+ private:
+  Status CheckCurves() const;
+
+  std::map<std::string, ThroughputCurve> computation_curves_;
+  // the curves of every group size measured
+  std::map<std::string, std::map<size_t, ThroughputCurve>> communication_curves_;
+  size_t rank_num_ = 0;
+};
+using CostProfilePtr = std::shared_ptr<CostProfile>;
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PARALLEL_AUTO_PARALLEL_COST_PROFILE_H_
@@ -76,8 +76,55 @@ void SimplifyForDecreasingCommunicationWithPartialPara(CostPtrList *clist_ptrs)
   *clist_ptrs = std::move(ret);
 }
 
-void RefineForPracticalCost(const CostPtr &origin_cost, bool is_redistribution) {
+// The costs not positive are kept, they are the ties broken by BreakingTiesForPerferringDataParallel
+static void RefineForProfiledCost(const CostPtr &origin_cost, bool is_redistribution, const std::string &cost_name,
+                                  const CommGroupSizes &group_sizes) {
+  MS_EXCEPTION_IF_NULL(COST_MODEL_PROFILE);
+  auto communication_time = [](const std::string &curve, double cost, size_t group_size) {
+    return cost > EPS ? COST_MODEL_PROFILE->CommunicationTime(curve, cost, group_size) : cost;
+  };
+  if (is_redistribution) {
+    if (origin_cost->computation_cost_ > EPS) {
+      origin_cost->computation_cost_ =
+        COST_MODEL_PROFILE->ComputationTime(REDISTRIBUTION_COMPUTATION_CURVE, origin_cost->computation_cost_);
+    }
+    origin_cost->communication_redis_forward_ = communication_time(
+      ALLGATHER_COMMUNICATION_CURVE, origin_cost->communication_redis_forward_, group_sizes.forward);
+    origin_cost->communication_redis_backward_ = communication_time(
+      ALLGATHER_COMMUNICATION_CURVE, origin_cost->communication_redis_backward_, group_sizes.backward);
+    origin_cost->communication_cost_ =
+      origin_cost->communication_redis_forward_ + origin_cost->communication_redis_backward_;
+    origin_cost->communication_without_parameter_ = origin_cost->communication_cost_;
+    origin_cost->communication_with_partial_para_ = origin_cost->communication_cost_;
+    return;
+  }
+  if (origin_cost->computation_cost_ > EPS) {
+    origin_cost->computation_cost_ = COST_MODEL_PROFILE->ComputationTime(cost_name, origin_cost->computation_cost_);
+  }
+  double backward = 0.0;
+  if (std::abs(origin_cost->communication_cost_ - origin_cost->communication_without_parameter_) > EPS) {
+    backward = communication_time(ALLREDUCE_COMMUNICATION_CURVE,
+                                  origin_cost->communication_cost_ - origin_cost->communication_without_parameter_,
+                                  group_sizes.backward);
+  }
+  origin_cost->communication_without_parameter_ = communication_time(
+    ALLREDUCE_COMMUNICATION_CURVE, origin_cost->communication_without_parameter_, group_sizes.forward);
+  if (origin_cost->communication_cost_ > EPS) {
+    origin_cost->communication_cost_ = origin_cost->communication_without_parameter_ + backward;
+  }
+  if (origin_cost->communication_with_partial_para_ > EPS) {
+    origin_cost->communication_with_partial_para_ =
+      origin_cost->communication_without_parameter_ + COST_MODEL_GAMMA * backward;
+  }
+}
+
+void RefineForPracticalCost(const CostPtr &origin_cost, bool is_redistribution, const std::string &cost_name,
+                            const CommGroupSizes &group_sizes) {
   MS_EXCEPTION_IF_NULL(origin_cost);
+  if (COST_MODEL_PROFILE != nullptr) {
+    RefineForProfiledCost(origin_cost, is_redistribution, cost_name, group_sizes);
+    return;
+  }
   if (is_redistribution) {
     // Redistribution cost
     if ((origin_cost->communication_redis_forward_ > EPS) &&
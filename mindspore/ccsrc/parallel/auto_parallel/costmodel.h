@@ -302,7 +302,15 @@ using FinalSingleDecisionPtr = std::shared_ptr<FinalSingleDecision>;
 void Simplify(CostPtrList *clist);
 void SimplifyForDecreasingCommunicationForward(CostPtrList *clist);
 void SimplifyForDecreasingCommunicationWithPartialPara(CostPtrList *clist);
-void RefineForPracticalCost(const CostPtr &, bool is_redistribution);
+// The group sizes of the collectives in the forward and the backward of a cost, 0 if unknown
+struct CommGroupSizes {
+  size_t forward = 0;
+  size_t backward = 0;
+};
+// With a cost profile, the costs in bytes are turned into the time in us by the curve of the cost model named
+// 'cost_name' and the curves of the collectives on the group sizes
+void RefineForPracticalCost(const CostPtr &, bool is_redistribution, const std::string &cost_name = "",
+                            const CommGroupSizes &group_sizes = CommGroupSizes());
 }  // namespace parallel
 }  // namespace mindspore
 
@@ -19,13 +19,87 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <sstream>
 #include <utility>
 #include "parallel/auto_parallel/costmodel.h"
 #include "parallel/auto_parallel/graph_costmodel.h"
 #include "parallel/tensor_layout/tensor_redistribution.h"
+#include "utils/convert_utils.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+// The devices whose slices of the 'from' layout are gathered into a slice of the 'to' layout, 0 if unknown
+size_t RedistributionGroupSize(const TensorLayout &from, const TensorLayout &to) {
+  Shape from_slice = from.slice_shape().array();
+  Shape to_slice = to.slice_shape().array();
+  if (from_slice.size() != to_slice.size()) {
+    return 0;
+  }
+  size_t group_size = 1;
+  for (size_t i = 0; i < from_slice.size(); ++i) {
+    if (from_slice[i] > 0 && to_slice[i] > from_slice[i]) {
+      group_size *= IntToSize(to_slice[i] / from_slice[i]);
+    }
+  }
+  return group_size > 1 ? group_size : 0;
+}
+}  // namespace
+
+RedistributionCostCache &RedistributionCostCache::GetInstance() {
+  static RedistributionCostCache instance;
+  return instance;
+}
+
+std::string RedistributionCostCache::Key(const TensorLayout &from, const TensorLayout &to, const RankList &dev_list) {
+  std::ostringstream buffer;
+  buffer << from.ToString() << std::endl << "to" << to.ToString() << std::endl << "devices =";
+  for (auto rank : dev_list) {
+    buffer << " " << rank;
+  }
+  return buffer.str();
+}
+
+bool RedistributionCostCache::Find(const std::string &key, RedistributionCost *cost) {
+  MS_EXCEPTION_IF_NULL(cost);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = costs_.find(key);
+  if (iter == costs_.end()) {
+    miss_count_++;
+    return false;
+  }
+  hit_count_++;
+  *cost = iter->second;
+  return true;
+}
+
+void RedistributionCostCache::Insert(const std::string &key, const RedistributionCost &cost) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  (void)costs_.emplace(key, cost);
+}
+
+void RedistributionCostCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  costs_.clear();
+  hit_count_ = 0;
+  miss_count_ = 0;
+}
+
+size_t RedistributionCostCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return costs_.size();
+}
+
+size_t RedistributionCostCache::hit_count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+
+size_t RedistributionCostCache::miss_count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return miss_count_;
+}
+
 Status Edge::InitEdgeCost() {
   bool has_available_cost = false;
   for (auto &swc : prev_op_->GetStrategyCost()) {
@@ -75,7 +149,9 @@ Status Edge::InitEdgeCost() {
                       << ", communication_without_parameter_: " << cost->communication_without_parameter_
                       << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
         // refine communication cost calculation for practice
-        RefineForPracticalCost(cost, true);
+        RefineForPracticalCost(cost, true, "",
+                               {RedistributionGroupSize(target_output_lyt, target_input_lyt),
+                                RedistributionGroupSize(target_input_lyt, target_output_lyt)});
         cost->communication_forward_ = cost->communication_redis_forward_;
         CostPtrKey ck = {target_output_str, target_input_str};
         CostPtrList cl;
@@ -105,22 +181,31 @@ Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, co
   MS_EXCEPTION_IF_NULL(prev_op_);
   MS_EXCEPTION_IF_NULL(cost);
   RankList dev_list = prev_op_->global_device_list();
-  TensorRedistribution tensor_redistribution(false);
+  auto &cache = RedistributionCostCache::GetInstance();
+  std::string key = RedistributionCostCache::Key(prev_op_output_layout, next_op_input_layout, dev_list);
+  RedistributionCost redis_cost;
+  if (!cache.Find(key, &redis_cost)) {
+    TensorRedistribution tensor_redistribution(false);
 
-  // Init TensorRedistribution
-  if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
-  }
+    // Init TensorRedistribution
+    if (tensor_redistribution.Init(prev_op_output_layout, next_op_input_layout, dev_list) == FAILED) {
+      MS_LOG(EXCEPTION) << "Failure: tensor_redistribution init failed.";
+    }
 
-  if (tensor_redistribution.ComputeCost() == FAILED) {
-    MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
+    if (tensor_redistribution.ComputeCost() == FAILED) {
+      MS_LOG(EXCEPTION) << "Failure: tensor_redistribution ComputeCost failed.";
+    }
+    redis_cost = {tensor_redistribution.comm_cost(), tensor_redistribution.forward_comm_cost(),
+                  tensor_redistribution.backward_comm_cost(), tensor_redistribution.computation_cost(),
+                  tensor_redistribution.memory_cost()};
+    cache.Insert(key, redis_cost);
   }
 
-  double comm_cost = tensor_redistribution.comm_cost();
-  double forward_comm_cost = tensor_redistribution.forward_comm_cost();
-  double backward_comm_cost = tensor_redistribution.backward_comm_cost();
-  double computation_cost = tensor_redistribution.computation_cost();
-  double mem_cost = tensor_redistribution.memory_cost();
+  double comm_cost = redis_cost.comm_cost;
+  double forward_comm_cost = redis_cost.forward_comm_cost;
+  double backward_comm_cost = redis_cost.backward_comm_cost;
+  double computation_cost = redis_cost.computation_cost;
+  double mem_cost = redis_cost.memory_cost;
 
   // Now AllGather, ReduceScatter, AlltoAll don't support bool type
   MS_EXCEPTION_IF_NULL(type);
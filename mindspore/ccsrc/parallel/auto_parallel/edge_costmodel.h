@@ -19,7 +19,9 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "common/utils.h"
@@ -34,6 +36,36 @@ using CostPtrKey = std::pair<StrategyPtr, StrategyPtr>;
 using OperatorInfoPtr = std::shared_ptr<mindspore::parallel::OperatorInfo>;
 using EdgePtr = std::shared_ptr<mindspore::parallel::Edge>;
 
+// The costs computed by TensorRedistribution, before they are scaled by the length of the data type
+struct RedistributionCost {
+  double comm_cost;
+  double forward_comm_cost;
+  double backward_comm_cost;
+  double computation_cost;
+  double memory_cost;
+};
+
+// The redistribution costs only depend on the two layouts and the device list, and many edges redistribute between
+// the same layouts, so they are computed once in a strategy search. It is shared by the edges initialized in parallel.
+class RedistributionCostCache {
+ public:
+  static RedistributionCostCache &GetInstance();
+  static std::string Key(const TensorLayout &from, const TensorLayout &to, const RankList &dev_list);
+  bool Find(const std::string &key, RedistributionCost *cost);
+  void Insert(const std::string &key, const RedistributionCost &cost);
+  void Clear();
+  size_t size();
+  size_t hit_count();
+  size_t miss_count();
+
+ private:
+  RedistributionCostCache() = default;
+  std::mutex mutex_;
+  std::unordered_map<std::string, RedistributionCost> costs_;
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+};
+
 class Edge {
   // An 'Edge' connects two Operators in the CostGraph.
  public:
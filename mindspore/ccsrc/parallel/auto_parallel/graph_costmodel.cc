@@ -41,6 +41,7 @@ bool FULLY_USE_DEVICES = DEFAULT_FULLY_USE_DEVICES;
 bool ELEMENTWISE_OP_STRA_FOLLOW = DEFAULT_ELEMENTWISE_OP_STRA_FOLLOW;
 bool MULTI_SUBGRAPHS = DEFAULT_IS_MULTI_SUBGRAPHS;
 int32_t RUN_PHASE = DEFAULT_RUN_PHASE;
+CostProfilePtr COST_MODEL_PROFILE = nullptr;
 constexpr char RESHAPEINFO[] = "ReshapeInfo";
 
 void CostGraph::SetDeviceMemoryAndCostParameter() {
@@ -71,6 +72,16 @@ void CostGraph::SetDeviceMemoryAndCostParameter() {
   costmodel_beta_ = beta;
   MS_LOG(INFO) << "costmodel_beta: " << costmodel_beta_ << ".";
 
+  // COST_MODEL_PROFILE
+  COST_MODEL_PROFILE = CostModelContext::GetInstance()->costmodel_profile();
+  if (COST_MODEL_PROFILE != nullptr) {
+    // Both the computation and the communication costs are the time in us
+    costmodel_alpha_ = 1.0;
+    costmodel_beta_ = 1.0;
+    MS_LOG(INFO) << "costmodel_profile: " << CostModelContext::GetInstance()->costmodel_profile_file()
+                 << ", costmodel_alpha and costmodel_beta are 1.";
+  }
+
   // COST_MODEL_GAMMA
   auto gamma = CostModelContext::GetInstance()->costmodel_gamma();
   if ((gamma < 0) || (gamma > 1)) {
@@ -24,6 +24,7 @@
 #include <vector>
 #include "../../common.h"
 #include "common/utils.h"
+#include "parallel/auto_parallel/cost_profile.h"
 #include "parallel/auto_parallel/edge_costmodel.h"
 #include "parallel/costmodel_context.h"
 #include "parallel/ops_info/operator_info.h"
@@ -65,6 +66,8 @@ extern bool FULLY_USE_DEVICES;
 extern bool ELEMENTWISE_OP_STRA_FOLLOW;
 extern bool MULTI_SUBGRAPHS;
 extern int32_t RUN_PHASE;
+// the profile the costs are turned into time by, nullptr for the analytic cost model
+extern CostProfilePtr COST_MODEL_PROFILE;
 
 class CostGraph {
   // 'CostGraph' consists of Operators and edges between them. An edge is created between two Operators if they have
@@ -109,6 +112,8 @@ class CostGraph {
     return edges_[{u_node, v_node}];
   }
   double GetDeviceMemory() const { return dev_memory_; }
+  double costmodel_alpha() const { return costmodel_alpha_; }
+  double costmodel_beta() const { return costmodel_beta_; }
 
   // Search the cost_list in the final graph, and determine the optimal one
   Status SearchStrategy();
@@ -18,6 +18,7 @@
 #define PARALLEL_AUTO_PARALLEL_OPERATOR_COSTMODEL_H_
 
 #include <memory>
+#include <string>
 #include <vector>
 #include "parallel/device_manager.h"
 #include "parallel/tensor_layout/tensor_info.h"
@@ -66,6 +67,8 @@ class OperatorCost {
     }
   }
   virtual ~OperatorCost() = default;
+  // the name of the curve of this cost model in the cost profile
+  virtual std::string name() const = 0;
 
   void set_is_parameter(const std::vector<bool> &is_parameter);
   void set_is_parameter_involve(const std::vector<bool> &);
@@ -121,6 +124,7 @@ class MatMulCost : public OperatorCost {
   explicit MatMulCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   MatMulCost() : OperatorCost(true) {}
   ~MatMulCost() override = default;
+  std::string name() const override { return "MatMulCost"; }
 
   // per device communication cost
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
@@ -149,6 +153,7 @@ class ActivationCost : public OperatorCost {
   explicit ActivationCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   ActivationCost() : OperatorCost(false) {}
   ~ActivationCost() override = default;
+  std::string name() const override { return "ActivationCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -176,6 +181,7 @@ class SoftmaxCost : public OperatorCost {
   explicit SoftmaxCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   SoftmaxCost() : OperatorCost(false) {}
   ~SoftmaxCost() override = default;
+  std::string name() const override { return "SoftmaxCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -201,6 +207,7 @@ class TmpIdentityCost : public OperatorCost {
   explicit TmpIdentityCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   TmpIdentityCost() : OperatorCost(false) {}
   ~TmpIdentityCost() override = default;
+  std::string name() const override { return "TmpIdentityCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -228,6 +235,7 @@ class BatchParallelCost : public OperatorCost {
   explicit BatchParallelCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   BatchParallelCost() : OperatorCost(false) {}
   ~BatchParallelCost() override = default;
+  std::string name() const override { return "BatchParallelCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -253,6 +261,7 @@ class VirtualDatasetCost : public OperatorCost {
   explicit VirtualDatasetCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   VirtualDatasetCost() : OperatorCost(false) {}
   ~VirtualDatasetCost() override = default;
+  std::string name() const override { return "VirtualDatasetCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -288,6 +297,7 @@ class GeneratorBaseCost : public OperatorCost {
   explicit GeneratorBaseCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   GeneratorBaseCost() : OperatorCost(false) {}
   ~GeneratorBaseCost() override = default;
+  std::string name() const override { return "GeneratorBaseCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -321,6 +331,7 @@ class PReLUCost : public OperatorCost {
   explicit PReLUCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   PReLUCost() : OperatorCost(true) {}
   ~PReLUCost() override = default;
+  std::string name() const override { return "PReLUCost"; }
 
   // per device communication cost
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
@@ -349,6 +360,7 @@ class OneHotCost : public OperatorCost {
   explicit OneHotCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   OneHotCost() : OperatorCost(true) {}
   ~OneHotCost() override = default;
+  std::string name() const override { return "OneHotCost"; }
 
   // per device communication cost
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
@@ -377,6 +389,7 @@ class SoftmaxCrossEntropyWithLogitsCost : public OperatorCost {
   explicit SoftmaxCrossEntropyWithLogitsCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   SoftmaxCrossEntropyWithLogitsCost() : OperatorCost(false) {}
   ~SoftmaxCrossEntropyWithLogitsCost() override = default;
+  std::string name() const override { return "SoftmaxCrossEntropyWithLogitsCost"; }
 
   // per device communication cost
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
@@ -406,6 +419,7 @@ class ReshapeCost : public OperatorCost {
   ReshapeCost() : OperatorCost(true) {}
 
   ~ReshapeCost() override = default;
+  std::string name() const override { return "ReshapeCost"; }
 
   // per device communication cost
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
@@ -438,6 +452,7 @@ class ArithmeticCost : public OperatorCost {
   explicit ArithmeticCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   ArithmeticCost() : OperatorCost(false) {}
   ~ArithmeticCost() override = default;
+  std::string name() const override { return "ArithmeticCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -466,6 +481,7 @@ class ReduceMethodCost : public OperatorCost {
   explicit ReduceMethodCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   ReduceMethodCost() : OperatorCost(true) {}
   ~ReduceMethodCost() override = default;
+  std::string name() const override { return "ReduceMethodCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -497,6 +513,7 @@ class ReduceMeanCost : public ReduceMethodCost {
   explicit ReduceMeanCost(bool is_inputs_related) : ReduceMethodCost(is_inputs_related) {}
   ReduceMeanCost() : ReduceMethodCost(true) {}
   ~ReduceMeanCost() override = default;
+  std::string name() const override { return "ReduceMeanCost"; }
 
   double GetForwardComputationCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                                    int32_t stage_id) const override;
@@ -508,6 +525,7 @@ class GetNextCost : public OperatorCost {
   explicit GetNextCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   GetNextCost() : OperatorCost(false) {}
   ~GetNextCost() override = default;
+  std::string name() const override { return "GetNextCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -541,6 +559,7 @@ class DropOutCost : public OperatorCost {
   explicit DropOutCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   DropOutCost() : OperatorCost(true) {}
   ~DropOutCost() override = default;
+  std::string name() const override { return "DropOutCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -571,6 +590,7 @@ class LayerNormCost : public OperatorCost {
   explicit LayerNormCost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   LayerNormCost() : OperatorCost(true) {}
   ~LayerNormCost() override = default;
+  std::string name() const override { return "LayerNormCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -599,6 +619,7 @@ class GatherV2Cost : public OperatorCost {
   explicit GatherV2Cost(bool is_inputs_related) : OperatorCost(is_inputs_related) {}
   GatherV2Cost() : OperatorCost(true) {}
   ~GatherV2Cost() override = default;
+  std::string name() const override { return "GatherV2Cost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -625,6 +646,7 @@ class GatherV2PCost : public OperatorCost {
   explicit GatherV2PCost(bool is_inputs_related) : OperatorCost(is_inputs_related), axis_(0) {}
   GatherV2PCost() : OperatorCost(true), axis_(0) {}
   ~GatherV2PCost() override = default;
+  std::string name() const override { return "GatherV2PCost"; }
 
   double GetCommCost(const std::vector<TensorInfo> &inputs, const std::vector<TensorInfo> &outputs,
                      int32_t stage_id) const override {
@@ -31,15 +31,11 @@ namespace parallel {
 #define DOUBLE_MAX (std::numeric_limits<double>::max)()
 
 // Compute redistributed cost
-double CostRedis(const Graph::NodeType &node,
-                 const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                 const std::vector<std::vector<float>> &mode, const Graph &graph) {
+double CostRedis(const Graph::NodeType &node, const NodeStrategies &node_strategies,
+                 const std::vector<std::vector<float>> &mode) {
   // Store value of cost redist
   double cost_redis = 0;
 
-  // Number of current strategies.
-  size_t num_strategy = node_name_to_strategy.size();
-
   // Number of node-in and node-out
   size_t num_node_in = node.node_in.size();
   size_t num_node_out = node.node_out.size();
@@ -55,68 +51,58 @@ double CostRedis(const Graph::NodeType &node,
                          node.tensor_parm.tensor_shape.shape_h * node.tensor_parm.tensor_str.str_h *
                          node.tensor_parm.tensor_shape.shape_w * node.tensor_parm.tensor_str.str_w;
 
-  // For each strategy candidate.
-  for (size_t i_strategy = 0; i_strategy < num_strategy; i_strategy++) {
-    // Find its forward nodes
-    for (size_t i_node = 0; i_node < num_node_in; i_node++) {
-      if (graph.nodes[node.node_in[i_node]].name == node_name_to_strategy[i_strategy].first) {
-        bool is_search_forward = true;
-        cost_redis +=
-          CostRedisWithAdjacentNode(node_name_to_strategy, mode, i_strategy, i_node, input_tensor, is_search_forward);
-      }
+  // Its forward nodes partitioned in this cut. The other neighbors are charged when they get their strategies.
+  for (size_t i_node = 0; i_node < num_node_in; i_node++) {
+    size_t node_id = node.node_in[i_node];
+    if (node_strategies.IsPartitioned(node_id)) {
+      bool is_search_forward = true;
+      cost_redis += CostRedisWithAdjacentNode(node_strategies.strategies[node_id], mode, i_node, input_tensor,
+                                              is_search_forward);
     }
+  }
 
-    // Find its backward nodes
-    for (size_t i_node = 0; i_node < num_node_out; i_node++) {
-      if (graph.nodes[node.node_out[i_node]].name == node_name_to_strategy[i_strategy].first) {
-        bool is_search_forward = false;
-        cost_redis +=
-          CostRedisWithAdjacentNode(node_name_to_strategy, mode, i_strategy, i_node, output_tensor, is_search_forward);
-      }
+  // Its backward nodes partitioned in this cut.
+  for (size_t i_node = 0; i_node < num_node_out; i_node++) {
+    size_t node_id = node.node_out[i_node];
+    if (node_strategies.IsPartitioned(node_id)) {
+      bool is_search_forward = false;
+      cost_redis += CostRedisWithAdjacentNode(node_strategies.strategies[node_id], mode, i_node, output_tensor,
+                                              is_search_forward);
     }
   }
 
   return cost_redis;
 }
 
-double CostRedisWithAdjacentNode(const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                                 const std::vector<std::vector<float>> &mode, size_t i_strategy, size_t i_node,
-                                 double tensor_size, bool search_forward) {
+double CostRedisWithAdjacentNode(const StrategyRec &adjacent_str, const std::vector<std::vector<float>> &mode,
+                                 size_t i_node, double tensor_size, bool search_forward) {
   double new_redis_cost = 0;
   int counter = 0;
 
   if (search_forward) {
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.outputTensor.str_n) !=
-        static_cast<int>(1 / mode[i_node][0])) {
+    if (static_cast<int>(1 / adjacent_str.outputTensor.str_n) != static_cast<int>(1 / mode[i_node][0])) {
       counter += 1;
     }
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.outputTensor.str_c) !=
-        static_cast<int>(1 / mode[i_node][1])) {
+    if (static_cast<int>(1 / adjacent_str.outputTensor.str_c) != static_cast<int>(1 / mode[i_node][1])) {
       counter += 1;
     }
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.outputTensor.str_h) !=
-        static_cast<int>(1 / mode[i_node][2])) {
+    if (static_cast<int>(1 / adjacent_str.outputTensor.str_h) != static_cast<int>(1 / mode[i_node][2])) {
       counter += 1;
     }
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.outputTensor.str_w) !=
-        static_cast<int>(1 / mode[i_node][3])) {
+    if (static_cast<int>(1 / adjacent_str.outputTensor.str_w) != static_cast<int>(1 / mode[i_node][3])) {
       counter += 1;
     }
   } else {
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.inputTensor[0].str_n) !=
-        static_cast<int>(1 / mode[2][0])) {
+    if (static_cast<int>(1 / adjacent_str.inputTensor[0].str_n) != static_cast<int>(1 / mode[2][0])) {
       counter += 1;
     }
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.inputTensor[0].str_c) !=
-        static_cast<int>(1 / mode[2][1])) {
+    if (static_cast<int>(1 / adjacent_str.inputTensor[0].str_c) != static_cast<int>(1 / mode[2][1])) {
       counter += 1;
     }
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.inputTensor[0].str_h) !=
-        static_cast<int>(1 / mode[2][2])) {
+    if (static_cast<int>(1 / adjacent_str.inputTensor[0].str_h) != static_cast<int>(1 / mode[2][2])) {
       counter += 1;
     }
-    if (static_cast<int>(1 / node_name_to_strategy[i_strategy].second.inputTensor[0].str_w) !=
-        static_cast<int>(1 / mode[2][3])) {
+    if (static_cast<int>(1 / adjacent_str.inputTensor[0].str_w) != static_cast<int>(1 / mode[2][3])) {
       counter += 1;
     }
   }
@@ -133,9 +119,7 @@ double CostRedisWithAdjacentNode(const std::vector<std::pair<std::string, Strate
 }
 
 // Get optimal strategy for MatMul
-StrategyRec CostMatMul::GetOptimalStr(const Graph::NodeType &node,
-                                      const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                                      const Graph &graph) {
+StrategyRec CostMatMul::GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies) {
   int edge_i =
     static_cast<int>(node.apply.arguments[0].tensor_shape.shape_h * node.apply.arguments[0].tensor_str.str_h);
   int edge_j =
@@ -149,25 +133,22 @@ StrategyRec CostMatMul::GetOptimalStr(const Graph::NodeType &node,
   if (edge_i < 2 || edge_i % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrConcatDimI(edge_j, edge_k) + CostRedis(node, node_name_to_strategy,
-                                                                mode = {{1, 1, 0.5, 1}, {1, 1, 1, 1}, {1, 1, 0.5, 1}},
-                                                                graph));
+    cost_op.push_back(StrConcatDimI(edge_j, edge_k) +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 0.5, 1}, {1, 1, 1, 1}, {1, 1, 0.5, 1}}));
   }
 
   if (edge_j < 2 || edge_j % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrConcatDimJ(edge_i, edge_k) + CostRedis(node, node_name_to_strategy,
-                                                                mode = {{1, 1, 1, 1}, {1, 1, 1, 0.5}, {1, 1, 1, 0.5}},
-                                                                graph));
+    cost_op.push_back(StrConcatDimJ(edge_i, edge_k) +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 1, 1}, {1, 1, 1, 0.5}, {1, 1, 1, 0.5}}));
   }
 
   if (edge_k < 2 || edge_k % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrReduceDimK(edge_i, edge_j) + CostRedis(node, node_name_to_strategy,
-                                                                mode = {{1, 1, 1, 0.5}, {1, 1, 0.5, 1}, {1, 1, 1, 1}},
-                                                                graph));
+    cost_op.push_back(StrReduceDimK(edge_i, edge_j) +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 1, 0.5}, {1, 1, 0.5, 1}, {1, 1, 1, 1}}));
   }
 
   return ChoseStr(cost_op, node.apply.str);
@@ -224,9 +205,8 @@ StrategyRec CostMatMul::ChoseStr(const std::vector<double> &cost_op, StrategyRec
 }
 
 // Get optimal strategy for Conv
-StrategyRec CostConvolution::GetOptimalStr(
-  const Graph::NodeType &node, const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-  const Graph &graph, bool channel_partition) {
+StrategyRec CostConvolution::GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies,
+                                           bool channel_partition) {
   const OperatorRec &op = node.apply;
 
   int input_tensor_h = static_cast<int>(op.arguments[0].tensor_shape.shape_h * op.arguments[0].tensor_str.str_h);
@@ -257,8 +237,8 @@ StrategyRec CostConvolution::GetOptimalStr(
   if (input_tensor_n < 2 || input_tensor_n % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrDimB(tensor_filter) + CostRedis(node, node_name_to_strategy,
-                                                         mode = {{0.5, 1, 1, 1}, {1, 1, 1, 1}, {0.5, 1, 1, 1}}, graph));
+    cost_op.push_back(StrDimB(tensor_filter) +
+                      CostRedis(node, node_strategies, mode = {{0.5, 1, 1, 1}, {1, 1, 1, 1}, {0.5, 1, 1, 1}}));
   }
 
   cost_op.push_back(DOUBLE_MAX);
@@ -267,8 +247,8 @@ StrategyRec CostConvolution::GetOptimalStr(
   if (channel_partition == false || tensor_filter < 2 || tensor_filter % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrDimK(tensor_in) + CostRedis(node, node_name_to_strategy,
-                                                     mode = {{1, 1, 1, 1}, {0.5, 1, 1, 1}, {1, 0.5, 1, 1}}, graph));
+    cost_op.push_back(StrDimK(tensor_in) +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 1, 1}, {0.5, 1, 1, 1}, {1, 0.5, 1, 1}}));
   }
 
   cost_op.push_back(DOUBLE_MAX);
@@ -277,8 +257,8 @@ StrategyRec CostConvolution::GetOptimalStr(
   if (channel_partition == false || tensor_filter_c < 2 || tensor_filter_c % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrDimQ(tensor_out) + CostRedis(node, node_name_to_strategy,
-                                                      mode = {{1, 0.5, 1, 1}, {1, 0.5, 1, 1}, {1, 1, 1, 1}}, graph));
+    cost_op.push_back(StrDimQ(tensor_out) +
+                      CostRedis(node, node_strategies, mode = {{1, 0.5, 1, 1}, {1, 0.5, 1, 1}, {1, 1, 1, 1}}));
   }
 
   return ChoseStr(cost_op, node.apply.str);
@@ -375,9 +355,7 @@ StrategyRec CostConvolution::ChoseStr(const std::vector<double> &cost_op, Strate
 }
 
 // Get optimal strategy for Pooling
-StrategyRec CostPooling::GetOptimalStr(const Graph::NodeType &node,
-                                       const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                                       const Graph &graph) {
+StrategyRec CostPooling::GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies) {
   int tensor_n = static_cast<int>(node.tensor_parm.tensor_shape.shape_n * node.tensor_parm.tensor_str.str_n);
   int tensor_c = static_cast<int>(node.tensor_parm.tensor_shape.shape_c * node.tensor_parm.tensor_str.str_c);
 
@@ -387,15 +365,15 @@ StrategyRec CostPooling::GetOptimalStr(const Graph::NodeType &node,
   if (tensor_n < 2 || tensor_n % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(cost_in_ + CostRedis(node, node_name_to_strategy,
-                                           mode = {{0.5, 1, 1, 1}, {0.5, 1, 1, 1}, {0.5, 1, 1, 1}}, graph));
+    cost_op.push_back(cost_in_ +
+                      CostRedis(node, node_strategies, mode = {{0.5, 1, 1, 1}, {0.5, 1, 1, 1}, {0.5, 1, 1, 1}}));
   }
 
   if (tensor_c < 2 || tensor_c % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(cost_in_ + CostRedis(node, node_name_to_strategy,
-                                           mode = {{1, 0.5, 1, 1}, {1, 0.5, 1, 1}, {1, 0.5, 1, 1}}, graph));
+    cost_op.push_back(cost_in_ +
+                      CostRedis(node, node_strategies, mode = {{1, 0.5, 1, 1}, {1, 0.5, 1, 1}, {1, 0.5, 1, 1}}));
   }
 
   cost_op.push_back(DOUBLE_MAX);
@@ -541,9 +519,7 @@ StrategyRec CostBiasAdd::ChoseStr(const std::vector<double> &cost_op, StrategyRe
 }
 
 // Get optimal strategy for Common OPs
-StrategyRec CostCommon::GetOptimalStr(const Graph::NodeType &node,
-                                      const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                                      const Graph &graph) {
+StrategyRec CostCommon::GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies) {
   const OperatorRec &op = node.apply;
   int tensor_n = static_cast<int>(op.arguments[0].tensor_shape.shape_n * op.arguments[0].tensor_str.str_n);
   int tensor_c = static_cast<int>(op.arguments[0].tensor_shape.shape_c * op.arguments[0].tensor_str.str_c);
@@ -556,29 +532,29 @@ StrategyRec CostCommon::GetOptimalStr(const Graph::NodeType &node,
   if (tensor_n < 2 || tensor_n % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(cost_in_ + CostRedis(node, node_name_to_strategy,
-                                           mode = {{0.5, 1, 1, 1}, {0.5, 1, 1, 1}, {0.5, 1, 1, 1}}, graph));
+    cost_op.push_back(cost_in_ +
+                      CostRedis(node, node_strategies, mode = {{0.5, 1, 1, 1}, {0.5, 1, 1, 1}, {0.5, 1, 1, 1}}));
   }
 
   if (tensor_c < 2 || tensor_c % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(cost_in_ + CostRedis(node, node_name_to_strategy,
-                                           mode = {{1, 0.5, 1, 1}, {1, 0.5, 1, 1}, {1, 0.5, 1, 1}}, graph));
+    cost_op.push_back(cost_in_ +
+                      CostRedis(node, node_strategies, mode = {{1, 0.5, 1, 1}, {1, 0.5, 1, 1}, {1, 0.5, 1, 1}}));
   }
 
   if (tensor_h < 2 || tensor_h % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(cost_in_ + CostRedis(node, node_name_to_strategy,
-                                           mode = {{1, 1, 0.5, 1}, {1, 1, 0.5, 1}, {1, 1, 0.5, 1}}, graph));
+    cost_op.push_back(cost_in_ +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 0.5, 1}, {1, 1, 0.5, 1}, {1, 1, 0.5, 1}}));
   }
 
   if (tensor_w < 2 || tensor_w % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(cost_in_ + CostRedis(node, node_name_to_strategy,
-                                           mode = {{1, 1, 1, 0.5}, {1, 1, 1, 0.5}, {1, 1, 1, 0.5}}, graph));
+    cost_op.push_back(cost_in_ +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 1, 0.5}, {1, 1, 1, 0.5}, {1, 1, 1, 0.5}}));
   }
 
   return ChoseStr(cost_op, node.apply.str);
@@ -643,9 +619,7 @@ double CostBatchNorm::GetMinCostIn(const OperatorRec &op) {
 }
 
 // Get optimal strategy for BN
-StrategyRec CostBatchNorm::GetOptimalStr(const Graph::NodeType &node,
-                                         const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                                         const Graph &graph) {
+StrategyRec CostBatchNorm::GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies) {
   const OperatorRec &op = node.apply;
 
   int tensor_filter_n = static_cast<int>(op.arguments[1].tensor_shape.shape_n * op.arguments[1].tensor_str.str_n);
@@ -665,8 +639,8 @@ StrategyRec CostBatchNorm::GetOptimalStr(const Graph::NodeType &node,
   if (output_tensor_n < 2 || output_tensor_n % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrDimB(tensor_filter) + CostRedis(node, node_name_to_strategy,
-                                                         mode = {{0.5, 1, 1, 1}, {1, 1, 1, 1}, {0.5, 1, 1, 1}}, graph));
+    cost_op.push_back(StrDimB(tensor_filter) +
+                      CostRedis(node, node_strategies, mode = {{0.5, 1, 1, 1}, {1, 1, 1, 1}, {0.5, 1, 1, 1}}));
   }
 
   cost_op.push_back(DOUBLE_MAX);
@@ -674,15 +648,15 @@ StrategyRec CostBatchNorm::GetOptimalStr(const Graph::NodeType &node,
   if (output_tensor_h < 2 || output_tensor_h % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrDimH(tensor_filter) + CostRedis(node, node_name_to_strategy,
-                                                         mode = {{1, 1, 0.5, 1}, {1, 1, 1, 1}, {1, 1, 0.5, 1}}, graph));
+    cost_op.push_back(StrDimH(tensor_filter) +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 0.5, 1}, {1, 1, 1, 1}, {1, 1, 0.5, 1}}));
   }
 
   if (output_tensor_w < 2 || output_tensor_w % 2 != 0) {
     cost_op.push_back(DOUBLE_MAX);
   } else {
-    cost_op.push_back(StrDimW(tensor_filter) + CostRedis(node, node_name_to_strategy,
-                                                         mode = {{1, 1, 1, 0.5}, {1, 1, 1, 1}, {1, 1, 1, 0.5}}, graph));
+    cost_op.push_back(StrDimW(tensor_filter) +
+                      CostRedis(node, node_strategies, mode = {{1, 1, 1, 0.5}, {1, 1, 1, 1}, {1, 1, 1, 0.5}}));
   }
 
   return ChoseStr(cost_op, node.apply.str);
@@ -17,6 +17,7 @@
 #ifndef PARALLEL_AUTO_PARALLEL_REC_COST_H_
 #define PARALLEL_AUTO_PARALLEL_REC_COST_H_
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -28,20 +29,36 @@
 
 namespace mindspore {
 namespace parallel {
-double CostRedis(const Graph::NodeType &node,
-                 const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                 const std::vector<std::vector<float>> &mode, const Graph &graph);
+// The strategies decided in the current cut, indexed by the node ids, i.e. the positions of the nodes in
+// Graph::nodes. Each node is partitioned once per cut, so the redistribution cost of a candidate only reads the
+// entries of its own neighbors.
+struct NodeStrategies {
+  NodeStrategies() = default;
+  explicit NodeStrategies(size_t num_node) : strategies(num_node), partitioned(num_node, false) {}
+
+  void Reset() { std::fill(partitioned.begin(), partitioned.end(), false); }
+
+  void Set(size_t node_id, const StrategyRec &str) {
+    strategies[node_id] = str;
+    partitioned[node_id] = true;
+  }
+
+  bool IsPartitioned(size_t node_id) const { return node_id < partitioned.size() && partitioned[node_id]; }
+
+  std::vector<StrategyRec> strategies;
+  std::vector<bool> partitioned;
+};
+
+double CostRedis(const Graph::NodeType &node, const NodeStrategies &node_strategies,
+                 const std::vector<std::vector<float>> &mode);
 
-double CostRedisWithAdjacentNode(const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                                 const std::vector<std::vector<float>> &mode, size_t i_strategy, size_t i_node,
-                                 double tensor_size, bool is_search_forward);
+double CostRedisWithAdjacentNode(const StrategyRec &adjacent_str, const std::vector<std::vector<float>> &mode,
+                                 size_t i_node, double tensor_size, bool is_search_forward);
 
 // class CostMatMul is used to compute the cost of MatMul operator.
 class CostMatMul {
  public:
-  StrategyRec GetOptimalStr(const Graph::NodeType &node,
-                            const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                            const Graph &graph);
+  StrategyRec GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies);
 
   double GetMinCostIn(const OperatorRec &op);
 
@@ -76,9 +93,8 @@ class CostMatMul {
 // class CostConvolution is used to compute the cost of Conv operator.
 class CostConvolution {
  public:
-  StrategyRec GetOptimalStr(const Graph::NodeType &node,
-                            const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                            const Graph &graph, bool channel_partition);
+  StrategyRec GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies,
+                            bool channel_partition);
 
   double GetMinCostIn(const Graph::NodeType &node);
 
@@ -145,9 +161,7 @@ class CostConvolution {
 // class CostPooling is used to compute the cost of Pooling operator.
 class CostPooling {
  public:
-  StrategyRec GetOptimalStr(const Graph::NodeType &node,
-                            const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                            const Graph &graph);
+  StrategyRec GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies);
 
   double GetMinCostIn() const { return cost_in_; }
 
@@ -173,9 +187,7 @@ class CostReshape {
 // class CostCommon is used to compute the cost of an element-wise operator
 class CostCommon {
  public:
-  virtual StrategyRec GetOptimalStr(const Graph::NodeType &node,
-                                    const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                                    const Graph &graph);
+  virtual StrategyRec GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies);
 
   virtual double GetMinCostIn() const { return cost_in_; }
 
@@ -209,9 +221,7 @@ class CostCast : public CostCommon {};
 // class BatchNorm is used to compute the cost of BatchNorm operator.
 class CostBatchNorm {
  public:
-  StrategyRec GetOptimalStr(const Graph::NodeType &node,
-                            const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
-                            const Graph &graph);
+  StrategyRec GetOptimalStr(const Graph::NodeType &node, const NodeStrategies &node_strategies);
 
   double GetMinCostIn(const OperatorRec &op);
 
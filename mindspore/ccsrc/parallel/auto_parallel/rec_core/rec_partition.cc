@@ -35,54 +35,54 @@ double GetWeights(const Graph::NodeType &node) {
 
   if (op.op_type == OperatorType::kRecMatMul) {
     // For MatMul
-    auto cost_ptr = std::make_shared<CostMatMul>();
+    CostMatMul cost;
 
-    return cost_ptr->GetMinCostIn(op);
+    return cost.GetMinCostIn(op);
   } else if (op.op_type == OperatorType::kRecConvolution) {
     // For Convolution
-    auto cost_ptr = std::make_shared<CostConvolution>();
+    CostConvolution cost;
 
-    return cost_ptr->GetMinCostIn(node);
+    return cost.GetMinCostIn(node);
   } else if (op.op_type == OperatorType::kRecPooling) {
     // For Pooling
-    auto cost_ptr = std::make_shared<CostPooling>();
+    CostPooling cost;
 
-    return cost_ptr->GetMinCostIn();
+    return cost.GetMinCostIn();
   } else if (op.op_type == OperatorType::kRecElmWiseOp) {
     // For TensorAdd
-    auto cost_ptr = std::make_shared<CostTensorAdd>();
+    CostTensorAdd cost;
 
-    return cost_ptr->GetMinCostIn();
+    return cost.GetMinCostIn();
   } else if (op.op_type == OperatorType::kRecReLU || op.op_type == OperatorType::kRecSoftmax ||
              op.op_type == OperatorType::kRecSparseSoftmaxCrossEntropyWithLogits) {
     // For Activation and Softmax
-    auto cost_ptr = std::make_shared<CostCommon>();
+    CostCommon cost;
 
-    return cost_ptr->GetMinCostIn();
+    return cost.GetMinCostIn();
   } else if (op.op_type == OperatorType::kRecReshape) {
     // For Reshape
-    auto cost_ptr = std::make_shared<CostReshape>();
+    CostReshape cost;
 
-    return cost_ptr->GetMinCostIn();
+    return cost.GetMinCostIn();
   } else if (op.op_type == OperatorType::kRecBiasAdd) {
     // For BiasAdd
-    auto cost_ptr = std::make_shared<CostBiasAdd>();
+    CostBiasAdd cost;
 
-    return cost_ptr->GetMinCostIn();
+    return cost.GetMinCostIn();
   } else if (op.op_type == OperatorType::kRecBatchNorm) {
     // For BatchNorm
-    auto cost_ptr = std::make_shared<CostBatchNorm>();
+    CostBatchNorm cost;
 
-    return cost_ptr->GetMinCostIn(op);
+    return cost.GetMinCostIn(op);
   } else if (op.op_type == OperatorType::kRecOneHot || op.op_type == OperatorType::kRecLog ||
              op.op_type == OperatorType::kRecExp || op.op_type == OperatorType::kRecAdd ||
              op.op_type == OperatorType::kRecSub || op.op_type == OperatorType::kRecMul ||
              op.op_type == OperatorType::kRecDiv || op.op_type == OperatorType::kRecSqueeze ||
              op.op_type == OperatorType::kRecCast) {
     // For element-wise op
-    auto cost_ptr = std::make_shared<CostCommon>();
+    CostCommon cost;
 
-    return cost_ptr->GetMinCostIn();
+    return cost.GetMinCostIn();
   } else if (op.op_type == OperatorType::kRecUnkownType) {
     // For unknown type
     return 0.0;
@@ -97,6 +97,8 @@ std::vector<size_t> SortByWeight(const std::shared_ptr<Graph> graph) {
 
   std::vector<std::pair<double, size_t>> weight_to_node_index;
   std::vector<size_t> node_index_by_weights;
+  weight_to_node_index.reserve(graph->nodes.size());
+  node_index_by_weights.reserve(graph->nodes.size());
 
   // Get node's weight.
   for (size_t i = 0; i < graph->nodes.size(); i++) {
@@ -121,62 +123,61 @@ std::vector<size_t> SortByWeight(const std::shared_ptr<Graph> graph) {
 }
 
 // Get optimal strategy to partition the target node
-StrategyRec PartitionNode(const Graph::NodeType &node,
-                          const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
+StrategyRec PartitionNode(const Graph::NodeType &node, const NodeStrategies &node_strategies,
                           std::shared_ptr<Graph> graph) {
   bool enable_conv_chw_partition = false;
   MS_EXCEPTION_IF_NULL(graph);
 
   if (node.apply.op_type == OperatorType::kRecMatMul) {
     // For MatMul
-    auto cost_ptr = std::make_shared<CostMatMul>();
+    CostMatMul cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph);
+    return cost.GetOptimalStr(node, node_strategies);
   } else if (node.apply.op_type == OperatorType::kRecConvolution) {
     // For Convolution
-    auto cost_ptr = std::make_shared<CostConvolution>();
+    CostConvolution cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph, enable_conv_chw_partition);
+    return cost.GetOptimalStr(node, node_strategies, enable_conv_chw_partition);
   } else if (node.apply.op_type == OperatorType::kRecPooling) {
     // For Pooling
-    auto cost_ptr = std::make_shared<CostPooling>();
+    CostPooling cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph);
+    return cost.GetOptimalStr(node, node_strategies);
   } else if (node.apply.op_type == OperatorType::kRecElmWiseOp) {
     // For TensorAdd
-    auto cost_ptr = std::make_shared<CostTensorAdd>();
+    CostTensorAdd cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph);
+    return cost.GetOptimalStr(node, node_strategies);
   } else if (node.apply.op_type == OperatorType::kRecReLU || node.apply.op_type == OperatorType::kRecSoftmax ||
              node.apply.op_type == OperatorType::kRecSparseSoftmaxCrossEntropyWithLogits) {
     // For Softmax & Activation
-    auto cost_ptr = std::make_shared<CostCommon>();
+    CostCommon cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph);
+    return cost.GetOptimalStr(node, node_strategies);
   } else if (node.apply.op_type == OperatorType::kRecReshape) {
     // For Reshape
-    auto cost_ptr = std::make_shared<CostReshape>();
+    CostReshape cost;
 
-    return cost_ptr->GetOptimalStr(node);
+    return cost.GetOptimalStr(node);
   } else if (node.apply.op_type == OperatorType::kRecBiasAdd) {
     // For BiasAdd
-    auto cost_ptr = std::make_shared<CostBiasAdd>();
+    CostBiasAdd cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph);
+    return cost.GetOptimalStr(node, node_strategies);
   } else if (node.apply.op_type == OperatorType::kRecBatchNorm) {
     // For BatchNorm
-    auto cost_ptr = std::make_shared<CostBatchNorm>();
+    CostBatchNorm cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph);
+    return cost.GetOptimalStr(node, node_strategies);
   } else if (node.apply.op_type == OperatorType::kRecOneHot || node.apply.op_type == OperatorType::kRecLog ||
              node.apply.op_type == OperatorType::kRecExp || node.apply.op_type == OperatorType::kRecAdd ||
              node.apply.op_type == OperatorType::kRecSub || node.apply.op_type == OperatorType::kRecMul ||
              node.apply.op_type == OperatorType::kRecDiv || node.apply.op_type == OperatorType::kRecSqueeze ||
              node.apply.op_type == OperatorType::kRecCast) {
     // For element-wise op
-    auto cost_ptr = std::make_shared<CostCommon>();
+    CostCommon cost;
 
-    return cost_ptr->GetOptimalStr(node, node_name_to_strategy, *graph);
+    return cost.GetOptimalStr(node, node_strategies);
   } else if (node.apply.op_type == OperatorType::kRecUnkownType) {
     // For unknown type
     StrategyRec default_strategy;
@@ -201,6 +202,9 @@ Status PartitionForAllDevices(const size_t num_device, const double device_memor
   // Comopute iter times
   int iter_times = static_cast<int>(log2(num_device));
 
+  // The strategies of the nodes partitioned in the current cut, indexed by the node ids.
+  NodeStrategies node_strategies(graph->nodes.size());
+
   // N-cuts loop
   for (int loop = 0; loop < iter_times; loop++) {
     // Sort by weights
@@ -209,8 +213,8 @@ Status PartitionForAllDevices(const size_t num_device, const double device_memor
     // get total node number
     size_t iter_nodes = reorder_node_list.size();
 
-    // temp vector to map nodename to its strategy.
-    std::vector<std::pair<std::string, StrategyRec>> node_name_to_strategy;
+    // No node is partitioned yet in this cut.
+    node_strategies.Reset();
 
     // Loop for all the nodes
     for (size_t i_node = 0; i_node < iter_nodes; i_node++) {
@@ -220,15 +224,13 @@ Status PartitionForAllDevices(const size_t num_device, const double device_memor
       Graph::NodeType &node_ptr = graph->nodes[index];
 
       // Serch optimal strategy to cut this operator. And store the result optimal strategy in graph.
-      graph->nodes[index].apply.str = PartitionNode(node_ptr, node_name_to_strategy, graph);
+      node_ptr.apply.str = PartitionNode(node_ptr, node_strategies, graph);
 
       // Apply OP Strategy to Tensor Strategy.
-      graph->nodes[index] = ApplyStrToTensor(node_ptr);
+      ApplyStrToTensor(&node_ptr);
 
-      // Note down the node name and its strategy in this loop.
-      auto node_name_to_str =
-        std::pair<std::string, StrategyRec>(graph->nodes[index].name, graph->nodes[index].apply.str);
-      node_name_to_strategy.push_back(node_name_to_str);
+      // Note down the strategy of the node in this loop.
+      node_strategies.Set(index, node_ptr.apply.str);
     }
   }
 
@@ -241,20 +243,26 @@ Status PartitionForAllDevices(const size_t num_device, const double device_memor
 
 // Apply OP Strategy to Tensor Strategy
 Graph::NodeType ApplyStrToTensor(Graph::NodeType Node) {
+  ApplyStrToTensor(&Node);
+  return Node;
+}
+
+// Apply OP Strategy to Tensor Strategy of the node in the graph
+void ApplyStrToTensor(Graph::NodeType *node) {
+  MS_EXCEPTION_IF_NULL(node);
   // Set Node's tensor_parm
-  Node.tensor_parm.tensor_str.str_n = Node.apply.str.outputTensor.str_n;
-  Node.tensor_parm.tensor_str.str_c = Node.apply.str.outputTensor.str_c;
-  Node.tensor_parm.tensor_str.str_h = Node.apply.str.outputTensor.str_h;
-  Node.tensor_parm.tensor_str.str_w = Node.apply.str.outputTensor.str_w;
+  node->tensor_parm.tensor_str.str_n = node->apply.str.outputTensor.str_n;
+  node->tensor_parm.tensor_str.str_c = node->apply.str.outputTensor.str_c;
+  node->tensor_parm.tensor_str.str_h = node->apply.str.outputTensor.str_h;
+  node->tensor_parm.tensor_str.str_w = node->apply.str.outputTensor.str_w;
 
   // Set input tensors' tersor_parm
   for (int i = 0; i < 2; i++) {
-    Node.apply.arguments[i].tensor_str.str_n = Node.apply.str.inputTensor[i].str_n;
-    Node.apply.arguments[i].tensor_str.str_c = Node.apply.str.inputTensor[i].str_c;
-    Node.apply.arguments[i].tensor_str.str_h = Node.apply.str.inputTensor[i].str_h;
-    Node.apply.arguments[i].tensor_str.str_w = Node.apply.str.inputTensor[i].str_w;
+    node->apply.arguments[i].tensor_str.str_n = node->apply.str.inputTensor[i].str_n;
+    node->apply.arguments[i].tensor_str.str_c = node->apply.str.inputTensor[i].str_c;
+    node->apply.arguments[i].tensor_str.str_h = node->apply.str.inputTensor[i].str_h;
+    node->apply.arguments[i].tensor_str.str_w = node->apply.str.inputTensor[i].str_w;
   }
-  return Node;
 }
 
 Status DevicesMemoryControl(const double device_memory, std::shared_ptr<Graph> graph) {
@@ -36,14 +36,15 @@ std::vector<size_t> SortByWeight(const std::shared_ptr<Graph> graph);
 
 double GetWeights(const Graph::NodeType &node);
 
-StrategyRec PartitionNode(const Graph::NodeType &node,
-                          const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
+StrategyRec PartitionNode(const Graph::NodeType &node, const NodeStrategies &node_strategies,
                           std::shared_ptr<Graph> graph);
 
 Status PartitionForAllDevices(const size_t num_device, const double device_memory, std::shared_ptr<Graph> graph);
 
 Graph::NodeType ApplyStrToTensor(Graph::NodeType Node);
 
+void ApplyStrToTensor(Graph::NodeType *node);
+
 Status DevicesMemoryControl(const double device_memory, std::shared_ptr<Graph> graph);
 
 size_t GetDataTypeSize(const TensorType &type);
@@ -59,8 +59,11 @@ void ParallelContext::Reset() {
   parameter_broadcast_ = false;
   parameter_broadcast_is_set_ = false;
   enable_all_reduce_fusion_ = false;
+  enable_parallel_optimizer_ = false;
   strategy_ckpt_load_file_ = "";
   strategy_ckpt_save_file_ = "";
+  pipeline_stages_ = 1;
+  micro_batch_num_ = 1;
 }
 
 void ParallelContext::set_device_num(int32_t device_num) {
@@ -116,6 +119,20 @@ void ParallelContext::set_strategy_ckpt_save_file(const std::string &strategy_ck
   strategy_ckpt_save_file_ = strategy_ckpt_save_file;
 }
 
+void ParallelContext::set_pipeline_stages(int32_t pipeline_stages) {
+  if (pipeline_stages <= 0) {
+    MS_LOG(EXCEPTION) << "The pipeline stages must be positive, but got " << pipeline_stages;
+  }
+  pipeline_stages_ = pipeline_stages;
+}
+
+void ParallelContext::set_micro_batch_num(int32_t micro_batch_num) {
+  if (micro_batch_num <= 0) {
+    MS_LOG(EXCEPTION) << "The micro batch num must be positive, but got " << micro_batch_num;
+  }
+  micro_batch_num_ = micro_batch_num;
+}
+
 void ParallelContext::SetAllReduceFusionSplitIndices(const std::vector<uint32_t> indices, const std::string &group) {
   all_reduce_fusion_split_indices_[group] = indices;
 }
@@ -91,11 +91,21 @@ class ParallelContext {
   }
   bool enable_all_reduce_fusion() const { return enable_all_reduce_fusion_; }
 
+  void set_enable_parallel_optimizer(bool enable_parallel_optimizer) {
+    enable_parallel_optimizer_ = enable_parallel_optimizer;
+  }
+  bool enable_parallel_optimizer() const { return enable_parallel_optimizer_; }
+
   void set_strategy_ckpt_load_file(const std::string &strategy_ckpt_load_file);
   std::string strategy_ckpt_load_file() const { return strategy_ckpt_load_file_; }
   void set_strategy_ckpt_save_file(const std::string &strategy_ckpt_save_file);
   std::string strategy_ckpt_save_file() const { return strategy_ckpt_save_file_; }
 
+  void set_pipeline_stages(int32_t pipeline_stages);
+  int32_t pipeline_stages() const { return pipeline_stages_; }
+  void set_micro_batch_num(int32_t micro_batch_num);
+  int32_t micro_batch_num() const { return micro_batch_num_; }
+
   void Reset();
 
  private:
@@ -114,10 +124,13 @@ class ParallelContext {
   bool global_rank_is_set_;
   bool parameter_broadcast_is_set_;
   bool enable_all_reduce_fusion_;
+  bool enable_parallel_optimizer_;
   std::map<std::string, std::vector<uint32_t>> all_reduce_fusion_split_indices_;
   std::map<std::string, std::vector<uint32_t>> all_reduce_fusion_split_sizes_;
   std::string strategy_ckpt_load_file_;
   std::string strategy_ckpt_save_file_;
+  int32_t pipeline_stages_;
+  int32_t micro_batch_num_;
 };
 
 void ParallelParameterContextInit(const FuncGraphPtr &func_graph);
@@ -19,7 +19,9 @@
 #include <memory>
 
 #include "parallel/allreduce_fusion/allreduce_fusion.h"
+#include "parallel/allreduce_fusion/gradient_compression.h"
 #include "parallel/auto_parallel/graph_costmodel.h"
+#include "parallel/optimizer_shard/optimizer_shard.h"
 
 namespace mindspore {
 namespace parallel {
@@ -46,6 +48,8 @@ void CostModelContext::ResetCostModel() {
   costmodel_communi_threshold_ = DEFAULT_COST_MODEL_COMMUNI_THRESHOLD;
   costmodel_communi_const_ = DEFAULT_COST_MODEL_COMMUNI_CONST;
   costmodel_communi_bias_ = DEFAULT_COST_MODEL_COMMUNI_BIAS;
+  costmodel_profile_file_ = "";
+  costmodel_profile_ = nullptr;
   is_multi_subgraphs_ = DEFAULT_IS_MULTI_SUBGRAPHS;
   run_phase_ = DEFAULT_RUN_PHASE;
   costmodel_allreduce_fusion_algorithm_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALGORITHM;
@@ -56,6 +60,13 @@ void CostModelContext::ResetCostModel() {
   costmodel_allreduce_fusion_allreduce_bandwidth_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_BANDWIDTH;
   costmodel_allreduce_fusion_computation_time_parameter_ =
     DEFAULT_COST_MODEL_ALLREDUCE_FUSION_COMPUTATION_TIME_PARAMETER;
+  costmodel_allreduce_fusion_backward_profile_file_ = "";
+  costmodel_allreduce_fusion_bucket_bytes_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_BUCKET_BYTES;
+  costmodel_gradient_compression_ = DEFAULT_COST_MODEL_GRADIENT_COMPRESSION;
+  costmodel_gradient_compression_topk_ratio_ = DEFAULT_COST_MODEL_GRADIENT_COMPRESSION_TOPK_RATIO;
+  costmodel_gradient_compression_powersgd_rank_ = DEFAULT_COST_MODEL_GRADIENT_COMPRESSION_POWERSGD_RANK;
+  costmodel_gradient_compression_element_time_ = DEFAULT_COST_MODEL_GRADIENT_COMPRESSION_ELEMENT_TIME;
+  costmodel_optimizer_shard_memory_ = DEFAULT_COST_MODEL_OPTIMIZER_SHARD_MEMORY;
 }
 
 void CostModelContext::ResetAlgoParameters() {
@@ -86,6 +97,30 @@ void CostModelContext::set_costmodel_communi_const(double cm_communi_const) {
 
 void CostModelContext::set_costmodel_communi_bias(double cm_communi_bias) { costmodel_communi_bias_ = cm_communi_bias; }
 
+void CostModelContext::set_costmodel_profile_file(const std::string &profile_file) {
+  if (profile_file.empty()) {
+    costmodel_profile_file_ = "";
+    costmodel_profile_ = nullptr;
+    return;
+  }
+  auto profile = std::make_shared<CostProfile>();
+  if (profile->Load(profile_file) != SUCCESS) {
+    MS_LOG(EXCEPTION) << "Load cost model profile " << profile_file << " failed.";
+  }
+  costmodel_profile_file_ = profile_file;
+  costmodel_profile_ = profile;
+}
+
+void CostModelContext::CalibrateCostModelProfile(const std::string &profile_file) {
+  auto profile = CostProfile::Calibrate();
+  MS_EXCEPTION_IF_NULL(profile);
+  if (profile->Save(profile_file) != SUCCESS) {
+    MS_LOG(EXCEPTION) << "Save cost model profile " << profile_file << " failed.";
+  }
+  costmodel_profile_file_ = profile_file;
+  costmodel_profile_ = profile;
+}
+
 void CostModelContext::set_multi_subgraphs(bool multi_graphs) { is_multi_subgraphs_ = multi_graphs; }
 void CostModelContext::set_costmodel_allreduce_fusion_algorithm(int32_t algorithm) {
   costmodel_allreduce_fusion_algorithm_ = algorithm;
@@ -115,6 +150,49 @@ void CostModelContext::set_costmodel_allreduce_fusion_computation_time_parameter
   costmodel_allreduce_fusion_computation_time_parameter_ = computation_time_parameter;
 }
 
+void CostModelContext::set_costmodel_allreduce_fusion_backward_profile_file(const std::string &profile_file) {
+  costmodel_allreduce_fusion_backward_profile_file_ = profile_file;
+}
+
+void CostModelContext::set_costmodel_allreduce_fusion_bucket_bytes(double bucket_bytes) {
+  costmodel_allreduce_fusion_bucket_bytes_ = bucket_bytes;
+}
+
+void CostModelContext::set_costmodel_gradient_compression(const std::string &compression) {
+  GradientCompression method = kCompressionNone;
+  if (!GetGradientCompression(compression, &method)) {
+    MS_LOG(EXCEPTION) << "The gradient compression " << compression
+                      << " is not supported, it should be 'none', 'fp16', 'topk' or 'powersgd'";
+  }
+  costmodel_gradient_compression_ = compression;
+}
+
+void CostModelContext::set_costmodel_gradient_compression_topk_ratio(double topk_ratio) {
+  if (topk_ratio <= 0 || topk_ratio >= 1) {
+    MS_LOG(EXCEPTION) << "The top-k ratio of the gradient compression should be in (0, 1), but got " << topk_ratio;
+  }
+  costmodel_gradient_compression_topk_ratio_ = topk_ratio;
+}
+
+void CostModelContext::set_costmodel_gradient_compression_powersgd_rank(int32_t powersgd_rank) {
+  if (powersgd_rank < 1) {
+    MS_LOG(EXCEPTION) << "The PowerSGD rank of the gradient compression should be positive, but got "
+                      << powersgd_rank;
+  }
+  costmodel_gradient_compression_powersgd_rank_ = powersgd_rank;
+}
+
+void CostModelContext::set_costmodel_gradient_compression_element_time(double element_time) {
+  costmodel_gradient_compression_element_time_ = element_time;
+}
+
+void CostModelContext::set_costmodel_optimizer_shard_memory(double shard_memory) {
+  if (shard_memory < 0) {
+    MS_LOG(EXCEPTION) << "The optimizer shard memory should not be negative, but got " << shard_memory;
+  }
+  costmodel_optimizer_shard_memory_ = shard_memory;
+}
+
 void CostModelContext::set_tensor_slice_alignment_enable(bool ts_align) { tensor_slice_alignment_enable_ = ts_align; }
 
 void CostModelContext::set_tensor_slice_alignment_size(size_t ts_align_size) {
@@ -21,6 +21,7 @@
 #include <string>
 #include <vector>
 
+#include "parallel/auto_parallel/cost_profile.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -67,6 +68,13 @@ class CostModelContext {
   void set_costmodel_communi_bias(double);
   double costmodel_communi_bias() const { return costmodel_communi_bias_; }
 
+  // COST_MODEL_PROFILE, the profile is loaded when it is set, an empty file turns it off
+  void set_costmodel_profile_file(const std::string &);
+  std::string costmodel_profile_file() const { return costmodel_profile_file_; }
+  CostProfilePtr costmodel_profile() const { return costmodel_profile_; }
+  // Measure the cost models on the host, save the profile to the file and use it
+  void CalibrateCostModelProfile(const std::string &);
+
   void set_multi_subgraphs(bool);
   bool is_multi_subgraphs() const { return is_multi_subgraphs_; }
 
@@ -97,6 +105,36 @@ class CostModelContext {
     return costmodel_allreduce_fusion_computation_time_parameter_;
   }
 
+  void set_costmodel_allreduce_fusion_backward_profile_file(const std::string &);
+  std::string costmodel_allreduce_fusion_backward_profile_file() const {
+    return costmodel_allreduce_fusion_backward_profile_file_;
+  }
+
+  void set_costmodel_allreduce_fusion_bucket_bytes(double);
+  double costmodel_allreduce_fusion_bucket_bytes() const { return costmodel_allreduce_fusion_bucket_bytes_; }
+
+  // COST_MODEL_GRADIENT_COMPRESSION, "none", "fp16", "topk" or "powersgd"
+  void set_costmodel_gradient_compression(const std::string &);
+  std::string costmodel_gradient_compression() const { return costmodel_gradient_compression_; }
+
+  void set_costmodel_gradient_compression_topk_ratio(double);
+  double costmodel_gradient_compression_topk_ratio() const { return costmodel_gradient_compression_topk_ratio_; }
+
+  void set_costmodel_gradient_compression_powersgd_rank(int32_t);
+  int32_t costmodel_gradient_compression_powersgd_rank() const {
+    return costmodel_gradient_compression_powersgd_rank_;
+  }
+
+  void set_costmodel_gradient_compression_element_time(double);
+  double costmodel_gradient_compression_element_time() const {
+    return costmodel_gradient_compression_element_time_;
+  }
+
+  // COST_MODEL_OPTIMIZER_SHARD_MEMORY, the bytes of the parameters and optimizer states a device keeps when the
+  // optimizer is sharded, 0 for sharding all the parameters that can be sharded
+  void set_costmodel_optimizer_shard_memory(double);
+  double costmodel_optimizer_shard_memory() const { return costmodel_optimizer_shard_memory_; }
+
   // TENSOR_SLICE_ALIGNMENT_ENABLE
   void set_tensor_slice_alignment_enable(bool);
   bool tensor_slice_alignment_enable() const { return tensor_slice_alignment_enable_; }
@@ -144,6 +182,10 @@ class CostModelContext {
   // COST_MODEL_COMMUNI_BIAS
   double costmodel_communi_bias_;
 
+  // COST_MODEL_PROFILE
+  std::string costmodel_profile_file_;
+  CostProfilePtr costmodel_profile_;
+
   // MULTI_SUBGRAPHS
   bool is_multi_subgraphs_;
 
@@ -163,6 +205,22 @@ class CostModelContext {
 
   double costmodel_allreduce_fusion_computation_time_parameter_;
 
+  std::string costmodel_allreduce_fusion_backward_profile_file_;
+
+  double costmodel_allreduce_fusion_bucket_bytes_;
+
+  // COST_MODEL_GRADIENT_COMPRESSION
+  std::string costmodel_gradient_compression_;
+
+  double costmodel_gradient_compression_topk_ratio_;
+
+  int32_t costmodel_gradient_compression_powersgd_rank_;
+
+  double costmodel_gradient_compression_element_time_;
+
+  // COST_MODEL_OPTIMIZER_SHARD_MEMORY
+  double costmodel_optimizer_shard_memory_;
+
   // TENSOR_SLICE_ALIGNMENT_ENABLE
   bool tensor_slice_alignment_enable_;
 
@@ -38,7 +38,7 @@ Stage::Stage(const std::vector<mindspore::parallel::Device> &devices, int num, i
 // NOTE: '-1' indicates ERROR
 int Stage::global_rank(Group *g) const { return ((g == nullptr) ? rank_ : -1); }
 
-bool InitDevice(int32_t device_num, int32_t global_rank, const std::string &backend) {
+bool InitDevice(int32_t device_num, int32_t global_rank, const std::string &backend, int32_t stage_num) {
   if (device_num <= 0) {
     MS_LOG(ERROR) << "'device_num' must be positive.";
     return false;
@@ -60,17 +60,25 @@ bool InitDevice(int32_t device_num, int32_t global_rank, const std::string &back
     MS_LOG(ERROR) << "'global_rank' must be less than 'device_num'.";
     return false;
   }
-  if ((backend != HCCL_BACKEND) && (backend != NCCL_BACKEND) && (backend != UNDEFINED_BACKEND)) {
+  if ((backend != HCCL_BACKEND) && (backend != NCCL_BACKEND) && (backend != CPU_BACKEND) &&
+      (backend != UNDEFINED_BACKEND)) {
     MS_LOG(ERROR) << "Invalid backend: " << backend;
     return false;
   }
 
+  if ((stage_num <= 0) || (device_num % stage_num != 0)) {
+    MS_LOG(ERROR) << "'device_num' " << device_num << " can not be split into " << stage_num << " pipeline stages.";
+    return false;
+  }
+
   RankList devices, stage_map;
   for (int i = 0; i < device_num; ++i) {
     devices.push_back(i);
   }
 
-  stage_map.push_back(device_num);
+  for (int i = 0; i < stage_num; ++i) {
+    stage_map.push_back(device_num / stage_num);
+  }
   g_device_manager = std::make_shared<DeviceManager>();
   if (g_device_manager->Init(devices, global_rank, stage_map, backend) == SUCCESS) {
     MS_LOG(INFO) << "Device initialization succeeds.";
@@ -129,7 +137,8 @@ Status DeviceManager::Init(const RankList &devices, int32_t global_device_rank,
   auto stage_it = stage_map.begin();
   int32_t sum = 0;
 
-  if ((backend != HCCL_BACKEND) && (backend != NCCL_BACKEND) && (backend != UNDEFINED_BACKEND)) {
+  if ((backend != HCCL_BACKEND) && (backend != NCCL_BACKEND) && (backend != CPU_BACKEND) &&
+      (backend != UNDEFINED_BACKEND)) {
     MS_LOG(ERROR) << "Invalid backend: " << backend;
     return Status::FAILED;
   }
@@ -196,6 +205,8 @@ Status DeviceManager::Init(const RankList &devices, int32_t global_device_rank,
     gm_.set_world_group(HCCL_WORLD_GROUP);
   } else if (backend_ == NCCL_BACKEND) {
     gm_.set_world_group(NCCL_WORLD_GROUP);
+  } else if (backend_ == CPU_BACKEND) {
+    gm_.set_world_group(CPU_WORLD_GROUP);
   } else {
     gm_.set_world_group(UNDEFINED_WORLD_GROUP);
   }
@@ -233,6 +244,16 @@ RankList DeviceManager::GetDeviceListByStageId(int32_t stage_id) const {
   return res;
 }
 
+int32_t DeviceManager::GetStageIdByRank(int32_t rank) const {
+  for (size_t stage_id = 0; stage_id < stage_devices_.size(); ++stage_id) {
+    auto &stage = stage_devices_[stage_id];
+    if (std::find(stage.begin(), stage.end(), rank) != stage.end()) {
+      return SizeToInt(stage_id);
+    }
+  }
+  MS_LOG(EXCEPTION) << "The rank " << rank << " is not in any stage";
+}
+
 RankList DeviceManager::global_device_list(int32_t stage_id, int32_t rank, int32_t split_num) const {
   RankList res;
   if (split_num <= 0) {
@@ -294,7 +315,7 @@ DeviceManager &DeviceManager::GetInstance() {
 
 std::string DeviceManager::FindRankListNameByHashName(const std::string &hash_name) {
   std::string tmp = "WORLD_GROUP";
-  if ((hash_name == HCCL_WORLD_GROUP) || (hash_name == NCCL_WORLD_GROUP)) {
+  if ((hash_name == HCCL_WORLD_GROUP) || (hash_name == NCCL_WORLD_GROUP) || (hash_name == CPU_WORLD_GROUP)) {
     return tmp;
   }
   auto iter = group_to_rank_.find(hash_name);
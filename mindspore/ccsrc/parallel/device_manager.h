@@ -39,6 +39,7 @@ namespace parallel {
 
 constexpr char HCCL_BACKEND[] = "hccl";
 constexpr char NCCL_BACKEND[] = "nccl";
+constexpr char CPU_BACKEND[] = "cpu";
 constexpr char UNDEFINED_BACKEND[] = "undefined_backend";
 
 class DeviceManager;
@@ -48,7 +49,6 @@ extern DeviceManagerPtr g_device_manager;
 
 class Stage {
   // This class is used in pipeline-parallelization. Available devices are partitioned into multiple stages.
-  // Currently, the function of pipeline-parallelization and this class are NOT implemented.
  public:
   explicit Stage(std::vector<Device> devices) : devices_(std::move(devices)), number_(0), rank_(0) {
     gm_ = GroupManager();
@@ -69,8 +69,8 @@ class Stage {
 };
 
 // This method is used for initializing the global DeviceManager 'g_device_manager',
-// arguments including 'device_num' and 'global_rank'
-bool InitDevice(int32_t device_num, int32_t global_rank, const std::string &backend);
+// arguments including 'device_num' and 'global_rank'. The devices are split evenly into 'stage_num' pipeline stages.
+bool InitDevice(int32_t device_num, int32_t global_rank, const std::string &backend, int32_t stage_num = 1);
 
 void CheckGlobalDeviceManager();
 
@@ -99,6 +99,8 @@ class DeviceManager {
   size_t DeviceNum() const { return devices_.size(); }
 
   int32_t GetStageNum() const { return static_cast<const int32_t>(stage_devices_.size()); }
+  // the pipeline stage the rank is in
+  int32_t GetStageIdByRank(int32_t rank) const;
 
   int32_t global_rank() const { return global_rank_; }
   std::string backend() const { return backend_; }
@@ -29,6 +29,7 @@ namespace mindspore {
 namespace parallel {
 constexpr char HCCL_WORLD_GROUP[] = "hccl_world_group";
 constexpr char NCCL_WORLD_GROUP[] = "nccl_world_group";
+constexpr char CPU_WORLD_GROUP[] = "cpu_world_group";
 constexpr char UNDEFINED_WORLD_GROUP[] = "undefined_world_group";
 
 // Devices that need communication should in the same group. These classes are used to
@@ -208,6 +208,21 @@ Operator CreateAllReduceOp(const std::string &reduce_op, const std::string &grou
   return op;
 }
 
+Operator CreateAllGatherOp(const std::string &group) {
+  OperatorName operator_name = ALL_GATHER;
+  ValuePtr attr0_value = MakeValue(group);  // group
+  Attr attr0 = std::make_pair(GROUP, attr0_value);
+  OperatorAttrs operator_attrs;
+  operator_attrs.push_back(attr0);
+
+  OperatorParams operator_param;
+  OperatorArgs operator_arg = std::make_pair(operator_attrs, operator_param);
+
+  Operator op = std::make_pair(operator_name, operator_arg);
+  MS_LOG(INFO) << "Create all gather op success, the group is " << group;
+  return op;
+}
+
 // use for get tensor slice
 Operator CreateGetTensorSliceOp(const TensorLayout &tensor_layout) {
   Shape tensor_map = tensor_layout.tensor_map().array();
@@ -1048,7 +1063,7 @@ Status OperatorInfo::SetCostUnderStrategyBase(const StrategyPtr &strategy) {
   // Breaking ties for preferring data parallelization
   BreakingTiesForPerferringDataParallel(strategy, result);
   // refine communication cost calculation for practice
-  RefineForPracticalCost(result, false);
+  RefineForPracticalCost(result, false, operator_cost()->name(), GetCommGroupSizes());
   result->communication_forward_ = result->communication_without_parameter_;
 
   std::shared_ptr<StrategyWithCost> swc =
@@ -1148,6 +1163,23 @@ Status OperatorInfo::CorrectMemoryCost(size_t input_index) {
   return SUCCESS;
 }
 
+CommGroupSizes OperatorInfo::GetCommGroupSizes() const {
+  // the devices holding the same slice reduce it together, an invalid tensor map leaves the size unknown
+  auto repeat_device_num = [this](const Shape &tensor_map) {
+    return IntToSize(std::max(ComputeRepeatDeviceNumByTensorMap(dev_matrix_shape_, tensor_map), 0));
+  };
+  CommGroupSizes group_sizes;
+  if (!outputs_tensor_map_.empty()) {
+    group_sizes.forward = repeat_device_num(outputs_tensor_map_[0]);
+  }
+  for (size_t i = 0; i < inputs_tensor_map_.size() && i < is_parameter_.size(); ++i) {
+    if (is_parameter_[i]) {
+      group_sizes.backward = std::max(group_sizes.backward, repeat_device_num(inputs_tensor_map_[i]));
+    }
+  }
+  return group_sizes;
+}
+
 int32_t ComputeRepeatDeviceNumByTensorMap(const Shape &dev_matrix_shape, const Shape &tensor_map) {
   int32_t ret = -1;
 
@@ -192,6 +192,9 @@ class OperatorInfo {
   Status InferSliceShape(const Strategys &inputs_strategy, const Strategys &outputs_strategy,
                          Shapes *inputs_slice_shape, Shapes *outputs_slice_shape);
   void BreakingTiesForPerferringDataParallel(const StrategyPtr &, const CostPtr &);
+  // The group sizes of the AllReduce of the partial output and of the parameter gradients under the strategy the
+  // operator is initialized with for the cost model
+  CommGroupSizes GetCommGroupSizes() const;
 
   std::string name_;
   Shapes inputs_shape_;
@@ -262,6 +265,7 @@ Shape GetSliceShape(const Shape &tensor_shape, const Dimensions &strategy);
 Status CheckStrategyValue(const StrategyPtr &strategy, const Shapes &inputs_shape, bool);
 Operator CreateVirtualDivOp(int32_t div_num);
 Operator CreateAllReduceOp(const std::string &reduce_op, const std::string &group);
+Operator CreateAllGatherOp(const std::string &group);
 Operator CreateGetTensorSliceOp(const TensorLayout &tensor_layout);
 OperatorVector CreateMirrorOps(const std::string &group_name, size_t dev_num);
 int32_t ComputeRepeatDeviceNumByTensorMap(const Shape &dev_matrix_shape, const Shape &tensor_map);
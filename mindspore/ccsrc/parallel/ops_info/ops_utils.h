@@ -123,9 +123,14 @@ constexpr char SHAPES[] = "shapes";
 constexpr char GETNEXT_NUM[] = "output_num";
 constexpr char SHARED_NAME[] = "shared_name";
 constexpr char MIRROR_OP[] = "mirror_op";
+constexpr char OPTIMIZER_SHARD_OP[] = "optimizer_shard_op";
 constexpr char FORWARD_OP[] = "forward_op";
 constexpr char REDISTRIBUTION_OP[] = "redistribution_op";
 constexpr char DARA_PARALLEL[] = "data_parallel";
+constexpr char SR_TAG[] = "sr_tag";
+constexpr char SRC_RANK[] = "src_rank";
+constexpr char DEST_RANK[] = "dest_rank";
+constexpr char PIPELINE_STAGE[] = "pipeline_stage";
 
 // Operator
 constexpr char VIRTUAL_DIV[] = "_VirtualDiv";
@@ -137,6 +142,8 @@ constexpr char CONCAT_BY_AXIS[] = "ConcatByAxis";
 constexpr char SPLIT_BY_AXIS[] = "SplitByAxis";
 constexpr char ALL_REDUCE[] = "AllReduce";
 constexpr char MIRROR_OPERATOR[] = "_MirrorOperator";
+constexpr char PIPELINE_SEND[] = "_Send";
+constexpr char PIPELINE_RECEIVE[] = "_Receive";
 constexpr char STRIDED_SLICE[] = "StridedSlice";
 constexpr char ALL_GATHER[] = "AllGather";
 constexpr char REDUCE_SCATTER[] = "ReduceScatter";
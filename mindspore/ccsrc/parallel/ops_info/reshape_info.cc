@@ -410,7 +410,7 @@ void ReshapeInfo::SetCostForReshape(const mindspore::parallel::StrategyPtr &stra
   // Breaking ties for preferring data parallelization
   BreakingTiesForPerferringDataParallel(strategy, result);
   // refine communication cost calculation for practice
-  RefineForPracticalCost(result, false);
+  RefineForPracticalCost(result, false, operator_cost()->name(), GetCommGroupSizes());
 
   std::shared_ptr<StrategyWithCost> swc =
     std::make_shared<StrategyWithCost>(strategy, inputs_tensor_info_, outputs_tensor_info_);
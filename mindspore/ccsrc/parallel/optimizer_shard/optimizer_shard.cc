@@ -0,0 +1,124 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/optimizer_shard/optimizer_shard.h"
+
+#include <algorithm>
+#include "parallel/tensor_layout/map.h"
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+Status OptimizerShardLayout(const TensorLayout &layout, TensorLayout *shard_layout, int32_t *dev_num) {
+  MS_EXCEPTION_IF_NULL(shard_layout);
+  MS_EXCEPTION_IF_NULL(dev_num);
+  std::vector<int32_t> device_arrangement = layout.device_arrangement().array();
+  std::vector<int32_t> tensor_map = layout.tensor_map().array();
+  std::vector<int32_t> tensor_shape = layout.tensor_shape().array();
+  if (tensor_map.empty() || tensor_map[0] != MAP_NONE) {
+    return FAILED;
+  }
+
+  // the device dimension the parameter is repeated along, numbered as in the tensor map
+  int32_t repeated_dim = MAP_NONE;
+  size_t dim_num = device_arrangement.size();
+  for (size_t i = 0; i < dim_num; ++i) {
+    int32_t map = SizeToInt(dim_num - i - 1);
+    if (device_arrangement[i] == 1 || std::find(tensor_map.begin(), tensor_map.end(), map) != tensor_map.end()) {
+      continue;
+    }
+    if (repeated_dim != MAP_NONE) {
+      MS_LOG(INFO) << "The parameter is repeated along more than one device dimension";
+      return FAILED;
+    }
+    repeated_dim = map;
+  }
+  if (repeated_dim == MAP_NONE) {
+    return FAILED;
+  }
+  int32_t repeated_num = device_arrangement[dim_num - IntToSize(repeated_dim) - 1];
+  if (tensor_shape[0] % repeated_num != 0) {
+    MS_LOG(INFO) << "The first dimension " << tensor_shape[0] << " can not be split by " << repeated_num;
+    return FAILED;
+  }
+
+  tensor_map[0] = repeated_dim;
+  if (shard_layout->InitFromVector(device_arrangement, tensor_map, tensor_shape) != SUCCESS) {
+    MS_LOG(ERROR) << "Init the shard layout failed";
+    return FAILED;
+  }
+  *dev_num = repeated_num;
+  return SUCCESS;
+}
+
+double OptimizerShardSavedMemory(const OptimizerShardCandidate &candidate) {
+  if (candidate.dev_num < 2) {
+    return 0.0;
+  }
+  double memory = candidate.bytes * static_cast<double>(candidate.state_num + 1);
+  return memory * (candidate.dev_num - 1) / candidate.dev_num;
+}
+
+double OptimizerShardExposedTime(const OptimizerShardCandidate &candidate, const AllreduceTimeFunc &allreduce_time) {
+  MS_EXCEPTION_IF_NULL(allreduce_time);
+  return allreduce_time(candidate.bytes) / 2;
+}
+
+Status ChooseOptimizerShard(const std::vector<OptimizerShardCandidate> &candidates, double fixed_memory,
+                            double memory_budget, const AllreduceTimeFunc &allreduce_time, OptimizerShardPlan *plan) {
+  MS_EXCEPTION_IF_NULL(plan);
+  plan->sharded.clear();
+  plan->memory = fixed_memory;
+  plan->exposed_time = 0.0;
+
+  std::vector<size_t> order;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    plan->memory += candidates[i].bytes * static_cast<double>(candidates[i].state_num + 1);
+    if (candidates[i].dev_num > 1) {
+      order.push_back(i);
+    }
+  }
+  std::vector<double> exposed_time(candidates.size(), 0.0);
+  for (auto index : order) {
+    exposed_time[index] = OptimizerShardExposedTime(candidates[index], allreduce_time);
+  }
+  // the memory saved per exposed time, the larger first
+  std::stable_sort(order.begin(), order.end(), [&candidates, &exposed_time](size_t a, size_t b) {
+    return OptimizerShardSavedMemory(candidates[a]) * exposed_time[b] >
+           OptimizerShardSavedMemory(candidates[b]) * exposed_time[a];
+  });
+
+  for (auto index : order) {
+    if (memory_budget > 0 && plan->memory <= memory_budget) {
+      break;
+    }
+    plan->sharded.push_back(index);
+    plan->memory -= OptimizerShardSavedMemory(candidates[index]);
+    plan->exposed_time += exposed_time[index];
+  }
+  std::sort(plan->sharded.begin(), plan->sharded.end());
+  if (memory_budget > 0 && plan->memory > memory_budget) {
+    MS_LOG(WARNING) << "The parameters and the optimizer states take " << plan->memory << " bytes even when all the "
+                    << plan->sharded.size() << " candidates are sharded, over the budget " << memory_budget;
+    return FAILED;
+  }
+  MS_LOG(INFO) << "Shard " << plan->sharded.size() << " of " << candidates.size() << " parameters, the memory is "
+               << plan->memory << " bytes and the exposed time is " << plan->exposed_time;
+  return SUCCESS;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PARALLEL_OPTIMIZER_SHARD_OPTIMIZER_SHARD_H_
+#define MINDSPORE_CCSRC_PARALLEL_OPTIMIZER_SHARD_OPTIMIZER_SHARD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "parallel/allreduce_fusion/gradient_bucket.h"
+#include "parallel/status.h"
+#include "parallel/tensor_layout/tensor_layout.h"
+
+namespace mindspore {
+namespace parallel {
+// No memory budget: all the parameters that can be sharded are sharded
+constexpr double DEFAULT_COST_MODEL_OPTIMIZER_SHARD_MEMORY = 0.0;
+
+// The layout of the slice of a repeated parameter a rank keeps when the optimizer is sharded: the first dimension,
+// not split by the operators, is split over the device dimension the parameter is repeated along, so the ranks
+// sharing the parameter keep one part each. The parameter must be repeated along exactly one device dimension, whose
+// size divides the first dimension, otherwise FAILED. *dev_num is the size of that device dimension.
+Status OptimizerShardLayout(const TensorLayout &layout, TensorLayout *shard_layout, int32_t *dev_num);
+
+// A parameter that can be sharded
+struct OptimizerShardCandidate {
+  // the bytes of the parameter slice before it is sharded
+  double bytes;
+  // the number of the optimizer states cloned from the parameter, they are sharded with it
+  size_t state_num;
+  // the number of the ranks the parameter and its states are sharded over
+  int32_t dev_num;
+};
+
+struct OptimizerShardPlan {
+  // the indexes of the candidates sharded
+  std::vector<size_t> sharded;
+  // the bytes of the parameters and the optimizer states kept by a rank
+  double memory;
+  // the time the forwards wait for the AllGathers of the sharded parameters
+  double exposed_time;
+};
+
+// The bytes a rank saves when the candidate and its states are sharded
+double OptimizerShardSavedMemory(const OptimizerShardCandidate &candidate);
+
+// The time the sharding adds to a step. The ReduceScatter that replaces the AllReduce of the gradient still overlaps
+// the backward, but the forward waits for the AllGather of the parameter, which moves about half the bytes of an
+// AllReduce of it.
+double OptimizerShardExposedTime(const OptimizerShardCandidate &candidate, const AllreduceTimeFunc &allreduce_time);
+
+// Trade the memory of the candidates against the AllGathers their sharding exposes. fixed_memory is the bytes of the
+// parameters and states that are not candidates. Without a positive memory_budget all the candidates are sharded.
+// Otherwise the candidates saving the most memory per exposed time are sharded first, until the memory fits the
+// budget, and FAILED if it does not fit even when all of them are sharded.
+Status ChooseOptimizerShard(const std::vector<OptimizerShardCandidate> &candidates, double fixed_memory,
+                            double memory_budget, const AllreduceTimeFunc &allreduce_time, OptimizerShardPlan *plan);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PARALLEL_OPTIMIZER_SHARD_OPTIMIZER_SHARD_H_
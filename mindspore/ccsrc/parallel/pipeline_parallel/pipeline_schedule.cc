@@ -0,0 +1,147 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/pipeline_parallel/pipeline_schedule.h"
+
+#include <algorithm>
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+std::vector<StageSchedule> OneForwardOneBackwardSchedule(int32_t stage_num, int32_t micro_batch_num) {
+  if (stage_num <= 0 || micro_batch_num <= 0) {
+    MS_LOG(EXCEPTION) << "Invalid pipeline of " << stage_num << " stages and " << micro_batch_num << " micro batches";
+  }
+  std::vector<StageSchedule> schedule(IntToSize(stage_num));
+  for (int32_t stage = 0; stage < stage_num; ++stage) {
+    auto &tasks = schedule[IntToSize(stage)];
+    int32_t warmup = std::min(stage_num - stage - 1, micro_batch_num);
+    int32_t forward = 0;
+    int32_t backward = 0;
+    for (; forward < warmup; ++forward) {
+      tasks.push_back({PIPELINE_FORWARD, forward});
+    }
+    for (; forward < micro_batch_num; ++forward, ++backward) {
+      tasks.push_back({PIPELINE_FORWARD, forward});
+      tasks.push_back({PIPELINE_BACKWARD, backward});
+    }
+    for (; backward < micro_batch_num; ++backward) {
+      tasks.push_back({PIPELINE_BACKWARD, backward});
+    }
+  }
+  return schedule;
+}
+
+Status SimulatePipeline(const std::vector<StageSchedule> &schedule, const std::vector<double> &forward_time,
+                        const std::vector<double> &backward_time, double comm_time, PipelineSimulation *simulation) {
+  MS_EXCEPTION_IF_NULL(simulation);
+  size_t stage_num = schedule.size();
+  if (stage_num == 0 || forward_time.size() != stage_num || backward_time.size() != stage_num) {
+    MS_LOG(ERROR) << "The schedule of " << stage_num << " stages has " << forward_time.size() << " forward times and "
+                  << backward_time.size() << " backward times";
+    return FAILED;
+  }
+  int32_t micro_batch_num = 0;
+  for (auto &tasks : schedule) {
+    for (auto &task : tasks) {
+      micro_batch_num = std::max(micro_batch_num, task.micro_batch + 1);
+    }
+  }
+  // the end time of the forward and backward of every micro batch on every stage, negative before it runs
+  std::vector<std::vector<double>> forward_end(stage_num, std::vector<double>(IntToSize(micro_batch_num), -1.0));
+  std::vector<std::vector<double>> backward_end(stage_num, std::vector<double>(IntToSize(micro_batch_num), -1.0));
+  std::vector<size_t> next_task(stage_num, 0);
+  std::vector<double> stage_free(stage_num, 0.0);
+  simulation->stage_busy_time.assign(stage_num, 0.0);
+
+  size_t task_num = 0;
+  for (auto &tasks : schedule) {
+    task_num += tasks.size();
+  }
+  // every round runs the next task of every stage whose inputs are ready, there is a deadlock if none of them is
+  size_t finished = 0;
+  while (finished < task_num) {
+    bool progress = false;
+    for (size_t stage = 0; stage < stage_num; ++stage) {
+      while (next_task[stage] < schedule[stage].size()) {
+        auto &task = schedule[stage][next_task[stage]];
+        if (task.micro_batch < 0 || task.micro_batch >= micro_batch_num) {
+          MS_LOG(ERROR) << "Invalid micro batch " << task.micro_batch << " on stage " << stage;
+          return FAILED;
+        }
+        size_t micro = IntToSize(task.micro_batch);
+        double ready = 0.0;
+        if (task.type == PIPELINE_FORWARD) {
+          if (stage > 0) {
+            if (forward_end[stage - 1][micro] < 0.0) {
+              break;
+            }
+            ready = forward_end[stage - 1][micro] + comm_time;
+          }
+        } else {
+          if (forward_end[stage][micro] < 0.0) {
+            break;
+          }
+          ready = forward_end[stage][micro];
+          if (stage + 1 < stage_num) {
+            if (backward_end[stage + 1][micro] < 0.0) {
+              break;
+            }
+            ready = std::max(ready, backward_end[stage + 1][micro] + comm_time);
+          }
+        }
+        double duration = (task.type == PIPELINE_FORWARD) ? forward_time[stage] : backward_time[stage];
+        double end = std::max(ready, stage_free[stage]) + duration;
+        if (task.type == PIPELINE_FORWARD) {
+          forward_end[stage][micro] = end;
+        } else {
+          backward_end[stage][micro] = end;
+        }
+        stage_free[stage] = end;
+        simulation->stage_busy_time[stage] += duration;
+        ++next_task[stage];
+        ++finished;
+        progress = true;
+      }
+    }
+    if (!progress) {
+      for (size_t stage = 0; stage < stage_num; ++stage) {
+        if (next_task[stage] < schedule[stage].size()) {
+          MS_LOG(ERROR) << "The pipeline schedule deadlocks at " << PipelineTaskName(schedule[stage][next_task[stage]])
+                        << " of stage " << stage;
+          break;
+        }
+      }
+      return FAILED;
+    }
+  }
+
+  simulation->step_time = *std::max_element(stage_free.begin(), stage_free.end());
+  double busy_time = 0.0;
+  for (auto time : simulation->stage_busy_time) {
+    busy_time += time;
+  }
+  double total_time = simulation->step_time * static_cast<double>(stage_num);
+  simulation->bubble_ratio = (total_time > 0.0) ? 1.0 - busy_time / total_time : 0.0;
+  return SUCCESS;
+}
+
+std::string PipelineTaskName(const PipelineTask &task) {
+  return std::string(task.type == PIPELINE_FORWARD ? "F" : "B") + std::to_string(task.micro_batch);
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_PIPELINE_SCHEDULE_H_
+#define MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_PIPELINE_SCHEDULE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "parallel/status.h"
+
+namespace mindspore {
+namespace parallel {
+// The backward of a micro batch is taken as this many times of its forward when only the forward is costed
+constexpr double PIPELINE_BACKWARD_COMPUTATION_RATIO = 2.0;
+
+enum PipelineTaskType { PIPELINE_FORWARD, PIPELINE_BACKWARD };
+
+struct PipelineTask {
+  PipelineTaskType type;
+  int32_t micro_batch;
+};
+// The tasks of a stage in the order it runs them
+using StageSchedule = std::vector<PipelineTask>;
+
+struct PipelineSimulation {
+  // the time from the first task starts to the last task ends
+  double step_time = 0.0;
+  // the idle time of all the stages over stage_num * step_time
+  double bubble_ratio = 0.0;
+  std::vector<double> stage_busy_time;
+};
+
+// The 1F1B schedule: the stage s runs min(stage_num - s - 1, micro_batch_num) forwards to warm up, then one forward
+// and one backward in turn, and the backwards left at last. A stage holds the activations of at most stage_num - s
+// micro batches, instead of all of them as when all the forwards run first.
+std::vector<StageSchedule> OneForwardOneBackwardSchedule(int32_t stage_num, int32_t micro_batch_num);
+
+// Run the schedule with the forward and backward time of a micro batch on every stage, and comm_time between two
+// stages. The forward of a micro batch on a stage waits for its forward on the previous stage, and the backward for its
+// backward on the next stage. FAILED if the schedule deadlocks.
+Status SimulatePipeline(const std::vector<StageSchedule> &schedule, const std::vector<double> &forward_time,
+                        const std::vector<double> &backward_time, double comm_time, PipelineSimulation *simulation);
+
+std::string PipelineTaskName(const PipelineTask &task);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_PIPELINE_SCHEDULE_H_
@@ -0,0 +1,319 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/pipeline_parallel/pipeline_transformer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <set>
+#include "ir/meta_tensor.h"
+#include "operator/ops.h"
+#include "parallel/context.h"
+#include "parallel/device_manager.h"
+#include "parallel/graph_util/generate_graph.h"
+#include "parallel/ops_info/operator_info.h"
+#include "parallel/ops_info/ops_utils.h"
+#include "parallel/step_parallel.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#include "utils/context/ms_context.h"
+#include "utils/graph_utils.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+bool IsPrimitiveCNode(const CNodePtr &cnode, const std::string &name) {
+  if (!IsValueNode<Primitive>(cnode->input(0))) {
+    return false;
+  }
+  return GetValueNode<PrimitivePtr>(cnode->input(0))->name() == name;
+}
+
+// The forward graphs the stages are cut from, or the root graph when there is no backward
+std::set<FuncGraphPtr> PipelineGraphs(const FuncGraphPtr &root) {
+  auto graphs = ForwardGraph(root);
+  if (graphs.empty()) {
+    graphs.insert(root);
+  }
+  return graphs;
+}
+}  // namespace
+
+// The operators have the stages of their strategies, and the communication ops the stages of their groups
+int32_t PipelineTransformer::FixedStage(const CNodePtr &cnode) const {
+  if (!IsValueNode<Primitive>(cnode->input(0))) {
+    return -1;
+  }
+  if (IsParallelCareNode(cnode) && cnode->operator_info() != nullptr) {
+    auto strategy = cnode->operator_info()->strategy();
+    MS_EXCEPTION_IF_NULL(strategy);
+    return strategy->GetInputStage();
+  }
+  auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
+  auto group_ranks = prim->GetAttr(GROUP_RANKS);
+  if (group_ranks != nullptr && group_ranks->isa<StringImm>()) {
+    // the rank list name is like "0-1-2-3"
+    auto rank_list_name = GetValue<std::string>(group_ranks);
+    auto first_rank = rank_list_name.substr(0, rank_list_name.find('-'));
+    return g_device_manager->GetStageIdByRank(std::stoi(first_rank));
+  }
+  return -1;
+}
+
+void PipelineTransformer::Coloring() {
+  for (auto &graph : PipelineGraphs(root_)) {
+    for (auto &node : TopoSort(graph->get_return())) {
+      auto cnode = node->cast<CNodePtr>();
+      if (cnode != nullptr && cnode->in_forward_flag() && cnode->func_graph() == graph) {
+        forward_cnodes_.push_back(cnode);
+      }
+    }
+  }
+
+  for (auto &cnode : forward_cnodes_) {
+    int32_t stage = FixedStage(cnode);
+    if (stage >= 0) {
+      node_stage_[cnode] = stage;
+    } else if (IsPrimitiveCNode(cnode, TUPLE_GETITEM) && IsColored(cnode->input(1))) {
+      // the items of an output are where the output is
+      node_stage_[cnode] = node_stage_[cnode->input(1)];
+    }
+  }
+  // the ops inserted before an operator, like the ones of the redistribution, are in the stage of their users
+  auto &node_users = manager_->node_users();
+  for (auto iter = forward_cnodes_.rbegin(); iter != forward_cnodes_.rend(); ++iter) {
+    auto &cnode = *iter;
+    if (IsColored(cnode)) {
+      continue;
+    }
+    int32_t stage = stage_num_;
+    for (auto &user : node_users[cnode]) {
+      if (IsColored(user.first)) {
+        stage = std::min(stage, node_stage_[user.first]);
+      }
+    }
+    if (stage < stage_num_) {
+      node_stage_[cnode] = stage;
+    }
+  }
+  // and the ones at the end, like the output of the loss, are in the stage of their inputs
+  for (auto &cnode : forward_cnodes_) {
+    if (IsColored(cnode)) {
+      continue;
+    }
+    int32_t stage = -1;
+    for (size_t i = 1; i < cnode->size(); ++i) {
+      if (IsColored(cnode->input(i))) {
+        stage = std::max(stage, node_stage_[cnode->input(i)]);
+      }
+    }
+    if (stage >= 0) {
+      node_stage_[cnode] = stage;
+    }
+  }
+  MS_LOG(INFO) << "Colored " << node_stage_.size() << " of the " << forward_cnodes_.size()
+               << " forward cnodes with pipeline stages";
+}
+
+int32_t PipelineTransformer::PeerRank(int32_t stage) const {
+  auto rank = g_device_manager->global_rank();
+  auto local_devices = g_device_manager->GetDeviceListByStageId(stage_);
+  auto peer_devices = g_device_manager->GetDeviceListByStageId(stage);
+  auto iter = std::find(local_devices.begin(), local_devices.end(), rank);
+  if (iter == local_devices.end() || local_devices.size() != peer_devices.size()) {
+    MS_LOG(EXCEPTION) << "The rank " << rank << " has no peer in the stage " << stage;
+  }
+  return peer_devices[IntToSize(iter - local_devices.begin())];
+}
+
+std::pair<std::vector<int32_t>, TypePtr> PipelineTransformer::SliceShapeAndType(const AnfNodePtr &node) const {
+  auto tensor_abstract = node->abstract() == nullptr ? nullptr : node->abstract()->cast<abstract::AbstractTensorPtr>();
+  if (tensor_abstract == nullptr) {
+    MS_LOG(EXCEPTION) << "Only tensors can be passed between pipeline stages, but got " << node->DebugString();
+  }
+  TypePtr type = tensor_abstract->element()->BuildType();
+
+  // the operator outputs the slice, the allreduce of its partial sums and the item of its outputs keep it
+  size_t output_index = 0;
+  auto cnode = node->cast<CNodePtr>();
+  while (cnode != nullptr) {
+    if (IsParallelCareNode(cnode) && cnode->operator_info() != nullptr) {
+      auto outputs = cnode->operator_info()->outputs_tensor_info();
+      if (output_index < outputs.size()) {
+        return std::make_pair(outputs[output_index].slice_shape(), type);
+      }
+      break;
+    }
+    if (IsPrimitiveCNode(cnode, TUPLE_GETITEM)) {
+      output_index = IntToSize(GetTupleGetItemIndex(cnode));
+    } else if (!IsPrimitiveCNode(cnode, ALL_REDUCE)) {
+      break;
+    }
+    cnode = cnode->input(1)->cast<CNodePtr>();
+  }
+  auto shapes = GetNodeShape(node);
+  if (shapes.empty()) {
+    MS_LOG(EXCEPTION) << "Can not get the shape of " << node->DebugString();
+  }
+  return std::make_pair(shapes[0], type);
+}
+
+AnfNodePtr PipelineTransformer::InsertSend(const AnfNodePtr &node, int32_t dest_stage, int32_t sr_tag) {
+  auto shape_type = SliceShapeAndType(node);
+  OperatorAttrs attrs = {std::make_pair(SR_TAG, MakeValue(sr_tag)),
+                         std::make_pair(DEST_RANK, MakeValue(PeerRank(dest_stage))),
+                         std::make_pair(SHAPE, MakeValue(shape_type.first)), std::make_pair(DTYPE, shape_type.second),
+                         std::make_pair(GROUP, MakeValue(g_device_manager->world_group()))};
+  auto send_op = CreatOpInstance(attrs, PIPELINE_SEND, "");
+  MS_EXCEPTION_IF_NULL(send_op);
+  auto graph = node->func_graph();
+  auto send = graph->NewCNode({NewValueNode(send_op), node});
+  send->set_in_forward_flag(true);
+  send->set_scope(node->scope());
+  MS_LOG(INFO) << "Send " << node->DebugString() << " to stage " << dest_stage << " with sr_tag " << sr_tag;
+  return send;
+}
+
+// The _Receive takes a weight, whose gradient carries the _Send of the gradient back to the stage it is from
+AnfNodePtr PipelineTransformer::ReceiveInput(const FuncGraphPtr &graph) {
+  for (auto &cnode : forward_cnodes_) {
+    if (cnode->func_graph() != graph || !IsColored(cnode) || node_stage_[cnode] != stage_) {
+      continue;
+    }
+    for (size_t i = 1; i < cnode->size(); ++i) {
+      auto param = cnode->input(i)->cast<ParameterPtr>();
+      if (param != nullptr && param->has_default()) {
+        return param;
+      }
+    }
+  }
+  MS_LOG(EXCEPTION) << "The pipeline stage " << stage_ << " has no weight to receive the tensors with";
+}
+
+AnfNodePtr PipelineTransformer::InsertReceive(const AnfNodePtr &node, const CNodePtr &user, int32_t src_stage,
+                                              int32_t sr_tag) {
+  auto shape_type = SliceShapeAndType(node);
+  OperatorAttrs attrs = {std::make_pair(SR_TAG, MakeValue(sr_tag)),
+                         std::make_pair(SRC_RANK, MakeValue(PeerRank(src_stage))),
+                         std::make_pair(SHAPE, MakeValue(shape_type.first)), std::make_pair(DTYPE, shape_type.second),
+                         std::make_pair(GROUP, MakeValue(g_device_manager->world_group()))};
+  auto receive_op = CreatOpInstance(attrs, PIPELINE_RECEIVE, "");
+  MS_EXCEPTION_IF_NULL(receive_op);
+  auto graph = user->func_graph();
+  auto receive = graph->NewCNode({NewValueNode(receive_op), ReceiveInput(graph)});
+  receive->set_in_forward_flag(true);
+  receive->set_scope(user->scope());
+  node_stage_[receive] = stage_;
+  MS_LOG(INFO) << "Receive " << node->DebugString() << " from stage " << src_stage << " with sr_tag " << sr_tag;
+  return receive;
+}
+
+void PipelineTransformer::InsertSendReceive() {
+  // every rank walks the same edges in the same order, so the sr_tags of the sends and the receives match
+  std::map<std::pair<AnfNodePtr, int32_t>, int32_t> sr_tags;
+  std::map<std::pair<AnfNodePtr, int32_t>, AnfNodePtr> receives;
+  for (auto &cnode : forward_cnodes_) {
+    if (!IsColored(cnode)) {
+      continue;
+    }
+    int32_t user_stage = node_stage_[cnode];
+    for (size_t i = 1; i < cnode->size(); ++i) {
+      auto input = cnode->input(i);
+      if (!input->isa<CNode>() || !IsColored(input) || node_stage_[input] == user_stage) {
+        continue;
+      }
+      int32_t input_stage = node_stage_[input];
+      if (input_stage > user_stage) {
+        MS_LOG(EXCEPTION) << "The stage " << user_stage << " of " << cnode->DebugString() << " uses "
+                          << input->DebugString() << " of the later stage " << input_stage;
+      }
+      auto key = std::make_pair(input, user_stage);
+      auto tag_iter = sr_tags.find(key);
+      bool first_use = (tag_iter == sr_tags.end());
+      int32_t sr_tag = first_use ? SizeToInt(sr_tags.size()) : tag_iter->second;
+      if (first_use) {
+        sr_tags[key] = sr_tag;
+      }
+      if (stage_ == input_stage && first_use) {
+        sends_.push_back(InsertSend(input, user_stage, sr_tag));
+      } else if (stage_ == user_stage) {
+        if (receives.find(key) == receives.end()) {
+          receives[key] = InsertReceive(input, cnode, input_stage, sr_tag);
+        }
+        manager_->SetEdge(cnode, SizeToInt(i), receives[key]);
+      }
+    }
+  }
+  MS_LOG(INFO) << "The pipeline stage " << stage_ << " sends " << sends_.size() << " tensors and receives "
+               << receives.size() << " tensors";
+}
+
+// The graph outputs the loss on the last stage, and zeros on the others, which depend on the sends
+void PipelineTransformer::CutGraph() {
+  for (auto &graph : PipelineGraphs(root_)) {
+    std::vector<AnfNodePtr> make_tuple_inputs = {NewValueNode(prim::kPrimMakeTuple)};
+    for (auto &send : sends_) {
+      if (send->func_graph() == graph) {
+        make_tuple_inputs.push_back(send);
+      }
+    }
+    auto output = graph->output();
+    MS_EXCEPTION_IF_NULL(output);
+    if (stage_ != stage_num_ - 1) {
+      auto tensor_abstract =
+        output->abstract() == nullptr ? nullptr : output->abstract()->cast<abstract::AbstractTensorPtr>();
+      if (tensor_abstract == nullptr) {
+        MS_LOG(EXCEPTION) << "The output of the pipeline must be a tensor, but got " << output->DebugString();
+      }
+      auto shape = GetNodeShape(output);
+      auto type = tensor_abstract->element()->BuildType();
+      auto zeros = std::make_shared<tensor::Tensor>(type->type_id(), shape.empty() ? Shape() : shape[0]);
+      (void)memset(zeros->data_c(true), 0, zeros->data().nbytes());
+      auto zeros_node = NewValueNode(zeros);
+      zeros_node->set_abstract(output->abstract());
+      output = zeros_node;
+    }
+    if (make_tuple_inputs.size() > 1) {
+      auto sends = graph->NewCNode(make_tuple_inputs);
+      output = graph->NewCNode({NewValueNode(prim::kPrimDepend), output, sends});
+    }
+    if (output != graph->output()) {
+      (void)manager_->Replace(graph->output(), output);
+    }
+  }
+}
+
+void PipelineTransform(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager) {
+  MS_EXCEPTION_IF_NULL(root);
+  MS_EXCEPTION_IF_NULL(manager);
+  CheckGlobalDeviceManager();
+  int32_t stage_num = g_device_manager->GetStageNum();
+  int32_t stage = g_device_manager->GetStageIdByRank(g_device_manager->global_rank());
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->device_target() != kCPUDevice) {
+    MS_LOG(WARNING) << "The kernels of _Send and _Receive only run on the CPU after init(\"cpu\"), the pipeline graph "
+                    << "on " << ms_context->device_target() << " can only be compiled";
+  }
+  MS_LOG(INFO) << "Cut the pipeline stage " << stage << " of " << stage_num << " stages for the rank "
+               << g_device_manager->global_rank();
+  PipelineTransformer transformer(manager, root, stage, stage_num);
+  transformer.Coloring();
+  transformer.InsertSendReceive();
+  transformer.CutGraph();
+}
+}  // namespace parallel
+}  // namespace mindspore
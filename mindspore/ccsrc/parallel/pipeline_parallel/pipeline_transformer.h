@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_PIPELINE_TRANSFORMER_H_
+#define MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_PIPELINE_TRANSFORMER_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ir/anf.h"
+#include "ir/manager.h"
+#include "parallel/status.h"
+
+namespace mindspore {
+namespace parallel {
+// Keep the forward of the pipeline stage of this rank only. The forward cnodes are colored with the stages of their
+// operators, the tensors from an earlier stage are received by _Receive, and the tensors used by a later stage are sent
+// by _Send, whose bprops carry the gradients back. The other stages are cut off the graph.
+class PipelineTransformer {
+ public:
+  PipelineTransformer(const FuncGraphManagerPtr &manager, const FuncGraphPtr &root, int32_t stage, int32_t stage_num)
+      : manager_(manager), root_(root), stage_(stage), stage_num_(stage_num) {}
+  ~PipelineTransformer() = default;
+
+  void Coloring();
+  void InsertSendReceive();
+  void CutGraph();
+
+ private:
+  int32_t FixedStage(const CNodePtr &cnode) const;
+  bool IsColored(const AnfNodePtr &node) const { return node_stage_.find(node) != node_stage_.end(); }
+  // the peer of this rank in the stage, which has the same index in its stage
+  int32_t PeerRank(int32_t stage) const;
+  // the shape and the type of the tensor slice the node outputs
+  std::pair<std::vector<int32_t>, TypePtr> SliceShapeAndType(const AnfNodePtr &node) const;
+  AnfNodePtr InsertSend(const AnfNodePtr &node, int32_t dest_stage, int32_t sr_tag);
+  AnfNodePtr InsertReceive(const AnfNodePtr &node, const CNodePtr &user, int32_t src_stage, int32_t sr_tag);
+  AnfNodePtr ReceiveInput(const FuncGraphPtr &graph);
+
+  FuncGraphManagerPtr manager_;
+  FuncGraphPtr root_;
+  int32_t stage_;
+  int32_t stage_num_;
+  std::vector<CNodePtr> forward_cnodes_;
+  std::unordered_map<AnfNodePtr, int32_t> node_stage_;
+  std::vector<AnfNodePtr> sends_;
+};
+
+// Called at the end of StepParallel when the pipeline has more than one stage
+void PipelineTransform(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_PIPELINE_TRANSFORMER_H_
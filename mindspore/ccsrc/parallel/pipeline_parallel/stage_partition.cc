@@ -0,0 +1,207 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parallel/pipeline_parallel/stage_partition.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <string>
+#include "parallel/ops_info/ops_utils.h"
+#include "parallel/pipeline_parallel/pipeline_schedule.h"
+#include "utils/convert_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+Status PartitionStages(const std::vector<double> &costs, const std::vector<double> &memories, size_t stage_num,
+                       double memory_limit, std::vector<size_t> *stage_ends) {
+  MS_EXCEPTION_IF_NULL(stage_ends);
+  size_t op_num = costs.size();
+  if (memories.size() != op_num) {
+    MS_LOG(ERROR) << "There are " << op_num << " costs but " << memories.size() << " memories";
+    return FAILED;
+  }
+  if (stage_num == 0 || stage_num > op_num) {
+    MS_LOG(ERROR) << "Can not split " << op_num << " operators into " << stage_num << " stages";
+    return FAILED;
+  }
+  std::vector<double> cost_sum(op_num + 1, 0.0);
+  std::vector<double> memory_sum(op_num + 1, 0.0);
+  for (size_t i = 0; i < op_num; ++i) {
+    cost_sum[i + 1] = cost_sum[i] + costs[i];
+    memory_sum[i + 1] = memory_sum[i] + memories[i];
+  }
+
+  const double inf = std::numeric_limits<double>::max();
+  // best[k][i]: the least largest stage cost of splitting the first i operators into k stages,
+  // split[k][i]: where the last of the k stages begins
+  std::vector<std::vector<double>> best(stage_num + 1, std::vector<double>(op_num + 1, inf));
+  std::vector<std::vector<size_t>> split(stage_num + 1, std::vector<size_t>(op_num + 1, 0));
+  best[0][0] = 0.0;
+  for (size_t k = 1; k <= stage_num; ++k) {
+    // every stage has an operator at least
+    for (size_t i = k; i + (stage_num - k) <= op_num; ++i) {
+      for (size_t j = k - 1; j < i; ++j) {
+        if (best[k - 1][j] == inf) {
+          continue;
+        }
+        if (memory_limit > 0.0 && memory_sum[i] - memory_sum[j] > memory_limit) {
+          continue;
+        }
+        double cost = std::max(best[k - 1][j], cost_sum[i] - cost_sum[j]);
+        if (cost < best[k][i]) {
+          best[k][i] = cost;
+          split[k][i] = j;
+        }
+      }
+    }
+  }
+  if (best[stage_num][op_num] == inf) {
+    MS_LOG(ERROR) << "The memory of " << op_num << " operators can not fit into " << stage_num
+                  << " stages of memory " << memory_limit;
+    return FAILED;
+  }
+
+  stage_ends->assign(stage_num, 0);
+  size_t end = op_num;
+  for (size_t k = stage_num; k > 0; --k) {
+    (*stage_ends)[k - 1] = end;
+    end = split[k][end];
+  }
+  return SUCCESS;
+}
+
+namespace {
+// The operators in topological order, and the ones ready at the same time in the order of the cost graph
+std::vector<OperatorInfoPtr> TopologicalOrder(const std::vector<OperatorInfoPtr> &ops) {
+  std::map<OperatorInfoPtr, size_t> index;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    index[ops[i]] = i;
+  }
+  std::vector<size_t> in_degree(ops.size(), 0);
+  for (size_t i = 0; i < ops.size(); ++i) {
+    for (auto &edge : ops[i]->prev_edges()) {
+      if (index.count(edge->prev_operator()) != 0) {
+        ++in_degree[i];
+      }
+    }
+  }
+  std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (in_degree[i] == 0) {
+      ready.push(i);
+    }
+  }
+  std::vector<OperatorInfoPtr> order;
+  while (!ready.empty()) {
+    size_t i = ready.top();
+    ready.pop();
+    order.push_back(ops[i]);
+    for (auto &edge : ops[i]->succ_edges()) {
+      auto iter = index.find(edge->next_operator());
+      if (iter != index.end() && --in_degree[iter->second] == 0) {
+        ready.push(iter->second);
+      }
+    }
+  }
+  if (order.size() != ops.size()) {
+    MS_LOG(EXCEPTION) << "The cost graph has a cycle";
+  }
+  return order;
+}
+
+bool IsTmpIdentity(const OperatorInfoPtr &op) { return op->name().find(IDENTITY_INFO) != std::string::npos; }
+}  // namespace
+
+Status PartitionOperatorsIntoStages(const CostGraphPtr &graph, int32_t stage_num, int32_t micro_batch_num) {
+  MS_EXCEPTION_IF_NULL(graph);
+  // the parameters shared by TmpIdentity go to the stages of their users, so they are not split
+  std::vector<OperatorInfoPtr> ops;
+  std::vector<OperatorInfoPtr> identities;
+  for (auto &op : TopologicalOrder(graph->GetOperators())) {
+    MS_EXCEPTION_IF_NULL(op->selected_strategy());
+    MS_EXCEPTION_IF_NULL(op->selected_cost());
+    if (IsTmpIdentity(op)) {
+      identities.push_back(op);
+    } else {
+      ops.push_back(op);
+    }
+  }
+  std::vector<double> costs;
+  std::vector<double> memories;
+  for (auto &op : ops) {
+    auto cost = op->selected_cost();
+    costs.push_back(graph->costmodel_alpha() * cost->computation_cost_ +
+                    graph->costmodel_beta() * cost->communication_with_partial_para_);
+    memories.push_back(cost->memory_with_reuse_);
+  }
+  std::vector<size_t> stage_ends;
+  if (PartitionStages(costs, memories, IntToSize(stage_num), graph->GetDeviceMemory(), &stage_ends) != SUCCESS) {
+    MS_LOG(ERROR) << "Partitioning " << ops.size() << " operators into " << stage_num << " stages failed";
+    return FAILED;
+  }
+
+  std::map<OperatorInfoPtr, int32_t> op_stage;
+  std::vector<double> stage_cost(IntToSize(stage_num), 0.0);
+  size_t begin = 0;
+  for (size_t stage = 0; stage < stage_ends.size(); ++stage) {
+    for (size_t i = begin; i < stage_ends[stage]; ++i) {
+      op_stage[ops[i]] = SizeToInt(stage);
+      stage_cost[stage] += costs[i];
+    }
+    MS_LOG(INFO) << "Pipeline stage " << stage << " has " << stage_ends[stage] - begin << " operators from "
+                 << ops[begin]->name() << " to " << ops[stage_ends[stage] - 1]->name() << ", cost "
+                 << stage_cost[stage];
+    begin = stage_ends[stage];
+  }
+  for (auto &identity : identities) {
+    int32_t stage = stage_num - 1;
+    for (auto &edge : identity->succ_edges()) {
+      auto iter = op_stage.find(edge->next_operator());
+      if (iter != op_stage.end()) {
+        stage = std::min(stage, iter->second);
+      }
+    }
+    op_stage[identity] = stage;
+  }
+  for (auto &item : op_stage) {
+    auto &op = item.first;
+    auto strategy = NewStrategy(item.second, op->selected_strategy()->GetInputDim());
+    op->SetSelectedStrategyAndCost(strategy, op->selected_cost());
+  }
+
+  // the cost is of a whole batch, and of the forward only
+  std::vector<double> forward_time;
+  std::vector<double> backward_time;
+  for (auto cost : stage_cost) {
+    forward_time.push_back(cost / micro_batch_num);
+    backward_time.push_back(PIPELINE_BACKWARD_COMPUTATION_RATIO * cost / micro_batch_num);
+  }
+  PipelineSimulation simulation;
+  auto schedule = OneForwardOneBackwardSchedule(stage_num, micro_batch_num);
+  if (SimulatePipeline(schedule, forward_time, backward_time, 0.0, &simulation) != SUCCESS) {
+    MS_LOG(ERROR) << "Simulating the pipeline failed";
+    return FAILED;
+  }
+  MS_LOG(INFO) << "The 1F1B pipeline of " << stage_num << " stages and " << micro_batch_num
+               << " micro batches: step cost " << simulation.step_time << ", bubble ratio " << simulation.bubble_ratio;
+  return SUCCESS;
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_STAGE_PARTITION_H_
+#define MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_STAGE_PARTITION_H_
+
+#include <cstdint>
+#include <vector>
+#include "parallel/auto_parallel/graph_costmodel.h"
+#include "parallel/status.h"
+
+namespace mindspore {
+namespace parallel {
+// Split the operators, which are in topological order, into stage_num contiguous stages, so that the largest cost of a
+// stage is the least, and the memory of every stage is within memory_limit. A memory_limit of no more than 0 does not
+// limit the memory. stage_ends[s] is one past the last operator of the stage s.
+Status PartitionStages(const std::vector<double> &costs, const std::vector<double> &memories, size_t stage_num,
+                       double memory_limit, std::vector<size_t> *stage_ends);
+
+// Split the operators of the cost graph into pipeline stages by the costs of their selected strategies, and move the
+// selected strategies to the stages. The 1F1B schedule of micro_batch_num micro batches is simulated on the stages, and
+// its bubble ratio is reported.
+Status PartitionOperatorsIntoStages(const CostGraphPtr &graph, int32_t stage_num, int32_t micro_batch_num);
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PARALLEL_PIPELINE_PARALLEL_STAGE_PARTITION_H_
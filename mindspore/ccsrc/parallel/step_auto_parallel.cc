@@ -19,10 +19,15 @@
 #include <inttypes.h>
 #include <sys/time.h>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -40,6 +45,7 @@
 #include "parallel/context.h"
 #include "parallel/ops_info/tmp_identity_info.h"
 #include "parallel/ops_info/reshape_info.h"
+#include "parallel/pipeline_parallel/stage_partition.h"
 #include "parallel/step_parallel.h"
 #include "parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
 #include "pipeline/parse/python_adapter.h"
@@ -162,6 +168,9 @@ bool StepAutoParallel(const FuncGraphPtr &root, const opt::OptimizerPtr &) {
       MS_LOG(EXCEPTION) << "Auto-parallel strategy search failed when using DP searching mode";
     }
   } else if (strategy_search_mode == RECURSIVE_PROGRAMMING) {
+    if (ParallelContext::GetInstance()->pipeline_stages() > 1) {
+      MS_LOG(EXCEPTION) << "The pipeline stages are only partitioned in DP searching mode";
+    }
     if (ParallelStrategyRecSearch(all_nodes, root) != SUCCESS) {
       MS_LOG(EXCEPTION) << "Auto-parallel strategy search failed when using RP searching mode";
     }
@@ -342,9 +351,100 @@ bool IsAutoParallelCareNode(const CNodePtr &cnode) {
   return IsParallelCareNode(cnode) && IsSplittableOperator(prim->name());
 }
 
-OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &cnode, StrategyMap *stra_map) {
+namespace {
+constexpr size_t kMaxSearchThreadNum = 16;
+
+// Run task(index) for every index in [0, task_num) on at most thread_num threads. The tasks are taken one by one, as
+// their costs differ a lot. If tasks throw, the exception of the first of them is rethrown once all the threads end.
+void ParallelForEach(size_t task_num, size_t thread_num, const std::function<void(size_t)> &task) {
+  thread_num = std::min(thread_num, task_num);
+  if (thread_num <= 1) {
+    for (size_t index = 0; index < task_num; ++index) {
+      task(index);
+    }
+    return;
+  }
+  std::atomic<size_t> next_task(0);
+  std::mutex exception_mutex;
+  std::exception_ptr exception = nullptr;
+  size_t exception_index = task_num;
+  auto worker = [&]() {
+    for (size_t index = next_task++; index < task_num; index = next_task++) {
+      try {
+        task(index);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (index < exception_index) {
+          exception = std::current_exception();
+          exception_index = index;
+        }
+        // the tasks before this one are all taken already, so they still run
+        next_task = task_num;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+// Return the time in us since 'start', and move 'start' to now
+uint64_t PhaseTime(struct timeval *start) {
+  struct timeval end;
+  (void)gettimeofday(&end, nullptr);
+  uint64_t time = kUSecondInSecond * static_cast<uint64_t>(end.tv_sec - start->tv_sec);
+  time += static_cast<uint64_t>(end.tv_usec - start->tv_usec);
+  *start = end;
+  return time;
+}
+}  // namespace
+
+size_t StrategySearchThreadNum() {
+  return std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), kMaxSearchThreadNum);
+}
+
+// The strategies of an operator are generated independently of the other operators, so they are generated for all
+// the operators of the cost graph in parallel.
+Status GenerateStrategiesForOperators(const std::vector<OperatorInfoPtr> &operators, size_t thread_num) {
+  std::vector<Status> status(operators.size(), SUCCESS);
+  ParallelForEach(operators.size(), thread_num, [&operators, &status](size_t index) {
+    MS_EXCEPTION_IF_NULL(operators[index]);
+    status[index] = operators[index]->GenerateStrategies(0);
+  });
+  for (size_t index = 0; index < operators.size(); ++index) {
+    if (status[index] != SUCCESS) {
+      MS_LOG(ERROR) << "Strategy search for Operator " << operators[index]->name() << " failed.";
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+}
+
+// Each edge only reads the strategies of its two operators, so the costs of the edges are initialized in parallel.
+void InitEdgeCosts(const std::vector<EdgePtr> &edges, size_t thread_num) {
+  ParallelForEach(edges.size(), thread_num, [&edges](size_t index) {
+    MS_EXCEPTION_IF_NULL(edges[index]);
+    if (edges[index]->InitEdgeCost() != SUCCESS) {
+      MS_LOG(EXCEPTION) << "Edge cost initialization failed";
+    }
+  });
+}
+
+// The operators whose strategies are to be generated are added to 'generate_list', and the strategies are generated
+// by GenerateStrategiesForOperators after all the operators are created.
+OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &cnode, StrategyMap *stra_map,
+                                      std::vector<OperatorInfoPtr> *generate_list) {
   MS_EXCEPTION_IF_NULL(prim);
   MS_EXCEPTION_IF_NULL(cnode);
+  MS_EXCEPTION_IF_NULL(generate_list);
   auto attrs = prim->attrs();
   std::vector<Shapes> shape_list = ExtractShape(cnode);
   if (shape_list.empty()) {
@@ -399,10 +499,7 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
     // Compute split_flag_list_, indicating which input has batch dimension. This is ONLY used for preparation for
     // BatchParallelInfo operator
     operator_info->ComputeBatchSplitFlagList();
-    if (operator_info->GenerateStrategies(0) != SUCCESS) {
-      MS_LOG(ERROR) << "Strategy search for Operator " << operator_info->name() << " failed.";
-      return nullptr;
-    }
+    generate_list->push_back(operator_info);
   } else {
     // In this case, the configured strategy should be extracted to help setting cost
     StrategyPtr strategyPtr;
@@ -453,6 +550,7 @@ Status ConstructCostGraphNodesByUniqueId(const std::vector<AnfNodePtr> &all_node
       MS_LOG(EXCEPTION) << "Load strategy checkpoint failed";
     }
   }
+  std::vector<OperatorInfoPtr> generate_list;
   // Step 1
   for (auto &node : all_nodes) {
     // NOTE: we only care about splittable Primitive operators
@@ -470,7 +568,7 @@ Status ConstructCostGraphNodesByUniqueId(const std::vector<AnfNodePtr> &all_node
 
     auto search_cnode = from_cnode_to_info.find(cnode->UniqueId());
     if (search_cnode == from_cnode_to_info.end()) {
-      auto operator_info = CreateTheOperatorInfo(prim, cnode, &stra_map);
+      auto operator_info = CreateTheOperatorInfo(prim, cnode, &stra_map, &generate_list);
       if (operator_info == nullptr) {
         return FAILED;
       }
@@ -493,6 +591,9 @@ Status ConstructCostGraphNodesByUniqueId(const std::vector<AnfNodePtr> &all_node
                         << " is set OperatorInfo: " << search_cnode->second->name() << ", Primitive: " << prim->name();
     }
   }
+  if (GenerateStrategiesForOperators(generate_list, StrategySearchThreadNum()) != SUCCESS) {
+    return FAILED;
+  }
 
   MS_LOG(INFO) << "Constructing nodes for cost graph ends.";
   return SUCCESS;
@@ -512,6 +613,7 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
       MS_LOG(EXCEPTION) << "Load strategy checkpoint failed";
     }
   }
+  std::vector<OperatorInfoPtr> generate_list;
   for (auto &node : all_nodes) {
     // NOTE: we only care about splittable Primitive operators
     auto cnode = node->cast<CNodePtr>();
@@ -529,7 +631,7 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
     auto search_cnode = from_cnode_to_info.find(cnode->UniqueIdThroughCopy());
     if (search_cnode == from_cnode_to_info.end()) {
       // In this case, the corresponding OperatorInfo is not created, create the new one.
-      auto operator_info = CreateTheOperatorInfo(prim, cnode, &stra_map);
+      auto operator_info = CreateTheOperatorInfo(prim, cnode, &stra_map, &generate_list);
       if (operator_info == nullptr) {
         return FAILED;
       }
@@ -564,6 +666,9 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
       }
     }
   }
+  if (GenerateStrategiesForOperators(generate_list, StrategySearchThreadNum()) != SUCCESS) {
+    return FAILED;
+  }
 
   MS_LOG(INFO) << "Constructing nodes for cost graph ends.";
   return SUCCESS;
@@ -572,6 +677,7 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
 void ConstructCostGraphEdges(const std::vector<AnfNodePtr> &all_nodes) {
   // Step 2
   MS_LOG(INFO) << "Constructing edges for cost graph begins.";
+  std::vector<EdgePtr> edges;
   for (auto &node : all_nodes) {
     auto cnode = node->cast<CNodePtr>();
     bool bool_result_cnode = (cnode == nullptr) || !IsValueNode<Primitive>(cnode->input(0));
@@ -620,11 +726,7 @@ void ConstructCostGraphEdges(const std::vector<AnfNodePtr> &all_nodes) {
             edge_ptr = std::make_shared<Edge>(edge_name, prev_cnode->operator_info(), cnode->operator_info(),
                                               output_index, i - 1, false);
           }
-
-          // Init costs for this edge
-          if (edge_ptr->InitEdgeCost() != SUCCESS) {
-            MS_LOG(EXCEPTION) << "Edge cost initialization failed";
-          }
+          edges.push_back(edge_ptr);
           cnode->operator_info()->AddPrevEdge(edge_ptr);
           prev_cnode->operator_info()->AddSuccEdge(edge_ptr);
           entire_costgraph->AddEdge(prev_cnode->operator_info(), cnode->operator_info(), edge_ptr);
@@ -672,6 +774,8 @@ void ConstructCostGraphEdges(const std::vector<AnfNodePtr> &all_nodes) {
     }
     MS_LOG(INFO) << "Successfully created " << edge_count << " edges for: " << cnode->operator_info()->name();
   }
+  // Init costs for the edges
+  InitEdgeCosts(edges, StrategySearchThreadNum());
 
   MS_LOG(INFO) << "Constructing edges for cost graph ends.";
 }
@@ -1074,7 +1178,13 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   //      runs on each of them.
   //
   // OUTPUT: the determined strategy for each operator.
+  //
+  // The strategies of the operators in Step 1 and the costs of the edges in Step 2 are computed on several threads,
+  // and the redistribution costs are shared by the edges with the same layouts.
 
+  struct timeval phase_start;
+  (void)gettimeofday(&phase_start, nullptr);
+  RedistributionCostCache::GetInstance().Clear();
   // Step 1
   if (CostModelContext::GetInstance()->is_multi_subgraphs()) {
     if (ConstructCostGraphNodesByUniqueIdTC(all_nodes, root) == SUCCESS) {
@@ -1091,29 +1201,49 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
       MS_LOG(EXCEPTION) << "Constructing nodes for cost graph failed.";
     }
   }
+  MS_LOG(INFO) << "Constructing nodes and generating strategies used time: " << PhaseTime(&phase_start) << " us";
   // Step 1.1
   ReshapeCostCompute(all_nodes);
+  MS_LOG(INFO) << "Computing the costs of Reshape used time: " << PhaseTime(&phase_start) << " us";
   // Step 2
   ConstructCostGraphEdges(all_nodes);
   MS_LOG(INFO) << "Constructing edges for cost graph succeeded. There are " << entire_costgraph->GetOperators().size()
                << " operators, and " << entire_costgraph->GetNumEdges() << " edges.";
+  MS_LOG(INFO) << "Constructing edges used time: " << PhaseTime(&phase_start) << " us";
 
   // Step 3: Augment the costgraph.
   AugmentCostGraph(all_nodes);
   MS_LOG(INFO) << "After the augmenting procedure, there are " << entire_costgraph->GetOperators().size()
                << " operators, and " << entire_costgraph->GetNumEdges() << " edges.";
+  auto &redis_cost_cache = RedistributionCostCache::GetInstance();
+  MS_LOG(INFO) << "Augmenting cost graph used time: " << PhaseTime(&phase_start) << " us. "
+               << redis_cost_cache.size() << " redistribution costs are computed for "
+               << redis_cost_cache.hit_count() + redis_cost_cache.miss_count() << " lookups.";
+  redis_cost_cache.Clear();
 
   // Step 3.1: Calculate the memory usage
   if (entire_costgraph->CalculateMemoryCost() != SUCCESS) {
     MS_LOG(EXCEPTION) << "Calculating memory cost failed.";
   }
+  MS_LOG(INFO) << "Calculating memory cost used time: " << PhaseTime(&phase_start) << " us";
 
   // Step 4: run DP algorithm on the costgraph.
   if (GetStrategy(entire_costgraph) != SUCCESS) {
     MS_LOG(ERROR) << "Strategy search for cost-graph fails";
     return FAILED;
   }
-  MS_LOG(INFO) << "Searching strategy succeeded.";
+  MS_LOG(INFO) << "Searching strategy succeeded, used time: " << PhaseTime(&phase_start) << " us";
+
+  // Step 4.1: split the operators into pipeline stages
+  int32_t stage_num = ParallelContext::GetInstance()->pipeline_stages();
+  if (stage_num > 1) {
+    if (PartitionOperatorsIntoStages(entire_costgraph, stage_num, ParallelContext::GetInstance()->micro_batch_num()) !=
+        SUCCESS) {
+      MS_LOG(ERROR) << "Partitioning pipeline stages fails";
+      return FAILED;
+    }
+    MS_LOG(INFO) << "Partitioning pipeline stages used time: " << PhaseTime(&phase_start) << " us";
+  }
 
   if (entire_costgraph->InitSelectedStrategy() == SUCCESS) {
     MS_LOG(INFO) << "Init selected strategy succeeded.";
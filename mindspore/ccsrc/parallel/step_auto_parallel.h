@@ -23,6 +23,7 @@
 #include <vector>
 #include "ir/anf.h"
 #include "optimizer/opt.h"
+#include "parallel/auto_parallel/edge_costmodel.h"
 #include "parallel/status.h"
 #include "pipeline/pipeline.h"
 
@@ -49,6 +50,13 @@ Status ConstructCostGraphNodesByUniqueIdTC(const std::vector<AnfNodePtr> &all_no
 
 void ConstructCostGraphEdges(const std::vector<AnfNodePtr> &all_nodes);
 
+// the number of threads generating the strategies and the edge costs, at most the number of cores
+size_t StrategySearchThreadNum();
+
+Status GenerateStrategiesForOperators(const std::vector<OperatorInfoPtr> &operators, size_t thread_num);
+
+void InitEdgeCosts(const std::vector<EdgePtr> &edges, size_t thread_num);
+
 void AugmentCostGraph(const std::vector<AnfNodePtr> &all_nodes);
 
 Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root);
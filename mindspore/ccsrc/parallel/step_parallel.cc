@@ -30,8 +30,10 @@
 #include "ir/meta_tensor.h"
 #include "operator/ops.h"
 #include "optimizer/optimizer.h"
+#include "parallel/allreduce_fusion/allreduce_fusion.h"
 #include "parallel/auto_parallel/graph_costmodel.h"
 #include "parallel/context.h"
+#include "parallel/costmodel_context.h"
 #include "parallel/device_manager.h"
 #include "parallel/dynamic_creator.h"
 #include "parallel/graph_util/generate_graph.h"
@@ -39,6 +41,8 @@
 #include "parallel/graph_util/node_info.h"
 #include "parallel/node_check.h"
 #include "parallel/ops_info/matmul_info.h"
+#include "parallel/optimizer_shard/optimizer_shard.h"
+#include "parallel/pipeline_parallel/pipeline_transformer.h"
 #include "parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
 #include "utils/comm_manager.h"
 #include "utils/symbolic.h"
@@ -52,6 +56,9 @@ static const std::set<std::string> INVALID_LOSS_OPS = {GET_NEXT, VIRTUALLOSS};
 // g_RefMap, for CNode B input i is a RefKey[Parameter C],
 // it will be one item in map with key: C, and value: (B, i)
 static std::map<AnfNodePtr, std::pair<AnfNodePtr, int>> g_RefMap;
+// g_OptimizerShardOps, the parameters whose optimizer is sharded and the AllGather ops gathering them, which take the
+// place of their mirror ops
+static std::unordered_map<AnfNodePtr, Operator> g_OptimizerShardOps;
 
 void SetCommunicationOpGroupLabel(std::vector<AnfNodePtr> new_node_input) {
   if (new_node_input.empty()) {
@@ -872,9 +879,19 @@ void InsertMirrorOps(const MirrorOps &mirror_ops, const CNodePtr &node) {
     if (!param_node_pair.first) {
       continue;
     }
+    AnfNodePtr parameter = param_node_pair.first;
+    if (param_node_pair.second) {
+      parameter = FindParameterByRefKeyNode(param_node_pair.first, func_graph)[0];
+    }
+    // the parameter whose optimizer is sharded is gathered by an AllGather instead of the MirrorOp
+    auto shard_iter = g_OptimizerShardOps.find(parameter);
+    bool sharded = (shard_iter != g_OptimizerShardOps.end());
+    if (sharded) {
+      backward_op = {shard_iter->second};
+    }
     // not a RefKey
     if (!param_node_pair.second) {
-      auto next_cnode = FindCNode(param_node_pair.first, MIRROR_OPERATOR, func_graph);
+      auto next_cnode = FindCNode(param_node_pair.first, sharded ? ALL_GATHER : MIRROR_OPERATOR, func_graph);
       // if there is already a MirrorOp in the same graph, use MirrorOp CNode as a input instead
       if (next_cnode.first) {
         MS_EXCEPTION_IF_NULL(next_cnode.second);
@@ -887,7 +904,8 @@ void InsertMirrorOps(const MirrorOps &mirror_ops, const CNodePtr &node) {
     if (backward_op.size() != 1) {
       MS_LOG(EXCEPTION) << "backward_op size must be 1, real is  " << backward_op.size();
     }
-    std::string instance_name = MIRROR_OP;
+    std::string instance_name = sharded ? OPTIMIZER_SHARD_OP : MIRROR_OP;
+    AnfNodePtr inserted_node = nullptr;
     if (IsCastBeforMirror(node, index)) {
       for (auto &op : backward_op) {
         // insert new node before the node
@@ -895,13 +913,24 @@ void InsertMirrorOps(const MirrorOps &mirror_ops, const CNodePtr &node) {
         MS_EXCEPTION_IF_NULL(cnode);
         AnfNodePtr pre_node = cnode->input(1);
         InsertNode(op, cnode, size_t(1), pre_node, func_graph, instance_name);
+        inserted_node = cnode->input(1);
       }
     } else {
       for (auto &op : backward_op) {
         AnfNodePtr pre_node = node->input(index);
         InsertNode(op, node, index, pre_node, func_graph, instance_name);
+        inserted_node = node->input(index);
       }
     }
+    if (sharded) {
+      // the bprop of the AllGather averages the gradients as the bprop of the MirrorOp does
+      MS_EXCEPTION_IF_NULL(inserted_node);
+      auto inserted_cnode = inserted_node->cast<CNodePtr>();
+      MS_EXCEPTION_IF_NULL(inserted_cnode);
+      auto prim = GetValueNode<PrimitivePtr>(inserted_cnode->input(0));
+      MS_EXCEPTION_IF_NULL(prim);
+      (void)prim->AddAttr(MEAN_FLAG, MakeValue(ParallelContext::GetInstance()->mirror_mean()));
+    }
   }
 }
 
@@ -1365,6 +1394,122 @@ void SetClonedTensorShapeForOptimizer(const FuncGraphPtr &root) {
   }
 }
 
+namespace {
+// The number of the optimizer states cloned from the parameter
+size_t OptimizerStateNum(const ParameterPtr &parameter) {
+  MS_EXCEPTION_IF_NULL(parameter);
+  py::object clone_info = parse::python_adapter::GetPyObjAttr(parameter->default_param(), CLONE_INFO);
+  if (!py::cast<bool>(parse::python_adapter::GetPyObjAttr(clone_info, BE_CLONED))) {
+    return 0;
+  }
+  py::list be_cloned_index = parse::python_adapter::GetPyObjAttr(clone_info, BE_CLONED_INDEX);
+  return be_cloned_index.size();
+}
+
+// The parameter is sharded over the devices of the MirrorOp of its first operator, the devices along the device
+// dimension it is repeated along. The AllGather gathering it is created for the group of the MirrorOp.
+bool OptimizerShardInfo(const FuncGraphPtr &root, const AnfNodePtr &parameter, TensorLayout *shard_layout,
+                        int32_t *dev_num, Operator *all_gather_op) {
+  MS_EXCEPTION_IF_NULL(all_gather_op);
+  auto parameter_ptr = parameter->cast<ParameterPtr>();
+  MS_EXCEPTION_IF_NULL(parameter_ptr);
+  if (parameter_ptr->tensor_layout() == nullptr) {
+    return false;
+  }
+  std::pair<AnfNodePtr, int> res = FindSubGraph(root, parameter);
+  if (res.first == nullptr) {
+    return false;
+  }
+  CNodePtr cnode = res.first->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  OperatorInfoPtr distribute_operator = cnode->operator_info();
+  MS_EXCEPTION_IF_NULL(distribute_operator);
+  MirrorOps mirror_ops = distribute_operator->mirror_ops();
+  size_t index = IntToSize(res.second - 1);
+  if (index >= mirror_ops.size() || mirror_ops[index].empty()) {
+    return false;
+  }
+
+  std::string group;
+  int32_t mirror_dev_num = 0;
+  for (auto &attr : mirror_ops[index][0].second.first) {
+    if (attr.first == GROUP) {
+      group = GetValue<std::string>(attr.second);
+    } else if (attr.first == DEV_NUM) {
+      mirror_dev_num = GetValue<int>(attr.second);
+    }
+  }
+  if (OptimizerShardLayout(*parameter_ptr->tensor_layout(), shard_layout, dev_num) != SUCCESS) {
+    return false;
+  }
+  if (*dev_num != mirror_dev_num) {
+    MS_LOG(INFO) << "The parameter " << parameter_ptr->name() << " is repeated on " << *dev_num
+                 << " devices, but its mirror op has " << mirror_dev_num;
+    return false;
+  }
+  *all_gather_op = CreateAllGatherOp(group);
+  return true;
+}
+}  // namespace
+
+void ShardOptimizer(const FuncGraphPtr &root) {
+  MS_EXCEPTION_IF_NULL(root);
+  g_OptimizerShardOps.clear();
+  std::vector<ParameterPtr> parameters;
+  std::vector<TensorLayout> shard_layouts;
+  std::vector<Operator> all_gather_ops;
+  std::vector<OptimizerShardCandidate> candidates;
+  double fixed_memory = 0.0;
+  for (auto &parameter_node : root->parameters()) {
+    auto parameter = parameter_node->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(parameter);
+    if (!parameter->has_default() || ParameterIsCloned(root, parameter_node)) {
+      continue;
+    }
+    size_t state_num = OptimizerStateNum(parameter);
+    double bytes = GradientBytes(parameter_node);
+    TensorLayout shard_layout;
+    int32_t dev_num = 0;
+    Operator all_gather_op;
+    // only the parameters with optimizer states are sharded
+    if (state_num == 0 || !OptimizerShardInfo(root, parameter_node, &shard_layout, &dev_num, &all_gather_op)) {
+      fixed_memory += bytes * static_cast<double>(state_num + 1);
+      continue;
+    }
+    parameters.push_back(parameter);
+    shard_layouts.push_back(shard_layout);
+    all_gather_ops.push_back(all_gather_op);
+    candidates.push_back({bytes, state_num, dev_num});
+  }
+  if (candidates.empty()) {
+    MS_LOG(INFO) << "No parameter can be sharded";
+    return;
+  }
+
+  AllreduceTimeFunc allreduce_time;
+  if (GetAllreduceTimeFunc(&allreduce_time) != SUCCESS) {
+    MS_LOG(EXCEPTION) << "Get the AllReduce time failed";
+  }
+  double memory_budget = CostModelContext::GetInstance()->costmodel_optimizer_shard_memory();
+  OptimizerShardPlan plan;
+  // all the candidates are sharded when the memory does not fit the budget
+  (void)ChooseOptimizerShard(candidates, fixed_memory, memory_budget, allreduce_time, &plan);
+  for (auto index : plan.sharded) {
+    auto &parameter = parameters[index];
+    auto &shard_layout = shard_layouts[index];
+    MS_EXCEPTION_IF_NULL(parameter->abstract());
+    // Don't modify it in-place as the pointer of this AbstractValue may used as cache key in StaticAnalysis.
+    auto cloned_abstract = parameter->abstract()->Clone();
+    MS_EXCEPTION_IF_NULL(cloned_abstract);
+    cloned_abstract->set_shape(std::make_shared<abstract::Shape>(shard_layout.slice_shape().array()));
+    parameter->set_abstract(cloned_abstract);
+    parameter->set_tensor_layout(std::make_shared<TensorLayout>(shard_layout));
+    g_OptimizerShardOps[parameter] = all_gather_ops[index];
+    MS_LOG(INFO) << "The parameter " << parameter->name() << " and its optimizer states are sharded over "
+                 << candidates[index].dev_num << " devices";
+  }
+}
+
 void SetVirtualDatasetStrategy(const CNodePtr &node) {
   MS_EXCEPTION_IF_NULL(node);
   PrimitivePtr prim = GetValueNode<PrimitivePtr>(node->input(0));
@@ -2209,6 +2354,8 @@ Status ParallelInit() {
     world_group = HCCL_WORLD_GROUP;
   } else if (backend == NCCL_BACKEND) {
     world_group = NCCL_WORLD_GROUP;
+  } else if (backend == CPU_BACKEND) {
+    world_group = CPU_WORLD_GROUP;
   } else {
     MS_LOG(EXCEPTION) << "Invalid communication backend: " << backend;
   }
@@ -2231,14 +2378,16 @@ Status ParallelInit() {
     MS_LOG(INFO) << "Get global rank from communication model, the global rank is  " << global_rank;
   }
 
-  if (!InitDevice(device_num, global_rank, backend)) {
+  int32_t stage_num = ParallelContext::GetInstance()->pipeline_stages();
+  if (!InitDevice(device_num, global_rank, backend, stage_num)) {
     MS_LOG(ERROR) << "Init device failed";
     return FAILED;
   }
 
   MS_LOG(INFO) << "The parallel context: dev num: " << device_num << ", global rank: " << global_rank
                << ", backend: " << backend << ", mirror_mean: " << ParallelContext::GetInstance()->mirror_mean()
-               << ", cast_before_mirror: " << ParallelContext::GetInstance()->cast_before_mirror();
+               << ", cast_before_mirror: " << ParallelContext::GetInstance()->cast_before_mirror()
+               << ", pipeline stages: " << stage_num;
   return SUCCESS;
 }
 
@@ -2305,11 +2454,25 @@ bool StepParallel(const FuncGraphPtr &root, const opt::OptimizerPtr &optimizer)
   // cover Parallel shape
   CoverSliceShape(root);
 
+  // shard the parameters, before the optimizer's clone tensors take their shapes
+  if (ParallelContext::GetInstance()->enable_parallel_optimizer()) {
+    ShardOptimizer(root);
+  }
+
   // set the shape for optimizer's clone tensor
   SetClonedTensorShapeForOptimizer(root);
 
   // ForwardCommunication BackwardCommunication TensorRedistribution
   ParallelCommunication(root, all_nodes, manager);
+  g_OptimizerShardOps.clear();
+
+  // keep the pipeline stage of this rank, and send and receive the tensors between the stages
+  if (ParallelContext::GetInstance()->pipeline_stages() > 1) {
+    if (parallel_mode != AUTO_PARALLEL) {
+      MS_LOG(EXCEPTION) << "The pipeline stages are only partitioned in auto parallel mode";
+    }
+    PipelineTransform(root, manager);
+  }
 
   DumpGraph(root, std::string(STEP_PARALLEL_END));
 
@@ -114,6 +114,11 @@ void SetParallelShape(const AnfNodePtr &parameter, const std::pair<AnfNodePtr, i
 // change parameters'shape in resource
 void CoverSliceShape(const FuncGraphPtr &root);
 
+// Shard the parameters chosen by the cost model and their optimizer states over the devices they are repeated on, the
+// AllGathers of the parameters take the place of their mirror ops and the bprops of the AllGathers reduce-scatter the
+// gradients
+void ShardOptimizer(const FuncGraphPtr &root);
+
 void SetVirtualDatasetStrategy(const CNodePtr &node);
 
 // Creat parallel operator for primitive node(has strategy)
@@ -25,6 +25,8 @@
 #include "pybind_api/api_register.h"
 #include "pipeline/parse/python_adapter.h"
 #include "utils/summary/event_writer.h"
+#include "utils/summary/async_event_writer.h"
+#include "utils/checkpoint/checkpoint_engine.h"
 #include "utils/config_manager.h"
 #include "parallel/context.h"
 #include "parallel/device_manager.h"
@@ -34,6 +36,9 @@
 #else
 #include "device/gpu/distribution/collective_fake_init.h"
 #endif
+#ifdef ENABLE_CPU_COLLECTIVE
+#include "device/cpu/distribution/cpu_collective.h"
+#endif
 namespace py = pybind11;
 
 using FuncGraph = mindspore::FuncGraph;
@@ -43,6 +48,9 @@ using Pipeline = mindspore::pipeline::Pipeline;
 using PrimitivePy = mindspore::PrimitivePy;
 using MetaFuncGraph = mindspore::MetaFuncGraph;
 using EventWriter = mindspore::summary::EventWriter;
+using AsyncEventWriter = mindspore::summary::AsyncEventWriter;
+using CheckpointWriter = mindspore::checkpoint::CheckpointWriter;
+using CheckpointReader = mindspore::checkpoint::CheckpointReader;
 using OpLib = mindspore::kernel::OpLib;
 using ParallelContext = mindspore::parallel::ParallelContext;
 using CostModelContext = mindspore::parallel::CostModelContext;
@@ -89,6 +97,7 @@ PYBIND11_MODULE(_c_expression, m) {
 
   (void)m.def("generate_key", &mindspore::pipeline::GenerateKey, "Generate the function graph key.");
   (void)m.def("real_run_op", &mindspore::pynative::RunOp, "Run op pynatively.");
+  (void)m.def("sync_pynative_ops", &mindspore::pynative::SyncPyNativeOps, "Wait for all pending pynative ops.");
   (void)m.def("reset_op_id", &mindspore::pipeline::ResetOpId, "Reset Operator Id");
   (void)m.def("init_hccl", &mindspore::pipeline::InitHccl, "Init Hccl");
   (void)m.def("finalize_hccl", &mindspore::pipeline::FinalizeHccl, "Finalize Hccl");
@@ -125,12 +134,18 @@ PYBIND11_MODULE(_c_expression, m) {
          "Get whether to enable reduce precision.")
     .def("set_enable_reduce_precision_flag", &mindspore::MsContext::set_enable_reduce_precision,
          "Set whether to enable reduce precision.")
+    .def("get_enable_pynative_async", &mindspore::MsContext::enable_pynative_async,
+         "Get whether to run pynative ops asynchronously.")
+    .def("set_enable_pynative_async", &mindspore::MsContext::set_enable_pynative_async,
+         "Set whether to run pynative ops asynchronously.")
     .def("get_save_graphs_path", &mindspore::MsContext::save_graphs_path, "Get save graphs path.")
     .def("set_save_graphs_path", &mindspore::MsContext::set_save_graphs_path, "Set save graphs path.")
     .def("get_save_ms_model_flag", &mindspore::MsContext::save_ms_model_flag, "Get whether to save ms model.")
     .def("set_save_ms_model_flag", &mindspore::MsContext::set_save_ms_model_flag, "Set whether to save ms model.")
     .def("get_save_ms_model_path", &mindspore::MsContext::save_ms_model_path, "Get path to save ms model.")
     .def("set_save_ms_model_path", &mindspore::MsContext::set_save_ms_model_path, "Set path to save ms model")
+    .def("get_ir_fusion_flag", &mindspore::MsContext::ir_fusion_flag, "Get whether to enable ir fusion.")
+    .def("set_ir_fusion_flag", &mindspore::MsContext::set_ir_fusion_flag, "Set whether to enable ir fusion.")
     .def("get_enable_dump", &mindspore::MsContext::enable_dump, "Get whether to enable dump.")
     .def("set_enable_dump", &mindspore::MsContext::set_enable_dump, "Set whether to enable dump.")
     .def("get_save_dump_path", &mindspore::MsContext::save_dump_path, "Get path to dump.")
@@ -138,6 +153,14 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("set_graph_memory_max_size", &mindspore::MsContext::set_graph_memory_max_size, "set graph memory max size.")
     .def("set_variable_memory_max_size", &mindspore::MsContext::set_variable_memory_max_size,
          "set variable memory max size")
+    .def("get_recompute_memory_max_size", &mindspore::MsContext::recompute_memory_max_size,
+         "Get the memory budget of the activations for the recomputation.")
+    .def("set_recompute_memory_max_size", &mindspore::MsContext::set_recompute_memory_max_size,
+         "Set the memory budget of the activations for the recomputation.")
+    .def("get_swap_memory_max_size", &mindspore::MsContext::swap_memory_max_size,
+         "Get the device memory limit of a graph, over which tensors are swapped to the host.")
+    .def("set_swap_memory_max_size", &mindspore::MsContext::set_swap_memory_max_size,
+         "Set the device memory limit of a graph, over which tensors are swapped to the host.")
     .def("get_enable_profiling", &mindspore::MsContext::enable_profiling, "Get whether to open profiling.")
     .def("set_enable_profiling", &mindspore::MsContext::set_enable_profiling, "Set whether to open profiling.")
     .def("get_profiling_options", &mindspore::MsContext::profiling_options, "Get options to profiling.")
@@ -175,6 +198,10 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set enable/disable all reduce fusion.")
     .def("get_enable_all_reduce_fusion", &ParallelContext::enable_all_reduce_fusion,
          "Get enable/disable all reduce fusion.")
+    .def("set_enable_parallel_optimizer", &ParallelContext::set_enable_parallel_optimizer,
+         "Set enable/disable parallel optimizer.")
+    .def("get_enable_parallel_optimizer", &ParallelContext::enable_parallel_optimizer,
+         "Get enable/disable parallel optimizer.")
     .def("get_parameter_broadcast", &ParallelContext::parameter_broadcast, "Get parameter broadcast.")
     .def("get_parameter_broadcast_is_set", &ParallelContext::parameter_broadcast_is_set,
          "Get parameter broadcast is set.")
@@ -185,6 +212,10 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set strategy checkpoint save file.")
     .def("get_strategy_ckpt_load_file", &ParallelContext::strategy_ckpt_load_file, "Get strategy checkpoint load file.")
     .def("get_strategy_ckpt_save_file", &ParallelContext::strategy_ckpt_save_file, "Get strategy checkpoint save file.")
+    .def("set_pipeline_stages", &ParallelContext::set_pipeline_stages, "Set pipeline stages.")
+    .def("get_pipeline_stages", &ParallelContext::pipeline_stages, "Get pipeline stages.")
+    .def("set_micro_batch_num", &ParallelContext::set_micro_batch_num, "Set micro batch num.")
+    .def("get_micro_batch_num", &ParallelContext::micro_batch_num, "Get micro batch num.")
     .def("reset", &ParallelContext::Reset, "Reset auto parallel context.");
 
   (void)py::class_<CostModelContext, std::shared_ptr<CostModelContext>>(m, "CostModelContext")
@@ -216,6 +247,12 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the parameter cost_model_communi_bias of the DP algorithm.")
     .def("get_costmodel_communi_bias", &CostModelContext::costmodel_communi_bias,
          "Get the parameter cost_model_communi_bias of the DP algorithm.")
+    .def("set_costmodel_profile_file", &CostModelContext::set_costmodel_profile_file,
+         "Set the profile file of the cost model.")
+    .def("get_costmodel_profile_file", &CostModelContext::costmodel_profile_file,
+         "Get the profile file of the cost model.")
+    .def("calibrate_costmodel_profile", &CostModelContext::CalibrateCostModelProfile,
+         "Measure the cost model on the host and save the profile file.")
     .def("set_multi_subgraphs", &CostModelContext::set_multi_subgraphs, "Set the parameter is_multi_subgraphs.")
     .def("get_multi_subgraphs", &CostModelContext::is_multi_subgraphs, "Get the parameter is_multi_subgraphs.")
     .def("set_run_phase", &CostModelContext::set_run_phase, "Set the flag run_phase.")
@@ -254,6 +291,42 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("get_costmodel_allreduce_fusion_computation_time_parameter",
          &CostModelContext::costmodel_allreduce_fusion_computation_time_parameter,
          "Get the parameter gradient AllReduce fusion computation time parameter.")
+    .def("set_costmodel_allreduce_fusion_backward_profile_file",
+         &CostModelContext::set_costmodel_allreduce_fusion_backward_profile_file,
+         "Set the parameter gradient AllReduce fusion backward time profile file.")
+    .def("get_costmodel_allreduce_fusion_backward_profile_file",
+         &CostModelContext::costmodel_allreduce_fusion_backward_profile_file,
+         "Get the parameter gradient AllReduce fusion backward time profile file.")
+    .def("set_costmodel_allreduce_fusion_bucket_bytes", &CostModelContext::set_costmodel_allreduce_fusion_bucket_bytes,
+         "Set the parameter gradient AllReduce fusion bucket bytes.")
+    .def("get_costmodel_allreduce_fusion_bucket_bytes", &CostModelContext::costmodel_allreduce_fusion_bucket_bytes,
+         "Get the parameter gradient AllReduce fusion bucket bytes.")
+    .def("set_costmodel_gradient_compression", &CostModelContext::set_costmodel_gradient_compression,
+         "Set the parameter gradient compression method.")
+    .def("get_costmodel_gradient_compression", &CostModelContext::costmodel_gradient_compression,
+         "Get the parameter gradient compression method.")
+    .def("set_costmodel_gradient_compression_topk_ratio",
+         &CostModelContext::set_costmodel_gradient_compression_topk_ratio,
+         "Set the parameter gradient compression top-k ratio.")
+    .def("get_costmodel_gradient_compression_topk_ratio",
+         &CostModelContext::costmodel_gradient_compression_topk_ratio,
+         "Get the parameter gradient compression top-k ratio.")
+    .def("set_costmodel_gradient_compression_powersgd_rank",
+         &CostModelContext::set_costmodel_gradient_compression_powersgd_rank,
+         "Set the parameter gradient compression PowerSGD rank.")
+    .def("get_costmodel_gradient_compression_powersgd_rank",
+         &CostModelContext::costmodel_gradient_compression_powersgd_rank,
+         "Get the parameter gradient compression PowerSGD rank.")
+    .def("set_costmodel_gradient_compression_element_time",
+         &CostModelContext::set_costmodel_gradient_compression_element_time,
+         "Set the parameter gradient compression time per element.")
+    .def("get_costmodel_gradient_compression_element_time",
+         &CostModelContext::costmodel_gradient_compression_element_time,
+         "Get the parameter gradient compression time per element.")
+    .def("set_costmodel_optimizer_shard_memory", &CostModelContext::set_costmodel_optimizer_shard_memory,
+         "Set the memory of the parameters and optimizer states of a device when the optimizer is sharded.")
+    .def("get_costmodel_optimizer_shard_memory", &CostModelContext::costmodel_optimizer_shard_memory,
+         "Get the memory of the parameters and optimizer states of a device when the optimizer is sharded.")
     .def("set_tensor_slice_align_enable", &CostModelContext::set_tensor_slice_alignment_enable,
          "Set the parameter tensor_slice_align_enable in strategy generation.")
     .def("get_tensor_slice_align_enable", &CostModelContext::tensor_slice_alignment_enable,
@@ -295,6 +368,38 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("Close", &EventWriter::Close, "Close the write.")
     .def("Shut", &EventWriter::Shut, "Final close the write.");
 
+  (void)py::class_<AsyncEventWriter, std::shared_ptr<AsyncEventWriter>>(m, "AsyncEventWriter_")
+    .def(py::init<const std::string &, size_t, int>())
+    .def("GetFileName", &AsyncEventWriter::GetFileName, "Get the file name.")
+    .def("Open", &AsyncEventWriter::Open, "Open the write file and start the writer thread.")
+    .def("Write", &AsyncEventWriter::Write, py::arg("event_str"), py::arg("droppable") = true,
+         py::call_guard<py::gil_scoped_release>(), "Enqueue the serialize event, return False if it is dropped.")
+    .def("EventCount", &AsyncEventWriter::GetWriteEventCount, "Written event count.")
+    .def("QueuedBytes", &AsyncEventWriter::GetQueuedBytes, "Bytes of the events waiting to be written.")
+    .def("PeakQueuedBytes", &AsyncEventWriter::GetPeakQueuedBytes, "Peak bytes of the queued events.")
+    .def("DroppedEvents", &AsyncEventWriter::GetDroppedEvents, "Count of events dropped as the queue is full.")
+    .def("SampledEvents", &AsyncEventWriter::GetSampledEvents, "Count of events skipped by sampling.")
+    .def("SetSampleInterval", &AsyncEventWriter::set_sample_interval, "Keep one of every interval events.")
+    .def("Flush", &AsyncEventWriter::Flush, py::call_guard<py::gil_scoped_release>(), "Flush the event.")
+    .def("Shut", &AsyncEventWriter::Shut, py::call_guard<py::gil_scoped_release>(), "Final close the write.");
+
+  (void)py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter>>(m, "CheckpointWriter_")
+    .def(py::init<const std::string &>())
+    .def("save", &CheckpointWriter::Save, py::arg("names"), py::arg("tensors"), "Save tensors to the checkpoint.")
+    .def("save_async", &CheckpointWriter::SaveAsync, py::arg("names"), py::arg("tensors"),
+         "Snapshot tensors and save them to the checkpoint in background.")
+    .def("wait", &CheckpointWriter::Wait, "Wait for the background save.")
+    .def("set_thread_num", &CheckpointWriter::set_thread_num, "Set the number of write threads.")
+    .def("file_name", &CheckpointWriter::file_name, "Get the checkpoint file name.");
+
+  (void)py::class_<CheckpointReader, std::shared_ptr<CheckpointReader>>(m, "CheckpointReader_")
+    .def(py::init<const std::string &>())
+    .def("open", &CheckpointReader::Open, "Map the checkpoint file and read its index.")
+    .def("get_names", &CheckpointReader::GetNames, "Get the names of tensors in the checkpoint.")
+    .def("get_tensor", &CheckpointReader::GetTensor, py::arg("name"), "Get a tensor mapped from the checkpoint.")
+    .def("check_tensor", &CheckpointReader::CheckTensor, py::arg("name"), "Verify the crc of a tensor.");
+  (void)m.def("is_native_checkpoint", &mindspore::checkpoint::IsNativeCheckpoint, "Check the checkpoint format.");
+
   (void)py::class_<OpLib, std::shared_ptr<OpLib>>(m, "Oplib")
     .def(py::init())
     .def("reg_op", &OpLib::RegOp, "Register op info.");
@@ -310,4 +415,18 @@ PYBIND11_MODULE(_c_expression, m) {
               "Finalize gpu collective communication mode.");
 
 #endif
+#ifdef ENABLE_CPU_COLLECTIVE
+  (void)m.def("init_cpu_collective", &mindspore::device::cpu::InitCPUCollective,
+              "Init cpu collective communication mode.");
+  (void)m.def("finalize_cpu_collective", &mindspore::device::cpu::FinalizeCPUCollective,
+              "Finalize cpu collective communication mode.");
+  (void)m.def("get_cpu_collective_rank_id", &mindspore::device::cpu::GetCPUCollectiveRankId,
+              "Get the rank id of the cpu collective group.");
+  (void)m.def("get_cpu_collective_rank_size", &mindspore::device::cpu::GetCPUCollectiveRankSize,
+              "Get the rank size of the cpu collective group.");
+  (void)m.def("create_cpu_collective_group", &mindspore::device::cpu::CreateCPUCollectiveGroup,
+              "Create a cpu collective group.");
+  (void)m.def("destroy_cpu_collective_group", &mindspore::device::cpu::DestroyCPUCollectiveGroup,
+              "Destroy a cpu collective group.");
+#endif
 }
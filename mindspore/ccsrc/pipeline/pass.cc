@@ -34,6 +34,7 @@
 #include "optimizer/clean.h"
 #include "optimizer/irpass.h"
 #include "optimizer/control_depend.h"
+#include "optimizer/recompute.h"
 #include "parallel/step_parallel.h"
 #include "parallel/step_auto_parallel.h"
 #include "parallel/allreduce_fusion/step_allreduce_fusion.h"
@@ -241,6 +242,13 @@ bool AddControlDependPass(const ResourcePtr &res) {
   return true;
 }
 
+bool RecomputePass(const ResourcePtr &res) {
+  FuncGraphPtr func_graph = res->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  (void)opt::Recompute(func_graph, res->manager());
+  return true;
+}
+
 bool CconvPass(const ResourcePtr &res) {
   MS_EXCEPTION_IF_NULL(res->func_graph());
   FuncGraphPtr func_graph = res->func_graph();
@@ -268,12 +276,14 @@ bool InferenceOptPreparePass(const ResourcePtr &res) {
 std::vector<PassItem> kVmPasses = {{"simplify_data_structures", SimplifyDataStructuresPass},
                                    {"opt_a", OptPassAGroup},
                                    {"opt_b", OptPassBGroup},
+                                   {"recompute", RecomputePass},
                                    {"add_control_depend", AddControlDependPass},
                                    {"cconv", CconvPass}};
 
 std::vector<PassItem> kGePasses = {{"simplify_data_structures", SimplifyDataStructuresPass},
                                    {"opt_a", OptPassAGroup},
                                    {"opt_b", OptPassBGroup},
+                                   {"recompute", RecomputePass},
                                    {"add_control_depend", AddControlDependPass},
                                    {"opt_control", ControlGroup},
                                    {"opt_prepare", PrepareGroup},
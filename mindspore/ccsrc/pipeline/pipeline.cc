@@ -632,6 +632,8 @@ py::object ExecutorPy::Run(const py::tuple &args, const py::object &phase) {
     MS_LOG(EXCEPTION) << "Run failed, phase input is not a str";
   }
   auto phase_s = py::cast<std::string>(phase);
+  // inputs of the graph may be produced by pynative ops which are still running
+  pynative::SyncPyNativeOps();
   std::string backend = MsContext::GetInstance()->backend_policy();
 #ifdef ENABLE_GE
   if (backend == "ge") {
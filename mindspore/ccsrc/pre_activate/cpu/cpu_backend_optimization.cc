@@ -0,0 +1,79 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/cpu_backend_optimization.h"
+#include <memory>
+#include <string>
+#include "operator/ops.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/cpu/ir_fusion/biasadd_fusion.h"
+#include "pre_activate/cpu/ir_fusion/activation_fusion.h"
+#include "pre_activate/cpu/ir_fusion/elemwise_fusion.h"
+#include "pre_activate/cpu/layout_propagation.h"
+#include "utils/context/ms_context.h"
+#include "utils/utils.h"
+#include "debug/anf_ir_dump.h"
+
+namespace mindspore {
+namespace opt {
+void CPUBackendIRFusionOptimization(const std::shared_ptr<session::KernelGraph> &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  if (!context_ptr->ir_fusion_flag()) {
+    MS_LOG(INFO) << "IRFusion is not enable, skip";
+    return;
+  }
+  bool save_graphs = context_ptr->save_graphs_flag();
+  auto save_graphs_path = context_ptr->save_graphs_path();
+  if (save_graphs_path.empty()) {
+    save_graphs_path = ".";
+  }
+  if (save_graphs) {
+    std::string file_path = save_graphs_path + "/" + "hwopt_cpu_ir_fusion_before" + "_graph_" +
+                            std::to_string(kernel_graph->graph_id()) + ".ir";
+    DumpIR(file_path, kernel_graph);
+  }
+  auto optimizer = std::make_shared<GraphOptimizer>();
+  auto ir_fusion_pm = std::make_shared<PassManager>("cpu_ir_fusion_pm");
+  // the bias is folded first so that conv + bias + relu ends up in one primitive
+  ir_fusion_pm->AddPass(std::make_shared<CPUBiasAddFusion>(prim::kPrimConv2D));
+  ir_fusion_pm->AddPass(std::make_shared<CPUBiasAddFusion>(prim::kPrimMatMul));
+  ir_fusion_pm->AddPass(std::make_shared<CPUActivationFusion>(prim::kPrimConv2D));
+  ir_fusion_pm->AddPass(std::make_shared<CPUActivationFusion>(prim::kPrimMatMul));
+  ir_fusion_pm->AddPass(std::make_shared<CPUActivationFusion>(std::make_shared<Primitive>(kBiasAddOpName)));
+  ir_fusion_pm->AddPass(std::make_shared<CPUActivationFusion>(prim::kPrimMul));
+  // the elementwise ops left are folded into single pass loops
+  ir_fusion_pm->AddPass(std::make_shared<CPUElemwiseFusion>());
+  optimizer->AddPassManager(ir_fusion_pm);
+  (void)optimizer->Optimize(kernel_graph);
+  kernel_graph->SetExecOrderByDefault();
+  if (save_graphs) {
+    std::string file_path = save_graphs_path + "/" + "hwopt_cpu_ir_fusion_after" + "_graph_" +
+                            std::to_string(kernel_graph->graph_id()) + ".ir";
+    DumpIR(file_path, kernel_graph);
+  }
+}
+
+void CPUDataLayout(const std::shared_ptr<session::KernelGraph> &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto optimizer = std::make_shared<GraphOptimizer>();
+  auto data_layout_pm = std::make_shared<PassManager>("cpu_data_layout_pm");
+  data_layout_pm->AddPass(std::make_shared<CPULayoutPropagation>());
+  optimizer->AddPassManager(data_layout_pm);
+  (void)optimizer->Optimize(kernel_graph);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/ir_fusion/activation_fusion.h"
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+#include "operator/ops.h"
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kProducerInputIndex = 1;
+constexpr size_t kMulInputNum = 3;
+
+// the fused mul kernel only handles the inputs of the same shape or the tensor * scalar case
+bool IsFusibleMul(const CNodePtr &mul) {
+  if (mul->size() != kMulInputNum) {
+    return false;
+  }
+  auto shape0 = AnfAlgo::GetPrevNodeOutputInferShape(mul, 0);
+  auto shape1 = AnfAlgo::GetPrevNodeOutputInferShape(mul, 1);
+  size_t size1 = std::accumulate(shape1.begin(), shape1.end(), size_t(1), std::multiplies<size_t>());
+  return shape0 == shape1 || size1 == 1;
+}
+}  // namespace
+
+const BaseRef CPUActivationFusion::DefinePattern() const {
+  VarPtr Xs = std::make_shared<SeqVar>();
+  return VectorRef({prim::kPrimRelu, VectorRef({prim_, Xs})});
+}
+
+const AnfNodePtr CPUActivationFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node,
+                                              const EquivPtr &) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(node);
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  CheckCNodeInputSize(cnode, kReluInputNum);
+  auto producer = cnode->input(kProducerInputIndex)->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(producer);
+  if (IsUsedByOthers(graph, producer) || AnfAlgo::HasNodeAttr(kAttrFusedActivation, producer)) {
+    return nullptr;
+  }
+  if (prim_->name() == prim::kPrimMul->name() && !IsFusibleMul(producer)) {
+    return nullptr;
+  }
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(prim_->name()))};
+  for (size_t index = 1; index < producer->size(); ++index) {
+    inputs.push_back(producer->input(index));
+  }
+  auto fusion_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fusion_node);
+  fusion_node->set_scope(cnode->scope());
+  fusion_node->set_abstract(cnode->abstract());
+  AnfAlgo::CopyNodeAttrs(producer, fusion_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedActivation, MakeValue(prim::kPrimRelu->name()), fusion_node);
+  return fusion_node;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/ir_fusion/biasadd_fusion.h"
+#include <memory>
+#include <vector>
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kProducerInputIndex = 1;
+constexpr size_t kBiasInputIndex = 2;
+}  // namespace
+
+const BaseRef CPUBiasAddFusion::DefinePattern() const {
+  VarPtr X0 = std::make_shared<Var>();
+  VarPtr X1 = std::make_shared<Var>();
+  VarPtr X2 = std::make_shared<Var>();
+  const auto prim_bias_add = std::make_shared<Primitive>(kBiasAddOpName);
+  return VectorRef({prim_bias_add, VectorRef({prim_, X0, X1}), X2});
+}
+
+const AnfNodePtr CPUBiasAddFusion::Process(const FuncGraphPtr &graph, const AnfNodePtr &node,
+                                           const EquivPtr &) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(node);
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  CheckCNodeInputSize(cnode, kBiasAddInputNum);
+  auto producer = cnode->input(kProducerInputIndex)->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(producer);
+  // the output without bias is still needed, or the producer has been fused already
+  if (IsUsedByOthers(graph, producer) || AnfAlgo::HasNodeAttr(kAttrHasBias, producer) ||
+      AnfAlgo::HasNodeAttr(kAttrFusedActivation, producer)) {
+    return nullptr;
+  }
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(prim_->name()))};
+  for (size_t index = 1; index < producer->size(); ++index) {
+    inputs.push_back(producer->input(index));
+  }
+  inputs.push_back(cnode->input(kBiasInputIndex));
+  auto fusion_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fusion_node);
+  fusion_node->set_scope(cnode->scope());
+  fusion_node->set_abstract(cnode->abstract());
+  AnfAlgo::CopyNodeAttrs(producer, fusion_node);
+  AnfAlgo::SetNodeAttr(kAttrHasBias, MakeValue(true), fusion_node);
+  return fusion_node;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,38 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_BIASADD_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_BIASADD_FUSION_H_
+
+#include "pre_activate/common/optimizer.h"
+
+namespace mindspore {
+namespace opt {
+// BiasAdd(prim(x, w), b) -> prim(x, w, b), the bias is added by the mkl-dnn primitive of prim
+class CPUBiasAddFusion : public PatternProcessPass {
+ public:
+  explicit CPUBiasAddFusion(const PrimitivePtr &prim, bool multigraph = true)
+      : PatternProcessPass("cpu_" + prim->name() + "_biasadd_fusion", multigraph), prim_(prim) {}
+  ~CPUBiasAddFusion() override = default;
+  const BaseRef DefinePattern() const override;
+  const AnfNodePtr Process(const FuncGraphPtr &, const AnfNodePtr &, const EquivPtr &) const override;
+
+ private:
+  PrimitivePtr prim_;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_BIASADD_FUSION_H_
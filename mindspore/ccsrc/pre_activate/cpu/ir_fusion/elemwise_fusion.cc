@@ -0,0 +1,155 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/ir_fusion/elemwise_fusion.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "operator/ops.h"
+#include "pre_activate/common/helper.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// the operand of a fused op which is the result of the previous one, the kChainOperand of the fused elemwise kernel
+constexpr int kChainOperand = -1;
+
+size_t ElemNum(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+// the ops computed by the fused elemwise kernel, on inputs of the size of the output or on scalars for a mul
+bool IsFusibleElemwise(const AnfNodePtr &node) {
+  static const std::set<std::string> kElemwiseOps = {prim::kPrimRelu->name(), prim::kPrimGelu->name(),
+                                                     prim::kPrimMul->name(), prim::kPrimReluGrad->name()};
+  MS_EXCEPTION_IF_NULL(node);
+  if (!node->isa<CNode>() || !AnfAlgo::IsRealKernel(node)) {
+    return false;
+  }
+  auto name = AnfAlgo::GetCNodeName(node);
+  if (kElemwiseOps.count(name) == 0 || AnfAlgo::GetOutputTensorNum(node) != 1 ||
+      AnfAlgo::GetOutputInferDataType(node, 0) != kNumberTypeFloat32) {
+    return false;
+  }
+  bool is_mul = name == prim::kPrimMul->name();
+  if (!is_mul && AnfAlgo::HasNodeAttr(kAttrFusedActivation, node->cast<CNodePtr>())) {
+    return false;
+  }
+  size_t elem_num = ElemNum(AnfAlgo::GetOutputInferShape(node, 0));
+  for (size_t index = 0; index < AnfAlgo::GetInputTensorNum(node); ++index) {
+    if (AnfAlgo::GetPrevNodeOutputInferDataType(node, index) != kNumberTypeFloat32) {
+      return false;
+    }
+    size_t input_num = ElemNum(AnfAlgo::GetPrevNodeOutputInferShape(node, index));
+    if (input_num != elem_num && !(is_mul && input_num == 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the input of the consumer which joins its chain, nullptr if there is none
+CNodePtr GetChainProducer(const FuncGraphPtr &graph, const CNodePtr &consumer,
+                          const std::unordered_set<AnfNodePtr> &visited) {
+  auto shape = AnfAlgo::GetOutputInferShape(consumer, 0);
+  for (size_t index = 1; index < consumer->size(); ++index) {
+    auto input = consumer->input(index);
+    if (visited.count(input) > 0 || !IsFusibleElemwise(input) || AnfAlgo::GetOutputInferShape(input, 0) != shape ||
+        IsUsedByOthers(graph, input)) {
+      continue;
+    }
+    return input->cast<CNodePtr>();
+  }
+  return nullptr;
+}
+
+// the fused node of the chain, whose first op is the one on the graph inputs
+CNodePtr CreateFusedNode(const FuncGraphPtr &graph, const std::vector<CNodePtr> &chain) {
+  std::vector<AnfNodePtr> inputs = {NewValueNode(std::make_shared<Primitive>(kFusedElemwiseOpName))};
+  std::vector<std::string> ops;
+  std::vector<int> operands;
+  for (size_t i = 0; i < chain.size(); ++i) {
+    auto &node = chain[i];
+    for (size_t index = 1; index < node->size(); ++index) {
+      auto input = node->input(index);
+      if (i > 0 && input == chain[i - 1]) {
+        operands.push_back(kChainOperand);
+        continue;
+      }
+      auto iter = std::find(inputs.begin() + 1, inputs.end(), input);
+      operands.push_back(SizeToInt(iter - inputs.begin()) - 1);
+      if (iter == inputs.end()) {
+        inputs.push_back(input);
+      }
+    }
+    ops.push_back(AnfAlgo::GetCNodeName(node));
+    if (AnfAlgo::HasNodeAttr(kAttrFusedActivation, node)) {
+      ops.push_back(AnfAlgo::GetNodeAttr<std::string>(node, kAttrFusedActivation));
+      operands.push_back(kChainOperand);
+    }
+  }
+  auto fused_node = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOps, MakeValue(ops), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOperands, MakeValue(operands), fused_node);
+  return fused_node;
+}
+}  // namespace
+
+bool CPUElemwiseFusion::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto manager = func_graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  std::vector<AnfNodePtr> node_list = TopoSort(func_graph->get_return());
+  std::unordered_set<AnfNodePtr> visited;
+  bool changed = false;
+  // the chains grow from their last op towards the inputs
+  for (auto iter = node_list.rbegin(); iter != node_list.rend(); ++iter) {
+    auto &node = *iter;
+    if (visited.count(node) > 0 || !IsFusibleElemwise(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    std::vector<CNodePtr> chain = {cnode};
+    (void)visited.insert(cnode);
+    for (auto producer = GetChainProducer(func_graph, cnode, visited); producer != nullptr;
+         producer = GetChainProducer(func_graph, producer, visited)) {
+      chain.push_back(producer);
+      (void)visited.insert(producer);
+    }
+    if (chain.size() < 2) {
+      continue;
+    }
+    std::reverse(chain.begin(), chain.end());
+    auto fused_node = CreateFusedNode(func_graph, chain);
+    fused_node->set_scope(cnode->scope());
+    fused_node->set_abstract(cnode->abstract());
+    MS_LOG(INFO) << "Fuse " << chain.size() << " elemwise ops into " << fused_node->DebugString();
+    (void)manager->Replace(cnode, fused_node);
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,37 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_ELEMWISE_FUSION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_ELEMWISE_FUSION_H_
+
+#include "ir/anf.h"
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Fold the chains of float32 elementwise ops (ReLU, Gelu, Mul, ReluGrad) into one FusedElemwise node, whose kernel
+// computes the chain in a single pass over the memory. An op joins the chain of its user if the user is its only one
+// and their outputs have the same shape, the other inputs of the ops become the inputs of the fused node.
+// It runs after the activation fusions, a mul with a fused relu is taken as a mul followed by a relu.
+class CPUElemwiseFusion : public Pass {
+ public:
+  CPUElemwiseFusion() : Pass("cpu_elemwise_fusion") {}
+  ~CPUElemwiseFusion() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_IR_FUSION_ELEMWISE_FUSION_H_
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/layout_propagation.h"
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kDataInputIndex = 1;
+
+// the kernels which read their data input and write their output in any mkl-dnn layout
+bool IsLayoutAwareKernel(const AnfNodePtr &node) {
+  static const std::set<std::string> kLayoutAwareOps = {prim::kPrimConv2D->name(), prim::kPrimRelu->name(),
+                                                        prim::kPrimMaxPool->name()};
+  MS_EXCEPTION_IF_NULL(node);
+  return node->isa<CNode>() && AnfAlgo::IsRealKernel(node) && kLayoutAwareOps.count(AnfAlgo::GetCNodeName(node)) > 0;
+}
+}  // namespace
+
+bool CPULayoutPropagation::Run(const FuncGraphPtr &func_graph) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  std::vector<AnfNodePtr> node_list = TopoSort(func_graph->get_return());
+  std::unordered_map<AnfNodePtr, bool> keep_blocked;
+  for (const auto &node : node_list) {
+    MS_EXCEPTION_IF_NULL(node);
+    if (!node->isa<CNode>()) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    for (size_t index = 1; index < cnode->size(); ++index) {
+      auto input = cnode->input(index);
+      if (!IsLayoutAwareKernel(input)) {
+        continue;
+      }
+      bool accepted = index == kDataInputIndex && IsLayoutAwareKernel(cnode);
+      auto iter = keep_blocked.find(input);
+      if (iter == keep_blocked.end()) {
+        keep_blocked[input] = accepted;
+      } else {
+        iter->second = iter->second && accepted;
+      }
+    }
+  }
+  bool changed = false;
+  for (const auto &node : node_list) {
+    if (!IsLayoutAwareKernel(node)) {
+      continue;
+    }
+    auto iter = keep_blocked.find(node);
+    bool blocked = iter != keep_blocked.end() && iter->second;
+    AnfAlgo::SetNodeAttr(kAttrBlockedLayout, MakeValue(blocked), node);
+    changed = changed || blocked;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
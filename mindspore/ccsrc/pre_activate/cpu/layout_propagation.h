@@ -0,0 +1,36 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_LAYOUT_PROPAGATION_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_LAYOUT_PROPAGATION_H_
+
+#include "ir/anf.h"
+#include "pre_activate/common/pass.h"
+
+namespace mindspore {
+namespace opt {
+// Mark the mkl-dnn kernels whose output may stay in the blocked layout chosen by their primitive.
+// The output is kept blocked only if every user reads it as the data input of a layout aware kernel,
+// so the reorders from and to the plain layout happen at the boundaries of such chains.
+class CPULayoutPropagation : public Pass {
+ public:
+  CPULayoutPropagation() : Pass("cpu_layout_propagation") {}
+  ~CPULayoutPropagation() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_CPU_LAYOUT_PROPAGATION_H_
@@ -15,35 +15,127 @@
  */
 
 #include "pre_activate/mem_reuse/mem_dynamic_allocator.h"
+#include <cstdint>
 #include "common/utils.h"
 #include "utils/convert_utils.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace device {
+namespace {
+// The size classes step by a quarter of the power of two below them, so a small memory wastes at most 25%.
+constexpr size_t kSizeClassStepsPerPower = 4;
+}  // namespace
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit()
+    : stream_caches_(DYNAMIC_MEM_STREAM_CACHE_NUM), small_mem_buf_shards_(DYNAMIC_MEM_SMALL_BUF_SHARD_NUM) {
+  size_t size = DYNAMIC_MEM_ALIGN_SIZE;
+  while (size <= DYNAMIC_MEM_SMALL_SIZE) {
+    size_class_sizes_.push_back(size);
+    size_t power = DYNAMIC_MEM_ALIGN_SIZE;
+    while (power * 2 <= size) {
+      power *= 2;
+    }
+    size += std::max(DYNAMIC_MEM_ALIGN_SIZE, power / kSizeClassStepsPerPower);
+  }
+  for (auto &stream_cache : stream_caches_) {
+    stream_cache.size_class_bins_.resize(size_class_sizes_.size());
+  }
+}
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
   global_mem_block_list_.clear();
   global_idle_mem_buf_map_.clear();
 }
 
-DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size) {
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size, uint32_t stream_id) {
   size_t align_size = AlignMemorySize(size);
+  if (align_size <= DYNAMIC_MEM_SMALL_SIZE && stream_id < DYNAMIC_MEM_STREAM_CACHE_NUM) {
+    return AllocSmallTensorMem(SizeClassIndex(align_size), stream_id);
+  }
+  size_t mem_buf_size = 0;
+  DeviceMemPtr device_addr = AllocMemBufFromBlock(align_size, &mem_buf_size);
+  if (device_addr != nullptr) {
+    total_used_mem_statistics_ += mem_buf_size;
+    UpdateUsedMemPeak();
+  }
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocMemBufFromBlock(size_t size, size_t *mem_buf_size) {
+  MS_EXCEPTION_IF_NULL(mem_buf_size);
+  std::unique_lock<std::mutex> lock(mem_lock_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
-  DeviceMemPtr device_addr = FindIdleMemBuf(align_size);
+  DeviceMemPtr device_addr = FindIdleMemBuf(size);
+  if (!device_addr && cached_mem_statistics_ > 0) {
+    // Combine the cached memory buf before asking the device for more memory.
+    lock.unlock();
+    FlushMemCache();
+    lock.lock();
+    device_addr = FindIdleMemBuf(size);
+  }
+  if (!device_addr) {
+    device_addr = AddMemBlockAndMemBuf(size);
+  }
   if (!device_addr) {
-    device_addr = AddMemBlockAndMemBuf(align_size);
+    return nullptr;
+  }
+  auto mem_block = FindMemBlock(device_addr);
+  MS_EXCEPTION_IF_NULL(mem_block);
+  auto iter = mem_block->block_all_mem_buf_map_.find(device_addr);
+  if (iter == mem_block->block_all_mem_buf_map_.end()) {
+    MS_LOG(EXCEPTION) << "Can't find the device address[" << device_addr << "].";
   }
+  MS_EXCEPTION_IF_NULL(iter->second);
+  *mem_buf_size = iter->second->size_;
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocSmallTensorMem(size_t size_class, uint32_t stream_id) {
+  size_t size = size_class_sizes_[size_class];
+  auto &stream_cache = stream_caches_[stream_id];
+  DeviceMemPtr device_addr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(stream_cache.lock_);
+    auto &bin = stream_cache.size_class_bins_[size_class];
+    if (!bin.empty()) {
+      device_addr = bin.back();
+      bin.pop_back();
+      stream_cache.cached_size_ -= size;
+      cached_mem_statistics_ -= size;
+    }
+  }
+  if (device_addr != nullptr) {
+    auto &shard = GetSmallMemBufShard(device_addr);
+    std::lock_guard<std::mutex> lock(shard.lock_);
+    shard.mem_bufs_[device_addr].cached_ = false;
+  } else {
+    size_t mem_buf_size = 0;
+    device_addr = AllocMemBufFromBlock(size, &mem_buf_size);
+    if (device_addr == nullptr) {
+      return nullptr;
+    }
+    auto &shard = GetSmallMemBufShard(device_addr);
+    std::lock_guard<std::mutex> lock(shard.lock_);
+    shard.mem_bufs_[device_addr] = {stream_id, size_class, false};
+  }
+  total_used_mem_statistics_ += size;
+  UpdateUsedMemPeak();
   return device_addr;
 }
 
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           std::vector<size_t> size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size);
+  // Pre-alloc the one whole piece memory, never from the stream caches because it is split below.
+  size_t mem_buf_size = 0;
+  auto device_addr = AllocMemBufFromBlock(AlignMemorySize(total_size), &mem_buf_size);
   if (!device_addr) {
     return device_addr_list;
   }
+  total_used_mem_statistics_ += mem_buf_size;
+  UpdateUsedMemPeak();
+  std::lock_guard<std::mutex> lock(mem_lock_);
   // Remove the pre-alloc memory.
   auto mem_block = FindMemBlock(device_addr);
   MS_EXCEPTION_IF_NULL(mem_block);
@@ -69,6 +161,28 @@ std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t
   return device_addr_list;
 }
 
+size_t DynamicMemPoolBestFit::SizeClassIndex(size_t size) const {
+  auto iter = std::lower_bound(size_class_sizes_.begin(), size_class_sizes_.end(), size);
+  if (iter == size_class_sizes_.end()) {
+    MS_LOG(EXCEPTION) << "The size[" << size << "] is larger than the small memory size[" << DYNAMIC_MEM_SMALL_SIZE
+                      << "].";
+  }
+  return IntToSize(iter - size_class_sizes_.begin());
+}
+
+SmallMemBufShard &DynamicMemPoolBestFit::GetSmallMemBufShard(const DeviceMemPtr device_addr) {
+  // The memory buf are aligned to 512, the low bits carry no information.
+  auto key = reinterpret_cast<uintptr_t>(device_addr) / DYNAMIC_MEM_ALIGN_SIZE;
+  return small_mem_buf_shards_[key % DYNAMIC_MEM_SMALL_BUF_SHARD_NUM];
+}
+
+void DynamicMemPoolBestFit::UpdateUsedMemPeak() {
+  size_t used_size = total_used_mem_statistics_;
+  size_t peak_size = used_mem_peak_statistics_;
+  while (used_size > peak_size && !used_mem_peak_statistics_.compare_exchange_weak(peak_size, used_size)) {
+  }
+}
+
 size_t DynamicMemPoolBestFit::AlignMemorySize(size_t size) const {
   if (size == 0) {
     return DYNAMIC_MEM_ALIGN_SIZE;
@@ -92,11 +206,6 @@ DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size) {
     if (IsDivide(size, mem_buf->size_)) {
       DivideMemBuf(size, mem_buf);
     }
-    // Memory statistics
-    total_used_mem_statistics_ += mem_buf->size_;
-    if (total_used_mem_statistics_ > used_mem_peak_statistics_) {
-      used_mem_peak_statistics_ = total_used_mem_statistics_;
-    }
     return mem_buf->device_addr_;
   }
   return nullptr;
@@ -130,10 +239,6 @@ DeviceMemPtr DynamicMemPoolBestFit::AddMemBlockAndMemBuf(size_t size) {
   }
   // Memory statistics
   total_mem_statistics_ += real_alloc_size;
-  total_used_mem_statistics_ += mem_buf->size_;
-  if (total_used_mem_statistics_ > used_mem_peak_statistics_) {
-    used_mem_peak_statistics_ = total_used_mem_statistics_;
-  }
   return mem_buf->device_addr_;
 }
 
@@ -190,12 +295,85 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr device
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  if (FreeSmallTensorMem(device_addr)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mem_lock_);
+  total_used_mem_statistics_ -= FreeMemBufToBlock(device_addr);
+}
+
+bool DynamicMemPoolBestFit::FreeSmallTensorMem(const DeviceMemPtr device_addr) {
+  SmallMemBufInfo mem_buf_info{0, 0, false};
+  {
+    auto &shard = GetSmallMemBufShard(device_addr);
+    std::lock_guard<std::mutex> lock(shard.lock_);
+    auto iter = shard.mem_bufs_.find(device_addr);
+    if (iter == shard.mem_bufs_.end()) {
+      return false;
+    }
+    // Caching the memory buf twice would hand it out to two tensors.
+    if (iter->second.cached_) {
+      MS_LOG(ERROR) << "Free the small memory buf twice, mem_buf_address[" << device_addr << "].";
+      return true;
+    }
+    iter->second.cached_ = true;
+    mem_buf_info = iter->second;
+  }
+  size_t size = size_class_sizes_[mem_buf_info.size_class_];
+  total_used_mem_statistics_ -= size;
+  auto &stream_cache = stream_caches_[mem_buf_info.stream_id_];
+  bool need_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(stream_cache.lock_);
+    stream_cache.size_class_bins_[mem_buf_info.size_class_].push_back(device_addr);
+    stream_cache.cached_size_ += size;
+    cached_mem_statistics_ += size;
+    need_flush = stream_cache.cached_size_ > DYNAMIC_MEM_STREAM_CACHE_SIZE;
+  }
+  if (need_flush) {
+    FlushStreamCache(&stream_cache);
+  }
+  return true;
+}
+
+void DynamicMemPoolBestFit::FlushStreamCache(DynamicMemStreamCache *stream_cache) {
+  MS_EXCEPTION_IF_NULL(stream_cache);
+  std::vector<std::vector<DeviceMemPtr>> size_class_bins(size_class_sizes_.size());
+  {
+    std::lock_guard<std::mutex> lock(stream_cache->lock_);
+    size_class_bins.swap(stream_cache->size_class_bins_);
+    cached_mem_statistics_ -= stream_cache->cached_size_;
+    stream_cache->cached_size_ = 0;
+  }
+  for (auto &bin : size_class_bins) {
+    for (auto device_addr : bin) {
+      auto &shard = GetSmallMemBufShard(device_addr);
+      std::lock_guard<std::mutex> lock(shard.lock_);
+      (void)shard.mem_bufs_.erase(device_addr);
+    }
+  }
+  // The deferred combination of the memory buf.
+  std::lock_guard<std::mutex> lock(mem_lock_);
+  for (auto &bin : size_class_bins) {
+    for (auto device_addr : bin) {
+      (void)FreeMemBufToBlock(device_addr);
+    }
+  }
+}
+
+void DynamicMemPoolBestFit::FlushMemCache() {
+  for (auto &stream_cache : stream_caches_) {
+    FlushStreamCache(&stream_cache);
+  }
+}
+
+size_t DynamicMemPoolBestFit::FreeMemBufToBlock(const DeviceMemPtr device_addr) {
   auto mem_block = FindMemBlock(device_addr);
   MS_EXCEPTION_IF_NULL(mem_block);
-  CombineMemBuf(mem_block, device_addr);
+  return CombineMemBuf(mem_block, device_addr);
 }
 
-void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, const DeviceMemPtr device_addr) {
+size_t DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, const DeviceMemPtr device_addr) {
   MS_EXCEPTION_IF_NULL(mem_block);
   MS_EXCEPTION_IF_NULL(device_addr);
   auto iter = mem_block->block_all_mem_buf_map_.find(device_addr);
@@ -208,7 +386,7 @@ void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, c
     MS_LOG(EXCEPTION) << "Find the mem_buf is not used, mem_buf_address[" << mem_buf->device_addr_ << "].";
   }
   mem_buf->status_ = kMemBufIdle;
-  total_used_mem_statistics_ -= mem_buf->size_;
+  size_t free_size = mem_buf->size_;
   // Combine backward(combine the next_mem_buf to mem_buf)
   auto next_iter = iter;
   (void)next_iter++;
@@ -242,6 +420,7 @@ void DynamicMemPoolBestFit::CombineMemBuf(const DynamicMemBlockPtr &mem_block, c
   } else {
     (void)global_idle_mem_buf_map_.emplace(mem_buf->size_, mem_buf);
   }
+  return free_size;
 }
 
 void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr device_addr) {
@@ -259,9 +438,36 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr devi
   MS_LOG(ERROR) << "Can't find the size[" << size << "] and device address[" << device_addr << "] in the idle mem_buf.";
 }
 
+DynamicMemPoolStatistics DynamicMemPoolBestFit::GetMemStatistics() {
+  DynamicMemPoolStatistics statistics;
+  statistics.total_size_ = total_mem_statistics_;
+  statistics.used_size_ = total_used_mem_statistics_;
+  statistics.used_peak_size_ = used_mem_peak_statistics_;
+  statistics.cached_size_ = cached_mem_statistics_;
+  std::lock_guard<std::mutex> lock(mem_lock_);
+  for (auto &idle_mem_buf : global_idle_mem_buf_map_) {
+    statistics.idle_size_ += idle_mem_buf.first;
+  }
+  if (!global_idle_mem_buf_map_.empty()) {
+    statistics.max_idle_buf_size_ = global_idle_mem_buf_map_.rbegin()->first;
+    statistics.fragmentation_ = 1.0 - static_cast<double>(statistics.max_idle_buf_size_) / statistics.idle_size_;
+  }
+  return statistics;
+}
+
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
-  MS_LOG(INFO) << "The dynamic memmory pool total size is " << total_mem_statistics_ << ", total used size is "
-               << total_used_mem_statistics_ << ", used peak size is " << used_mem_peak_statistics_ << ".";
+  auto statistics = GetMemStatistics();
+  MS_LOG(INFO) << "The dynamic memmory pool total size is " << statistics.total_size_ << ", total used size is "
+               << statistics.used_size_ << ", used peak size is " << statistics.used_peak_size_
+               << ", cached size is " << statistics.cached_size_ << ", fragmentation is " << statistics.fragmentation_
+               << ".";
+  FlushMemCache();
+  // The small memory buf still in use are dropped with their memory blocks.
+  for (auto &shard : small_mem_buf_shards_) {
+    std::lock_guard<std::mutex> shard_lock(shard.lock_);
+    shard.mem_bufs_.clear();
+  }
+  std::lock_guard<std::mutex> lock(mem_lock_);
   for (auto iter = global_mem_block_list_.begin(); iter != global_mem_block_list_.end(); ++iter) {
     auto device_addr = (*iter)->device_addr();
     if (device_addr != nullptr) {
@@ -270,9 +476,17 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
       }
     }
   }
+  // The pool is empty and can be used again.
+  global_mem_block_list_.clear();
+  global_idle_mem_buf_map_.clear();
+  total_mem_statistics_ = 0;
+  total_used_mem_statistics_ = 0;
+  used_mem_peak_statistics_ = 0;
+  cached_mem_statistics_ = 0;
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
+  std::lock_guard<std::mutex> lock(mem_lock_);
   MS_LOG(INFO) << "Start dump dynamic memory pool info.";
   DeviceAddrMapMemBuf mem_block_map;
   DynamicMemBufPtr mem_buf;
@@ -311,7 +525,7 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
   }
   // Dump the memory statistical info
   MS_LOG(INFO) << "Total allocated memory[" << total_mem << "], used memory[" << total_used_mem << "], idle memory["
-               << total_idle_mem1 << "].";
+               << total_idle_mem1 << "], cached memory[" << cached_mem_statistics_ << "].";
   if (total_idle_mem1 != total_idle_mem2) {
     MS_LOG(ERROR) << "Check error: the idle memory in the mem_block is not equal the global idle memory.";
   }
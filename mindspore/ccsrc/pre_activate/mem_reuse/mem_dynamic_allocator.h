@@ -19,9 +19,12 @@
 
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <utility>
+#include <atomic>
+#include <mutex>
 
 namespace mindspore {
 namespace device {
@@ -36,6 +39,18 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (500M) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 500 << 20;
 
+// The allocations up to this size (1M) are rounded up to a size class and cached per stream when freed.
+static const size_t DYNAMIC_MEM_SMALL_SIZE = 1 << 20;
+
+// The streams whose id is below this have a cache of small memory buf, the others always use the memory blocks.
+static const size_t DYNAMIC_MEM_STREAM_CACHE_NUM = 8;
+
+// The cache of a stream is flushed back to the memory blocks when it holds more than this (256M).
+static const size_t DYNAMIC_MEM_STREAM_CACHE_SIZE = 256 << 20;
+
+// The number of shards of the small memory buf records, each shard has its own lock.
+static const size_t DYNAMIC_MEM_SMALL_BUF_SHARD_NUM = 16;
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr addr1, const DeviceMemPtr addr2) const { return addr1 < addr2; }
@@ -72,18 +87,61 @@ class DynamicMemBlock {
 };
 using DynamicMemBlockPtr = std::shared_ptr<DynamicMemBlock>;
 
-// The main class of dynamic memory pool.
+// The freed small memory buf of one stream by size class. They are only reused by the same stream, and are not
+// combined with their neighbours until the cache is flushed.
+struct DynamicMemStreamCache {
+  std::mutex lock_;
+  std::vector<std::vector<DeviceMemPtr>> size_class_bins_;
+  size_t cached_size_{0};
+};
+
+// The record of a small memory buf, in use or in a stream cache.
+struct SmallMemBufInfo {
+  uint32_t stream_id_;
+  size_t size_class_;
+  // Whether the memory buf is free in the stream cache, to detect a double free.
+  bool cached_;
+};
+
+// A shard of the small memory buf records by device address.
+struct SmallMemBufShard {
+  std::mutex lock_;
+  std::unordered_map<DeviceMemPtr, SmallMemBufInfo> mem_bufs_;
+};
+
+// The statistics of the dynamic memory pool.
+struct DynamicMemPoolStatistics {
+  // The device memory held by the pool, it never shrinks so it is also the high watermark of the pool.
+  size_t total_size_{0};
+  // The memory held by the tensors and its high watermark.
+  size_t used_size_{0};
+  size_t used_peak_size_{0};
+  // The freed small memory buf kept in the stream caches.
+  size_t cached_size_{0};
+  // The idle memory in the memory blocks and the largest idle memory buf.
+  size_t idle_size_{0};
+  size_t max_idle_buf_size_{0};
+  // The share of the idle memory that the largest idle memory buf can't serve, 0 when it is all in one piece.
+  double fragmentation_{0};
+};
+
+// The main class of dynamic memory pool. The large allocations are served best fit from the memory blocks under one
+// lock. The small ones are rounded up to a size class, and when freed they go to the cache of the stream that
+// allocated them, so that allocating and freeing them again only takes the lock of that stream cache. The caches are
+// flushed back to the memory blocks, and the memory buf combined, when the blocks run out of idle memory.
 class DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit() = default;
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
   // The main program entry of memory alloc.
-  DeviceMemPtr AllocTensorMem(size_t size);
+  DeviceMemPtr AllocTensorMem(size_t size, uint32_t stream_id = 0);
   // The main program entry of continuous memory alloc.
   std::vector<DeviceMemPtr> AllocContinuousTensorMem(size_t total_size, std::vector<size_t> size_list);
   // The main program entry of memory free.
   void FreeTensorMem(const DeviceMemPtr device_addr);
-  // Release the real device memory.
+  // Return the memory buf of the stream caches to the memory blocks.
+  void FlushMemCache();
+  // Release the real device memory, and reset the pool to empty.
   void ReleaseDeviceRes();
   // Display the information of memory block and memory buf.
   void DumpDynamicMemPoolInfo();
@@ -92,6 +150,8 @@ class DynamicMemPoolBestFit {
   size_t total_mem_statistics() const { return total_mem_statistics_; }
   size_t used_mem_statistics() const { return total_used_mem_statistics_; }
   size_t used_mem_peak_statistics() const { return used_mem_peak_statistics_; }
+  size_t cached_mem_statistics() const { return cached_mem_statistics_; }
+  DynamicMemPoolStatistics GetMemStatistics();
 
   // The related interface of device memory real operation, needs override by device type.
   virtual size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) = 0;
@@ -106,6 +166,18 @@ class DynamicMemPoolBestFit {
   virtual size_t mem_alloc_unit_size() const { return DYNAMIC_MEM_ALLOC_UNIT_SIZE; }
 
  private:
+  // Alloc the memory buf from the memory blocks, and return the real size of the memory buf in mem_buf_size.
+  DeviceMemPtr AllocMemBufFromBlock(size_t size, size_t *mem_buf_size);
+  // Alloc the small memory from the stream cache, or from the memory blocks when the cache has no memory buf.
+  DeviceMemPtr AllocSmallTensorMem(size_t size_class, uint32_t stream_id);
+  // Free the small memory to its stream cache, return false if the memory is not a small one.
+  bool FreeSmallTensorMem(const DeviceMemPtr device_addr);
+  // Take all the memory buf of the stream cache and return them to the memory blocks.
+  void FlushStreamCache(DynamicMemStreamCache *stream_cache);
+  // The index of the smallest size class that holds the size.
+  size_t SizeClassIndex(size_t size) const;
+  SmallMemBufShard &GetSmallMemBufShard(const DeviceMemPtr device_addr);
+  void UpdateUsedMemPeak();
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -121,8 +193,10 @@ class DynamicMemPoolBestFit {
   // The Comparator of memory block by device address, because memory blocks are arranged in order by device address.
   static bool CmpMemBlock(const DeviceMemPtr device_addr, const DynamicMemBlockPtr mem_block);
 
-  // Combine the memory buf when memory free, to avoid the memory fragmentation.
-  void CombineMemBuf(const DynamicMemBlockPtr &mem_block, const DeviceMemPtr device_addr);
+  // Combine the memory buf when memory free, to avoid the memory fragmentation. Return the size of the freed buf.
+  size_t CombineMemBuf(const DynamicMemBlockPtr &mem_block, const DeviceMemPtr device_addr);
+  // Free the memory buf to the memory blocks, the mem_lock_ must be held.
+  size_t FreeMemBufToBlock(const DeviceMemPtr device_addr);
   // Erase the idle memory buf by size and device address when idle memory buf is combined.
   void EraseIdleMemBuf(size_t size, const DeviceMemPtr device_addr);
 
@@ -131,10 +205,18 @@ class DynamicMemPoolBestFit {
   // The map of all idle memory buf by size.
   SizeMapMemBuf global_idle_mem_buf_map_;
 
+  // The lock of the memory blocks and the idle memory buf.
+  std::mutex mem_lock_;
+  // The sizes of the size classes of the small memory, from small to large.
+  std::vector<size_t> size_class_sizes_;
+  std::vector<DynamicMemStreamCache> stream_caches_;
+  std::vector<SmallMemBufShard> small_mem_buf_shards_;
+
   // The related memory statistics information.
-  size_t total_mem_statistics_{0};
-  size_t total_used_mem_statistics_{0};
-  size_t used_mem_peak_statistics_{0};
+  std::atomic<size_t> total_mem_statistics_{0};
+  std::atomic<size_t> total_used_mem_statistics_{0};
+  std::atomic<size_t> used_mem_peak_statistics_{0};
+  std::atomic<size_t> cached_mem_statistics_{0};
 };
 }  // namespace device
 }  // namespace mindspore
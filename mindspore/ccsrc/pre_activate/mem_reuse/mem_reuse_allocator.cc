@@ -376,6 +376,9 @@ size_t BestFitMemReuse::AlignMemorySize(size_t size) const {
 }
 
 size_t BestFitMemReuse::GetAllocatedSize() {
+  if (use_pack_plan_) {
+    return pack_allocated_size_;
+  }
   size_t AllocatedSize = kTotalSize;
   if (membuf_ptr_list_.empty()) {
     return AllocatedSize;
@@ -419,9 +422,28 @@ void BestFitMemReuse::CheckTensorIndex(int tensor_index) const {
   }
 }
 
+void BestFitMemReuse::PackIfSmaller(MemPackPlanner *pack_planner) {
+  MS_EXCEPTION_IF_NULL(pack_planner);
+  size_t best_fit_size = GetAllocatedSize();
+  size_t pack_size = pack_planner->Plan();
+  // no plan for the large graphs, the best fit is kept
+  if (pack_size != 0 && pack_size < best_fit_size) {
+    MS_LOG(INFO) << "MemReuse uses the offline plan of size " << pack_size << " instead of the best fit of size "
+                 << best_fit_size;
+    pack_planner->ApplyOffsets();
+    use_pack_plan_ = true;
+    pack_allocated_size_ = pack_size;
+  }
+  MemReuseChecker::GetInstance().CheckFragmentation(GetAllocatedSize(), pack_planner->max_live_size());
+}
+
 void BestFitMemReuse::Reuse(const MemReuseUtil *mem_reuse_util_ptr) {
   MS_EXCEPTION_IF_NULL(mem_reuse_util_ptr);
   InitMemReuseInfo(mem_reuse_util_ptr);
+  use_pack_plan_ = false;
+  // the lifetimes are taken before the best fit below consumes the refcounts
+  MemPackPlanner pack_planner(this);
+  pack_planner.InitLifetimes(tensor_ptr_list_, wk_tensor_list_, op_ptr_list_);
   KernelDefPtr pre_op = nullptr;
 #ifdef MEM_REUSE_DEBUG
   size_t op_num = 0;
@@ -458,6 +480,7 @@ void BestFitMemReuse::Reuse(const MemReuseUtil *mem_reuse_util_ptr) {
   MemReuseChecker::GetInstance().ExportMembufInfoIR();
   MemReuseChecker::GetInstance().ExportAddNewMmebufIR();
 #endif
+  PackIfSmaller(&pack_planner);
 }
 }  // namespace memreuse
 }  // namespace mindspore
@@ -32,6 +32,7 @@
 #include "pre_activate/mem_reuse/kernel_refcount.h"
 #include "pre_activate/mem_reuse/mem_reuse.h"
 #include "pre_activate/mem_reuse/stream_reuse.h"
+#include "pre_activate/mem_reuse/mem_reuse_planner.h"
 
 namespace mindspore {
 namespace memreuse {
@@ -100,6 +101,8 @@ class BestFitMemReuse {
   void Reuse(const MemReuseUtil *mem_reuse_util_ptr);
   // Get the total memory that needs to be applied eventually
   size_t GetAllocatedSize();
+  // Plan the offsets offline with MemPackPlanner and keep it when it beats the best fit
+  void PackIfSmaller(MemPackPlanner *pack_planner);
   // If the target stream can be reused by current stream
   bool IsReusableStream(uint32_t curr_stream_id, uint32_t target_stream_id);
   // return false, when the node output cannot be released
@@ -109,6 +112,9 @@ class BestFitMemReuse {
     tensor_ptr_list_ = tensor_ptr_list;
   }
   void set_op_ptr_list(const std::vector<KernelDefPtr> &op_ptr_list) { op_ptr_list_ = op_ptr_list; }
+  void set_parallel_streams_map(const std::unordered_map<uint32_t, std::unordered_set<uint32_t>> &parallel_streams_map) {
+    parallel_streams_map_ = parallel_streams_map;
+  }
 
  private:
   uint32_t current_stream_id_{0};
@@ -120,6 +126,9 @@ class BestFitMemReuse {
   // Memory block information sequence, temporary variables
   std::vector<MembufPtr> membuf_ptr_list_;
   std::unordered_map<uint32_t, std::unordered_set<uint32_t>> parallel_streams_map_;
+  // the allocated size of the offline plan, when it is used instead of the membuf list
+  bool use_pack_plan_{false};
+  size_t pack_allocated_size_{0};
 };
 }  // namespace memreuse
 }  // namespace mindspore
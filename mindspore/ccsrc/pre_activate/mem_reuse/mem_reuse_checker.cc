@@ -514,5 +514,14 @@ void MemReuseChecker::ExportAddNewMmebufIR() {
   }
   ofs.close();
 }
+
+void MemReuseChecker::CheckFragmentation(size_t allocated_size, size_t max_live_size) {
+  fragmentation_ratio_ = 0;
+  if (allocated_size > max_live_size) {
+    fragmentation_ratio_ = static_cast<double>(allocated_size - max_live_size) / allocated_size;
+  }
+  MS_LOG(INFO) << "MemReuse allocated size: " << allocated_size << ", max live size: " << max_live_size
+               << ", fragmentation ratio: " << fragmentation_ratio_;
+}
 }  // namespace memreuse
 }  // namespace mindspore
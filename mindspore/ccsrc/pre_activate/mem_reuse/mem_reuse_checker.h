@@ -59,6 +59,9 @@ class MemReuseChecker {
   void ExportMembufInfoIR();
   void SetAddNewMembuInfos(const KernelDef *op_def, const std::vector<MembufPtr> &membuf_ptr_list, size_t op_idx);
   void ExportAddNewMmebufIR();
+  // the share of the allocated dynamic memory that is never live at once, 0 when the plan is as small as it can be
+  void CheckFragmentation(size_t allocated_size, size_t max_live_size);
+  double fragmentation_ratio() const { return fragmentation_ratio_; }
 
  private:
   MemReuseChecker() = default;
@@ -84,6 +87,7 @@ class MemReuseChecker {
   int64_t total_ori_value_size_ = 0;
   int64_t total_ori_dy_size_ = 0;
   int64_t total_ori_wkspace_size_ = 0;
+  double fragmentation_ratio_ = 0;
 };
 }  // namespace memreuse
 }  // namespace mindspore
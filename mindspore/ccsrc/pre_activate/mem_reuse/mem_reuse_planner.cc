@@ -0,0 +1,284 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/mem_reuse/mem_reuse_planner.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include "pre_activate/mem_reuse/mem_reuse_allocator.h"
+
+namespace mindspore {
+namespace memreuse {
+namespace {
+constexpr size_t kNoPosition = std::numeric_limits<size_t>::max();
+
+size_t GetListIndex(int index, size_t list_size) {
+  if (index < 0 || IntToSize(index) >= list_size) {
+    MS_LOG(EXCEPTION) << "tensor index " << index << " is out of the tensor list size " << list_size;
+  }
+  return IntToSize(index);
+}
+}  // namespace
+
+size_t MemPackPlanner::AddStreamSet(const std::set<uint32_t> &streams) {
+  auto iter = std::find(stream_sets_.begin(), stream_sets_.end(), streams);
+  if (iter != stream_sets_.end()) {
+    return IntToSize(iter - stream_sets_.begin());
+  }
+  stream_sets_.push_back(streams);
+  return stream_sets_.size() - 1;
+}
+
+void MemPackPlanner::InitLifetimes(const std::vector<KernelRefCountPtr> &tensor_list,
+                                   const std::vector<KernelRefCountPtr> &wk_list,
+                                   const std::vector<KernelDefPtr> &op_list) {
+  MS_EXCEPTION_IF_NULL(best_fit_);
+  lifetimes_.clear();
+  stream_sets_.clear();
+  op_num_ = op_list.size();
+  size_t tensor_num = tensor_list.size();
+  std::vector<size_t> def_pos(tensor_num, kNoPosition);
+  std::vector<size_t> last_pos(tensor_num, 0);
+  std::vector<int> use_count(tensor_num, 0);
+  std::vector<bool> keep_unused(tensor_num, false);
+  std::vector<std::set<uint32_t>> streams(tensor_num);
+  for (size_t pos = 0; pos < op_num_; ++pos) {
+    auto &op_def = op_list[pos];
+    MS_EXCEPTION_IF_NULL(op_def);
+    auto stream_id = op_def->stream_id();
+    for (auto output_idx : op_def->GetOutputRefIndexs()) {
+      auto idx = GetListIndex(output_idx, tensor_num);
+      if (def_pos[idx] == kNoPosition) {
+        def_pos[idx] = pos;
+      }
+      last_pos[idx] = pos;
+      keep_unused[idx] = !best_fit_->IsRelease(op_def->kernel_name());
+      (void)streams[idx].insert(stream_id);
+    }
+    for (auto input_idx : op_def->GetInputRefIndexs()) {
+      auto idx = GetListIndex(input_idx, tensor_num);
+      last_pos[idx] = std::max(last_pos[idx], pos);
+      use_count[idx]++;
+      (void)streams[idx].insert(stream_id);
+    }
+    // the workspace lives only while its op runs
+    for (auto wk_idx : op_def->GetWkRefIndexs()) {
+      auto idx = GetListIndex(wk_idx, wk_list.size());
+      MS_EXCEPTION_IF_NULL(wk_list[idx]);
+      TensorLifetime lifetime{wk_list[idx].get(), wk_list[idx]->size_, pos, pos, AddStreamSet({stream_id})};
+      lifetimes_.push_back(lifetime);
+    }
+  }
+  for (size_t idx = 0; idx < tensor_num; ++idx) {
+    if (def_pos[idx] == kNoPosition) {
+      continue;
+    }
+    auto &tensor = tensor_list[idx];
+    MS_EXCEPTION_IF_NULL(tensor);
+    size_t end = last_pos[idx];
+    // more refs than uses in the graph (the graph outputs) or an unused output that must be kept, never released
+    if (tensor->ref_count_ > use_count[idx] || (use_count[idx] == 0 && keep_unused[idx])) {
+      end = op_num_;
+    }
+    TensorLifetime lifetime{tensor.get(), tensor->size_, def_pos[idx], end, AddStreamSet(streams[idx])};
+    lifetimes_.push_back(lifetime);
+  }
+  InitStreamConflicts();
+  // the live size of every position, the last position stands for after the last op
+  std::vector<size_t> delta(op_num_ + 2, 0);
+  for (auto &lifetime : lifetimes_) {
+    delta[lifetime.begin] += lifetime.size;
+    delta[lifetime.end + 1] -= lifetime.size;
+  }
+  breadth_.assign(op_num_ + 1, 0);
+  size_t live_size = 0;
+  for (size_t pos = 0; pos < breadth_.size(); ++pos) {
+    live_size += delta[pos];
+    breadth_[pos] = live_size;
+  }
+  max_live_size_ = *std::max_element(breadth_.begin(), breadth_.end());
+}
+
+void MemPackPlanner::InitStreamConflicts() {
+  size_t set_num = stream_sets_.size();
+  stream_set_conflicts_.assign(set_num, std::vector<bool>(set_num, false));
+  for (size_t i = 0; i < set_num; ++i) {
+    for (size_t j = 0; j < set_num; ++j) {
+      for (auto lhs : stream_sets_[i]) {
+        for (auto rhs : stream_sets_[j]) {
+          if (!best_fit_->IsReusableStream(lhs, rhs) || !best_fit_->IsReusableStream(rhs, lhs)) {
+            stream_set_conflicts_[i][j] = true;
+          }
+        }
+      }
+    }
+  }
+}
+
+bool MemPackPlanner::IsConflict(const TensorLifetime &lhs, const TensorLifetime &rhs) const {
+  if (lhs.begin <= rhs.end && rhs.begin <= lhs.end) {
+    return true;
+  }
+  // the positions of ops on parallel streams say nothing about when they run
+  return stream_set_conflicts_[lhs.stream_set][rhs.stream_set];
+}
+
+std::vector<size_t> MemPackPlanner::SizeOrder() const {
+  std::vector<size_t> order(lifetimes_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+    auto &lhs_life = lifetimes_[lhs];
+    auto &rhs_life = lifetimes_[rhs];
+    if (lhs_life.size != rhs_life.size) {
+      return lhs_life.size > rhs_life.size;
+    }
+    return lhs_life.end - lhs_life.begin > rhs_life.end - rhs_life.begin;
+  });
+  return order;
+}
+
+std::vector<size_t> MemPackPlanner::BreadthOrder() const {
+  std::vector<size_t> positions(breadth_.size());
+  for (size_t i = 0; i < positions.size(); ++i) {
+    positions[i] = i;
+  }
+  std::stable_sort(positions.begin(), positions.end(),
+                   [this](size_t lhs, size_t rhs) { return breadth_[lhs] > breadth_[rhs]; });
+  auto size_order = SizeOrder();
+  std::vector<bool> ordered(lifetimes_.size(), false);
+  std::vector<size_t> order;
+  order.reserve(lifetimes_.size());
+  for (auto pos : positions) {
+    if (order.size() == lifetimes_.size()) {
+      break;
+    }
+    for (auto idx : size_order) {
+      auto &lifetime = lifetimes_[idx];
+      if (!ordered[idx] && lifetime.begin <= pos && pos <= lifetime.end) {
+        ordered[idx] = true;
+        order.push_back(idx);
+      }
+    }
+  }
+  return order;
+}
+
+size_t MemPackPlanner::PackInOrder(const std::vector<size_t> &order, std::vector<size_t> *offsets) const {
+  MS_EXCEPTION_IF_NULL(offsets);
+  offsets->assign(lifetimes_.size(), 0);
+  size_t allocated_size = 0;
+  std::vector<size_t> placed;
+  std::vector<std::pair<size_t, size_t>> busy;
+  placed.reserve(order.size());
+  for (auto idx : order) {
+    auto &lifetime = lifetimes_[idx];
+    busy.clear();
+    for (auto placed_idx : placed) {
+      if (IsConflict(lifetime, lifetimes_[placed_idx])) {
+        auto offset = (*offsets)[placed_idx];
+        busy.emplace_back(offset, offset + lifetimes_[placed_idx].size);
+      }
+    }
+    std::sort(busy.begin(), busy.end());
+    // the smallest gap that fits, or the end of the conflicting ones
+    size_t best_offset = kNoPosition;
+    size_t best_gap = kNoPosition;
+    size_t cursor = 0;
+    for (auto &range : busy) {
+      if (range.first > cursor) {
+        size_t gap = range.first - cursor;
+        if (gap >= lifetime.size && gap < best_gap) {
+          best_gap = gap;
+          best_offset = cursor;
+        }
+      }
+      cursor = std::max(cursor, range.second);
+    }
+    if (best_offset == kNoPosition) {
+      best_offset = cursor;
+    }
+    (*offsets)[idx] = best_offset;
+    allocated_size = std::max(allocated_size, best_offset + lifetime.size);
+    placed.push_back(idx);
+  }
+  return allocated_size;
+}
+
+void MemPackPlanner::LocalSearch(size_t search_rounds, std::vector<size_t> *order) {
+  MS_EXCEPTION_IF_NULL(order);
+  std::vector<size_t> offsets;
+  for (size_t round = 0; round < search_rounds && allocated_size_ > max_live_size_; ++round) {
+    // the tensors that reach the peak, placing one of them earlier may lower it
+    std::vector<size_t> peak_positions;
+    for (size_t pos = 0; pos < order->size(); ++pos) {
+      auto idx = (*order)[pos];
+      if (offsets_[idx] + lifetimes_[idx].size == allocated_size_ && pos != 0) {
+        peak_positions.push_back(pos);
+      }
+    }
+    if (peak_positions.empty()) {
+      return;
+    }
+    auto pos = peak_positions[round % peak_positions.size()];
+    auto candidate = *order;
+    auto idx = candidate[pos];
+    (void)candidate.erase(candidate.begin() + SizeToInt(pos));
+    (void)candidate.insert(candidate.begin() + SizeToInt(pos / 2), idx);
+    auto allocated_size = PackInOrder(candidate, &offsets);
+    if (allocated_size < allocated_size_) {
+      allocated_size_ = allocated_size;
+      offsets_.swap(offsets);
+      order->swap(candidate);
+    }
+  }
+}
+
+size_t MemPackPlanner::Plan(size_t search_rounds) {
+  allocated_size_ = 0;
+  offsets_.clear();
+  if (lifetimes_.empty()) {
+    return allocated_size_;
+  }
+  if (lifetimes_.size() > kPackSearchMaxTensors) {
+    MS_LOG(INFO) << "MemPackPlanner skips the graph of " << lifetimes_.size() << " tensors, more than "
+                 << kPackSearchMaxTensors;
+    return allocated_size_;
+  }
+  std::vector<std::vector<size_t>> orders{SizeOrder(), BreadthOrder()};
+  std::vector<size_t> best_order;
+  for (auto &order : orders) {
+    std::vector<size_t> offsets;
+    auto allocated_size = PackInOrder(order, &offsets);
+    if (best_order.empty() || allocated_size < allocated_size_) {
+      allocated_size_ = allocated_size;
+      offsets_.swap(offsets);
+      best_order = order;
+    }
+  }
+  LocalSearch(search_rounds, &best_order);
+  MS_LOG(INFO) << "MemPackPlanner allocated size: " << allocated_size_ << ", max live size: " << max_live_size_;
+  return allocated_size_;
+}
+
+void MemPackPlanner::ApplyOffsets() const {
+  for (size_t i = 0; i < lifetimes_.size() && i < offsets_.size(); ++i) {
+    lifetimes_[i].tensor->offset_ = offsets_[i];
+  }
+}
+}  // namespace memreuse
+}  // namespace mindspore
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_PLANNER_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_PLANNER_H_
+#include <set>
+#include <vector>
+#include "pre_activate/mem_reuse/kernel_refcount.h"
+
+namespace mindspore {
+namespace memreuse {
+class BestFitMemReuse;
+// rounds of the local search after the greedy packing
+static constexpr size_t kPackSearchRounds = 16;
+// every packing is quadratic in the tensors, so the graphs larger than this are not planned and keep the best fit
+static constexpr size_t kPackSearchMaxTensors = 4096;
+
+// the lifetime of a tensor in positions of the execution order, both ends included
+struct TensorLifetime {
+  KernelRefCount *tensor{nullptr};
+  size_t size{0};
+  size_t begin{0};
+  size_t end{0};
+  // index of the set of streams that define or use the tensor
+  size_t stream_set{0};
+};
+
+// An offline planner that sees all the tensor lifetimes and sizes up front. It packs the tensors greedy by size and
+// greedy by breadth (the tensors of the widest moments first), then runs a local search that moves the tensors
+// reaching the peak earlier in the packing order. Tensors used on streams that IsReusableStream reports as parallel
+// never share memory, whatever their lifetimes.
+class MemPackPlanner {
+ public:
+  explicit MemPackPlanner(BestFitMemReuse *best_fit) : best_fit_(best_fit) {}
+  ~MemPackPlanner() = default;
+  // collect the lifetimes, the sizes must be aligned and the refcounts not consumed yet
+  void InitLifetimes(const std::vector<KernelRefCountPtr> &tensor_list, const std::vector<KernelRefCountPtr> &wk_list,
+                     const std::vector<KernelDefPtr> &op_list);
+  // plan the offsets and return the allocated size, or 0 when there are no tensors or more than
+  // kPackSearchMaxTensors of them, search_rounds 0 turns the local search off
+  size_t Plan(size_t search_rounds = kPackSearchRounds);
+  // write the planned offsets to the tensors
+  void ApplyOffsets() const;
+  size_t allocated_size() const { return allocated_size_; }
+  // the most memory live at one moment, a lower bound of the allocated size of any plan
+  size_t max_live_size() const { return max_live_size_; }
+
+ private:
+  size_t AddStreamSet(const std::set<uint32_t> &streams);
+  void InitStreamConflicts();
+  bool IsConflict(const TensorLifetime &lhs, const TensorLifetime &rhs) const;
+  std::vector<size_t> SizeOrder() const;
+  std::vector<size_t> BreadthOrder() const;
+  // place the tensors in order, each at the lowest best fitting gap among the conflicting ones already placed
+  size_t PackInOrder(const std::vector<size_t> &order, std::vector<size_t> *offsets) const;
+  void LocalSearch(size_t search_rounds, std::vector<size_t> *order);
+
+  BestFitMemReuse *best_fit_;
+  size_t op_num_{0};
+  std::vector<TensorLifetime> lifetimes_;
+  std::vector<std::set<uint32_t>> stream_sets_;
+  std::vector<std::vector<bool>> stream_set_conflicts_;
+  // the live size at every position of the execution order
+  std::vector<size_t> breadth_;
+  std::vector<size_t> offsets_;
+  size_t allocated_size_{0};
+  size_t max_live_size_{0};
+};
+}  // namespace memreuse
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_REUSE_PLANNER_H_
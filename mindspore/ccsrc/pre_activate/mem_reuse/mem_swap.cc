@@ -0,0 +1,193 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/mem_reuse/mem_swap.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include "operator/ops.h"
+#include "pre_activate/mem_reuse/mem_reuse.h"
+#include "pre_activate/mem_reuse/mem_swap_planner.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace memreuse {
+namespace {
+// a reader of a tensor, at pos of the execution order
+struct SwapUse {
+  size_t pos;
+  CNodePtr kernel;
+  size_t input_idx;
+};
+
+// where the readers of a tensor take it from, the kernel writing it or a tuple_getitem of the kernel
+struct SwapSource {
+  AnfNodePtr node;
+  TypeId type{kTypeUnknown};
+  std::vector<size_t> shape;
+  std::vector<SwapUse> uses;
+};
+
+int NewSwapId() {
+  static int swap_id = 0;
+  return swap_id++;
+}
+
+CNodePtr NewSwapKernel(session::KernelGraph *graph, const std::string &name, int swap_id, const AnfNodePtr &input,
+                       TypeId type, const std::vector<size_t> &shape) {
+  auto prim = std::make_shared<Primitive>(name);
+  prim->set_attr(kAttrSwapId, MakeValue(swap_id));
+  auto kernel = graph->NewCNode({NewValueNode(prim), input});
+  MS_EXCEPTION_IF_NULL(kernel);
+  AnfAlgo::SetOutputInferTypeAndShape({type}, {shape}, kernel.get());
+  return kernel;
+}
+
+// the readers that take the tensor from elsewhere, through a depend for instance, can not be redirected
+bool IsRedirectable(const AnfNodePtr &input) {
+  MS_EXCEPTION_IF_NULL(input);
+  return input->isa<CNode>() &&
+         (AnfAlgo::IsRealKernel(input) || AnfAlgo::CheckPrimitiveType(input, prim::kPrimTupleGetItem));
+}
+}  // namespace
+
+bool MemSwap(session::KernelGraph *graph, size_t memory_limit) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto kernels = graph->execution_order();
+  if (memory_limit == 0 || kernels.empty()) {
+    return false;
+  }
+  MemReuseUtil util;
+  util.SetAllInfo(graph);
+  size_t tensor_num = util.total_refs_list_.size();
+  std::vector<SwapTensor> tensors(tensor_num);
+  std::vector<SwapSource> sources(tensor_num);
+  std::vector<SwapTensor> workspaces;
+  std::vector<double> op_time;
+  for (size_t pos = 0; pos < kernels.size(); ++pos) {
+    auto &kernel = kernels[pos];
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t touched = 0;
+    auto output_iter = util.kernel_output_refs_.find(kernel.get());
+    if (output_iter != util.kernel_output_refs_.end()) {
+      for (size_t k = 0; k < output_iter->second.size(); ++k) {
+        auto &ref = output_iter->second[k];
+        MS_EXCEPTION_IF_NULL(ref);
+        auto idx = IntToSize(ref->index_);
+        tensors[idx].size = ref->size_;
+        tensors[idx].accesses.push_back(pos);
+        tensors[idx].swappable = AnfAlgo::GetOutputDeviceDataType(kernel, k) == kNumberTypeFloat32;
+        sources[idx].type = AnfAlgo::GetOutputInferDataType(kernel, k);
+        sources[idx].shape = AnfAlgo::GetOutputInferShape(kernel, k);
+        touched += ref->size_;
+      }
+    }
+    // the optimizers update their inputs in place
+    bool in_place = kOptOperatorSet.find(AnfAlgo::GetCNodeName(kernel)) != kOptOperatorSet.end();
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      auto ref = util.GetKernelInputRef(kernel, i);
+      if (ref == nullptr) {
+        continue;
+      }
+      auto idx = IntToSize(ref->index_);
+      touched += ref->size_;
+      auto &tensor = tensors[idx];
+      if (tensor.accesses.empty()) {
+        MS_LOG(EXCEPTION) << "The input " << i << " of " << kernel->fullname_with_scope() << " is read before written";
+      }
+      if (tensor.accesses.back() != pos) {
+        tensor.accesses.push_back(pos);
+      }
+      auto input = kernel->input(i + 1);
+      if (in_place || !IsRedirectable(input)) {
+        tensor.swappable = false;
+      }
+      sources[idx].node = input;
+      sources[idx].uses.push_back({pos, kernel, i});
+    }
+    auto wk_iter = util.kernel_workspace_refs_.find(kernel.get());
+    if (wk_iter != util.kernel_workspace_refs_.end()) {
+      for (auto &ref : wk_iter->second) {
+        MS_EXCEPTION_IF_NULL(ref);
+        workspaces.push_back({ref->size_, {pos}, false});
+        touched += ref->size_;
+      }
+    }
+    op_time.push_back(static_cast<double>(touched) / kSwapDeviceBandwidth + kSwapLaunchTime);
+  }
+  // the outputs of the graph stay until the end
+  size_t last_pos = kernels.size() - 1;
+  for (const auto &node : AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem})) {
+    auto kernel_input = AnfAlgo::VisitKernelWithReturnType(node, 0);
+    MS_EXCEPTION_IF_NULL(kernel_input.first);
+    auto iter = util.kernel_output_refs_.find(kernel_input.first.get());
+    if (iter == util.kernel_output_refs_.end() || kernel_input.second >= iter->second.size()) {
+      continue;
+    }
+    auto &tensor = tensors[IntToSize(iter->second[kernel_input.second]->index_)];
+    tensor.swappable = false;
+    if (tensor.accesses.back() != last_pos) {
+      tensor.accesses.push_back(last_pos);
+    }
+  }
+
+  MemSwapPlanner planner(op_time, kSwapHostBandwidth);
+  for (auto &tensor : tensors) {
+    planner.AddTensor(tensor);
+  }
+  for (auto &workspace : workspaces) {
+    planner.AddTensor(workspace);
+  }
+  if (!planner.Plan(memory_limit)) {
+    MS_LOG(WARNING) << "The graph " << graph->graph_id() << " takes " << planner.peak() << " bytes with "
+                    << planner.decisions().size() << " swaps, over the memory limit " << memory_limit;
+  }
+  MS_LOG(INFO) << "Swap " << planner.decisions().size() << " tensors to the host, the peak memory of the graph "
+               << graph->graph_id() << " is from " << planner.origin_peak() << " to " << planner.peak() << " bytes";
+  if (planner.decisions().empty()) {
+    return false;
+  }
+
+  // the decisions of a tensor are sorted by the gap, each redirects the readers after its gap to its _SwapIn
+  std::vector<std::vector<CNodePtr>> swap_in_before(kernels.size());
+  std::vector<std::vector<CNodePtr>> swap_out_after(kernels.size());
+  for (auto &decision : planner.decisions()) {
+    auto &tensor = tensors[decision.tensor];
+    auto &source = sources[decision.tensor];
+    auto swap_id = NewSwapId();
+    auto swap_out = NewSwapKernel(graph, kSwapOutOpName, swap_id, source.node, kNumberTypeFloat32, {1});
+    auto swap_in = NewSwapKernel(graph, kSwapInOpName, swap_id, swap_out, source.type, source.shape);
+    swap_out_after[tensor.accesses[decision.gap]].push_back(swap_out);
+    swap_in_before[decision.in_pos].push_back(swap_in);
+    for (auto &use : source.uses) {
+      if (use.pos >= tensor.accesses[decision.gap + 1]) {
+        use.kernel->set_input(use.input_idx + 1, swap_in);
+      }
+    }
+    source.node = swap_in;
+  }
+  std::vector<CNodePtr> execution_order;
+  for (size_t pos = 0; pos < kernels.size(); ++pos) {
+    (void)execution_order.insert(execution_order.end(), swap_in_before[pos].begin(), swap_in_before[pos].end());
+    execution_order.push_back(kernels[pos]);
+    (void)execution_order.insert(execution_order.end(), swap_out_after[pos].begin(), swap_out_after[pos].end());
+  }
+  graph->set_execution_order(execution_order);
+  return true;
+}
+}  // namespace memreuse
+}  // namespace mindspore
@@ -0,0 +1,39 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SWAP_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SWAP_H_
+#include <cstddef>
+#include "session/kernel_graph.h"
+
+namespace mindspore {
+namespace memreuse {
+// the bandwidths of the device memory and of the copies between the device and the host in bytes per second, and
+// the time to launch an op in seconds, they estimate the time of the ops and of the copies for the swap planner
+constexpr double kSwapDeviceBandwidth = 1e11;
+constexpr double kSwapHostBandwidth = 1e10;
+constexpr double kSwapLaunchTime = 5e-6;
+
+// Swap the outputs of the kernels alive across the peak to the host so that the graph fits memory_limit bytes. The
+// lifetimes come from MemReuseUtil and the swaps from MemSwapPlanner. A swapped tensor x is copied out by a _SwapOut
+// after the kernel that writes or reads it, which returns a small token, and copied back by a _SwapIn of the token
+// issued before its next reader; the readers from then on read the output of the _SwapIn. The swap kernels carry a
+// swap_id naming the host buffer and are left for the caller to select and build. Only float32 outputs are swapped.
+// Return whether the graph is changed.
+bool MemSwap(session::KernelGraph *graph, size_t memory_limit);
+}  // namespace memreuse
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SWAP_H_
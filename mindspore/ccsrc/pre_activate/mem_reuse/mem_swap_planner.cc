@@ -0,0 +1,147 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pre_activate/mem_reuse/mem_swap_planner.h"
+#include <algorithm>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace memreuse {
+MemSwapPlanner::MemSwapPlanner(const std::vector<double> &op_time, double host_bandwidth)
+    : op_time_(op_time), host_bandwidth_(host_bandwidth) {
+  if (host_bandwidth_ <= 0) {
+    MS_LOG(EXCEPTION) << "The host bandwidth " << host_bandwidth_ << " must be positive";
+  }
+  start_time_.assign(op_time_.size() + 1, 0.0);
+  for (size_t pos = 0; pos < op_time_.size(); ++pos) {
+    start_time_[pos + 1] = start_time_[pos] + op_time_[pos];
+  }
+}
+
+bool MemSwapPlanner::FitCopies(SwapDecision *decision) const {
+  MS_EXCEPTION_IF_NULL(decision);
+  auto &tensor = tensors_[decision->tensor];
+  size_t from = tensor.accesses[decision->gap];
+  size_t to = tensor.accesses[decision->gap + 1];
+  if (to >= op_time_.size()) {
+    MS_LOG(EXCEPTION) << "The access " << to << " is out of the " << op_time_.size() << " ops";
+  }
+  double copy_time = static_cast<double>(tensor.size) / host_bandwidth_;
+  // the first op after from by the end of which the copy out is done
+  auto out_end = std::lower_bound(start_time_.begin() + from + 2, start_time_.end(), start_time_[from + 1] + copy_time);
+  if (out_end == start_time_.end()) {
+    return false;
+  }
+  decision->out_pos = static_cast<size_t>(out_end - start_time_.begin()) - 1;
+  // the last op from the start of which the copy in is done before to
+  auto in_begin = std::upper_bound(start_time_.begin(), start_time_.begin() + to + 1, start_time_[to] - copy_time);
+  if (in_begin == start_time_.begin()) {
+    return false;
+  }
+  decision->in_pos = static_cast<size_t>(in_begin - start_time_.begin()) - 1;
+  // nothing is saved unless an op runs while the tensor is on the host
+  return decision->out_pos + 1 < decision->in_pos;
+}
+
+std::vector<size_t> MemSwapPlanner::LiveSize() const {
+  size_t op_num = op_time_.size();
+  std::vector<size_t> delta(op_num + 1, 0);
+  std::vector<size_t> release(op_num + 1, 0);
+  for (auto &tensor : tensors_) {
+    if (tensor.accesses.empty()) {
+      continue;
+    }
+    if (tensor.accesses.back() >= op_num) {
+      MS_LOG(EXCEPTION) << "The access " << tensor.accesses.back() << " is out of the " << op_num << " ops";
+    }
+    delta[tensor.accesses.front()] += tensor.size;
+    release[tensor.accesses.back() + 1] += tensor.size;
+  }
+  for (auto &decision : decisions_) {
+    auto size = tensors_[decision.tensor].size;
+    release[decision.out_pos + 1] += size;
+    delta[decision.in_pos] += size;
+  }
+  std::vector<size_t> live(op_num, 0);
+  size_t live_size = 0;
+  for (size_t pos = 0; pos < op_num; ++pos) {
+    live_size = live_size + delta[pos] - release[pos];
+    live[pos] = live_size;
+  }
+  return live;
+}
+
+bool MemSwapPlanner::Plan(size_t memory_limit) {
+  decisions_.clear();
+  std::vector<SwapDecision> candidates;
+  for (size_t index = 0; index < tensors_.size(); ++index) {
+    auto &tensor = tensors_[index];
+    if (!tensor.swappable || tensor.size == 0) {
+      continue;
+    }
+    for (size_t gap = 0; gap + 1 < tensor.accesses.size(); ++gap) {
+      SwapDecision decision{index, gap, 0, 0};
+      if (FitCopies(&decision)) {
+        candidates.push_back(decision);
+      }
+    }
+  }
+
+  auto live = LiveSize();
+  auto peak_iter = std::max_element(live.begin(), live.end());
+  origin_peak_ = peak_iter == live.end() ? 0 : *peak_iter;
+  peak_ = origin_peak_;
+  std::vector<bool> chosen(candidates.size(), false);
+  bool fit = true;
+  while (peak_ > memory_limit) {
+    size_t peak_pos = static_cast<size_t>(peak_iter - live.begin());
+    size_t best = candidates.size();
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      auto &candidate = candidates[i];
+      if (chosen[i] || candidate.out_pos >= peak_pos || candidate.in_pos <= peak_pos) {
+        continue;
+      }
+      if (best == candidates.size()) {
+        best = i;
+        continue;
+      }
+      auto size = tensors_[candidate.tensor].size;
+      auto best_size = tensors_[candidates[best].tensor].size;
+      // the larger tensor first, then the longer time on the host
+      if (size > best_size || (size == best_size && candidate.in_pos - candidate.out_pos >
+                                                        candidates[best].in_pos - candidates[best].out_pos)) {
+        best = i;
+      }
+    }
+    if (best == candidates.size()) {
+      fit = false;
+      break;
+    }
+    chosen[best] = true;
+    decisions_.push_back(candidates[best]);
+    for (size_t pos = candidates[best].out_pos + 1; pos < candidates[best].in_pos; ++pos) {
+      live[pos] -= tensors_[candidates[best].tensor].size;
+    }
+    peak_iter = std::max_element(live.begin(), live.end());
+    peak_ = *peak_iter;
+  }
+  std::sort(decisions_.begin(), decisions_.end(), [](const SwapDecision &lhs, const SwapDecision &rhs) {
+    return lhs.tensor < rhs.tensor || (lhs.tensor == rhs.tensor && lhs.gap < rhs.gap);
+  });
+  return fit;
+}
+}  // namespace memreuse
+}  // namespace mindspore
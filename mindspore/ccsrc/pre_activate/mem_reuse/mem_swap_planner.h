@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SWAP_PLANNER_H_
+#define MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SWAP_PLANNER_H_
+#include <cstddef>
+#include <vector>
+
+namespace mindspore {
+namespace memreuse {
+// a tensor as seen by the swap planner, the positions are those of the execution order
+struct SwapTensor {
+  size_t size{0};
+  // the position of the op that defines the tensor followed by those of the ops that read it, sorted and unique
+  std::vector<size_t> accesses;
+  // the workspaces and the outputs of the graph stay on the device
+  bool swappable{true};
+};
+
+// a tensor moved to the host between two of its accesses
+struct SwapDecision {
+  size_t tensor{0};
+  // the tensor is on the host from accesses[gap] to accesses[gap + 1]
+  size_t gap{0};
+  // the copy to the host is issued after the op of accesses[gap] and its device memory is released after the op at
+  // out_pos, when the copy is expected to be done
+  size_t out_pos{0};
+  // the copy back is issued before the op at in_pos, early enough to be done before the op of accesses[gap + 1]
+  size_t in_pos{0};
+};
+
+// Plan the swaps of the tensors to the host memory so that the tensors alive at any position fit a memory limit.
+// The copies are overlapped with the ops in between: the memory of a tensor is released once the ops after the
+// copy out took as long as the copy, and the copy in is issued as many ops before the next access. A gap too short
+// for both copies is not swapped. The copies are assumed not to slow down each other nor the ops.
+class MemSwapPlanner {
+ public:
+  // op_time is the expected time of every op of the execution order, host_bandwidth the bytes copied in a unit of it
+  MemSwapPlanner(const std::vector<double> &op_time, double host_bandwidth);
+  ~MemSwapPlanner() = default;
+  void AddTensor(const SwapTensor &tensor) { tensors_.push_back(tensor); }
+  // swap the largest tensor gap across the peak until the peak fits memory_limit, return false if it does not fit
+  // when no gap is left to swap
+  bool Plan(size_t memory_limit);
+  // the bytes alive at every position with the decisions made so far
+  std::vector<size_t> LiveSize() const;
+  const std::vector<SwapDecision> &decisions() const { return decisions_; }
+  const std::vector<SwapTensor> &tensors() const { return tensors_; }
+  size_t origin_peak() const { return origin_peak_; }
+  size_t peak() const { return peak_; }
+
+ private:
+  // fill the out_pos and in_pos of the decision, return false if the gap is too short
+  bool FitCopies(SwapDecision *decision) const;
+
+  std::vector<double> op_time_;
+  // the time of the ops before every position
+  std::vector<double> start_time_;
+  double host_bandwidth_;
+  std::vector<SwapTensor> tensors_;
+  std::vector<SwapDecision> decisions_;
+  size_t origin_peak_{0};
+  size_t peak_{0};
+};
+}  // namespace memreuse
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PRE_ACTIVATE_MEM_REUSE_MEM_SWAP_PLANNER_H_
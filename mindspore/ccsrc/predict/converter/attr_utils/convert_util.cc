@@ -198,6 +198,62 @@ bool FindNodeInMap(const std::unordered_map<MsKernelKey, int> &node_map, const A
                      [node](const std::pair<MsKernelKey, int> &kernel_key) { return kernel_key.first == node.get(); });
 }
 
+namespace {
+flatbuffers::Offset<mindspore::predict::TensorDef> PackAlignedTensorDef(flatbuffers::FlatBufferBuilder *builder,
+                                                                       const TensorDefT &tensor) {
+  MS_EXCEPTION_IF_NULL(builder);
+  auto dims = tensor.dims.empty() ? 0 : builder->CreateVector(tensor.dims);
+  flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data = 0;
+  if (!tensor.data.empty()) {
+    builder->ForceVectorAlignment(tensor.data.size(), sizeof(uint8_t), kTensorDataAlign);
+    data = builder->CreateVector(tensor.data);
+  }
+  auto quantization = tensor.quantization == nullptr
+                        ? 0
+                        : mindspore::predict::CreateQuantizationDef(*builder, tensor.quantization.get());
+  return mindspore::predict::CreateTensorDef(*builder, tensor.dataType, dims, tensor.format, tensor.refCount,
+                                             tensor.offset, data, quantization);
+}
+
+flatbuffers::Offset<mindspore::predict::SubGraphDef> PackAlignedSubGraphDef(flatbuffers::FlatBufferBuilder *builder,
+                                                                           const SubGraphDefT &sub_graph) {
+  MS_EXCEPTION_IF_NULL(builder);
+  std::vector<flatbuffers::Offset<mindspore::predict::TensorDef>> all_tensors;
+  for (auto &tensor : sub_graph.allTensors) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    all_tensors.push_back(PackAlignedTensorDef(builder, *tensor));
+  }
+  std::vector<flatbuffers::Offset<mindspore::predict::NodeDef>> nodes;
+  for (auto &node : sub_graph.nodes) {
+    MS_EXCEPTION_IF_NULL(node);
+    nodes.push_back(mindspore::predict::CreateNodeDef(*builder, node.get()));
+  }
+  auto name = sub_graph.name.empty() ? 0 : builder->CreateString(sub_graph.name);
+  auto input_index = sub_graph.inputIndex.empty() ? 0 : builder->CreateVector(sub_graph.inputIndex);
+  auto output_index = sub_graph.outputIndex.empty() ? 0 : builder->CreateVector(sub_graph.outputIndex);
+  auto nodes_offset = nodes.empty() ? 0 : builder->CreateVector(nodes);
+  auto all_tensors_offset = all_tensors.empty() ? 0 : builder->CreateVector(all_tensors);
+  return mindspore::predict::CreateSubGraphDef(*builder, name, input_index, output_index, sub_graph.mempoolSize,
+                                               nodes_offset, all_tensors_offset);
+}
+}  // namespace
+
+flatbuffers::Offset<mindspore::predict::GraphDef> PackAlignedGraphDef(flatbuffers::FlatBufferBuilder *builder,
+                                                                     const GraphDefT &graph) {
+  MS_EXCEPTION_IF_NULL(builder);
+  std::vector<flatbuffers::Offset<mindspore::predict::SubGraphDef>> sub_graphs;
+  for (auto &sub_graph : graph.subgraphs) {
+    MS_EXCEPTION_IF_NULL(sub_graph);
+    sub_graphs.push_back(PackAlignedSubGraphDef(builder, *sub_graph));
+  }
+  auto name = graph.name.empty() ? 0 : builder->CreateString(graph.name);
+  auto mempool_cfg =
+    graph.mempoolCfg == nullptr ? 0 : mindspore::predict::CreateMempoolCfg(*builder, graph.mempoolCfg.get());
+  auto sub_graphs_offset = sub_graphs.empty() ? 0 : builder->CreateVector(sub_graphs);
+  // the buffer is padded to the largest alignment forced, so the offsets from its start are aligned as well
+  return mindspore::predict::CreateGraphDef(*builder, name, mempool_cfg, sub_graphs_offset, kTensorDataAlign);
+}
+
 bool SaveDeviceModelUtil(const std::shared_ptr<GraphDefT> &new_ms_graph_ptr, const std::string &save_path_name,
                          SubGraphDefT *sub_graph) {
   MS_EXCEPTION_IF_NULL(new_ms_graph_ptr);
@@ -208,7 +264,7 @@ bool SaveDeviceModelUtil(const std::shared_ptr<GraphDefT> &new_ms_graph_ptr, con
   new_ms_graph_ptr->subgraphs.emplace_back(std::move(sub_graph_ptr));
   // get flatbuffer builder
   flatbuffers::FlatBufferBuilder builder(1024);
-  auto offset = mindspore::predict::GraphDef::Pack(builder, new_ms_graph_ptr.get());
+  auto offset = PackAlignedGraphDef(&builder, *new_ms_graph_ptr);
   builder.Finish(offset);
   auto size = builder.GetSize();
   if (size == 0) {
@@ -216,7 +272,7 @@ bool SaveDeviceModelUtil(const std::shared_ptr<GraphDefT> &new_ms_graph_ptr, con
     return false;
   }
   auto content = builder.GetBufferPointer();
-  std::ofstream output(save_path_name);
+  std::ofstream output(save_path_name, std::ofstream::binary);
   if (!output.is_open()) {
     MS_LOG(EXCEPTION) << "mindspore.mindspoire output failed";
   }
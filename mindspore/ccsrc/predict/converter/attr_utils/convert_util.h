@@ -43,6 +43,9 @@ using MsKernelKey = void *;
 namespace mindspore {
 namespace predict {
 namespace utils {
+// the alignment of the data of the const tensors in the saved model, so that the runtime can use it in place
+constexpr uint32_t kTensorDataAlign = 64;
+
 TypePtr GetTypePtr(const AnfNodePtr &anf_node);
 MsDataType GetMSDataType(TypeId ori_data_type);
 MsFormat GetMsFormat(const std::string &format_str);
@@ -53,6 +56,9 @@ TensorPtr GetKernelCpuTensor(const CNodePtr &c_node_ptr, size_t inx);
 TensorPtr GetKernelAscendTensor(const CNodePtr &c_node_ptr, size_t inx);
 TensorPtr GetOutputTensor(const AnfNodePtr &out_node, size_t inx);
 bool FindNodeInMap(const std::unordered_map<MsKernelKey, int> &Nodemap, const AnfNodePtr &node);
+// pack the graph like GraphDef::Pack, with the data of the const tensors aligned to kTensorDataAlign
+flatbuffers::Offset<mindspore::predict::GraphDef> PackAlignedGraphDef(flatbuffers::FlatBufferBuilder *builder,
+                                                                     const GraphDefT &graph);
 bool SaveDeviceModelUtil(const std::shared_ptr<GraphDefT> &new_ms_graph_ptr, const std::string &save_path_name,
                          SubGraphDefT *sub_graph_def_t);
 }  // namespace utils
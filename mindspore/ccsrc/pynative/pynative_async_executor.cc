@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pynative/pynative_async_executor.h"
+
+#include "pybind11/pybind11.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace pynative {
+namespace py = pybind11;
+
+AsyncOpExecutor &AsyncOpExecutor::GetInstance() {
+  static AsyncOpExecutor instance;
+  return instance;
+}
+
+AsyncOpExecutor::~AsyncOpExecutor() {
+  // the python runtime may be gone at static destruction, Stop() is expected to be called before
+  if (worker_.joinable()) {
+    worker_.detach();
+  }
+}
+
+std::shared_future<void> AsyncOpExecutor::Push(const OpTaskPtr &task) {
+  MS_EXCEPTION_IF_NULL(task);
+  std::shared_future<void> future = task->get_future().share();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      running_ = true;
+      worker_ = std::thread(&AsyncOpExecutor::WorkerLoop, this);
+    }
+    tasks_.push(task);
+  }
+  task_cond_.notify_one();
+  return future;
+}
+
+void AsyncOpExecutor::Sync() {
+  {
+    // nothing is pending, e.g. the async mode is off, keep the GIL
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (tasks_.empty() && !busy_) {
+      return;
+    }
+  }
+  // the worker needs the GIL to finish the pending ops
+  py::gil_scoped_release release;
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_cond_.wait(lock, [this] { return tasks_.empty() && !busy_; });
+}
+
+void AsyncOpExecutor::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  task_cond_.notify_one();
+  py::gil_scoped_release release;
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void AsyncOpExecutor::WorkerLoop() {
+  while (true) {
+    OpTaskPtr task = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this] { return !tasks_.empty() || !running_; });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = tasks_.front();
+      tasks_.pop();
+      busy_ = true;
+    }
+    {
+      py::gil_scoped_acquire acquire;
+      // errors are kept in the future of the task and reported at the sync point
+      (*task)();
+      // the task owns python objects, release them while holding the GIL
+      task = nullptr;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_ = false;
+    }
+    idle_cond_.notify_all();
+  }
+}
+}  // namespace pynative
+}  // namespace mindspore
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PYNATIVE_PYNATIVE_ASYNC_EXECUTOR_H_
+#define MINDSPORE_CCSRC_PYNATIVE_PYNATIVE_ASYNC_EXECUTOR_H_
+
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace mindspore {
+namespace pynative {
+using OpTask = std::packaged_task<void()>;
+using OpTaskPtr = std::shared_ptr<OpTask>;
+
+// Runs pynative ops on a single background thread in submission order.
+// The worker holds the GIL while an op task runs, the session releases it around the kernel launch.
+class AsyncOpExecutor {
+ public:
+  static AsyncOpExecutor &GetInstance();
+
+  // Enqueue an op task, the returned future is ready once the op has been executed.
+  // An exception thrown by the task is stored in the future and raised when it is waited on.
+  std::shared_future<void> Push(const OpTaskPtr &task);
+  // Block until every enqueued task has finished, must be called with the GIL held.
+  void Sync();
+  // Drain the queue and join the worker thread, must be called with the GIL held.
+  void Stop();
+
+ private:
+  AsyncOpExecutor() = default;
+  ~AsyncOpExecutor();
+  AsyncOpExecutor(const AsyncOpExecutor &) = delete;
+  AsyncOpExecutor &operator=(const AsyncOpExecutor &) = delete;
+
+  void WorkerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable idle_cond_;
+  std::queue<OpTaskPtr> tasks_;
+  std::thread worker_;
+  bool running_{false};
+  bool busy_{false};
+};
+}  // namespace pynative
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PYNATIVE_PYNATIVE_ASYNC_EXECUTOR_H_
@@ -33,6 +33,7 @@
 #include "pre_activate/pass/const_input_to_attr_registry.h"
 #include "pre_activate/common/helper.h"
 #include "pynative/base.h"
+#include "pynative/pynative_async_executor.h"
 
 #ifdef ENABLE_GE
 #include "pynative/pynative_execute_ge.h"
@@ -353,6 +354,128 @@ py::object RunOpInMs(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *stat
   return result;
 }
 
+bool CreatePendingOutput(const AbstractBasePtr &abstract, py::object *output,
+                         std::vector<tensor::TensorPtr> *pending_tensors) {
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(pending_tensors);
+  if (abstract == nullptr) {
+    return false;
+  }
+  if (abstract->isa<abstract::AbstractTensor>()) {
+    auto abs_tensor = abstract->cast<abstract::AbstractTensorPtr>();
+    MS_EXCEPTION_IF_NULL(abs_tensor->element());
+    auto type = abs_tensor->element()->BuildType();
+    auto shape = abs_tensor->shape();
+    if (type == nullptr || shape == nullptr) {
+      return false;
+    }
+    auto shape_value = shape->shape();
+    if (std::any_of(shape_value.begin(), shape_value.end(), [](int dim) { return dim < 0; })) {
+      return false;
+    }
+    auto tensor_ptr = std::make_shared<tensor::Tensor>(type->type_id(), shape_value);
+    pending_tensors->push_back(tensor_ptr);
+    *output = py::cast(tensor_ptr);
+    return true;
+  }
+  if (abstract->isa<abstract::AbstractTuple>()) {
+    auto abs_tuple = abstract->cast<abstract::AbstractTuplePtr>();
+    const auto &elements = abs_tuple->elements();
+    py::tuple tuple_output(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+      py::object item;
+      if (!CreatePendingOutput(elements[i], &item, pending_tensors)) {
+        return false;
+      }
+      tuple_output[i] = item;
+    }
+    *output = tuple_output;
+    return true;
+  }
+  return false;
+}
+
+void BindPendingOutput(const py::object &result, const std::vector<tensor::TensorPtr> &pending_tensors,
+                       size_t *index) {
+  MS_EXCEPTION_IF_NULL(index);
+  if (py::isinstance<tensor::Tensor>(result)) {
+    if (*index >= pending_tensors.size()) {
+      MS_LOG(EXCEPTION) << "The op has more outputs than the inferred " << pending_tensors.size() << " tensors";
+    }
+    auto tensor_ptr = py::cast<tensor::TensorPtr>(result);
+    MS_EXCEPTION_IF_NULL(tensor_ptr);
+    auto pending_tensor = pending_tensors[*index];
+    MS_EXCEPTION_IF_NULL(pending_tensor);
+    *pending_tensor = *tensor_ptr;
+    (*index)++;
+    return;
+  }
+  if (py::isinstance<py::tuple>(result)) {
+    auto tuple_result = py::cast<py::tuple>(result);
+    for (size_t i = 0; i < tuple_result.size(); ++i) {
+      BindPendingOutput(tuple_result[i], pending_tensors, index);
+    }
+    return;
+  }
+  MS_LOG(EXCEPTION) << "The output of op should be tensors, but got " << std::string(py::str(result));
+}
+
+void WaitPendingInput(const py::object &input) {
+  if (py::isinstance<tensor::Tensor>(input)) {
+    auto tensor_ptr = py::cast<tensor::TensorPtr>(input);
+    MS_EXCEPTION_IF_NULL(tensor_ptr);
+    tensor_ptr->WaitPendingTask();
+    return;
+  }
+  if (py::isinstance<py::tuple>(input) || py::isinstance<py::list>(input)) {
+    for (auto item : input) {
+      WaitPendingInput(py::reinterpret_borrow<py::object>(item));
+    }
+  }
+}
+
+void WaitPendingInputs(const OpExecInfoPtr &op_exec_info) {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  for (size_t i = 0; i < op_exec_info->op_inputs.size(); ++i) {
+    WaitPendingInput(op_exec_info->op_inputs[i]);
+  }
+}
+
+bool RunOpInMsAsync(const OpExecInfoPtr &op_exec_info, py::object *result) {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  MS_EXCEPTION_IF_NULL(result);
+  py::object output;
+  std::vector<tensor::TensorPtr> pending_tensors;
+  if (!CreatePendingOutput(op_exec_info->abstract, &output, &pending_tensors)) {
+    MS_LOG(INFO) << "The output of op[" << op_exec_info->op_name << "] can not be inferred, run it synchronously";
+    return false;
+  }
+  auto task = std::make_shared<OpTask>([op_exec_info, pending_tensors]() {
+    // the error of a failed producer is stored in the outputs of this op as well, instead of reading unbound data
+    WaitPendingInputs(op_exec_info);
+    PynativeStatusCode status = PYNATIVE_UNKNOWN_STATE;
+    py::object op_result = RunOpInMs(op_exec_info, &status);
+    if (status != PYNATIVE_SUCCESS) {
+      MS_LOG(EXCEPTION) << "Failed to run " << op_exec_info->op_name;
+    }
+    size_t index = 0;
+    BindPendingOutput(op_result, pending_tensors, &index);
+    if (index != pending_tensors.size()) {
+      MS_LOG(EXCEPTION) << "The op[" << op_exec_info->op_name << "] has " << index << " outputs, but "
+                        << pending_tensors.size() << " are inferred";
+    }
+  });
+  auto pending_task = AsyncOpExecutor::GetInstance().Push(task);
+  for (auto &tensor_ptr : pending_tensors) {
+    tensor_ptr->set_pending_task(pending_task);
+  }
+  py::tuple async_result(1);
+  async_result[0] = output;
+  *result = async_result;
+  MS_LOG(INFO) << "Op[" << op_exec_info->op_name << "] is enqueued to the async executor";
+  return true;
+}
+
 py::object RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecInfoPtr op_exec_info,
                                   PynativeStatusCode *const status) {
   MS_EXCEPTION_IF_NULL(status);
@@ -361,6 +484,8 @@ py::object RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecIn
     case kMsBackendVmOnly: {
       // use vm only
       MS_LOG(INFO) << "RunOp use VM only backend";
+      SyncPyNativeOps();
+      WaitPendingInputs(op_exec_info);
       result = RunOpInVM(op_exec_info, status);
       break;
     }
@@ -368,6 +493,8 @@ py::object RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecIn
 #ifdef ENABLE_GE
       // use GE first, use vm when GE fails
       MS_LOG(INFO) << "RunOp use GE first backend";
+      SyncPyNativeOps();
+      WaitPendingInputs(op_exec_info);
       result = RunOpInGE(op_exec_info, status);
       if (*status != PYNATIVE_SUCCESS) {
         result = RunOpInVM(op_exec_info, status);
@@ -378,6 +505,15 @@ py::object RunOpWithBackendPolicy(MsBackendPolicy backend_policy, const OpExecIn
     case kMsBackendMsPrior: {
       // use Ms fisrt,use others when ms failed
       MS_LOG(INFO) << "RunOp use Ms first backend";
+      auto ms_context = MsContext::GetInstance();
+      MS_EXCEPTION_IF_NULL(ms_context);
+      if (ms_context->enable_pynative_async() && RunOpInMsAsync(op_exec_info, &result)) {
+        *status = PYNATIVE_SUCCESS;
+        break;
+      }
+      // ops run synchronously must not overtake the pending ones
+      SyncPyNativeOps();
+      WaitPendingInputs(op_exec_info);
       result = RunOpInMs(op_exec_info, status);
       if (*status != PYNATIVE_SUCCESS) {
         MS_LOG(ERROR) << "RunOp use Ms backend failed!!!";
@@ -436,6 +572,11 @@ py::tuple RunOp(const py::args &args) {
   return result;
 }
 
-void ClearPyNativeSession() { session = nullptr; }
+void SyncPyNativeOps() { AsyncOpExecutor::GetInstance().Sync(); }
+
+void ClearPyNativeSession() {
+  AsyncOpExecutor::GetInstance().Stop();
+  session = nullptr;
+}
 }  // namespace pynative
 }  // namespace mindspore
@@ -37,6 +37,11 @@ py::object RunOpInVM(const OpExecInfoPtr &op_exec_info, PynativeStatusCode *stat
 
 py::tuple RunOp(const py::args &args);
 
+void SyncPyNativeOps();
+
+// Wait for the ops producing the input tensors, raise the error of a failed one
+void WaitPendingInputs(const OpExecInfoPtr &op_exec_info);
+
 void ClearPyNativeSession();
 
 }  // namespace pynative
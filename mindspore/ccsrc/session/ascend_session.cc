@@ -372,8 +372,11 @@ py::tuple AscendSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &gr
   RunOpMemoryAlloc(input_tensors, graph.get());
   // load input data to device
   LoadInputData(graph, input_tensors);
-  // run op
-  RunOpExecTask(graph);
+  // run op, release the GIL so that python can go on while the kernel runs
+  {
+    py::gil_scoped_release release;
+    RunOpExecTask(graph);
+  }
   // get output
   VectorRef outputs;
   UpdateOutputs(graph, &outputs, input_tensors);
@@ -24,7 +24,11 @@
 #include "device/kernel_runtime.h"
 #include "predict/predict.h"
 #include "kernel/cpu/cpu_kernel_factory.h"
+#include "kernel/cpu/mkldnn/mkl_primitive_cache.h"
 #include "device/cpu/kernel_select_cpu.h"
+#include "pre_activate/cpu/cpu_backend_optimization.h"
+#include "pre_activate/mem_reuse/mem_swap.h"
+#include "utils/context/ms_context.h"
 
 namespace mindspore {
 namespace session {
@@ -32,11 +36,18 @@ GraphId CPUSession::CompileGraph(const AnfNodePtrList &lst, const AnfNodePtrList
   auto graph_id = graph_sum_;
   auto graph = ConstructKernelGraph(lst, outputs);
   MS_EXCEPTION_IF_NULL(graph);
+  MS_LOG(INFO) << "IRFusion optimize";
+  opt::CPUBackendIRFusionOptimization(graph);
+  opt::CPUDataLayout(graph);
   MS_LOG(INFO) << "Set kernel info";
   SetKernelInfo(graph.get());
   predictmodel::StepConvertGraph(graph);
   MS_LOG(INFO) << "Build kernel";
   BuildKernel(graph.get());
+  auto execution_order = graph->execution_order();
+  Reorder(&execution_order);
+  graph->set_execution_order(execution_order);
+  SwapMemory(graph.get());
   MS_LOG(INFO) << "Assign kernel address";
   runtime_.AssignKernelAddress(graph.get());
   return graph_id;
@@ -49,9 +60,6 @@ void CPUSession::RunGraph(const GraphId &graph_id, const std::vector<tensor::Ten
   runtime_.BindInputOutput(kernel_graph.get(), inputs, outputs);
   MS_LOG(INFO) << "Run graph start";
   predictmodel::StepConvertWeight(inputs);
-  auto execution_order = kernel_graph->execution_order();
-  Reorder(&execution_order);
-  kernel_graph->set_execution_order(execution_order);
   bool ret = runtime_.Run(kernel_graph.get());
   if (!ret) {
     MS_LOG(EXCEPTION) << "Run graph failed";
@@ -73,6 +81,9 @@ void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
   auto &kernel_nodes = kernel_graph->execution_order();
   for (const auto &kernel_node : kernel_nodes) {
     MS_EXCEPTION_IF_NULL(kernel_node);
+    if (AnfAlgo::GetKernelMod(kernel_node) != nullptr) {
+      continue;
+    }
     std::string kernel_name = AnfAlgo::GetCNodeName(kernel_node);
     MS_LOG(INFO) << "Cpu building operator[" << kernel_name << "].";
     std::shared_ptr<kernel::CPUKernel> cpu_kernel =
@@ -84,6 +95,28 @@ void CPUSession::BuildKernel(const KernelGraph *kernel_graph) {
     AnfAlgo::SetKernelMod(cpu_kernel, kernel_node.get());
     MS_LOG(INFO) << "Cpu build success operator[" << kernel_name << "].";
   }
+  auto &primitive_cache = kernel::MKLPrimitiveCache::GetInstance();
+  MS_LOG(INFO) << "Mkl primitive cache size " << primitive_cache.size() << ", hit " << primitive_cache.hit_count()
+               << ", miss " << primitive_cache.miss_count() << ".";
+}
+
+void CPUSession::SwapMemory(KernelGraph *kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  auto context_ptr = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context_ptr);
+  auto memory_limit = static_cast<size_t>(context_ptr->swap_memory_max_size());
+  runtime_.set_memory_limit(memory_limit);
+  if (!memreuse::MemSwap(kernel_graph, memory_limit)) {
+    return;
+  }
+  MS_LOG(INFO) << "Build the swap kernels";
+  for (const auto &kernel_node : kernel_graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel_node);
+    if (AnfAlgo::GetKernelMod(kernel_node) == nullptr) {
+      device::cpu::SetKernelInfo(kernel_node);
+    }
+  }
+  BuildKernel(kernel_graph);
 }
 }  // namespace session
 }  // namespace mindspore
@@ -38,6 +38,8 @@ class CPUSession : public SessionBasic {
  private:
   void SetKernelInfo(const KernelGraph *kernel_graph);
   void BuildKernel(const KernelGraph *kernel_graph);
+  // swap tensors to the host to fit the swap_memory_max_size of the context
+  void SwapMemory(KernelGraph *kernel_graph);
   device::cpu::CPUKernelRuntime runtime_;
 };
 MS_REG_SESSION(kCPUDevice, CPUSession);
@@ -150,7 +150,11 @@ py::tuple GPUSession::RunOp(const OpRunInfo &op_run_info, const GraphInfo &graph
   RunOpAllocateMemory(input_tensors, kernel_graph.get());
   // Execute the computation
   LoadInputData(kernel_graph, input_tensors);
-  Execute(kernel_graph);
+  {
+    // Release the GIL so that python can go on while the kernels run
+    py::gil_scoped_release release;
+    Execute(kernel_graph);
+  }
   // Fetch outputs
   VectorRef outputs;
   UpdateOutputs(kernel_graph, &outputs, input_tensors);
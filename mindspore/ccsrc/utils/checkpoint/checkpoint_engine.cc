@@ -0,0 +1,479 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/checkpoint/checkpoint_engine.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "pybind11/numpy.h"
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+#include "utils/system/crc32c.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace {
+constexpr size_t kMaxWriteThreadNum = 8;
+// large tensors are written and copied in chunks
+constexpr size_t kChunkSize = 64 << 20;
+
+uint64_t AlignUp(uint64_t size, uint64_t align) { return (size + align - 1) / align * align; }
+
+std::string GetNumpyFormat(TypeId data_type) {
+  static const std::unordered_map<int, std::string> type_to_format = {
+    {kNumberTypeBool, "?"},    {kNumberTypeInt8, "b"},    {kNumberTypeInt16, "h"},   {kNumberTypeInt32, "i"},
+    {kNumberTypeInt64, "q"},   {kNumberTypeUInt8, "B"},   {kNumberTypeUInt16, "H"},  {kNumberTypeUInt32, "I"},
+    {kNumberTypeUInt64, "Q"},  {kNumberTypeFloat16, "e"}, {kNumberTypeFloat32, "f"}, {kNumberTypeFloat64, "d"}};
+  auto iter = type_to_format.find(static_cast<int>(data_type));
+  if (iter == type_to_format.end()) {
+    MS_LOG(EXCEPTION) << "Unsupported checkpoint data type " << TypeIdLabel(data_type);
+  }
+  return iter->second;
+}
+
+template <typename T>
+void AppendValue(std::string *buffer, T value) {
+  (void)buffer->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(const uint8_t *buffer, size_t size, size_t *pos, T *value) {
+  if (*pos + sizeof(T) > size) {
+    return false;
+  }
+  if (memcpy_s(value, sizeof(T), buffer + *pos, sizeof(T)) != EOK) {
+    return false;
+  }
+  *pos += sizeof(T);
+  return true;
+}
+
+size_t EntryIndexSize(const CheckpointEntry &entry) {
+  // name length, name, data type, dim num, dims, offset, size, crc
+  return sizeof(uint32_t) + entry.name.size() + sizeof(int32_t) + sizeof(uint32_t) +
+         entry.dims.size() * sizeof(int64_t) + sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t);
+}
+
+bool CopyData(uint8_t *dst, const uint8_t *src, uint64_t size) {
+  // memcpy_s refuses sizes larger than 2GB
+  while (size > 0) {
+    size_t len = static_cast<size_t>(std::min<uint64_t>(size, kChunkSize));
+    if (memcpy_s(dst, len, src, len) != EOK) {
+      return false;
+    }
+    dst += len;
+    src += len;
+    size -= len;
+  }
+  return true;
+}
+
+bool WriteAll(int fd, const void *data, uint64_t size, uint64_t offset) {
+  auto ptr = static_cast<const uint8_t *>(data);
+  while (size > 0) {
+    size_t len = static_cast<size_t>(std::min<uint64_t>(size, kChunkSize));
+    ssize_t ret = pwrite(fd, ptr, len, static_cast<off_t>(offset));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      MS_LOG(ERROR) << "Write checkpoint failed, errno " << errno;
+      return false;
+    }
+    ptr += ret;
+    size -= static_cast<uint64_t>(ret);
+    offset += static_cast<uint64_t>(ret);
+  }
+  return true;
+}
+}  // namespace
+
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile() {
+    if (addr_ != nullptr) {
+      (void)munmap(addr_, size_);
+      addr_ = nullptr;
+    }
+  }
+
+  bool Map(const std::string &file_name) {
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "Open checkpoint file " << file_name << " failed, errno " << errno;
+      return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+      MS_LOG(ERROR) << "Get the size of checkpoint file " << file_name << " failed.";
+      (void)close(fd);
+      return false;
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    // private writable mapping: tensors may be modified in place, the pages are copied on write
+    void *addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED) {
+      MS_LOG(ERROR) << "Map checkpoint file " << file_name << " failed, errno " << errno;
+      return false;
+    }
+    addr_ = static_cast<uint8_t *>(addr);
+    return true;
+  }
+
+  uint8_t *addr() const { return addr_; }
+  size_t size() const { return size_; }
+
+ private:
+  uint8_t *addr_{nullptr};
+  size_t size_{0};
+};
+
+bool IsNativeCheckpoint(const std::string &file_name) {
+  FILE *file = fopen(file_name.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  char magic[kCheckpointMagicSize] = {0};
+  size_t read_size = fread(magic, 1, kCheckpointMagicSize, file);
+  (void)fclose(file);
+  return read_size == kCheckpointMagicSize && memcmp(magic, kCheckpointMagic, kCheckpointMagicSize) == 0;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string &file_name) : file_name_(file_name) {
+  thread_num_ = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), kMaxWriteThreadNum);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+  if (pending_save_.valid() && !pending_save_.get()) {
+    MS_LOG(ERROR) << "Save checkpoint " << file_name_ << " in background failed.";
+  }
+}
+
+bool CheckpointWriter::Prepare(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors,
+                               bool snapshot) {
+  if (names.size() != tensors.size()) {
+    MS_LOG(ERROR) << "The names size " << names.size() << " is not equal to the tensors size " << tensors.size();
+    return false;
+  }
+  Reset();
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    auto &tensor = tensors[i];
+    MS_EXCEPTION_IF_NULL(tensor);
+    // copy the data from device, the host buffer of the tensor is updated
+    (void)tensor->data_sync();
+    CheckpointEntry entry;
+    entry.name = names[i];
+    entry.data_type = tensor->data_type();
+    (void)GetNumpyFormat(entry.data_type);
+    for (auto dim : tensor->shape()) {
+      entry.dims.push_back(static_cast<int64_t>(dim));
+    }
+    const void *data = tensor->data_c();
+    entry.size = static_cast<uint64_t>(tensor->data().nbytes());
+    if (snapshot) {
+      std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[std::max<uint64_t>(entry.size, 1)]);
+      if (buffer == nullptr) {
+        MS_LOG(ERROR) << "Malloc snapshot of " << entry.name << " failed, size " << entry.size;
+        Reset();
+        return false;
+      }
+      if (!CopyData(buffer.get(), static_cast<const uint8_t *>(data), entry.size)) {
+        MS_LOG(ERROR) << "Copy snapshot of " << entry.name << " failed, size " << entry.size;
+        Reset();
+        return false;
+      }
+      buffers_.push_back(buffer.get());
+      snapshot_.push_back(std::move(buffer));
+    } else {
+      buffers_.push_back(data);
+      borrowed_.push_back(tensor->data());
+    }
+    entries_.push_back(entry);
+  }
+  return true;
+}
+
+std::string CheckpointWriter::BuildIndex() {
+  std::string index;
+  for (auto &entry : entries_) {
+    AppendValue(&index, static_cast<uint32_t>(entry.name.size()));
+    (void)index.append(entry.name);
+    AppendValue(&index, static_cast<int32_t>(entry.data_type));
+    AppendValue(&index, static_cast<uint32_t>(entry.dims.size()));
+    for (auto dim : entry.dims) {
+      AppendValue(&index, dim);
+    }
+    AppendValue(&index, entry.offset);
+    AppendValue(&index, entry.size);
+    AppendValue(&index, entry.crc);
+  }
+  return index;
+}
+
+bool CheckpointWriter::WriteData(int fd, const std::vector<size_t> &order) {
+  std::atomic<size_t> next(0);
+  std::atomic<bool> success(true);
+  auto write_task = [this, fd, &order, &next, &success]() {
+    while (success) {
+      size_t pos = next++;
+      if (pos >= order.size()) {
+        return;
+      }
+      auto &entry = entries_[order[pos]];
+      auto data = static_cast<const char *>(buffers_[order[pos]]);
+      entry.crc = system::Crc32c::GetMaskCrc32cValue(data, entry.size);
+      if (!WriteAll(fd, data, entry.size, entry.offset)) {
+        MS_LOG(ERROR) << "Write tensor " << entry.name << " failed.";
+        success = false;
+      }
+    }
+  };
+  size_t thread_num = std::min(std::max<size_t>(thread_num_, 1), std::max<size_t>(order.size(), 1));
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_num; ++i) {
+    threads.emplace_back(write_task);
+  }
+  write_task();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return success;
+}
+
+bool CheckpointWriter::WriteFile() {
+  // the layout is fixed before writing since the index size does not depend on the offsets and crcs
+  uint64_t index_size = 0;
+  for (auto &entry : entries_) {
+    index_size += EntryIndexSize(entry);
+  }
+  uint64_t data_offset = AlignUp(sizeof(CheckpointHeader) + index_size, kCheckpointPageAlign);
+  uint64_t file_size = data_offset;
+  for (auto &entry : entries_) {
+    entry.offset = AlignUp(file_size, kCheckpointDataAlign);
+    file_size = entry.offset + entry.size;
+  }
+  // write the bigger tensors first for a better balance between the threads
+  std::vector<size_t> order(entries_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return entries_[a].size > entries_[b].size; });
+
+  std::string tmp_file_name = file_name_ + ".tmp";
+  int fd = open(tmp_file_name.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Create checkpoint file " << tmp_file_name << " failed, errno " << errno;
+    return false;
+  }
+  bool success = ftruncate(fd, static_cast<off_t>(file_size)) == 0 && WriteData(fd, order);
+  if (success) {
+    std::string index = BuildIndex();
+    CheckpointHeader header;
+    (void)memset_s(&header, sizeof(header), 0, sizeof(header));
+    (void)memcpy_s(header.magic, sizeof(header.magic), kCheckpointMagic, kCheckpointMagicSize);
+    header.version = kCheckpointVersion;
+    header.tensor_num = static_cast<uint32_t>(entries_.size());
+    header.index_size = index_size;
+    header.data_offset = data_offset;
+    header.file_size = file_size;
+    header.index_crc = system::Crc32c::GetMaskCrc32cValue(index.data(), index.size());
+    success = WriteAll(fd, &header, sizeof(header), 0) && WriteAll(fd, index.data(), index.size(), sizeof(header)) &&
+              fsync(fd) == 0;
+  }
+  if (close(fd) != 0) {
+    success = false;
+  }
+  if (!success) {
+    MS_LOG(ERROR) << "Write checkpoint file " << tmp_file_name << " failed.";
+    (void)remove(tmp_file_name.c_str());
+    return false;
+  }
+  (void)chmod(tmp_file_name.c_str(), S_IRUSR);
+  if (rename(tmp_file_name.c_str(), file_name_.c_str()) != 0) {
+    MS_LOG(ERROR) << "Rename checkpoint file " << tmp_file_name << " to " << file_name_ << " failed, errno " << errno;
+    (void)remove(tmp_file_name.c_str());
+    return false;
+  }
+  MS_LOG(INFO) << "Save checkpoint " << file_name_ << " finish, " << entries_.size() << " tensors, " << file_size
+               << " bytes.";
+  return true;
+}
+
+bool CheckpointWriter::Save(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors) {
+  if (!Wait()) {
+    MS_LOG(WARNING) << "The previous background save of " << file_name_ << " failed.";
+  }
+  if (!Prepare(names, tensors, false)) {
+    return false;
+  }
+  bool success = false;
+  {
+    py::gil_scoped_release release;
+    success = WriteFile();
+  }
+  // the borrowed buffers are python objects, release them with the GIL held
+  Reset();
+  return success;
+}
+
+bool CheckpointWriter::SaveAsync(const std::vector<std::string> &names,
+                                 const std::vector<tensor::TensorPtr> &tensors) {
+  if (!Wait()) {
+    MS_LOG(WARNING) << "The previous background save of " << file_name_ << " failed.";
+  }
+  if (!Prepare(names, tensors, true)) {
+    return false;
+  }
+  pending_save_ = std::async(std::launch::async, [this]() { return WriteFile(); });
+  return true;
+}
+
+bool CheckpointWriter::Wait() {
+  if (!pending_save_.valid()) {
+    return true;
+  }
+  bool success = false;
+  {
+    py::gil_scoped_release release;
+    success = pending_save_.get();
+  }
+  Reset();
+  return success;
+}
+
+void CheckpointWriter::Reset() {
+  entries_.clear();
+  buffers_.clear();
+  borrowed_.clear();
+  snapshot_.clear();
+}
+
+CheckpointReader::CheckpointReader(const std::string &file_name) : file_name_(file_name) {}
+
+bool CheckpointReader::Open() {
+  mapped_file_ = std::make_shared<MappedFile>();
+  if (!mapped_file_->Map(file_name_)) {
+    mapped_file_ = nullptr;
+    return false;
+  }
+  const uint8_t *addr = mapped_file_->addr();
+  size_t file_size = mapped_file_->size();
+  CheckpointHeader header;
+  if (file_size < sizeof(header) || memcpy_s(&header, sizeof(header), addr, sizeof(header)) != EOK) {
+    MS_LOG(ERROR) << "The checkpoint file " << file_name_ << " is too small.";
+    return false;
+  }
+  if (memcmp(header.magic, kCheckpointMagic, kCheckpointMagicSize) != 0 || header.version != kCheckpointVersion) {
+    MS_LOG(ERROR) << "The checkpoint file " << file_name_ << " is not a native checkpoint of version "
+                  << kCheckpointVersion;
+    return false;
+  }
+  if (header.file_size > file_size || sizeof(header) + header.index_size > header.data_offset ||
+      header.data_offset > header.file_size) {
+    MS_LOG(ERROR) << "The checkpoint file " << file_name_ << " is truncated or broken.";
+    return false;
+  }
+  auto index = reinterpret_cast<const char *>(addr + sizeof(header));
+  if (system::Crc32c::GetMaskCrc32cValue(index, header.index_size) != header.index_crc) {
+    MS_LOG(ERROR) << "The index crc of checkpoint file " << file_name_ << " is wrong.";
+    return false;
+  }
+  const uint8_t *index_addr = addr + sizeof(header);
+  size_t index_size = header.index_size;
+  size_t pos = 0;
+  entries_.clear();
+  name_to_index_.clear();
+  for (uint32_t i = 0; i < header.tensor_num; ++i) {
+    CheckpointEntry entry;
+    uint32_t name_size = 0;
+    int32_t data_type = 0;
+    uint32_t dim_num = 0;
+    bool success = ReadValue(index_addr, index_size, &pos, &name_size) && pos + name_size <= index_size;
+    if (success) {
+      entry.name.assign(reinterpret_cast<const char *>(index_addr + pos), name_size);
+      pos += name_size;
+      success = ReadValue(index_addr, index_size, &pos, &data_type) && ReadValue(index_addr, index_size, &pos, &dim_num);
+    }
+    for (uint32_t j = 0; success && j < dim_num; ++j) {
+      int64_t dim = 0;
+      success = ReadValue(index_addr, index_size, &pos, &dim);
+      entry.dims.push_back(dim);
+    }
+    success = success && ReadValue(index_addr, index_size, &pos, &entry.offset) &&
+              ReadValue(index_addr, index_size, &pos, &entry.size) && ReadValue(index_addr, index_size, &pos, &entry.crc);
+    if (!success || entry.offset + entry.size > header.file_size) {
+      MS_LOG(ERROR) << "The index of checkpoint file " << file_name_ << " is broken at tensor " << i;
+      return false;
+    }
+    entry.data_type = static_cast<TypeId>(data_type);
+    name_to_index_[entry.name] = entries_.size();
+    entries_.push_back(entry);
+  }
+  MS_LOG(INFO) << "Open checkpoint " << file_name_ << " with " << entries_.size() << " tensors.";
+  return true;
+}
+
+std::vector<std::string> CheckpointReader::GetNames() const {
+  std::vector<std::string> names;
+  for (auto &entry : entries_) {
+    names.push_back(entry.name);
+  }
+  return names;
+}
+
+const CheckpointEntry &CheckpointReader::GetEntry(const std::string &name) const {
+  auto iter = name_to_index_.find(name);
+  if (mapped_file_ == nullptr || iter == name_to_index_.end()) {
+    MS_LOG(EXCEPTION) << "Tensor " << name << " is not found in checkpoint " << file_name_;
+  }
+  return entries_[iter->second];
+}
+
+tensor::TensorPtr CheckpointReader::GetTensor(const std::string &name) const {
+  auto &entry = GetEntry(name);
+  std::vector<ssize_t> shape;
+  for (auto dim : entry.dims) {
+    shape.push_back(static_cast<ssize_t>(dim));
+  }
+  // the array keeps the mapping alive through its base object
+  auto holder = new std::shared_ptr<MappedFile>(mapped_file_);
+  py::capsule base(holder, [](void *ptr) { delete static_cast<std::shared_ptr<MappedFile> *>(ptr); });
+  py::array data(py::dtype(GetNumpyFormat(entry.data_type)), shape, mapped_file_->addr() + entry.offset, base);
+  if (static_cast<uint64_t>(data.nbytes()) != entry.size) {
+    MS_LOG(EXCEPTION) << "The size of tensor " << name << " is " << entry.size << ", but its shape needs "
+                      << data.nbytes();
+  }
+  return std::make_shared<tensor::Tensor>(data, TypeIdToType(entry.data_type));
+}
+
+bool CheckpointReader::CheckTensor(const std::string &name) const {
+  auto &entry = GetEntry(name);
+  auto data = reinterpret_cast<const char *>(mapped_file_->addr() + entry.offset);
+  return system::Crc32c::GetMaskCrc32cValue(data, entry.size) == entry.crc;
+}
+}  // namespace checkpoint
+}  // namespace mindspore
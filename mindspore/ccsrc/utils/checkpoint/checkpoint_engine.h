@@ -0,0 +1,135 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_ENGINE_H_
+#define MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_ENGINE_H_
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "ir/meta_tensor.h"
+
+namespace mindspore {
+namespace checkpoint {
+namespace py = pybind11;
+
+// Native Checkpoint Format:
+//  1 header     : CheckpointHeader, 64 bytes
+//  2 index      : one record per tensor, name / data type / dims / data offset / data size / masked crc32c of data
+//  3 data       : tensor data, the first tensor starts on a page boundary and every tensor is aligned to 64 bytes
+// All integers are little endian, tensors are stored in C order.
+constexpr char kCheckpointMagic[] = "MSCKPT01";
+constexpr size_t kCheckpointMagicSize = 8;
+constexpr uint32_t kCheckpointVersion = 1;
+constexpr size_t kCheckpointDataAlign = 64;
+constexpr size_t kCheckpointPageAlign = 4096;
+
+struct CheckpointHeader {
+  char magic[kCheckpointMagicSize];
+  uint32_t version;
+  uint32_t tensor_num;
+  uint64_t index_size;
+  uint64_t data_offset;
+  uint64_t file_size;
+  uint32_t index_crc;
+  uint32_t reserved[5];
+};
+static_assert(sizeof(CheckpointHeader) == 64, "The checkpoint header should be 64 bytes.");
+
+struct CheckpointEntry {
+  std::string name;
+  TypeId data_type{kTypeUnknown};
+  std::vector<int64_t> dims;
+  uint64_t offset{0};
+  uint64_t size{0};
+  uint32_t crc{0};
+};
+
+// Return true if the file starts with the native checkpoint magic.
+bool IsNativeCheckpoint(const std::string &file_name);
+
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(const std::string &file_name);
+  ~CheckpointWriter();
+
+  // Write the tensors directly from their host buffers, the tensors are synced from device first.
+  // The data is written by several threads without the GIL and without building the file in memory.
+  bool Save(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors);
+
+  // Take a host snapshot of the tensors and write it in a background thread, training may go on
+  // and update the tensors as soon as the function returns.
+  bool SaveAsync(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors);
+
+  // Wait for the background save, return whether the file has been written.
+  bool Wait();
+
+  std::string file_name() const { return file_name_; }
+  void set_thread_num(size_t thread_num) { thread_num_ = thread_num; }
+
+ private:
+  bool Prepare(const std::vector<std::string> &names, const std::vector<tensor::TensorPtr> &tensors, bool snapshot);
+  bool WriteFile();
+  bool WriteData(int fd, const std::vector<size_t> &order);
+  std::string BuildIndex();
+  void Reset();
+
+  std::string file_name_;
+  size_t thread_num_;
+  std::vector<CheckpointEntry> entries_;
+  // host buffers of the tensors, either borrowed from the tensors or owned by the snapshot
+  std::vector<const void *> buffers_;
+  std::vector<py::array> borrowed_;
+  std::vector<std::unique_ptr<uint8_t[]>> snapshot_;
+  std::future<bool> pending_save_;
+};
+
+class MappedFile;
+
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(const std::string &file_name);
+  ~CheckpointReader() = default;
+
+  // Map the file and parse the index, the tensor data is not read.
+  bool Open();
+
+  std::vector<std::string> GetNames() const;
+
+  // The returned tensor shares the pages of the file mapping, the data is loaded when it is touched.
+  // Modifying the tensor does not change the file.
+  tensor::TensorPtr GetTensor(const std::string &name) const;
+
+  // Verify the crc of the tensor data, this reads the whole tensor.
+  bool CheckTensor(const std::string &name) const;
+
+ private:
+  const CheckpointEntry &GetEntry(const std::string &name) const;
+
+  std::string file_name_;
+  std::shared_ptr<MappedFile> mapped_file_;
+  std::vector<CheckpointEntry> entries_;
+  std::unordered_map<std::string, size_t> name_to_index_;
+};
+}  // namespace checkpoint
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_CHECKPOINT_CHECKPOINT_ENGINE_H_
@@ -19,6 +19,9 @@
 #ifndef NO_DLIB
 #include "hccl/hcom.h"
 #endif
+#ifdef ENABLE_CPU_COLLECTIVE
+#include "device/cpu/distribution/cpu_collective.h"
+#endif
 
 namespace mindspore {
 CommManager &CommManager::GetInstance() noexcept {
@@ -26,6 +29,18 @@ CommManager &CommManager::GetInstance() noexcept {
   return instance;
 }
 
+// The groups of the processes initialized by init("cpu") are managed by the cpu collective
+#ifdef ENABLE_CPU_COLLECTIVE
+#define CPU_COLLECTIVE_DISPATCH(call)                           \
+  do {                                                          \
+    if (device::cpu::CPUCollective::instance().initialized()) { \
+      return device::cpu::CPUCollective::instance().call;       \
+    }                                                           \
+  } while (0)
+#else
+#define CPU_COLLECTIVE_DISPATCH(call)
+#endif
+
 #ifndef NO_DLIB
 #define HCCL_RUN_CHECK(op_name, group, op)                      \
   do {                                                          \
@@ -53,6 +68,7 @@ CommManager &CommManager::GetInstance() noexcept {
   } while (0)
 
 bool CommManager::CreateGroupSync(const string &group, const vector<unsigned int> &rank_id_list) const {
+  CPU_COLLECTIVE_DISPATCH(CreateGroup(group, rank_id_list));
   auto rank_size = rank_id_list.size();
   HCCL_GROUP_CHECK_EMPTY(group);
   HCCL_GROUP_CHECK_IS_WORLD(group);
@@ -62,33 +78,46 @@ bool CommManager::CreateGroupSync(const string &group, const vector<unsigned int
 }
 
 bool CommManager::GetRankID(const string &group, unsigned int *rank_id) const {
+  CPU_COLLECTIVE_DISPATCH(GetRankId(group, rank_id));
   HCCL_GROUP_CHECK_EMPTY(group);
   HCCL_RUN_CHECK(string("get rank_id"), group, hcom_get_rank_id(group.c_str(), rank_id));
   return true;
 }
 
 bool CommManager::GetRankSize(const string &group, unsigned int *rank_size) const {
+  CPU_COLLECTIVE_DISPATCH(GetRankSize(group, rank_size));
   HCCL_GROUP_CHECK_EMPTY(group);
   HCCL_RUN_CHECK(string("get rank size"), group, hcom_get_rank_size(group.c_str(), rank_size));
   return true;
 }
 
 bool CommManager::DestroyGroup(const string &group) const {
+  CPU_COLLECTIVE_DISPATCH(DestroyGroup(group));
   HCCL_GROUP_CHECK_EMPTY(group);
   HCCL_GROUP_CHECK_IS_WORLD(group);
   HCCL_RUN_CHECK(string("destroy communicate group"), group, hcom_destroy_group(group.c_str()));
   return true;
 }
 #else
-bool CommManager::CreateGroupSync(const string &, const vector<unsigned int> &) const { return true; }
+bool CommManager::CreateGroupSync(const string &group, const vector<unsigned int> &rank_id_list) const {
+  CPU_COLLECTIVE_DISPATCH(CreateGroup(group, rank_id_list));
+  return true;
+}
 
-bool CommManager::GetRankID(const string &group, unsigned int *rank_id) const { return true; }
+bool CommManager::GetRankID(const string &group, unsigned int *rank_id) const {
+  CPU_COLLECTIVE_DISPATCH(GetRankId(group, rank_id));
+  return true;
+}
 
 bool CommManager::GetRankSize(const string &group, unsigned int *rank_size) const {
+  CPU_COLLECTIVE_DISPATCH(GetRankSize(group, rank_size));
   *rank_size = NO_COMM_DLIB_RANK_SIZE;
   return true;
 }
 
-bool CommManager::DestroyGroup(const string &group) const { return true; }
+bool CommManager::DestroyGroup(const string &group) const {
+  CPU_COLLECTIVE_DISPATCH(DestroyGroup(group));
+  return true;
+}
 #endif
 }  // namespace mindspore
@@ -74,9 +74,12 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   precompile_only_ = false;
   auto_mixed_precision_flag_ = true;
   enable_pynative_infer_ = false;
+  enable_pynative_async_ = false;
   enable_dynamic_mem_pool_ = true;
   graph_memory_max_size_ = "0";
   variable_memory_max_size_ = "0";
+  recompute_memory_max_size_ = 0;
+  swap_memory_max_size_ = 0;
   enable_loop_sink_ = target == kAscendDevice || target == kDavinciDevice;
   profiling_mode_ = false;
   profiling_options_ = "training_trace";
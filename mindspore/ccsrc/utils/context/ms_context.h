@@ -62,6 +62,9 @@ class MsContext {
   bool enable_pynative_infer() const { return enable_pynative_infer_; }
   void set_enable_pynative_infer(bool enable_pynative_infer) { enable_pynative_infer_ = enable_pynative_infer; }
 
+  bool enable_pynative_async() const { return enable_pynative_async_; }
+  void set_enable_pynative_async(bool enable_pynative_async) { enable_pynative_async_ = enable_pynative_async; }
+
   bool enable_task_sink() const { return enable_task_sink_; }
 
   void set_precompile_only(bool precompile_only) { precompile_only_ = precompile_only; }
@@ -89,6 +92,7 @@ class MsContext {
   bool enable_hccl() const { return enable_hccl_; }
   bool PynativeInitGe();
 
+  void set_ir_fusion_flag(bool flag) { ir_fusion_flag_ = flag; }
   bool ir_fusion_flag() const { return ir_fusion_flag_; }
 
   bool loop_sink_flag() const { return enable_loop_sink_; }
@@ -135,6 +139,14 @@ class MsContext {
     variable_memory_max_size_ = variable_memory_max_size;
   }
 
+  void set_recompute_memory_max_size(double recompute_memory_max_size) {
+    recompute_memory_max_size_ = recompute_memory_max_size;
+  }
+  double recompute_memory_max_size() const { return recompute_memory_max_size_; }
+
+  void set_swap_memory_max_size(double swap_memory_max_size) { swap_memory_max_size_ = swap_memory_max_size; }
+  double swap_memory_max_size() const { return swap_memory_max_size_; }
+
   void set_enable_profiling(bool flag) { profiling_mode_ = flag; }
   bool enable_profiling() const { return profiling_mode_; }
 
@@ -154,6 +166,7 @@ class MsContext {
   uint32_t device_id_;
   int execution_mode_;
   bool enable_pynative_infer_;
+  bool enable_pynative_async_;
   bool save_graphs_flag_;
   std::string save_graphs_path_;
   uint32_t tsd_ref_;
@@ -176,6 +189,8 @@ class MsContext {
   bool enable_dynamic_mem_pool_;
   std::string graph_memory_max_size_;
   std::string variable_memory_max_size_;
+  double recompute_memory_max_size_;
+  double swap_memory_max_size_;
   std::thread tdt_print_;
   bool profiling_mode_;
   std::string profiling_options_;
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/data_version.h"
+
+namespace mindspore {
+DataVersion &DataVersion::GetInstance() {
+  static DataVersion instance;
+  return instance;
+}
+
+uint64_t DataVersion::Get(const void *addr) {
+  std::lock_guard<std::mutex> lock(lock_);
+  auto iter = versions_.find(addr);
+  if (iter == versions_.end()) {
+    iter = versions_.emplace(addr, ++counter_).first;
+  }
+  return iter->second;
+}
+
+void DataVersion::Bump(const void *addr) {
+  if (addr == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(lock_);
+  auto iter = versions_.find(addr);
+  if (iter != versions_.end()) {
+    iter->second = ++counter_;
+  }
+}
+
+size_t DataVersion::tracked_size() {
+  std::lock_guard<std::mutex> lock(lock_);
+  return versions_.size();
+}
+
+void DataVersion::Clear() {
+  std::lock_guard<std::mutex> lock(lock_);
+  versions_.clear();
+}
+}  // namespace mindspore
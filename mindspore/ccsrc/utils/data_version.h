@@ -0,0 +1,50 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_DATA_VERSION_H_
+#define MINDSPORE_CCSRC_UTILS_DATA_VERSION_H_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace mindspore {
+// The version of the data at an address, for the kernels keeping a converted copy of their inputs across launches.
+// Every writer of the data outside the kernel graph (the tensor data set from python or loaded from a checkpoint,
+// the swap and the optimizer kernels) bumps the version of the address it writes.
+class DataVersion {
+ public:
+  static DataVersion &GetInstance();
+  // the address is tracked from the first call, the version of an address changes after every bump
+  uint64_t Get(const void *addr);
+  // only the tracked addresses are bumped, so the writers of the untracked data do not pay for the map
+  void Bump(const void *addr);
+  size_t tracked_size();
+  void Clear();
+
+  DataVersion(const DataVersion &) = delete;
+  DataVersion &operator=(const DataVersion &) = delete;
+
+ private:
+  DataVersion() = default;
+  ~DataVersion() = default;
+  std::mutex lock_;
+  std::unordered_map<const void *, uint64_t> versions_;
+  uint64_t counter_{0};
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_DATA_VERSION_H_
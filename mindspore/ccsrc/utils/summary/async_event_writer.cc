@@ -0,0 +1,226 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/summary/async_event_writer.h"
+
+#include <chrono>
+#include <string>
+#include "utils/log_adapter.h"
+#include "utils/convert_utils.h"
+
+namespace mindspore {
+namespace summary {
+namespace {
+constexpr size_t kQueueSlots = 1024;
+constexpr auto kIdleWait = std::chrono::milliseconds(10);
+constexpr auto kFullWait = std::chrono::microseconds(200);
+}  // namespace
+
+AsyncEventWriter::AsyncEventWriter(const std::string &file_full_name, size_t max_queue_bytes, int policy)
+    : writer_(file_full_name), max_queue_bytes_(max_queue_bytes), policy_(policy), queue_(kQueueSlots) {
+  if (policy_ != kSummaryDrop && policy_ != kSummarySample) {
+    MS_LOG(EXCEPTION) << "Unknown summary queue policy " << policy_ << ".";
+  }
+  if (max_queue_bytes_ == 0) {
+    MS_LOG(EXCEPTION) << "The max queue bytes of the summary writer should be greater than 0.";
+  }
+}
+
+AsyncEventWriter::~AsyncEventWriter() {
+  if (!Shut()) {
+    MS_LOG(ERROR) << "Shut the async event writer of file(" << writer_.GetFileName() << ") failed.";
+  }
+}
+
+bool AsyncEventWriter::Open() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    return true;
+  }
+  if (!writer_.Open()) {
+    return false;
+  }
+  running_ = true;
+  writer_thread_ = std::thread(&AsyncEventWriter::WriterLoop, this);
+  return true;
+}
+
+bool AsyncEventWriter::Admit(size_t size, bool droppable) {
+  uint64_t queued = queued_bytes_.load();
+  if (droppable && policy_ == kSummarySample && queued + size > max_queue_bytes_ / 2) {
+    if (sample_count_.fetch_add(1) % sample_interval_ != 0) {
+      (void)sampled_events_.fetch_add(1);
+      return false;
+    }
+  }
+  while (true) {
+    // an event which must not be lost and is larger than the limit goes once the queue is empty
+    if (queued + size <= max_queue_bytes_ || (!droppable && queued == 0)) {
+      if (queued_bytes_.compare_exchange_weak(queued, queued + size)) {
+        return true;
+      }
+      continue;
+    }
+    if (droppable) {
+      Drop(size);
+      return false;
+    }
+    // wait for the writer to make room, which it no longer does once it is shut
+    if (!running_.load()) {
+      MS_LOG(ERROR) << "The event of " << size << " bytes is not written because the async event writer of file("
+                    << writer_.GetFileName() << ") has been shut.";
+      return false;
+    }
+    work_cond_.notify_one();
+    std::this_thread::sleep_for(kFullWait);
+    queued = queued_bytes_.load();
+  }
+}
+
+void AsyncEventWriter::Drop(size_t size) {
+  (void)dropped_events_.fetch_add(1);
+  if (!drop_warned_.exchange(true)) {
+    MS_LOG(WARNING) << "The summary queue of file(" << writer_.GetFileName() << ") is full, the event of " << size
+                    << " bytes is dropped, the max queue bytes is " << max_queue_bytes_ << ".";
+  }
+}
+
+bool AsyncEventWriter::Write(const std::string &event_str, bool droppable) {
+  if (!running_.load()) {
+    MS_LOG(ERROR) << "Write failed because the async event writer is not opened or has been shut.";
+    return false;
+  }
+  size_t size = event_str.size();
+  if (!Admit(size, droppable)) {
+    return false;
+  }
+  uint64_t queued = queued_bytes_.load();
+  uint64_t peak = peak_queued_bytes_.load();
+  while (queued > peak && !peak_queued_bytes_.compare_exchange_weak(peak, queued)) {
+  }
+
+  std::string event = event_str;
+  while (!queue_.TryPush(std::move(event))) {
+    if (droppable) {
+      (void)queued_bytes_.fetch_sub(size);
+      Drop(size);
+      return false;
+    }
+    if (!running_.load()) {
+      (void)queued_bytes_.fetch_sub(size);
+      MS_LOG(ERROR) << "The event of " << size << " bytes is not written because the async event writer of file("
+                    << writer_.GetFileName() << ") has been shut.";
+      return false;
+    }
+    work_cond_.notify_one();
+    std::this_thread::sleep_for(kFullWait);
+  }
+  if (writer_idle_.load()) {
+    work_cond_.notify_one();
+  }
+  return true;
+}
+
+size_t AsyncEventWriter::WriteQueued() {
+  size_t popped = 0;
+  std::string event;
+  std::string batch;
+  while (true) {
+    batch.clear();
+    int32_t count = 0;
+    uint64_t bytes = 0;
+    while (batch.size() < batch_bytes_ && queue_.TryPop(&event)) {
+      EventWriter::EncodeRecord(event, &batch);
+      bytes += event.size();
+      ++count;
+    }
+    if (count == 0) {
+      return popped;
+    }
+    if (!writer_.WriteBatch(batch, count)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      write_failed_ = true;
+    } else {
+      (void)written_events_.fetch_add(count);
+    }
+    // the memory of the batch is released only once it is written
+    (void)queued_bytes_.fetch_sub(bytes);
+    popped += IntToSize(count);
+  }
+}
+
+void AsyncEventWriter::WriterLoop() {
+  while (true) {
+    if (WriteQueued() > 0) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (flush_requested_ || !running_) {
+      // everything pushed before the request is visible now, drain it before answering
+      lock.unlock();
+      (void)WriteQueued();
+      bool result = writer_.Flush();
+      lock.lock();
+      write_failed_ = write_failed_ || !result;
+      flush_requested_ = false;
+      done_cond_.notify_all();
+      if (!running_) {
+        return;
+      }
+      continue;
+    }
+    writer_idle_ = true;
+    (void)work_cond_.wait_for(lock, kIdleWait,
+                              [this] { return flush_requested_ || !running_ || queued_bytes_.load() > 0; });
+    writer_idle_ = false;
+  }
+}
+
+bool AsyncEventWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!running_) {
+    MS_LOG(ERROR) << "Flush failed because the async event writer is not opened or has been shut.";
+    return false;
+  }
+  flush_requested_ = true;
+  work_cond_.notify_one();
+  done_cond_.wait(lock, [this] { return !flush_requested_; });
+  bool result = !write_failed_;
+  write_failed_ = false;
+  return result;
+}
+
+bool AsyncEventWriter::Shut() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return true;
+    }
+    running_ = false;
+  }
+  work_cond_.notify_one();
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+  bool result = writer_.Shut() && !write_failed_;
+  if (dropped_events_.load() > 0 || sampled_events_.load() > 0) {
+    MS_LOG(WARNING) << "The summary writer of file(" << writer_.GetFileName() << ") dropped " << dropped_events_.load()
+                    << " events and sampled out " << sampled_events_.load() << " events under backpressure.";
+  }
+  return result;
+}
+}  // namespace summary
+}  // namespace mindspore
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_UTILS_SUMMARY_ASYNC_EVENT_WRITER_H_
+#define MINDSPORE_CCSRC_UTILS_SUMMARY_ASYNC_EVENT_WRITER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "utils/summary/event_writer.h"
+
+namespace mindspore {
+namespace summary {
+// Bounded multi-producer multi-consumer ring, every slot carries a sequence number so that
+// producers and consumers only contend on the head and tail counters.
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity) : mask_(RoundUp(capacity) - 1), slots_(mask_ + 1) {
+    for (size_t i = 0; i < slots_.size(); ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  ~BoundedQueue() = default;
+
+  // return false if the queue is full
+  bool TryPush(T &&item) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos & mask_];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.item = std::move(item);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // return false if the queue is empty
+  bool TryPop(T *item) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos & mask_];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          *item = std::move(slot.item);
+          slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    T item;
+  };
+  static size_t RoundUp(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    return size;
+  }
+
+  size_t mask_;
+  std::vector<Slot> slots_;
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) std::atomic<size_t> head_{0};
+};
+
+// What to do with a droppable event when the queued bytes reach the limit.
+enum SummaryQueuePolicy : int {
+  // drop the event once the queue is full
+  kSummaryDrop = 0,
+  // keep one of every sample_interval events once the queue is half full, drop when it is full
+  kSummarySample = 1,
+};
+
+// Writes the summary events on a background thread so that Write never touches the disk.
+// Memory is bounded by max_queue_bytes: droppable events (step summaries) are dropped or sampled under
+// backpressure, events which must not be lost (the first event, the graph) wait for room instead.
+class AsyncEventWriter {
+ public:
+  AsyncEventWriter(const std::string &file_full_name, size_t max_queue_bytes, int policy = kSummaryDrop);
+  ~AsyncEventWriter();
+
+  std::string GetFileName() const { return writer_.GetFileName(); }
+
+  // Open the file and start the writer thread
+  bool Open();
+
+  // Enqueue the serialized event, return false if it has been dropped
+  bool Write(const std::string &event_str, bool droppable = true);
+
+  // Wait until the events written before are on the disk
+  bool Flush();
+
+  // Write the remaining events, stop the writer thread and close the file
+  bool Shut();
+
+  // metrics
+  int32_t GetWriteEventCount() const { return written_events_.load(); }
+  uint64_t GetQueuedBytes() const { return queued_bytes_.load(); }
+  uint64_t GetPeakQueuedBytes() const { return peak_queued_bytes_.load(); }
+  uint64_t GetDroppedEvents() const { return dropped_events_.load(); }
+  uint64_t GetSampledEvents() const { return sampled_events_.load(); }
+
+  void set_sample_interval(uint32_t interval) { sample_interval_ = interval == 0 ? 1 : interval; }
+  void set_batch_bytes(size_t batch_bytes) { batch_bytes_ = batch_bytes; }
+
+ private:
+  bool Admit(size_t size, bool droppable);
+  void Drop(size_t size);
+  void WriterLoop();
+  // pop and write the queued events in batches, return the number of events popped
+  size_t WriteQueued();
+
+  EventWriter writer_;
+  size_t max_queue_bytes_;
+  int policy_;
+  uint32_t sample_interval_{10};
+  size_t batch_bytes_{4 << 20};
+  BoundedQueue<std::string> queue_;
+
+  std::atomic<uint64_t> queued_bytes_{0};
+  std::atomic<uint64_t> peak_queued_bytes_{0};
+  std::atomic<uint64_t> dropped_events_{0};
+  std::atomic<uint64_t> sampled_events_{0};
+  std::atomic<uint64_t> sample_count_{0};
+  std::atomic<int32_t> written_events_{0};
+
+  std::thread writer_thread_;
+  std::mutex mutex_;
+  std::condition_variable work_cond_;
+  std::condition_variable done_cond_;
+  std::atomic<bool> writer_idle_{false};
+  std::atomic<bool> drop_warned_{false};
+  // only changed with mutex_ held, read without it by Write
+  std::atomic<bool> running_{false};
+  bool flush_requested_{false};
+  bool write_failed_{false};
+};
+}  // namespace summary
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_UTILS_SUMMARY_ASYNC_EVENT_WRITER_H_
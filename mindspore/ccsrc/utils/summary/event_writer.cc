@@ -143,45 +143,54 @@ bool EventWriter::WriteRecord(const std::string &data) {
     MS_LOG(ERROR) << "Writer not initialized or previously closed.";
     return false;
   }
-  // Write the data to event file
+  // build the whole record first so it goes to the file in one write
+  std::string record;
+  EncodeRecord(data, &record);
+  bool result = event_file_->Write(record);
+  if (!result) {
+    MS_LOG(ERROR) << "Write the Summary record failed.";
+    return false;
+  }
+  return true;
+}
+
+void EventWriter::EncodeRecord(const std::string &data, std::string *buffer) {
+  MS_EXCEPTION_IF_NULL(buffer);
   const unsigned int kArrayLen = sizeof(uint64_t);
   char data_len_array[kArrayLen];
   char crc_array[sizeof(uint32_t)];
+  buffer->reserve(buffer->size() + data.size() + kArrayLen + 2 * sizeof(uint32_t));
 
-  // step 1: write the data length
+  // step 1: the data length
   system::EncodeFixed64(data_len_array, kArrayLen, static_cast<int64_t>(data.size()));
-  bool result = event_file_->Write(string(data_len_array, sizeof(data_len_array)));
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data length failed.";
-    return false;
-  }
+  (void)buffer->append(data_len_array, sizeof(data_len_array));
 
-  // step 2: write the crc of data length
+  // step 2: the crc of data length
   system::EncodeFixed64(data_len_array, kArrayLen, SizeToInt(data.size()));
   uint32_t crc = system::Crc32c::GetMaskCrc32cValue(data_len_array, sizeof(data_len_array));
   system::EncodeFixed32(crc_array, crc);
-  result = event_file_->Write(string(crc_array, sizeof(crc_array)));
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data length crc failed.";
-    return false;
-  }
+  (void)buffer->append(crc_array, sizeof(crc_array));
 
-  // step 3: write the data
-  result = event_file_->Write(data);
-  if (!result) {
-    MS_LOG(ERROR) << "Write the Summary data failed.";
-    return false;
-  }
+  // step 3: the data
+  (void)buffer->append(data);
 
-  // step 4: write data crc
+  // step 4: the data crc
   crc = system::Crc32c::GetMaskCrc32cValue(data.data(), data.size());
   system::EncodeFixed32(crc_array, crc);
-  result = event_file_->Write(string(crc_array, sizeof(crc_array)));
+  (void)buffer->append(crc_array, sizeof(crc_array));
+}
+
+bool EventWriter::WriteBatch(const std::string &records, int32_t count) {
+  if (event_file_ == nullptr) {
+    MS_LOG(ERROR) << "Writer not initialized or previously closed.";
+    return false;
+  }
+  events_write_count_ += count;
+  bool result = event_file_->Write(records);
   if (!result) {
-    MS_LOG(ERROR) << "Write the Summary footer failed.";
+    MS_LOG(ERROR) << "Write " << count << " Summary records failed.";
     return false;
   }
-
   return true;
 }
 
@@ -71,6 +71,12 @@ class EventWriter {
   //  4 uint32 : mask crc value of data
   bool WriteRecord(const std::string &data);
 
+  // Append one framed record of "data" to "buffer", several records can be written by one WriteBatch
+  static void EncodeRecord(const std::string &data, std::string *buffer);
+
+  // Write "count" records already framed by EncodeRecord
+  bool WriteBatch(const std::string &records, int32_t count);
+
  private:
   // True: valid / False: closed
   bool status_ = false;
@@ -112,6 +112,7 @@ constexpr auto kBNInferOpName = "BNInfer";
 constexpr auto kAdamApplyOneOpName = "AdamApplyOne";
 constexpr auto kResizeNearestNeighborGradOpName = "ResizeNearestNeighborGrad";
 constexpr auto kFusedMulAddOpName = "FusedMulAdd";
+constexpr auto kFusedElemwiseOpName = "FusedElemwise";
 constexpr auto kFusedMulAddNOpName = "FusedMulAddN";
 constexpr auto kFusedMulApplyMomentumOpName = "FusedMulApplyMomentum";
 constexpr auto kBiasAddOpName = "BiasAdd";
@@ -147,6 +148,8 @@ constexpr auto kSwitchOpName = "switch";
 constexpr auto kLarsV2OpName = "LarsV2";
 constexpr auto kLarsV2UpdateOpName = "LarsV2Update";
 constexpr auto kSquareSumAllOpName = "SquareSumAll";
+constexpr auto kSwapOutOpName = "_SwapOut";
+constexpr auto kSwapInOpName = "_SwapIn";
 
 // attr key name
 constexpr auto kAttrInputNames = "input_names";
@@ -180,6 +183,10 @@ constexpr auto kAttrDynInputSizes = "dyn_input_sizes";
 constexpr auto kAttrSrcFormat = "src_format";
 constexpr auto kAttrOutputUsedNum = "output_used_num";
 constexpr auto kAttrHasBias = "has_bias";
+constexpr auto kAttrFusedActivation = "fused_activation";
+constexpr auto kAttrFusedOps = "fused_ops";
+constexpr auto kAttrFusedOperands = "fused_operands";
+constexpr auto kAttrBlockedLayout = "blocked_layout";
 constexpr auto kAttrN = "n";
 constexpr auto kAttrLabelForInsertStreamActive = "label_for_insert_stream_active";
 constexpr auto kAttrFusion = "fusion";
@@ -189,6 +196,7 @@ constexpr auto kAttrIsTraining = "is_training";
 constexpr auto kAttrFusionId = "fusion_id";
 constexpr auto kAttrLabelIndex = "label_index";
 constexpr auto kAttrLabelSwitchList = "label_switch_list";
+constexpr auto kAttrSwapId = "swap_id";
 
 // attr value
 constexpr auto kValueTargetSwitch = "target_switch";
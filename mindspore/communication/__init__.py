@@ -18,11 +18,12 @@ Collective communication interface.
 
 from .management import GlobalComm, init, release, get_rank, get_group_size, get_world_rank_from_group_rank, \
     get_group_rank_from_world_rank, create_group, HCCL_WORLD_COMM_GROUP, NCCL_WORLD_COMM_GROUP, \
-    get_local_rank, get_local_rank_size, destroy_group
+    CPU_WORLD_COMM_GROUP, get_local_rank, get_local_rank_size, destroy_group
 
 
 __all__ = [
     "GlobalComm", "init", "release", "get_rank", "get_group_size", "get_world_rank_from_group_rank",
     "get_group_rank_from_world_rank", "create_group", "HCCL_WORLD_COMM_GROUP", "NCCL_WORLD_COMM_GROUP",
+    "CPU_WORLD_COMM_GROUP",
     "get_local_rank", "get_local_rank_size", "destroy_group"
 ]
@@ -16,9 +16,11 @@
 
 
 from ._hccl_management import load_lib as hccl_load_lib
+from .. import _c_expression as cpu_collective
 
 _HCCL_AVAILABLE = False
 _NCCL_AVAILABLE = False
+_CPU_AVAILABLE = hasattr(cpu_collective, "init_cpu_collective")
 try:
     import mindspore._ms_mpi as mpi
     _NCCL_AVAILABLE = True
@@ -44,6 +46,7 @@ else:
 
 HCCL_WORLD_COMM_GROUP = "hccl_world_group"
 NCCL_WORLD_COMM_GROUP = "nccl_world_group"
+CPU_WORLD_COMM_GROUP = "cpu_world_group"
 
 
 class Backend:
@@ -68,6 +71,7 @@ class Backend:
     UNDEFINED = "undefined"
     HCCL = "hccl"
     NCCL = "nccl"
+    CPU = "cpu"
 
     def __new__(cls, name):
         """Create instance object of Backend."""
@@ -99,6 +103,29 @@ def is_nccl_available():
     return _NCCL_AVAILABLE
 
 
+def is_cpu_available():
+    """
+    Check cpu collective api is available.
+
+    Returns:
+        Boolean. Return whether cpu collective is available or not.
+    """
+    return _CPU_AVAILABLE
+
+
+def _init_cpu_collective():
+    """Init the cpu collective of the processes given by RANK_ID, RANK_SIZE, MASTER_ADDR and MASTER_PORT."""
+    if not is_cpu_available():
+        raise RuntimeError("Distributed Communication doesn't have CPU collective built in")
+    cpu_collective.init_cpu_collective()
+
+
+def _finalize_cpu_collective():
+    """Finalize the cpu collective."""
+    if is_cpu_available():
+        cpu_collective.finalize_cpu_collective()
+
+
 def check_parameter_available(func):
     """
     Check parameter is available. If not available, raise Error.
@@ -126,12 +153,16 @@ def check_parameter_available(func):
                 raise RuntimeError("Distributed Communication doesn't have HCCL built in")
             if backend is Backend.NCCL and not is_nccl_available():
                 raise RuntimeError("Distributed Communication doesn't have NCCL built in")
+            if backend is Backend.CPU and not is_cpu_available():
+                raise RuntimeError("Distributed Communication doesn't have CPU collective built in")
 
         if group is None:
             if backend is Backend.HCCL:
                 group = HCCL_WORLD_COMM_GROUP
             elif backend is Backend.NCCL:
                 group = NCCL_WORLD_COMM_GROUP
+            elif backend is Backend.CPU:
+                group = CPU_WORLD_COMM_GROUP
         return func(*args, **kargs)
     return wrapper
 
@@ -162,6 +193,8 @@ def _get_rank_helper(group, backend):
             rank_id = mpi.get_rank_id()
         else:
             raise RuntimeError("Nccl doesn't support get_rank_id by user group now.")
+    elif backend == Backend.CPU:
+        rank_id = cpu_collective.get_cpu_collective_rank_id(group)
     else:
         raise ValueError("Invalid backend: '{}'".format(backend))
     return rank_id
@@ -190,6 +223,8 @@ def _get_local_rank_helper(group, backend):
             rank_id = hccl.get_local_rank_id(group)
     elif backend == Backend.NCCL:
         raise RuntimeError("Nccl doesn't support get_local_rank_id now.")
+    elif backend == Backend.CPU:
+        raise RuntimeError("Cpu collective doesn't support get_local_rank_id now.")
     else:
         raise ValueError("Invalid backend: '{}'".format(backend))
     return rank_id
@@ -221,6 +256,8 @@ def _get_size_helper(group, backend):
             size = mpi.get_rank_size()
         else:
             raise RuntimeError("Nccl doesn't support get_rank_size by user group now.")
+    elif backend == Backend.CPU:
+        size = cpu_collective.get_cpu_collective_rank_size(group)
     else:
         raise ValueError("Invalid backend: '{}'".format(backend))
     return size
@@ -249,6 +286,8 @@ def _get_local_size_helper(group, backend):
             size = hccl.get_local_rank_size(group)
     elif backend == Backend.NCCL:
         raise RuntimeError("Nccl doesn't support get_local_rank_size now.")
+    elif backend == Backend.CPU:
+        raise RuntimeError("Cpu collective doesn't support get_local_rank_size now.")
     else:
         raise ValueError("Invalid backend: '{}'".format(backend))
     return size
@@ -280,6 +319,8 @@ def _get_world_rank_from_group_rank_helper(group, group_rank_id, backend):
         world_rank_id = hccl.get_world_rank_from_group_rank(group, group_rank_id)
     elif backend == Backend.NCCL:
         raise RuntimeError("Nccl doesn't support get_world_rank_from_group_rank now.")
+    elif backend == Backend.CPU:
+        raise RuntimeError("Cpu collective doesn't support get_world_rank_from_group_rank now.")
     else:
         raise ValueError("Invalid backend: '{}'".format(backend))
     return world_rank_id
@@ -311,6 +352,8 @@ def _get_group_rank_from_world_rank_helper(world_rank_id, group, backend):
         group_rank_id = hccl.get_group_rank_from_world_rank(world_rank_id, group)
     elif backend == Backend.NCCL:
         raise RuntimeError("Nccl doesn't support get_group_rank_from_world_rank now.")
+    elif backend == Backend.CPU:
+        raise RuntimeError("Cpu collective doesn't support get_group_rank_from_world_rank now.")
     else:
         raise ValueError("Invalid backend: '{}'".format(backend))
     return group_rank_id
@@ -330,7 +373,7 @@ def _create_group_helper(group, rank_ids, backend):
         TypeError: If rank_ids is not a list.
         ValueError: If rank_ids size is not larger than 1 or rank_ids has duplicate data or backend is invalid.
     """
-    if backend == Backend.HCCL:
+    if backend in (Backend.HCCL, Backend.CPU):
         if not isinstance(rank_ids, list):
             raise TypeError("Rank_ids {} should be list".format(rank_ids))
         rank_size = len(rank_ids)
@@ -338,7 +381,10 @@ def _create_group_helper(group, rank_ids, backend):
             raise ValueError("Rank_ids size {} should be large than 0".format(rank_size))
         if len(rank_ids) - len(list(set(rank_ids))) > 0:
             raise ValueError("List rank_ids in Group {} has duplicate data!".format(group))
-        hccl.create_group(group, rank_size, rank_ids)
+        if backend == Backend.HCCL:
+            hccl.create_group(group, rank_size, rank_ids)
+        else:
+            cpu_collective.create_cpu_collective_group(group, rank_ids)
     elif backend == Backend.NCCL:
         raise RuntimeError("Nccl doesn't support create_group now.")
     else:
@@ -363,5 +409,9 @@ def _destroy_group_helper(group, backend):
         hccl.destroy_group(group)
     elif backend == Backend.NCCL:
         raise RuntimeError("Nccl doesn't support destroy_group now.")
+    elif backend == Backend.CPU:
+        if group == CPU_WORLD_COMM_GROUP:
+            raise ValueError("The cpu_world_group does not support destruction.")
+        cpu_collective.destroy_cpu_collective_group(group)
     else:
         raise ValueError("Invalid backend: '{}'".format(backend))
@@ -17,14 +17,15 @@ from mindspore.parallel._auto_parallel_context import auto_parallel_context
 from ._comm_helper import Backend, _get_rank_helper, _get_size_helper, \
     _get_world_rank_from_group_rank_helper, _get_group_rank_from_world_rank_helper, \
     _create_group_helper, _destroy_group_helper, HCCL_WORLD_COMM_GROUP, NCCL_WORLD_COMM_GROUP, \
-    _get_local_rank_helper, _get_local_size_helper
+    CPU_WORLD_COMM_GROUP, _get_local_rank_helper, _get_local_size_helper, _init_cpu_collective, \
+    _finalize_cpu_collective
 from .._c_expression import init_hccl, finalize_hccl, init_gpu_collective
 
 
 __all__ = ["init", "release", "get_rank", "get_local_rank", "get_group_size",
            "get_local_rank_size", "get_world_rank_from_group_rank",
            "get_group_rank_from_world_rank", "create_group", "destroy_group",
-           "HCCL_WORLD_COMM_GROUP", "NCCL_WORLD_COMM_GROUP"]
+           "HCCL_WORLD_COMM_GROUP", "NCCL_WORLD_COMM_GROUP", "CPU_WORLD_COMM_GROUP"]
 
 DEFAULT_WORLD_COMM_GROUP = HCCL_WORLD_COMM_GROUP
 DEFAULT_BACKEND = Backend("hccl")
@@ -45,11 +46,14 @@ class GlobalComm:
 
 def init(backend_name="hccl"):
     """
-    Init distributed backend, e.g., hccl/nccl, it is required before communication service can be used.
+    Init distributed backend, e.g., hccl/nccl/cpu, it is required before communication service can be used.
 
     Note:
         The full name of hccl is Huawei Collective Communication Library.
         The full name of nccl is NVIDIA Collective Communication Library.
+        The cpu backend connects the processes on the CPU, through shared memory on the same host and TCP across
+        hosts. The processes are given by the environment variables RANK_ID, RANK_SIZE, MASTER_ADDR and
+        MASTER_PORT, where the rank 0 listens. MS_CPU_COLLECTIVE_SHM=0 makes them use TCP on the same host as well.
 
     Args:
         backend_name (str): Backend.
@@ -69,6 +73,10 @@ def init(backend_name="hccl"):
         init_gpu_collective()
         GlobalComm.BACKEND = Backend("nccl")
         GlobalComm.WORLD_COMM_GROUP = NCCL_WORLD_COMM_GROUP
+    elif backend_name == "cpu":
+        _init_cpu_collective()
+        GlobalComm.BACKEND = Backend("cpu")
+        GlobalComm.WORLD_COMM_GROUP = CPU_WORLD_COMM_GROUP
     else:
         raise RuntimeError("Backend name {} is not supported.".format(backend_name))
 
@@ -77,11 +85,14 @@ def init(backend_name="hccl"):
 
 def release():
     """
-    Release distributed resource. e.g., hccl/nccl.
+    Release distributed resource. e.g., hccl/nccl/cpu.
 
     Raises:
         RuntimeError: If distributed resource release fails.
     """
+    if GlobalComm.BACKEND == Backend.CPU:
+        _finalize_cpu_collective()
+        return
     finalize_hccl()
 
 
@@ -33,6 +33,7 @@ GRAPH_MODE = 0
 PYNATIVE_MODE = 1
 # The max memory size of graph plus variable.
 _DEVICE_APP_MEMORY_SIZE = 31
+_GB = 1024 * 1024 * 1024
 
 
 def _make_directory(path):
@@ -249,6 +250,22 @@ class _Context:
     def enable_reduce_precision(self, enable_reduce_precision):
         self._context_handle.set_enable_reduce_precision_flag(enable_reduce_precision)
 
+    @property
+    def enable_pynative_async(self):
+        return self._context_handle.get_enable_pynative_async()
+
+    @enable_pynative_async.setter
+    def enable_pynative_async(self, enable_pynative_async):
+        self._context_handle.set_enable_pynative_async(enable_pynative_async)
+
+    @property
+    def enable_ir_fusion(self):
+        return self._context_handle.get_ir_fusion_flag()
+
+    @enable_ir_fusion.setter
+    def enable_ir_fusion(self, enable_ir_fusion):
+        self._context_handle.set_ir_fusion_flag(enable_ir_fusion)
+
     @property
     def enable_dump(self):
         return self._context_handle.get_enable_dump()
@@ -311,6 +328,26 @@ class _Context:
         self._context_handle.set_variable_memory_max_size(variable_memory_max_size_)
         self._context_handle.set_graph_memory_max_size(graph_memory_max_size_)
 
+    @property
+    def recompute_memory_max_size(self):
+        return str(self._context_handle.get_recompute_memory_max_size() / _GB) + "GB"
+
+    @recompute_memory_max_size.setter
+    def recompute_memory_max_size(self, recompute_memory_max_size):
+        if recompute_memory_max_size != "0GB" and not check_input_format(recompute_memory_max_size):
+            raise ValueError("Context param recompute_memory_max_size should be in correct format! Such as \"5GB\"")
+        self._context_handle.set_recompute_memory_max_size(float(recompute_memory_max_size[:-2]) * _GB)
+
+    @property
+    def swap_memory_max_size(self):
+        return str(self._context_handle.get_swap_memory_max_size() / _GB) + "GB"
+
+    @swap_memory_max_size.setter
+    def swap_memory_max_size(self, swap_memory_max_size):
+        if swap_memory_max_size != "0GB" and not check_input_format(swap_memory_max_size):
+            raise ValueError("Context param swap_memory_max_size should be in correct format! Such as \"5GB\"")
+        self._context_handle.set_swap_memory_max_size(float(swap_memory_max_size[:-2]) * _GB)
+
     @property
     def enable_ge(self):
         return self._context_handle.get_backend_policy() == 'ge'
@@ -360,7 +397,8 @@ def _context():
 
 
 @args_type_check(device_num=int, global_rank=int, mirror_mean=bool, cast_before_mirror=bool, parallel_mode=str,
-                 parameter_broadcast=bool, strategy_ckpt_load_file=str, strategy_ckpt_save_file=str)
+                 parameter_broadcast=bool, strategy_ckpt_load_file=str, strategy_ckpt_save_file=str,
+                 pipeline_stages=int, micro_batch_num=int, enable_parallel_optimizer=bool)
 def set_auto_parallel_context(**kwargs):
     """
     Set auto parallel context.
@@ -397,6 +435,19 @@ def set_auto_parallel_context(**kwargs):
                        broadcast. Default: False.
         strategy_ckpt_load_file (str): The path to load parallel strategy checkpoint. Default: ''
         strategy_ckpt_save_file (str): The path to save parallel strategy checkpoint. Default: ''
+        pipeline_stages (int): The number of pipeline stages the devices are split into, the device number must be
+                       divisible by it. Only "auto_parallel" supports more than one stage. Each stage runs its cut of
+                       the graph and passes the tensors to the next one with _Send and _Receive, which run on the
+                       CPU after init("cpu"). Default: 1.
+        micro_batch_num (int): The number of micro batches the pipeline schedules a batch in. It sets the 1F1B
+                       schedule whose step cost and bubble ratio are estimated, the batch is not split in the graph
+                       yet. Default: 1.
+        enable_parallel_optimizer (bool): Shard the optimizer states of the parameters repeated on several devices,
+                       together with the parameters, so each device keeps a slice of them. The gradients are
+                       reduce-scattered instead of allreduced and the parameters are all-gathered before the forward
+                       uses them. The parameters sharded are chosen by the cost model parameter
+                       costmodel_optimizer_shard_memory. Only "semi_auto_parallel" and "auto_parallel" support it,
+                       "semi_auto_parallel" without strategies is data parallel. Default: False.
 
     Raises:
         ValueError: If input key is not attribute in auto parallel context.
@@ -410,6 +461,8 @@ def set_auto_parallel_context(**kwargs):
         >>> context.set_auto_parallel_context(parameter_broadcast=False)
         >>> context.set_auto_parallel_context(strategy_ckpt_load_file="./strategy_stage1.ckpt")
         >>> context.set_auto_parallel_context(strategy_ckpt_save_file="./strategy_stage1.ckpt")
+        >>> context.set_auto_parallel_context(pipeline_stages=2, micro_batch_num=4)
+        >>> context.set_auto_parallel_context(enable_parallel_optimizer=True)
     """
     _set_auto_parallel_context(**kwargs)
 
@@ -442,6 +495,9 @@ def reset_auto_parallel_context():
     - parameter_broadcast: False.
     - strategy_ckpt_load_file: "".
     - strategy_ckpt_save_file: "".
+    - pipeline_stages: 1.
+    - micro_batch_num: 1.
+    - enable_parallel_optimizer: False.
     """
     _reset_auto_parallel_context()
 
@@ -449,7 +505,9 @@ def reset_auto_parallel_context():
 @args_type_check(mode=int, precompile_only=bool, device_target=str, device_id=int, save_graphs=bool,
                  save_graphs_path=str, save_ms_model=bool, save_ms_model_path=str, enable_dump=bool,
                  save_dump_path=str, enable_reduce_precision=bool, variable_memory_max_size=str,
-                 enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool)
+                 enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
+                 enable_pynative_async=bool, enable_ir_fusion=bool, recompute_memory_max_size=str,
+                 swap_memory_max_size=str)
 def set_context(**kwargs):
     """
     Sets context for running environment.
@@ -480,11 +538,24 @@ def set_context(**kwargs):
         enable_auto_mixed_precision (bool): Whether to enable auto mixed precision. Default: True.
         reserve_class_name_in_scope (bool) : Whether to save the network class name in the scope. Default: True.
         enable_reduce_precision (bool): Whether to enable precision reduction. Default: True.
+        enable_pynative_async (bool): Whether to run operators asynchronously in PYNATIVE_MODE. The outputs are
+            returned before the operator finishes and are synchronized when read by `asnumpy`, errors of the
+            operator are raised there as well. Default: False.
+        enable_ir_fusion (bool): Whether to fuse the operators of the graph before selecting their kernels, e.g. the
+            bias add and relu into the preceding convolution on CPU. Default: True.
         enable_dump (bool): Whether to enable dump. Default: False.
         save_dump_path (str): When the program is executed on Ascend, operators can dump data here.
             The root dump path is configured in /home/HwHiAiUser/ide_daemon/ide_daemon.cfg.
             So the real dump path is "{configured root dump path}/{`save_dump_path`}". Default: ".".
         variable_memory_max_size (str): Sets variable memory max size. Default: "5GB".
+        recompute_memory_max_size (str): Sets the peak memory of the activations kept for the backward in
+            GRAPH_MODE. Forward operators are recomputed in the backward, the cheapest per byte first, until the
+            activations fit, in addition to those marked by `recompute` of Primitive or Cell. "0GB" recomputes the
+            marked ones only. Default: "0GB".
+        swap_memory_max_size (str): Sets the device memory of the tensors of a graph, only used by the CPU backend
+            for now, which also enforces it as a simulated device memory. The tensors alive across the peak are
+            copied to the host and back ahead of their next use, overlapped with the operators in between, until the
+            graph fits. "0GB" swaps nothing. Default: "0GB".
         enable_profiling (bool): Whether to open profiling. Default: False.
         profiling_options (str): Sets profiling collection options, operators can profiling data here.
             Profiling collection options, the values are as follows, supporting the collection of multiple data.
@@ -511,10 +582,13 @@ def set_context(**kwargs):
         >>> context.set_context(device_id=0)
         >>> context.set_context(save_graphs=True, save_graphs_path="./model.ms")
         >>> context.set_context(enable_reduce_precision=True)
+        >>> context.set_context(enable_pynative_async=True)
         >>> context.set_context(save_ms_model=True, save_ms_model_path=".")
         >>> context.set_context(enable_dump=True, save_dump_path=".")
         >>> context.set_context(reserve_class_name_in_scope=True)
         >>> context.set_context(variable_memory_max_size="6GB")
+        >>> context.set_context(recompute_memory_max_size="8GB")
+        >>> context.set_context(swap_memory_max_size="8GB")
         >>> context.set_context(mode=context.GRAPH_MODE,
         >>>                     device_target="Ascend",device_id=0, save_graphs=True,
         >>>                     save_graphs_path="/mindspore")
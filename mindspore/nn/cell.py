@@ -659,6 +659,23 @@ class Cell:
         self.add_flags_recursive(**flags)
         return self
 
+    def recompute(self, mode=True):
+        """
+        Marks the primitive operators of the cell and its children cells to be recomputed in the backward.
+
+        The outputs of the operators are not kept from the forward to the backward, which saves the memory of
+        the activations at the cost of computing them again. Only the primitive operators held as attributes of
+        the cells are marked.
+
+        Args:
+            mode (bool): Whether to recompute the operators. Default: True.
+        """
+        for _, cell in self.cells_and_names():
+            for value in cell.__dict__.values():
+                if isinstance(value, Primitive):
+                    value.recompute(mode)
+        return self
+
     def set_train(self, mode=True):
         """
         Sets the cell to training mode.
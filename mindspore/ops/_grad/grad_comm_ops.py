@@ -20,9 +20,16 @@ from .. import operations as P
 from ..composite.multitype_ops.zeros_like_impl import zeros_like
 from ..operations.comm_ops import (AllGather, AllReduce, _AlltoAll, Broadcast,
                                    _GetTensorSlice, _MirrorOperator, ReduceOp,
-                                   ReduceScatter, _VirtualDiv)
+                                   ReduceScatter, _VirtualDiv, _Send, _Receive,
+                                   _TopKCompress, _TopKDecompress, _PowerSGDCompressP,
+                                   _PowerSGDCompressQ, _PowerSGDDecompress)
 from .grad_base import bprop_getters
 
+# the float16 sum of the scaled gradients reaches at most this, a quarter of the float16 max keeps room for rounding
+_FP16_SCALED_SUM_MAX = 16384.0
+# the smallest largest magnitude scaled, so that the scale stays finite in float32
+_FP16_SCALE_MIN_ABS_MAX = 1e-30
+
 
 @bprop_getters.register(AllReduce)
 def get_bprop_all_reduce(self):
@@ -71,9 +78,18 @@ def get_bprop_all_gather(self):
     if self.instance_name:
         instance_name = "grad" + self.instance_name
         all_gather_grad.set_prim_instance_name(instance_name)
+    # the AllGather of a parameter whose optimizer is sharded averages the gradients as the mirror operator does
+    mean_flag = hasattr(self, 'mean_flag') and self.mean_flag
+    rank_size = self.rank_size
+    mul = P.Mul()
+    cast = P.Cast()
 
     def bprop(x, out, dout):
         dx = all_gather_grad(dout)
+        if mean_flag:
+            float_one = F.scalar_cast(1.0, F.dtype(dx))
+            num = F.scalar_cast(rank_size, F.dtype(dx))
+            dx = mul(dx, cast(F.scalar_to_array(float_one/num), F.dtype(dx)))
         return (dx,)
 
     return bprop
@@ -112,9 +128,120 @@ def get_bprop_all_to_all(self):
     return bprop
 
 
+@bprop_getters.register(_Send)
+def get_bprop_send(self):
+    """Generate bprop for _Send, receive the gradient from the rank the tensor is sent to."""
+    receive = _Receive(self.sr_tag, self.dest_rank, self.shape, self.dtype, self.group)
+    if self.instance_name:
+        instance_name = "grad" + self.instance_name
+        receive.set_prim_instance_name(instance_name)
+
+    def bprop(x, out, dout):
+        dx = receive(x)
+        return (dx,)
+    return bprop
+
+
+@bprop_getters.register(_Receive)
+def get_bprop_receive(self):
+    """Generate bprop for _Receive, send the gradient back to the rank the tensor is received from."""
+    send = _Send(self.sr_tag, self.src_rank, self.shape, self.dtype, self.group)
+    if self.instance_name:
+        instance_name = "grad" + self.instance_name
+        send.set_prim_instance_name(instance_name)
+
+    def bprop(x, out, dout):
+        send_out = send(dout)
+        dx = F.depend(zeros_like(x), send_out)
+        return (dx,)
+    return bprop
+
+
+def _get_bprop_compressed_mirror(self, compression):
+    """
+    Backpropagator for the _MirrorOperator whose gradient is compressed, the allreduce fusion pass chooses the
+    compression by the cost model.
+    """
+    group = self.group
+    dev_num = self.dev_num
+    mean_flag = self.mean_flag
+    parameter = self.parameter
+    key = self.compression_key
+    mul = P.Mul()
+    cast = P.Cast()
+
+    def mean(dx):
+        float_one = F.scalar_cast(1.0, F.dtype(dx))
+        num = F.scalar_cast(dev_num, F.dtype(dx))
+        return mul(dx, cast(F.scalar_to_array(float_one/num), F.dtype(dx)))
+
+    if compression == "fp16":
+        all_reduce = AllReduce(group=group)
+        all_reduce.add_prim_attr("fusion", self.fusion if hasattr(self, 'fusion') else 1)
+        all_reduce.add_prim_attr("parameter", parameter)
+        # the largest magnitude of the gradient over the devices, a max is not fused with the sums
+        all_reduce_max = AllReduce(ReduceOp.MAX, group=group)
+        all_reduce_max.add_prim_attr("fusion", 0)
+        abs_ = P.Abs()
+        reduce_max = P.ReduceMax()
+        reshape = P.Reshape()
+        maximum = P.Maximum()
+        real_div = P.RealDiv()
+        scaled_sum_max = _FP16_SCALED_SUM_MAX / dev_num
+
+        def bprop_fp16(x, out, dout):
+            # scale the gradient so that its sum over the devices fills the float16 range without overflowing, the
+            # small gradients keep their precision instead of underflowing. All the devices use the same scale. A
+            # non finite gradient gives nan, which the loss scale detects and skips the step for
+            dx = cast(dout, mstype.float32)
+            abs_max = all_reduce_max(reshape(reduce_max(abs_(dx)), (1,)))
+            abs_max = maximum(abs_max, cast(F.scalar_to_array(_FP16_SCALE_MIN_ABS_MAX), mstype.float32))
+            scale = real_div(cast(F.scalar_to_array(scaled_sum_max), mstype.float32), abs_max)
+            dx = cast(all_reduce(cast(mul(dx, scale), mstype.float16)), mstype.float32)
+            # unscale and average in float32
+            dx = real_div(dx, scale)
+            if mean_flag:
+                dx = mean(dx)
+            return (cast(dx, F.dtype(dout)),)
+        return bprop_fp16
+
+    if compression == "topk":
+        compress = _TopKCompress(key, self.compression_topk_ratio)
+        all_gather = AllGather(group=group)
+        decompress = _TopKDecompress(dev_num)
+
+        def bprop_topk(x, out, dout):
+            dx = decompress(all_gather(compress(dout)), dout)
+            if mean_flag:
+                dx = mean(dx)
+            return (dx,)
+        return bprop_topk
+
+    rank = self.compression_powersgd_rank
+    compress_p = _PowerSGDCompressP(key, rank)
+    compress_q = _PowerSGDCompressQ(key, rank)
+    decompress = _PowerSGDDecompress(key, rank, dev_num)
+    # the factors are not fused with the other gradients
+    all_reduce_p = AllReduce(group=group)
+    all_reduce_p.add_prim_attr("fusion", 0)
+    all_reduce_q = AllReduce(group=group)
+    all_reduce_q.add_prim_attr("fusion", 0)
+
+    def bprop_powersgd(x, out, dout):
+        p = all_reduce_p(compress_p(dout))
+        q = all_reduce_q(compress_q(p, dout))
+        dx = decompress(q, dout)
+        if mean_flag:
+            dx = mean(dx)
+        return (dx,)
+    return bprop_powersgd
+
+
 @bprop_getters.register(_MirrorOperator)
 def get_bprop_mirror_operator(self):
     """Backpropagator for _MirrorOperator, do allreduce for the devices in group(only for one group)."""
+    if hasattr(self, 'compression') and self.compression != "none":
+        return _get_bprop_compressed_mirror(self, self.compression)
     group = self.group
     dev_num = self.dev_num
     mean_flag = self.mean_flag
@@ -15,6 +15,7 @@
 
 """comm_ops"""
 
+import math
 from ..._checkparam import Validator as validator
 from ..._checkparam import Rel
 from ...communication.management import get_rank, get_group_size, GlobalComm, _get_group
@@ -327,6 +328,214 @@ class _AlltoAll(PrimitiveWithInfer):
         return
 
 
+class _Send(PrimitiveWithInfer):
+    """
+    Auto parallel pipeline operator. Send the tensor to the rank of another pipeline stage, where the _Receive of the
+    same sr_tag gets it. The output is a token to keep the send in the graph. It is only for internal use of parallel
+    modules and cannot be called by users.
+
+    Args:
+        sr_tag (int): The tag pairing the send with its receive.
+        dest_rank (int): The global rank the tensor is sent to.
+        shape (tuple): The shape of the tensor.
+        dtype (:class:`mindspore.dtype`): The data type of the tensor.
+        group (str): The communication group to work on. Default: "hccl_world_group".
+    """
+
+    @prim_attr_register
+    def __init__(self, sr_tag, dest_rank, shape, dtype, group=GlobalComm.WORLD_COMM_GROUP):
+        validator.check_value_type('sr_tag', sr_tag, (int,), self.name)
+        validator.check_value_type('dest_rank', dest_rank, (int,), self.name)
+        self.sr_tag = sr_tag
+        self.dest_rank = dest_rank
+        self.shape = shape
+        self.dtype = dtype
+        self.add_prim_attr('group', _get_group(group))
+
+    def infer_shape(self, x_shape):
+        return [1]
+
+    def infer_dtype(self, x_dtype):
+        validator.check_tensor_type_same({'x': x_dtype}, target_dtypes, self.name)
+        return mstype.float32
+
+
+class _Receive(PrimitiveWithInfer):
+    """
+    Auto parallel pipeline operator. Receive the tensor sent by the _Send of the same sr_tag on another pipeline stage.
+    The input only carries the gradient of the send back in backward, its value is not used. It is only for internal
+    use of parallel modules and cannot be called by users.
+
+    Args:
+        sr_tag (int): The tag pairing the receive with its send.
+        src_rank (int): The global rank the tensor is received from.
+        shape (tuple): The shape of the tensor.
+        dtype (:class:`mindspore.dtype`): The data type of the tensor.
+        group (str): The communication group to work on. Default: "hccl_world_group".
+    """
+
+    @prim_attr_register
+    def __init__(self, sr_tag, src_rank, shape, dtype, group=GlobalComm.WORLD_COMM_GROUP):
+        validator.check_value_type('sr_tag', sr_tag, (int,), self.name)
+        validator.check_value_type('src_rank', src_rank, (int,), self.name)
+        self.sr_tag = sr_tag
+        self.src_rank = src_rank
+        self.shape = shape
+        self.dtype = dtype
+        self.add_prim_attr('group', _get_group(group))
+
+    def infer_shape(self, x_shape):
+        return list(self.shape)
+
+    def infer_dtype(self, x_dtype):
+        return self.dtype
+
+
+def _topk_count(x_shape, ratio):
+    """The number of the elements kept by _TopKCompress, at least one."""
+    count = 1
+    for dim in x_shape:
+        count *= dim
+    return min(max(int(math.ceil(ratio * count)), 1), count)
+
+
+def _powersgd_matrix(x_shape):
+    """PowerSGD views a gradient as a matrix of the first dimension by the product of the others."""
+    cols = 1
+    for dim in x_shape[1:]:
+        cols *= dim
+    return x_shape[0], cols
+
+
+class _TopKCompress(PrimitiveWithInfer):
+    """
+    Data parallel gradient compression operator. Add the residual to the gradient, keep the elements of the largest
+    magnitude and leave the others as the residual of the next step. The output is the k values followed by their k
+    indices, stored in the bits of float32. It is only for internal use of parallel modules and cannot be called by
+    users.
+
+    Args:
+        key (str): The key of the residual of the gradient.
+        ratio (float): The part of the elements kept, in (0, 1).
+    """
+
+    @prim_attr_register
+    def __init__(self, key, ratio):
+        validator.check_value_type('key', key, (str,), self.name)
+        validator.check_number_range('ratio', ratio, 0, 1, Rel.INC_NEITHER, self.name)
+
+    def infer_shape(self, x_shape):
+        return [2 * _topk_count(x_shape, self.ratio)]
+
+    def infer_dtype(self, x_dtype):
+        validator.check_tensor_type_same({'x': x_dtype}, (mstype.float32,), self.name)
+        return mstype.float32
+
+
+class _TopKDecompress(PrimitiveWithInfer):
+    """
+    Data parallel gradient decompression operator. Sum the values and indices of the _TopKCompress of all the devices,
+    gathered one after another, into a dense gradient of the shape of x. The value of x is not used. It is only for
+    internal use of parallel modules and cannot be called by users.
+
+    Args:
+        dev_num (int): The number of the devices gathered.
+    """
+
+    @prim_attr_register
+    def __init__(self, dev_num):
+        validator.check_integer('dev_num', dev_num, 0, Rel.GT, self.name)
+
+    def infer_shape(self, gathered_shape, x_shape):
+        validator.check_integer("gathered length", gathered_shape[0] % (2 * self.dev_num), 0, Rel.EQ, self.name)
+        return x_shape
+
+    def infer_dtype(self, gathered_dtype, x_dtype):
+        validator.check_tensor_type_same({'gathered': gathered_dtype, 'x': x_dtype}, (mstype.float32,), self.name)
+        return x_dtype
+
+
+class _PowerSGDCompressP(PrimitiveWithInfer):
+    """
+    Data parallel gradient compression operator, the first step of PowerSGD. Add the residual to the gradient matrix M
+    and project it to P = M * Q, Q being the one of the last step. It is only for internal use of parallel modules and
+    cannot be called by users.
+
+    Args:
+        key (str): The key of the residual and the Q of the gradient.
+        rank (int): The rank of the approximation.
+    """
+
+    @prim_attr_register
+    def __init__(self, key, rank):
+        validator.check_value_type('key', key, (str,), self.name)
+        validator.check_integer('rank', rank, 0, Rel.GT, self.name)
+
+    def infer_shape(self, x_shape):
+        validator.check_integer("x rank", len(x_shape), 2, Rel.GE, self.name)
+        rows, _ = _powersgd_matrix(x_shape)
+        return [rows, self.rank]
+
+    def infer_dtype(self, x_dtype):
+        validator.check_tensor_type_same({'x': x_dtype}, (mstype.float32,), self.name)
+        return mstype.float32
+
+
+class _PowerSGDCompressQ(PrimitiveWithInfer):
+    """
+    Data parallel gradient compression operator, the second step of PowerSGD. Orthogonalize the reduced P and project
+    the gradient matrix of _PowerSGDCompressP to Q = M^T * P. The value of x only gives the shape. It is only for
+    internal use of parallel modules and cannot be called by users.
+
+    Args:
+        key (str): The key of the residual and the Q of the gradient.
+        rank (int): The rank of the approximation.
+    """
+
+    @prim_attr_register
+    def __init__(self, key, rank):
+        validator.check_value_type('key', key, (str,), self.name)
+        validator.check_integer('rank', rank, 0, Rel.GT, self.name)
+
+    def infer_shape(self, p_shape, x_shape):
+        rows, cols = _powersgd_matrix(x_shape)
+        validator.check("p shape", list(p_shape), "expected shape", [rows, self.rank], Rel.EQ, self.name)
+        return [cols, self.rank]
+
+    def infer_dtype(self, p_dtype, x_dtype):
+        validator.check_tensor_type_same({'p': p_dtype, 'x': x_dtype}, (mstype.float32,), self.name)
+        return mstype.float32
+
+
+class _PowerSGDDecompress(PrimitiveWithInfer):
+    """
+    Data parallel gradient decompression operator, the last step of PowerSGD. The gradient is P * Q^T of the
+    orthogonalized P and the reduced Q, which is the sum of the approximations of all the devices. The difference of
+    the local gradient matrix and the average approximation is the residual of the next step and Q is kept for it.
+    The value of x only gives the shape. It is only for internal use of parallel modules and cannot be called by users.
+
+    Args:
+        key (str): The key of the residual and the Q of the gradient.
+        rank (int): The rank of the approximation.
+        dev_num (int): The number of the devices reduced.
+    """
+
+    @prim_attr_register
+    def __init__(self, key, rank, dev_num):
+        validator.check_value_type('key', key, (str,), self.name)
+        validator.check_integer('rank', rank, 0, Rel.GT, self.name)
+        validator.check_integer('dev_num', dev_num, 0, Rel.GT, self.name)
+
+    def infer_shape(self, q_shape, x_shape):
+        _, cols = _powersgd_matrix(x_shape)
+        validator.check("q shape", list(q_shape), "expected shape", [cols, self.rank], Rel.EQ, self.name)
+        return x_shape
+
+    def infer_dtype(self, q_dtype, x_dtype):
+        validator.check_tensor_type_same({'q': q_dtype, 'x': x_dtype}, (mstype.float32,), self.name)
+        return x_dtype
+
+
 class _MirrorOperator(PrimitiveWithInfer):
     """
     Auto parallel virtual operator. Do nothing in forward, do all reduce and mean in backward. It is only for
@@ -119,6 +119,20 @@ class Primitive(Primitive_):
         self.add_prim_attr("strategy", strategy)
         return self
 
+    def recompute(self, mode=True):
+        """
+        Marks the primitive operator to be recomputed in the backward instead of keeping its output.
+
+        Note:
+            Valid only in GRAPH_MODE training. Operators with random or side effects and communication
+            operators are never recomputed.
+
+        Args:
+            mode (bool): Whether to recompute the primitive operator. Default: True.
+        """
+        self.add_prim_attr("recompute", mode)
+        return self
+
     def set_prim_instance_name(self, instance_name):
         """
         Sets instance name to primitive operator.
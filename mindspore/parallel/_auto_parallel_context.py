@@ -374,6 +374,65 @@ class _AutoParallelContext:
         self.check_context_handle()
         return self._context_handle.get_enable_all_reduce_fusion()
 
+    def set_enable_parallel_optimizer(self, enable_parallel_optimizer):
+        """
+        Set enable/disable parallel optimizer.
+
+        Args:
+            enable_parallel_optimizer (bool): Enable/disable sharding the parameters and the optimizer states over
+                                              the devices they are repeated on.
+        """
+        self.check_context_handle()
+        if not isinstance(enable_parallel_optimizer, bool):
+            raise TypeError('enable_parallel_optimizer is invalid type')
+        self._context_handle.set_enable_parallel_optimizer(enable_parallel_optimizer)
+
+    def get_enable_parallel_optimizer(self):
+        """Get parallel optimizer flag."""
+        self.check_context_handle()
+        return self._context_handle.get_enable_parallel_optimizer()
+
+    def set_pipeline_stages(self, stages):
+        """
+        Set the number of pipeline stages.
+
+        Args:
+            stages (int): The number of pipeline stages the devices are split into.
+
+        Raises:
+            ValueError: If the stages is not in [1, 4096].
+        """
+        self.check_context_handle()
+        if stages < 1 or stages > 4096:
+            raise ValueError("Pipeline stages must be in [1, 4096], but got {}".format(stages))
+        self._context_handle.set_pipeline_stages(stages)
+
+    def get_pipeline_stages(self):
+        """Get the number of pipeline stages."""
+        self.check_context_handle()
+        return self._context_handle.get_pipeline_stages()
+
+    def set_micro_batch_num(self, micro_batch_num):
+        """
+        Set the number of micro batches the pipeline schedules a batch in. The batch is not split in the graph yet,
+        the micro batches give the 1F1B schedule whose step cost and bubble ratio are estimated.
+
+        Args:
+            micro_batch_num (int): The number of micro batches.
+
+        Raises:
+            ValueError: If the micro batch num is less than 1.
+        """
+        self.check_context_handle()
+        if micro_batch_num < 1:
+            raise ValueError("Micro batch num must be at least 1, but got {}".format(micro_batch_num))
+        self._context_handle.set_micro_batch_num(micro_batch_num)
+
+    def get_micro_batch_num(self):
+        """Get the number of micro batches."""
+        self.check_context_handle()
+        return self._context_handle.get_micro_batch_num()
+
     def get_device_num_is_set(self):
         """Get device number is set or not."""
         self.check_context_handle()
@@ -415,7 +474,10 @@ _set_auto_parallel_context_func_map = {
     "parallel_mode": auto_parallel_context().set_parallel_mode,
     "parameter_broadcast": auto_parallel_context().set_parameter_broadcast,
     "strategy_ckpt_load_file": auto_parallel_context().set_strategy_ckpt_load_file,
-    "strategy_ckpt_save_file": auto_parallel_context().set_strategy_ckpt_save_file}
+    "strategy_ckpt_save_file": auto_parallel_context().set_strategy_ckpt_save_file,
+    "pipeline_stages": auto_parallel_context().set_pipeline_stages,
+    "micro_batch_num": auto_parallel_context().set_micro_batch_num,
+    "enable_parallel_optimizer": auto_parallel_context().set_enable_parallel_optimizer}
 
 
 _get_auto_parallel_context_func_map = {
@@ -427,12 +489,16 @@ _get_auto_parallel_context_func_map = {
     "parallel_mode": auto_parallel_context().get_parallel_mode,
     "parameter_broadcast": auto_parallel_context().get_parameter_broadcast,
     "strategy_ckpt_load_file": auto_parallel_context().get_strategy_ckpt_load_file,
-    "strategy_ckpt_save_file": auto_parallel_context().get_strategy_ckpt_save_file}
+    "strategy_ckpt_save_file": auto_parallel_context().get_strategy_ckpt_save_file,
+    "pipeline_stages": auto_parallel_context().get_pipeline_stages,
+    "micro_batch_num": auto_parallel_context().get_micro_batch_num,
+    "enable_parallel_optimizer": auto_parallel_context().get_enable_parallel_optimizer}
 
 
 @args_type_check(device_num=int, global_rank=int, mirror_mean=bool, cast_before_mirror=bool,
                  loss_repeated_mean=bool, parallel_mode=str, parameter_broadcast=bool,
-                 strategy_ckpt_load_file=str, strategy_ckpt_save_file=str)
+                 strategy_ckpt_load_file=str, strategy_ckpt_save_file=str, pipeline_stages=int, micro_batch_num=int,
+                 enable_parallel_optimizer=bool)
 def _set_auto_parallel_context(**kwargs):
     """
     Set auto parallel context.
@@ -465,6 +531,11 @@ def _set_auto_parallel_context(**kwargs):
                        broadcast. Default: False.
         strategy_ckpt_load_file (str): The path to load parallel strategy checkpoint. Default: ''
         strategy_ckpt_save_file (str): The path to save parallel strategy checkpoint. Default: ''
+        pipeline_stages (int): The number of pipeline stages the devices are split into, only in "auto_parallel".
+                       Default: 1.
+        micro_batch_num (int): The number of micro batches the pipeline schedules a batch in. Default: 1.
+        enable_parallel_optimizer (bool): Shard the parameters and their optimizer states over the devices they are
+                       repeated on, only in "semi_auto_parallel" and "auto_parallel". Default: False.
 
     Raises:
         ValueError: If input key is not attribute in auto parallel context.
@@ -507,5 +578,8 @@ def _reset_auto_parallel_context():
     - parameter_broadcast: False.
     - strategy_ckpt_load_file: ""
     - strategy_ckpt_save_file: ""
+    - pipeline_stages: 1
+    - micro_batch_num: 1
+    - enable_parallel_optimizer: False
     """
     auto_parallel_context().reset()
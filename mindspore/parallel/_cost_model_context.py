@@ -214,6 +214,45 @@ class _CostModelContext:
             raise ValueError("Context handle is none in context!!!")
         return self._context_handle.get_costmodel_communi_bias()
 
+    def set_costmodel_profile_file(self, profile_file):
+        """
+        Set the profile of the cost model, which is loaded in place of the analytic cost parameters.
+
+        Args:
+            profile_file (str): The json file of the measured throughput curves, an empty string turns it off.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_profile_file(profile_file)
+
+    def get_costmodel_profile_file(self):
+        """
+        Get the profile of the cost model.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_profile_file()
+
+    def calibrate_costmodel_profile(self, profile_file):
+        """
+        Run the microbenchmarks of the operators and the collectives on the host, save the profile and use it.
+
+        Args:
+            profile_file (str): The json file the profile is saved to.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.calibrate_costmodel_profile(profile_file)
+
     def set_multi_subgraphs(self, multi_subgraph):
         """
         Set the flag of ANF graph containing multiple subgraphs.
@@ -443,6 +482,182 @@ class _CostModelContext:
             raise ValueError("Context handle is none in context!!!")
         return self._context_handle.get_costmodel_allreduce_fusion_computation_time_parameter()
 
+    def set_costmodel_allreduce_fusion_backward_profile_file(self, profile_file):
+        """
+        Set costmodel allreduce fusion backward profile file.
+
+        Args:
+            profile_file (str): The json file of the measured backward time of the operators.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_allreduce_fusion_backward_profile_file(profile_file)
+
+    def get_costmodel_allreduce_fusion_backward_profile_file(self):
+        """
+        Get costmodel allreduce fusion backward profile file.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_allreduce_fusion_backward_profile_file()
+
+    def set_costmodel_allreduce_fusion_bucket_bytes(self, bucket_bytes):
+        """
+        Set costmodel allreduce fusion bucket bytes.
+
+        Args:
+            bucket_bytes (float): The target bytes of the gradients fused into one AllReduce.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_allreduce_fusion_bucket_bytes(bucket_bytes)
+
+    def get_costmodel_allreduce_fusion_bucket_bytes(self):
+        """
+        Get costmodel allreduce fusion bucket bytes.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_allreduce_fusion_bucket_bytes()
+
+    def set_costmodel_gradient_compression(self, compression):
+        """
+        Set costmodel gradient compression.
+
+        Args:
+            compression (str): The compression of the gradients, "none", "fp16", "topk" or "powersgd".
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_gradient_compression(compression)
+
+    def get_costmodel_gradient_compression(self):
+        """
+        Get costmodel gradient compression.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_gradient_compression()
+
+    def set_costmodel_gradient_compression_topk_ratio(self, topk_ratio):
+        """
+        Set costmodel gradient compression topk ratio.
+
+        Args:
+            topk_ratio (float): The part of the elements of a gradient kept by the top-k, in (0, 1).
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_gradient_compression_topk_ratio(topk_ratio)
+
+    def get_costmodel_gradient_compression_topk_ratio(self):
+        """
+        Get costmodel gradient compression topk ratio.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_gradient_compression_topk_ratio()
+
+    def set_costmodel_gradient_compression_powersgd_rank(self, powersgd_rank):
+        """
+        Set costmodel gradient compression powersgd rank.
+
+        Args:
+            powersgd_rank (int): The rank of the low-rank approximation of the gradients.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_gradient_compression_powersgd_rank(powersgd_rank)
+
+    def get_costmodel_gradient_compression_powersgd_rank(self):
+        """
+        Get costmodel gradient compression powersgd rank.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_gradient_compression_powersgd_rank()
+
+    def set_costmodel_gradient_compression_element_time(self, element_time):
+        """
+        Set costmodel gradient compression element time.
+
+        Args:
+            element_time (float): The time to compress or decompress one element, in the unit of the AllReduce time.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_gradient_compression_element_time(element_time)
+
+    def get_costmodel_gradient_compression_element_time(self):
+        """
+        Get costmodel gradient compression element time.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_gradient_compression_element_time()
+
+    def set_costmodel_optimizer_shard_memory(self, shard_memory):
+        """
+        Set costmodel optimizer shard memory.
+
+        Args:
+            shard_memory (float): The bytes of the parameters and the optimizer states a device keeps when the
+                                  optimizer is sharded.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_optimizer_shard_memory(shard_memory)
+
+    def get_costmodel_optimizer_shard_memory(self):
+        """
+        Get costmodel optimizer shard memory.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_optimizer_shard_memory()
+
     def reset_cost_model(self):
         """
         Reset cost model settings.
@@ -479,6 +694,7 @@ set_cost_model_context_func_map = {
     "costmodel_communi_threshold": cost_model_context().set_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().set_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().set_costmodel_communi_bias,
+    "costmodel_profile_file": cost_model_context().set_costmodel_profile_file,
     "multi_subgraphs": cost_model_context().set_multi_subgraphs,
     "run_phase": cost_model_context().set_run_phase,
     "costmodel_allreduce_fusion_algorithm": cost_model_context().set_costmodel_allreduce_fusion_algorithm,
@@ -490,7 +706,17 @@ set_cost_model_context_func_map = {
     "costmodel_allreduce_fusion_allreduce_bandwidth":
         cost_model_context().set_costmodel_allreduce_fusion_allreduce_bandwidth,
     "costmodel_allreduce_fusion_computation_time_parameter":
-        cost_model_context().set_costmodel_allreduce_fusion_computation_time_parameter}
+        cost_model_context().set_costmodel_allreduce_fusion_computation_time_parameter,
+    "costmodel_allreduce_fusion_backward_profile_file":
+        cost_model_context().set_costmodel_allreduce_fusion_backward_profile_file,
+    "costmodel_allreduce_fusion_bucket_bytes": cost_model_context().set_costmodel_allreduce_fusion_bucket_bytes,
+    "costmodel_gradient_compression": cost_model_context().set_costmodel_gradient_compression,
+    "costmodel_gradient_compression_topk_ratio": cost_model_context().set_costmodel_gradient_compression_topk_ratio,
+    "costmodel_gradient_compression_powersgd_rank":
+        cost_model_context().set_costmodel_gradient_compression_powersgd_rank,
+    "costmodel_gradient_compression_element_time":
+        cost_model_context().set_costmodel_gradient_compression_element_time,
+    "costmodel_optimizer_shard_memory": cost_model_context().set_costmodel_optimizer_shard_memory}
 
 
 get_cost_model_context_func_map = {
@@ -501,6 +727,7 @@ get_cost_model_context_func_map = {
     "costmodel_communi_threshold": cost_model_context().get_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().get_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().get_costmodel_communi_bias,
+    "costmodel_profile_file": cost_model_context().get_costmodel_profile_file,
     "multi_subgraphs": cost_model_context().get_multi_subgraphs,
     "run_phase": cost_model_context().get_run_phase,
     "costmodel_allreduce_fusion_algorithm": cost_model_context().get_costmodel_allreduce_fusion_algorithm,
@@ -512,17 +739,31 @@ get_cost_model_context_func_map = {
     "costmodel_allreduce_fusion_allreduce_bandwidth":
         cost_model_context().get_costmodel_allreduce_fusion_allreduce_bandwidth,
     "costmodel_allreduce_fusion_computation_time_parameter":
-        cost_model_context().get_costmodel_allreduce_fusion_computation_time_parameter}
+        cost_model_context().get_costmodel_allreduce_fusion_computation_time_parameter,
+    "costmodel_allreduce_fusion_backward_profile_file":
+        cost_model_context().get_costmodel_allreduce_fusion_backward_profile_file,
+    "costmodel_allreduce_fusion_bucket_bytes": cost_model_context().get_costmodel_allreduce_fusion_bucket_bytes,
+    "costmodel_gradient_compression": cost_model_context().get_costmodel_gradient_compression,
+    "costmodel_gradient_compression_topk_ratio": cost_model_context().get_costmodel_gradient_compression_topk_ratio,
+    "costmodel_gradient_compression_powersgd_rank":
+        cost_model_context().get_costmodel_gradient_compression_powersgd_rank,
+    "costmodel_gradient_compression_element_time":
+        cost_model_context().get_costmodel_gradient_compression_element_time,
+    "costmodel_optimizer_shard_memory": cost_model_context().get_costmodel_optimizer_shard_memory}
 
 
 @args_type_check(device_memory_capacity=float, costmodel_alpha=float, costmodel_beta=float, costmodel_gamma=float,
                  costmodel_communi_threshold=float, costmodel_communi_const=float, costmodel_communi_bias=float,
-                 multi_subgraphs=bool, run_phase=int,
+                 costmodel_profile_file=str, multi_subgraphs=bool, run_phase=int,
                  costmodel_allreduce_fusion_algorithm=int, costmodel_allreduce_fusion_times=int,
                  costmodel_allreduce_fusion_tail_percent=float, costmodel_allreduce_fusion_tail_time=float,
                  costmodel_allreduce_fusion_allreduce_inherent_time=float,
                  costmodel_allreduce_fusion_allreduce_bandwidth=float,
-                 costmodel_allreduce_fusion_computation_time_parameter=float)
+                 costmodel_allreduce_fusion_computation_time_parameter=float,
+                 costmodel_allreduce_fusion_backward_profile_file=str,
+                 costmodel_allreduce_fusion_bucket_bytes=float, costmodel_gradient_compression=str,
+                 costmodel_gradient_compression_topk_ratio=float, costmodel_gradient_compression_powersgd_rank=int,
+                 costmodel_gradient_compression_element_time=float, costmodel_optimizer_shard_memory=float)
 def set_cost_model_context(**kwargs):
     """
     Set cost model context.
@@ -538,12 +779,17 @@ def set_cost_model_context(**kwargs):
         costmodel_communi_threshold (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_const (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_bias (float): A parameter used in adjusting communication calculation for practice.
+        costmodel_profile_file (str): The profile of measured throughput curves, written by
+            `calibrate_cost_model`. When it is set, the costs are the time in us, and costmodel_alpha, costmodel_beta
+            and the communication parameters above are not used. Default: "".
         multi_subgraphs (bool): A parameter used in marking the flag of ANF graph containing multiple subgraphs.
         run_phase (int): A parameter indicating which phase is running: training (0) or inference (1). Default: 0.
         costmodel_allreduce_fusion_algorithm (int): The allreduce fusion algorithm.
             0: bypass allreduce fusion;
             1: only use backward computation time to group allreduce;
-            2: use backward computation time and parameter gradient allreduce time to group allreduce.
+            2: use backward computation time and parameter gradient allreduce time to group allreduce;
+            3: use the measured backward time of the operators to size the buckets of the gradients, so that every
+            allreduce starts as early as possible, and report the predicted overlap ratio.
         costmodel_allreduce_fusion_times (int): The AllReduce fusion times of parameter gradients.
         costmodel_allreduce_fusion_tail_percent (float): A parameter used in allreduce fusion algorithm. The percentage
             of backward computing time corresponding to the last parameter gradients AllReduce in the whole backward
@@ -556,6 +802,28 @@ def set_cost_model_context(**kwargs):
             bandwidth of AllReduce.
         costmodel_allreduce_fusion_computation_time_parameter (float): A parameter used in allreduce fusion algorithm.
             The parameter used to compute backward computation time.
+        costmodel_allreduce_fusion_backward_profile_file (str): A parameter used in allreduce fusion algorithm 3. The
+            json file mapping the names of the operators to their measured backward time, in the unit of the
+            AllReduce time of costmodel_profile_file, or of the inherent time and bandwidth above when it is not set.
+        costmodel_allreduce_fusion_bucket_bytes (float): A parameter used in allreduce fusion algorithm 3. The target
+            bytes of the gradients fused into one AllReduce. Default: 26214400.
+        costmodel_gradient_compression (str): The compression of the data parallel gradients, applied to the
+            gradients it reduces faster by the AllReduce time above, when the allreduce fusion is enabled.
+            "none": no compression;
+            "fp16": cast the float32 gradients to float16 around the AllReduce, every gradient is scaled before the
+            cast by its largest magnitude over the devices so that the sum fills the float16 range without
+            overflowing, then unscaled and averaged in float32 after it;
+            "topk": gather the largest elements of every gradient, the rest is added to the next step;
+            "powersgd": reduce a low-rank approximation of every matrix gradient, the error is added to the next
+            step. "topk" and "powersgd" run on the CPU only. Default: "none".
+        costmodel_gradient_compression_topk_ratio (float): The part of the elements kept by "topk". Default: 0.01.
+        costmodel_gradient_compression_powersgd_rank (int): The rank of the approximation of "powersgd". Default: 4.
+        costmodel_gradient_compression_element_time (float): The time to compress or decompress one element, in the
+            unit of the AllReduce time. Default: 0.0.
+        costmodel_optimizer_shard_memory (float): The bytes of the parameters and the optimizer states a device keeps
+            when enable_parallel_optimizer is set. Sharding a parameter saves its memory but the forward waits for
+            its AllGather, priced by the AllReduce time above, so the parameters saving the most memory per AllGather
+            time are sharded until the memory fits. 0.0 shards all the parameters that can be sharded. Default: 0.0.
 
 
 
@@ -591,3 +859,13 @@ def get_cost_model_context(attr_key):
 def reset_cost_model_context():
     """Reset cost model context attributes."""
     cost_model_context().reset_cost_model()
+
+
+def calibrate_cost_model(profile_file):
+    """
+    Measure the operators and the collectives on the host, and use the measured throughput curves as the cost model.
+
+    Args:
+        profile_file (str): The json file the profile is saved to, which can be set as costmodel_profile_file later.
+    """
+    cost_model_context().calibrate_costmodel_profile(profile_file)
@@ -21,6 +21,7 @@ import mindspore.nn as nn
 import mindspore.context as context
 from mindspore import log as logger
 from mindspore.train.checkpoint_pb2 import Checkpoint
+from mindspore._c_expression import CheckpointWriter_, CheckpointReader_, is_native_checkpoint
 from mindspore.common.tensor import Tensor
 from mindspore.common.initializer import initializer
 from mindspore.common.parameter import Parameter
@@ -36,6 +37,9 @@ tensor_to_ms_type = {"Int8": mstype.int8, "Int16": mstype.int16, "Int32": mstype
 tensor_to_np_type = {"Int8": np.int8, "Int16": np.int16, "Int32": np.int32, "Int64": np.int64,
                      "Float16": np.float16, "Float32": np.float32, "Float64": np.float64}
 
+# writer of the checkpoint being saved in background, only one background save is kept
+_async_ckpt_writer = None
+
 def _special_process_par(par, new_par):
     """
     Processes the special condition.
@@ -96,7 +100,45 @@ def _update_param(param, new_param):
         param.set_parameter_data(type(param.data)(new_param.data))
 
 
-def save_checkpoint(parameter_list, ckpoint_file_name):
+def _wait_async_save():
+    """Waits for the checkpoint being saved in background."""
+    global _async_ckpt_writer
+    if _async_ckpt_writer is None:
+        return
+    writer = _async_ckpt_writer
+    _async_ckpt_writer = None
+    if not writer.wait():
+        raise RuntimeError("Failed to save the checkpoint file {} in background.".format(writer.file_name()))
+
+
+def _save_native_checkpoint(parameter_list, ckpoint_file_name, async_save):
+    """Saves checkpoint in the native format, the tensors are written by the c++ checkpoint writer."""
+    global _async_ckpt_writer
+    names = []
+    tensors = []
+    for param in parameter_list:
+        param_data = param["data"]
+        if isinstance(param_data, Parameter):
+            param_data.init_data()
+            param_data = param_data.data
+        if not isinstance(param_data, Tensor):
+            param_data = Tensor(param_data)
+        names.append(param["name"])
+        tensors.append(param_data)
+
+    # two saves must not write the same file at the same time
+    _wait_async_save()
+    writer = CheckpointWriter_(ckpoint_file_name)
+    if async_save:
+        if not writer.save_async(names, tensors):
+            raise RuntimeError("Failed to snapshot the parameters for checkpoint file {}.".format(ckpoint_file_name))
+        _async_ckpt_writer = writer
+        return
+    if not writer.save(names, tensors):
+        raise RuntimeError("Failed to save the checkpoint file {}.".format(ckpoint_file_name))
+
+
+def save_checkpoint(parameter_list, ckpoint_file_name, native_format=False, async_save=False):
     """
     Saves checkpoint info to a specified file.
 
@@ -104,11 +146,20 @@ def save_checkpoint(parameter_list, ckpoint_file_name):
         parameter_list (list): Parameters list, each element is a dict
                                like {"name":xx, "type":xx, "shape":xx, "data":xx}.
         ckpoint_file_name (str): Checkpoint file name.
+        native_format (bool): Whether to save in the native format. The tensors are written in parallel
+                              with aligned data and an index, and can be memory mapped when loaded. Default: False.
+        async_save (bool): Whether to save in background, implies `native_format`. The parameters are copied
+                           before the function returns and the file is written while training goes on.
+                           Default: False.
 
     Raises:
         RuntimeError: Failed to save the Checkpoint file.
     """
     logger.info("Execute save checkpoint process.")
+    if native_format or async_save:
+        _save_native_checkpoint(parameter_list, ckpoint_file_name, async_save)
+        logger.info("Save checkpoint process finish.")
+        return
     checkpoint_list = Checkpoint()
 
     try:
@@ -162,6 +213,12 @@ def load_checkpoint(ckpoint_file_name, net=None):
         raise ValueError("The checkpoint file may be empty, please make sure enter the correct file name.")
 
     logger.info("Execute load checkpoint process.")
+    if is_native_checkpoint(ckpoint_file_name):
+        parameter_dict = _load_native_checkpoint(ckpoint_file_name)
+        if net:
+            load_param_into_net(net, parameter_dict)
+        return parameter_dict
+
     checkpoint_list = Checkpoint()
 
     try:
@@ -210,6 +267,30 @@ def load_checkpoint(ckpoint_file_name, net=None):
     return parameter_dict
 
 
+def _load_native_checkpoint(ckpoint_file_name):
+    """Loads checkpoint in the native format, the tensors share the pages of the file mapping."""
+    reader = CheckpointReader_(ckpoint_file_name)
+    if not reader.open():
+        raise ValueError("Failed to read the checkpoint file {}, please check the correct of the file."
+                         .format(ckpoint_file_name))
+
+    parameter_dict = {}
+    try:
+        for name in reader.get_names():
+            param_data = Tensor(reader.get_tensor(name))
+            if param_data.shape() == ():
+                # keep the same as the protobuf format, which saves scalars as python numbers
+                param_data = param_data.asnumpy().item()
+            parameter_dict[name] = Parameter(param_data, name=name)
+        logger.info("Load checkpoint process finish.")
+
+    except BaseException as e:
+        logger.error("Failed to load the checkpoint file %s.", ckpoint_file_name)
+        raise RuntimeError(e.__str__())
+
+    return parameter_dict
+
+
 def load_param_into_net(net, parameter_dict):
     """
     Loads parameters into network.
@@ -297,7 +378,7 @@ def _save_graph(network, file_name):
         os.chmod(file_name, stat.S_IWUSR | stat.S_IRUSR)
 
 
-def _exec_save_checkpoint(train_network, ckpoint_file_name, integrated_save=True):
+def _exec_save_checkpoint(train_network, ckpoint_file_name, integrated_save=True, async_save=False):
     """
     Saves checkpoint for 'ms' backend.
 
@@ -305,6 +386,7 @@ def _exec_save_checkpoint(train_network, ckpoint_file_name, integrated_save=True
         train_network (Network): The train network for training.
         ckpoint_file_name (str): The name of checkpoint file.
         integrated_save (bool): Whether to intergrated save in automatic model parallel scene.
+        async_save (bool): Whether to save checkpoint in background.
     """
 
     param_dict = {}
@@ -328,7 +410,7 @@ def _exec_save_checkpoint(train_network, ckpoint_file_name, integrated_save=True
         each_param["data"] = param_data
         param_list.append(each_param)
 
-    save_checkpoint(param_list, ckpoint_file_name)
+    save_checkpoint(param_list, ckpoint_file_name, async_save=async_save)
 
 
 def _get_merged_param_data(net, param_name, param_data):
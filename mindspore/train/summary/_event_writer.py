@@ -14,13 +14,21 @@
 # ============================================================================
 """Writes events to disk in a logdir."""
 import os
+import queue
 import stat
+import time
 from collections import deque
-from multiprocessing import Pool, Process, Queue, cpu_count
+from multiprocessing import Pool, Process, Queue, Value, cpu_count
 
-from ..._c_expression import EventWriter_
+from ..._c_expression import AsyncEventWriter_
+from ...log import logger
 from ._summary_adapter import package_summary_event
 
+# bytes of serialized events allowed to wait for the disk, step summaries beyond it are dropped
+_DEFAULT_MAX_QUEUE_BYTES = 256 << 20
+_POLICIES = {'drop': 0, 'sample': 1}
+_GET_TIMEOUT = 0.01
+
 
 def _pack(result, step):
     summary_event = package_summary_event(result, step)
@@ -31,43 +39,82 @@ class EventWriter(Process):
     """
     Creates a `EventWriter` and write event to file.
 
+    The events are serialized by a process pool and written by a background thread, so neither the
+    serialization nor the disk shows up in the training step. Step summaries are dropped or sampled when
+    the pending events reach `max_queue_bytes`, the other events are never dropped.
+
     Args:
         filepath (str): Summary event file path and file name.
         flush_interval (int): The flush seconds to flush the pending events to disk. Default: 120.
+        max_queue_bytes (int): The bytes of serialized events allowed to wait for the disk. Default: 256MB.
+        policy (str): 'drop' or 'sample', what to do with the step summaries under backpressure. Default: 'drop'.
     """
 
-    def __init__(self, filepath: str, flush_interval: int) -> None:
+    def __init__(self, filepath: str, flush_interval: int, max_queue_bytes=_DEFAULT_MAX_QUEUE_BYTES,
+                 policy='drop') -> None:
         super().__init__()
-        _ = flush_interval
+        if policy not in _POLICIES:
+            raise ValueError(f"The policy should be one of {list(_POLICIES)}, but got {policy}.")
         with open(filepath, 'w'):
             os.chmod(filepath, stat.S_IWUSR | stat.S_IRUSR)
-        self._writer = EventWriter_(filepath)
+        self._filepath = filepath
+        self._flush_interval = flush_interval
+        self._max_queue_bytes = max_queue_bytes
+        self._policy = _POLICIES[policy]
         self._queue = Queue(cpu_count() * 2)
+        # steps dropped because the process queue is full, counted by the training process
+        self._dropped_steps = 0
+        # the metrics of the writer thread, published by the writer process
+        self._dropped_events = Value('L', 0)
+        self._queued_bytes = Value('Q', 0)
+        self._peak_queued_bytes = Value('Q', 0)
         self.start()
 
-    def run(self):
+    def _publish_metrics(self, writer):
+        """Publish the metrics of the writer thread to the training process."""
+        self._dropped_events.value = writer.DroppedEvents() + writer.SampledEvents()
+        self._queued_bytes.value = writer.QueuedBytes()
+        self._peak_queued_bytes.value = writer.PeakQueuedBytes()
 
+    def run(self):
+        # the writer thread is started in the writer process
+        writer = AsyncEventWriter_(self._filepath, self._max_queue_bytes, self._policy)
+        if not writer.Open():
+            logger.error("Open the summary file %r failed, the summary events are discarded.", self._filepath)
+            # keep taking the events, the training process must not block on a full queue
+            while self._queue.get()[0] != 'END':
+                pass
+            return
+        last_flush = time.time()
         with Pool() as pool:
             deq = deque()
             while True:
                 while deq and deq[0].ready():
-                    self._writer.Write(deq.popleft().get())
-
-                if not self._queue.empty():
-                    action, data = self._queue.get()
-                    if action == 'WRITE':
-                        if not isinstance(data, (str, bytes)):
-                            deq.append(pool.apply_async(_pack, data))
-                        else:
-                            self._writer.Write(data)
-                    elif action == 'FLUSH':
-                        self._writer.Flush()
-                    elif action == 'END':
-                        break
+                    writer.Write(deq.popleft().get(), True)
+
+                try:
+                    action, data = self._queue.get(timeout=_GET_TIMEOUT if deq else None)
+                except queue.Empty:
+                    continue
+                if action == 'WRITE':
+                    if not isinstance(data, (str, bytes)):
+                        deq.append(pool.apply_async(_pack, data))
+                    else:
+                        writer.Write(data, False)
+                elif action == 'FLUSH':
+                    writer.Flush()
+                    last_flush = time.time()
+                elif action == 'END':
+                    break
+                if time.time() - last_flush > self._flush_interval:
+                    writer.Flush()
+                    last_flush = time.time()
+                self._publish_metrics(writer)
             for res in deq:
-                self._writer.Write(res.get())
+                writer.Write(res.get(), True)
 
-            self._writer.Shut()
+            writer.Shut()
+            self._publish_metrics(writer)
 
     def write(self, data) -> None:
         """
@@ -76,12 +123,36 @@ class EventWriter(Process):
         Args:
             data (Optional[str, Tuple[list, int]]): The data to write.
         """
-        self._queue.put(('WRITE', data))
+        if isinstance(data, (str, bytes)):
+            self._queue.put(('WRITE', data))
+            return
+        # never block the training step on the summary of a step
+        try:
+            self._queue.put_nowait(('WRITE', data))
+        except queue.Full:
+            if not self._dropped_steps:
+                logger.warning("The summary writer is busy, the summary of step %r is dropped.", data[1])
+            self._dropped_steps += 1
 
     def flush(self):
         """Flush the writer."""
         self._queue.put(('FLUSH', None))
 
+    @property
+    def dropped_count(self):
+        """The count of step summaries dropped under backpressure, complete after `close`."""
+        return self._dropped_steps + self._dropped_events.value
+
+    @property
+    def queued_bytes(self):
+        """The bytes of serialized events waiting for the disk."""
+        return self._queued_bytes.value
+
+    @property
+    def peak_queued_bytes(self):
+        """The peak bytes of serialized events waiting for the disk."""
+        return self._peak_queued_bytes.value
+
     def close(self) -> None:
         """Close the writer."""
         self._queue.put(('END', None))
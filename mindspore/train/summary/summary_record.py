@@ -22,7 +22,7 @@ from mindspore import log as logger
 from ..._c_expression import Tensor
 from ..._checkparam import _check_str_by_regular
 from .._utils import _make_directory
-from ._event_writer import EventWriter
+from ._event_writer import _DEFAULT_MAX_QUEUE_BYTES, _POLICIES, EventWriter
 from ._summary_adapter import get_event_file_name, package_graph_event, package_init_event
 
 # for the moment, this lock is for caution's sake,
@@ -71,9 +71,15 @@ class SummaryRecord:
         file_prefix (str): The prefix of file. Default: "events".
         file_suffix (str): The suffix of file. Default: "_MS".
         network (Cell): Obtain a pipeline through network for saving graph summary. Default: None.
+        max_queue_bytes (int): The bytes of serialized events allowed to wait for the disk, the step summaries
+            beyond it are dropped or sampled. Default: 256MB.
+        policy (str): 'drop' or 'sample', what to do with the step summaries when `max_queue_bytes` is reached.
+            Default: 'drop'.
 
     Raises:
-        TypeError: If `queue_max_size` and `flush_time` is not int, or `file_prefix` and `file_suffix` is not str.
+        TypeError: If `queue_max_size`, `flush_time` and `max_queue_bytes` is not int, or `file_prefix`, `file_suffix`
+            and `policy` is not str.
+        ValueError: If `max_queue_bytes` is not positive, or `policy` is not 'drop' or 'sample'.
         RuntimeError: If the log_dir can not be resolved to a canonicalized absolute pathname.
 
     Examples:
@@ -87,7 +93,9 @@ class SummaryRecord:
                  flush_time=120,
                  file_prefix="events",
                  file_suffix="_MS",
-                 network=None):
+                 network=None,
+                 max_queue_bytes=_DEFAULT_MAX_QUEUE_BYTES,
+                 policy='drop'):
 
         _check_str_by_regular(file_prefix)
         _check_str_by_regular(file_suffix)
@@ -97,6 +105,14 @@ class SummaryRecord:
             raise TypeError("`queue_max_size` and `flush_time` should be int")
         if not isinstance(file_prefix, str) or not isinstance(file_suffix, str):
             raise TypeError("`file_prefix` and `file_suffix`  should be str.")
+        if not isinstance(max_queue_bytes, int) or isinstance(max_queue_bytes, bool):
+            raise TypeError("`max_queue_bytes` should be int.")
+        if max_queue_bytes <= 0:
+            raise ValueError(f"`max_queue_bytes` should be positive, but got {max_queue_bytes}.")
+        if not isinstance(policy, str):
+            raise TypeError("`policy` should be str.")
+        if policy not in _POLICIES:
+            raise ValueError(f"`policy` should be one of {list(_POLICIES)}, but got {policy}.")
 
         self.queue_max_size = queue_max_size
         if queue_max_size < 0:
@@ -112,6 +128,8 @@ class SummaryRecord:
         self.prefix = file_prefix
         self.suffix = file_suffix
         self.network = network
+        self.max_queue_bytes = max_queue_bytes
+        self.policy = policy
         self.has_graph = False
         self._closed = False
 
@@ -126,7 +144,7 @@ class SummaryRecord:
 
     def _init_event_writer(self):
         """Init event writer and write metadata."""
-        event_writer = EventWriter(self.full_file_name, self.flush_time)
+        event_writer = EventWriter(self.full_file_name, self.flush_time, self.max_queue_bytes, self.policy)
         event_writer.write(package_init_event().SerializeToString())
         return event_writer
 
@@ -211,6 +229,41 @@ class SummaryRecord:
         """
         return self.full_file_name
 
+    @property
+    def queued_bytes(self):
+        """
+        Get the bytes of serialized events waiting to be written to disk.
+
+        Returns:
+            int, the queued bytes, 0 before the first event is recorded.
+        """
+        return self._event_writer.queued_bytes if self._event_writer else 0
+
+    @property
+    def peak_queued_bytes(self):
+        """
+        Get the peak bytes of serialized events waiting to be written to disk.
+
+        Returns:
+            int, the peak queued bytes, 0 before the first event is recorded.
+        """
+        return self._event_writer.peak_queued_bytes if self._event_writer else 0
+
+    @property
+    def dropped_events(self):
+        """
+        Get the count of step summaries dropped or skipped by sampling under backpressure.
+
+        Examples:
+            >>> with SummaryRecord(log_dir="/opt/log", max_queue_bytes=64 << 20) as summary_record:
+            >>>     summary_record.record(step=2)
+            >>> print(summary_record.dropped_events)
+
+        Returns:
+            int, the dropped count, complete once the SummaryRecord is closed.
+        """
+        return self._event_writer.dropped_count if self._event_writer else 0
+
     def flush(self):
         """
         Flush the event file to disk.
@@ -15,11 +15,17 @@
  */
 
 #include "benchmark/benchmark.h"
+#include <sys/resource.h>
 #include <random>
 #include <limits>
 #include <algorithm>
 #include <utility>
 #include <memory>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
 #include "include/session.h"
 
 namespace mindspore {
@@ -53,31 +59,21 @@ STATUS Benchmark::GenerateInputData() {
 }
 
 STATUS Benchmark::LoadInput() {
-  size_t size = 0;
-  char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
-  if (graphBuf == nullptr) {
-    MS_LOGE("Load graph failed, path %s", _flags->modelPath.c_str());
-    return RET_ERROR;
-  }
-
   this->msInputs = session->GetInput();
 
   if (_flags->inDataPath.empty()) {
     auto status = GenerateInputData();
     if (status != RET_OK) {
-      delete graphBuf;
       MS_LOGE("Generate input data error %d", status);
       return status;
     }
   } else {
     auto status = ReadInputFile();
     if (status != RET_OK) {
-      delete graphBuf;
       MS_LOGE("ReadInputFile error, %d", status);
       return status;
     }
   }
-  delete graphBuf;
   return RET_OK;
 }
 
@@ -252,7 +248,37 @@ STATUS Benchmark::CompareOutput(const std::map<NODE_ID, std::vector<Tensor *>> &
   }
 }
 
+// the user and system cpu time of the process in us
+static uint64_t GetCpuTimeUs() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  const uint64_t secToUs = 1000000;
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * secToUs + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+void Benchmark::MarkIdleCpu() {
+  if (_flags->idleTimeMs <= 0) {
+    return;
+  }
+  uint64_t start = GetCpuTimeUs();
+  std::this_thread::sleep_for(std::chrono::milliseconds(_flags->idleTimeMs));
+  MS_LOGI("IdleCpuTime = %f ms in %d ms", (GetCpuTimeUs() - start) / US2MS, _flags->idleTimeMs);
+}
+
+// the run time under which the given percent of the runs are, the times are sorted
+static uint64_t GetPercentile(std::vector<uint64_t> *times, size_t percent) {
+  MS_ASSERT(times != nullptr && !times->empty());
+  std::sort(times->begin(), times->end());
+  size_t index = (times->size() * percent + 99) / 100;
+  return (*times)[index == 0 ? 0 : index - 1];
+}
+
 STATUS Benchmark::MarkPerformance() {
+  if (_flags->concurrency > 1) {
+    return MarkConcurrentPerformance();
+  }
   MS_LOGI("Running warm up loops...");
   for (int i = 0; i < _flags->warmUpLoopCount; i++) {
     auto status = session->Run(msInputs);
@@ -263,9 +289,12 @@ STATUS Benchmark::MarkPerformance() {
   }
 
   MS_LOGI("Running benchmark loops...");
+  uint64_t cpuStart = GetCpuTimeUs();
+  uint64_t wallStart = GetTimeUs();
   uint64_t timeMin = maxTimeThr;
   uint64_t timeMax = 0;
   uint64_t timeAvg = 0;
+  std::vector<uint64_t> times;
   for (int i = 0; i < _flags->loopCount; i++) {
     uint64_t start = GetTimeUs();
     auto status = session->Run(msInputs);
@@ -279,6 +308,7 @@ STATUS Benchmark::MarkPerformance() {
     timeMin = std::min(timeMin, time);
     timeMax = std::max(timeMax, time);
     timeAvg += time;
+    times.push_back(time);
 
     msOutputs = session->GetAllOutput();
     if (cleanData) {
@@ -294,7 +324,77 @@ STATUS Benchmark::MarkPerformance() {
     timeAvg /= _flags->loopCount;
     MS_LOGI("MinRunTime = %f ms, MaxRuntime = %f ms, AvgRunTime = %f ms", timeMin / US2MS, timeMax / US2MS,
             timeAvg / US2MS);
+    MS_LOGI("P50RunTime = %f ms, P99RunTime = %f ms", GetPercentile(&times, 50) / US2MS,
+            GetPercentile(&times, 99) / US2MS);
+    MS_LOGI("CpuTime = %f ms, WallTime = %f ms", (GetCpuTimeUs() - cpuStart) / US2MS,
+            (GetTimeUs() - wallStart) / US2MS);
   }
+  MarkIdleCpu();
+  return RET_OK;
+}
+
+STATUS Benchmark::MarkConcurrentPerformance() {
+  MS_LOGI("Running warm up loops...");
+  for (int i = 0; i < _flags->warmUpLoopCount; i++) {
+    std::map<std::string, std::vector<Tensor *>> outputs;
+    auto status = session->Run(msInputs, &outputs);
+    for (auto &output : outputs) {
+      for (auto &outputTensor : output.second) {
+        delete outputTensor;
+      }
+    }
+    if (status != RET_OK) {
+      MS_LOGE("Inference error %d", status);
+      return status;
+    }
+  }
+
+  MS_LOGI("Running benchmark loops with %d threads...", _flags->concurrency);
+  std::vector<std::vector<uint64_t>> threadTimes(_flags->concurrency);
+  std::atomic<int> runStatus{RET_OK};
+  std::vector<std::thread> threads;
+  uint64_t cpuStart = GetCpuTimeUs();
+  uint64_t start = GetTimeUs();
+  for (int t = 0; t < _flags->concurrency; t++) {
+    threads.emplace_back([this, t, &threadTimes, &runStatus]() {
+      for (int i = 0; i < _flags->loopCount && runStatus.load() == RET_OK; i++) {
+        std::map<std::string, std::vector<Tensor *>> outputs;
+        uint64_t runStart = GetTimeUs();
+        auto status = session->Run(msInputs, &outputs);
+        threadTimes[t].push_back(GetTimeUs() - runStart);
+        for (auto &output : outputs) {
+          for (auto &outputTensor : output.second) {
+            delete outputTensor;
+          }
+        }
+        if (status != RET_OK) {
+          runStatus.store(status);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  uint64_t totalTime = GetTimeUs() - start;
+  if (runStatus.load() != RET_OK) {
+    MS_LOGE("Inference error %d", runStatus.load());
+    return runStatus.load();
+  }
+
+  std::vector<uint64_t> times;
+  for (auto &threadTime : threadTimes) {
+    times.insert(times.end(), threadTime.begin(), threadTime.end());
+  }
+  if (times.empty() || totalTime == 0) {
+    return RET_OK;
+  }
+  MS_LOGI("Concurrency = %d, Requests = %zu, Throughput = %f requests/s", _flags->concurrency, times.size(),
+          times.size() * US2MS * US2MS / totalTime);
+  MS_LOGI("P50RunTime = %f ms, P99RunTime = %f ms, MaxRunTime = %f ms", GetPercentile(&times, 50) / US2MS,
+          GetPercentile(&times, 99) / US2MS, times.back() / US2MS);
+  MS_LOGI("CpuTime = %f ms, WallTime = %f ms", (GetCpuTimeUs() - cpuStart) / US2MS, totalTime / US2MS);
+  MarkIdleCpu();
   return RET_OK;
 }
 
@@ -337,27 +437,44 @@ STATUS Benchmark::CleanData() {
   return RET_OK;
 }
 
+// the peak resident set size of the process in KB, 0 if unknown
+static size_t GetPeakRss() {
+  const std::string key = "VmHWM:";
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, key.size(), key) == 0) {
+      return std::stoul(line.substr(key.size()));
+    }
+  }
+  return 0;
+}
+
 STATUS Benchmark::RunBenchmark() {
   // Load graph
   std::string comment = modelName;
 
   MS_LOGI("start reading model file");
   size_t size = 0;
-  char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
-  if (graphBuf == nullptr) {
-    MS_LOGE("Load graph failed while running %s", comment.c_str());
-    return RET_ERROR;
-  }
-
+  char *graphBuf = nullptr;
   uint64_t startPrepareTime = GetTimeUs();
-  session = CreateSession(graphBuf, size, ctx);
+  if (_flags->mmapModel) {
+    session = CreateSessionFromFile(_flags->modelPath.c_str(), ctx);
+  } else {
+    graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
+    if (graphBuf == nullptr) {
+      MS_LOGE("Load graph failed while running %s", comment.c_str());
+      return RET_ERROR;
+    }
+    session = CreateSession(graphBuf, size, ctx);
+  }
   if (session == nullptr) {
     delete graphBuf;
     MS_LOGE("new session failed while running %s", comment.c_str());
     return RET_ERROR;
   }
   uint64_t endPrepareTime = GetTimeUs();
-  MS_LOGI("PrepareTime = %f ms, ", (endPrepareTime - startPrepareTime) / US2MS);
+  MS_LOGI("PrepareTime = %f ms, PeakRSS = %zu KB", (endPrepareTime - startPrepareTime) / US2MS, GetPeakRss());
 
   // Load input
   MS_LOGI("start generate input data");
@@ -395,12 +512,24 @@ STATUS Benchmark::Init() {
   }
   MS_LOGI("ModelPath = %s", this->_flags->modelPath.c_str());
   MS_LOGI("InDataPath = %s", this->_flags->inDataPath.c_str());
+  MS_LOGI("MmapModel = %d", this->_flags->mmapModel);
   MS_LOGI("TensorDataType = %s", this->_flags->tensorDataTypeIn.c_str());
   MS_LOGI("LoopCount = %d", this->_flags->loopCount);
   MS_LOGI("WarmUpLoopCount = %d", this->_flags->warmUpLoopCount);
   MS_LOGI("NumThreads = %d", this->_flags->numThreads);
+  MS_LOGI("Concurrency = %d", this->_flags->concurrency);
+  MS_LOGI("ExecContextNum = %d", this->_flags->execContextNum);
+  MS_LOGI("ParallelNodes = %d", this->_flags->parallelNodes);
+  MS_LOGI("MaxBatchSize = %d", this->_flags->maxBatchSize);
+  MS_LOGI("BatchTimeoutUs = %d", this->_flags->batchTimeoutUs);
+  MS_LOGI("IdleTimeMs = %d", this->_flags->idleTimeMs);
   MS_LOGI("calibDataPath = %s", this->_flags->calibDataPath.c_str());
 
+  ctx.execContextNum = this->_flags->execContextNum;
+  ctx.parallelNodes = this->_flags->parallelNodes;
+  ctx.maxBatchSize = this->_flags->maxBatchSize;
+  ctx.batchTimeoutUs = this->_flags->batchTimeoutUs;
+
   this->_flags->inDataType = this->_flags->inDataTypeIn == "img" ? kImage : kBinary;
   if (this->_flags->tensorDataTypeIn == "float") {
     this->_flags->tensorDataType = DataType_DT_FLOAT;
@@ -60,10 +60,17 @@ class BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::modelPath, "modelPath", "Input model path", "");
     AddFlag(&BenchmarkFlags::tensorDataTypeIn, "tensorDataType", "Data type of input Tensor. float", "float");
     AddFlag(&BenchmarkFlags::inDataPath, "inDataPath", "Input data path, if not set, use random input", "");
+    AddFlag(&BenchmarkFlags::mmapModel, "mmapModel", "Map the model file and use the weights in place", false);
     // MarkPerformance
     AddFlag(&BenchmarkFlags::loopCount, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::numThreads, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::warmUpLoopCount, "warmUpLoopCount", "Run warm up loop", 3);
+    AddFlag(&BenchmarkFlags::concurrency, "concurrency", "Threads sending requests at the same time", 1);
+    AddFlag(&BenchmarkFlags::execContextNum, "execContextNum", "Executor contexts sharing the weights", 1);
+    AddFlag(&BenchmarkFlags::parallelNodes, "parallelNodes", "Run the independent nodes at the same time", false);
+    AddFlag(&BenchmarkFlags::maxBatchSize, "maxBatchSize", "Max requests batched into one run", 1);
+    AddFlag(&BenchmarkFlags::batchTimeoutUs, "batchTimeoutUs", "Time a request waits for its batch in us", 0);
+    AddFlag(&BenchmarkFlags::idleTimeMs, "idleTimeMs", "Idle time after the loops to measure the idle cpu in ms", 0);
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::calibDataPath, "calibDataPath", "Calibration data file path", "");
   }
@@ -78,10 +85,17 @@ class BenchmarkFlags : public virtual FlagParser {
   std::string inDataTypeIn;
   DataType tensorDataType;
   std::string tensorDataTypeIn;
+  bool mmapModel;
   // MarkPerformance
   int loopCount;
   int numThreads;
   int warmUpLoopCount;
+  int concurrency;
+  int execContextNum;
+  bool parallelNodes;
+  int maxBatchSize;
+  int batchTimeoutUs;
+  int idleTimeMs;
   // MarkAccuracy
   std::string calibDataPath;
 };
@@ -116,6 +130,12 @@ class Benchmark {
 
   STATUS MarkPerformance();
 
+  // every thread runs loopCount requests through the reentrant Session::Run
+  STATUS MarkConcurrentPerformance();
+
+  // the cpu time the process spends while the session is idle, the threads of the pool should not spin
+  void MarkIdleCpu();
+
   STATUS MarkAccuracy();
 
  private:
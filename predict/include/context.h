@@ -49,6 +49,17 @@ class MSPREDICT_API Context {
   DLContext deviceCtx;
   int threadNum = 1;
   std::shared_ptr<Allocator> allocator;
+  ///\brief The number of executor contexts sharing the weights, each of them serves one Session::Run at a time.
+  int execContextNum = 1;
+  ///\brief Run the independent nodes of the graph at the same time on the thread pool.
+  bool parallelNodes = false;
+  ///\brief The most requests of the reentrant Session::Run batched into one run, 1 turns the batching off.
+  ///
+  ///\note
+  /// The batching is only valid for models whose nodes are all independent along the first dimension.
+  int maxBatchSize = 1;
+  ///\brief The time a request waits for others to join its batch, in microseconds.
+  int batchTimeoutUs = 0;
 };
 }  // namespace predict
 }  // namespace mindspore
@@ -43,6 +43,12 @@ class Graph;
 /// The caller does not need to care about detailed implementation of this class, so just list the class name here.
 class GraphExecution;
 
+///\brief ExecutorPool defined by MindSpore predict.
+///
+///\note
+/// The caller does not need to care about detailed implementation of this class, so just list the class name here.
+class ExecutorPool;
+
 ///\brief MindSpore predict session.
 ///
 /// This class represents session of MindSpore predict.
@@ -71,6 +77,16 @@ class MSPREDICT_API Session {
   ///\return Return RET_OK if the initialization is success, otherwhise return RET_ERROR.
   int Init(const char *graphBuf, size_t size);
 
+  ///\brief Init the session from a model file.
+  ///
+  ///\param[in] modelPath The path of the model file, used for build session.
+  ///
+  ///\return Return RET_OK if the initialization is success, otherwhise return RET_ERROR.
+  ///
+  ///\note
+  /// The model file is mapped into memory and the aligned weights are used in place instead of being copied.
+  int InitFromFile(const char *modelPath);
+
   ///\brief Get the input of session.
   ///
   ///\return Input node's input tensors if found, empty vector otherwise.
@@ -87,8 +103,21 @@ class MSPREDICT_API Session {
   ///\note
   /// Currently input tensors' data format only support FORMAT_NCHW.
   /// Currently input tensors' data type only support FLOAT.
+  /// Return RET_REENTRANT_ERROR if a reentrant Run is running on the executor context 0.
   int Run(const std::vector<Tensor *> &inputs);
 
+  ///\brief Run the session and get the outputs, may be called from several threads at the same time.
+  ///
+  ///\param[in] inputs The input of the session.
+  ///\param[out] outputs Every output node's output tensors.
+  ///
+  ///\return Return RET_OK if run success, otherwhise return an error code.
+  ///\note
+  /// The requests run on the Context::execContextNum executor contexts, or in batches if Context::maxBatchSize is
+  /// larger than 1. The caller needs to free memory of outputs.
+  /// Run(inputs) and GetOutput on the same session must not be called while this runs.
+  int Run(const std::vector<Tensor *> &inputs, std::map<std::string, std::vector<Tensor *>> *outputs);
+
   ///\brief Get the output of session.
   ///
   ///\param[in] nodeName Given output node name.
@@ -113,9 +142,18 @@ class MSPREDICT_API Session {
   ///\return Return RET_OK if the initialization is success, otherwhise return RET_ERROR.
   int InitExecutor();
 
+  ///\brief Plan the memory of the graph and init the executors.
+  ///
+  ///\param[in] graphBuf The buffer of the graph, the other executor contexts are built from it.
+  ///\param[in] size The size of the buffer.
+  ///
+  ///\return Return RET_OK if the initialization is success, otherwhise return RET_ERROR.
+  int InitGraph(const char *graphBuf, size_t size);
+
   const Context &_ctx;
   Graph *_graph = nullptr;
   GraphExecution *_executor = nullptr;
+  ExecutorPool *_executorPool = nullptr;
   bool reinitExecutor = true;
 };
 
@@ -133,6 +171,20 @@ class MSPREDICT_API Session {
 ///\note
 /// The caller needs to allocate and free memory of graph buffer.
 std::shared_ptr<Session> MSPREDICT_API CreateSession(const char *graphBuf, size_t size, const Context &ctx);
+
+///\brief MindSpore predict neural network session create function from a model file
+///
+/// This function maps the model file into memory and uses the aligned weights in it in place, which saves a copy of
+/// the weights at load time.
+///
+///\param[in] modelPath The path of the model file, used for build session.
+///\param[in] ctx The context of the session.
+///
+///\return Instance of MindSpore predict session.
+///
+///\note
+/// The model file must not be modified while the session lives.
+std::shared_ptr<Session> MSPREDICT_API CreateSessionFromFile(const char *modelPath, const Context &ctx);
 }  // namespace predict
 }  // namespace mindspore
 
@@ -68,9 +68,11 @@ class MSPREDICT_API Tensor {
   ///\brief Get MindSpore predict tensor.
   ///
   ///\param[in] Definition of the tensor.
+  ///\param[in] copyData Whether to copy the const data out of the model buffer. If not and the data is aligned, the
+  /// tensor points at the data in the buffer, which must outlive the tensor.
   ///
   ///\return Address of MindSpore predict tensor.
-  static Tensor *CopyFromTensorDef(const TensorDef &tensordef);
+  static Tensor *CopyFromTensorDef(const TensorDef &tensordef, bool copyData = true);
 
   ///\brief Get dtype of MindSpore predict tensor.
   ///
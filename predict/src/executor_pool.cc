@@ -0,0 +1,335 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/executor_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include "common/mslog.h"
+#include "include/errorcode.h"
+#include "securec/include/securec.h"
+#include "src/graph_execution.h"
+#include "src/runtime/allocator.h"
+
+namespace mindspore {
+namespace predict {
+ExecutorPool::ExecutorPool(const Context &ctx) : _ctx(ctx) {}
+
+ExecutorPool::~ExecutorPool() {
+  for (auto tensor : batchInputs) {
+    delete tensor;
+  }
+  batchInputs.clear();
+  batchGraph.reset();
+  // the contexts use the weights of the graph of the session, which is deleted by the session
+  for (size_t i = 1; i < graphs.size(); i++) {
+    delete graphs[i];
+  }
+  graphs.clear();
+}
+
+int ExecutorPool::Init(Graph *graph, const char *buf, size_t size) {
+  if (graph == nullptr) {
+    MS_LOGE("the graph is nullptr");
+    return RET_NULL_PTR;
+  }
+  graphs.push_back(graph);
+  int contextNum = std::max(_ctx.execContextNum, 1);
+  maxBatchSize = std::max(_ctx.maxBatchSize, 1);
+  if ((contextNum > 1 || maxBatchSize > 1) && buf == nullptr) {
+    MS_LOGE("the model buffer is nullptr, the executor contexts can not be built");
+    return RET_NULL_PTR;
+  }
+  // the nodes of several contexts or of one step malloc their outputs from the allocator at the same time
+  if ((contextNum > 1 || maxBatchSize > 1 || _ctx.parallelNodes) && _ctx.allocator != nullptr) {
+    _ctx.allocator->SetContext({0, true});
+  }
+
+  GraphBuildOption option;
+  option.weightGraph = graph;
+  for (int i = 1; i < contextNum; i++) {
+    std::unique_ptr<Graph> context(Graph::CreateFromBuf(buf, size, _ctx, option));
+    if (context == nullptr) {
+      MS_LOGE("create the executor context %d failed", i);
+      return RET_ERROR;
+    }
+    auto ret = context->InitStaticMemPlan(_ctx.parallelNodes);
+    if (ret != RET_OK) {
+      MS_LOGE("init static memory plan of the executor context %d failed", i);
+      return ret;
+    }
+    graphs.push_back(context.release());
+  }
+  busy.assign(graphs.size(), false);
+
+  if (maxBatchSize > 1) {
+    auto ret = InitBatchGraph(buf, size);
+    if (ret != RET_OK) {
+      MS_LOGE("init the graph of batch %d failed", maxBatchSize);
+      return ret;
+    }
+  }
+  MS_LOGI("%zu executor contexts, max batch size %d", graphs.size(), maxBatchSize);
+  return RET_OK;
+}
+
+int ExecutorPool::InitBatchGraph(const char *buf, size_t size) {
+  for (auto tensor : graphs.front()->GetInputs()) {
+    if (tensor == nullptr || tensor->GetDims().empty()) {
+      MS_LOGE("the inputs of the model have no batch dimension");
+      return RET_ERROR;
+    }
+  }
+  GraphBuildOption option;
+  option.weightGraph = graphs.front();
+  option.batchSize = maxBatchSize;
+  batchGraph.reset(Graph::CreateFromBuf(buf, size, _ctx, option));
+  if (batchGraph == nullptr) {
+    MS_LOGE("create the graph of batch %d failed", maxBatchSize);
+    return RET_ERROR;
+  }
+  auto ret = batchGraph->InitStaticMemPlan(_ctx.parallelNodes);
+  if (ret != RET_OK) {
+    MS_LOGE("init static memory plan of the graph of batch %d failed", maxBatchSize);
+    return ret;
+  }
+  for (auto refInput : batchGraph->GetInputs()) {
+    MS_ASSERT(refInput != nullptr);
+    std::unique_ptr<Tensor> tensor(
+      new (std::nothrow) Tensor(refInput->GetDataType(), refInput->GetDims(), Format_NCHW, nullptr));
+    if (tensor == nullptr) {
+      MS_LOGE("new Tensor failed");
+      return RET_ERROR;
+    }
+    ret = tensor->MallocData();
+    if (ret != RET_OK) {
+      MS_LOGE("malloc the batch input failed, size %zu", tensor->GetDataSize());
+      return ret;
+    }
+    // the parts no request of a batch takes stay valid data
+    (void)memset_s(tensor->GetData(), tensor->GetDataSize(), 0, tensor->GetDataSize());
+    batchInputs.push_back(tensor.release());
+  }
+  return RET_OK;
+}
+
+bool ExecutorPool::TryAcquireMainContext() {
+  std::lock_guard<std::mutex> lock(contextMutex);
+  if (busy.empty() || busy.front()) {
+    return false;
+  }
+  busy.front() = true;
+  return true;
+}
+
+size_t ExecutorPool::AcquireContext() {
+  std::unique_lock<std::mutex> lock(contextMutex);
+  size_t index = 0;
+  contextCond.wait(lock, [this, &index]() {
+    auto iter = std::find(busy.begin(), busy.end(), false);
+    index = static_cast<size_t>(iter - busy.begin());
+    return iter != busy.end();
+  });
+  busy[index] = true;
+  return index;
+}
+
+void ExecutorPool::ReleaseContext(size_t index) {
+  {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    MS_ASSERT(index < busy.size());
+    busy[index] = false;
+  }
+  contextCond.notify_one();
+}
+
+int ExecutorPool::CheckInputs(const std::vector<Tensor *> &inputs) {
+  auto refInputs = graphs.front()->GetInputs();
+  if (inputs.size() != refInputs.size()) {
+    MS_LOGE("input num %zu != model input num %zu", inputs.size(), refInputs.size());
+    return RET_INPUT_TENSOR_ERROR;
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (inputs[i] == nullptr || inputs[i]->GetData() == nullptr) {
+      MS_LOGE("input tensor %zu or its data is null", i);
+      return RET_INPUT_TENSOR_ERROR;
+    }
+    MS_ASSERT(refInputs[i] != nullptr);
+    if (!inputs[i]->CompareShape(*refInputs[i]) || inputs[i]->GetDataType() != refInputs[i]->GetDataType() ||
+        inputs[i]->GetFormat() != Format_NCHW) {
+      MS_LOGE("input tensor %zu is different from the model input", i);
+      return RET_INPUT_TENSOR_ERROR;
+    }
+  }
+  return RET_OK;
+}
+
+int ExecutorPool::RunOnGraph(Graph *graph, const std::vector<Tensor *> &inputs,
+                             std::map<NODE_ID, std::vector<Tensor *>> *outputs) {
+  MS_ASSERT(graph != nullptr && outputs != nullptr);
+  GraphExecution executor(_ctx, graph);
+  auto ret = executor.Run(inputs);
+  if (ret != RET_OK) {
+    MS_LOGE("run graph failed: %d", ret);
+    return ret;
+  }
+  *outputs = executor.GetAllOutput();
+  if (outputs->empty()) {
+    MS_LOGE("get the outputs failed");
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int ExecutorPool::RunOnContext(const std::vector<Tensor *> &inputs,
+                               std::map<NODE_ID, std::vector<Tensor *>> *outputs) {
+  auto index = AcquireContext();
+  auto ret = RunOnGraph(graphs[index], inputs, outputs);
+  ReleaseContext(index);
+  return ret;
+}
+
+int ExecutorPool::Run(const std::vector<Tensor *> &inputs, std::map<NODE_ID, std::vector<Tensor *>> *outputs) {
+  if (outputs == nullptr) {
+    MS_LOGE("outputs is nullptr");
+    return RET_NULL_PTR;
+  }
+  if (graphs.empty()) {
+    MS_LOGE("the executor pool is not initialized");
+    return RET_ERROR;
+  }
+  // the inputs are checked before taking a context or joining a batch, a bad request holds up no other one
+  auto ret = CheckInputs(inputs);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  if (batchGraph == nullptr) {
+    return RunOnContext(inputs, outputs);
+  }
+  return RunBatched(inputs, outputs);
+}
+
+int ExecutorPool::RunBatched(const std::vector<Tensor *> &inputs, std::map<NODE_ID, std::vector<Tensor *>> *outputs) {
+  BatchRequest request{&inputs, outputs, RET_OK, false};
+  std::unique_lock<std::mutex> lock(batchMutex);
+  pendingRequests.push_back(&request);
+  batchCond.notify_all();
+  while (!request.done) {
+    if (collecting) {
+      batchCond.wait(lock);
+      continue;
+    }
+    // lead: wait for a full batch or the timeout, then run the oldest requests
+    collecting = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(std::max(_ctx.batchTimeoutUs, 0));
+    (void)batchCond.wait_until(lock, deadline, [this]() {
+      return pendingRequests.size() >= static_cast<size_t>(maxBatchSize);
+    });
+    std::vector<BatchRequest *> batch;
+    while (!pendingRequests.empty() && batch.size() < static_cast<size_t>(maxBatchSize)) {
+      batch.push_back(pendingRequests.front());
+      pendingRequests.pop_front();
+    }
+    collecting = false;
+    batchCond.notify_all();
+    lock.unlock();
+    auto ret = RunBatch(batch);
+    lock.lock();
+    for (auto batchRequest : batch) {
+      if (ret != RET_OK) {
+        batchRequest->ret = ret;
+      }
+      batchRequest->done = true;
+    }
+    batchCond.notify_all();
+  }
+  return request.ret;
+}
+
+int ExecutorPool::RunBatch(const std::vector<BatchRequest *> &batch) {
+  if (batch.empty()) {
+    return RET_OK;
+  }
+  // a single request does not pay for the padding of the batch
+  if (batch.size() == 1) {
+    return RunOnContext(*batch.front()->inputs, batch.front()->outputs);
+  }
+  std::lock_guard<std::mutex> runLock(batchRunMutex);
+  for (size_t i = 0; i < batchInputs.size(); i++) {
+    size_t partSize = batchInputs[i]->GetDataSize() / maxBatchSize;
+    auto dst = static_cast<uint8_t *>(batchInputs[i]->GetData());
+    for (size_t k = 0; k < batch.size(); k++) {
+      auto src = (*batch[k]->inputs)[i];
+      if (memcpy_s(dst + k * partSize, partSize, src->GetData(), src->GetDataSize()) != EOK) {
+        MS_LOGE("copy input %zu of request %zu to the batch failed", i, k);
+        return RET_ERROR;
+      }
+    }
+  }
+  std::map<NODE_ID, std::vector<Tensor *>> batchOutputs;
+  auto ret = RunOnGraph(batchGraph.get(), batchInputs, &batchOutputs);
+  if (ret == RET_OK) {
+    ret = SplitBatchOutputs(batchOutputs, batch);
+    if (ret != RET_OK) {
+      for (auto request : batch) {
+        for (auto &output : *request->outputs) {
+          for (auto tensor : output.second) {
+            delete tensor;
+          }
+        }
+        request->outputs->clear();
+      }
+    }
+  }
+  for (auto &output : batchOutputs) {
+    for (auto tensor : output.second) {
+      delete tensor;
+    }
+  }
+  return ret;
+}
+
+int ExecutorPool::SplitBatchOutputs(const std::map<NODE_ID, std::vector<Tensor *>> &batchOutputs,
+                                    const std::vector<BatchRequest *> &batch) {
+  for (auto &output : batchOutputs) {
+    for (auto tensor : output.second) {
+      MS_ASSERT(tensor != nullptr);
+      auto dims = tensor->GetDims();
+      if (dims.empty() || dims[0] % maxBatchSize != 0) {
+        MS_LOGE("the output of node %s has no batch dimension", output.first.c_str());
+        return RET_ERROR;
+      }
+      dims[0] /= maxBatchSize;
+      size_t partSize = tensor->GetDataSize() / maxBatchSize;
+      auto src = static_cast<const uint8_t *>(tensor->GetData());
+      for (size_t k = 0; k < batch.size(); k++) {
+        std::unique_ptr<Tensor> part(new (std::nothrow) Tensor(tensor->GetDataType(), dims, Format_NCHW, nullptr));
+        if (part == nullptr || part->MallocData() != RET_OK) {
+          MS_LOGE("malloc the output of request %zu failed", k);
+          return RET_ERROR;
+        }
+        if (memcpy_s(part->GetData(), part->GetDataSize(), src + k * partSize, partSize) != EOK) {
+          MS_LOGE("copy the output of request %zu failed", k);
+          return RET_ERROR;
+        }
+        (*batch[k]->outputs)[output.first].push_back(part.release());
+      }
+    }
+  }
+  return RET_OK;
+}
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_SRC_EXECUTOR_POOL_H_
+#define PREDICT_SRC_EXECUTOR_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "include/context.h"
+#include "include/tensor.h"
+#include "src/graph.h"
+
+namespace mindspore {
+namespace predict {
+// The executor contexts of a session. Every context is a graph of its own with the intermediate tensors of its own,
+// the weights are those of the graph of the session, so several requests run at the same time on one loaded model.
+// With batching on, the requests arriving within the timeout are run together on a graph built for the largest batch.
+class ExecutorPool {
+ public:
+  explicit ExecutorPool(const Context &ctx);
+  ~ExecutorPool();
+
+  // graph is the context 0 owned by the session, the other contexts are built from buf, which is only used here
+  int Init(Graph *graph, const char *buf, size_t size);
+  // run the inputs on a free context or in a batch, the caller owns the outputs
+  int Run(const std::vector<Tensor *> &inputs, std::map<NODE_ID, std::vector<Tensor *>> *outputs);
+  // the run of the session takes the context 0 without waiting, false if a request is running on it
+  bool TryAcquireMainContext();
+  void ReleaseContext(size_t index);
+
+ private:
+  struct BatchRequest {
+    const std::vector<Tensor *> *inputs;
+    std::map<NODE_ID, std::vector<Tensor *>> *outputs;
+    int ret;
+    bool done;
+  };
+
+  size_t AcquireContext();
+  int InitBatchGraph(const char *buf, size_t size);
+  int CheckInputs(const std::vector<Tensor *> &inputs);
+  int RunOnGraph(Graph *graph, const std::vector<Tensor *> &inputs, std::map<NODE_ID, std::vector<Tensor *>> *outputs);
+  int RunOnContext(const std::vector<Tensor *> &inputs, std::map<NODE_ID, std::vector<Tensor *>> *outputs);
+  int RunBatched(const std::vector<Tensor *> &inputs, std::map<NODE_ID, std::vector<Tensor *>> *outputs);
+  int RunBatch(const std::vector<BatchRequest *> &batch);
+  int SplitBatchOutputs(const std::map<NODE_ID, std::vector<Tensor *>> &batchOutputs,
+                        const std::vector<BatchRequest *> &batch);
+
+  const Context &_ctx;
+  // graphs[0] is the graph of the session
+  std::vector<Graph *> graphs;
+  std::vector<bool> busy;
+  std::mutex contextMutex;
+  std::condition_variable contextCond;
+
+  int maxBatchSize = 1;
+  std::unique_ptr<Graph> batchGraph;
+  // the inputs of batchGraph, the request k of a batch takes the k-th part of them
+  std::vector<Tensor *> batchInputs;
+  std::deque<BatchRequest *> pendingRequests;
+  // one of the waiting requests collects a batch at a time
+  bool collecting = false;
+  std::mutex batchMutex;
+  std::condition_variable batchCond;
+  std::mutex batchRunMutex;
+};
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_SRC_EXECUTOR_POOL_H_
@@ -15,6 +15,10 @@
  */
 
 #include "src/graph.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <map>
 #include <algorithm>
 #include <memory>
@@ -29,7 +33,7 @@ namespace mindspore {
 namespace predict {
 static const uint32_t G_MAX_OP_COUNT = 10000;
 
-Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx) {
+Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx, const GraphBuildOption &option) {
   if (buf == nullptr) {
     MS_LOGE("the input buffer is nullptr");
     return nullptr;
@@ -42,12 +46,15 @@ Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx) {
   }
 
   auto graphDef = GetGraphDef(buf);
+  if (!option.copyWeight && option.weightGraph == nullptr && graphDef->dataAlign() == 0) {
+    MS_LOGW("the weights of the model are not aligned by the converter, the unaligned ones are copied");
+  }
   std::unique_ptr<Graph> graph(new (std::nothrow) Graph());
   if (graph == nullptr) {
     MS_LOGE("graph malloc fail");
     return nullptr;
   }
-  auto ret = graph->Build(*graphDef, ctx);
+  auto ret = graph->Build(*graphDef, ctx, option);
   if (ret != RET_OK) {
     MS_LOGE("build graph fail");
     return nullptr;
@@ -55,20 +62,71 @@ Graph *Graph::CreateFromBuf(const char *buf, size_t size, const Context &ctx) {
   return graph.release();
 }
 
+Graph *Graph::CreateFromFile(const char *path, const Context &ctx) {
+  if (path == nullptr) {
+    MS_LOGE("the model path is nullptr");
+    return nullptr;
+  }
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    MS_LOGE("open model file %s failed", path);
+    return nullptr;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+    MS_LOGE("model file %s is empty or can not be read", path);
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(fileStat.st_size);
+  // a private writable mapping, the pages a kernel writes to are copied and the file stays intact
+  void *buf = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (buf == MAP_FAILED) {
+    MS_LOGE("mmap model file %s failed, size %zu", path, size);
+    return nullptr;
+  }
+  GraphBuildOption option;
+  option.copyWeight = false;
+  auto graph = CreateFromBuf(static_cast<const char *>(buf), size, ctx, option);
+  if (graph == nullptr) {
+    munmap(buf, size);
+    return nullptr;
+  }
+  graph->modelBuf = buf;
+  graph->modelSize = size;
+  return graph;
+}
+
 Graph::Graph() = default;
 
 Graph::~Graph() {
+  memPlan.reset();
   for (auto &subgraph : subgraphs) {
     delete subgraph;
   }
   subgraphs.clear();
+  if (modelBuf != nullptr) {
+    munmap(modelBuf, modelSize);
+    modelBuf = nullptr;
+  }
 }
 
-int Graph::Build(const GraphDef &graphDef, const Context &ctx) {
+int Graph::Build(const GraphDef &graphDef, const Context &ctx, const GraphBuildOption &option) {
   MS_ASSERT(graphDef.subgraphs() != nullptr);
+  if (option.batchSize < 1) {
+    MS_LOGE("the batch size %d is invalid", option.batchSize);
+    return RET_PARAM_INVALID;
+  }
+  if (option.weightGraph != nullptr && option.weightGraph->subgraphs.size() != graphDef.subgraphs()->size()) {
+    MS_LOGE("the graph to share the weights with is built from another model");
+    return RET_ERROR;
+  }
   for (size_t i = 0; i < graphDef.subgraphs()->size(); i++) {
     MS_ASSERT(graphDef.subgraphs()->GetAs<SubGraphDef>(i) != nullptr);
-    SubGraph *subGraph = SubGraph::CreateSubGraph(*(graphDef.subgraphs()->GetAs<SubGraphDef>(i)), ctx);
+    const SubGraph *weightSubGraph = option.weightGraph == nullptr ? nullptr : option.weightGraph->subgraphs[i];
+    SubGraph *subGraph =
+      SubGraph::CreateSubGraph(*(graphDef.subgraphs()->GetAs<SubGraphDef>(i)), ctx, option, weightSubGraph);
     if (subGraph == nullptr) {
       MS_LOGE("converter subgraph failed");
       return RET_ERROR;
@@ -114,6 +172,77 @@ void Graph::FreeAllTensors() {
 
 std::vector<SubGraph *> *Graph::Subgraphs() { return &subgraphs; }
 
+int Graph::InitStaticMemPlan(bool parallel) {
+  // the same order as running the readyQue, the nodes made ready by one wave form the next wave
+  auto remainDepends = depends;
+  std::vector<Node *> wave(readyQue.begin(), readyQue.end());
+  std::vector<std::vector<Node *>> steps;
+  while (!wave.empty()) {
+    std::vector<Node *> nextWave;
+    for (auto node : wave) {
+      for (auto outNode : node->GetAllOutEdges()) {
+        auto nodeDepend = remainDepends.find(outNode);
+        if (nodeDepend == remainDepends.end()) {
+          continue;
+        }
+        nodeDepend->second.erase(node);
+        if (nodeDepend->second.empty()) {
+          remainDepends.erase(nodeDepend);
+          nextWave.push_back(outNode);
+        }
+      }
+    }
+    if (parallel) {
+      steps.push_back(wave);
+    } else {
+      for (auto node : wave) {
+        steps.push_back({node});
+      }
+    }
+    wave.swap(nextWave);
+  }
+  if (!remainDepends.empty()) {
+    MS_LOGW("%zu nodes are never ready, run without static memory plan", remainDepends.size());
+    return RET_OK;
+  }
+
+  // the outputs are handed to the caller and the nchw inputs take the data of the caller, they stay dynamic
+  std::unordered_set<Tensor *> skipTensors;
+  for (auto subgraph : subgraphs) {
+    MS_ASSERT(subgraph != nullptr);
+    for (auto tensor : subgraph->GetOutputs()) {
+      skipTensors.insert(tensor);
+    }
+    for (auto &outputNode : subgraph->GetOutputsMap()) {
+      skipTensors.insert(outputNode.second.begin(), outputNode.second.end());
+    }
+  }
+  std::vector<Tensor *> inputs;
+  for (auto tensor : GetInputs()) {
+    if (tensor != nullptr && tensor->GetFormat() == Format_NC4HW4) {
+      inputs.push_back(tensor);
+    } else {
+      skipTensors.insert(tensor);
+    }
+  }
+
+  memPlan.reset(new (std::nothrow) StaticMemPlan());
+  if (memPlan == nullptr) {
+    MS_LOGE("new StaticMemPlan failed");
+    return RET_NULL_PTR;
+  }
+  auto ret = memPlan->Build(steps, inputs, skipTensors);
+  if (ret != RET_OK) {
+    MS_LOGE("build static memory plan failed: %d", ret);
+    memPlan.reset();
+    return ret;
+  }
+  execSteps.swap(steps);
+  return RET_OK;
+}
+
+bool Graph::IsStaticTensor(const Tensor *tensor) const { return memPlan != nullptr && memPlan->IsPlanned(tensor); }
+
 SubGraph::SubGraph() = default;
 
 SubGraph::~SubGraph() {
@@ -125,6 +254,10 @@ SubGraph::~SubGraph() {
   }
   nodes.clear();
 
+  for (auto tensor : bufferTensors) {
+    tensor->SetData(nullptr);
+  }
+  bufferTensors.clear();
   for (auto &allTensor : allTensors) {
     if (allTensor != nullptr) {
       delete allTensor;
@@ -133,14 +266,15 @@ SubGraph::~SubGraph() {
   allTensors.clear();
 }
 
-SubGraph *SubGraph::CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx) {
+SubGraph *SubGraph::CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx, const GraphBuildOption &option,
+                                   const SubGraph *weightSubGraph) {
   std::unique_ptr<SubGraph> subGraph(new (std::nothrow) SubGraph());
   if (subGraph == nullptr) {
     MS_LOGE("subGraph malloc fail");
     return nullptr;
   }
 
-  auto ret = subGraph->Build(subGraphDef, ctx);
+  auto ret = subGraph->Build(subGraphDef, ctx, option, weightSubGraph);
   if (ret != RET_OK) {
     MS_LOGE("subGraph Build fail");
     return nullptr;
@@ -149,7 +283,8 @@ SubGraph *SubGraph::CreateSubGraph(const SubGraphDef &subGraphDef, const Context
   return subGraph.release();
 }
 
-int SubGraph::Build(const SubGraphDef &subGraphDef, const Context &ctx) {
+int SubGraph::Build(const SubGraphDef &subGraphDef, const Context &ctx, const GraphBuildOption &option,
+                    const SubGraph *weightSubGraph) {
   int ret;
   MS_ASSERT(subGraphDef.inputIndex() != nullptr);
   ret = ConverterIndex(*(subGraphDef.inputIndex()), &inputIndices);
@@ -167,7 +302,7 @@ int SubGraph::Build(const SubGraphDef &subGraphDef, const Context &ctx) {
   }
   MS_LOGD("converter outputIndex succ");
   MS_ASSERT(subGraphDef.allTensors() != nullptr);
-  ret = ConverterAllTensor(*(subGraphDef.allTensors()));
+  ret = ConverterAllTensor(*(subGraphDef.allTensors()), option, weightSubGraph);
   if (ret != RET_OK) {
     MS_LOGE("ConverterAllTensor failed: %d", ret);
     return ret;
@@ -209,8 +344,14 @@ int SubGraph::ConverterIndex(const flatbuffers::Vector<uint32_t> &srcIndex, std:
   return RET_OK;
 }
 
-int SubGraph::ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors) {
+int SubGraph::ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors,
+                                 const GraphBuildOption &option, const SubGraph *weightSubGraph) {
   uint32_t tensorsSize = srcTensors.size();
+  if (weightSubGraph != nullptr && weightSubGraph->allTensors.size() != tensorsSize) {
+    MS_LOGE("the subgraph to share the weights with has %zu tensors, not %u", weightSubGraph->allTensors.size(),
+            tensorsSize);
+    return RET_ERROR;
+  }
 
   allTensors.clear();
   allTensors.reserve(tensorsSize);
@@ -220,11 +361,38 @@ int SubGraph::ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<T
       MS_LOGE("%ud th tensordef is null", i);
       return RET_ERROR;
     }
-    auto tensor = Tensor::CopyFromTensorDef(*tensorDef);
+    bool isConst = tensorDef->refCount() == MSConst_WEIGHT_REFCOUNT && tensorDef->data() != nullptr &&
+                   tensorDef->data()->size() > 0;
+    Tensor *tensor = nullptr;
+    if (isConst && weightSubGraph != nullptr && weightSubGraph->allTensors[i] != nullptr &&
+        weightSubGraph->allTensors[i]->GetData() != nullptr) {
+      auto srcTensor = weightSubGraph->allTensors[i];
+      tensor = new (std::nothrow) Tensor(*srcTensor, false);
+      if (tensor == nullptr) {
+        MS_LOGE("new Tensor failed");
+        return RET_ERROR;
+      }
+      tensor->SetData(srcTensor->GetData());
+      tensor->AddRef(MSConst_WEIGHT_REFCOUNT - tensor->RefCount());
+      allTensors.push_back(tensor);
+      bufferTensors.push_back(tensor);
+      continue;
+    }
+    tensor = Tensor::CopyFromTensorDef(*tensorDef, option.copyWeight);
     if (tensor == nullptr) {
       return RET_ERROR;
     }
     allTensors.push_back(tensor);
+    if (tensorDef->data() != nullptr && tensor->GetData() == tensorDef->data()->data()) {
+      bufferTensors.push_back(tensor);
+    }
+    if (!isConst && option.batchSize > 1) {
+      auto dims = tensor->GetDims();
+      if (!dims.empty()) {
+        dims[0] *= option.batchSize;
+        tensor->SetDims(dims);
+      }
+    }
   }
 
   return RET_OK;
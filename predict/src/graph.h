@@ -19,6 +19,7 @@
 
 #include <map>
 #include <deque>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,17 +28,31 @@
 #include "common/graph_util.h"
 #include "include/tensor.h"
 #include "src/node.h"
+#include "src/static_mem_plan.h"
 
 #define MSPREDICT_API __attribute__((visibility("default")))
 
 namespace mindspore {
 namespace predict {
+class Graph;
+
+struct GraphBuildOption {
+  // the weights are copied out of the buffer unless copyWeight is false, then the buffer must outlive the graph
+  bool copyWeight = true;
+  // use the weights of this graph built from the same model instead, it must outlive the graph
+  const Graph *weightGraph = nullptr;
+  // the first dimension of the tensors other than the weights is multiplied by batchSize
+  int batchSize = 1;
+};
+
 class SubGraph {
  public:
   SubGraph();
   ~SubGraph();
-  static SubGraph *CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx);
-  int Build(const SubGraphDef &subGraphDef, const Context &ctx);
+  static SubGraph *CreateSubGraph(const SubGraphDef &subGraphDef, const Context &ctx, const GraphBuildOption &option,
+                                  const SubGraph *weightSubGraph = nullptr);
+  int Build(const SubGraphDef &subGraphDef, const Context &ctx, const GraphBuildOption &option,
+            const SubGraph *weightSubGraph = nullptr);
   bool IsInputIndex(uint32_t i);
   bool IsOutputIndex(uint32_t i);
 
@@ -47,6 +62,7 @@ class SubGraph {
   std::vector<Tensor *> GetInputs();
   std::vector<Tensor *> GetOutputs();
   std::map<NODE_ID, std::vector<Tensor *>> &GetOutputsMap();
+  const std::vector<Tensor *> &GetAllTensors() const { return allTensors; }
   void FreeAllTensors();
 
   Node *GetNode(const NODE_ID &id);
@@ -56,7 +72,8 @@ class SubGraph {
  private:
   int ConverterIndex(const flatbuffers::Vector<uint32_t> &srcIndex, std::vector<uint32_t> *dstIndex);
 
-  int ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors);
+  int ConverterAllTensor(const flatbuffers::Vector<flatbuffers::Offset<TensorDef>> &srcTensors,
+                         const GraphBuildOption &option, const SubGraph *weightSubGraph);
 
   int ConverterNodes(const flatbuffers::Vector<flatbuffers::Offset<NodeDef>> &opDefs, const Context &ctx);
 
@@ -69,6 +86,7 @@ class SubGraph {
   std::vector<uint32_t> inputIndices;
   std::vector<uint32_t> outputIndices;
   std::vector<Tensor *> allTensors;  // weight + input + output
+  std::vector<Tensor *> bufferTensors;  // the weights using the data of the model buffer or of another graph
   std::map<NODE_ID, std::vector<Tensor *>> outputsMap;
 };
 
@@ -76,7 +94,10 @@ class MSPREDICT_API Graph {
  public:
   Graph();
   ~Graph();
-  static Graph *CreateFromBuf(const char *buf, size_t size, const Context &ctx);
+  static Graph *CreateFromBuf(const char *buf, size_t size, const Context &ctx,
+                              const GraphBuildOption &option = GraphBuildOption());
+  // map the model file and use the aligned weights in place
+  static Graph *CreateFromFile(const char *path, const Context &ctx);
 
   std::vector<Tensor *> GetInputs();
   std::vector<Tensor *> GetOutputs();
@@ -85,15 +106,28 @@ class MSPREDICT_API Graph {
 
   void FreeAllTensors();
 
-  int Build(const GraphDef &def, const Context &ctx);
+  int Build(const GraphDef &def, const Context &ctx, const GraphBuildOption &option = GraphBuildOption());
   std::vector<SubGraph *> *Subgraphs();
 
+  // fix the execution steps and bind the intermediate tensors to one arena planned from their lifetimes. a step
+  // holds one node, or all the nodes whose dependencies are done by the steps before if parallel is true.
+  int InitStaticMemPlan(bool parallel = false);
+  bool IsStaticTensor(const Tensor *tensor) const;
+  // the mapped model file, nullptr if the graph is not created from a file
+  const char *GetModelBuf() const { return static_cast<const char *>(modelBuf); }
+  size_t GetModelSize() const { return modelSize; }
+
  protected:
   friend class GraphExecution;
 
   std::vector<SubGraph *> subgraphs;
   std::unordered_map<Node *, std::unordered_set<Node *>> depends;  // records the dependencies
   std::deque<Node *> readyQue;  // the nodes which can execute without any dependencies
+  std::vector<std::vector<Node *>> execSteps;  // the steps the static memory plan is made for
+  std::unique_ptr<StaticMemPlan> memPlan;
+  // the mapped model file
+  void *modelBuf = nullptr;
+  size_t modelSize = 0;
 };
 }  // namespace predict
 }  // namespace mindspore
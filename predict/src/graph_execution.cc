@@ -25,8 +25,11 @@ GraphExecution::GraphExecution(const Context &ctx) : graph(nullptr), _ctx(ctx) {
 GraphExecution::GraphExecution(const Context &ctx, Graph *staticGraph) : _ctx(ctx) {
   graph = staticGraph;
   if (graph != nullptr) {
-    depends = graph->depends;
-    readyQue = graph->readyQue;
+    // the nodes run in the order of the static memory plan if there is one, with no dependencies to track
+    if (graph->execSteps.empty()) {
+      depends = graph->depends;
+      readyQue = graph->readyQue;
+    }
     outputTensors = graph->GetOutputs();
     inputTensors = graph->GetInputs();
   }
@@ -225,6 +228,9 @@ void GraphExecution::ResetInputData() {
       continue;
     }
     if (tensor->GetFormat() == Format_NC4HW4) {
+      if (graph->IsStaticTensor(tensor)) {
+        continue;
+      }
       if (tensor->GetData() != nullptr) {
         free(tensor->GetData());
         tensor->SetData(nullptr);
@@ -237,6 +243,55 @@ void GraphExecution::ResetInputData() {
 
 void GraphExecution::FreeAllTensors() { graph->FreeAllTensors(); }
 
+int GraphExecution::RunNode(Node *node) {
+  auto ret = node->Run(_ctx);
+  if (ret != RET_OK) {
+    MS_LOGE("node (%s) failed to run op (%s). error code:%d", node->ID().c_str(), node->Type().c_str(), ret);
+    ResetInputData();
+    FreeAllTensors();
+  }
+  return ret;
+}
+
+int GraphExecution::RunStepTask(int taskId, TVMParallelGroupEnv *penv, void *cdata) {
+  auto step = static_cast<std::vector<Node *> *>(cdata);
+  MS_ASSERT(step != nullptr && static_cast<size_t>(taskId) < step->size());
+  auto node = (*step)[taskId];
+  auto ret = node->Execute();
+  if (ret != RET_OK) {
+    MS_LOGE("node (%s) failed to run op (%s). error code:%d", node->ID().c_str(), node->Type().c_str(), ret);
+  }
+  return ret;
+}
+
+int GraphExecution::RunStep(std::vector<Node *> *step) {
+  MS_ASSERT(step != nullptr);
+  if (step->size() == 1) {
+    return RunNode(step->front());
+  }
+  // the refcounts and the allocator are only touched by this thread, the ops run on the thread pool
+  int ret = RET_OK;
+  for (auto node : *step) {
+    ret = node->MallocOutput(_ctx);
+    if (ret != RET_OK) {
+      MS_LOGE("node (%s) MallocOutput failed: %d", node->ID().c_str(), ret);
+      break;
+    }
+  }
+  if (ret == RET_OK && LiteBackendParallelLaunch(RunStepTask, step, static_cast<int>(step->size())) != 0) {
+    ret = RET_ERROR;
+  }
+  if (ret != RET_OK) {
+    ResetInputData();
+    FreeAllTensors();
+    return ret;
+  }
+  for (auto node : *step) {
+    node->FreeInput();
+  }
+  return RET_OK;
+}
+
 int GraphExecution::Run(const std::vector<Tensor *> &inputs) {
   if (inputs.empty()) {
     MS_LOGE("input is empty");
@@ -245,7 +300,7 @@ int GraphExecution::Run(const std::vector<Tensor *> &inputs) {
 
   int ret;
 
-  if (readyQue.empty()) {
+  if (readyQue.empty() && graph->execSteps.empty()) {
     MS_LOGE("readyQue is empty");
     return RET_ERROR;
   }
@@ -263,15 +318,19 @@ int GraphExecution::Run(const std::vector<Tensor *> &inputs) {
     return ret;
   }
 
+  for (auto &step : graph->execSteps) {
+    ret = RunStep(&step);
+    if (ret != RET_OK) {
+      return ret;
+    }
+  }
+
   while (!readyQue.empty()) {
     auto *node = readyQue.front();
     readyQue.pop_front();
 
-    ret = node->Run(_ctx);
+    ret = RunNode(node);
     if (ret != RET_OK) {
-      MS_LOGE("node (%s) failed to run op (%s). error code:%d", node->ID().c_str(), node->Type().c_str(), ret);
-      ResetInputData();
-      FreeAllTensors();
       return ret;
     }
 
@@ -30,6 +30,7 @@
 #include "schema/inner/ms_generated.h"
 #include "src/operator/cpu/include/op_func_comm.h"
 #include "src/node.h"
+#include "src/runtime/runtime_api.h"
 
 namespace mindspore {
 namespace predict {
@@ -55,6 +56,10 @@ class GraphExecution {
   int CopyOutputTensors(const std::vector<Tensor *> &refOutputs, std::vector<Tensor *> *outputs);
   void FreeOutputMap(std::map<NODE_ID, std::vector<Tensor *>> *map);
   void FreeAllTensors();
+  int RunNode(Node *node);
+  // the nodes of a step are independent, they run at the same time when there are several
+  int RunStep(std::vector<Node *> *step);
+  static int RunStepTask(int taskId, TVMParallelGroupEnv *penv, void *cdata);
 
  protected:
   Graph *graph;
@@ -15,7 +15,13 @@
  */
 
 #include "src/runtime/thread_pool.h"
+#if defined(__linux__) || defined(__ANDROID__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #include <algorithm>
+#include <climits>
 #include "common/mslog.h"
 
 namespace mindspore {
@@ -24,34 +30,81 @@ static constexpr int kThreadPoolMaxThreads = 8;
 static const int kCoreNumThr = 4;
 static const int kMidCoreNum = 2;
 static const int kBigCoreNum = 2;
-bool LiteQueue::Enqueue(const ThreadPoolTask &task) {
-  const int tailIndex = tail.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tailIndex + 1) % kSingleThreadMaxTask;
-  if (next == head.load(std::memory_order_acquire)) {
-    return false;
+// set on the threads of the pool, a task that distributes tasks again runs them inline
+static thread_local bool gInPoolThread = false;
+#if defined(__linux__) || defined(__ANDROID__)
+static void FutexWait(std::atomic<int> *addr, int expected) {
+  (void)syscall(SYS_futex, reinterpret_cast<int *>(addr), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+static void FutexWake(std::atomic<int> *addr, int count) {
+  (void)syscall(SYS_futex, reinterpret_cast<int *>(addr), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+#else
+static void FutexWait(std::atomic<int> *addr, int expected) {
+  if (addr->load() == expected) {
+    std::this_thread::yield();
   }
-  buffer[tailIndex] = task;
-  tail.store(next, std::memory_order_release);
-  taskSize.fetch_add(1);
-  return true;
 }
 
-bool LiteQueue::Dequeue(ThreadPoolTask *out) {
-  if (out == nullptr) {
-    MS_LOGE("ThreadPoolTask is nullptr");
+static void FutexWake(std::atomic<int> *addr, int count) {}
+#endif
+
+static inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+void ParkingLot::Park(int expected) {
+  parked.fetch_add(1);
+  FutexWait(&epoch, expected);
+  parked.fetch_sub(1);
+}
+
+void ParkingLot::Unpark(int count) {
+  epoch.fetch_add(1);
+  // the parked count is read after the epoch changes, a thread not counted yet sees the new epoch and does not park
+  if (parked.load() > 0) {
+    FutexWake(&epoch, count);
+  }
+}
+
+void TaskDeque::PushBack(const ThreadPoolTask &task) {
+  std::lock_guard<std::mutex> lock(mutex);
+  tasks.push_back(task);
+  taskSize.fetch_add(1, std::memory_order_release);
+}
+
+bool TaskDeque::PopFront(ThreadPoolTask *out) {
+  MS_ASSERT(out != nullptr);
+  if (Empty()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  if (tasks.empty()) {
     return false;
   }
-  if (taskSize.load() == 0) {
+  *out = tasks.front();
+  tasks.pop_front();
+  taskSize.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool TaskDeque::StealBack(ThreadPoolTask *out) {
+  MS_ASSERT(out != nullptr);
+  if (Empty()) {
     return false;
   }
-  // queue empty
-  const int headIndex = head.load(std::memory_order_relaxed);
-  if (headIndex == tail.load(std::memory_order_acquire)) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (tasks.empty()) {
     return false;
   }
-  *out = buffer[headIndex];
-  head.store((headIndex + 1) % kSingleThreadMaxTask, std::memory_order_release);
+  *out = tasks.back();
+  tasks.pop_back();
+  taskSize.fetch_sub(1, std::memory_order_relaxed);
   return true;
 }
 
@@ -197,106 +250,147 @@ bool LiteThreadBind::SetCPUBind(pthread_t threadId, const cpu_set_t &cpuSet) {
 }
 
 LiteThreadPool::LiteThreadPool(int numThreads) {
-  queueList.resize(kThreadPoolMaxThreads);
-  queueList.clear();
+  queueList.reserve(kThreadPoolMaxThreads);
+  for (int i = 0; i < kThreadPoolMaxThreads; ++i) {
+    queueList.push_back(std::unique_ptr<TaskDeque>(new TaskDeque()));
+  }
   AddNewThread(numThreads);
 }
 
 void LiteThreadPool::AddNewThread(int newNums) {
-  for (int i = curThreadNums, j = 0; j < newNums; ++j, ++i) {
-    queueList.push_back(std::unique_ptr<LiteQueue>(new LiteQueue()));
-    threadList.emplace_back([this, i]() {
-      ThreadPoolTask task;
-      while (!destroy) {
-        while (running != 0) {
-          MS_LOGD("i = %d, thread id = %lu, taskSize = %d", i, pthread_self(), queueList[i]->taskSize.load());
-          while (queueList[i]->taskSize.load() > 0 && queueList[i]->Dequeue(&task)) {
-            auto ret = task.first(task.second.taskId, task.second.tvmParam, task.second.cdata);
-            if (ret != 0) {
-              errorInfo.emplace_back(std::make_pair(task.second.taskId, std::make_pair(false, ret)));
-            }
-            queueList[i]->taskSize.fetch_sub(1);
-          }
-          std::this_thread::yield();
-        }
-        std::unique_lock<std::mutex> queueLock(tMutex);
-        queueReady.wait(queueLock, [this] { return destroy || running != 0; });
-      }
-    });
+  int cur = curThreadNums.load();
+  newNums = std::min(newNums, kThreadPoolMaxThreads - cur);
+  for (int i = cur, j = 0; j < newNums; ++j, ++i) {
+    threadList.emplace_back([this, i]() { WorkerLoop(i); });
   }
   MS_LOGI("%d new thread create", newNums);
-  curThreadNums += newNums;
+  curThreadNums.store(cur + newNums);
 }
 
-bool LiteThreadPool::DistributeTask(ThreadPoolTask task, int numTask) {
-  // wake up
-  errorInfo.clear();
-  if (!AddRunReference()) {
-    MS_LOGE("add reference failed");
-    return false;
+bool LiteThreadPool::RunOneTask(int index) {
+  ThreadPoolTask task;
+  bool found = queueList[index]->PopFront(&task);
+  for (int i = 1; !found && i < kThreadPoolMaxThreads; ++i) {
+    found = queueList[(index + i) % kThreadPoolMaxThreads]->StealBack(&task);
   }
-  bool kSuccFlag;
-  for (int i = 1; i < numTask; ++i) {
-    task.second.taskId = i;
-    do {
-      kSuccFlag = false;
-      for (auto &queue : queueList) {
-        MS_ASSERT(queue != nullptr);
-        if (queue->Enqueue(task)) {
-          kSuccFlag = true;
-          break;
-        }
-      }
-      std::this_thread::yield();
-    } while (!kSuccFlag);
+  if (!found) {
+    return false;
   }
-  MS_LOGI("add %d task successful", numTask);
-  // master thread
-  int ret = task.first(0, task.second.tvmParam, task.second.cdata);
+  auto group = task.second.group;
+  auto ret = task.first(task.second.taskId, task.second.tvmParam, task.second.cdata);
   if (ret != 0) {
-    errorInfo.emplace_back(std::make_pair(0, std::make_pair(false, ret)));
+    group->errorCode.store(ret);
   }
-  kSuccFlag = false;
-  while (!kSuccFlag) {
-    kSuccFlag = true;
-    for (auto iter = queueList.begin(); iter != queueList.end(); ++iter) {
-      if ((*iter)->taskSize.load() != 0) {
-        kSuccFlag = false;
+  // the group lives on the stack of its waiting thread, it is not touched after the last task is counted
+  if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    doneLot.Unpark(INT_MAX);
+  }
+  return true;
+}
+
+bool LiteThreadPool::HasTask() const {
+  for (auto &queue : queueList) {
+    if (!queue->Empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LiteThreadPool::WorkerLoop(int index) {
+  gInPoolThread = true;
+  int spinLimit = kMinSpinCount;
+  while (!destroy) {
+    if (RunOneTask(index)) {
+      continue;
+    }
+    bool found = false;
+    for (int spin = 0; spin < spinLimit && !destroy; ++spin) {
+      if (HasTask()) {
+        found = true;
         break;
       }
+      CpuRelax();
     }
-    std::this_thread::yield();
-  }
-  // hibernate
-  if (!SubRunReference()) {
-    MS_LOGE("sub reference failed");
-    return false;
+    if (found) {
+      // the tasks come in bursts, spin longer next time
+      spinLimit = std::min(spinLimit * 2, kMaxSpinCount);
+      continue;
+    }
+    spinLimit = std::max(spinLimit / 2, kMinSpinCount);
+    // a task pushed after the epoch is read changes it, so the thread does not park on a stale epoch
+    int epoch = taskLot.Epoch();
+    if (HasTask() || destroy) {
+      continue;
+    }
+    taskLot.Park(epoch);
   }
-  MS_LOGI("finish %d task successful", numTask);
-  return CheckResult();
 }
 
-bool LiteThreadPool::AddRunReference() {
-  running.fetch_add(1);
-  std::lock_guard<std::mutex> queueLock(tMutex);
-  queueReady.notify_all();
-  return true;
+bool LiteThreadPool::DistributeTask(ThreadPoolTask task, int numTask) {
+  // no task to run, the group would never count down to 0
+  if (numTask <= 0) {
+    MS_LOGD("no task to distribute, numTask is %d", numTask);
+    return true;
+  }
+  TaskGroup group;
+  task.second.group = &group;
+  // the threads of the pool may all be waiting on this task, run them inline
+  if (gInPoolThread) {
+    for (int i = 0; i < numTask; ++i) {
+      int ret = task.first(i, task.second.tvmParam, task.second.cdata);
+      if (ret != 0) {
+        group.errorCode.store(ret);
+      }
+    }
+    return CheckResult(group);
+  }
+  group.pending.store(numTask - 1);
+  int threadNum = std::max(curThreadNums.load(), 1);
+  int first = nextQueue.fetch_add(1) % threadNum;
+  for (int i = 1; i < numTask; ++i) {
+    task.second.taskId = i;
+    queueList[(first + i - 1) % threadNum]->PushBack(task);
+  }
+  taskLot.Unpark(numTask - 1);
+  MS_LOGD("add %d task successful", numTask);
+  // master thread
+  int ret = task.first(0, task.second.tvmParam, task.second.cdata);
+  if (ret != 0) {
+    group.errorCode.store(ret);
+  }
+  WaitGroup(group);
+  MS_LOGD("finish %d task successful", numTask);
+  return CheckResult(group);
 }
 
-bool LiteThreadPool::SubRunReference() {
-  running.fetch_sub(1);
-  return true;
+void LiteThreadPool::WaitGroup(const TaskGroup &group) {
+  int spin = 0;
+  while (group.pending.load(std::memory_order_acquire) != 0) {
+    // help with the tasks left rather than wait for a thread to take them
+    if (RunOneTask(nextQueue.load() % kThreadPoolMaxThreads)) {
+      continue;
+    }
+    if (spin < kMaxSpinCount) {
+      ++spin;
+      CpuRelax();
+      continue;
+    }
+    int epoch = doneLot.Epoch();
+    if (group.pending.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+    doneLot.Park(epoch);
+  }
 }
 
-bool LiteThreadPool::CheckResult() {
-  bool kSuccFlag = true;
-  for (auto result : errorInfo) {
-    if (result.second.first) {
-      MS_LOGE("task %d failed, error code is %d", result.first, result.second.second);
-      kSuccFlag = false;
-    }
+bool LiteThreadPool::CheckResult(const TaskGroup &group) {
+  auto errorCode = group.errorCode.load();
+  if (errorCode != 0) {
+    MS_LOGE("task failed, error code is %d", errorCode);
+    return false;
   }
-  return kSuccFlag;
+  return true;
 }
 
 int ThreadPool::GetThreadNum(int numThreads) {
@@ -304,8 +398,9 @@ int ThreadPool::GetThreadNum(int numThreads) {
     MS_LOGE("numThreads %d, must be greater than 0 or less than or equal to %d", numThreads, kThreadPoolMaxThreads);
     return -1;
   } else {
-    if (numThreads > totalThreadNum) {
-      return (numThreads - totalThreadNum);
+    int curThreadNum = gThreadPool == nullptr ? 0 : static_cast<int>(gThreadPool->threadList.size());
+    if (numThreads > curThreadNum) {
+      return (numThreads - curThreadNum);
     } else {
       MS_LOGD("%d threads have been already created", numThreads);
       return 0;
@@ -395,6 +490,7 @@ void ThreadPool::ConfigThreadPool(int mode, int numThreads) {
 }
 
 bool ThreadPool::LaunchThreadPoolTask() {
+  std::lock_guard<std::mutex> launchLock(gLaunchMutex);
   if (gThreadPool == nullptr) {
     if (!SetThreadPool(totalThreadNum)) {
       MS_LOGE("create %d threads failed", totalThreadNum);
@@ -427,16 +523,28 @@ bool ThreadPool::AddTask(const WorkFun &worker, void *cdata, int numTask) {
     MS_LOGD("task 0 successful");
     return true;
   }
+  TvmEnv env{};
+  env.num_task = numTask;
   ThreadPoolTask task;
   task.first = worker;
   task.second.cdata = cdata;
+  task.second.tvmParam = &env;
+  if (gThreadPool == nullptr) {
+    for (int i = 0; i < numTask; ++i) {
+      int ret = worker(i, &env, cdata);
+      if (ret != 0) {
+        MS_LOGE("task %d failed, error code is %d", i, ret);
+        return false;
+      }
+    }
+    return true;
+  }
   return gThreadPool->DistributeTask(task, numTask);
 }
 
 LiteThreadPool::~LiteThreadPool() {
   destroy.store(true);
-  running.store(0);
-  queueReady.notify_all();
+  taskLot.Unpark(INT_MAX);
   for (auto &thread : threadList) {
     if (thread.joinable()) {
       thread.join();
@@ -18,11 +18,11 @@
 #define PREDICT_SRC_RUNTIME_THREAD_POOL_H_
 
 #include <mutex>
-#include <condition_variable>
 #include <thread>
 #include <vector>
 #include <string>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <functional>
@@ -30,29 +30,56 @@
 
 namespace mindspore {
 namespace predict {
-constexpr int kSingleThreadMaxTask = 4;
+// the spins an idle thread checks for tasks before it parks, adapted between the bounds by whether spinning pays off
+constexpr int kMinSpinCount = 64;
+constexpr int kMaxSpinCount = 16384;
 using TvmEnv = TVMParallelGroupEnv;
 using WorkFun = FTVMParallelLambda;
+// the tasks of one DistributeTask call, so that calls from several threads do not wait for each other
+struct TaskGroup {
+  std::atomic<int> pending{0};
+  std::atomic<int> errorCode{0};
+};
 using TaskParam = struct Param {
   void *cdata;
   int32_t taskId;
   TvmEnv *tvmParam;
+  TaskGroup *group;
 };
 using ThreadPoolTask = std::pair<WorkFun, TaskParam>;
 
-class LiteQueue {
+// A futex word, the threads park on it until the value changes. Falls back to yielding where there is no futex.
+class ParkingLot {
  public:
-  LiteQueue() = default;
-  ~LiteQueue() = default;
+  ParkingLot() = default;
+  ~ParkingLot() = default;
 
-  bool Enqueue(const ThreadPoolTask &task);
-  bool Dequeue(ThreadPoolTask *out);
-  std::atomic<int> taskSize{0};
+  int Epoch() const { return epoch.load(); }
+  // park unless the epoch has changed since it was read
+  void Park(int expected);
+  // change the epoch and wake up to count parked threads
+  void Unpark(int count);
 
  private:
-  std::atomic<int> head{0};
-  std::atomic<int> tail{0};
-  ThreadPoolTask buffer[kSingleThreadMaxTask]{};
+  std::atomic<int> epoch{0};
+  std::atomic<int> parked{0};
+};
+
+// The tasks of one thread of the pool. The thread takes them from the front, the other threads steal from the back.
+class TaskDeque {
+ public:
+  TaskDeque() = default;
+  ~TaskDeque() = default;
+
+  void PushBack(const ThreadPoolTask &task);
+  bool PopFront(ThreadPoolTask *out);
+  bool StealBack(ThreadPoolTask *out);
+  bool Empty() const { return taskSize.load(std::memory_order_acquire) == 0; }
+
+ private:
+  std::mutex mutex;
+  std::deque<ThreadPoolTask> tasks;
+  std::atomic<int> taskSize{0};
 };
 
 class LiteThreadBind {
@@ -83,21 +110,26 @@ class LiteThreadPool {
   ~LiteThreadPool();
 
   void AddNewThread(int newNums);
+  // may be called from several threads at the same time, a call from a task of the pool runs the tasks inline
   bool DistributeTask(ThreadPoolTask task, int numTask);
   std::vector<std::thread> threadList{};
 
  private:
-  using errCode = std::pair<bool, int>;
-  bool AddRunReference();
-  bool SubRunReference();
-  bool CheckResult();
-  int curThreadNums{0};
-  std::vector<std::unique_ptr<LiteQueue>> queueList;
-  std::atomic_int running{0};
-  std::mutex tMutex;
-  std::condition_variable queueReady;
+  // run one task of the deque of the thread index, or one stolen from the others
+  bool RunOneTask(int index);
+  bool HasTask() const;
+  void WorkerLoop(int index);
+  // spin, then park until the tasks of the group are all done, the waiting thread helps with the tasks meanwhile
+  void WaitGroup(const TaskGroup &group);
+  bool CheckResult(const TaskGroup &group);
+  std::atomic<int> curThreadNums{0};
+  // one for every thread the pool may have, created up front so the list never changes while the threads run
+  std::vector<std::unique_ptr<TaskDeque>> queueList;
+  std::atomic<int> nextQueue{0};
+  // the idle threads park on taskLot, the threads waiting for their group park on doneLot
+  ParkingLot taskLot;
+  ParkingLot doneLot;
   std::atomic<bool> destroy = {false};
-  std::vector<std::pair<int, errCode>> errorInfo{};
 };
 
 class ThreadPool {
@@ -120,6 +152,8 @@ class ThreadPool {
   std::unique_ptr<LiteThreadPool> gThreadPool{nullptr};
   std::unique_ptr<LiteThreadBind> gThreadBind{nullptr};
   std::mutex gPoolMutex;
+  // the first tasks of several sessions may launch the pool at the same time
+  std::mutex gLaunchMutex;
   int totalThreadNum{1};
   int bindMode{-1};
 };
@@ -21,6 +21,7 @@
 #include "common/mslog.h"
 #include "src/graph.h"
 #include "src/graph_execution.h"
+#include "src/executor_pool.h"
 
 namespace mindspore {
 namespace predict {
@@ -48,6 +49,22 @@ std::shared_ptr<Session> CreateSession(const char *graphBuf, size_t size, const
   }
   return session;
 }
+
+std::shared_ptr<Session> CreateSessionFromFile(const char *modelPath, const Context &ctx) {
+  if (modelPath == nullptr) {
+    MS_LOGE("the modelPath is nullptr");
+    return nullptr;
+  }
+  auto session = std::make_shared<Session>(ctx);
+  MS_ASSERT(session != nullptr);
+  auto ret = session->InitFromFile(modelPath);
+  if (ret != RET_OK) {
+    MS_LOGE("Init session from file failed.");
+    return nullptr;
+  }
+  return session;
+}
+
 Session::Session(const Context &ctx) : _ctx(ctx) {
   Context cfgCtx;
   cfgCtx = ctx;
@@ -62,8 +79,37 @@ int Session::Init(const char *graphBuf, size_t size) {
     MS_LOGE("Graph create from buf failed.");
     return RET_NULL_PTR;
   }
+  return this->InitGraph(graphBuf, size);
+}
+
+int Session::InitFromFile(const char *modelPath) {
+  _graph = Graph::CreateFromFile(modelPath, _ctx);
+  if (_graph == nullptr) {
+    MS_LOGE("Graph create from file failed.");
+    return RET_NULL_PTR;
+  }
+  return this->InitGraph(_graph->GetModelBuf(), _graph->GetModelSize());
+}
 
-  auto ret = this->InitExecutor();
+int Session::InitGraph(const char *graphBuf, size_t size) {
+  auto ret = _graph->InitStaticMemPlan(_ctx.parallelNodes);
+  if (ret != RET_OK) {
+    MS_LOGE("Init static memory plan failed");
+    return ret;
+  }
+
+  _executorPool = new (std::nothrow) ExecutorPool(_ctx);
+  if (_executorPool == nullptr) {
+    MS_LOGE("new ExecutorPool fail");
+    return RET_ERROR;
+  }
+  ret = _executorPool->Init(_graph, graphBuf, size);
+  if (ret != RET_OK) {
+    MS_LOGE("Init executor pool failed");
+    return ret;
+  }
+
+  ret = this->InitExecutor();
   if (ret != RET_OK) {
     MS_LOGE("Init Executor failed");
     return ret;
@@ -93,28 +139,47 @@ Session::~Session() {
   if (_executor != nullptr) {
     delete _executor;
   }
+  // the executor contexts use the weights of the graph
+  if (_executorPool != nullptr) {
+    delete _executorPool;
+  }
   if (_graph != nullptr) {
     delete _graph;
   }
 }
 
 int Session::Run(const std::vector<Tensor *> &inputs) {
+  if (_executorPool == nullptr || !_executorPool->TryAcquireMainContext()) {
+    MS_LOGE("the session is running");
+    return RET_REENTRANT_ERROR;
+  }
   auto ret = RET_OK;
   if (reinitExecutor) {
     ret = this->InitExecutor();
     if (ret != RET_OK) {
       MS_LOGE("Init Executor failed");
+      _executorPool->ReleaseContext(0);
       return ret;
     }
   }
   if (_executor == nullptr) {
     MS_LOGE("_executor is nullptr");
+    _executorPool->ReleaseContext(0);
     return ret;
   }
   ret = _executor->Run(inputs);
+  _executorPool->ReleaseContext(0);
   return ret;
 }
 
+int Session::Run(const std::vector<Tensor *> &inputs, std::map<std::string, std::vector<Tensor *>> *outputs) {
+  if (_executorPool == nullptr) {
+    MS_LOGE("_executorPool is nullptr");
+    return RET_ERROR;
+  }
+  return _executorPool->Run(inputs, outputs);
+}
+
 std::vector<Tensor *> Session::GetInput() {
   if (_executor == nullptr) {
     MS_LOGE("_executor is nullptr");
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/static_mem_plan.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include "common/mslog.h"
+#include "include/errorcode.h"
+
+namespace mindspore {
+namespace predict {
+static size_t AlignUp(size_t size) { return (size + STATIC_MEM_ALIGN - 1) / STATIC_MEM_ALIGN * STATIC_MEM_ALIGN; }
+
+StaticMemPlan::~StaticMemPlan() {
+  // the tensors must not free the arena when they are deleted
+  for (auto &lifetime : lifetimes) {
+    lifetime.tensor->SetData(nullptr);
+  }
+  if (arena != nullptr) {
+    free(arena);
+    arena = nullptr;
+  }
+}
+
+void StaticMemPlan::AddTensor(Tensor *tensor, size_t pos, std::unordered_map<Tensor *, size_t> *indices) {
+  MS_ASSERT(indices != nullptr);
+  auto iter = indices->find(tensor);
+  if (iter != indices->end()) {
+    auto &lifetime = lifetimes[iter->second];
+    lifetime.begin = std::min(lifetime.begin, pos);
+    lifetime.end = std::max(lifetime.end, pos);
+    return;
+  }
+  if (tensor->GetData() != nullptr) {
+    return;
+  }
+  auto dims = tensor->GetDims();
+  for (auto dim : dims) {
+    if (dim <= 0) {
+      return;
+    }
+  }
+  size_t size = tensor->GetDataSize();
+  if (size == 0) {
+    return;
+  }
+  (*indices)[tensor] = lifetimes.size();
+  lifetimes.push_back({tensor, AlignUp(size), pos, pos});
+}
+
+void StaticMemPlan::AssignOffsets(std::vector<size_t> *offsets) {
+  MS_ASSERT(offsets != nullptr);
+  std::vector<size_t> order(lifetimes.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_t lhs, size_t rhs) { return lifetimes[lhs].size > lifetimes[rhs].size; });
+
+  offsets->assign(lifetimes.size(), 0);
+  std::vector<size_t> placed;
+  std::vector<std::pair<size_t, size_t>> busy;
+  arenaSize = 0;
+  for (auto idx : order) {
+    auto &lifetime = lifetimes[idx];
+    busy.clear();
+    for (auto placedIdx : placed) {
+      auto &other = lifetimes[placedIdx];
+      if (lifetime.begin <= other.end && other.begin <= lifetime.end) {
+        busy.emplace_back((*offsets)[placedIdx], (*offsets)[placedIdx] + other.size);
+      }
+    }
+    std::sort(busy.begin(), busy.end());
+    size_t offset = 0;
+    for (auto &range : busy) {
+      if (range.first >= offset + lifetime.size) {
+        break;
+      }
+      offset = std::max(offset, range.second);
+    }
+    (*offsets)[idx] = offset;
+    arenaSize = std::max(arenaSize, offset + lifetime.size);
+    placed.push_back(idx);
+  }
+}
+
+int StaticMemPlan::Build(const std::vector<std::vector<Node *>> &steps, const std::vector<Tensor *> &inputs,
+                         const std::unordered_set<Tensor *> &skipTensors) {
+  if (arena != nullptr) {
+    MS_LOGE("the static memory plan is built already");
+    return RET_ERROR;
+  }
+  std::unordered_map<Tensor *, size_t> indices;
+  for (auto tensor : inputs) {
+    MS_ASSERT(tensor != nullptr);
+    AddTensor(tensor, 0, &indices);
+  }
+  for (size_t pos = 0; pos < steps.size(); pos++) {
+    for (auto node : steps[pos]) {
+      MS_ASSERT(node != nullptr);
+      for (auto tensor : node->GetOutputTensors()) {
+        if (tensor == nullptr || tensor->RefCount() == MSConst_WEIGHT_REFCOUNT ||
+            skipTensors.find(tensor) != skipTensors.end()) {
+          continue;
+        }
+        AddTensor(tensor, pos, &indices);
+      }
+    }
+    for (auto node : steps[pos]) {
+      for (auto tensor : node->GetInputTensors()) {
+        auto iter = indices.find(tensor);
+        if (iter != indices.end()) {
+          lifetimes[iter->second].end = std::max(lifetimes[iter->second].end, pos);
+        }
+      }
+    }
+  }
+  if (lifetimes.empty()) {
+    return RET_OK;
+  }
+
+  std::vector<size_t> offsets;
+  AssignOffsets(&offsets);
+  arena = malloc(arenaSize + STATIC_MEM_ALIGN);
+  if (arena == nullptr) {
+    MS_LOGE("malloc static memory arena failed, size %zu", arenaSize);
+    lifetimes.clear();
+    arenaSize = 0;
+    return RET_ERROR;
+  }
+  auto base = reinterpret_cast<uint8_t *>(AlignUp(reinterpret_cast<uintptr_t>(arena)));
+  size_t totalSize = 0;
+  for (size_t i = 0; i < lifetimes.size(); i++) {
+    auto tensor = lifetimes[i].tensor;
+    tensor->SetData(base + offsets[i]);
+    tensor->AddRef(MSConst_WEIGHT_REFCOUNT - tensor->RefCount());
+    tensors.insert(tensor);
+    totalSize += lifetimes[i].size;
+  }
+  MS_LOGI("static memory plan: %zu tensors of %zu bytes in an arena of %zu bytes", lifetimes.size(), totalSize,
+          arenaSize);
+  return RET_OK;
+}
+
+bool StaticMemPlan::IsPlanned(const Tensor *tensor) const { return tensors.find(tensor) != tensors.end(); }
+}  // namespace predict
+}  // namespace mindspore
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREDICT_SRC_STATIC_MEM_PLAN_H_
+#define PREDICT_SRC_STATIC_MEM_PLAN_H_
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "include/tensor.h"
+#include "src/node.h"
+
+namespace mindspore {
+namespace predict {
+// the offsets of the tensors in the arena are aligned to this
+constexpr size_t STATIC_MEM_ALIGN = 64;
+
+// A static memory plan of the tensors of a graph. The lifetime of every planned tensor is known from a fixed
+// execution order, so the tensors are packed into one arena ahead of time and bound to their offsets once. The
+// planned tensors get the weight refcount, so the nodes neither malloc nor free them when the graph runs.
+// The order is a list of steps, the nodes of a step may run at the same time.
+class StaticMemPlan {
+ public:
+  StaticMemPlan() = default;
+  ~StaticMemPlan();
+
+  // plan the outputs of the nodes in the steps and the inputs given, which live from the start of the graph. the
+  // tensors in skipTensors, the weights and the tensors of unknown size stay dynamic.
+  int Build(const std::vector<std::vector<Node *>> &steps, const std::vector<Tensor *> &inputs,
+            const std::unordered_set<Tensor *> &skipTensors);
+  bool IsPlanned(const Tensor *tensor) const;
+  size_t GetArenaSize() const { return arenaSize; }
+  size_t GetTensorNum() const { return tensors.size(); }
+
+ private:
+  struct Lifetime {
+    Tensor *tensor;
+    size_t size;
+    size_t begin;
+    size_t end;
+  };
+
+  void AddTensor(Tensor *tensor, size_t pos, std::unordered_map<Tensor *, size_t> *indices);
+  // greedy by size, every tensor takes the lowest gap that fits among the placed ones it overlaps with
+  void AssignOffsets(std::vector<size_t> *offsets);
+
+  std::vector<Lifetime> lifetimes;
+  std::unordered_set<const Tensor *> tensors;
+  void *arena = nullptr;
+  size_t arenaSize = 0;
+};
+}  // namespace predict
+}  // namespace mindspore
+
+#endif  // PREDICT_SRC_STATIC_MEM_PLAN_H_
@@ -15,6 +15,7 @@
  */
 
 #include "include/tensor.h"
+#include <cstdint>
 #include "common/mslog.h"
 #include "src/op_common.h"
 #include "include/errorcode.h"
@@ -24,7 +25,10 @@
 
 namespace mindspore {
 namespace predict {
-Tensor *Tensor::CopyFromTensorDef(const TensorDef &tensorDef) {
+// the alignment the kernels need to use the const data in place
+static constexpr uintptr_t CONST_DATA_ALIGN = 16;
+
+Tensor *Tensor::CopyFromTensorDef(const TensorDef &tensorDef, bool copyData) {
   std::vector<int64_t> dims;
 
   if (tensorDef.dims() == nullptr) {
@@ -46,12 +50,18 @@ Tensor *Tensor::CopyFromTensorDef(const TensorDef &tensorDef) {
     if (dims.size() < 1) {
       tensor->SetDims({1});
     }
+    auto tensorData = tensorDef.data()->data();
+    if (!copyData && reinterpret_cast<uintptr_t>(tensorData) % CONST_DATA_ALIGN == 0 &&
+        tensorDef.data()->size() >= tensor->GetDataSize()) {
+      tensor->SetData(const_cast<uint8_t *>(tensorData));
+      tensor->refCount = tensorDef.refCount();
+      return tensor.release();
+    }
     auto ret = tensor->MallocData();
     if (ret != RET_OK) {
       MS_LOGE("malloc data fail,datasize %zu", tensor->GetDataSize());
       return nullptr;
     }
-    auto tensorData = tensorDef.data()->data();
     ret = memcpy_sp(tensor->GetData(), tensor->GetDataSize(), tensorData, tensorDef.data()->size());
     if (ret != RET_OK) {
       MS_LOGE("copy data fail,dst size %zu, src size %u", tensor->GetDataSize(), tensorDef.data()->size());
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "src/runtime/thread_pool.h"
+
+namespace mindspore {
+namespace predict {
+class ThreadPoolBenchmarkTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+static int EmptyTask(int, TvmEnv *, void *) { return 0; }
+
+// The latency of launching bursts of trivial tasks, the overhead the pool adds to every parallel kernel
+TEST_F(ThreadPoolBenchmarkTest, LaunchLatency) {
+  const int poolThreads = 3;
+  const int loops = 10000;
+  LiteThreadPool pool(poolThreads);
+  for (int numTask : {2, 4}) {
+    TvmEnv env{};
+    env.num_task = numTask;
+    ThreadPoolTask task;
+    task.first = EmptyTask;
+    task.second.cdata = nullptr;
+    task.second.taskId = 0;
+    task.second.tvmParam = &env;
+    task.second.group = nullptr;
+    std::vector<double> latencies;
+    latencies.reserve(loops);
+    for (int i = 0; i < loops; ++i) {
+      auto start = std::chrono::steady_clock::now();
+      ASSERT_TRUE(pool.DistributeTask(task, numTask));
+      auto end = std::chrono::steady_clock::now();
+      latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    printf("launch %d tasks: p50 %.2f us, p99 %.2f us\n", numTask, latencies[loops / 2], latencies[loops * 99 / 100]);
+  }
+}
+}  // namespace predict
+}  // namespace mindspore
@@ -16,7 +16,11 @@
 
 #include <gtest/gtest.h>
 #include <cstdio>
+#include <fstream>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 #include "schema/inner/ms_generated.h"
 #include "src/graph.h"
 #include "common/file_utils.h"
@@ -144,5 +148,288 @@ TEST_F(GraphTest, CreateFromFileAdd) {
   FreeOutputs(&outputs);
   FreeInputs(&inputs);
 }
+
+std::unique_ptr<NodeDefT> CreateAddNode(const std::string &name, const std::vector<uint32_t> &inputIndex,
+                                        const std::vector<uint32_t> &outputIndex) {
+  std::unique_ptr<NodeDefT> node(new (std::nothrow) NodeDefT);
+  std::unique_ptr<OpDefT> opDef(new (std::nothrow) OpDefT);
+  if (node == nullptr || opDef == nullptr) {
+    return nullptr;
+  }
+  node->opDef = std::move(opDef);
+  node->opDef->isLastConv = false;
+  node->opDef->inputIndex = inputIndex;
+  node->opDef->outputIndex = outputIndex;
+  node->opDef->name = name;
+  node->fmkType = FmkType_CAFFE;
+  auto attr = std::unique_ptr<AddT>(new (std::nothrow) AddT());
+  if (attr == nullptr) {
+    return nullptr;
+  }
+  attr->format = DataFormatType_NCHW;
+  node->opDef->attr.type = OpT_Add;
+  node->opDef->attr.value = attr.release();
+  return node;
+}
+
+TEST_F(GraphTest, StaticMemPlanAddChain) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test2";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0, 1};
+  msSubgraph->outputIndex = {3};
+
+  // tensor 2 only lives between the two nodes, it is bound to the static memory plan
+  auto node = CreateAddNode(msSubgraph->name + std::to_string(0), {0, 1}, {2});
+  ASSERT_NE(node, nullptr);
+  msSubgraph->nodes.emplace_back(std::move(node));
+  node = CreateAddNode(msSubgraph->name + std::to_string(1), {2, 1}, {3});
+  ASSERT_NE(node, nullptr);
+  msSubgraph->nodes.emplace_back(std::move(node));
+
+  InitMsGraphAllTensor(msSubgraph.get());
+  std::unique_ptr<TensorDefT> tensor(new (std::nothrow) TensorDefT);
+  ASSERT_NE(tensor, nullptr);
+  tensor->refCount = 0;
+  tensor->format = Format_NCHW;
+  tensor->dataType = DataType_DT_FLOAT;
+  tensor->dims = {1, 1, 1, 2};
+  tensor->offset = -1;
+  tensor->data.resize(0);
+  msSubgraph->allTensors.emplace_back(std::move(tensor));
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  Context ctx;
+  auto session = CreateSession(static_cast<char *>(content), size, ctx);
+  ASSERT_NE(session, nullptr);
+
+  std::vector<float> tmpT = {1, 2};
+  std::vector<float> tmpT2 = {3, 5};
+  auto inputs = session->GetInput();
+  inputs[0]->SetData(tmpT.data());
+  inputs[1]->SetData(tmpT2.data());
+
+  // the arena is reused by every run
+  for (int i = 0; i < 2; i++) {
+    auto ret = session->Run(inputs);
+    EXPECT_EQ(0, ret);
+    auto outputs = session->GetAllOutput();
+    ASSERT_EQ(1, outputs.size());
+    EXPECT_EQ(7, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[0]);
+    EXPECT_EQ(12, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[1]);
+    FreeOutputs(&outputs);
+  }
+
+  FreeInputs(&inputs);
+}
+
+TEST_F(GraphTest, CreateSessionFromFile) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test3";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0};
+  msSubgraph->outputIndex = {2};
+  auto node = CreateAddNode(msSubgraph->name + std::to_string(0), {0, 1}, {2});
+  ASSERT_NE(node, nullptr);
+  msSubgraph->nodes.emplace_back(std::move(node));
+
+  // tensor 1 is a weight, it is used in place when the model file is mapped
+  InitMsGraphAllTensor(msSubgraph.get());
+  std::vector<float> weight = {3, 5};
+  auto weightData = reinterpret_cast<uint8_t *>(weight.data());
+  msSubgraph->allTensors[1]->data.assign(weightData, weightData + weight.size() * sizeof(float));
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  const std::string modelPath = "./graph_tests_mmap.ms";
+  std::ofstream output(modelPath, std::ofstream::binary);
+  ASSERT_TRUE(output.is_open());
+  output.write(reinterpret_cast<const char *>(builder.GetBufferPointer()), builder.GetSize());
+  output.close();
+
+  Context ctx;
+  auto session = CreateSessionFromFile(modelPath.c_str(), ctx);
+  ASSERT_NE(session, nullptr);
+
+  std::vector<float> tmpT = {1, 2};
+  auto inputs = session->GetInput();
+  ASSERT_EQ(1, inputs.size());
+  inputs[0]->SetData(tmpT.data());
+  auto ret = session->Run(inputs);
+  EXPECT_EQ(0, ret);
+  auto outputs = session->GetAllOutput();
+  EXPECT_EQ(4, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[0]);
+  EXPECT_EQ(7, reinterpret_cast<float *>(outputs.begin()->second.front()->GetData())[1]);
+
+  FreeOutputs(&outputs);
+  FreeInputs(&inputs);
+  session = nullptr;
+  (void)remove(modelPath.c_str());
+}
+
+TEST_F(GraphTest, ConcurrentRunParallelNodes) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test4";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0, 1};
+  msSubgraph->outputIndex = {2, 3};
+
+  // the two nodes are independent, they run in one step
+  const std::string firstName = msSubgraph->name + std::to_string(0);
+  const std::string secondName = msSubgraph->name + std::to_string(1);
+  auto node = CreateAddNode(firstName, {0, 1}, {2});
+  ASSERT_NE(node, nullptr);
+  msSubgraph->nodes.emplace_back(std::move(node));
+  node = CreateAddNode(secondName, {1, 1}, {3});
+  ASSERT_NE(node, nullptr);
+  msSubgraph->nodes.emplace_back(std::move(node));
+
+  InitMsGraphAllTensor(msSubgraph.get());
+  std::unique_ptr<TensorDefT> tensor(new (std::nothrow) TensorDefT);
+  ASSERT_NE(tensor, nullptr);
+  tensor->refCount = 0;
+  tensor->format = Format_NCHW;
+  tensor->dataType = DataType_DT_FLOAT;
+  tensor->dims = {1, 1, 1, 2};
+  tensor->offset = -1;
+  tensor->data.resize(0);
+  msSubgraph->allTensors.emplace_back(std::move(tensor));
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  Context ctx;
+  ctx.execContextNum = 2;
+  ctx.parallelNodes = true;
+  auto session = CreateSession(static_cast<char *>(content), size, ctx);
+  ASSERT_NE(session, nullptr);
+
+  std::vector<float> tmpT = {1, 2};
+  std::vector<float> tmpT2 = {3, 5};
+  auto inputs = session->GetInput();
+  ASSERT_EQ(2, inputs.size());
+  inputs[0]->SetData(tmpT.data());
+  inputs[1]->SetData(tmpT2.data());
+
+  const int threadNum = 4;
+  const int loopCount = 10;
+  std::vector<int> failures(threadNum, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadNum; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < loopCount; i++) {
+        std::map<std::string, std::vector<Tensor *>> outputs;
+        auto ret = session->Run(inputs, &outputs);
+        auto first = outputs.find(firstName);
+        auto second = outputs.find(secondName);
+        if (ret != 0 || first == outputs.end() || second == outputs.end() || first->second.empty() ||
+            second->second.empty()) {
+          failures[t]++;
+        } else {
+          auto firstData = reinterpret_cast<float *>(first->second.front()->GetData());
+          auto secondData = reinterpret_cast<float *>(second->second.front()->GetData());
+          if (firstData[0] != 4 || firstData[1] != 7 || secondData[0] != 6 || secondData[1] != 10) {
+            failures[t]++;
+          }
+        }
+        FreeOutputs(&outputs);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < threadNum; t++) {
+    EXPECT_EQ(0, failures[t]);
+  }
+
+  FreeInputs(&inputs);
+}
+
+TEST_F(GraphTest, BatchedRun) {
+  auto msGraph = std::unique_ptr<GraphDefT>(new (std::nothrow) GraphDefT());
+  ASSERT_NE(msGraph, nullptr);
+  msGraph->name = "test5";
+  auto msSubgraph = std::unique_ptr<SubGraphDefT>(new (std::nothrow) SubGraphDefT());
+  ASSERT_NE(msSubgraph, nullptr);
+  msSubgraph->name = msGraph->name + "_1";
+  msSubgraph->inputIndex = {0, 1};
+  msSubgraph->outputIndex = {2};
+  auto node = CreateAddNode(msSubgraph->name + std::to_string(0), {0, 1}, {2});
+  ASSERT_NE(node, nullptr);
+  msSubgraph->nodes.emplace_back(std::move(node));
+  InitMsGraphAllTensor(msSubgraph.get());
+  msGraph->subgraphs.emplace_back(std::move(msSubgraph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = mindspore::predict::GraphDef::Pack(builder, msGraph.get());
+  builder.Finish(offset);
+  int size = builder.GetSize();
+  void *content = builder.GetBufferPointer();
+
+  // the requests are collected into batches of up to 4, every request gets its own part of the outputs
+  Context ctx;
+  ctx.maxBatchSize = 4;
+  ctx.batchTimeoutUs = 10000;
+  auto session = CreateSession(static_cast<char *>(content), size, ctx);
+  ASSERT_NE(session, nullptr);
+
+  const int threadNum = 6;
+  std::vector<int> failures(threadNum, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadNum; t++) {
+    threads.emplace_back([&, t]() {
+      std::vector<float> tmpT = {static_cast<float>(t), 1};
+      std::vector<float> tmpT2 = {3, static_cast<float>(t)};
+      auto inputs = session->GetInput();
+      if (inputs.size() != 2) {
+        failures[t]++;
+        return;
+      }
+      inputs[0]->SetData(tmpT.data());
+      inputs[1]->SetData(tmpT2.data());
+      std::map<std::string, std::vector<Tensor *>> outputs;
+      auto ret = session->Run(inputs, &outputs);
+      if (ret != 0 || outputs.size() != 1 || outputs.begin()->second.size() != 1) {
+        failures[t]++;
+      } else {
+        auto output = outputs.begin()->second.front();
+        auto data = reinterpret_cast<float *>(output->GetData());
+        if (output->GetDims() != inputs[0]->GetDims() || data[0] != t + 3 || data[1] != t + 1) {
+          failures[t]++;
+        }
+      }
+      FreeOutputs(&outputs);
+      FreeInputs(&inputs);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < threadNum; t++) {
+    EXPECT_EQ(0, failures[t]);
+  }
+}
 }  // namespace predict
 }  // namespace mindspore
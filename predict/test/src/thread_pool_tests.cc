@@ -0,0 +1,171 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "src/runtime/thread_pool.h"
+
+namespace mindspore {
+namespace predict {
+class ThreadPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+static const int kPoolThreads = 3;
+
+// the counts of the tasks run by id, and the pool the nested tasks distribute to
+struct TaskCounter {
+  std::atomic<int> counts[kPoolThreads + 1];
+  LiteThreadPool *pool;
+  TaskCounter() : pool(nullptr) {
+    for (auto &count : counts) {
+      count.store(0);
+    }
+  }
+};
+
+static ThreadPoolTask MakeTask(WorkFun fun, void *cdata, TvmEnv *env) {
+  ThreadPoolTask task;
+  task.first = fun;
+  task.second.cdata = cdata;
+  task.second.taskId = 0;
+  task.second.tvmParam = env;
+  task.second.group = nullptr;
+  return task;
+}
+
+static int CountTask(int taskId, TvmEnv *, void *cdata) {
+  auto counter = static_cast<TaskCounter *>(cdata);
+  counter->counts[taskId].fetch_add(1);
+  return 0;
+}
+
+static int FailTask(int taskId, TvmEnv *, void *) {
+  const int errorCode = 3;
+  return taskId == 2 ? errorCode : 0;
+}
+
+// each task distributes the tasks of CountTask again
+static int NestedTask(int, TvmEnv *env, void *cdata) {
+  auto counter = static_cast<TaskCounter *>(cdata);
+  return counter->pool->DistributeTask(MakeTask(CountTask, cdata, env), env->num_task) ? 0 : 1;
+}
+
+// several threads distribute their tasks at the same time, each call waits for its own tasks only
+TEST_F(ThreadPoolTest, ConcurrentDistributeTask) {
+  LiteThreadPool pool(kPoolThreads);
+  const int callers = 4;
+  const int rounds = 200;
+  const int numTask = kPoolThreads + 1;
+  std::vector<std::unique_ptr<TaskCounter>> counters;
+  std::vector<std::thread> threads;
+  std::atomic<int> failed{0};
+  for (int i = 0; i < callers; ++i) {
+    counters.emplace_back(new TaskCounter());
+  }
+  for (int i = 0; i < callers; ++i) {
+    auto counter = counters[i].get();
+    threads.emplace_back([&pool, &failed, counter, numTask, rounds]() {
+      TvmEnv env{};
+      env.num_task = numTask;
+      for (int round = 0; round < rounds; ++round) {
+        if (!pool.DistributeTask(MakeTask(CountTask, counter, &env), numTask)) {
+          failed.fetch_add(1);
+        }
+        // all the tasks of the call are done when it returns
+        for (int id = 0; id < numTask; ++id) {
+          if (counter->counts[id].load() != round + 1) {
+            failed.fetch_add(1);
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(failed.load(), 0);
+}
+
+// the error of a task fails its call only, the next call of the pool succeeds
+TEST_F(ThreadPoolTest, TaskErrorPropagation) {
+  LiteThreadPool pool(kPoolThreads);
+  TvmEnv env{};
+  env.num_task = kPoolThreads + 1;
+  ASSERT_FALSE(pool.DistributeTask(MakeTask(FailTask, nullptr, &env), env.num_task));
+  TaskCounter counter;
+  ASSERT_TRUE(pool.DistributeTask(MakeTask(CountTask, &counter, &env), env.num_task));
+  for (int id = 0; id < env.num_task; ++id) {
+    ASSERT_EQ(counter.counts[id].load(), 1);
+  }
+}
+
+// a task of the pool distributing tasks runs them inline instead of waiting for the busy threads
+TEST_F(ThreadPoolTest, DistributeTaskFromTask) {
+  LiteThreadPool pool(kPoolThreads);
+  TaskCounter counter;
+  counter.pool = &pool;
+  TvmEnv env{};
+  env.num_task = kPoolThreads + 1;
+  ASSERT_TRUE(pool.DistributeTask(MakeTask(NestedTask, &counter, &env), env.num_task));
+  for (int id = 0; id < env.num_task; ++id) {
+    ASSERT_EQ(counter.counts[id].load(), env.num_task);
+  }
+}
+
+// a call without tasks returns at once and runs nothing, the next call of the pool still runs its tasks
+TEST_F(ThreadPoolTest, DistributeNoTask) {
+  LiteThreadPool pool(kPoolThreads);
+  TaskCounter counter;
+  TvmEnv env{};
+  env.num_task = 0;
+  ASSERT_TRUE(pool.DistributeTask(MakeTask(CountTask, &counter, &env), 0));
+  ASSERT_TRUE(pool.DistributeTask(MakeTask(CountTask, &counter, &env), -1));
+  for (int id = 0; id <= kPoolThreads; ++id) {
+    ASSERT_EQ(counter.counts[id].load(), 0);
+  }
+  env.num_task = kPoolThreads + 1;
+  ASSERT_TRUE(pool.DistributeTask(MakeTask(CountTask, &counter, &env), env.num_task));
+  for (int id = 0; id < env.num_task; ++id) {
+    ASSERT_EQ(counter.counts[id].load(), 1);
+  }
+}
+
+// the threads parked once the tasks are done are woken up and joined by the destructor
+TEST_F(ThreadPoolTest, DestroyParkedPool) {
+  std::unique_ptr<LiteThreadPool> pool(new LiteThreadPool(kPoolThreads));
+  TaskCounter counter;
+  TvmEnv env{};
+  env.num_task = kPoolThreads + 1;
+  ASSERT_TRUE(pool->DistributeTask(MakeTask(CountTask, &counter, &env), env.num_task));
+  // long enough for the threads to spin out and park
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  pool.reset();
+
+  // a pool that never ran a task
+  pool.reset(new LiteThreadPool(kPoolThreads));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  pool.reset();
+}
+}  // namespace predict
+}  // namespace mindspore
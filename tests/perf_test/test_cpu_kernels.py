@@ -0,0 +1,89 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+"""Micro benchmarks of the vectorized cpu kernels, run with MS_CPU_ISA=generic for the scalar baseline."""
+
+import time
+
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore import context
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+repeat = 20
+
+
+class OpNet(nn.Cell):
+    def __init__(self, op, *attrs):
+        super(OpNet, self).__init__()
+        self.op = op
+        self.attrs = attrs
+
+    def construct(self, *inputs):
+        return self.op(*(inputs + self.attrs))
+
+
+def bench(name, net, inputs, reference):
+    """Time the kernel against the numpy reference of the same op, the first run compiles the graph."""
+    net(*inputs)
+    start = time.time()
+    for _ in range(repeat):
+        net(*inputs)
+    kernel_ms = (time.time() - start) * 1000 / repeat
+    arrays = [x.asnumpy() for x in inputs]
+    start = time.time()
+    for _ in range(repeat):
+        reference(*arrays)
+    numpy_ms = (time.time() - start) * 1000 / repeat
+    print("{:<12} kernel {:8.3f} ms, numpy {:8.3f} ms".format(name, kernel_ms, numpy_ms))
+    return kernel_ms
+
+
+def gelu_reference(x):
+    return 0.5 * x * (1.0 + np.tanh(0.7978845608 * (x + 0.044715 * x * x * x)))
+
+
+def layer_norm_reference(x, gamma, beta):
+    mean = np.mean(x, axis=-1, keepdims=True)
+    var = np.var(x, axis=-1, keepdims=True)
+    return (x - mean) / np.sqrt(var + 10e-12) * gamma + beta
+
+
+def test_cpu_kernels():
+    np.random.seed(0)
+    x = Tensor(np.random.randn(64, 128, 768).astype(np.float32))
+    gamma = Tensor(np.random.randn(768).astype(np.float32))
+    beta = Tensor(np.random.randn(768).astype(np.float32))
+    table = Tensor(np.random.randn(30522, 768).astype(np.float32))
+    indices = Tensor(np.random.randint(0, 30522, size=(64, 128)).astype(np.int32))
+    image = Tensor(np.random.randn(32, 64, 56, 56).astype(np.float32))
+    channel = [Tensor(np.abs(np.random.randn(64)).astype(np.float32)) for _ in range(4)]
+
+    bench("Gelu", OpNet(P.Gelu()), [x], gelu_reference)
+    bench("LayerNorm", OpNet(P.LayerNorm(-1, -1)), [x, gamma, beta], layer_norm_reference)
+    bench("GatherV2", OpNet(P.GatherV2(), 0), [table, indices], lambda t, i: np.take(t, i, axis=0))
+    bench("Concat", OpNet(P.Concat(-1)), [x, x], lambda a, b: np.concatenate((a, b), axis=-1))
+    bench("Slice", OpNet(P.Slice(), (0, 0, 128), (64, 128, 512)), [x], lambda a: a[:, :, 128:640].copy())
+    bench("Transpose", OpNet(P.Transpose(), (0, 2, 1)), [x], lambda a: np.transpose(a, (0, 2, 1)).copy())
+    bench("ReduceSum", OpNet(P.ReduceSum(), (0, 1)), [x], lambda a: np.sum(a, axis=(0, 1)))
+    bench("ReduceMean", OpNet(P.ReduceMean(), -1), [x], lambda a: np.mean(a, axis=-1))
+    bench("ReduceMax", OpNet(P.ReduceMax(), -1), [x], lambda a: np.max(a, axis=-1))
+    bench("BatchNorm", OpNet(P.BatchNorm(is_training=False)), [image] + channel,
+          lambda a, s, o, m, v: (a - m.reshape(1, -1, 1, 1)) / np.sqrt(v.reshape(1, -1, 1, 1) + 1e-5) *
+          s.reshape(1, -1, 1, 1) + o.reshape(1, -1, 1, 1))
@@ -0,0 +1,62 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetAdam(nn.Cell):
+    def __init__(self, var, m, v, use_nesterov):
+        super(NetAdam, self).__init__()
+        self.adam = P.Adam(use_nesterov=use_nesterov)
+        self.var = Parameter(Tensor(var), name="var")
+        self.m = Parameter(Tensor(m), name="m")
+        self.v = Parameter(Tensor(v), name="v")
+
+    def construct(self, beta1_power, beta2_power, lr, beta1, beta2, epsilon, grad):
+        return self.adam(self.var, self.m, self.v, beta1_power, beta2_power, lr, beta1, beta2, epsilon, grad)
+
+
+def adam_compute(var, m, v, grad, beta1_power, beta2_power, lr, beta1, beta2, epsilon, use_nesterov):
+    lr_t = lr * np.sqrt(1 - beta2_power) / (1 - beta1_power)
+    m = beta1 * m + (1 - beta1) * grad
+    v = beta2 * v + (1 - beta2) * grad * grad
+    update = m * beta1 + (1 - beta1) * grad if use_nesterov else m
+    var = var - lr_t * update / (np.sqrt(v) + epsilon)
+    return var, m, v
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_adam():
+    np.random.seed(0)
+    for use_nesterov in (False, True):
+        var = np.random.randn(64, 129).astype(np.float32)
+        m = np.random.randn(64, 129).astype(np.float32)
+        v = np.abs(np.random.randn(64, 129)).astype(np.float32)
+        grad = np.random.randn(64, 129).astype(np.float32)
+        scalars = [Tensor(np.array([value]).astype(np.float32)) for value in (0.81, 0.998, 0.01, 0.9, 0.999, 1e-8)]
+        output = NetAdam(var, m, v, use_nesterov)(*scalars, Tensor(grad))
+        expect = adam_compute(var, m, v, grad, 0.81, 0.998, 0.01, 0.9, 0.999, 1e-8, use_nesterov)
+        for out, exp in zip(output, expect):
+            assert np.allclose(out.asnumpy(), exp, rtol=1e-4, atol=1e-5)
@@ -0,0 +1,73 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetBatchNorm(nn.Cell):
+    def __init__(self, is_training):
+        super(NetBatchNorm, self).__init__()
+        self.batch_norm = P.BatchNorm(is_training=is_training, epsilon=1e-5)
+
+    def construct(self, x, scale, offset, mean, variance):
+        return self.batch_norm(x, scale, offset, mean, variance)
+
+
+def batch_norm_compute(x, scale, offset, mean, variance):
+    shape = (1, -1, 1, 1)
+    return (x - mean.reshape(shape)) / np.sqrt(variance.reshape(shape) + 1e-5) * scale.reshape(shape) + \
+           offset.reshape(shape)
+
+
+def make_inputs():
+    np.random.seed(0)
+    x = np.random.randn(2, 16, 9, 11).astype(np.float32)
+    scale = np.random.randn(16).astype(np.float32)
+    offset = np.random.randn(16).astype(np.float32)
+    mean = np.random.randn(16).astype(np.float32)
+    variance = np.abs(np.random.randn(16)).astype(np.float32)
+    return x, scale, offset, mean, variance
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_batch_norm_infer():
+    x, scale, offset, mean, variance = make_inputs()
+    output = NetBatchNorm(False)(Tensor(x), Tensor(scale), Tensor(offset), Tensor(mean), Tensor(variance))
+    expect = batch_norm_compute(x, scale, offset, mean, variance)
+    assert np.allclose(output[0].asnumpy(), expect, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_batch_norm_training():
+    x, scale, offset, mean, variance = make_inputs()
+    output = NetBatchNorm(True)(Tensor(x), Tensor(scale), Tensor(offset), Tensor(mean), Tensor(variance))
+    batch_mean = np.mean(x, axis=(0, 2, 3))
+    batch_variance = np.var(x, axis=(0, 2, 3))
+    expect = batch_norm_compute(x, scale, offset, batch_mean, batch_variance)
+    assert np.allclose(output[0].asnumpy(), expect, rtol=1e-4, atol=1e-4)
+    assert np.allclose(output[1].asnumpy(), batch_mean, rtol=1e-4, atol=1e-5)
+    assert np.allclose(output[2].asnumpy(), batch_variance, rtol=1e-4, atol=1e-5)
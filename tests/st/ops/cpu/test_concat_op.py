@@ -0,0 +1,48 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetConcat(nn.Cell):
+    def __init__(self, axis):
+        super(NetConcat, self).__init__()
+        self.concat = P.Concat(axis)
+
+    def construct(self, x1, x2, x3):
+        return self.concat((x1, x2, x3))
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_concat():
+    np.random.seed(0)
+    for axis in (0, 1, 2, -1):
+        shapes = [[4, 5, 6], [4, 5, 6], [4, 5, 6]]
+        shapes[1][axis] = 2
+        shapes[2][axis] = 7
+        inputs = [np.random.randn(*shape).astype(np.float32) for shape in shapes]
+        output = NetConcat(axis)(*[Tensor(x) for x in inputs])
+        expect = np.concatenate(inputs, axis=axis)
+        assert (output.asnumpy() == expect).all()
@@ -0,0 +1,58 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetGatherV2(nn.Cell):
+    def __init__(self, axis):
+        super(NetGatherV2, self).__init__()
+        self.gather = P.GatherV2()
+        self.axis = axis
+
+    def construct(self, params, indices):
+        return self.gather(params, indices, self.axis)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_gather_v2():
+    np.random.seed(0)
+    params = np.random.randn(16, 32, 64).astype(np.float32)
+    for axis in (0, 1, -1):
+        indices = np.random.randint(0, params.shape[axis], size=(3, 5)).astype(np.int32)
+        output = NetGatherV2(axis)(Tensor(params), Tensor(indices))
+        expect = np.take(params, indices, axis=axis)
+        assert (output.asnumpy() == expect).all()
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_gather_v2_out_of_range():
+    params = np.arange(12).reshape(4, 3).astype(np.float32)
+    indices = np.array([1, 4, -1]).astype(np.int32)
+    output = NetGatherV2(0)(Tensor(params), Tensor(indices))
+    expect = np.array([[3, 4, 5], [0, 0, 0], [0, 0, 0]]).astype(np.float32)
+    assert (output.asnumpy() == expect).all()
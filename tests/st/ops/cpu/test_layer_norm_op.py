@@ -0,0 +1,69 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetLayerNorm(nn.Cell):
+    def __init__(self, begin_norm_axis, begin_params_axis):
+        super(NetLayerNorm, self).__init__()
+        self.layer_norm = P.LayerNorm(begin_norm_axis, begin_params_axis)
+
+    def construct(self, x, gamma, beta):
+        return self.layer_norm(x, gamma, beta)
+
+
+def layer_norm_compute(x, gamma, beta, begin_norm_axis):
+    axis = tuple(range(begin_norm_axis, x.ndim))
+    mean = np.mean(x, axis=axis, keepdims=True)
+    var = np.var(x, axis=axis, keepdims=True)
+    y = (x - mean) / np.sqrt(var + 10e-12) * gamma + beta
+    return y, mean, var
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_layer_norm():
+    np.random.seed(0)
+    x = np.random.randn(4, 32, 771).astype(np.float32)
+    gamma = np.random.randn(771).astype(np.float32)
+    beta = np.random.randn(771).astype(np.float32)
+    y, mean, var = NetLayerNorm(-1, -1)(Tensor(x), Tensor(gamma), Tensor(beta))
+    expect_y, expect_mean, expect_var = layer_norm_compute(x, gamma, beta, 2)
+    assert np.allclose(y.asnumpy(), expect_y, rtol=1e-4, atol=1e-4)
+    assert np.allclose(mean.asnumpy().reshape(expect_mean.shape), expect_mean, rtol=1e-4, atol=1e-5)
+    assert np.allclose(var.asnumpy().reshape(expect_var.shape), expect_var, rtol=1e-4, atol=1e-5)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_layer_norm_params_axis():
+    np.random.seed(1)
+    x = np.random.randn(8, 6, 40).astype(np.float32)
+    gamma = np.random.randn(40).astype(np.float32)
+    beta = np.random.randn(40).astype(np.float32)
+    y, _, _ = NetLayerNorm(1, -1)(Tensor(x), Tensor(gamma), Tensor(beta))
+    expect_y, _, _ = layer_norm_compute(x, gamma, beta, 1)
+    assert np.allclose(y.asnumpy(), expect_y, rtol=1e-4, atol=1e-4)
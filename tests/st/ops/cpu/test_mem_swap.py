@@ -0,0 +1,59 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetLateUse(nn.Cell):
+    """The first output is read again by the last operator, four outputs of 32KB are alive at the peak."""
+    def __init__(self):
+        super(NetLateUse, self).__init__()
+        self.relu = P.ReLU()
+        self.mul = P.Mul()
+
+    def construct(self, x):
+        a = self.relu(x)
+        b = self.mul(x, x)
+        c = self.relu(b)
+        d = self.mul(b, c)
+        e = self.relu(d)
+        f = self.relu(e)
+        return self.mul(f, a)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_mem_swap():
+    x = np.random.randn(32, 256).astype(np.float32)
+    expect = np.maximum(x * x * x * x, 0) * np.maximum(x, 0)
+    output = NetLateUse()(Tensor(x))
+    assert np.allclose(output.asnumpy(), expect)
+
+    # three and a half outputs, the first one has to be on the host while the peak runs
+    context.set_context(swap_memory_max_size="0.000107GB")
+    try:
+        output = NetLateUse()(Tensor(x))
+    finally:
+        context.set_context(swap_memory_max_size="0GB")
+    assert np.allclose(output.asnumpy(), expect)
@@ -0,0 +1,69 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetReduce(nn.Cell):
+    def __init__(self, op, axis, keep_dims):
+        super(NetReduce, self).__init__()
+        self.reduce = op(keep_dims)
+        self.axis = axis
+
+    def construct(self, x):
+        return self.reduce(x, self.axis)
+
+
+axes = (2, 0, (0, 2), (1, 3), (), -1)
+
+
+def run_reduce(op, np_op):
+    np.random.seed(0)
+    x = np.random.randn(4, 5, 6, 7).astype(np.float32)
+    for axis in axes:
+        for keep_dims in (False, True):
+            output = NetReduce(op, axis, keep_dims)(Tensor(x))
+            np_axis = None if axis == () else axis
+            expect = np_op(x, axis=np_axis, keepdims=keep_dims)
+            assert np.allclose(output.asnumpy().reshape(np.shape(expect)), expect, rtol=1e-4, atol=1e-4)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_reduce_sum():
+    run_reduce(P.ReduceSum, np.sum)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_reduce_mean():
+    run_reduce(P.ReduceMean, np.mean)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_reduce_max():
+    run_reduce(P.ReduceMax, np.max)
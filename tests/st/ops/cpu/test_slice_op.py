@@ -0,0 +1,56 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetSlice(nn.Cell):
+    def __init__(self, begin, size):
+        super(NetSlice, self).__init__()
+        self.slice = P.Slice()
+        self.begin = begin
+        self.size = size
+
+    def construct(self, x):
+        return self.slice(x, self.begin, self.size)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_slice():
+    np.random.seed(0)
+    x = np.random.randn(4, 6, 7, 9).astype(np.float32)
+    output = NetSlice((1, 2, 0, 3), (2, 3, 7, 5))(Tensor(x))
+    expect = x[1:3, 2:5, 0:7, 3:8]
+    assert (output.asnumpy() == expect).all()
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_slice_to_end():
+    x = np.arange(60).reshape(3, 4, 5).astype(np.float32)
+    output = NetSlice((1, 0, 2), (-1, 2, -1))(Tensor(x))
+    expect = x[1:, 0:2, 2:]
+    assert (output.asnumpy() == expect).all()
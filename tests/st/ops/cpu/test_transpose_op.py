@@ -0,0 +1,46 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target='CPU')
+
+
+class NetTranspose(nn.Cell):
+    def __init__(self, perm):
+        super(NetTranspose, self).__init__()
+        self.transpose = P.Transpose()
+        self.perm = perm
+
+    def construct(self, x):
+        return self.transpose(x, self.perm)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_transpose():
+    np.random.seed(0)
+    x = np.random.randn(2, 3, 4, 5).astype(np.float32)
+    for perm in ((0, 2, 1, 3), (0, 3, 1, 2), (3, 2, 1, 0), (0, 1, 2, 3)):
+        output = NetTranspose(perm)(Tensor(x))
+        expect = np.transpose(x, perm)
+        assert (output.asnumpy() == expect).all()
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <iostream>
+#include <numeric>
 #include <vector>
 #include "common/common_test.h"
 #include "common/trans.h"
@@ -106,6 +109,109 @@ TEST_F(FormatTransTest, nhwc_to_nchw) {
     EXPECT_EQ((reinterpret_cast<uint16_t *>(trans_tmp.data()))[i], res[i]);
   }
 }
+namespace {
+uint64_t Sum(const std::vector<uint16_t> &data) { return std::accumulate(data.begin(), data.end(), uint64_t(0)); }
+
+// host -> device -> host, the padding of the device data should be zeros
+void CheckRoundTrip(const std::vector<size_t> &host_shape, const std::string &format) {
+  auto device_shape = TransShapeToDevice(host_shape, format);
+  std::vector<uint16_t> host(ShapeSize(host_shape));
+  for (size_t i = 0; i < host.size(); i++) {
+    host[i] = static_cast<uint16_t>(i % 1021 + 1);
+  }
+  std::vector<uint16_t> device(ShapeSize(device_shape), 0);
+  size_t device_size = device.size() * sizeof(uint16_t);
+  FormatArgs to_device{host.data(), device_size, kOpFormat_NCHW, format, host_shape, device_shape, kNumberTypeFloat16};
+  ASSERT_TRUE(TransFormat(to_device, device.data()));
+  ASSERT_EQ(Sum(device), Sum(host));
+  std::vector<uint16_t> result(host.size(), 0);
+  FormatArgs to_host{device.data(), device_size, kOpFormat_NCHW, format, host_shape, device_shape, kNumberTypeFloat16};
+  ASSERT_TRUE(TransFormatFromDeviceToHost(to_host, result.data()));
+  ASSERT_EQ(result, host);
+}
+}  // namespace
+
+TEST_F(FormatTransTest, round_trip) {
+  std::vector<std::vector<size_t>> shapes = {{1, 1, 1, 1}, {3, 5, 2, 3}, {17, 33, 3, 3}, {256, 512, 3, 3}};
+  for (auto &shape : shapes) {
+    for (auto format : {kOpFormat_NC1HWC0, kOpFormat_FRAC_Z}) {
+      CheckRoundTrip(shape, format);
+    }
+  }
+  CheckRoundTrip({33, 17}, kOpFormat_FRAC_NZ);
+  CheckRoundTrip({768, 3072}, kOpFormat_FRAC_NZ);
+}
+
+namespace {
+// every element is checked at its nhwc / hwcn position, in both directions
+void CheckLayout4D(const std::vector<size_t> &host_shape, const std::string &format) {
+  size_t n = host_shape[0];
+  size_t c = host_shape[1];
+  size_t h = host_shape[2];
+  size_t w = host_shape[3];
+  std::vector<uint16_t> host(ShapeSize(host_shape));
+  for (size_t i = 0; i < host.size(); i++) {
+    host[i] = static_cast<uint16_t>(i % 65521);
+  }
+  auto device_shape = TransShapeToDevice(host_shape, format);
+  std::vector<uint16_t> device(host.size(), 0);
+  size_t device_size = device.size() * sizeof(uint16_t);
+  FormatArgs to_device{host.data(), device_size, kOpFormat_NCHW, format, host_shape, device_shape, kNumberTypeFloat16};
+  ASSERT_TRUE(TransFormat(to_device, device.data()));
+  std::vector<uint16_t> expect(host.size(), 0);
+  for (size_t ni = 0; ni < n; ni++) {
+    for (size_t ci = 0; ci < c; ci++) {
+      for (size_t hi = 0; hi < h; hi++) {
+        for (size_t wi = 0; wi < w; wi++) {
+          size_t device_idx = format == kOpFormat_NHWC ? ((ni * h + hi) * w + wi) * c + ci
+                                                        : ((hi * w + wi) * c + ci) * n + ni;
+          expect[device_idx] = host[((ni * c + ci) * h + hi) * w + wi];
+        }
+      }
+    }
+  }
+  ASSERT_EQ(device, expect);
+  std::vector<uint16_t> result(host.size(), 0);
+  FormatArgs to_host{expect.data(), device_size, kOpFormat_NCHW, format, host_shape, device_shape, kNumberTypeFloat16};
+  ASSERT_TRUE(TransFormatFromDeviceToHost(to_host, result.data()));
+  ASSERT_EQ(result, host);
+}
+}  // namespace
+
+TEST_F(FormatTransTest, nhwc_hwcn_layout) {
+  std::vector<std::vector<size_t>> shapes = {{1, 1, 1, 1}, {3, 5, 2, 3}, {17, 33, 3, 3}, {2, 3, 40, 1}, {64, 48, 7, 7}};
+  for (auto &shape : shapes) {
+    CheckLayout4D(shape, kOpFormat_NHWC);
+    CheckLayout4D(shape, kOpFormat_HWCN);
+  }
+}
+
+// run with --gtest_also_run_disabled_tests, the shapes are weights of resnet50 and bert-base
+TEST_F(FormatTransTest, DISABLED_benchmark_weight_shapes) {
+  std::vector<std::pair<std::vector<size_t>, std::string>> weights = {
+    {{64, 3, 7, 7}, kOpFormat_FRAC_Z},         {{64, 64, 3, 3}, kOpFormat_FRAC_Z},
+    {{256, 64, 1, 1}, kOpFormat_FRAC_Z},       {{512, 512, 3, 3}, kOpFormat_FRAC_Z},
+    {{2048, 512, 1, 1}, kOpFormat_FRAC_Z},     {{32, 256, 56, 56}, kOpFormat_NC1HWC0},
+    {{32, 2048, 7, 7}, kOpFormat_NC1HWC0},     {{30522, 768}, kOpFormat_FRAC_NZ},
+    {{768, 768}, kOpFormat_FRAC_NZ},           {{768, 3072}, kOpFormat_FRAC_NZ},
+    {{3072, 768}, kOpFormat_FRAC_NZ},          {{512, 512, 3, 3}, kOpFormat_NHWC}};
+  const int repeat = 10;
+  for (auto &weight : weights) {
+    auto &host_shape = weight.first;
+    auto device_shape = TransShapeToDevice(host_shape, weight.second);
+    std::vector<uint16_t> host(ShapeSize(host_shape), 1);
+    std::vector<uint16_t> device(ShapeSize(device_shape), 0);
+    size_t device_size = device.size() * sizeof(uint16_t);
+    FormatArgs args{host.data(), device_size, kOpFormat_NCHW, weight.second, host_shape, device_shape,
+                    kNumberTypeFloat16};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++) {
+      ASSERT_TRUE(TransFormat(args, device.data()));
+    }
+    auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+    std::cout << weight.second << " " << host.size() << " elements: " << cost << " ms" << std::endl;
+  }
+}
 }  // namespace trans
 }  // namespace mindspore
 
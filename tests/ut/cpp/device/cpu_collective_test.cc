@@ -0,0 +1,262 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Eigen/Core"
+#include "common/common_test.h"
+#include "device/cpu/distribution/cpu_collective.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+class TestCPUCollective : public UT::Common {
+ public:
+  TestCPUCollective() {}
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+using RankBody = std::function<int(CPUCollective *collective, int rank, int size)>;
+
+// Run the body on every rank in its own process, a rank exits with the code returned by the body
+void RunRanks(int size, bool shm_enable, const RankBody &body) {
+  int port = 0;
+  int fd = ListenOn(0, 1, &port);
+  ASSERT_GE(fd, 0);
+  CloseFd(fd);
+
+  std::vector<pid_t> pids;
+  for (int rank = 0; rank < size; ++rank) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      auto &collective = CPUCollective::instance();
+      collective.set_shm_enable(shm_enable);
+      if (!collective.Init(rank, size, "127.0.0.1", port)) {
+        _exit(100);
+      }
+      int code = body(&collective, rank, size);
+      collective.Finalize();
+      _exit(code);
+    }
+    pids.push_back(pid);
+  }
+  for (auto pid : pids) {
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+  }
+}
+
+float Value(int rank, size_t index) { return static_cast<float>(rank + static_cast<int>(index % 7)); }
+
+// The sum and the max of the inputs of all the ranks for every count, small counts use the recursive halving on the
+// groups of 2^k ranks and large ones the ring
+int CheckAllReduce(CPUCollective *collective, int rank, int size) {
+  for (size_t count : {size_t(2), size_t(1000), size_t(1 << 20)}) {
+    std::vector<float> input(count);
+    for (size_t i = 0; i < count; ++i) {
+      input[i] = Value(rank, i);
+    }
+    std::vector<float> output(count);
+    if (!collective->AllReduce(input.data(), output.data(), count, kNumberTypeFloat32, kCollectiveSum,
+                               CPU_WORLD_GROUP)) {
+      return 1;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (output[i] != size * (size - 1) / 2.0f + size * static_cast<float>(i % 7)) {
+        return 2;
+      }
+    }
+    // in place
+    if (!collective->AllReduce(input.data(), input.data(), count, kNumberTypeFloat32, kCollectiveMax,
+                               CPU_WORLD_GROUP)) {
+      return 3;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (input[i] != Value(size - 1, i)) {
+        return 4;
+      }
+    }
+  }
+  // the float16 gradients of the compressed data parallel
+  std::vector<Eigen::half> halves(1000, Eigen::half(0.5f));
+  if (!collective->AllReduce(halves.data(), halves.data(), halves.size(), kNumberTypeFloat16, kCollectiveSum,
+                             CPU_WORLD_GROUP)) {
+    return 7;
+  }
+  for (auto value : halves) {
+    if (static_cast<float>(value) != 0.5f * size) {
+      return 8;
+    }
+  }
+  std::vector<int32_t> values = {rank + 1, 2};
+  if (!collective->AllReduce(values.data(), values.data(), values.size(), kNumberTypeInt32, kCollectiveProd,
+                             CPU_WORLD_GROUP)) {
+    return 5;
+  }
+  int32_t factorial = 1;
+  for (int i = 1; i <= size; ++i) {
+    factorial *= i;
+  }
+  return (values[0] == factorial && values[1] == (1 << size)) ? 0 : 6;
+}
+
+int CheckAllGatherReduceScatterBroadcast(CPUCollective *collective, int rank, int size) {
+  for (size_t count : {size_t(3), size_t(100000)}) {
+    std::vector<float> input(count, static_cast<float>(rank));
+    std::vector<float> gathered(count * size);
+    if (!collective->AllGather(input.data(), gathered.data(), count, kNumberTypeFloat32, CPU_WORLD_GROUP)) {
+      return 11;
+    }
+    for (size_t i = 0; i < gathered.size(); ++i) {
+      if (gathered[i] != static_cast<float>(i / count)) {
+        return 12;
+      }
+    }
+
+    // every rank reduces the segment of its own rank
+    std::vector<float> scattered(count);
+    if (!collective->ReduceScatter(gathered.data(), scattered.data(), count, kNumberTypeFloat32, kCollectiveSum,
+                                   CPU_WORLD_GROUP)) {
+      return 13;
+    }
+    for (auto value : scattered) {
+      if (value != static_cast<float>(rank * size)) {
+        return 14;
+      }
+    }
+
+    std::vector<float> broadcast(count);
+    if (!collective->Broadcast(input.data(), broadcast.data(), count, kNumberTypeFloat32, 1, CPU_WORLD_GROUP)) {
+      return 15;
+    }
+    for (auto value : broadcast) {
+      if (value != 1.0f) {
+        return 16;
+      }
+    }
+  }
+  return 0;
+}
+
+// Every rank sends to the next one and receives from the previous one at the same time, the messages are larger than
+// the ring of the shared memory. The tags of a pair are received in the other order than they are sent.
+int CheckSendRecv(CPUCollective *collective, int rank, int size) {
+  const size_t count = 1 << 20;
+  int next = (rank + 1) % size;
+  int prev = (rank + size - 1) % size;
+  std::vector<float> input(count);
+  for (size_t i = 0; i < count; ++i) {
+    input[i] = Value(rank, i);
+  }
+  std::vector<int32_t> tags = {rank, rank + 100};
+  if (!collective->Send(tags.data(), 1, kNumberTypeInt32, next, 1) ||
+      !collective->Send(input.data(), count, kNumberTypeFloat32, next, 0) ||
+      !collective->Send(tags.data() + 1, 1, kNumberTypeInt32, next, 2)) {
+    return 40;
+  }
+  std::vector<float> output(count);
+  int32_t first = -1;
+  int32_t second = -1;
+  if (!collective->Recv(&second, 1, kNumberTypeInt32, prev, 2) ||
+      !collective->Recv(output.data(), count, kNumberTypeFloat32, prev, 0) ||
+      !collective->Recv(&first, 1, kNumberTypeInt32, prev, 1)) {
+    return 41;
+  }
+  if (first != prev || second != prev + 100) {
+    return 42;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (output[i] != Value(prev, i)) {
+      return 43;
+    }
+  }
+  // the size of a receive must match its send
+  if (!collective->Send(input.data(), 2, kNumberTypeFloat32, next, 3) ||
+      collective->Recv(output.data(), 3, kNumberTypeFloat32, prev, 3)) {
+    return 44;
+  }
+  // a rank has no link to itself
+  if (collective->Send(input.data(), 1, kNumberTypeFloat32, rank, 4)) {
+    return 45;
+  }
+  // the collectives go on after the messages
+  return CheckAllReduce(collective, rank, size);
+}
+}  // namespace
+
+TEST_F(TestCPUCollective, test_AllReduceShm) {
+  RunRanks(4, true, [](CPUCollective *collective, int rank, int size) {
+    for (int peer = 0; peer < size; ++peer) {
+      if (peer != rank && collective->link_type(peer) != "shm") {
+        return 20;
+      }
+    }
+    return CheckAllReduce(collective, rank, size);
+  });
+  RunRanks(3, true, CheckAllReduce);
+}
+
+TEST_F(TestCPUCollective, test_CollectivesTcp) {
+  RunRanks(3, false, [](CPUCollective *collective, int rank, int size) {
+    if (collective->link_type((rank + 1) % size) != "tcp") {
+      return 20;
+    }
+    int code = CheckAllReduce(collective, rank, size);
+    return (code != 0) ? code : CheckAllGatherReduceScatterBroadcast(collective, rank, size);
+  });
+  RunRanks(4, true, CheckAllGatherReduceScatterBroadcast);
+}
+
+TEST_F(TestCPUCollective, test_SendRecv) {
+  RunRanks(3, true, CheckSendRecv);
+  RunRanks(2, false, CheckSendRecv);
+}
+
+TEST_F(TestCPUCollective, test_Group) {
+  RunRanks(3, true, [](CPUCollective *collective, int rank, int size) {
+    if (rank == 1) {
+      return collective->CreateGroup("0-2", {2, 0}) ? 30 : 0;
+    }
+    // the group ranks follow the order of the creation
+    unsigned int group_rank = 0;
+    unsigned int group_size = 0;
+    if (!collective->CreateGroup("0-2", {2, 0}) || !collective->GetRankId("0-2", &group_rank) ||
+        !collective->GetRankSize("0-2", &group_size) || group_size != 2 || group_rank != (rank == 2 ? 0 : 1)) {
+      return 31;
+    }
+    std::vector<float> values = {static_cast<float>(rank)};
+    if (!collective->AllReduce(values.data(), values.data(), 1, kNumberTypeFloat32, kCollectiveSum, "0-2") ||
+        values[0] != 2.0f) {
+      return 32;
+    }
+    if (collective->DestroyGroup(CPU_WORLD_GROUP) || !collective->DestroyGroup("0-2") ||
+        collective->GetRankId("0-2", &group_rank)) {
+      return 33;
+    }
+    return 0;
+  });
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
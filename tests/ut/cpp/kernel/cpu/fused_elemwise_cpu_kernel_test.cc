@@ -0,0 +1,167 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "kernel/cpu/fused_elemwise_cpu_kernel.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+class TestFusedElemwiseCPUKernel : public UT::Common {
+ public:
+  TestFusedElemwiseCPUKernel() {}
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+// A fused elemwise node of the ops and their operands, whose inputs and output have the shapes given
+CNodePtr FusedNode(const std::vector<std::string> &ops, const std::vector<int> &operands,
+                   const std::vector<std::vector<int>> &input_shapes, const std::vector<int> &output_shape) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto prim = std::make_shared<Primitive>(kFusedElemwiseOpName);
+  (void)prim->AddAttr(kAttrFusedOps, MakeValue(ops));
+  (void)prim->AddAttr(kAttrFusedOperands, MakeValue(operands));
+  std::vector<AnfNodePtr> inputs = {NewValueNode(prim)};
+  for (auto &shape : input_shapes) {
+    auto param = graph->add_parameter();
+    param->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    inputs.push_back(param);
+  }
+  auto cnode = graph->NewCNode(inputs);
+  cnode->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, output_shape));
+  return cnode;
+}
+
+AddressPtr MakeAddress(std::vector<float> *data) {
+  auto address = std::make_shared<Address>();
+  address->addr = data->data();
+  address->size = data->size() * sizeof(float);
+  return address;
+}
+
+void Launch(CPUKernel *kernel, const std::vector<std::vector<float> *> &inputs, std::vector<float> *output) {
+  std::vector<AddressPtr> input_addresses;
+  for (auto input : inputs) {
+    input_addresses.push_back(MakeAddress(input));
+  }
+  ASSERT_TRUE(kernel->Launch(input_addresses, {}, {MakeAddress(output)}));
+}
+
+float Gelu(float x) { return 0.5f * x * (1.f + std::tanh(0.7978845608f * (x + 0.044715f * x * x * x))); }
+}  // namespace
+
+// relu(x * y) * s with the scalar s
+TEST_F(TestFusedElemwiseCPUKernel, test_MulReluScale) {
+  FusedElemwiseCPUKernel kernel;
+  kernel.InitKernel(FusedNode({"Mul", "ReLU", "Mul"}, {0, 1, -1, -1, 2}, {{2, 3}, {2, 3}, {1}}, {2, 3}));
+  std::vector<float> x{1, -2, 3, -4, 5, -6};
+  std::vector<float> y{2, 2, -2, -2, 1, 0};
+  std::vector<float> s{0.5};
+  std::vector<float> output(6);
+  Launch(&kernel, {&x, &y, &s}, &output);
+  std::vector<float> expect{1, 0, 0, 4, 2.5, 0};
+  ASSERT_EQ(output, expect);
+}
+
+// relu_grad(dy * m, x) over several blocks
+TEST_F(TestFusedElemwiseCPUKernel, test_MulReluGrad) {
+  const int size = 100000;
+  FusedElemwiseCPUKernel kernel;
+  kernel.InitKernel(FusedNode({"Mul", "ReluGrad"}, {0, 1, -1, 2}, {{size}, {size}, {size}}, {size}));
+  std::vector<float> dy(size), m(size), x(size), output(size);
+  for (int i = 0; i < size; ++i) {
+    dy[i] = static_cast<float>(i % 7);
+    m[i] = 0.5f;
+    x[i] = static_cast<float>(i % 3) - 1.f;
+  }
+  Launch(&kernel, {&dy, &m, &x}, &output);
+  for (int i = 0; i < size; ++i) {
+    ASSERT_EQ(output[i], x[i] > 0 ? dy[i] * m[i] : 0.f) << "index " << i;
+  }
+}
+
+// gelu(x) * x, an input may be the operand of several ops
+TEST_F(TestFusedElemwiseCPUKernel, test_GeluMul) {
+  FusedElemwiseCPUKernel kernel;
+  kernel.InitKernel(FusedNode({"Gelu", "Mul"}, {0, -1, 0}, {{5}}, {5}));
+  std::vector<float> x{-2, -0.5, 0, 0.5, 2};
+  std::vector<float> output(5);
+  Launch(&kernel, {&x}, &output);
+  for (size_t i = 0; i < x.size(); ++i) {
+    ASSERT_NEAR(output[i], Gelu(x[i]) * x[i], 1e-5);
+  }
+}
+
+TEST_F(TestFusedElemwiseCPUKernel, test_ParseStepsInvalid) {
+  auto steps = FusedElemwiseCPUKernel::ParseSteps({"Mul", "ReLU"}, {0, 1, -1}, 2);
+  ASSERT_EQ(steps.size(), 2);
+  ASSERT_TRUE(steps[0].op == ElemwiseOp::kMul);
+  ASSERT_EQ(steps[1].operands, std::vector<int>{kChainOperand});
+  // the first op has no previous result
+  ASSERT_ANY_THROW(FusedElemwiseCPUKernel::ParseSteps({"ReLU"}, {-1}, 1));
+  // an input out of range, an operand missing or left over, an op not supported
+  ASSERT_ANY_THROW(FusedElemwiseCPUKernel::ParseSteps({"ReLU"}, {1}, 1));
+  ASSERT_ANY_THROW(FusedElemwiseCPUKernel::ParseSteps({"Mul"}, {0}, 1));
+  ASSERT_ANY_THROW(FusedElemwiseCPUKernel::ParseSteps({"ReLU"}, {0, 0}, 1));
+  ASSERT_ANY_THROW(FusedElemwiseCPUKernel::ParseSteps({"Tanh"}, {0}, 1));
+  // a scalar is only broadcast to a mul
+  FusedElemwiseCPUKernel kernel;
+  ASSERT_ANY_THROW(kernel.InitKernel(FusedNode({"ReluGrad", "ReLU"}, {0, 1, -1}, {{4}, {1}}, {4})));
+}
+
+// The time of mul, relu, mul by a scalar and gelu on 16M elements, fused into one pass or run as four kernels
+TEST_F(TestFusedElemwiseCPUKernel, DISABLED_benchmark_FusedChain) {
+  const int size = 16 << 20;
+  const int repeat = 20;
+  std::vector<float> x(size, 0.5f), y(size, -1.5f), s{2.f}, output(size), temp(size);
+  auto measure_ms = [repeat](const std::function<void()> &run) {
+    run();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+      run();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeat;
+  };
+  FusedElemwiseCPUKernel fused;
+  fused.InitKernel(FusedNode({"Mul", "ReLU", "Mul", "Gelu"}, {0, 1, -1, -1, 2, -1}, {{size}, {size}, {1}}, {size}));
+  double fused_ms = measure_ms([&]() { Launch(&fused, {&x, &y, &s}, &output); });
+
+  FusedElemwiseCPUKernel mul, relu, scale, gelu;
+  mul.InitKernel(FusedNode({"Mul"}, {0, 1}, {{size}, {size}}, {size}));
+  relu.InitKernel(FusedNode({"ReLU"}, {0}, {{size}}, {size}));
+  scale.InitKernel(FusedNode({"Mul"}, {0, 1}, {{size}, {1}}, {size}));
+  gelu.InitKernel(FusedNode({"Gelu"}, {0}, {{size}}, {size}));
+  double unfused_ms = measure_ms([&]() {
+    Launch(&mul, {&x, &y}, &temp);
+    Launch(&relu, {&temp}, &output);
+    Launch(&scale, {&output, &s}, &temp);
+    Launch(&gelu, {&temp}, &output);
+  });
+  std::cout << "4 elemwise ops on " << size << " elements: fused " << fused_ms << " ms, unfused " << unfused_ms
+            << " ms, speedup " << unfused_ms / fused_ms << std::endl;
+}
+}  // namespace kernel
+}  // namespace mindspore
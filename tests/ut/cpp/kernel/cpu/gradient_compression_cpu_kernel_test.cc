@@ -0,0 +1,220 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "kernel/cpu/gradient_compression_cpu_kernel.h"
+#include "pipeline/static_analysis/abstract_value.h"
+
+namespace mindspore {
+namespace kernel {
+class TestGradientCompressionCPUKernel : public UT::Common {
+ public:
+  TestGradientCompressionCPUKernel() {}
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+using Attrs = std::vector<std::pair<std::string, ValuePtr>>;
+
+// A float32 kernel node of the primitive, whose inputs and output have the shapes given
+CNodePtr KernelNode(const std::string &name, const std::vector<std::vector<int>> &input_shapes,
+                    const std::vector<int> &output_shape, const Attrs &attrs) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto prim = std::make_shared<Primitive>(name);
+  for (auto &attr : attrs) {
+    (void)prim->AddAttr(attr.first, attr.second);
+  }
+  std::vector<AnfNodePtr> inputs = {NewValueNode(prim)};
+  for (auto &shape : input_shapes) {
+    auto param = graph->add_parameter();
+    param->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    inputs.push_back(param);
+  }
+  auto cnode = graph->NewCNode(inputs);
+  cnode->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, output_shape));
+  return cnode;
+}
+
+AddressPtr MakeAddress(std::vector<float> *data) {
+  auto address = std::make_shared<Address>();
+  address->addr = data->data();
+  address->size = data->size() * sizeof(float);
+  return address;
+}
+
+void Launch(CPUKernel *kernel, const std::vector<std::vector<float> *> &inputs, std::vector<float> *output) {
+  std::vector<AddressPtr> input_addresses;
+  for (auto input : inputs) {
+    input_addresses.push_back(MakeAddress(input));
+  }
+  ASSERT_TRUE(kernel->Launch(input_addresses, {}, {MakeAddress(output)}));
+}
+
+// The index -> value of the k values followed by their k indices
+std::map<uint32_t, float> DecodeTopK(const std::vector<float> &output) {
+  size_t k = output.size() / 2;
+  std::map<uint32_t, float> result;
+  for (size_t i = 0; i < k; ++i) {
+    uint32_t index = 0;
+    (void)memcpy(&index, &output[k + i], sizeof(index));
+    result[index] = output[i];
+  }
+  return result;
+}
+
+float Dot(const std::vector<float> &matrix, size_t rows, size_t cols, size_t a, size_t b) {
+  float sum = 0.0f;
+  for (size_t i = 0; i < rows; ++i) {
+    sum += matrix[i * cols + a] * matrix[i * cols + b];
+  }
+  return sum;
+}
+}  // namespace
+
+// The elements left by a step are added to the gradient of the next one, and are sent once they are large enough
+TEST_F(TestGradientCompressionCPUKernel, test_TopKErrorFeedback) {
+  TopKCompressCPUKernel compress;
+  compress.InitKernel(KernelNode("_TopKCompress", {{6}}, {4}, {{"key", MakeValue("topk_feedback")}}));
+  std::vector<float> gradient = {0.1, -5.0, 0.2, 3.0, -0.3, 0.4};
+  std::vector<float> output(4);
+  Launch(&compress, {&gradient}, &output);
+  auto top = DecodeTopK(output);
+  ASSERT_EQ(top.size(), 2);
+  ASSERT_FLOAT_EQ(top[1], -5.0);
+  ASSERT_FLOAT_EQ(top[3], 3.0);
+
+  // 0.4 is left from the first step, so the index 5 is sent rather than the index 2 of this gradient alone
+  gradient = {0.1, 0.1, 0.2, 0.1, -0.3, 0.1};
+  Launch(&compress, {&gradient}, &output);
+  top = DecodeTopK(output);
+  ASSERT_EQ(top.size(), 2);
+  ASSERT_FLOAT_EQ(top[4], -0.6);
+  ASSERT_FLOAT_EQ(top[5], 0.5);
+
+  auto state = GradientCompressionStore::GetInstance().GetState("topk_feedback", 6);
+  std::vector<float> residual = {0.2, 0.1, 0.4, 0.1, 0.0, 0.0};
+  for (size_t i = 0; i < residual.size(); ++i) {
+    ASSERT_FLOAT_EQ(state->residual[i], residual[i]);
+  }
+}
+
+// The values and the indices in the float32 bits of all the devices are summed back into the dense gradient
+TEST_F(TestGradientCompressionCPUKernel, test_TopKRoundTrip) {
+  std::vector<std::vector<float>> gradients = {{1.0, 0.0, 0.0, -4.0, 0.0, 2.0}, {0.0, 3.0, 0.0, 0.0, 0.0, -1.0}};
+  std::vector<float> gathered;
+  for (size_t dev = 0; dev < gradients.size(); ++dev) {
+    TopKCompressCPUKernel compress;
+    auto key = "topk_dev" + std::to_string(dev);
+    compress.InitKernel(KernelNode("_TopKCompress", {{6}}, {4}, {{"key", MakeValue(key)}}));
+    std::vector<float> output(4);
+    Launch(&compress, {&gradients[dev]}, &output);
+    gathered.insert(gathered.end(), output.begin(), output.end());
+  }
+
+  TopKDecompressCPUKernel decompress;
+  decompress.InitKernel(KernelNode("_TopKDecompress", {{8}, {6}}, {6}, {{"dev_num", MakeValue(2)}}));
+  std::vector<float> x(6);
+  std::vector<float> gradient(6, 7.0);
+  Launch(&decompress, {&gathered, &x}, &gradient);
+  ASSERT_EQ(gradient, std::vector<float>({0.0, 3.0, 0.0, -4.0, 0.0, 1.0}));
+
+  // an index out of the gradient is rejected
+  uint32_t index = 6;
+  (void)memcpy(&gathered[2], &index, sizeof(index));
+  ASSERT_ANY_THROW(decompress.Launch({MakeAddress(&gathered), MakeAddress(&x)}, {}, {MakeAddress(&gradient)}));
+}
+
+// The columns of P are orthonormal after the compression of Q, and a dependent column is dropped
+TEST_F(TestGradientCompressionCPUKernel, test_PowerSGDOrthogonalize) {
+  const size_t rows = 4;
+  const size_t cols = 2;
+  const size_t rank = 3;
+  auto state = GradientCompressionStore::GetInstance().GetState("powersgd_orthogonalize", rows * cols);
+  state->residual = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+
+  PowerSGDCPUKernel compress_q;
+  compress_q.InitKernel(KernelNode("_PowerSGDCompressQ", {{4, 3}, {4, 2}}, {2, 3},
+                                   {{"key", MakeValue("powersgd_orthogonalize")}, {"rank", MakeValue(3)}}));
+  // the third column is the sum of the first two
+  std::vector<float> p = {1.0, 1.0, 2.0, 1.0, 0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 0.0, 0.0};
+  std::vector<float> x(rows * cols);
+  std::vector<float> q(cols * rank);
+  Launch(&compress_q, {&p, &x}, &q);
+
+  auto &p_hat = state->p;
+  ASSERT_EQ(p_hat.size(), rows * rank);
+  ASSERT_NEAR(Dot(p_hat, rows, rank, 0, 0), 1.0, 1e-5);
+  ASSERT_NEAR(Dot(p_hat, rows, rank, 1, 1), 1.0, 1e-5);
+  ASSERT_NEAR(Dot(p_hat, rows, rank, 0, 1), 0.0, 1e-5);
+  ASSERT_FLOAT_EQ(Dot(p_hat, rows, rank, 2, 2), 0.0);
+  // Q = M^T * orth(P)
+  for (size_t j = 0; j < cols; ++j) {
+    for (size_t r = 0; r < rank; ++r) {
+      float expected = 0.0f;
+      for (size_t i = 0; i < rows; ++i) {
+        expected += state->residual[i * cols + j] * p_hat[i * rank + r];
+      }
+      ASSERT_NEAR(q[j * rank + r], expected, 1e-5);
+    }
+  }
+}
+
+// A gradient of rank 1 is restored exactly with no residual, and the Q it leaves starts the next step
+TEST_F(TestGradientCompressionCPUKernel, test_PowerSGDQUpdate) {
+  const std::string key = "powersgd_q_update";
+  Attrs attrs = {{"key", MakeValue(key)}, {"rank", MakeValue(1)}};
+  PowerSGDCPUKernel compress_p;
+  compress_p.InitKernel(KernelNode("_PowerSGDCompressP", {{2, 2}}, {2, 1}, attrs));
+  PowerSGDCPUKernel compress_q;
+  compress_q.InitKernel(KernelNode("_PowerSGDCompressQ", {{2, 1}, {2, 2}}, {2, 1}, attrs));
+  attrs.push_back({"dev_num", MakeValue(1)});
+  PowerSGDCPUKernel decompress;
+  decompress.InitKernel(KernelNode("_PowerSGDDecompress", {{2, 1}, {2, 2}}, {2, 2}, attrs));
+
+  // (1, 2)^T * (3, 4)
+  std::vector<float> m = {3.0, 4.0, 6.0, 8.0};
+  std::vector<float> p(2);
+  std::vector<float> q(2);
+  std::vector<float> gradient(4);
+  Launch(&compress_p, {&m}, &p);
+  Launch(&compress_q, {&p, &m}, &q);
+  Launch(&decompress, {&q, &m}, &gradient);
+  auto state = GradientCompressionStore::GetInstance().GetState(key, 4);
+  for (size_t i = 0; i < m.size(); ++i) {
+    ASSERT_NEAR(gradient[i], m[i], 1e-4);
+    ASSERT_NEAR(state->residual[i], 0.0, 1e-4);
+  }
+  ASSERT_EQ(state->q, q);
+
+  // the next step projects on the Q of the last one
+  std::vector<float> last_q = state->q;
+  std::vector<float> residual = state->residual;
+  Launch(&compress_p, {&m}, &p);
+  for (size_t i = 0; i < 2; ++i) {
+    float expected = (residual[i * 2] + m[i * 2]) * last_q[0] + (residual[i * 2 + 1] + m[i * 2 + 1]) * last_q[1];
+    ASSERT_NEAR(p[i], expected, 1e-4);
+  }
+}
+}  // namespace kernel
+}  // namespace mindspore
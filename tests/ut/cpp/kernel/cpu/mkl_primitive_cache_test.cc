@@ -0,0 +1,131 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include "common/common_test.h"
+#include "kernel/cpu/mkldnn/mkl_primitive_cache.h"
+
+namespace mindspore {
+namespace kernel {
+class TestMKLPrimitiveCache : public UT::Common {
+ public:
+  TestMKLPrimitiveCache() {}
+  void SetUp() {
+    auto &cache = MKLPrimitiveCache::GetInstance();
+    capacity_ = cache.capacity();
+    cache.Clear();
+  }
+  void TearDown() {
+    auto &cache = MKLPrimitiveCache::GetInstance();
+    cache.Clear();
+    cache.set_capacity(capacity_);
+  }
+
+  // Get the primitive of the key from the cache, counting the primitives created
+  std::shared_ptr<dnnl::primitive> Get(const std::string &key) {
+    return MKLPrimitiveCache::GetInstance().GetOrCreate(key, [this]() {
+      ++create_count_;
+      return std::make_shared<dnnl::primitive>();
+    });
+  }
+
+  size_t create_count_{0};
+
+ private:
+  size_t capacity_{0};
+};
+
+// The primitive of a key is created once and shared by the later calls
+TEST_F(TestMKLPrimitiveCache, test_HitAndMiss) {
+  auto &cache = MKLPrimitiveCache::GetInstance();
+  cache.set_capacity(4);
+  auto a = Get("a");
+  auto b = Get("b");
+  ASSERT_NE(a, b);
+  ASSERT_EQ(Get("a"), a);
+  ASSERT_EQ(Get("a"), a);
+  ASSERT_EQ(Get("b"), b);
+  ASSERT_EQ(create_count_, 2);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.miss_count(), 2);
+  ASSERT_EQ(cache.hit_count(), 3);
+
+  // the counters start again after a clear
+  cache.Clear();
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.miss_count(), 0);
+  ASSERT_EQ(cache.hit_count(), 0);
+  ASSERT_NE(Get("a"), a);
+  ASSERT_EQ(create_count_, 3);
+}
+
+// The least recently used primitive is dropped when the cache is full, a hit makes it the most recently used
+TEST_F(TestMKLPrimitiveCache, test_LRUEviction) {
+  auto &cache = MKLPrimitiveCache::GetInstance();
+  cache.set_capacity(2);
+  auto a = Get("a");
+  auto b = Get("b");
+  ASSERT_EQ(Get("a"), a);
+  // b is the least recently used one
+  auto c = Get("c");
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(Get("a"), a);
+  ASSERT_EQ(Get("c"), c);
+  ASSERT_EQ(create_count_, 3);
+  ASSERT_NE(Get("b"), b);
+  ASSERT_EQ(create_count_, 4);
+  // a was dropped for b, as c was used after it
+  ASSERT_EQ(Get("c"), c);
+  ASSERT_NE(Get("a"), a);
+  ASSERT_EQ(create_count_, 5);
+  ASSERT_EQ(cache.size(), 2);
+}
+
+// Shrinking the capacity drops the least recently used primitives
+TEST_F(TestMKLPrimitiveCache, test_ShrinkCapacity) {
+  auto &cache = MKLPrimitiveCache::GetInstance();
+  cache.set_capacity(3);
+  auto a = Get("a");
+  (void)Get("b");
+  (void)Get("c");
+  ASSERT_EQ(Get("a"), a);
+  cache.set_capacity(1);
+  ASSERT_EQ(cache.capacity(), 1);
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_EQ(Get("a"), a);
+  ASSERT_EQ(create_count_, 3);
+  (void)Get("c");
+  ASSERT_EQ(create_count_, 4);
+}
+
+// A capacity of 0 disables the cache, every call creates its primitive and counts a miss
+TEST_F(TestMKLPrimitiveCache, test_ZeroCapacity) {
+  auto &cache = MKLPrimitiveCache::GetInstance();
+  cache.set_capacity(2);
+  (void)Get("a");
+  cache.set_capacity(0);
+  ASSERT_EQ(cache.size(), 0);
+  auto a = Get("a");
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(Get("a"), a);
+  ASSERT_EQ(create_count_, 3);
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.miss_count(), 3);
+  ASSERT_EQ(cache.hit_count(), 0);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,201 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "ir/manager.h"
+#include "operator/ops.h"
+#include "optimizer/cse.h"
+#include "optimizer/recompute.h"
+#include "pipeline/static_analysis/abstract_value.h"
+#include "pre_activate/common/optimizer.h"
+#include "pre_activate/common/pass_manager.h"
+#include "pre_activate/pass/common_subexpression_elimination.h"
+#include "pre_activate/pass/optimize_dependence.h"
+
+namespace mindspore {
+namespace opt {
+class TestRecompute : public UT::Common {
+ public:
+  TestRecompute() {}
+  void SetUp();
+  void TearDown() {}
+
+ public:
+  std::vector<RecomputeNode> nodes;
+};
+
+// a three layer forward a, b, c and the loss, then the backward g3, g2, g1 reading c, b and a
+void TestRecompute::SetUp() {
+  nodes = {
+    {100.0, 10.0, true, true, false, {}},         // a
+    {100.0, 1000.0, true, true, false, {0}},      // b
+    {100.0, 10.0, true, true, false, {1}},        // c
+    {4.0, 100.0, true, false, false, {2}},        // loss
+    {100.0, 100.0, false, false, false, {3, 2}},  // g3
+    {100.0, 100.0, false, false, false, {4, 1}},  // g2
+    {100.0, 100.0, false, false, false, {5, 0}},  // g1
+  };
+}
+
+TEST_F(TestRecompute, test_RecomputePeakMemory) {
+  // a, b, c, the loss and g3 are alive when g3 is computed
+  ASSERT_DOUBLE_EQ(RecomputePeakMemory(nodes, std::vector<bool>(nodes.size(), false)), 404.0);
+  // a is freed after b and copied for g1
+  ASSERT_DOUBLE_EQ(RecomputePeakMemory(nodes, {true, false, false, false, false, false, false}), 304.0);
+  // the copy of c is made for g3, at the peak
+  ASSERT_DOUBLE_EQ(RecomputePeakMemory(nodes, {false, false, true, false, false, false, false}), 404.0);
+  // the copies of a and b are alive with g3 and g2
+  ASSERT_DOUBLE_EQ(RecomputePeakMemory(nodes, {true, true, false, false, false, false, false}), 400.0);
+}
+
+TEST_F(TestRecompute, test_ChooseRecompute) {
+  RecomputePlan plan;
+  // without a budget only the marked nodes are recomputed
+  nodes[2].marked = true;
+  ASSERT_TRUE(ChooseRecompute(nodes, 0.0, &plan));
+  ASSERT_EQ(plan.recomputed, std::vector<size_t>({2}));
+  ASSERT_DOUBLE_EQ(plan.origin_peak_memory, 404.0);
+  ASSERT_DOUBLE_EQ(plan.peak_memory, 404.0);
+  ASSERT_DOUBLE_EQ(plan.recompute_flops, 10.0);
+  ASSERT_DOUBLE_EQ(plan.total_flops, 1420.0);
+  nodes[2].marked = false;
+
+  // a keeps the most bytes per operation and fits the budget
+  ASSERT_TRUE(ChooseRecompute(nodes, 350.0, &plan));
+  ASSERT_EQ(plan.recomputed, std::vector<size_t>({0}));
+  ASSERT_DOUBLE_EQ(plan.peak_memory, 304.0);
+  ASSERT_DOUBLE_EQ(plan.recompute_flops, 10.0);
+
+  // c and b do not lower the peak further
+  ASSERT_FALSE(ChooseRecompute(nodes, 250.0, &plan));
+  ASSERT_EQ(plan.recomputed, std::vector<size_t>({0}));
+  ASSERT_DOUBLE_EQ(plan.peak_memory, 304.0);
+
+  // nothing to do when the budget is met
+  ASSERT_TRUE(ChooseRecompute(nodes, 1000.0, &plan));
+  ASSERT_TRUE(plan.recomputed.empty());
+  ASSERT_DOUBLE_EQ(plan.recompute_flops, 0.0);
+}
+
+namespace {
+bool IsBackward(const AnfNodePtr &node) {
+  return node->scope() != nullptr && node->scope()->name().find("Gradients/") == 0;
+}
+
+// The forward a = relu(x), b = relu(a) marked to recompute and c = b * b, then the backward g2 = d * b and g1 = g2 * a.
+// d = c * c is a gradient when with_gradient is set, which the copies then wait for, else d is the forward c.
+FuncGraphPtr MakeRecomputeGraph(bool with_gradient) {
+  auto graph = std::make_shared<FuncGraph>();
+  auto forward_scope = std::make_shared<Scope>("Default/network");
+  auto backward_scope = std::make_shared<Scope>("Gradients/Default/network");
+  auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int>{16, 16});
+  auto x = graph->add_parameter();
+  x->set_abstract(abstract);
+  auto new_cnode = [&](const PrimitivePtr &op, const std::vector<AnfNodePtr> &args, bool marked, bool backward) {
+    auto prim = std::make_shared<Primitive>(*op);
+    if (marked) {
+      prim->set_attr(kAttrRecompute, MakeValue(true));
+    }
+    std::vector<AnfNodePtr> inputs{NewValueNode(prim)};
+    (void)inputs.insert(inputs.end(), args.begin(), args.end());
+    auto cnode = graph->NewCNodeWithScope(inputs, backward ? backward_scope : forward_scope);
+    cnode->set_abstract(abstract);
+    return cnode;
+  };
+  auto a = new_cnode(prim::kPrimRelu, {x}, true, false);
+  auto b = new_cnode(prim::kPrimRelu, {a}, true, false);
+  auto c = new_cnode(prim::kPrimMul, {b, b}, false, false);
+  AnfNodePtr d = with_gradient ? new_cnode(prim::kPrimMul, {c, c}, false, true) : c;
+  auto g2 = new_cnode(prim::kPrimMul, {d, b}, false, true);
+  auto g1 = new_cnode(prim::kPrimMul, {g2, a}, false, true);
+  graph->set_output(graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), c, g1}));
+  return graph;
+}
+
+// Recompute, then the frontend CSE and the backend passes that come after it
+void RunRecomputeAndBackend(const FuncGraphPtr &graph) {
+  auto manager = Manage(graph);
+  ASSERT_TRUE(Recompute(graph, manager));
+  (void)CSE().Cse(graph, manager);
+  auto optimizer = std::make_shared<GraphOptimizer>();
+  auto pm = std::make_shared<PassManager>();
+  pm->AddPass(std::make_shared<CommonSubexpressionElimination>());
+  pm->AddPass(std::make_shared<OptimizeDependence>());
+  optimizer->AddPassManager(pm);
+  (void)optimizer->Optimize(graph);
+}
+
+// The copies of the graph, after the checks that the originals feed the forward and the copies the backward only
+std::vector<CNodePtr> CheckCopies(const FuncGraphPtr &graph) {
+  auto manager = graph->manager();
+  std::vector<CNodePtr> copies;
+  for (auto &node : manager->all_nodes()) {
+    auto cnode = node->cast<CNodePtr>();
+    if (cnode == nullptr || !IsPrimitiveCNode(cnode, prim::kPrimRelu)) {
+      continue;
+    }
+    auto users = manager->node_users()[cnode];
+    for (auto &user : users) {
+      // a copy is read through a depend by the next copy
+      auto reader = user.first;
+      if (IsPrimitiveCNode(reader, prim::kPrimDepend)) {
+        auto depend_users = manager->node_users()[reader];
+        EXPECT_EQ(depend_users.size(), 1);
+        reader = depend_users.begin()->first;
+      }
+      EXPECT_EQ(IsBackward(reader) || IsRecomputeCopy(reader), IsRecomputeCopy(cnode)) << reader->DebugString();
+    }
+    if (IsRecomputeCopy(cnode)) {
+      copies.push_back(cnode);
+    }
+  }
+  return copies;
+}
+}  // namespace
+
+// Without a gradient to wait for the copies have the inputs of the originals, and CSE must keep them apart
+TEST_F(TestRecompute, test_RecomputeCopiesSurviveCSE) {
+  auto graph = MakeRecomputeGraph(false);
+  RunRecomputeAndBackend(graph);
+  auto copies = CheckCopies(graph);
+  ASSERT_EQ(copies.size(), 2);
+  for (auto &copy : copies) {
+    ASSERT_FALSE(IsPrimitiveCNode(copy->input(1), prim::kPrimDepend));
+  }
+}
+
+// The copies wait for the gradient d through a depend on their input
+TEST_F(TestRecompute, test_RecomputeCopiesWaitForGradient) {
+  auto graph = MakeRecomputeGraph(true);
+  RunRecomputeAndBackend(graph);
+  auto copies = CheckCopies(graph);
+  ASSERT_EQ(copies.size(), 2);
+  size_t depend_num = 0;
+  for (auto &copy : copies) {
+    auto input = copy->input(1);
+    if (IsPrimitiveCNode(input, prim::kPrimDepend)) {
+      auto trigger = input->cast<CNodePtr>()->input(2);
+      ASSERT_TRUE(IsBackward(trigger));
+      ++depend_num;
+    }
+  }
+  ASSERT_EQ(depend_num, 2);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common/common_test.h"
+#include "parallel/allreduce_fusion/gradient_bucket.h"
+
+namespace mindspore {
+namespace parallel {
+
+class TestGradientBucket : public UT::Common {
+ public:
+  TestGradientBucket() {}
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(TestGradientBucket, test_PlanGradientBuckets_LinkIdle) {
+  // the first bucket is reduced before the next gradient is ready, so it does not wait for it
+  std::vector<BackwardOp> ops = {{"op0", 1.0, 100.0}, {"op1", 10.0, 100.0}};
+  BucketPlan plan;
+  ASSERT_EQ(PlanGradientBuckets(ops, 1000.0, [](double bytes) { return 1.0 + bytes / 100.0; }, &plan), SUCCESS);
+  ASSERT_EQ(plan.buckets.size(), 2);
+  ASSERT_DOUBLE_EQ(plan.buckets[0].start_time, 1.0);
+  ASSERT_DOUBLE_EQ(plan.buckets[0].end_time, 3.0);
+  ASSERT_DOUBLE_EQ(plan.buckets[1].start_time, 11.0);
+  ASSERT_DOUBLE_EQ(plan.buckets[1].end_time, 13.0);
+  ASSERT_DOUBLE_EQ(plan.backward_time, 11.0);
+  ASSERT_DOUBLE_EQ(plan.allreduce_time, 4.0);
+  ASSERT_DOUBLE_EQ(plan.exposed_time, 2.0);
+  ASSERT_DOUBLE_EQ(plan.overlap_ratio, 0.5);
+}
+
+TEST_F(TestGradientBucket, test_PlanGradientBuckets_BucketBytes) {
+  // the AllReduce is too slow to start alone, the buckets are closed at the target bytes
+  std::vector<BackwardOp> ops = {{"op0", 1.0, 100.0}, {"op1", 1.0, 100.0}, {"op2", 1.0, 100.0}, {"op3", 1.0, 100.0}};
+  BucketPlan plan;
+  ASSERT_EQ(PlanGradientBuckets(ops, 200.0, [](double bytes) { return 10.0 + bytes / 100.0; }, &plan), SUCCESS);
+  ASSERT_EQ(plan.buckets.size(), 2);
+  ASSERT_EQ(plan.buckets[0].first_op, 0);
+  ASSERT_EQ(plan.buckets[0].last_op, 1);
+  ASSERT_DOUBLE_EQ(plan.buckets[0].bytes, 200.0);
+  ASSERT_DOUBLE_EQ(plan.buckets[0].ready_time, 2.0);
+  ASSERT_DOUBLE_EQ(plan.buckets[0].end_time, 14.0);
+  ASSERT_EQ(plan.buckets[1].first_op, 2);
+  ASSERT_EQ(plan.buckets[1].last_op, 3);
+  // the second AllReduce waits for the first one
+  ASSERT_DOUBLE_EQ(plan.buckets[1].start_time, 14.0);
+  ASSERT_DOUBLE_EQ(plan.buckets[1].end_time, 26.0);
+  ASSERT_DOUBLE_EQ(plan.exposed_time, 22.0);
+  ASSERT_DOUBLE_EQ(plan.overlap_ratio, 1.0 - 22.0 / 24.0);
+}
+
+TEST_F(TestGradientBucket, test_PlanGradientBuckets_NoGradient) {
+  // the operators without gradients only take their backward time
+  std::vector<BackwardOp> ops = {{"op0", 1.0, 100.0}, {"op1", 5.0, 0.0}, {"op2", 1.0, 0.0}};
+  BucketPlan plan;
+  auto allreduce_time = [](double bytes) { return 1.0 + bytes / 100.0; };
+  ASSERT_EQ(PlanGradientBuckets(ops, 0.0, allreduce_time, &plan), SUCCESS);
+  ASSERT_EQ(plan.buckets.size(), 1);
+  ASSERT_DOUBLE_EQ(plan.backward_time, 7.0);
+  ASSERT_DOUBLE_EQ(plan.exposed_time, 0.0);
+  ASSERT_DOUBLE_EQ(plan.overlap_ratio, 1.0);
+
+  ASSERT_EQ(PlanGradientBuckets({}, 0.0, allreduce_time, &plan), SUCCESS);
+  ASSERT_EQ(plan.buckets.size(), 0);
+  ASSERT_EQ(PlanGradientBuckets({{"op0", -1.0, 100.0}}, 0.0, allreduce_time, &plan), FAILED);
+}
+
+TEST_F(TestGradientBucket, test_LoadBackwardTimeProfile) {
+  std::string file = "./backward_profile_test.json";
+  std::ofstream(file) << "{\"Default/network/fc1/MatMul-op1\": 12.5, \"MatMulInfo00\": 3}";
+  std::unordered_map<std::string, double> profile;
+  ASSERT_EQ(LoadBackwardTimeProfile(file, &profile), SUCCESS);
+  ASSERT_EQ(profile.size(), 2);
+  ASSERT_DOUBLE_EQ(profile["Default/network/fc1/MatMul-op1"], 12.5);
+  ASSERT_DOUBLE_EQ(profile["MatMulInfo00"], 3.0);
+
+  std::ofstream(file) << "{\"MatMulInfo00\": -3}";
+  ASSERT_EQ(LoadBackwardTimeProfile(file, &profile), FAILED);
+  (void)remove(file.c_str());
+  ASSERT_EQ(LoadBackwardTimeProfile("./backward_profile_not_exist.json", &profile), FAILED);
+}
+}  // namespace parallel
+}  // namespace mindspore
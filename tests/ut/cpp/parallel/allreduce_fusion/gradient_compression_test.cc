@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "parallel/allreduce_fusion/gradient_compression.h"
+
+namespace mindspore {
+namespace parallel {
+
+class TestGradientCompression : public UT::Common {
+ public:
+  TestGradientCompression() {}
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+double AllreduceTime(double bytes) { return 10.0 + bytes / 100.0; }
+}  // namespace
+
+TEST_F(TestGradientCompression, test_GetGradientCompression) {
+  GradientCompression method = kCompressionNone;
+  ASSERT_TRUE(GetGradientCompression("powersgd", &method));
+  ASSERT_EQ(method, kCompressionPowerSGD);
+  ASSERT_EQ(GradientCompressionName(method), "powersgd");
+  ASSERT_FALSE(GetGradientCompression("bf16", &method));
+  ASSERT_EQ(method, kCompressionPowerSGD);
+}
+
+TEST_F(TestGradientCompression, test_TopKCount) {
+  ASSERT_EQ(TopKCount(1000, 0.01), 10);
+  ASSERT_EQ(TopKCount(1001, 0.01), 11);
+  ASSERT_EQ(TopKCount(10, 0.01), 1);
+  ASSERT_EQ(TopKCount(0, 0.01), 0);
+}
+
+TEST_F(TestGradientCompression, test_CompressedAllreduceTime) {
+  GradientCompressionConfig config = {kCompressionTopK, 0.01, 4, 0.0};
+  std::vector<int32_t> shape = {100, 100};
+  ASSERT_DOUBLE_EQ(CompressedAllreduceTime(config, kCompressionNone, shape, 4, 8, AllreduceTime), 410.0);
+  // the float16 sum and the AllReduce of the largest magnitude
+  ASSERT_DOUBLE_EQ(CompressedAllreduceTime(config, kCompressionFp16, shape, 4, 8, AllreduceTime), 220.04);
+  // 8 devices gather 100 values and 100 indices each
+  ASSERT_DOUBLE_EQ(CompressedAllreduceTime(config, kCompressionTopK, shape, 4, 8, AllreduceTime), 42.0);
+  // two AllReduces of 100 x 4 floats
+  ASSERT_DOUBLE_EQ(CompressedAllreduceTime(config, kCompressionPowerSGD, shape, 4, 8, AllreduceTime), 52.0);
+  // the computation is counted
+  config.element_time = 0.001;
+  ASSERT_DOUBLE_EQ(CompressedAllreduceTime(config, kCompressionFp16, shape, 4, 8, AllreduceTime), 260.04);
+  // the float16 gradients, the vectors and the small matrices are not compressed
+  ASSERT_LT(CompressedAllreduceTime(config, kCompressionFp16, shape, 2, 8, AllreduceTime), 0.0);
+  ASSERT_LT(CompressedAllreduceTime(config, kCompressionPowerSGD, {10000}, 4, 8, AllreduceTime), 0.0);
+  ASSERT_LT(CompressedAllreduceTime(config, kCompressionPowerSGD, {4, 100}, 4, 8, AllreduceTime), 0.0);
+}
+
+TEST_F(TestGradientCompression, test_ChooseGradientCompression) {
+  GradientCompressionConfig config = {kCompressionPowerSGD, 0.01, 4, 0.0};
+  ASSERT_EQ(ChooseGradientCompression(config, {100, 100}, 4, 8, AllreduceTime), kCompressionPowerSGD);
+  // the factors of a small gradient are not smaller than itself
+  ASSERT_EQ(ChooseGradientCompression(config, {8, 8}, 4, 8, AllreduceTime), kCompressionNone);
+  // nothing to reduce on one device
+  ASSERT_EQ(ChooseGradientCompression(config, {100, 100}, 4, 1, AllreduceTime), kCompressionNone);
+  config.method = kCompressionTopK;
+  ASSERT_EQ(ChooseGradientCompression(config, {100, 100}, 4, 8, AllreduceTime), kCompressionTopK);
+  // gathering from many devices costs more than reducing
+  ASSERT_EQ(ChooseGradientCompression(config, {100, 100}, 4, 1024, AllreduceTime), kCompressionNone);
+  ASSERT_DOUBLE_EQ(FusedGradientBytes(kCompressionTopK, 400.0), 0.0);
+  ASSERT_DOUBLE_EQ(FusedGradientBytes(kCompressionFp16, 400.0), 200.0);
+  ASSERT_DOUBLE_EQ(FusedGradientBytes(kCompressionNone, 400.0), 400.0);
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/common_test.h"
+#include "parallel/auto_parallel/cost_profile.h"
+
+namespace mindspore {
+namespace parallel {
+
+class TestCostProfile : public UT::Common {
+ public:
+  TestCostProfile() {}
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(TestCostProfile, test_ThroughputCurve) {
+  ThroughputCurve curve({{2000.0, 20.0}, {1000.0, 10.0}, {4000.0, 30.0}});
+  ASSERT_DOUBLE_EQ(curve.Time(0.0), 0.0);
+  // below the smallest size, the latency
+  ASSERT_DOUBLE_EQ(curve.Time(500.0), 10.0);
+  ASSERT_DOUBLE_EQ(curve.Time(1500.0), 15.0);
+  ASSERT_DOUBLE_EQ(curve.Time(3000.0), 25.0);
+  // above the largest size, the throughput of the last segment
+  ASSERT_DOUBLE_EQ(curve.Time(8000.0), 50.0);
+}
+
+TEST_F(TestCostProfile, test_SaveAndLoad) {
+  CostProfile profile;
+  profile.set_computation_curve(DEFAULT_COMPUTATION_CURVE, ThroughputCurve({{1000.0, 1.0}, {2000.0, 2.0}}));
+  profile.set_computation_curve("MatMulCost", ThroughputCurve({{1000.0, 5.0}, {2000.0, 10.0}}));
+  profile.set_rank_num(8);
+  profile.set_communication_curve(ALLREDUCE_COMMUNICATION_CURVE, 8, ThroughputCurve({{1000.0, 3.0}, {2000.0, 4.0}}));
+  profile.set_communication_curve(ALLGATHER_COMMUNICATION_CURVE, 8, ThroughputCurve({{1000.0, 2.0}, {2000.0, 3.0}}));
+  std::string file = "./cost_profile_test.json";
+  ASSERT_EQ(profile.Save(file), SUCCESS);
+
+  CostProfile loaded;
+  ASSERT_EQ(loaded.Load(file), SUCCESS);
+  ASSERT_EQ(loaded.rank_num(), 8);
+  ASSERT_DOUBLE_EQ(loaded.ComputationTime("MatMulCost", 1500.0), 7.5);
+  // the cost models without a curve use the default one
+  ASSERT_DOUBLE_EQ(loaded.ComputationTime("ActivationCost", 1500.0), 1.5);
+  ASSERT_DOUBLE_EQ(loaded.CommunicationTime(ALLREDUCE_COMMUNICATION_CURVE, 1500.0), 3.5);
+  ASSERT_DOUBLE_EQ(loaded.CommunicationTime(ALLGATHER_COMMUNICATION_CURVE, 2000.0, 8), 3.0);
+  (void)remove(file.c_str());
+
+  CostProfile missing;
+  ASSERT_NE(missing.Load("./cost_profile_not_exist.json"), SUCCESS);
+}
+
+// The time on a group size without a curve is scaled from the nearest measured one by the steps of the ring
+TEST_F(TestCostProfile, test_CommunicationGroupSize) {
+  CostProfile profile;
+  profile.set_rank_num(8);
+  profile.set_communication_curve(ALLREDUCE_COMMUNICATION_CURVE, 4, ThroughputCurve({{1000.0, 10.0}, {2000.0, 16.0}}));
+  ASSERT_DOUBLE_EQ(profile.CommunicationTime(ALLREDUCE_COMMUNICATION_CURVE, 2000.0, 4), 16.0);
+  // 7 steps instead of 3, each of them moving an eighth of the bytes instead of a quarter
+  ASSERT_NEAR(profile.CommunicationTime(ALLREDUCE_COMMUNICATION_CURVE, 2000.0, 8), 10.0 * 7 / 3 + 6.0 * 7 / 6, 1e-9);
+  // the group size 0 is all the ranks
+  ASSERT_DOUBLE_EQ(profile.CommunicationTime(ALLREDUCE_COMMUNICATION_CURVE, 2000.0, 0),
+                   profile.CommunicationTime(ALLREDUCE_COMMUNICATION_CURVE, 2000.0, 8));
+  // nothing is communicated within a single device
+  ASSERT_DOUBLE_EQ(profile.CommunicationTime(ALLREDUCE_COMMUNICATION_CURVE, 2000.0, 1), 0.0);
+  ASSERT_ANY_THROW(profile.set_communication_curve(ALLGATHER_COMMUNICATION_CURVE, 1, ThroughputCurve({{1000.0, 1.0}})));
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -21,6 +21,7 @@
 #include "parallel/ops_info/activation_info.h"
 #include "parallel/ops_info/tmp_identity_info.h"
 #include "parallel/auto_parallel/dp_algo_costmodel.h"
+#include "parallel/step_auto_parallel.h"
 
 namespace mindspore {
 namespace parallel {
@@ -1249,6 +1250,83 @@ void TestDPAlgo::ConstructIdentityDiamondGraph() {
   cost_graph->AddEdge(mm2_ptr, mm3_ptr, edge_m2_m3);
 }
 
+// A cost graph of MatMuls with a diamond in it, whose strategies and edge costs are computed on thread_num threads
+CostGraphPtr ConstructSearchGraph(size_t thread_num) {
+  struct MatMulDef {
+    Shapes inputs_shape;
+    Shape output_shape;
+    bool transpose_b;
+  };
+  std::vector<MatMulDef> matmul_defs = {{{{128, 1024}, {1024, 4096}}, {128, 4096}, false},
+                                        {{{128, 4096}, {4096, 1024}}, {128, 1024}, false},
+                                        {{{128, 4096}, {4096, 4096}}, {128, 4096}, false},
+                                        {{{128, 1024}, {1024, 4096}}, {128, 4096}, false},
+                                        {{{128, 4096}, {128, 4096}}, {128, 128}, true},
+                                        {{{128, 128}, {128, 1024}}, {128, 1024}, false}};
+  // the previous operator, the next operator and the input index of the next operator
+  std::vector<std::vector<size_t>> edge_defs = {{0, 1, 0}, {0, 2, 0}, {1, 3, 0}, {2, 4, 0}, {3, 4, 1}, {4, 5, 0}};
+
+  auto graph = std::make_shared<CostGraph>();
+  graph->SetDeviceMemoryAndCostParameter();
+  std::vector<OperatorInfoPtr> operators;
+  for (size_t i = 0; i < matmul_defs.size(); ++i) {
+    auto &def = matmul_defs[i];
+    std::unordered_map<std::string, ValuePtr> attr = {{"transpose_a", MakeValue(false)},
+                                                      {"transpose_b", MakeValue(def.transpose_b)}};
+    auto matmul = std::make_shared<MatMulInfo>("matmul_info", def.inputs_shape, Shapes{def.output_shape}, attr);
+    matmul->set_name("MatMul" + std::to_string(i));
+    matmul->set_outputs_type({kFloat32});
+    operators.push_back(matmul);
+  }
+  if (GenerateStrategiesForOperators(operators, thread_num) != SUCCESS) {
+    return nullptr;
+  }
+  for (auto &op : operators) {
+    graph->AddOperator(op);
+  }
+
+  std::vector<EdgePtr> edges;
+  for (auto &def : edge_defs) {
+    edges.push_back(std::make_shared<Edge>("MatMul-MatMul", operators[def[0]], operators[def[1]], 0, def[2], false));
+  }
+  InitEdgeCosts(edges, thread_num);
+  for (size_t i = 0; i < edges.size(); ++i) {
+    auto &prev_op = operators[edge_defs[i][0]];
+    auto &next_op = operators[edge_defs[i][1]];
+    prev_op->AddSuccEdge(edges[i]);
+    next_op->AddPrevEdge(edges[i]);
+    graph->AddEdge(prev_op, next_op, edges[i]);
+  }
+  return graph;
+}
+
+TEST_F(TestDPAlgo, test_SerialAndParallelSearchSelectSameStrategies) {
+  auto &redis_cost_cache = RedistributionCostCache::GetInstance();
+  redis_cost_cache.Clear();
+  auto serial_graph = ConstructSearchGraph(1);
+  redis_cost_cache.Clear();
+  auto parallel_graph = ConstructSearchGraph(4);
+  redis_cost_cache.Clear();
+  ASSERT_NE(serial_graph, nullptr);
+  ASSERT_NE(parallel_graph, nullptr);
+  ASSERT_EQ(GetStrategy(serial_graph), SUCCESS);
+  ASSERT_EQ(GetStrategy(parallel_graph), SUCCESS);
+
+  auto serial_ops = serial_graph->GetOperators();
+  auto parallel_ops = parallel_graph->GetOperators();
+  ASSERT_EQ(serial_ops.size(), parallel_ops.size());
+  for (size_t i = 0; i < serial_ops.size(); ++i) {
+    ASSERT_EQ(serial_ops[i]->name(), parallel_ops[i]->name());
+    ASSERT_EQ(serial_ops[i]->GetStrategyCost().size(), parallel_ops[i]->GetStrategyCost().size());
+    auto serial_strategy = serial_ops[i]->selected_strategy();
+    auto parallel_strategy = parallel_ops[i]->selected_strategy();
+    ASSERT_NE(serial_strategy, nullptr);
+    ASSERT_NE(parallel_strategy, nullptr);
+    ASSERT_EQ(serial_strategy->GetInputStage(), parallel_strategy->GetInputStage());
+    ASSERT_EQ(serial_strategy->GetInputDim(), parallel_strategy->GetInputDim());
+  }
+}
+
 TEST_F(TestDPAlgo, test_ConstructTwoLargeMatMul) {
   ConstructTwoLargeMatMul();
   ASSERT_EQ(GetStrategy(cost_graph), SUCCESS);
@@ -114,6 +114,43 @@ TEST_F(TestEdgeCostModel, test_InitEdgeCost) {
   ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
 }
 
+TEST_F(TestEdgeCostModel, test_RedistributionCostCache) {
+  auto &cache = RedistributionCostCache::GetInstance();
+  cache.Clear();
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  std::shared_ptr<Edge> edge_m4_m2 = std::make_shared<Edge>(edge_name, matmul4, matmul2, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  matmul4->GenerateStrategies(0);
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  size_t cache_size = cache.size();
+  ASSERT_GT(cache_size, 0);
+  ASSERT_EQ(cache.hit_count() + cache.miss_count(),
+            matmul1->GetStrategyCost().size() * matmul2->GetStrategyCost().size());
+  // matmul4 is the same as matmul1, so all the redistribution costs of the second edge are found in the cache
+  size_t hit_count = cache.hit_count();
+  ASSERT_EQ(edge_m4_m2->InitEdgeCost(), SUCCESS);
+  ASSERT_EQ(cache.size(), cache_size);
+  ASSERT_EQ(cache.hit_count(), hit_count + matmul4->GetStrategyCost().size() * matmul2->GetStrategyCost().size());
+  auto outputs_1 = edge_m1_m2->prev_op_output();
+  auto outputs_4 = edge_m4_m2->prev_op_output();
+  auto inputs = edge_m1_m2->next_op_input();
+  ASSERT_EQ(outputs_1.size(), outputs_4.size());
+  for (size_t i = 0; i < outputs_1.size(); ++i) {
+    for (auto &input : inputs) {
+      auto cost_1 = edge_m1_m2->GetCostList(outputs_1[i].first, input.first);
+      auto cost_4 = edge_m4_m2->GetCostList(outputs_4[i].first, input.first);
+      ASSERT_EQ(cost_1.size(), 1);
+      ASSERT_EQ(cost_4.size(), 1);
+      ASSERT_EQ(cost_1[0]->communication_cost_, cost_4[0]->communication_cost_);
+      ASSERT_EQ(cost_1[0]->computation_cost_, cost_4[0]->computation_cost_);
+      ASSERT_EQ(cost_1[0]->memory_with_reuse_, cost_4[0]->memory_with_reuse_);
+    }
+  }
+  cache.Clear();
+}
+
 TEST_F(TestEdgeCostModel, test_OpEliminationSetNewCost) {
   std::string edge_name = "MatMul-MatMul";
   std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
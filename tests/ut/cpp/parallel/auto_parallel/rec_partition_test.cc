@@ -18,8 +18,15 @@
 #include "parallel/auto_parallel/rec_core/rec_tensor.h"
 #include "parallel/auto_parallel/rec_core/rec_graph.h"
 #include "parallel/auto_parallel/rec_core/rec_partition.h"
+#include <chrono>
+#include <iostream>
+#include <map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "ir/value.h"
+#include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace parallel {
@@ -219,8 +226,8 @@ TEST_F(TestPartition, test_PartitionNode) {
   std::shared_ptr<Graph> graph = MakeMatMulData(9);
   // node 2 is the first kRecMatMul Operator
   Graph::NodeType node2 = graph->nodes[2];
-  std::vector<std::pair<std::string, StrategyRec>> nameToStrategy;
-  StrategyRec str = PartitionNode(node2, nameToStrategy, graph);
+  NodeStrategies node_strategies(graph->nodes.size());
+  StrategyRec str = PartitionNode(node2, node_strategies, graph);
   ASSERT_EQ(str.outputTensor.str_h, 1);
   ASSERT_EQ(str.outputTensor.str_w, 0.5);
 }
@@ -247,8 +254,8 @@ TEST_F(TestPartition, test_PartitionForAllDevices0) {
 
 TEST_F(TestPartition, test_ApplyStrToTensor) {
   std::shared_ptr<Graph> graph = MakeMatMulData(9);
-  std::vector<std::pair<std::string, StrategyRec>> nameToStrategy;
-  StrategyRec str = PartitionNode(graph->nodes[4], nameToStrategy, graph);
+  NodeStrategies node_strategies(graph->nodes.size());
+  StrategyRec str = PartitionNode(graph->nodes[4], node_strategies, graph);
   auto h_str = str.outputTensor.str_h;
   auto w_str = str.outputTensor.str_w;
 
@@ -258,5 +265,141 @@ TEST_F(TestPartition, test_ApplyStrToTensor) {
   ASSERT_EQ(h_str, h_node);
   ASSERT_EQ(w_str, w_node);
 }
+
+TEST_F(TestPartition, test_CostRedis) {
+  std::shared_ptr<Graph> graph = MakeMatMulData(9);
+  NodeStrategies node_strategies(graph->nodes.size());
+  // node 4 reads the output of node 2, split on n and c it has to be redistributed for a split on h
+  std::vector<std::vector<float>> mode = {{1, 1, 0.5, 1}, {1, 1, 1, 1}, {1, 1, 0.5, 1}};
+  ASSERT_EQ(CostRedis(graph->nodes[4], node_strategies, mode), 0);
+
+  StrategyRec str;
+  str.outputTensor.str_n = 0.5;
+  str.outputTensor.str_c = 0.5;
+  node_strategies.Set(2, str);
+  ASSERT_EQ(CostRedis(graph->nodes[4], node_strategies, mode), ARRAY_A * ARRAY_C / 4.0);
+
+  node_strategies.Reset();
+  ASSERT_EQ(CostRedis(graph->nodes[4], node_strategies, mode), 0);
+}
+
+// Chains of MatMul of several lengths are all cut once per device doubling, the MatMul at the same place in the
+// pattern of the chain taking the same strategy whatever the length
+TEST_F(TestPartition, test_PartitionForAllDevicesChains) {
+  double device_memory = 1024.0 * 1024.0 * 1024.0 * 16.0;
+  std::map<size_t, std::vector<float>> expected_strs;
+  for (int num_op = 4; num_op <= 256; num_op *= 4) {
+    std::shared_ptr<Graph> graph = MakeMatMulData(2 * num_op + 1);
+    ASSERT_EQ(PartitionForAllDevices(8, device_memory, graph), SUCCESS);
+    for (size_t i = 0; i < graph->nodes.size(); ++i) {
+      auto &node = graph->nodes[i];
+      if (node.info != kApplication) {
+        continue;
+      }
+      ASSERT_EQ(node.apply.str.cut_counter, 3);
+      // the splits of the dimensions i, k and j of the MatMul share the 8 devices
+      auto &args = node.apply.arguments;
+      std::vector<float> str = {args[0].tensor_str.str_h, args[0].tensor_str.str_w, args[1].tensor_str.str_w};
+      ASSERT_FLOAT_EQ(str[0] * str[1] * str[2], 0.125);
+      auto iter = expected_strs.find(i % 4);
+      if (iter == expected_strs.end()) {
+        expected_strs[i % 4] = str;
+      } else {
+        ASSERT_EQ(iter->second, str);
+      }
+    }
+  }
+}
+
+// The planning time of chains of 2.5k to 20k MatMul on 8 devices, it should grow linearly with the number of operators
+TEST_F(TestPartition, DISABLED_benchmark_PartitionForAllDevicesScaling) {
+  double device_memory = 1024.0 * 1024.0 * 1024.0 * 16.0;
+  for (int num_op = 2500; num_op <= 20000; num_op *= 2) {
+    std::shared_ptr<Graph> graph = MakeMatMulData(2 * num_op + 1);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(PartitionForAllDevices(8, device_memory, graph), SUCCESS);
+    auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << num_op << " MatMul on 8 devices: " << cost << " ms, " << cost * 1000 / num_op << " us per operator"
+              << std::endl;
+    for (auto &node : graph->nodes) {
+      if (node.info == kApplication) {
+        ASSERT_EQ(node.apply.str.cut_counter, 3);
+      }
+    }
+  }
+}
+
+namespace {
+// The redistribution cost as it was computed before NodeStrategies, by looking up the names of the neighbors in the
+// list of the strategies decided
+double NameBasedCostRedis(const Graph::NodeType &node, const std::vector<std::pair<std::string, StrategyRec>> &strs,
+                          const std::vector<std::vector<float>> &mode, const Graph &graph) {
+  auto &in = node.apply.arguments[0];
+  double input_tensor = in.tensor_shape.shape_n * in.tensor_str.str_n * in.tensor_shape.shape_c * in.tensor_str.str_c *
+                        in.tensor_shape.shape_h * in.tensor_str.str_h * in.tensor_shape.shape_w * in.tensor_str.str_w;
+  auto &out = node.tensor_parm;
+  double output_tensor = out.tensor_shape.shape_n * out.tensor_str.str_n * out.tensor_shape.shape_c *
+                         out.tensor_str.str_c * out.tensor_shape.shape_h * out.tensor_str.str_h *
+                         out.tensor_shape.shape_w * out.tensor_str.str_w;
+  double cost_redis = 0;
+  for (auto &str : strs) {
+    for (size_t i_node = 0; i_node < node.node_in.size(); i_node++) {
+      if (graph.nodes[node.node_in[i_node]].name == str.first) {
+        cost_redis += CostRedisWithAdjacentNode(str.second, mode, i_node, input_tensor, true);
+      }
+    }
+    for (size_t i_node = 0; i_node < node.node_out.size(); i_node++) {
+      if (graph.nodes[node.node_out[i_node]].name == str.first) {
+        cost_redis += CostRedisWithAdjacentNode(str.second, mode, i_node, output_tensor, false);
+      }
+    }
+  }
+  return cost_redis;
+}
+}  // namespace
+
+// The costs read from NodeStrategies match the name based lookup for every set of partitioned nodes, on a graph where
+// N1 feeds N2 and N3, N3 reads N1 twice and N4 reads both N2 and N3
+TEST_F(TestPartition, test_CostRedisMatchesNameLookup) {
+  std::shared_ptr<Graph> graph(new Graph);
+  Create(graph, 5, {0, 1, 1, 1, 2, 3}, {1, 2, 3, 3, 4, 4});
+  const float splits[] = {1, 0.5, 0.25};
+  std::vector<StrategyRec> strs(graph->nodes.size());
+  for (size_t i = 0; i < graph->nodes.size(); ++i) {
+    auto &node = graph->nodes[i];
+    std::unique_ptr<TensorParam> tensor(MakeTensor(4, 8, 16, 32));
+    node.tensor_parm = *tensor;
+    node.apply.arguments[0] = *tensor;
+    node.tensor_parm.tensor_str.str_h = splits[i % 3];
+    node.apply.arguments[0].tensor_str.str_w = splits[(i + 1) % 3];
+    auto &str = strs[i];
+    str.outputTensor.str_n = splits[i % 3];
+    str.outputTensor.str_w = splits[(i + 2) % 3];
+    str.inputTensor[0].str_c = splits[(i + 1) % 3];
+    str.inputTensor[0].str_h = splits[i % 3];
+  }
+  std::vector<std::vector<std::vector<float>>> modes = {{{1, 1, 0.5, 1}, {1, 1, 1, 1}, {1, 1, 0.5, 1}},
+                                                        {{0.5, 1, 1, 1}, {0.5, 1, 1, 1}, {0.5, 1, 1, 1}},
+                                                        {{1, 1, 1, 0.5}, {1, 1, 0.5, 1}, {1, 1, 1, 1}}};
+
+  size_t num_node = graph->nodes.size();
+  NodeStrategies node_strategies(num_node);
+  for (size_t subset = 0; subset < (1u << num_node); ++subset) {
+    node_strategies.Reset();
+    std::vector<std::pair<std::string, StrategyRec>> name_to_strategy;
+    for (size_t i = 0; i < num_node; ++i) {
+      if (subset & (1u << i)) {
+        node_strategies.Set(i, strs[i]);
+        name_to_strategy.push_back(std::make_pair(graph->nodes[i].name, strs[i]));
+      }
+    }
+    for (auto &node : graph->nodes) {
+      for (auto &mode : modes) {
+        ASSERT_DOUBLE_EQ(CostRedis(node, node_strategies, mode),
+                         NameBasedCostRedis(node, name_to_strategy, mode, *graph));
+      }
+    }
+  }
+}
 }  // namespace parallel
 }  // namespace mindspore
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "parallel/optimizer_shard/optimizer_shard.h"
+
+namespace mindspore {
+namespace parallel {
+
+class TestOptimizerShard : public UT::Common {
+ public:
+  TestOptimizerShard() {}
+  void SetUp() {}
+  void TearDown() {}
+};
+
+namespace {
+double AllreduceTime(double bytes) { return 10.0 + bytes / 100.0; }
+}  // namespace
+
+TEST_F(TestOptimizerShard, test_OptimizerShardLayout) {
+  // a [64, 32] weight split by its second dimension over 2 devices and repeated over 4
+  TensorLayout layout;
+  ASSERT_EQ(layout.InitFromVector({4, 2}, {-1, 0}, {64, 32}), SUCCESS);
+  TensorLayout shard_layout;
+  int32_t dev_num = 0;
+  ASSERT_EQ(OptimizerShardLayout(layout, &shard_layout, &dev_num), SUCCESS);
+  ASSERT_EQ(dev_num, 4);
+  ASSERT_EQ(shard_layout.tensor_map().array(), std::vector<int32_t>({1, 0}));
+  ASSERT_EQ(shard_layout.slice_shape().array(), std::vector<int32_t>({16, 16}));
+
+  // the first dimension is split by the operator
+  ASSERT_EQ(layout.InitFromVector({4, 2}, {0, -1}, {64, 32}), SUCCESS);
+  ASSERT_EQ(OptimizerShardLayout(layout, &shard_layout, &dev_num), FAILED);
+  // not repeated
+  ASSERT_EQ(layout.InitFromVector({4, 2}, {-1, 1, 0}, {8, 64, 32}), SUCCESS);
+  ASSERT_EQ(OptimizerShardLayout(layout, &shard_layout, &dev_num), FAILED);
+  // repeated along two device dimensions
+  ASSERT_EQ(layout.InitFromVector({2, 2, 2}, {-1, 0}, {64, 32}), SUCCESS);
+  ASSERT_EQ(OptimizerShardLayout(layout, &shard_layout, &dev_num), FAILED);
+  // the first dimension can not be split evenly
+  ASSERT_EQ(layout.InitFromVector({4, 2}, {-1, 0}, {6, 32}), SUCCESS);
+  ASSERT_EQ(OptimizerShardLayout(layout, &shard_layout, &dev_num), FAILED);
+}
+
+TEST_F(TestOptimizerShard, test_ChooseOptimizerShard) {
+  // the momentum of a large and a small weight, and a bias without the devices to shard over
+  std::vector<OptimizerShardCandidate> candidates = {{8000.0, 1, 8}, {800.0, 1, 8}, {40.0, 1, 1}};
+  ASSERT_DOUBLE_EQ(OptimizerShardSavedMemory(candidates[0]), 14000.0);
+  ASSERT_DOUBLE_EQ(OptimizerShardExposedTime(candidates[0], AllreduceTime), 45.0);
+
+  OptimizerShardPlan plan;
+  ASSERT_EQ(ChooseOptimizerShard(candidates, 1000.0, 0.0, AllreduceTime, &plan), SUCCESS);
+  ASSERT_EQ(plan.sharded, std::vector<size_t>({0, 1}));
+  ASSERT_DOUBLE_EQ(plan.memory, 1000.0 + 2000.0 + 200.0 + 80.0);
+  ASSERT_DOUBLE_EQ(plan.exposed_time, 45.0 + 9.0);
+
+  // the large weight saves more per exposed time, it is enough to fit the budget
+  ASSERT_EQ(ChooseOptimizerShard(candidates, 1000.0, 5000.0, AllreduceTime, &plan), SUCCESS);
+  ASSERT_EQ(plan.sharded, std::vector<size_t>({0}));
+  ASSERT_DOUBLE_EQ(plan.memory, 1000.0 + 2000.0 + 1600.0 + 80.0);
+  // nothing is sharded when the memory fits
+  ASSERT_EQ(ChooseOptimizerShard(candidates, 1000.0, 1e6, AllreduceTime, &plan), SUCCESS);
+  ASSERT_TRUE(plan.sharded.empty());
+  ASSERT_DOUBLE_EQ(plan.exposed_time, 0.0);
+  // all are sharded but the memory does not fit
+  ASSERT_EQ(ChooseOptimizerShard(candidates, 1000.0, 2000.0, AllreduceTime, &plan), FAILED);
+  ASSERT_EQ(plan.sharded, std::vector<size_t>({0, 1}));
+}
+}  // namespace parallel
+}  // namespace mindspore
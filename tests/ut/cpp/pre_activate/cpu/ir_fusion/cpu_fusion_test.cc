@@ -0,0 +1,141 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "pre_activate/cpu/ir_fusion/biasadd_fusion.h"
+#include "pre_activate/cpu/ir_fusion/activation_fusion.h"
+#include "pre_activate/cpu/ir_fusion/elemwise_fusion.h"
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "operator/ops.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWCPUFusion : public BackendCommon {
+ public:
+  TestHWCPUFusion() : get_py_fun_("gtest_input.pre_activate.cpu_fusion_test", true) {}
+  ~TestHWCPUFusion() override = default;
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWCPUFusion, test_cpu_matmul_biasadd_relu_fusion) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_cpu_matmul_biasadd_relu_fusion", "before");
+  EXPECT_NE(g, nullptr);
+  std::vector<int> shpx{1, 3};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shpx);
+  std::vector<int> shpy{3, 4};
+  auto y_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shpy);
+  std::vector<int> shp_bias{4};
+  auto bias_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp_bias);
+  AbstractBasePtrList args_spec_list{x_abstract, y_abstract, bias_abstract};
+  auto kg = GetKernelGraph(g, args_spec_list);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CPUBiasAddFusion>(prim::kPrimMatMul));
+  pm->AddPass(std::make_shared<opt::CPUActivationFusion>(prim::kPrimMatMul));
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_cpu_matmul_biasadd_relu_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto matmul = new_graph->output()->cast<CNodePtr>()->input(1);
+  EXPECT_TRUE(AnfAlgo::GetNodeAttr<bool>(matmul, kAttrHasBias));
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::string>(matmul, kAttrFusedActivation), prim::kPrimRelu->name());
+}
+
+TEST_F(TestHWCPUFusion, test_cpu_mul_relu_fusion) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_cpu_mul_relu_fusion", "before");
+  EXPECT_NE(g, nullptr);
+  std::vector<int> shp{2, 32, 224, 224};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+  auto kg = GetKernelGraph(g, args_spec_list);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CPUActivationFusion>(prim::kPrimMul));
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_cpu_mul_relu_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+}
+
+TEST_F(TestHWCPUFusion, test_cpu_mul_relu_fusion_used_by_others) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_cpu_mul_relu_fusion", "before_used_by_others");
+  EXPECT_NE(g, nullptr);
+  std::vector<int> shp{2, 32, 224, 224};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+  auto kg = GetKernelGraph(g, args_spec_list);
+  auto origin_graph = std::make_shared<session::KernelGraph>(*kg);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CPUActivationFusion>(prim::kPrimMul));
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  // the output of mul without relu is still needed
+  EXPECT_TRUE(CheckEqualGraph(origin_graph, new_graph));
+}
+
+TEST_F(TestHWCPUFusion, test_cpu_elemwise_fusion) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_cpu_elemwise_fusion", "before");
+  EXPECT_NE(g, nullptr);
+  std::vector<int> shp{2, 32, 224, 224};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+  auto kg = GetKernelGraph(g, args_spec_list);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CPUElemwiseFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_cpu_elemwise_fusion", "after");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+  auto fused = new_graph->output()->cast<CNodePtr>()->input(1);
+  std::vector<std::string> ops{prim::kPrimMul->name(), prim::kPrimRelu->name(), prim::kPrimGelu->name()};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<std::string>>(fused, kAttrFusedOps), ops);
+  // the inputs of mul, then the result of the previous op for relu and gelu
+  std::vector<int> operands{0, 1, -1, -1};
+  EXPECT_EQ(AnfAlgo::GetNodeAttr<std::vector<int>>(fused, kAttrFusedOperands), operands);
+}
+
+TEST_F(TestHWCPUFusion, test_cpu_elemwise_fusion_used_by_others) {
+  FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_cpu_elemwise_fusion", "before_used_by_others");
+  EXPECT_NE(g, nullptr);
+  std::vector<int> shp{2, 32, 224, 224};
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp);
+  AbstractBasePtrList args_spec_list{x_abstract, x_abstract};
+  auto kg = GetKernelGraph(g, args_spec_list);
+
+  auto optimizer = std::make_shared<opt::GraphOptimizer>();
+  auto pm = std::make_shared<opt::PassManager>();
+  pm->AddPass(std::make_shared<opt::CPUElemwiseFusion>());
+  optimizer->AddPassManager(pm);
+  FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+  // the output of mul is still needed, only relu and gelu are fused
+  FuncGraphPtr g_after = get_py_fun_.CallAndParseRet("test_cpu_elemwise_fusion", "after_used_by_others");
+  EXPECT_TRUE(CheckEqualGraph(g_after, new_graph));
+}
+}  // namespace opt
+}  // namespace mindspore
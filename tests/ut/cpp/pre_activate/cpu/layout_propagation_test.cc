@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <string>
+#include "pre_activate/cpu/layout_propagation.h"
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "session/anf_runtime_algorithm.h"
+#include "utils/graph_utils.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWCPULayoutPropagation : public BackendCommon {
+ public:
+  TestHWCPULayoutPropagation() : get_py_fun_("gtest_input.pre_activate.cpu_layout_propagation_test", true) {}
+  ~TestHWCPULayoutPropagation() override = default;
+
+  std::map<std::string, bool> RunPass(const std::string &tag) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_cpu_layout_propagation", tag);
+    EXPECT_NE(g, nullptr);
+    std::vector<int> shp_x{1, 3, 32, 32};
+    std::vector<int> shp_w{64, 3, 7, 7};
+    auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp_x);
+    auto w_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, shp_w);
+    AbstractBasePtrList args_spec_list{x_abstract, w_abstract};
+    auto kg = GetKernelGraph(g, args_spec_list);
+
+    auto optimizer = std::make_shared<opt::GraphOptimizer>();
+    auto pm = std::make_shared<opt::PassManager>();
+    pm->AddPass(std::make_shared<opt::CPULayoutPropagation>());
+    optimizer->AddPassManager(pm);
+    FuncGraphPtr new_graph = optimizer->Optimize(kg);
+
+    std::map<std::string, bool> blocked;
+    for (const auto &node : TopoSort(new_graph->get_return())) {
+      if (node->isa<CNode>() && AnfAlgo::HasNodeAttr(kAttrBlockedLayout, node->cast<CNodePtr>())) {
+        blocked[AnfAlgo::GetCNodeName(node)] = AnfAlgo::GetNodeAttr<bool>(node, kAttrBlockedLayout);
+      }
+    }
+    return blocked;
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+TEST_F(TestHWCPULayoutPropagation, test_chain) {
+  auto blocked = RunPass("chain");
+  ASSERT_EQ(blocked.size(), 3);
+  EXPECT_TRUE(blocked["Conv2D"]);
+  EXPECT_TRUE(blocked["ReLU"]);
+  // the output of the graph is plain
+  EXPECT_FALSE(blocked["MaxPool"]);
+}
+
+TEST_F(TestHWCPULayoutPropagation, test_used_by_others) {
+  auto blocked = RunPass("relu_used_by_others");
+  ASSERT_EQ(blocked.size(), 3);
+  EXPECT_TRUE(blocked["Conv2D"]);
+  EXPECT_FALSE(blocked["ReLU"]);
+  EXPECT_FALSE(blocked["MaxPool"]);
+}
+}  // namespace opt
+}  // namespace mindspore
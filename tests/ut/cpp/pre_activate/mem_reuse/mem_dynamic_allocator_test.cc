@@ -0,0 +1,217 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "pre_activate/mem_reuse/mem_dynamic_allocator.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+// the dynamic memory pool on host memory
+class HostMemPool : public DynamicMemPoolBestFit {
+ public:
+  explicit HostMemPool(size_t capacity) : capacity_(capacity) {}
+  ~HostMemPool() override { ReleaseDeviceRes(); }
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    if (size > capacity_ - alloc_size_) {
+      return 0;
+    }
+    *addr = std::malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    alloc_size_ += size;
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    std::free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return capacity_ - alloc_size_; }
+  size_t total_mem_size() override { return capacity_; }
+
+ protected:
+  size_t mem_alloc_unit_size() const override { return 16 << 20; }
+
+ private:
+  size_t capacity_;
+  size_t alloc_size_{0};
+};
+
+class TestMemDynamicAllocator : public UT::Common {
+ public:
+  TestMemDynamicAllocator() {}
+};
+
+TEST_F(TestMemDynamicAllocator, alloc_and_free) {
+  HostMemPool pool(64 << 20);
+  auto large_addr = pool.AllocTensorMem(4 << 20);
+  ASSERT_NE(large_addr, nullptr);
+  auto small_addr = pool.AllocTensorMem(1000);
+  ASSERT_NE(small_addr, nullptr);
+  ASSERT_EQ(pool.used_mem_statistics(), (4 << 20) + 1024);
+  pool.FreeTensorMem(large_addr);
+  pool.FreeTensorMem(small_addr);
+  ASSERT_EQ(pool.used_mem_statistics(), 0);
+  ASSERT_EQ(pool.cached_mem_statistics(), 1024);
+  ASSERT_EQ(pool.used_mem_peak_statistics(), (4 << 20) + 1024);
+  // the small memory of the same size class comes back from the stream cache
+  ASSERT_EQ(pool.AllocTensorMem(600), small_addr);
+  ASSERT_EQ(pool.cached_mem_statistics(), 0);
+  pool.FreeTensorMem(small_addr);
+}
+
+// a small memory buf freed twice is cached once, so it is not handed out to two tensors
+TEST_F(TestMemDynamicAllocator, double_free_small_mem) {
+  HostMemPool pool(64 << 20);
+  auto addr = pool.AllocTensorMem(1000);
+  ASSERT_NE(addr, nullptr);
+  pool.FreeTensorMem(addr);
+  pool.FreeTensorMem(addr);
+  ASSERT_EQ(pool.used_mem_statistics(), 0);
+  ASSERT_EQ(pool.cached_mem_statistics(), 1024);
+  auto first_addr = pool.AllocTensorMem(1000);
+  auto second_addr = pool.AllocTensorMem(1000);
+  ASSERT_EQ(first_addr, addr);
+  ASSERT_NE(second_addr, addr);
+  ASSERT_EQ(pool.used_mem_statistics(), 2048);
+  ASSERT_EQ(pool.cached_mem_statistics(), 0);
+  pool.FreeTensorMem(first_addr);
+  pool.FreeTensorMem(second_addr);
+}
+
+TEST_F(TestMemDynamicAllocator, stream_cache) {
+  HostMemPool pool(64 << 20);
+  auto addr = pool.AllocTensorMem(2048, 0);
+  pool.FreeTensorMem(addr);
+  // a cached memory buf is not reused by another stream
+  auto other_addr = pool.AllocTensorMem(2048, 1);
+  ASSERT_NE(other_addr, addr);
+  pool.FreeTensorMem(other_addr);
+  // all the memory is in one piece again after the flush
+  pool.FlushMemCache();
+  auto statistics = pool.GetMemStatistics();
+  ASSERT_EQ(statistics.cached_size_, 0);
+  ASSERT_EQ(statistics.used_size_, 0);
+  ASSERT_EQ(statistics.idle_size_, statistics.total_size_);
+  ASSERT_EQ(statistics.fragmentation_, 0);
+}
+
+TEST_F(TestMemDynamicAllocator, flush_when_no_memory) {
+  HostMemPool pool(16 << 20);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < 32; ++i) {
+    addrs.push_back(pool.AllocTensorMem(512 << 10));
+    ASSERT_NE(addrs.back(), nullptr);
+  }
+  for (auto addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+  ASSERT_EQ(pool.cached_mem_statistics(), 16 << 20);
+  // the cached small memory buf are combined to serve a large one
+  auto addr = pool.AllocTensorMem(8 << 20);
+  ASSERT_NE(addr, nullptr);
+  ASSERT_EQ(pool.cached_mem_statistics(), 0);
+  ASSERT_EQ(pool.total_mem_statistics(), 16 << 20);
+  pool.FreeTensorMem(addr);
+}
+
+TEST_F(TestMemDynamicAllocator, continuous_mem) {
+  HostMemPool pool(64 << 20);
+  std::vector<size_t> size_list{1024, 2048, 512};
+  auto addrs = pool.AllocContinuousTensorMem(3584, size_list);
+  ASSERT_EQ(addrs.size(), 3);
+  ASSERT_EQ(static_cast<uint8_t *>(addrs[1]) - static_cast<uint8_t *>(addrs[0]), 1024);
+  ASSERT_EQ(static_cast<uint8_t *>(addrs[2]) - static_cast<uint8_t *>(addrs[1]), 2048);
+  for (auto addr : addrs) {
+    pool.FreeTensorMem(addr);
+  }
+  ASSERT_EQ(pool.used_mem_statistics(), 0);
+}
+
+TEST_F(TestMemDynamicAllocator, release_and_reuse) {
+  HostMemPool pool(64 << 20);
+  auto large_addr = pool.AllocTensorMem(4 << 20, 1);
+  auto small_addr = pool.AllocTensorMem(1000, 1);
+  auto cached_addr = pool.AllocTensorMem(2048, 1);
+  ASSERT_NE(large_addr, nullptr);
+  ASSERT_NE(small_addr, nullptr);
+  pool.FreeTensorMem(cached_addr);
+  // the memory in use and in the stream caches goes with the memory blocks
+  pool.ReleaseDeviceRes();
+  auto statistics = pool.GetMemStatistics();
+  ASSERT_EQ(statistics.total_size_, 0);
+  ASSERT_EQ(statistics.used_size_, 0);
+  ASSERT_EQ(statistics.used_peak_size_, 0);
+  ASSERT_EQ(statistics.cached_size_, 0);
+  ASSERT_EQ(statistics.idle_size_, 0);
+  // the pool allocates new memory blocks, and frees them once only
+  auto addr = pool.AllocTensorMem(2048, 1);
+  ASSERT_NE(addr, nullptr);
+  ASSERT_EQ(pool.total_mem_statistics(), 16 << 20);
+  ASSERT_EQ(pool.used_mem_statistics(), 2048);
+  pool.FreeTensorMem(addr);
+}
+
+TEST_F(TestMemDynamicAllocator, stress) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kIterNum = 20000;
+  HostMemPool pool(size_t(1) << 30);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&pool, i]() {
+      std::mt19937 rng(i);
+      std::vector<DeviceMemPtr> live_addrs;
+      for (size_t iter = 0; iter < kIterNum; ++iter) {
+        if (live_addrs.size() < 64 && (rng() % 2 == 0 || live_addrs.empty())) {
+          // mostly small memory with a few large ones, like the pynative mode
+          size_t size = rng() % 16 == 0 ? (1 << 20) + rng() % (4 << 20) : 1 + rng() % (256 << 10);
+          auto addr = pool.AllocTensorMem(size, i % 2);
+          if (addr != nullptr) {
+            live_addrs.push_back(addr);
+          }
+        } else {
+          auto index = rng() % live_addrs.size();
+          pool.FreeTensorMem(live_addrs[index]);
+          live_addrs[index] = live_addrs.back();
+          live_addrs.pop_back();
+        }
+      }
+      for (auto addr : live_addrs) {
+        pool.FreeTensorMem(addr);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  auto statistics = pool.GetMemStatistics();
+  MS_LOG(INFO) << "Stress " << kThreadNum * kIterNum << " alloc and free cost " << cost << " us, total size "
+               << statistics.total_size_ << ", used peak size " << statistics.used_peak_size_ << ", fragmentation "
+               << statistics.fragmentation_;
+  ASSERT_EQ(statistics.used_size_, 0);
+  pool.FlushMemCache();
+  statistics = pool.GetMemStatistics();
+  ASSERT_EQ(statistics.idle_size_, statistics.total_size_);
+}
+}  // namespace device
+}  // namespace mindspore
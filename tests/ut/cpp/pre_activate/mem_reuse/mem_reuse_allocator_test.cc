@@ -14,12 +14,15 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <vector>
 #include <string>
 #include "operator/ops.h"
 #include "pre_activate/mem_reuse/mem_reuse.h"
 #include "pre_activate/mem_reuse/mem_reuse_allocator.h"
+#include "pre_activate/mem_reuse/mem_reuse_checker.h"
 
 #include "common/common_test.h"
 #include "common/py_func_graph_fetcher.h"
@@ -108,6 +111,59 @@ void InitMemReuseUtils(MemReuseUtil *mem_reuse_util_ptr) {
   mem_reuse_util_ptr->set_kernel_def_ptr_list(op_ptr_list);
 }
 
+// The tensors live at the same time, or used on streams running in parallel, must get disjoint memory ranges
+void CheckPackedRanges(const std::vector<KernelRefCountPtr> &tensor_list, const std::vector<KernelDefPtr> &op_list,
+                       BestFitMemReuse *best_fit, size_t allocated_size) {
+  size_t op_num = op_list.size();
+  size_t tensor_num = tensor_list.size();
+  std::vector<size_t> begin(tensor_num, op_num);
+  std::vector<size_t> end(tensor_num, 0);
+  std::vector<int> use_count(tensor_num, 0);
+  std::vector<std::set<uint32_t>> streams(tensor_num);
+  for (size_t pos = 0; pos < op_num; ++pos) {
+    auto stream_id = op_list[pos]->stream_id();
+    for (auto &output : op_list[pos]->output_refs()) {
+      auto idx = IntToSize(output->index_);
+      begin[idx] = std::min(begin[idx], pos);
+      end[idx] = std::max(end[idx], pos);
+      (void)streams[idx].insert(stream_id);
+    }
+    for (auto &input : op_list[pos]->input_refs()) {
+      auto idx = IntToSize(input->index_);
+      end[idx] = std::max(end[idx], pos);
+      use_count[idx]++;
+      (void)streams[idx].insert(stream_id);
+    }
+  }
+  for (size_t idx = 0; idx < tensor_num; ++idx) {
+    // the graph inputs and outputs are never released
+    if (tensor_list[idx]->ref_count_ > use_count[idx]) {
+      end[idx] = op_num;
+    }
+  }
+  for (size_t i = 0; i < tensor_num; ++i) {
+    auto &lhs = tensor_list[i];
+    ASSERT_LE(lhs->offset_ + lhs->size_, allocated_size);
+    for (size_t j = i + 1; j < tensor_num; ++j) {
+      auto &rhs = tensor_list[j];
+      bool conflict = begin[i] <= end[j] && begin[j] <= end[i];
+      for (auto lhs_stream : streams[i]) {
+        for (auto rhs_stream : streams[j]) {
+          if (!best_fit->IsReusableStream(lhs_stream, rhs_stream) ||
+              !best_fit->IsReusableStream(rhs_stream, lhs_stream)) {
+            conflict = true;
+          }
+        }
+      }
+      if (conflict) {
+        ASSERT_TRUE(lhs->offset_ + lhs->size_ <= rhs->offset_ || rhs->offset_ + rhs->size_ <= lhs->offset_)
+          << "tensor " << i << " [" << lhs->offset_ << ", " << lhs->offset_ + lhs->size_ << ") overlaps tensor " << j
+          << " [" << rhs->offset_ << ", " << rhs->offset_ + rhs->size_ << ")";
+      }
+    }
+  }
+}
+
 TEST_F(TestMemReuseAllocator, mem_reuse_allocator) {
   MS_LOG(INFO) << "mem_resue_allocator UT";
   auto mem_reuse_util_ptr = std::make_shared<MemReuseUtil>();
@@ -122,6 +178,101 @@ TEST_F(TestMemReuseAllocator, mem_reuse_allocator) {
   ASSERT_EQ(is_reusable_stream, true);
 }
 
+TEST_F(TestMemReuseAllocator, mem_reuse_allocator_pack_planner) {
+  auto mem_reuse_util_ptr = std::make_shared<MemReuseUtil>();
+  InitMemReuseUtils(mem_reuse_util_ptr.get());
+  auto best_fit_mem_reuse = std::make_shared<BestFitMemReuse>();
+  best_fit_mem_reuse->InitMemReuseInfo(mem_reuse_util_ptr.get());
+  MemPackPlanner pack_planner(best_fit_mem_reuse.get());
+  pack_planner.InitLifetimes(mem_reuse_util_ptr->total_refs_list(), mem_reuse_util_ptr->total_wk_ref_list(),
+                             mem_reuse_util_ptr->kernel_def_ptr_list());
+  auto allocated_size = pack_planner.Plan();
+  ASSERT_GE(allocated_size, pack_planner.max_live_size());
+  ASSERT_NE(allocated_size, 0);
+  pack_planner.ApplyOffsets();
+  CheckPackedRanges(mem_reuse_util_ptr->total_refs_list(), mem_reuse_util_ptr->kernel_def_ptr_list(),
+                    best_fit_mem_reuse.get(), allocated_size);
+  // the plan kept by Reuse is never larger than the offline one
+  auto mem_reuse_util = std::make_shared<MemReuseUtil>();
+  InitMemReuseUtils(mem_reuse_util.get());
+  auto best_fit = std::make_shared<BestFitMemReuse>();
+  best_fit->Reuse(mem_reuse_util.get());
+  ASSERT_LE(best_fit->GetAllocatedSize(), allocated_size);
+  auto fragmentation_ratio = MemReuseChecker::GetInstance().fragmentation_ratio();
+  ASSERT_GE(fragmentation_ratio, 0);
+  ASSERT_LT(fragmentation_ratio, 1);
+}
+
+TEST_F(TestMemReuseAllocator, mem_reuse_allocator_pack_planner_streams) {
+  // a chain on stream 0 whose tensors can share memory, with a branch on stream 1 running in parallel with it
+  std::vector<size_t> sizes{1024, 2048, 512, 2048, 1024, 512, 1024, 512};
+  std::vector<uint32_t> op_streams{0, 0, 0, 0, 0, 1, 1, 0};
+  std::vector<KernelRefCountPtr> tensor_ptr_list;
+  std::vector<KernelDefPtr> op_ptr_list;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    auto tensor = std::make_shared<KernelRefCount>();
+    tensor->index_ = SizeToInt(i);
+    tensor->size_ = sizes[i];
+    tensor->ref_count_ = 1;
+    std::vector<KernelRefCountPtr> inputs;
+    if (!tensor_ptr_list.empty()) {
+      inputs.push_back(tensor_ptr_list.back());
+    }
+    op_ptr_list.push_back(GetNewKernelDef(inputs, {tensor}, op_streams[i]));
+    tensor_ptr_list.push_back(tensor);
+  }
+  // the last output is a graph output
+  tensor_ptr_list.back()->ref_count_ = 2;
+  auto mem_reuse_util_ptr = std::make_shared<MemReuseUtil>();
+  mem_reuse_util_ptr->set_total_refs_list(tensor_ptr_list);
+  mem_reuse_util_ptr->set_kernel_def_ptr_list(op_ptr_list);
+  auto best_fit_mem_reuse = std::make_shared<BestFitMemReuse>();
+  best_fit_mem_reuse->InitMemReuseInfo(mem_reuse_util_ptr.get());
+  best_fit_mem_reuse->set_parallel_streams_map({{0, {1}}, {1, {0}}});
+  MemPackPlanner pack_planner(best_fit_mem_reuse.get());
+  pack_planner.InitLifetimes(tensor_ptr_list, {}, op_ptr_list);
+  auto allocated_size = pack_planner.Plan();
+  ASSERT_GE(allocated_size, pack_planner.max_live_size());
+  pack_planner.ApplyOffsets();
+  CheckPackedRanges(tensor_ptr_list, op_ptr_list, best_fit_mem_reuse.get(), allocated_size);
+  // the tensors of the chain on stream 0 alone share memory
+  size_t total_size = 0;
+  for (auto size : sizes) {
+    total_size += size;
+  }
+  ASSERT_LT(allocated_size, total_size);
+}
+
+TEST_F(TestMemReuseAllocator, mem_reuse_allocator_pack_planner_large_graph) {
+  // a chain of ops with more tensors than the planner packs
+  std::vector<KernelRefCountPtr> tensor_ptr_list;
+  std::vector<KernelDefPtr> op_ptr_list;
+  for (size_t i = 0; i <= kPackSearchMaxTensors; ++i) {
+    auto tensor = std::make_shared<KernelRefCount>();
+    tensor->index_ = static_cast<int>(i);
+    tensor->size_ = 512;
+    tensor->ref_count_ = 1;
+    std::vector<KernelRefCountPtr> inputs;
+    if (!tensor_ptr_list.empty()) {
+      inputs.push_back(tensor_ptr_list.back());
+    }
+    op_ptr_list.push_back(GetNewKernelDef(inputs, {tensor}, 0));
+    tensor_ptr_list.push_back(tensor);
+  }
+  auto mem_reuse_util_ptr = std::make_shared<MemReuseUtil>();
+  mem_reuse_util_ptr->set_total_refs_list(tensor_ptr_list);
+  mem_reuse_util_ptr->set_kernel_def_ptr_list(op_ptr_list);
+  auto best_fit_mem_reuse = std::make_shared<BestFitMemReuse>();
+  best_fit_mem_reuse->InitMemReuseInfo(mem_reuse_util_ptr.get());
+  MemPackPlanner pack_planner(best_fit_mem_reuse.get());
+  pack_planner.InitLifetimes(tensor_ptr_list, {}, op_ptr_list);
+  ASSERT_EQ(pack_planner.Plan(), 0);
+  ASSERT_EQ(pack_planner.max_live_size(), 1024);
+  // Reuse keeps the best fit plan
+  best_fit_mem_reuse->Reuse(mem_reuse_util_ptr.get());
+  ASSERT_GE(best_fit_mem_reuse->GetAllocatedSize(), pack_planner.max_live_size());
+}
+
 TEST_F(TestMemReuseAllocator, mem_reuse_allocator_add_membuf) {
   auto best_fit_mem_reuse = std::make_shared<BestFitMemReuse>();
   auto tensor_desc = std::make_shared<KernelRefCount>();
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "pre_activate/mem_reuse/mem_swap_planner.h"
+
+namespace mindspore {
+namespace memreuse {
+class TestMemSwapPlanner : public UT::Common {
+ public:
+  TestMemSwapPlanner() {}
+  void SetUp();
+  void TearDown() {}
+
+ public:
+  std::vector<double> op_time;
+  std::vector<SwapTensor> tensors;
+};
+
+// six ops of a unit of time, an activation read at the start and the end, a short lived large tensor and a small
+// tensor read by every op from the third
+void TestMemSwapPlanner::SetUp() {
+  op_time = std::vector<double>(6, 1.0);
+  tensors = {
+    {100, {0, 5}, true},
+    {50, {1, 2}, true},
+    {10, {2, 3, 4, 5}, true},
+  };
+}
+
+TEST_F(TestMemSwapPlanner, test_LiveSize) {
+  MemSwapPlanner planner(op_time, 100.0);
+  for (auto &tensor : tensors) {
+    planner.AddTensor(tensor);
+  }
+  ASSERT_EQ(planner.LiveSize(), std::vector<size_t>({100, 150, 160, 110, 110, 110}));
+  ASSERT_TRUE(planner.Plan(200));
+  ASSERT_TRUE(planner.decisions().empty());
+  ASSERT_EQ(planner.origin_peak(), 160);
+  ASSERT_EQ(planner.peak(), 160);
+}
+
+TEST_F(TestMemSwapPlanner, test_Plan) {
+  // the activation takes one op to copy, it is released after the second op and copied back before the fifth
+  MemSwapPlanner planner(op_time, 100.0);
+  for (auto &tensor : tensors) {
+    planner.AddTensor(tensor);
+  }
+  ASSERT_TRUE(planner.Plan(150));
+  ASSERT_EQ(planner.decisions().size(), 1);
+  auto &decision = planner.decisions()[0];
+  ASSERT_EQ(decision.tensor, 0);
+  ASSERT_EQ(decision.gap, 0);
+  ASSERT_EQ(decision.out_pos, 1);
+  ASSERT_EQ(decision.in_pos, 4);
+  ASSERT_EQ(planner.LiveSize(), std::vector<size_t>({100, 150, 60, 10, 110, 110}));
+  ASSERT_EQ(planner.peak(), 150);
+
+  // the gaps of the other tensors are too short to hide a copy
+  ASSERT_FALSE(planner.Plan(100));
+  ASSERT_EQ(planner.decisions().size(), 1);
+  ASSERT_EQ(planner.peak(), 150);
+}
+
+TEST_F(TestMemSwapPlanner, test_PlanSlowHost) {
+  // the copies of the activation take longer than the ops in between
+  MemSwapPlanner planner(op_time, 40.0);
+  for (auto &tensor : tensors) {
+    planner.AddTensor(tensor);
+  }
+  ASSERT_FALSE(planner.Plan(150));
+  ASSERT_TRUE(planner.decisions().empty());
+  ASSERT_EQ(planner.peak(), 160);
+
+  // a tensor that must stay is not swapped
+  MemSwapPlanner pinned_planner(op_time, 100.0);
+  tensors[0].swappable = false;
+  for (auto &tensor : tensors) {
+    pinned_planner.AddTensor(tensor);
+  }
+  ASSERT_FALSE(pinned_planner.Plan(150));
+  ASSERT_TRUE(pinned_planner.decisions().empty());
+}
+}  // namespace memreuse
+}  // namespace mindspore
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "pipeline/parse/python_adapter.h"
+#include "pynative/pynative_async_executor.h"
+#include "pynative/pynative_execute.h"
+#include "ir/meta_tensor.h"
+
+namespace mindspore {
+namespace pynative {
+class TestPynativeAsyncExecutor : public UT::Common {
+ public:
+  TestPynativeAsyncExecutor() {}
+  void SetUp() override { env_ = parse::python_adapter::set_python_scoped(); }
+  void TearDown() override { AsyncOpExecutor::GetInstance().Stop(); }
+
+ private:
+  std::shared_ptr<py::scoped_interpreter> env_;
+};
+
+TEST_F(TestPynativeAsyncExecutor, TestRunInOrder) {
+  std::vector<int> order;
+  std::vector<std::shared_future<void>> futures;
+  for (int i = 0; i < 10; ++i) {
+    auto task = std::make_shared<OpTask>([&order, i]() { order.push_back(i); });
+    futures.push_back(AsyncOpExecutor::GetInstance().Push(task));
+  }
+  AsyncOpExecutor::GetInstance().Sync();
+  ASSERT_EQ(order.size(), 10);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(order[i], i);
+    futures[i].get();
+  }
+}
+
+TEST_F(TestPynativeAsyncExecutor, TestDeferredError) {
+  auto task = std::make_shared<OpTask>([]() { MS_LOG(EXCEPTION) << "Run op failed"; });
+  auto future = AsyncOpExecutor::GetInstance().Push(task);
+  AsyncOpExecutor::GetInstance().Sync();
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  tensor->set_pending_task(future);
+  ASSERT_ANY_THROW(tensor->data_sync());
+  // the error is kept until the tensor is produced again
+  ASSERT_ANY_THROW(tensor->data_sync());
+}
+
+TEST_F(TestPynativeAsyncExecutor, TestWaitOnRead) {
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto result = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto data = reinterpret_cast<float *>(result->data_c(true));
+  for (int i = 0; i < result->DataSize(); ++i) {
+    data[i] = 1.0;
+  }
+  auto task = std::make_shared<OpTask>([tensor, result]() { *tensor = *result; });
+  tensor->set_pending_task(AsyncOpExecutor::GetInstance().Push(task));
+  py::array output = tensor->data_sync();
+  auto output_data = reinterpret_cast<float *>(tensor->data_c());
+  ASSERT_EQ(output.size(), 6);
+  for (int i = 0; i < tensor->DataSize(); ++i) {
+    ASSERT_EQ(output_data[i], 1.0);
+  }
+}
+
+// Printing a tensor and changing its dtype wait for the op writing it
+TEST_F(TestPynativeAsyncExecutor, TestWaitOnPrintAndSetDtype) {
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto result = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto data = reinterpret_cast<float *>(result->data_c(true));
+  for (int i = 0; i < result->DataSize(); ++i) {
+    data[i] = 2.0;
+  }
+  auto task = std::make_shared<OpTask>([tensor, result]() { *tensor = *result; });
+  tensor->set_pending_task(AsyncOpExecutor::GetInstance().Push(task));
+  auto str = tensor->ToString();
+  ASSERT_NE(str.find("2."), std::string::npos);
+
+  task = std::make_shared<OpTask>([tensor, result]() { *tensor = *result; });
+  tensor->set_pending_task(AsyncOpExecutor::GetInstance().Push(task));
+  (void)tensor->SetDtype(kInt32);
+  ASSERT_EQ(tensor->data_type(), kNumberTypeInt32);
+  auto int_data = reinterpret_cast<int32_t *>(tensor->data_c());
+  for (int i = 0; i < tensor->DataSize(); ++i) {
+    ASSERT_EQ(int_data[i], 2);
+  }
+}
+
+TEST_F(TestPynativeAsyncExecutor, TestErrorReachesDependentOp) {
+  auto failed_output = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto failed_task = std::make_shared<OpTask>([]() { MS_LOG(EXCEPTION) << "Run op failed"; });
+  failed_output->set_pending_task(AsyncOpExecutor::GetInstance().Push(failed_task));
+
+  // the dependent op is queued before the failure is known, like RunOpInMsAsync does
+  auto op_exec_info = std::make_shared<OpExecInfo>();
+  op_exec_info->op_inputs = py::make_tuple(py::cast(failed_output));
+  bool launched = false;
+  auto output = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{2, 3});
+  auto task = std::make_shared<OpTask>([op_exec_info, &launched]() {
+    WaitPendingInputs(op_exec_info);
+    launched = true;
+  });
+  output->set_pending_task(AsyncOpExecutor::GetInstance().Push(task));
+  AsyncOpExecutor::GetInstance().Sync();
+  ASSERT_FALSE(launched);
+  ASSERT_ANY_THROW(output->data_sync());
+}
+}  // namespace pynative
+}  // namespace mindspore
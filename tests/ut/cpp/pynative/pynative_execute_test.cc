@@ -13,8 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <future>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include "common/common_test.h"
 #include "pipeline/parse/python_adapter.h"
 #include "pipeline/parse/data_converter.h"
@@ -87,6 +89,18 @@ TEST_F(TestPynativeExecute, TestRunOp) {
   }
 }
 
+TEST_F(TestPynativeExecute, TestRunOpWithFailedInput) {
+  auto op_exec_info_ptr = ConstructOpExecInfo();
+  auto input = py::cast<TensorPtr>(op_exec_info_ptr->op_inputs[0]);
+  std::promise<void> failed_op;
+  failed_op.set_exception(std::make_exception_ptr(std::runtime_error("Run op failed")));
+  input->set_pending_task(failed_op.get_future().share());
+  // the op consuming the output of a failed op raises its error instead of reading unbound data
+  ASSERT_ANY_THROW(pynative::RunOp(py::make_tuple(op_exec_info_ptr->py_primitive, op_exec_info_ptr->op_name,
+                                                  op_exec_info_ptr->op_inputs, op_exec_info_ptr->inputs_mask)));
+  ASSERT_ANY_THROW(input->data_sync());
+}
+
 TEST_F(TestPynativeExecute, TestCreateContext) {
   auto ctx3 = MsContext::GetInstance();
   ASSERT_EQ(ctx3->backend_policy(), "vm");
@@ -0,0 +1,98 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+from mindspore.ops import Primitive
+from mindspore.ops import operations as P
+
+MatMul = P.MatMul()
+BiasAdd = P.BiasAdd()
+Mul = P.Mul()
+Relu = P.ReLU()
+Gelu = P.Gelu()
+FusedElemwise = Primitive('FusedElemwise')
+make_tuple = Primitive('make_tuple')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_cpu_matmul_biasadd_relu_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(input0, input1, input2):
+        matmul = MatMul(input0, input1)
+        biasadd = BiasAdd(matmul, input2)
+        return Relu(biasadd)
+
+    @fns
+    def after(input0, input1, input2):
+        return make_tuple(MatMul(input0, input1, input2))
+
+    return fns[tag]
+
+
+def test_cpu_mul_relu_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(input0, input1):
+        mul = Mul(input0, input1)
+        return Relu(mul)
+
+    @fns
+    def after(input0, input1):
+        return make_tuple(Mul(input0, input1))
+
+    @fns
+    def before_used_by_others(input0, input1):
+        mul = Mul(input0, input1)
+        return make_tuple(Relu(mul), mul)
+
+    return fns[tag]
+
+
+def test_cpu_elemwise_fusion(tag):
+    fns = FnDict()
+
+    @fns
+    def before(input0, input1):
+        mul = Mul(input0, input1)
+        relu = Relu(mul)
+        return Gelu(relu)
+
+    @fns
+    def after(input0, input1):
+        return make_tuple(FusedElemwise(input0, input1))
+
+    @fns
+    def before_used_by_others(input0, input1):
+        mul = Mul(input0, input1)
+        relu = Relu(mul)
+        return make_tuple(Gelu(relu), mul)
+
+    @fns
+    def after_used_by_others(input0, input1):
+        mul = Mul(input0, input1)
+        return make_tuple(FusedElemwise(mul), mul)
+
+    return fns[tag]
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "common/common_test.h"
+#include "utils/summary/async_event_writer.h"
+
+namespace mindspore {
+namespace summary {
+class TestAsyncEventWriter : public UT::Common {
+ public:
+  TestAsyncEventWriter() {}
+  // the file is created before it is opened, as the python writer does
+  void SetUp() override { std::ofstream(file_name_).close(); }
+  void TearDown() override { (void)remove(file_name_.c_str()); }
+
+  std::string ReadFile() {
+    std::ifstream ifs(file_name_, std::ios::binary);
+    std::stringstream buffer;
+    buffer << ifs.rdbuf();
+    return buffer.str();
+  }
+
+ protected:
+  std::string file_name_ = "./async_event_writer_test.summary";
+};
+
+TEST_F(TestAsyncEventWriter, test_bounded_queue) {
+  BoundedQueue<int> queue(3);
+  ASSERT_EQ(queue.capacity(), 4);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.TryPush(int(i)));
+  }
+  ASSERT_FALSE(queue.TryPush(4));
+  int item = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.TryPop(&item));
+    ASSERT_EQ(item, i);
+  }
+  ASSERT_FALSE(queue.TryPop(&item));
+}
+
+TEST_F(TestAsyncEventWriter, test_write_records) {
+  std::string expect;
+  {
+    AsyncEventWriter writer(file_name_, 1 << 20);
+    ASSERT_TRUE(writer.Open());
+    for (int i = 0; i < 100; ++i) {
+      std::string event = "event" + std::to_string(i);
+      EventWriter::EncodeRecord(event, &expect);
+      ASSERT_TRUE(writer.Write(event, i % 2 == 0));
+    }
+    ASSERT_TRUE(writer.Flush());
+    ASSERT_EQ(writer.GetWriteEventCount(), 100);
+    ASSERT_EQ(writer.GetQueuedBytes(), 0);
+    ASSERT_EQ(writer.GetDroppedEvents(), 0);
+    ASSERT_TRUE(writer.Shut());
+  }
+  // the batches hold the same records as writing the events one by one
+  ASSERT_EQ(ReadFile(), expect);
+}
+
+TEST_F(TestAsyncEventWriter, test_drop_under_backpressure) {
+  AsyncEventWriter writer(file_name_, 16);
+  ASSERT_TRUE(writer.Open());
+  std::string large_event(64, 'a');
+  ASSERT_FALSE(writer.Write(large_event));
+  ASSERT_FALSE(writer.Write(large_event));
+  ASSERT_EQ(writer.GetDroppedEvents(), 2);
+  // the events which are not droppable wait for room instead
+  ASSERT_TRUE(writer.Write(large_event, false));
+  ASSERT_TRUE(writer.Flush());
+  ASSERT_EQ(writer.GetWriteEventCount(), 1);
+  ASSERT_EQ(writer.GetPeakQueuedBytes(), 64);
+  ASSERT_TRUE(writer.Shut());
+}
+
+TEST_F(TestAsyncEventWriter, test_sample_under_backpressure) {
+  AsyncEventWriter writer(file_name_, 100, kSummarySample);
+  writer.set_sample_interval(2);
+  ASSERT_TRUE(writer.Open());
+  std::string event(60, 'a');
+  // over half of the limit, one of every two events is kept
+  ASSERT_TRUE(writer.Write(event));
+  ASSERT_FALSE(writer.Write(event));
+  ASSERT_EQ(writer.GetSampledEvents(), 1);
+  ASSERT_TRUE(writer.Shut());
+}
+
+// the events waiting for room give up once the writer is shut, rather than wait for a writer which is gone
+TEST_F(TestAsyncEventWriter, test_shut_while_waiting) {
+  AsyncEventWriter writer(file_name_, 16);
+  ASSERT_TRUE(writer.Open());
+  std::string large_event(64, 'a');
+  std::thread producer([&writer, &large_event]() {
+    while (writer.Write(large_event, false)) {
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_TRUE(writer.Shut());
+  producer.join();
+  ASSERT_FALSE(writer.Write(large_event, false));
+  ASSERT_GT(writer.GetWriteEventCount(), 0);
+}
+}  // namespace summary
+}  // namespace mindspore
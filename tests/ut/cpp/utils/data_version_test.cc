@@ -0,0 +1,67 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <vector>
+#include "common/common_test.h"
+#include "utils/data_version.h"
+
+namespace mindspore {
+class TestDataVersion : public UT::Common {
+ public:
+  TestDataVersion() {}
+  void SetUp() { DataVersion::GetInstance().Clear(); }
+  void TearDown() { DataVersion::GetInstance().Clear(); }
+};
+
+// The version of a tracked address changes after every bump, the other addresses keep theirs
+TEST_F(TestDataVersion, test_BumpTracked) {
+  auto &versions = DataVersion::GetInstance();
+  std::vector<float> weight(16);
+  std::vector<float> other(16);
+  uint64_t version = versions.Get(weight.data());
+  uint64_t other_version = versions.Get(other.data());
+  ASSERT_EQ(versions.Get(weight.data()), version);
+  ASSERT_NE(other_version, version);
+
+  versions.Bump(weight.data());
+  uint64_t bumped = versions.Get(weight.data());
+  ASSERT_NE(bumped, version);
+  ASSERT_EQ(versions.Get(other.data()), other_version);
+  versions.Bump(weight.data());
+  ASSERT_NE(versions.Get(weight.data()), bumped);
+  ASSERT_NE(versions.Get(weight.data()), version);
+}
+
+// Bumping an untracked address does not track it
+TEST_F(TestDataVersion, test_BumpUntracked) {
+  auto &versions = DataVersion::GetInstance();
+  std::vector<float> data(16);
+  versions.Bump(data.data());
+  versions.Bump(nullptr);
+  ASSERT_EQ(versions.tracked_size(), 0);
+  (void)versions.Get(data.data());
+  ASSERT_EQ(versions.tracked_size(), 1);
+}
+
+// An address tracked again after a clear never gets one of its old versions back
+TEST_F(TestDataVersion, test_ClearKeepsVersionsUnique) {
+  auto &versions = DataVersion::GetInstance();
+  std::vector<float> data(16);
+  uint64_t version = versions.Get(data.data());
+  versions.Clear();
+  ASSERT_EQ(versions.tracked_size(), 0);
+  ASSERT_NE(versions.Get(data.data()), version);
+}
+}  // namespace mindspore
@@ -0,0 +1,89 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+
+import mindspore as ms
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore import context
+from mindspore.common.api import _executor
+from mindspore.nn import TrainOneStepCell
+from mindspore.nn.optim import Momentum
+from mindspore.ops import operations as P
+from mindspore.train.anf_ir_pb2 import ModelProto
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.weight = Parameter(Tensor(np.ones([64, 32]), dtype=ms.float32), "w1")
+        self.matmul = P.MatMul(transpose_b=True).set_strategy(((8, 1), (1, 1)))
+
+    def construct(self, x):
+        return self.matmul(x, self.weight)
+
+
+class NetWithLoss(nn.Cell):
+    def __init__(self, network):
+        super(NetWithLoss, self).__init__()
+        self.loss = P.SoftmaxCrossEntropyWithLogits().set_strategy(((8, 1), (8, 1)))
+        self.network = network
+
+    def construct(self, x, b):
+        predict = self.network(x)
+        return self.loss(predict, b)[0]
+
+
+def compile_train_net(enable_parallel_optimizer):
+    context.set_auto_parallel_context(device_num=8, global_rank=0, parallel_mode="semi_auto_parallel",
+                                      mirror_mean=True, enable_parallel_optimizer=enable_parallel_optimizer)
+    net = Net()
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    train_net = TrainOneStepCell(NetWithLoss(net), optimizer)
+    train_net.set_auto_parallel()
+    x = Tensor(np.ones([64, 32]), dtype=ms.float32)
+    b = Tensor(np.ones([64, 64]), dtype=ms.float32)
+    phase, _ = _executor.compile(train_net, x, b, phase='train', auto_parallel_mode=True)
+    model = ModelProto()
+    model.ParseFromString(_executor._get_func_graph_proto(phase, "anf_ir"))
+    return train_net.parameter_layout_dict, model.graph.node
+
+
+def op_nodes(nodes, op_type):
+    return [node for node in nodes if node.op_type == op_type]
+
+
+def test_parallel_optimizer_shard():
+    layouts, nodes = compile_train_net(True)
+    # the weight and its momentum keep a slice of the 8 devices the weight is repeated on
+    assert layouts["w1"][2] == [8, 32]
+    assert layouts["moments.w1"][2] == [8, 32]
+    # the AllGather averaging the gradients takes the place of the mirror, whose bprop allreduces them
+    assert not op_nodes(nodes, "AllReduce")
+    all_gathers = op_nodes(nodes, "AllGather")
+    assert len(all_gathers) == 1
+    attrs = {attr.name: attr.value for attr in all_gathers[0].attribute}
+    assert attrs["mean_flag"].bool_val
+    # its bprop reduce-scatters the gradient, which the optimizer updates the slice with
+    assert len(op_nodes(nodes, "ReduceScatter")) == 1
+
+
+def test_parallel_optimizer_disabled():
+    layouts, nodes = compile_train_net(False)
+    assert layouts["w1"][2] == [64, 32]
+    assert layouts["moments.w1"][2] == [64, 32]
+    assert op_nodes(nodes, "AllReduce")
+    assert not op_nodes(nodes, "AllGather")
+    assert not op_nodes(nodes, "ReduceScatter")
@@ -0,0 +1,91 @@
+# Copyright 2020 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+
+import mindspore as ms
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore import context
+from mindspore.common.api import _executor
+from mindspore.ops import operations as P
+from mindspore.parallel._auto_parallel_context import auto_parallel_context
+from tests.ut.python.ops.test_math_ops import VirtualLoss
+
+
+class NetWithLoss(nn.Cell):
+    def __init__(self, network):
+        super(NetWithLoss, self).__init__()
+        self.loss = VirtualLoss()
+        self.network = network
+
+    def construct(self, x):
+        predict = self.network(x)
+        return self.loss(predict)
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.matmul1 = P.MatMul()
+        self.matmul2 = P.MatMul()
+        self.matmul3 = P.MatMul()
+        self.matmul4 = P.MatMul()
+        self.w1 = Parameter(Tensor(np.ones([128, 128]), dtype=ms.float32), name="w1")
+        self.w2 = Parameter(Tensor(np.ones([128, 128]), dtype=ms.float32), name="w2")
+        self.w3 = Parameter(Tensor(np.ones([128, 128]), dtype=ms.float32), name="w3")
+        self.w4 = Parameter(Tensor(np.ones([128, 128]), dtype=ms.float32), name="w4")
+
+    def construct(self, x):
+        out = self.matmul1(x, self.w1)
+        out = self.matmul2(out, self.w2)
+        out = self.matmul3(out, self.w3)
+        out = self.matmul4(out, self.w4)
+        return out
+
+
+def compile_stage(global_rank):
+    context.set_auto_parallel_context(device_num=8, global_rank=global_rank, parallel_mode="auto_parallel",
+                                      pipeline_stages=2)
+    net = NetWithLoss(Net())
+    net.set_auto_parallel()
+    x = Tensor(np.ones([128, 128]), dtype=ms.float32)
+    phase, _ = _executor.compile(net, x)
+    return _executor._get_func_graph_proto(phase, "anf_ir")
+
+
+def test_pipeline_stages_context():
+    context.set_auto_parallel_context(pipeline_stages=2, micro_batch_num=4)
+    assert context.get_auto_parallel_context("pipeline_stages") == 2
+    assert context.get_auto_parallel_context("micro_batch_num") == 4
+    assert auto_parallel_context().get_pipeline_stages() == 2
+    context.reset_auto_parallel_context()
+    assert context.get_auto_parallel_context("pipeline_stages") == 1
+    assert context.get_auto_parallel_context("micro_batch_num") == 1
+
+
+def test_pipeline_first_stage():
+    # the ranks 0-3 are the first stage, which sends its output to the last one and outputs no loss
+    graph = compile_stage(0)
+    assert b"_Send" in graph
+    assert b"_Receive" not in graph
+    assert b"VirtualLoss" not in graph
+
+
+def test_pipeline_last_stage():
+    # the ranks 4-7 are the last stage, which receives the input from the first one and outputs the loss
+    graph = compile_stage(4)
+    assert b"_Receive" in graph
+    assert b"_Send" not in graph
+    assert b"VirtualLoss" in graph
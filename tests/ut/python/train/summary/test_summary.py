@@ -228,3 +228,25 @@ def test_validate():
         SummaryStep(sr, [3, 4])
     with pytest.raises(ValueError):
         SummaryStep(sr, sr)
+
+
+def test_queue_options():
+    """ the queue options are checked and the metrics of the writer are exposed """
+    with pytest.raises(ValueError):
+        SummaryRecord(SUMMARY_DIR, policy="block")
+    with pytest.raises(TypeError):
+        SummaryRecord(SUMMARY_DIR, policy=1)
+    with pytest.raises(ValueError):
+        SummaryRecord(SUMMARY_DIR, max_queue_bytes=0)
+    with pytest.raises(TypeError):
+        SummaryRecord(SUMMARY_DIR, max_queue_bytes=1.5)
+
+    with SummaryRecord(SUMMARY_DIR, file_suffix="_MS_QUEUE", max_queue_bytes=1 << 20, policy="sample") as test_writer:
+        assert test_writer.dropped_events == 0
+        for i in range(1, 100):
+            _cache_summary_tensor_data(get_test_data(i))
+            test_writer.record(i)
+    # some steps may be dropped while the writer process is busy, the queue is empty once closed
+    assert 0 <= test_writer.dropped_events < 99
+    assert test_writer.queued_bytes == 0
+    assert test_writer.peak_queued_bytes > 0
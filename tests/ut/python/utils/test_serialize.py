@@ -30,7 +30,7 @@ from mindspore.nn.optim.momentum import Momentum
 from mindspore.ops import operations as P
 from mindspore.train.callback import _CheckpointManager
 from mindspore.train.serialization import save_checkpoint, load_checkpoint, load_param_into_net, \
-    _exec_save_checkpoint, export, _save_graph
+    _exec_save_checkpoint, export, _save_graph, _wait_async_save
 from ..ut_filter import run_on_onnxruntime, non_graph_engine
 
 context.set_context(mode=context.GRAPH_MODE)
@@ -131,6 +131,45 @@ def test_load_checkpoint():
     assert isinstance(par_dict, dict)
 
 
+def test_save_load_native_checkpoint():
+    """ test_save_load_native_checkpoint """
+    weight = np.random.randint(0, 255, [12, 1024]).astype(np.float32)
+    bias = np.random.randint(0, 255, [12]).astype(np.int32)
+    parameter_list = [{'name': "weight", 'data': Tensor(weight)},
+                      {'name': "bias", 'data': Parameter(Tensor(bias), name="bias")},
+                      {'name': "global_step", 'data': Tensor(np.array(5).astype(np.int32))}]
+    ckpoint_file_name = os.path.join(_cur_dir, './native_parameters.ckpt')
+    if os.path.exists(ckpoint_file_name):
+        os.chmod(ckpoint_file_name, stat.S_IWRITE)
+        os.remove(ckpoint_file_name)
+    save_checkpoint(parameter_list, ckpoint_file_name, native_format=True)
+
+    par_dict = load_checkpoint(ckpoint_file_name)
+    assert len(par_dict) == 3
+    assert par_dict['weight'].data.dtype() == mstype.float32
+    assert par_dict['weight'].data.shape() == (12, 1024)
+    assert np.all(par_dict['weight'].data.asnumpy() == weight)
+    assert np.all(par_dict['bias'].data.asnumpy() == bias)
+    assert par_dict['global_step'].data == 5
+
+
+def test_save_native_checkpoint_async():
+    """ test_save_native_checkpoint_async """
+    weight = np.random.randint(0, 255, [64, 256]).astype(np.float32)
+    weight_tensor = Tensor(weight)
+    ckpoint_file_name = os.path.join(_cur_dir, './async_parameters.ckpt')
+    if os.path.exists(ckpoint_file_name):
+        os.chmod(ckpoint_file_name, stat.S_IWRITE)
+        os.remove(ckpoint_file_name)
+    save_checkpoint([{'name': "weight", 'data': weight_tensor}], ckpoint_file_name, async_save=True)
+    # the parameters may change once the snapshot is taken
+    weight_tensor.asnumpy().fill(0)
+    _wait_async_save()
+
+    par_dict = load_checkpoint(ckpoint_file_name)
+    assert np.all(par_dict['weight'].data.asnumpy() == weight)
+
+
 def test_checkpoint_manager():
     """ test_checkpoint_manager """
     ckp_mgr = _CheckpointManager()